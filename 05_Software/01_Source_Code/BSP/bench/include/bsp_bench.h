@@ -0,0 +1,141 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_bench.h
+ *
+ * @par dependencies
+ * - stdio.h
+ * - stdint.h
+ *
+ * @author Damian
+ *
+ * @brief Provide the timestamp, statistic and CSV report APIs shared by all
+ *        the benchmark suites.
+ *
+ * Processing flow:
+ *
+ * bench_timestamp_init -> bench_stat_reset -> bench_stat_add (N times)
+ *                      -> bench_csv_header / bench_csv_row
+ *
+ * Timestamps come from the DWT cycle counter on target. When the suite is
+ * built against the FreeRTOS POSIX port (BENCH_HOST_POSIX defined) they come
+ * from clock_gettime( CLOCK_MONOTONIC ) in nanoseconds instead.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+#ifndef __BSP_BENCH_H__
+#define __BSP_BENCH_H__
+
+//******************************** Includes *********************************//
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stddef.h>
+
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+#ifdef BENCH_HOST_POSIX
+#define BENCH_TS_UNIT        "ns"           /* unit of a raw timestamp       */
+#else
+#define BENCH_TS_UNIT        "cycles"       /* unit of a raw timestamp       */
+#endif /* BENCH_HOST_POSIX */
+
+typedef enum
+{
+    BENCH_OK              = 0,       /* BENCH operate successfully           */
+    BENCH_ERROR           = 1,       /* BENCH error without case matched     */
+    BENCH_ERRORTIMEOUT    = 2,       /* BENCH operate failed with timeout    */
+    BENCH_ERRORSOURCE     = 3,       /* BENCH resource not available         */
+    BENCH_ERRORPARAMETER  = 4,       /* BENCH parameter error                */
+    BENCH_ERRORNOMEMORY   = 5,       /* BENCH out of memory                  */
+    BENCH_ERRORISR        = 6,       /* BENCH not allowed in ISR context     */
+    BENCH_RESERVED        = 0xFF,    /* BENCH reserved                       */
+} bench_status_t;
+
+typedef struct
+{
+    uint32_t              samples;                /* number of samples added */
+    uint32_t              min;                    /* min delta in ts unit    */
+    uint32_t              max;                    /* max delta in ts unit    */
+    uint64_t              sum;                    /* sum of all the deltas   */
+} bench_stat_t;
+
+//******************************** Defines **********************************//
+
+//******************************* Declaring *********************************//
+
+/**
+ * @brief: Enable the timestamp source
+ * @steps:
+ *      1. Start the DWT cycle counter through the time service on target
+ *
+ * @return bench_status_t: execute result of this function
+ **/
+bench_status_t bench_timestamp_init ( void );
+
+/**
+ * @brief: Read the free-running timestamp, callable from task and ISR
+ *
+ * @return uint32_t: current timestamp in BENCH_TS_UNIT, wraps around
+ **/
+uint32_t bench_timestamp_get ( void );
+
+/**
+ * @brief: Convert a timestamp delta into nanoseconds
+ *
+ * @param[in]  delta: delta of two timestamps in BENCH_TS_UNIT
+ *
+ * @return uint32_t: delta in nanoseconds
+ **/
+uint32_t bench_timestamp_to_ns ( uint32_t delta );
+
+/**
+ * @brief: Clear a statistic before a new run
+ *
+ * @param[in]  stat: Pointer to a instance of bench_stat_t
+ **/
+void bench_stat_reset ( bench_stat_t * const stat );
+
+/**
+ * @brief: Add one measured delta into a statistic
+ *
+ * @param[in]  stat:  Pointer to a instance of bench_stat_t
+ * @param[in]  delta: measured delta in BENCH_TS_UNIT
+ **/
+void bench_stat_add ( bench_stat_t * const stat, uint32_t delta );
+
+/**
+ * @brief: Print the CSV header shared by all the suites
+ *
+ * @param[in]  suite: name of the suite, printed as a comment line
+ **/
+void bench_csv_header ( const char * const suite );
+
+/**
+ * @brief: Print one CSV row for a statistic
+ * @steps:
+ *      1. Print the raw values in BENCH_TS_UNIT
+ *      2. Print the converted values in nanoseconds
+ *
+ * @param[in]  suite: name of the suite
+ * @param[in]  mode:  name of the measured path, e.g. "task2task"
+ * @param[in]  case_name: name of the measured object, e.g. "semaphore"
+ * @param[in]  stat:  Pointer to a instance of bench_stat_t
+ **/
+void bench_csv_row (
+                     const char         * const suite,
+                     const char         * const mode,
+                     const char         * const case_name,
+                     const bench_stat_t * const stat
+                                                          );
+
+//******************************* Declaring *********************************//
+#endif // __BSP_BENCH_H__
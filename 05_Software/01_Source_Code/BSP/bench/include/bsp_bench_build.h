@@ -0,0 +1,77 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_bench_build.h
+ *
+ * @par dependencies
+ * - bsp_bench.h
+ *
+ * @author Damian
+ *
+ * @brief Measure the hot paths the build profile changes, to compare the
+ *        homework_06 (debug) and homework_06_release targets.
+ *
+ * Processing flow:
+ *
+ * bench_build_start -> runner task -> one row per hot path
+ *
+ * Define BENCH_BUILD_ENABLE in the target options of both targets to start
+ * the suite from MX_FREERTOS_Init. The mode column carries the profile
+ * ("debug" or "release", from RELEASE_BUILD), so the two CSV reports can be
+ * concatenated and compared row by row.
+ *
+ * tick_isr:    one sample is a gap in a tight loop of timestamp reads, i.e.
+ *              the cost of one tick interrupt (SysTick or the TIM1 timebase)
+ *              including entry and exit.
+ * yield:       one sample is taskYIELD with no other ready task, i.e. PendSV
+ *              and vTaskSwitchContext.
+ * queue_rt:    one sample is a non-blocking send and receive on a queue.
+ * time_get_us: one sample is one 64-bit microsecond read.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+#ifndef __BSP_BENCH_BUILD_H__
+#define __BSP_BENCH_BUILD_H__
+
+//******************************** Includes *********************************//
+
+#include "bsp_bench.h"
+
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+#define BENCH_BUILD_ITERATIONS  1000U     /* samples per case                */
+#define BENCH_BUILD_STACK_WORDS 256U      /* stack of the runner task        */
+#define BENCH_BUILD_GAP_MIN     48U       /* read gap taken as an interrupt  */
+
+#ifdef RELEASE_BUILD
+#define BENCH_BUILD_PROFILE     "release" /* mode column of the rows         */
+#else
+#define BENCH_BUILD_PROFILE     "debug"   /* mode column of the rows         */
+#endif /* RELEASE_BUILD */
+
+//******************************** Defines **********************************//
+
+//******************************* Declaring *********************************//
+
+/**
+ * @brief: Start the build profile suite
+ * @steps:
+ *      1. Start the timestamp source
+ *      2. Create the runner task, it prints the CSV report and deletes itself
+ *
+ * @param[in]  iterations: samples per case, 0 means default
+ *
+ * @return bench_status_t: execute result of this function
+ **/
+bench_status_t bench_build_start ( uint32_t iterations );
+
+//******************************* Declaring *********************************//
+#endif // __BSP_BENCH_BUILD_H__
@@ -0,0 +1,72 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_bench_clock.h
+ *
+ * @par dependencies
+ * - bsp_bench.h
+ * - bsp_clock.h
+ *
+ * @author Damian
+ *
+ * @brief Measure the same workloads under every clock profile, the table of
+ *        the clock-profile API.
+ *
+ * Processing flow:
+ *
+ * bench_clock_start -> runner task -> for each profile: clock_profile_apply
+ *                   -> workload rows -> back to the profile found at start
+ *
+ * Define BENCH_CLOCK_ENABLE in the target options to start the suite from
+ * MX_FREERTOS_Init. The mode column is the profile name, "no_art" is the
+ * performance profile with the ART accelerator off.
+ *
+ * flash_read: one sample is a sum over a BENCH_CLOCK_TABLE_WORDS words const
+ *             table in flash, the data side of ART.
+ * code_loop:  one sample is BENCH_CLOCK_LOOP_ROUNDS rounds of a branchy
+ *             integer loop, the instruction side of ART.
+ *
+ * Cycles show the wait state cost of a profile, nanoseconds the wall time.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+#ifndef __BSP_BENCH_CLOCK_H__
+#define __BSP_BENCH_CLOCK_H__
+
+//******************************** Includes *********************************//
+
+#include "bsp_bench.h"
+
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+#define BENCH_CLOCK_ITERATIONS  200U      /* samples per case                */
+#define BENCH_CLOCK_STACK_WORDS 256U      /* stack of the runner task        */
+#define BENCH_CLOCK_TABLE_WORDS 1024U     /* words of the flash table        */
+#define BENCH_CLOCK_LOOP_ROUNDS 256U      /* rounds of the code loop         */
+
+//******************************** Defines **********************************//
+
+//******************************* Declaring *********************************//
+
+/**
+ * @brief: Start the clock profile suite
+ * @steps:
+ *      1. Start the timestamp source
+ *      2. Create the runner task, it prints the CSV report and deletes itself
+ *
+ * @param[in]  iterations: samples per case, 0 means default
+ *
+ * @return bench_status_t: execute result of this function
+ **/
+bench_status_t bench_clock_start ( uint32_t iterations );
+
+//******************************* Declaring *********************************//
+#endif // __BSP_BENCH_CLOCK_H__
@@ -0,0 +1,84 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_bench_crc.h
+ *
+ * @par dependencies
+ * - bsp_bench.h
+ * - bsp_crc.h
+ *
+ * @author Damian
+ *
+ * @brief Check the CRC service gives the same CRC-32/MPEG-2 on every path
+ *        and measure the MB/s of each.
+ *
+ * Processing flow:
+ *
+ * bench_crc_start -> runner task -> check: "123456789", every length and
+ *                                   alignment of bytes, every length of
+ *                                   words across the DMA threshold, each
+ *                                   path against a bit by bit reference
+ *                                -> flash (target): the image sectors by
+ *                                   DMA, several transfers, against the
+ *                                   tables
+ *                                -> time every path on 64 B .. 16 KiB ->
+ *                                   CSV, plus "# rate" lines in MB/s
+ *
+ * Define BENCH_CRC_ENABLE in the target options to start the suite from
+ * MX_FREERTOS_Init with the CRC unit instance. Without one (NULL, and on
+ * the host) the suite runs its own software only instance.
+ *
+ *  mode         path
+ *  sw_bitwise   reference, one bit per step
+ *  sw_slice8    crc32_mpeg2_sw, 8 bytes per step through 8 KiB of tables
+ *  hw_cpu       the CPU writes the data register, byte reversed for bytes
+ *  hw_dma       DMA2 memory to memory into the data register
+ *
+ * Nothing here needs the hardware, so the same file runs on the host
+ * against the FreeRTOS POSIX port with BENCH_HOST_POSIX defined.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+#ifndef __BSP_BENCH_CRC_H__
+#define __BSP_BENCH_CRC_H__
+
+//******************************** Includes *********************************//
+
+#include "bsp_bench.h"
+#include "bsp_crc.h"
+
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+#define BENCH_CRC_ITERATIONS      200U   /* runs per path and size           */
+#define BENCH_CRC_STACK_WORDS     512U   /* stack of the runner task         */
+#define BENCH_CRC_MAX_BYTES       16384U /* largest buffer timed             */
+#define BENCH_CRC_FLASH_ADDR      0x08020000U /* image, sectors 5 to 7       */
+#define BENCH_CRC_FLASH_BYTES     0x00060000U
+
+//******************************** Defines **********************************//
+
+//******************************* Declaring *********************************//
+
+/**
+ * @brief: Start the CRC suite
+ * @steps:
+ *      1. Start the timestamp source
+ *      2. Create the runner task, it prints the CSV report and deletes itself
+ *
+ * @param[in]  iterations: runs per path and size, 0 means default
+ * @param[in]  crc:        instance with the CRC unit, NULL: software only
+ *
+ * @return bench_status_t: execute result of this function
+ **/
+bench_status_t bench_crc_start ( uint32_t iterations, bsp_crc_t * const crc );
+
+//******************************* Declaring *********************************//
+#endif // __BSP_BENCH_CRC_H__
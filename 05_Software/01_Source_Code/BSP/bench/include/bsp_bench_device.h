@@ -0,0 +1,105 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_bench_device.h
+ *
+ * @par dependencies
+ * - bsp_bench.h
+ * - bsp_device.h
+ *
+ * @author Damian
+ *
+ * @brief Check the device registry, the command worker and the LED stack on
+ *        them against a mock OSAL, and measure a lookup and the two ways of
+ *        an ioctl.
+ *
+ * Processing flow:
+ *
+ * bench_device_start -> runner task -> registry: fill it, look up, refuse
+ *                                   -> races: another registration inside
+ *                                      the open of a device
+ *                                   -> led: the LED handler on a registered
+ *                                      LED device
+ *                                   -> worker: commands posted, the worker
+ *                                      task played by the suite
+ *                                   -> time find and ioctl -> CSV
+ *
+ * Define BENCH_DEVICE_ENABLE in the target options to start the suite from
+ * MX_FREERTOS_Init. Every line mounts the registry again with bsp_core_init
+ * on a mock critical section, which counts its depth and on target also
+ * takes the one of FreeRTOS: the devices registered before the suite are
+ * gone from the registry after it. The suite runs the same on the host
+ * (BENCH_HOST_POSIX) and on target.
+ *
+ * The devices of the suite are of a mock class, their open and close record
+ * the depth of the critical section they run at; the open of one device can
+ * register another one, as a task preempting the open would. The mock queue
+ * copies the commands into a ring, the mock thread only records the worker
+ * task: the suite runs it one command at a time with bsp_worker_run.
+ *
+ *  line        expected
+ *  registry    MAX_BSP_DEVICE_NUM devices found by name, an unknown name
+ *              not found, a name taken, a full registry and a device
+ *              registered twice refused without an open
+ *  name_race   a name taken during the open: refused, the device closed,
+ *              the winner found
+ *  full_race   the last slot taken during the open: refused, the device
+ *              closed, the winner found
+ *  lock        every open and close outside of the critical section, as
+ *              many exits as enters
+ *  led         twinkle of a registered LED, a LED not registered and a
+ *              device of another class refused by the handler
+ *  worker      no worker without queue and thread, the queue deleted when
+ *              the task is not created; commands run in the posting order,
+ *              a device not registered counted failed, every result handed
+ *              to pf_done, a full queue refused
+ *  led_worker  pf_led_ctrl of the handler with a worker returns at once,
+ *              the worker runs the commands in order, a twinkle with the
+ *              setting of the LED when it starts
+ *
+ *  case        time of
+ *  find        bsp_device_find of the last of a full registry
+ *  ioctl       bsp_device_ioctl on the LED, through the vtable
+ *  ioctl_as    BSP_DEVICE_IOCTL_AS( led, ... ), a direct call
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+#ifndef __BSP_BENCH_DEVICE_H__
+#define __BSP_BENCH_DEVICE_H__
+
+//******************************** Includes *********************************//
+
+#include "bsp_bench.h"
+#include "bsp_device.h"
+
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+#define BENCH_DEVICE_ITERATIONS   10000U  /* samples of a case               */
+#define BENCH_DEVICE_STACK_WORDS  512U    /* stack of the runner task        */
+
+//******************************** Defines **********************************//
+
+//******************************* Declaring *********************************//
+
+/**
+ * @brief: Start the device suite
+ * @steps:
+ *      1. Start the timestamp source
+ *      2. Create the runner task, it prints the CSV report and deletes itself
+ *
+ * @param[in]  iterations: samples of a case, 0 means default
+ *
+ * @return bench_status_t: execute result of this function
+ **/
+bench_status_t bench_device_start ( uint32_t iterations );
+
+//******************************* Declaring *********************************//
+#endif // __BSP_BENCH_DEVICE_H__
@@ -0,0 +1,75 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_bench_dsp.h
+ *
+ * @par dependencies
+ * - bsp_bench.h
+ * - bsp_dsp_chain.h
+ *
+ * @author Damian
+ *
+ * @brief Measure the throughput of the DSP chains, one row per chain and
+ *        block size plus the samples per second it sustains.
+ *
+ * Processing flow:
+ *
+ * bench_dsp_start -> runner task -> for each chain and block size:
+ *                    dsp_chain_inst + stages -> dsp_chain_process (N times)
+ *                 -> CSV row + "# chain,block,samples/s" comment line
+ *
+ * Define BENCH_DSP_ENABLE in the target options to start the suite from
+ * MX_FREERTOS_Init. The mode column is the chain, the case column the block
+ * size. One sample is one dsp_chain_process call.
+ *
+ * fir:      BENCH_DSP_TAPS taps FIR
+ * decimate: FIR, then decimation by BENCH_DSP_DECIMATE
+ * spectrum: RFFT, magnitude, statistics
+ * full:     FIR, decimation, RFFT, magnitude, statistics
+ *
+ * The suite only needs the chain module, the portable C sources of
+ * CMSIS-DSP and the bench core, so the same file runs on the host against
+ * the FreeRTOS POSIX port with BENCH_HOST_POSIX defined.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+#ifndef __BSP_BENCH_DSP_H__
+#define __BSP_BENCH_DSP_H__
+
+//******************************** Includes *********************************//
+
+#include "bsp_bench.h"
+
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+#define BENCH_DSP_ITERATIONS    200U      /* samples per case                */
+#define BENCH_DSP_STACK_WORDS   256U      /* stack of the runner task        */
+#define BENCH_DSP_TAPS          31U       /* taps of the FIR stages          */
+#define BENCH_DSP_DECIMATE      2U        /* factor of the decimate stages   */
+
+//******************************** Defines **********************************//
+
+//******************************* Declaring *********************************//
+
+/**
+ * @brief: Start the DSP chain suite
+ * @steps:
+ *      1. Start the timestamp source
+ *      2. Create the runner task, it prints the CSV report and deletes itself
+ *
+ * @param[in]  iterations: samples per case, 0 means default
+ *
+ * @return bench_status_t: execute result of this function
+ **/
+bench_status_t bench_dsp_start ( uint32_t iterations );
+
+//******************************* Declaring *********************************//
+#endif // __BSP_BENCH_DSP_H__
@@ -0,0 +1,79 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_bench_dsp_feature.h
+ *
+ * @par dependencies
+ * - bsp_bench.h
+ * - bsp_dsp_feature.h
+ *
+ * @author Damian
+ *
+ * @brief Measure the streaming feature extraction per hop and check it
+ *        against the NumPy reference of 08_Tools/dsp_feature.
+ *
+ * Processing flow:
+ *
+ * bench_dsp_feature_start -> runner task -> for each reference case:
+ *                            dsp_feature_inst -> feed the test signal hop by
+ *                            hop, compare every column with the reference
+ *                         -> dsp_feature_to_s8, compare the int8 tensor
+ *                         -> keep streaming the signal until N hops timed
+ *                         -> CSV row + "# mode,case,frame,load,err,result"
+ *
+ * Define BENCH_DSP_FEATURE_ENABLE in the target options to start the suite
+ * from MX_FREERTOS_Init. The mode column is "mfcc" or "logmel", the case
+ * column the hop length. One sample is one dsp_feature_process call.
+ *
+ * The load is the time of one hop over the time the hop takes to arrive at
+ * the sample rate, in tenths of a percent. The error is the largest
+ * difference of a float column to the double reference in millionths, it
+ * has to stay below BENCH_DSP_FEATURE_TOL; the int8 spectrogram may differ
+ * by one step where a value sits on a rounding edge. Otherwise the suite
+ * prints MISMATCH.
+ *
+ * The suite only needs the feature and chain modules, the portable C
+ * sources of CMSIS-DSP and the bench core, so the same file runs on the
+ * host against the FreeRTOS POSIX port with BENCH_HOST_POSIX defined.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+#ifndef __BSP_BENCH_DSP_FEATURE_H__
+#define __BSP_BENCH_DSP_FEATURE_H__
+
+//******************************** Includes *********************************//
+
+#include "bsp_bench.h"
+
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+#define BENCH_DSP_FEATURE_ITERATIONS  100U  /* hops timed per case           */
+#define BENCH_DSP_FEATURE_STACK_WORDS 256U  /* stack of the runner task      */
+#define BENCH_DSP_FEATURE_TOL         1000U /* max column error, millionths  */
+
+//******************************** Defines **********************************//
+
+//******************************* Declaring *********************************//
+
+/**
+ * @brief: Start the feature extraction suite
+ * @steps:
+ *      1. Start the timestamp source
+ *      2. Create the runner task, it prints the CSV report and deletes itself
+ *
+ * @param[in]  iterations: hops timed per case, 0 means default
+ *
+ * @return bench_status_t: execute result of this function
+ **/
+bench_status_t bench_dsp_feature_start ( uint32_t iterations );
+
+//******************************* Declaring *********************************//
+#endif // __BSP_BENCH_DSP_FEATURE_H__
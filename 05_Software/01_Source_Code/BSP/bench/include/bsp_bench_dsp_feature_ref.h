@@ -0,0 +1,63 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_bench_dsp_feature_ref.h
+ *
+ * @par dependencies
+ * - bsp_dsp_feature.h
+ *
+ * @author Damian
+ *
+ * @brief Reference of the feature bench: the test signal, the float column
+ *        of every hop and the int8 spectrogram after the last hop.
+ *
+ * Processing flow:
+ *
+ * bench_dsp_feature_ref_case[i] -> dsp_feature_inst( &feat, &case->cfg )
+ *
+ * Generated by 08_Tools/dsp_feature/dsp_feature_ref.py --seed 1,
+ * do not edit.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+#ifndef __BSP_BENCH_DSP_FEATURE_REF_H__
+#define __BSP_BENCH_DSP_FEATURE_REF_H__
+
+//******************************** Includes *********************************//
+
+#include "bsp_dsp_feature.h"
+
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+#define BENCH_DSP_FEATURE_REF_LEN     2048U /* samples of the signal  */
+#define BENCH_DSP_FEATURE_REF_CASES   5U    /* cases                  */
+
+typedef struct
+{
+    const char            * mode;                     /* "mfcc" / "logmel"   */
+    const char            * case_name;                /* "hop_N"             */
+    dsp_feature_cfg_t     cfg;                        /* feature config      */
+    uint32_t              hops;                       /* hops of the signal  */
+    const float32_t       * columns;                  /* [hops, coeff_num]   */
+    const int8_t          * tensor;                   /* [columns, coeff]    */
+} bench_dsp_feature_ref_t;
+
+//******************************** Defines **********************************//
+
+//******************************* Declaring *********************************//
+
+extern const int16_t bench_dsp_feature_ref_signal[BENCH_DSP_FEATURE_REF_LEN];
+extern const bench_dsp_feature_ref_t
+                bench_dsp_feature_ref_case[BENCH_DSP_FEATURE_REF_CASES];
+
+//******************************* Declaring *********************************//
+#endif // __BSP_BENCH_DSP_FEATURE_REF_H__
+
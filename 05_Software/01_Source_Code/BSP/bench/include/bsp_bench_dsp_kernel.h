@@ -0,0 +1,96 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_bench_dsp_kernel.h
+ *
+ * @par dependencies
+ * - bsp_bench.h
+ * - bsp_dsp_chain.h
+ *
+ * @author Damian
+ *
+ * @brief Compare the variants of the CMSIS-DSP kernels, one row per variant
+ *        and size plus the throughput and the SNR against a double reference.
+ *
+ * Processing flow:
+ *
+ * bench_dsp_kernel_start -> runner task -> for each kernel, size and variant:
+ *                           run the kernel N times -> CSV row
+ *                        -> run once more, compare with the double reference
+ *                        -> "# mode,case,rate,snr" comment line
+ *
+ * Define BENCH_DSP_KERNEL_ENABLE in the target options to start the suite
+ * from MX_FREERTOS_Init. The mode column is the variant, the case column the
+ * size. One sample is one kernel call.
+ *
+ * fir_f32 / fir_q31 / fir_q31_fast / fir_q15 / fir_q15_fast:
+ *      BENCH_DSP_KERNEL_TAPS taps low pass, case block_n, rate in samples
+ * cfft_radix2 / cfft_radix4 / cfft_mixed:
+ *      forward complex FFT, case len_n, rate in points, radix4 only on powers
+ *      of four
+ * mat_f32 / mat_q31 / mat_q31_fast / mat_q15 / mat_q15_fast:
+ *      n x n times n x n, case dim_n, rate in multiply accumulates
+ *
+ * The fixed point variants take the float input rounded to q31 / q15, the
+ * reference is the same operation in double on the float input, so the SNR
+ * holds the quantisation and the arithmetic error together. Rates are in
+ * thousands per second. The SNR is capped at 999.9 dB.
+ *
+ * The vendored CMSIS-DSP has no arm_common_tables.c, the FFT tables are built
+ * at run time by dsp_cfft_tables_build; radix2 and radix4 share the twiddles
+ * of the mixed radix CFFT.
+ *
+ * The suite only needs the chain module, the portable C sources of
+ * CMSIS-DSP and the bench core, so the same file runs on the host against
+ * the FreeRTOS POSIX port with BENCH_HOST_POSIX defined. The host build runs
+ * the larger sizes.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+#ifndef __BSP_BENCH_DSP_KERNEL_H__
+#define __BSP_BENCH_DSP_KERNEL_H__
+
+//******************************** Includes *********************************//
+
+#include "bsp_bench.h"
+
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+#define BENCH_DSP_KERNEL_ITERATIONS   100U  /* samples per case              */
+#define BENCH_DSP_KERNEL_STACK_WORDS  256U  /* stack of the runner task      */
+#define BENCH_DSP_KERNEL_TAPS         32U   /* FIR taps, q15 needs even      */
+
+#ifdef BENCH_HOST_POSIX
+#define BENCH_DSP_KERNEL_FFT_MAX      1024U /* largest CFFT length           */
+#define BENCH_DSP_KERNEL_MAT_MAX      32U   /* largest matrix dimension      */
+#else
+#define BENCH_DSP_KERNEL_FFT_MAX      256U  /* largest CFFT length           */
+#define BENCH_DSP_KERNEL_MAT_MAX      16U   /* largest matrix dimension      */
+#endif /* BENCH_HOST_POSIX */
+
+//******************************** Defines **********************************//
+
+//******************************* Declaring *********************************//
+
+/**
+ * @brief: Start the DSP kernel suite
+ * @steps:
+ *      1. Start the timestamp source
+ *      2. Create the runner task, it prints the CSV report and deletes itself
+ *
+ * @param[in]  iterations: samples per case, 0 means default
+ *
+ * @return bench_status_t: execute result of this function
+ **/
+bench_status_t bench_dsp_kernel_start ( uint32_t iterations );
+
+//******************************* Declaring *********************************//
+#endif // __BSP_BENCH_DSP_KERNEL_H__
@@ -0,0 +1,102 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_bench_evlog.h
+ *
+ * @par dependencies
+ * - bsp_bench.h
+ * - bsp_evlog.h
+ *
+ * @author Damian
+ *
+ * @brief Check the flash event journal against simulated sectors and a
+ *        simulated clock charged with the F411 flash timings: sequence
+ *        and payload round trip, power loss, endurance and budget.
+ *
+ * Processing flow:
+ *
+ * bench_evlog_start -> runner task -> roundtrip: records across a wrap of
+ *                                    the ring -> flush -> remount -> walk
+ *                                 -> power_loss: for every cut point k
+ *                                    blank ring -> records, power lost at
+ *                                    flash operation k -> remount -> walk
+ *                                    -> more records -> remount -> walk
+ *                                 -> endurance: N records at a steady rate,
+ *                                    service every EVLOG_SERVICE_MS
+ *                                 -> burst: records with no service
+ *                                 -> time write / mount -> CSV
+ *
+ * Define BENCH_EVLOG_ENABLE in the target options to start the suite from
+ * MX_FREERTOS_Init. The journal runs on RAM arrays, never on the real
+ * sectors, and the writer task is not started: the runner calls
+ * evlog_service itself. Every simulated erase or program moves the clock
+ * by its typical F411 time, so busy and stall are the flash ones and the
+ * budget works as on the target. A cut during a program clears a random
+ * part of the bits still to clear, a cut during an erase leaves a random
+ * part of the sector erased.
+ *
+ * The walk reads the ring oldest first like evlog_dump and checks the
+ * sequence numbers follow each other and every payload is the one written.
+ *
+ *  line         expected
+ *  roundtrip    every record still in the ring read back, the remount
+ *               continues the sequence
+ *  power_loss   nothing written before the lost page missing or mangled,
+ *               no word programmed twice
+ *  endurance    erases per million records, write amplification (flash
+ *               bytes per record byte), flash busy per second, no drop
+ *  burst        the RAM pages take EVLOG_RAM_PAGES pages, the rest dropped
+ *
+ * Nothing here needs the hardware, so the same file runs on the host
+ * against the FreeRTOS POSIX port with BENCH_HOST_POSIX defined.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+#ifndef __BSP_BENCH_EVLOG_H__
+#define __BSP_BENCH_EVLOG_H__
+
+//******************************** Includes *********************************//
+
+#include "bsp_bench.h"
+
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+#define BENCH_EVLOG_ITERATIONS    1000U  /* writes and mounts timed          */
+#define BENCH_EVLOG_STACK_WORDS   512U   /* stack of the runner task         */
+#define BENCH_EVLOG_RATE_HZ       20U    /* records per second, endurance    */
+#ifdef BENCH_HOST_POSIX
+#define BENCH_EVLOG_SECTOR0_BYTES 16384U /* same as sectors 3 and 4          */
+#define BENCH_EVLOG_SECTOR1_BYTES 65536U
+#define BENCH_EVLOG_RECORDS       1000000U
+#else
+#define BENCH_EVLOG_SECTOR0_BYTES 2048U  /* two of them in the SRAM          */
+#define BENCH_EVLOG_SECTOR1_BYTES 4096U
+#define BENCH_EVLOG_RECORDS       100000U
+#endif /* BENCH_HOST_POSIX */
+
+//******************************** Defines **********************************//
+
+//******************************* Declaring *********************************//
+
+/**
+ * @brief: Start the event journal suite
+ * @steps:
+ *      1. Start the timestamp source
+ *      2. Create the runner task, it prints the CSV report and deletes itself
+ *
+ * @param[in]  iterations: writes and mounts timed, 0 means default
+ *
+ * @return bench_status_t: execute result of this function
+ **/
+bench_status_t bench_evlog_start ( uint32_t iterations );
+
+//******************************* Declaring *********************************//
+#endif // __BSP_BENCH_EVLOG_H__
@@ -0,0 +1,76 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_bench_fpu.h
+ *
+ * @par dependencies
+ * - bsp_bench.h
+ *
+ * @author Damian
+ *
+ * @brief Measure the float kernel throughput and the context switch cost
+ *        with and without FPU context.
+ *
+ * Processing flow:
+ *
+ * bench_fpu_start -> runner task -> kernel rows -> ctx_switch rows
+ *
+ * Define BENCH_FPU_ENABLE in the target options to start the suite from
+ * MX_FREERTOS_Init.
+ *
+ * kernel:     one sample is one block of BENCH_FPU_BLOCK samples through a
+ *             BENCH_FPU_TAPS taps FIR (float and q15) or a biquad (float).
+ *             Building the target without the FPU (Floating Point Hardware
+ *             "Not Used") gives the soft-float numbers of the same rows.
+ * ctx_switch: one sample is a notification round trip between two fresh
+ *             tasks, i.e. two context switches. In "int_only" the tasks never
+ *             touch the FPU, in "fpu_ctx" both ran a float instruction first,
+ *             so the ARM_CM4F port saves s16-s31 and the lazily stacked
+ *             s0-s15 on every switch.
+ *
+ * The ARM_CM4F port keeps lazy stacking (FPCCR.ASPEN and LSPEN) on, so the
+ * FPU context is per-task opt-in: a task pays for it only once it executed a
+ * float instruction, and needs 33 more stack words from then on.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+#ifndef __BSP_BENCH_FPU_H__
+#define __BSP_BENCH_FPU_H__
+
+//******************************** Includes *********************************//
+
+#include "bsp_bench.h"
+
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+#define BENCH_FPU_ITERATIONS    1000U     /* samples per case                */
+#define BENCH_FPU_STACK_WORDS   256U      /* stack of the runner and peers   */
+#define BENCH_FPU_BLOCK         64U       /* samples of a kernel block       */
+#define BENCH_FPU_TAPS          16U       /* taps of the FIR kernels         */
+
+//******************************** Defines **********************************//
+
+//******************************* Declaring *********************************//
+
+/**
+ * @brief: Start the FPU suite
+ * @steps:
+ *      1. Start the timestamp source
+ *      2. Create the runner task, it prints the CSV report and deletes itself
+ *
+ * @param[in]  iterations: samples per case, 0 means default
+ *
+ * @return bench_status_t: execute result of this function
+ **/
+bench_status_t bench_fpu_start ( uint32_t iterations );
+
+//******************************* Declaring *********************************//
+#endif // __BSP_BENCH_FPU_H__
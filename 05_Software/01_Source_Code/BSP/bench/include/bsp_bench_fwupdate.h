@@ -0,0 +1,85 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_bench_fwupdate.h
+ *
+ * @par dependencies
+ * - bsp_bench.h
+ * - bsp_fw_update.h
+ *
+ * @author Damian
+ *
+ * @brief Simulate the A/B slots in RAM and check the firmware receiver
+ *        resumes after power cuts and a bad link, and the boot choice.
+ *
+ * Processing flow:
+ *
+ * bench_fwupdate_start -> runner task -> install: image v1 in slot A
+ *                                     -> clean: v2 into B, no fault
+ *                                     -> resume: rounds of an update with
+ *                                        power cuts in the flash writes and
+ *                                        erases, frames lost or corrupted,
+ *                                        every round cut and resumed once
+ *                                        at least
+ *                                     -> boot: trials, rejection, fall back,
+ *                                        confirmation, BEGIN refused
+ *                                     -> cost per block -> CSV
+ *
+ * Define BENCH_FWUPDATE_ENABLE in the target options to start the suite
+ * from MX_FREERTOS_Init. Its slots are RAM arrays of BENCH_FW_SLOT_BYTES:
+ * the flash only clears bits, a cut leaves the word being written with a
+ * part of its bits, an erase cut a part of the words erased. After a cut
+ * the receiver starts again from the flash alone, like after a reset, and
+ * the host part (the logic of 08_Tools/fwupdate/fw_send.py) asks where to
+ * resume.
+ *
+ * "# link" gives the bytes on the wire per image and the time at 115200
+ * baud, "# resume" the bytes sent again because of the cuts.
+ *
+ * Nothing here needs the hardware, so the same file runs on the host
+ * against the FreeRTOS POSIX port with BENCH_HOST_POSIX defined.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+#ifndef __BSP_BENCH_FWUPDATE_H__
+#define __BSP_BENCH_FWUPDATE_H__
+
+//******************************** Includes *********************************//
+
+#include "bsp_bench.h"
+#include "bsp_fw_update.h"
+
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+#define BENCH_FW_ROUNDS           200U   /* updates with faults              */
+#define BENCH_FW_STACK_WORDS      512U   /* stack of the runner task         */
+#define BENCH_FW_SLOT_BYTES       0x4000U /* simulated slot, 16 KiB          */
+#define BENCH_FW_IMAGE_BYTES      15000U /* 14 blocks and a short one        */
+#define BENCH_FW_BAUD             115200U
+
+//******************************** Defines **********************************//
+
+//******************************* Declaring *********************************//
+
+/**
+ * @brief: Start the firmware update suite
+ * @steps:
+ *      1. Start the timestamp source
+ *      2. Create the runner task, it prints the CSV report and deletes itself
+ *
+ * @param[in]  rounds: updates with faults, 0 means default
+ *
+ * @return bench_status_t: execute result of this function
+ **/
+bench_status_t bench_fwupdate_start ( uint32_t rounds );
+
+//******************************* Declaring *********************************//
+#endif // __BSP_BENCH_FWUPDATE_H__
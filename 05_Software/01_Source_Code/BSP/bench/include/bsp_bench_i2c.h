@@ -0,0 +1,114 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_bench_i2c.h
+ *
+ * @par dependencies
+ * - bsp_bench.h
+ * - bsp_i2c.h
+ *
+ * @author Damian
+ *
+ * @brief Check the I2C bus manager against a mock bus of register devices:
+ *        order of the chains, NACK, bus errors, a stuck bus and its
+ *        recovery, the watch, batches and samplers, and measure its CPU
+ *        cost and the bus time of a merged batch.
+ *
+ * Processing flow:
+ *
+ * bench_i2c_start -> runner task -> check: BENCH_I2C_USERS submitters queue
+ *                                   chains at random on three devices and
+ *                                   a missing one, the bus ends them at
+ *                                   random: done, NACK, bus error; stuck
+ *                                   starts, cancels, the watch of i2c_poll
+ *                                -> recover: stuck bus, bus error, NACK
+ *                                -> timeout: the watch, i2c_transfer
+ *                                   behind a chain and running
+ *                                -> batch: i2c_batch_read merging runs
+ *                                -> sampler: two sensors from i2c_poll
+ *                                -> throughput: a batch merged against
+ *                                   register by register -> CSV
+ *
+ * Define BENCH_I2C_ENABLE in the target options to start the suite from
+ * MX_FREERTOS_Init. The bus under test has the mock for its hardware, never
+ * the I2C of the board: the runner plays the DMA interrupt, it calls
+ * i2c_done_isr after the transactions the mock started.
+ *
+ * The mock devices are 256 registers with auto-increment, the bus counts
+ * the bits a transaction takes on the wire. It counts what breaks the bus
+ * rules: a start while one runs, a start or a recovery while the bus is
+ * not free, a bus left to be freed with nothing running.
+ *
+ *  line         expected
+ *  check        chains started in submit order, never interleaved, the
+ *               registers read as the submitter wrote them, the rest of a
+ *               chain failed after a NACK, an error or a cancel, one
+ *               recovery per bus error, refused start and abort, no gap
+ *  recover      a stuck bus refuses the start, the chain fails, freed at
+ *               once; after a bus error nothing starts until i2c_poll; a
+ *               NACK fails its chain only
+ *  timeout      a transaction hung: aborted by i2c_poll after timeout_ms,
+ *               I2C_ERRORTIMEOUT, the next one runs; i2c_transfer returns
+ *               I2C_ERRORTIMEOUT behind a hung chain and running
+ *  batch        runs of registers one transaction each, the data of every
+ *               register, I2C_ERRORNOMEMORY for a chain too long
+ *  sampler      every period sampled, every sample of one instant, a hung
+ *               sensor an overrun of its own periods only
+ *  throughput   bits on the wire of a sensor read merged and one by one,
+ *               reads per second at 400 kHz
+ *
+ *  case          time of
+ *  submit_idle   i2c_submit on an idle bus, up to the DMA start
+ *  done_next     i2c_done_isr starting the next transaction
+ *  done_last     i2c_done_isr of the last queued transaction
+ *  end_to_start  i2c_done_isr entry to the next start
+ *  poll          i2c_poll of two samplers, none due
+ *
+ * Nothing here needs the hardware, so the same file runs on the host
+ * against the FreeRTOS POSIX port with BENCH_HOST_POSIX defined.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+#ifndef __BSP_BENCH_I2C_H__
+#define __BSP_BENCH_I2C_H__
+
+//******************************** Includes *********************************//
+
+#include "bsp_bench.h"
+#include "bsp_i2c.h"
+
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+#define BENCH_I2C_ITERATIONS      2000U  /* random steps of the check        */
+#define BENCH_I2C_STACK_WORDS     512U   /* stack of the runner task         */
+#define BENCH_I2C_USERS           4U     /* submitters                       */
+#define BENCH_I2C_CHAIN           3U     /* transactions of a chain at most  */
+#define BENCH_I2C_BYTES           8U     /* of a transaction at most         */
+#define BENCH_I2C_SAMPLE_MS       2000U  /* sampled time of the sampler line */
+
+//******************************** Defines **********************************//
+
+//******************************* Declaring *********************************//
+
+/**
+ * @brief: Start the I2C suite
+ * @steps:
+ *      1. Start the timestamp source
+ *      2. Create the runner task, it prints the CSV report and deletes itself
+ *
+ * @param[in]  iterations: random steps of the check, 0 means default
+ *
+ * @return bench_status_t: execute result of this function
+ **/
+bench_status_t bench_i2c_start ( uint32_t iterations );
+
+//******************************* Declaring *********************************//
+#endif // __BSP_BENCH_I2C_H__
@@ -0,0 +1,89 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_bench_key.h
+ *
+ * @par dependencies
+ * - bsp_bench.h
+ * - bsp_key_driver.h
+ *
+ * @author Damian
+ *
+ * @brief Replay bounce waveforms against the key state machine, check the
+ *        events it reports and measure the cost of a step.
+ *
+ * Processing flow:
+ *
+ * bench_key_start -> runner task -> click, double, long: recorded bounces,
+ *                                   the events against the expected ones
+ *                                -> random: bounced gestures against a
+ *                                   bounce-free twin of the same key
+ *                                -> time the steps of the random line -> CSV
+ *
+ * Define BENCH_KEY_ENABLE in the target options to start the suite from
+ * MX_FREERTOS_Init. The suite plays the pin of the key through the
+ * key_operation_t of a mocked key, so it runs the same on the host
+ * (BENCH_HOST_POSIX) and on target. Time moves in steps of 1 ms: every
+ * edge seen with the interrupt unmasked masks it and runs key_process in
+ * the same millisecond, as key_handler_irq and the handler task do, and so
+ * does a deadline of key_next_deadline.
+ *
+ * A bounce is up to BENCH_KEY_BOUNCE_MAX toggles inside the debounce window
+ * of an edge. The random line starts BENCH_KEY_WRAP_LEAD_MS before the wrap
+ * of the millisecond time.
+ *
+ *  line     expected
+ *  click    press, release, click after the double-click window
+ *  double   press, release, press, release, double click
+ *  long     press, long press, repeats, release
+ *  random   the events of the twin, on the same millisecond, every event
+ *           type seen
+ *  all      one interrupt per debounced edge
+ *
+ *  case       time of
+ *  process    key_process
+ *  deadline   key_next_deadline
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+#ifndef __BSP_BENCH_KEY_H__
+#define __BSP_BENCH_KEY_H__
+
+//******************************** Includes *********************************//
+
+#include "bsp_bench.h"
+#include "bsp_key_driver.h"
+
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+#define BENCH_KEY_ITERATIONS      2000U   /* gestures of the random line     */
+#define BENCH_KEY_STACK_WORDS     512U    /* stack of the runner task        */
+#define BENCH_KEY_BOUNCE_MAX      6U      /* toggles after an edge, even     */
+#define BENCH_KEY_WRAP_LEAD_MS    5000U   /* random line: time before wrap   */
+
+//******************************** Defines **********************************//
+
+//******************************* Declaring *********************************//
+
+/**
+ * @brief: Start the key suite
+ * @steps:
+ *      1. Start the timestamp source
+ *      2. Create the runner task, it prints the CSV report and deletes itself
+ *
+ * @param[in]  iterations: gestures of the random line, 0 means default
+ *
+ * @return bench_status_t: execute result of this function
+ **/
+bench_status_t bench_key_start ( uint32_t iterations );
+
+//******************************* Declaring *********************************//
+#endif // __BSP_BENCH_KEY_H__
@@ -0,0 +1,91 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_bench_kv.h
+ *
+ * @par dependencies
+ * - bsp_bench.h
+ * - bsp_kv.h
+ *
+ * @author Damian
+ *
+ * @brief Check the flash key/value store against a simulated flash with
+ *        power loss injected at every flash operation, and measure get,
+ *        set, mount and compaction.
+ *
+ * Processing flow:
+ *
+ * bench_kv_start -> runner task -> basic: set / get / delete / remount
+ *                              -> power_loss: for every cut point k
+ *                                 blank flash -> workload, power lost at
+ *                                 flash operation k -> remount -> every key
+ *                                 holds its old or its new value -> set all
+ *                                 keys, remount, check again
+ *                              -> wear: N sets, erases of each sector
+ *                              -> time get / set / mount / compact -> CSV
+ *
+ * Define BENCH_KV_ENABLE in the target options to start the suite from
+ * MX_FREERTOS_Init. The store runs on a RAM array, never on the real
+ * sectors. The simulated flash behaves like the F411 one: an erase sets
+ * the words to 0xFFFFFFFF, programming can only clear bits. A cut during a
+ * program clears a random part of the bits still to clear, a cut during an
+ * erase leaves a random part of the sector erased. Every later operation
+ * fails until the "reboot".
+ *
+ *  line         expected
+ *  basic        get returns what set wrote, after a remount too
+ *  power_loss   no key lost or mangled at any cut point, no word
+ *               programmed twice
+ *  wear         both sectors erased the same number of times, +-1
+ *
+ * The mount row times the scan of a full sector of BENCH_KV_SECTOR_BYTES,
+ * the worst case at boot.
+ *
+ * Nothing here needs the hardware, so the same file runs on the host
+ * against the FreeRTOS POSIX port with BENCH_HOST_POSIX defined.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+#ifndef __BSP_BENCH_KV_H__
+#define __BSP_BENCH_KV_H__
+
+//******************************** Includes *********************************//
+
+#include "bsp_bench.h"
+
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+#define BENCH_KV_ITERATIONS       1000U  /* gets, sets and mounts timed      */
+#define BENCH_KV_STACK_WORDS      512U   /* stack of the runner task         */
+#ifdef BENCH_HOST_POSIX
+#define BENCH_KV_SECTOR_BYTES     16384U /* same as sectors 1 and 2          */
+#else
+#define BENCH_KV_SECTOR_BYTES     4096U  /* two of them in the SRAM          */
+#endif /* BENCH_HOST_POSIX */
+
+//******************************** Defines **********************************//
+
+//******************************* Declaring *********************************//
+
+/**
+ * @brief: Start the key/value store suite
+ * @steps:
+ *      1. Start the timestamp source
+ *      2. Create the runner task, it prints the CSV report and deletes itself
+ *
+ * @param[in]  iterations: gets, sets and mounts timed, 0 means default
+ *
+ * @return bench_status_t: execute result of this function
+ **/
+bench_status_t bench_kv_start ( uint32_t iterations );
+
+//******************************* Declaring *********************************//
+#endif // __BSP_BENCH_KV_H__
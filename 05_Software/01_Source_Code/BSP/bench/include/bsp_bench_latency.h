@@ -0,0 +1,77 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_bench_latency.h
+ *
+ * @par dependencies
+ * - bsp_bench.h
+ *
+ * @author Damian
+ *
+ * @brief Measure how long it takes for a FreeRTOS primitive to wake a task,
+ *        both from another task and from an ISR.
+ *
+ * Processing flow:
+ *
+ * bench_latency_start -> runner task -> one CSV row per (mode, primitive)
+ *
+ * Define BENCH_LATENCY_ENABLE in the target options to start the suite from
+ * MX_FREERTOS_Init.
+ *
+ * The runner runs at tskIDLE_PRIORITY + 1 and the receiver at the highest
+ * priority, so every give/send preempts the runner immediately. A sample is
+ * the delta between the timestamp taken right before the give (in the runner
+ * or in the software triggered ISR) and the one taken right after the take
+ * returns in the receiver.
+ *
+ * The os2_evt_flags and bsp_signal cases compare the CMSIS-RTOS2 event flags
+ * (timer daemon hop from ISR) with the notification based bsp_signal_t.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+#ifndef __BSP_BENCH_LATENCY_H__
+#define __BSP_BENCH_LATENCY_H__
+
+//******************************** Includes *********************************//
+
+#include "bsp_bench.h"
+
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+#define BENCH_LATENCY_ITERATIONS   1000U      /* samples per primitive       */
+#define BENCH_LATENCY_STACK_WORDS  256U       /* stack of runner & receiver  */
+
+#ifndef BENCH_HOST_POSIX
+/* Spare vector pended by software to run the ISR-to-task cases, must not  */
+/* be used by any peripheral of the project.                               */
+#define BENCH_SWI_IRQn             SPI5_IRQn
+#define BENCH_SWI_IRQHandler       SPI5_IRQHandler
+#define BENCH_SWI_PRIORITY         6U         /* must be >= MAX_SYSCALL prio */
+#endif /* BENCH_HOST_POSIX */
+
+//******************************** Defines **********************************//
+
+//******************************* Declaring *********************************//
+
+/**
+ * @brief: Start the latency suite
+ * @steps:
+ *      1. Start the timestamp source
+ *      2. Create the runner task, it prints the CSV report and deletes itself
+ *
+ * @param[in]  iterations: samples per primitive, 0 means default
+ *
+ * @return bench_status_t: execute result of this function
+ **/
+bench_status_t bench_latency_start ( uint32_t iterations );
+
+//******************************* Declaring *********************************//
+#endif // __BSP_BENCH_LATENCY_H__
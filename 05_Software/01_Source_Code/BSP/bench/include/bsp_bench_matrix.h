@@ -0,0 +1,104 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_bench_matrix.h
+ *
+ * @par dependencies
+ * - bsp_bench.h
+ * - bsp_matrix.h
+ *
+ * @author Damian
+ *
+ * @brief Check the LED matrix scan engine against a mock slot timer and
+ *        shift chain: the slots at the clocks of the profiles, the bit
+ *        planes, the light of every pixel in every frame, frames of one
+ *        image while the images change, and measure the cost of a frame.
+ *
+ * Processing flow:
+ *
+ * bench_matrix_start -> runner task -> timing: sizes, bits and refresh
+ *                                      rates at clocks from 10 MHz down
+ *                                   -> encode: random rows, bit by bit
+ *                                   -> scan: matrices of 1x1 to 16x16, the
+ *                                      light of the pixels frame by frame
+ *                                   -> tear, clock, stop, led
+ *                                   -> time show and the interrupt -> CSV
+ *
+ * Define BENCH_MATRIX_ENABLE in the target options to start the suite from
+ * MX_FREERTOS_Init. The matrix under test has the mock for its hardware,
+ * never TIM4 of the board: the runner plays the timer, it ends the slot
+ * on the outputs after its preloaded ticks and calls matrix_timer_isr.
+ *
+ * The outputs are read as an eye would: a pixel lit in a slot gathers the
+ * ticks of the slot, a frame is rows * bits slots from the first one after
+ * the start. Its light must be level * base ticks for every pixel, level
+ * the top bits of the brightness of one image, the frame as long as the
+ * timing says. Light of two images in one frame is a tear.
+ *
+ *  line         expected
+ *  timing       the base nearest to the refresh rate, refused when shorter
+ *               than MATRIX_MIN_SLOT_NS or its longest slot over
+ *               MATRIX_MAX_PERIOD; the refresh rate it gives
+ *  encode       column x in bit x % 8 from the top of byte x / 8 of plane
+ *               b when bit b of the level is set
+ *  scan         every frame of the image shown, rows in order, slots of
+ *               base << plane, the refresh rate measured on the outputs
+ *  tear         show at random slots: every frame one whole image in the
+ *               order shown, every image swapped in or skipped, the last
+ *               one on at the end
+ *  clock        a new timer clock from the next image on, a too slow one
+ *               refused and the scan going on
+ *  stop         outputs blank, no slot after it, show starts again
+ *  led          a pixel as a LED device of the registry, registered in
+ *               bsp_led_handler_t and switched by pf_led_ctrl
+ *
+ *  case          time of
+ *  show          matrix_show of a 16x16 image of 5 bits
+ *  slot          matrix_timer_isr, the load line puts the interrupts and a
+ *                show a frame against the time of a frame
+ *
+ * Nothing here needs the hardware, so the same file runs on the host
+ * against the FreeRTOS POSIX port with BENCH_HOST_POSIX defined.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+#ifndef __BSP_BENCH_MATRIX_H__
+#define __BSP_BENCH_MATRIX_H__
+
+//******************************** Includes *********************************//
+
+#include "bsp_bench.h"
+#include "bsp_matrix.h"
+
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+#define BENCH_MATRIX_ROUNDS       50U    /* encode and tear repeats          */
+#define BENCH_MATRIX_STACK_WORDS  512U   /* stack of the runner task         */
+#define BENCH_MATRIX_FRAMES       4U     /* scanned for each image           */
+
+//******************************** Defines **********************************//
+
+//******************************* Declaring *********************************//
+
+/**
+ * @brief: Start the LED matrix suite
+ * @steps:
+ *      1. Start the timestamp source
+ *      2. Create the runner task, it prints the CSV report and deletes itself
+ *
+ * @param[in]  rounds: repeats of the random cases, 0 means default
+ *
+ * @return bench_status_t: execute result of this function
+ **/
+bench_status_t bench_matrix_start ( uint32_t rounds );
+
+//******************************* Declaring *********************************//
+#endif // __BSP_BENCH_MATRIX_H__
@@ -0,0 +1,74 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_bench_nn.h
+ *
+ * @par dependencies
+ * - bsp_bench.h
+ * - bsp_nn_runtime.h
+ * - bsp_nn_model_demo.h
+ *
+ * @author Damian
+ *
+ * @brief Measure the inference time of the nn runtime and check its output
+ *        under the offline arena plan and the runtime first fit.
+ *
+ * Processing flow:
+ *
+ * bench_nn_start -> runner task -> for the offline plan and the first fit:
+ *                   nn_runtime_inst -> copy the test input + nn_runtime_invoke
+ *                   (N times) -> CSV row + "# model,plan,arena,scratch,result"
+ *
+ * Define BENCH_NN_ENABLE in the target options to start the suite from
+ * MX_FREERTOS_Init. The mode column is the model, the case column the arena
+ * plan: "offline" takes the offsets of the generator, "first_fit" the same
+ * model without them, planned by the runtime. One sample is one copy of the
+ * input plus one invoke.
+ *
+ * The output has to equal the expected output of the generator byte for
+ * byte under both plans, otherwise the suite prints MISMATCH and logs an
+ * error. The comment line holds the activation bytes of each plan. On target the
+ * kernels take their DSP paths, on the host (BENCH_HOST_POSIX, FreeRTOS
+ * POSIX port) the C reference paths of CMSIS-NN, both have to be bit exact.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+#ifndef __BSP_BENCH_NN_H__
+#define __BSP_BENCH_NN_H__
+
+//******************************** Includes *********************************//
+
+#include "bsp_bench.h"
+
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+#define BENCH_NN_ITERATIONS     200U      /* samples per case                */
+#define BENCH_NN_STACK_WORDS    256U      /* stack of the runner task        */
+#define BENCH_NN_ARENA_BYTES    2048U     /* activations plus scratch        */
+
+//******************************** Defines **********************************//
+
+//******************************* Declaring *********************************//
+
+/**
+ * @brief: Start the nn runtime suite
+ * @steps:
+ *      1. Start the timestamp source
+ *      2. Create the runner task, it prints the CSV report and deletes itself
+ *
+ * @param[in]  iterations: samples per case, 0 means default
+ *
+ * @return bench_status_t: execute result of this function
+ **/
+bench_status_t bench_nn_start ( uint32_t iterations );
+
+//******************************* Declaring *********************************//
+#endif // __BSP_BENCH_NN_H__
@@ -0,0 +1,87 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_bench_pll.h
+ *
+ * @par dependencies
+ * - bsp_bench.h
+ * - bsp_clock.h
+ *
+ * @author Damian
+ *
+ * @brief Check the PLL solver and the flash latency table of the clock
+ *        profiles against the limits of the F411, and measure a solve.
+ *
+ * Processing flow:
+ *
+ * bench_pll_start -> runner task -> fixed targets: presets, USB, VCO and
+ *                                   divider edges, unreachable ones
+ *                                -> sweep and random targets against an
+ *                                   exhaustive search of M, N, P
+ *                                -> latency edges -> time a solve -> CSV
+ *
+ * Define BENCH_PLL_ENABLE in the target options to start the suite from
+ * MX_FREERTOS_Init. clock_pll_solve and clock_flash_latency touch no
+ * register, the suite runs the same on the host (BENCH_HOST_POSIX) and on
+ * target.
+ *
+ * Every solved PLL must keep M 2..63, N 50..432, P 2, 4, 6 or 8, Q 2..15,
+ * a VCO input of 1..2 MHz, a VCO output of 100..432 MHz, give the target
+ * exactly and the USB clock at most 48 MHz with the smallest Q. It must be
+ * the one of the lowest M (highest VCO input), then the lowest P. A target
+ * is unreachable exactly when the search finds no such PLL.
+ *
+ *  line      expected
+ *  <name>    status and dividers of one fixed target
+ *  sweep     0.1 MHz steps up to BENCH_PLL_SWEEP_MAX_HZ from every source
+ *  random    random targets in Hz, BENCH_PLL_RANDOM_MAX_HZ at most
+ *  latency   wait states at the edges of the table, error above 100 MHz
+ *
+ *  case          time of
+ *  solve         clock_pll_solve, 100 MHz from HSE
+ *  unreachable   clock_pll_solve, no exact match
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+#ifndef __BSP_BENCH_PLL_H__
+#define __BSP_BENCH_PLL_H__
+
+//******************************** Includes *********************************//
+
+#include "bsp_bench.h"
+#include "bsp_clock.h"
+
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+#define BENCH_PLL_ITERATIONS      10000U     /* random targets and samples  */
+#define BENCH_PLL_STACK_WORDS     512U       /* stack of the runner task    */
+#define BENCH_PLL_SWEEP_STEP_HZ   100000U    /* of the sweep line           */
+#define BENCH_PLL_SWEEP_MAX_HZ    220000000U /* above 432 MHz / 2           */
+#define BENCH_PLL_RANDOM_MAX_HZ   250000000U /* of the random line          */
+
+//******************************** Defines **********************************//
+
+//******************************* Declaring *********************************//
+
+/**
+ * @brief: Start the PLL suite
+ * @steps:
+ *      1. Start the timestamp source
+ *      2. Create the runner task, it prints the CSV report and deletes itself
+ *
+ * @param[in]  iterations: random targets and samples, 0 means default
+ *
+ * @return bench_status_t: execute result of this function
+ **/
+bench_status_t bench_pll_start ( uint32_t iterations );
+
+//******************************* Declaring *********************************//
+#endif // __BSP_BENCH_PLL_H__
@@ -0,0 +1,101 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_bench_spi.h
+ *
+ * @par dependencies
+ * - bsp_bench.h
+ * - bsp_spi.h
+ *
+ * @author Damian
+ *
+ * @brief Check the SPI bus manager against a mock DMA engine: order of the
+ *        chains, chip-select, set up of the devices, errors, cancel, and
+ *        measure its CPU cost and the time from a DMA end to the next start.
+ *
+ * Processing flow:
+ *
+ * bench_spi_start -> runner task -> check: BENCH_SPI_USERS submitters queue
+ *                                   chains at random on three devices, the
+ *                                   engine ends transfers at random between,
+ *                                   some fail, some chains are cancelled
+ *                                -> timeout: spi_transfer behind a chain
+ *                                   that never ends, cancelled
+ *                                -> notify (target): the signal of the
+ *                                   last transfer wakes the submitter
+ *                                -> time submit and the end of a transfer
+ *                                   -> CSV
+ *
+ * Define BENCH_SPI_ENABLE in the target options to start the suite from
+ * MX_FREERTOS_Init. The bus under test has the mock for its hardware, never
+ * the SPI of the board: the runner plays the DMA interrupt, it calls
+ * spi_dma_done_isr after every transfer the mock started.
+ *
+ * The mock is a device that answers every byte with a function of the byte
+ * and of the chip-select line, and it counts what breaks the bus rules:
+ * a transfer with no or two chip-selects low, or in the wrong mode, a set
+ * up with a chip-select low or not needed, a start while one runs.
+ *
+ *  line         expected
+ *  check        chains started in submit order, never interleaved, one
+ *               chip-select per chain, the answers in every rx, the rest
+ *               of a chain failed after an error or a cancel, no gap: a
+ *               transfer queued always started before the end returns
+ *  timeout      spi_transfer returns SPI_ERRORTIMEOUT, its chain never
+ *               started, the one after it runs
+ *
+ *  case          time of
+ *  submit_idle   spi_submit on an idle bus, up to the DMA start
+ *  submit_queued spi_submit behind a running transfer
+ *  done_next     spi_dma_done_isr starting the next transfer
+ *  done_last     spi_dma_done_isr of the last queued transfer
+ *  end_to_start  spi_dma_done_isr entry to the next DMA start: the gap on
+ *                the bus between two transfers, without the interrupt entry
+ *
+ * Nothing here needs the hardware, so the same file runs on the host
+ * against the FreeRTOS POSIX port with BENCH_HOST_POSIX defined.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+#ifndef __BSP_BENCH_SPI_H__
+#define __BSP_BENCH_SPI_H__
+
+//******************************** Includes *********************************//
+
+#include "bsp_bench.h"
+#include "bsp_spi.h"
+
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+#define BENCH_SPI_ITERATIONS      2000U  /* random steps of the check        */
+#define BENCH_SPI_STACK_WORDS     512U   /* stack of the runner task         */
+#define BENCH_SPI_USERS           4U     /* submitters                       */
+#define BENCH_SPI_CHAIN           3U     /* transfers per chain at most      */
+#define BENCH_SPI_BYTES           64U    /* per transfer at most             */
+
+//******************************** Defines **********************************//
+
+//******************************* Declaring *********************************//
+
+/**
+ * @brief: Start the SPI suite
+ * @steps:
+ *      1. Start the timestamp source
+ *      2. Create the runner task, it prints the CSV report and deletes itself
+ *
+ * @param[in]  iterations: random steps of the check, 0 means default
+ *
+ * @return bench_status_t: execute result of this function
+ **/
+bench_status_t bench_spi_start ( uint32_t iterations );
+
+//******************************* Declaring *********************************//
+#endif // __BSP_BENCH_SPI_H__
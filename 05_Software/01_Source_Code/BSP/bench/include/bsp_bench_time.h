@@ -0,0 +1,90 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_bench_time.h
+ *
+ * @par dependencies
+ * - bsp_bench.h
+ * - bsp_time.h
+ *
+ * @author Damian
+ *
+ * @brief Check the time service across wraps of the 32-bit cycle counter,
+ *        with the tick interrupt and clock changes preempting its readers,
+ *        and measure the cost of a read.
+ *
+ * Processing flow:
+ *
+ * bench_time_start -> runner task -> wrap: reads across wraps of the
+ *                                    counter, ticks between the reads
+ *                                 -> race: the tick inside the reads
+ *                                 -> clock: rebases inside the reads
+ *                                 -> time the reads and the tick -> CSV
+ *
+ * Define BENCH_TIME_ENABLE in the target options to start the suite from
+ * MX_FREERTOS_Init. On target the wrap line moves CYCCNT forward to
+ * BENCH_TIME_LEAD_MS before its wrap: the time of every user jumps forward
+ * once, never back. The TIM1 tick races the reads for real, the reads it
+ * preempted are counted; the clock line rebases at the same frequency.
+ *
+ * On the host (BENCH_HOST_POSIX) the suite plays the counter: every read
+ * of it advances the time by up to BENCH_TIME_STEP_MAX cycles, and the
+ * race and clock lines run time_tick_isr or time_set_core_clock inside
+ * the reads of the runner, right before or right after the counter is
+ * sampled. Every read is checked against the exact 64-bit count and
+ * microseconds.
+ *
+ *  line    expected
+ *  wrap    cycles and microseconds monotonic, no step of half a wrap,
+ *          BENCH_TIME_WRAPS wraps crossed
+ *  race    the same with the tick preempting the reads
+ *  clock   the same with the core clock changing under the reads
+ *
+ *  case       time of
+ *  cycles     time_get_cycles
+ *  us         time_get_us
+ *  ms         time_get_ms
+ *  tick_isr   time_tick_isr
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+#ifndef __BSP_BENCH_TIME_H__
+#define __BSP_BENCH_TIME_H__
+
+//******************************** Includes *********************************//
+
+#include "bsp_bench.h"
+#include "bsp_time.h"
+
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+#define BENCH_TIME_ITERATIONS     100000U /* reads of a line at least        */
+#define BENCH_TIME_STACK_WORDS    512U    /* stack of the runner task        */
+#define BENCH_TIME_LEAD_MS        500U    /* target: counter before the wrap */
+
+//******************************** Defines **********************************//
+
+//******************************* Declaring *********************************//
+
+/**
+ * @brief: Start the time suite
+ * @steps:
+ *      1. Start the timestamp source
+ *      2. Create the runner task, it prints the CSV report and deletes itself
+ *
+ * @param[in]  iterations: reads of a line at least, 0 means default
+ *
+ * @return bench_status_t: execute result of this function
+ **/
+bench_status_t bench_time_start ( uint32_t iterations );
+
+//******************************* Declaring *********************************//
+#endif // __BSP_BENCH_TIME_H__
@@ -0,0 +1,92 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_bench_watchdog.h
+ *
+ * @par dependencies
+ * - bsp_bench.h
+ * - bsp_watchdog.h
+ *
+ * @author Damian
+ *
+ * @brief Check the watchdog supervisor against a simulated watchdog and
+ *        measure the cost of a check-in and of a supervisor round.
+ *
+ * Processing flow:
+ *
+ * bench_watchdog_start -> runner task -> for each scenario:
+ *                         wdg_supervisor_inst on a simulated clock and
+ *                         watchdog -> step the clock 1 ms at a time, clients
+ *                         check in on their schedule, a round every period
+ *                      -> "# scenario,starved,detect,reset,result"
+ *                      -> time wdg_checkin and a round of 32 clients
+ *                         (N times) -> CSV rows
+ *
+ * Define BENCH_WATCHDOG_ENABLE in the target options to start the suite
+ * from MX_FREERTOS_Init. The scenarios never touch the IWDG: the simulated
+ * watchdog counts its kicks and expires once the time since the last kick
+ * passes its timeout, like the hardware.
+ *
+ *  scenario     what happens                         expected
+ *  all_live     every client within its deadline     no starved, no reset
+ *  edge         check-ins just inside the deadline   no starved, no reset
+ *  miss         one client stops checking in         that client starved,
+ *                                                    reset within timeout
+ *  late         the client comes back after a miss   still latched, reset
+ *  two_miss     two clients stop one after the other both logged, reset
+ *  register     deadline near the timeout or below   rejected
+ *               the period
+ *  start        wdg_supervisor_start on a mock       watchdog started, task
+ *               os_thread_t                          created once; a failed
+ *                                                    create reported
+ *
+ * "detect" is the time from the last check-in of the starved client to the
+ * round that flagged it. A round stamps a check-in up to one period late
+ * and flags one period after the deadline at most, so it has to lie in
+ * (deadline, deadline + 2 * period). "reset" is the time from that round
+ * to the expiry of the simulated watchdog, at most its timeout. Otherwise
+ * the suite prints MISMATCH.
+ *
+ * Nothing here needs the hardware, so the same file runs on the host
+ * against the FreeRTOS POSIX port with BENCH_HOST_POSIX defined.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+#ifndef __BSP_BENCH_WATCHDOG_H__
+#define __BSP_BENCH_WATCHDOG_H__
+
+//******************************** Includes *********************************//
+
+#include "bsp_bench.h"
+
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+#define BENCH_WATCHDOG_ITERATIONS   1000U /* check-ins and rounds timed      */
+#define BENCH_WATCHDOG_STACK_WORDS  256U  /* stack of the runner task        */
+
+//******************************** Defines **********************************//
+
+//******************************* Declaring *********************************//
+
+/**
+ * @brief: Start the watchdog supervisor suite
+ * @steps:
+ *      1. Start the timestamp source
+ *      2. Create the runner task, it prints the CSV report and deletes itself
+ *
+ * @param[in]  iterations: check-ins and rounds timed, 0 means default
+ *
+ * @return bench_status_t: execute result of this function
+ **/
+bench_status_t bench_watchdog_start ( uint32_t iterations );
+
+//******************************* Declaring *********************************//
+#endif // __BSP_BENCH_WATCHDOG_H__
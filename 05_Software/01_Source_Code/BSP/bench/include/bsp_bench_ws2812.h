@@ -0,0 +1,102 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_bench_ws2812.h
+ *
+ * @par dependencies
+ * - bsp_bench.h
+ * - bsp_ws2812.h
+ *
+ * @author Damian
+ *
+ * @brief Check the WS2812 strip driver against a mock timer DMA: the timing
+ *        of the bits at the clocks of the profiles, the encoding, the frames
+ *        on the wire and the reset between them, and measure the refill
+ *        interrupt against the time of a half.
+ *
+ * Processing flow:
+ *
+ * bench_ws2812_start -> runner task -> timing: every part at clocks from
+ *                                      100 MHz down, against the datasheet
+ *                                   -> encode: random bytes, slot by slot
+ *                                   -> stream: strips of 1 to 1000 LEDs of
+ *                                      every part, decoded off the wire
+ *                                   -> pending, late, clock, led
+ *                                   -> time show and the interrupts -> CSV
+ *
+ * Define BENCH_WS2812_ENABLE in the target options to start the suite from
+ * MX_FREERTOS_Init. The strip under test has the mock for its hardware,
+ * never TIM3 of the board: the runner plays the DMA, it copies a half of
+ * the ring to the wire and calls ws2812_dma_isr, until the mock is stopped.
+ *
+ * The wire is decoded as a strip would: a duty of t1h is a 1, of t0h a 0,
+ * 0 is the line low; bits after a low run longer than the reset start a
+ * new frame. Any other duty, a frame of the wrong length or two frames
+ * closer than the reset of the part is a mismatch.
+ *
+ *  line         expected
+ *  timing       the ticks nearest to the datasheet times, refused when one
+ *               is off by more than WS2812_TOLERANCE_NS; the reset at least
+ *               the datasheet one plus a bit
+ *  encode       t1h for a 1, t0h for a 0, most significant bit first
+ *  stream       one frame of the pixels in wire order, the reset after it,
+ *               then the line low and the DMA stopped
+ *  pending      show while streaming: a second frame after the reset, the
+ *               pixels of the second show in it
+ *  late         a half interrupt lost is counted
+ *  clock        the timing follows the timer clock, a too slow clock is
+ *               refused and leaves the strip idle
+ *  led          a pixel as a LED device of the registry, registered in
+ *               bsp_led_handler_t and switched by pf_led_ctrl
+ *
+ *  case          time of
+ *  show          ws2812_show on an idle strip: two halves encoded, start
+ *  refill        ws2812_dma_isr encoding a half, the load line compares its
+ *                max to the time the DMA takes for the other half
+ *  stop          ws2812_dma_isr stopping the strip
+ *
+ * Nothing here needs the hardware, so the same file runs on the host
+ * against the FreeRTOS POSIX port with BENCH_HOST_POSIX defined.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+#ifndef __BSP_BENCH_WS2812_H__
+#define __BSP_BENCH_WS2812_H__
+
+//******************************** Includes *********************************//
+
+#include "bsp_bench.h"
+#include "bsp_ws2812.h"
+
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+#define BENCH_WS2812_ROUNDS       50U    /* pending and stream repeats       */
+#define BENCH_WS2812_STACK_WORDS  512U   /* stack of the runner task         */
+#define BENCH_WS2812_MAX_LEDS     1000U  /* longest strip                    */
+
+//******************************** Defines **********************************//
+
+//******************************* Declaring *********************************//
+
+/**
+ * @brief: Start the WS2812 suite
+ * @steps:
+ *      1. Start the timestamp source
+ *      2. Create the runner task, it prints the CSV report and deletes itself
+ *
+ * @param[in]  rounds: repeats of the random cases, 0 means default
+ *
+ * @return bench_status_t: execute result of this function
+ **/
+bench_status_t bench_ws2812_start ( uint32_t rounds );
+
+//******************************* Declaring *********************************//
+#endif // __BSP_BENCH_WS2812_H__
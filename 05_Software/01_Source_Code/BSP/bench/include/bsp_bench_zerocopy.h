@@ -0,0 +1,66 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_bench_zerocopy.h
+ *
+ * @par dependencies
+ * - bsp_bench.h
+ *
+ * @author Damian
+ *
+ * @brief Compare a copying FreeRTOS queue with the zero-copy bsp_msgpool_t
+ *        hand-over for message sizes from 16 B to 1 KB.
+ *
+ * Processing flow:
+ *
+ * bench_zerocopy_start -> runner task -> one CSV row per (mode, size)
+ *
+ * Define BENCH_ZEROCOPY_ENABLE in the target options to start the suite from
+ * MX_FREERTOS_Init.
+ *
+ * Every sample is one full message life cycle in the runner task: the
+ * producer side fills the payload, the consumer side reads its first word.
+ * Both ends run in the same task so no context switch is measured, only the
+ * cost of moving the message.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+#ifndef __BSP_BENCH_ZEROCOPY_H__
+#define __BSP_BENCH_ZEROCOPY_H__
+
+//******************************** Includes *********************************//
+
+#include "bsp_bench.h"
+
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+#define BENCH_ZEROCOPY_ITERATIONS   1000U     /* samples per message size    */
+#define BENCH_ZEROCOPY_STACK_WORDS  256U      /* stack of the runner         */
+#define BENCH_ZEROCOPY_DEPTH        2U        /* queue depth and pool blocks */
+
+//******************************** Defines **********************************//
+
+//******************************* Declaring *********************************//
+
+/**
+ * @brief: Start the zero-copy suite
+ * @steps:
+ *      1. Start the timestamp source
+ *      2. Create the runner task, it prints the CSV report and deletes itself
+ *
+ * @param[in]  iterations: samples per message size, 0 means default
+ *
+ * @return bench_status_t: execute result of this function
+ **/
+bench_status_t bench_zerocopy_start ( uint32_t iterations );
+
+//******************************* Declaring *********************************//
+#endif // __BSP_BENCH_ZEROCOPY_H__
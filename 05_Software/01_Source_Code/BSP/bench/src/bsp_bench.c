@@ -0,0 +1,202 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_bench.c
+ *
+ * @par dependencies
+ * - bsp_bench.h
+ * - bsp_common.h
+ *
+ * @author Damian
+ *
+ * @brief Provide the timestamp, statistic and CSV report APIs shared by all
+ *        the benchmark suites.
+ *
+ * Processing flow:
+ *
+ * Call directly.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+//******************************** Includes *********************************//
+
+#include "bsp_bench.h"
+#include "bsp_common.h"
+
+#ifdef BENCH_HOST_POSIX
+#include <time.h>
+#else
+#include "main.h"
+#include "bsp_time.h"
+#endif /* BENCH_HOST_POSIX */
+
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+BSP_STATUS_CHECK( BENCH );
+
+/**
+ * @brief: Enable the timestamp source
+ * @steps:
+ *      1. Start the DWT cycle counter through the time service on target
+ *
+ * @return bench_status_t: execute result of this function
+ **/
+bench_status_t bench_timestamp_init ( void )
+{
+#ifndef BENCH_HOST_POSIX
+    // shared with the time service, never reset the running counter
+    if ( TIME_OK != time_init() )
+    {
+        return BENCH_ERRORSOURCE;
+    }
+#endif /* BENCH_HOST_POSIX */
+    return BENCH_OK;
+}
+
+/**
+ * @brief: Read the free-running timestamp, callable from task and ISR
+ *
+ * @return uint32_t: current timestamp in BENCH_TS_UNIT, wraps around
+ **/
+uint32_t bench_timestamp_get ( void )
+{
+#ifdef BENCH_HOST_POSIX
+    struct timespec ts;
+
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+    return (uint32_t)( (uint64_t)ts.tv_sec * 1000000000ULL +
+                       (uint64_t)ts.tv_nsec                 );
+#else
+    return DWT->CYCCNT;
+#endif /* BENCH_HOST_POSIX */
+}
+
+/**
+ * @brief: Convert a timestamp delta into nanoseconds
+ *
+ * @param[in]  delta: delta of two timestamps in BENCH_TS_UNIT
+ *
+ * @return uint32_t: delta in nanoseconds
+ **/
+uint32_t bench_timestamp_to_ns ( uint32_t delta )
+{
+#ifdef BENCH_HOST_POSIX
+    return delta;
+#else
+    return (uint32_t)( ( (uint64_t)delta * 1000000000ULL ) /
+                       SystemCoreClock                      );
+#endif /* BENCH_HOST_POSIX */
+}
+
+/**
+ * @brief: Clear a statistic before a new run
+ *
+ * @param[in]  stat: Pointer to a instance of bench_stat_t
+ **/
+void bench_stat_reset ( bench_stat_t * const stat )
+{
+    if ( NULL == stat )
+    {
+        return;
+    }
+    stat->samples = 0U;
+    stat->min     = UINT32_MAX;
+    stat->max     = 0U;
+    stat->sum     = 0U;
+}
+
+/**
+ * @brief: Add one measured delta into a statistic
+ *
+ * @param[in]  stat:  Pointer to a instance of bench_stat_t
+ * @param[in]  delta: measured delta in BENCH_TS_UNIT
+ **/
+void bench_stat_add ( bench_stat_t * const stat, uint32_t delta )
+{
+    if ( NULL == stat )
+    {
+        return;
+    }
+    if ( delta < stat->min )
+    {
+        stat->min = delta;
+    }
+    if ( delta > stat->max )
+    {
+        stat->max = delta;
+    }
+    stat->sum += delta;
+    stat->samples++;
+}
+
+/**
+ * @brief: Print the CSV header shared by all the suites
+ *
+ * @param[in]  suite: name of the suite, printed as a comment line
+ **/
+void bench_csv_header ( const char * const suite )
+{
+    printf( "# %s\r\n", ( NULL == suite ) ? "bench" : suite );
+    printf( "suite,mode,case,samples,unit,min,avg,max,min_ns,avg_ns,max_ns"
+            "\r\n" );
+}
+
+/**
+ * @brief: Print one CSV row for a statistic
+ * @steps:
+ *      1. Print the raw values in BENCH_TS_UNIT
+ *      2. Print the converted values in nanoseconds
+ *
+ * @param[in]  suite: name of the suite
+ * @param[in]  mode:  name of the measured path, e.g. "task2task"
+ * @param[in]  case_name: name of the measured object, e.g. "semaphore"
+ * @param[in]  stat:  Pointer to a instance of bench_stat_t
+ **/
+void bench_csv_row (
+                     const char         * const suite,
+                     const char         * const mode,
+                     const char         * const case_name,
+                     const bench_stat_t * const stat
+                                                          )
+{
+    uint32_t avg;
+
+    if ( NULL == suite     ||
+         NULL == mode      ||
+         NULL == case_name ||
+         NULL == stat
+                             )
+    {
+        return;
+    }
+
+    /********** 1. An empty run prints zeros **********/
+    if ( 0U == stat->samples )
+    {
+        printf( "%s,%s,%s,0,%s,0,0,0,0,0,0\r\n",
+                suite, mode, case_name, BENCH_TS_UNIT );
+        return;
+    }
+
+    /********** 2. Print raw and converted values *********/
+    avg = (uint32_t)( stat->sum / stat->samples );
+    printf( "%s,%s,%s,%u,%s,%u,%u,%u,%u,%u,%u\r\n",
+            suite, mode, case_name,
+            (unsigned int)stat->samples, BENCH_TS_UNIT,
+            (unsigned int)stat->min,
+            (unsigned int)avg,
+            (unsigned int)stat->max,
+            (unsigned int)bench_timestamp_to_ns( stat->min ),
+            (unsigned int)bench_timestamp_to_ns( avg ),
+            (unsigned int)bench_timestamp_to_ns( stat->max ) );
+}
+
+//******************************** Defines **********************************//
@@ -0,0 +1,206 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_bench_build.c
+ *
+ * @par dependencies
+ * - bsp_bench_build.h
+ *
+ * @author Damian
+ *
+ * @brief Measure the hot paths the build profile changes, to compare the
+ *        homework_06 (debug) and homework_06_release targets.
+ *
+ * Processing flow:
+ *
+ * Call directly.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+//******************************** Includes *********************************//
+
+#include "bsp_bench_build.h"
+#include "bsp_common.h"
+#include "bsp_time.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+#define BENCH_BUILD_SUITE       "build"
+
+static uint32_t         s_iterations = BENCH_BUILD_ITERATIONS;
+
+/**
+ * @brief: Catch tick interrupts as gaps between two back to back reads
+ *
+ * @param[out] stat: Pointer to a instance of bench_stat_t
+ **/
+static void bench_tick_isr_run ( bench_stat_t * const stat )
+{
+    uint32_t prev;
+    uint32_t now;
+
+    for ( uint32_t i = 0; i < s_iterations; ++i )
+    {
+        prev = bench_timestamp_get();
+        for ( ;; )
+        {
+            now = bench_timestamp_get();
+            if ( now - prev >= BENCH_BUILD_GAP_MIN )
+            {
+                break;
+            }
+            prev = now;
+        }
+        bench_stat_add( stat, now - prev );
+    }
+}
+
+/**
+ * @brief: Time taskYIELD while no other task is ready
+ *
+ * @param[out] stat: Pointer to a instance of bench_stat_t
+ **/
+static void bench_yield_run ( bench_stat_t * const stat )
+{
+    uint32_t t0;
+
+    for ( uint32_t i = 0; i < s_iterations; ++i )
+    {
+        t0 = bench_timestamp_get();
+        taskYIELD();
+        bench_stat_add( stat, bench_timestamp_get() - t0 );
+    }
+}
+
+/**
+ * @brief: Time a non-blocking send and receive on a one item queue
+ *
+ * @param[out] stat: Pointer to a instance of bench_stat_t
+ *
+ * @return bench_status_t: execute result of this function
+ **/
+static bench_status_t bench_queue_run ( bench_stat_t * const stat )
+{
+    QueueHandle_t queue;
+    uint32_t      item = 0U;
+    uint32_t      t0;
+
+    queue = xQueueCreate( 1U, sizeof( uint32_t ) );
+    if ( NULL == queue )
+    {
+        return BENCH_ERRORNOMEMORY;
+    }
+    for ( uint32_t i = 0; i < s_iterations; ++i )
+    {
+        t0 = bench_timestamp_get();
+        xQueueSend( queue, &item, 0U );
+        xQueueReceive( queue, &item, 0U );
+        bench_stat_add( stat, bench_timestamp_get() - t0 );
+    }
+    vQueueDelete( queue );
+    return BENCH_OK;
+}
+
+/**
+ * @brief: Time one microsecond read of the time service
+ *
+ * @param[out] stat: Pointer to a instance of bench_stat_t
+ **/
+static void bench_time_run ( bench_stat_t * const stat )
+{
+    volatile uint64_t us;
+    uint32_t          t0;
+
+    for ( uint32_t i = 0; i < s_iterations; ++i )
+    {
+        t0 = bench_timestamp_get();
+        us = time_get_us();
+        bench_stat_add( stat, bench_timestamp_get() - t0 );
+    }
+    (void)us;
+}
+
+/**
+ * @brief: Runner task, runs all the cases and deletes itself
+ *
+ * @param[in]  argument: Not used
+ **/
+static void bench_build_task ( void * argument )
+{
+    bench_stat_t stat;
+
+    (void)argument;
+
+    bench_csv_header( BENCH_BUILD_SUITE );
+
+    bench_stat_reset( &stat );
+    bench_tick_isr_run( &stat );
+    bench_csv_row( BENCH_BUILD_SUITE, BENCH_BUILD_PROFILE, "tick_isr", &stat );
+
+    bench_stat_reset( &stat );
+    bench_yield_run( &stat );
+    bench_csv_row( BENCH_BUILD_SUITE, BENCH_BUILD_PROFILE, "yield", &stat );
+
+    bench_stat_reset( &stat );
+    if ( BENCH_OK != bench_queue_run( &stat ) )
+    {
+        LOG( LOG_LEVEL_ERR, "Bench build queue no memory" );
+    }
+    bench_csv_row( BENCH_BUILD_SUITE, BENCH_BUILD_PROFILE, "queue_rt", &stat );
+
+    bench_stat_reset( &stat );
+    bench_time_run( &stat );
+    bench_csv_row( BENCH_BUILD_SUITE, BENCH_BUILD_PROFILE, "time_get_us", &stat );
+
+    vTaskDelete( NULL );
+}
+
+/**
+ * @brief: Start the build profile suite
+ * @steps:
+ *      1. Start the timestamp source
+ *      2. Create the runner task, it prints the CSV report and deletes itself
+ *
+ * @param[in]  iterations: samples per case, 0 means default
+ *
+ * @return bench_status_t: execute result of this function
+ **/
+bench_status_t bench_build_start ( uint32_t iterations )
+{
+    bench_status_t ret = BENCH_OK;
+
+    /************** 1. Start the timestamp source *************/
+    ret = bench_timestamp_init();
+    if ( BENCH_OK != ret )
+    {
+        LOG( LOG_LEVEL_ERR, "Bench timestamp init failed" );
+        return ret;
+    }
+    s_iterations = ( 0U == iterations ) ? BENCH_BUILD_ITERATIONS : iterations;
+
+    /***************** 2. Create the runner ******************/
+    if ( pdPASS != xTaskCreate( bench_build_task,
+                                "bench_build",
+                                BENCH_BUILD_STACK_WORDS,
+                                NULL,
+                                tskIDLE_PRIORITY + 1,
+                                NULL                       ) )
+    {
+        LOG( LOG_LEVEL_ERR, "Bench runner create failed" );
+        return BENCH_ERRORNOMEMORY;
+    }
+    return ret;
+}
+
+//******************************** Defines **********************************//
@@ -0,0 +1,203 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_bench_clock.c
+ *
+ * @par dependencies
+ * - bsp_bench_clock.h
+ *
+ * @author Damian
+ *
+ * @brief Measure the same workloads under every clock profile, the table of
+ *        the clock-profile API.
+ *
+ * Processing flow:
+ *
+ * Call directly.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+//******************************** Includes *********************************//
+
+#include "bsp_bench_clock.h"
+#include "bsp_clock.h"
+#include "bsp_common.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+#define BENCH_CLOCK_SUITE       "clock"
+
+static uint32_t         s_iterations = BENCH_CLOCK_ITERATIONS;
+
+/* lives in flash, the rest of the words are zero                            */
+static const uint32_t   s_table[BENCH_CLOCK_TABLE_WORDS] =
+{
+    0x9E3779B9U, 0x7F4A7C15U, 0xF39CC060U, 0x5CEDC834U,
+    0x1082276BU, 0xF3A27251U, 0xF86C6A11U, 0x6D0C1A31U,
+};
+
+/**
+ * @brief: Sum the flash table, read through volatile so it is not folded
+ **/
+static void __flash_read ( void )
+{
+    const volatile uint32_t * p   = s_table;
+    volatile uint32_t         sum = 0U;
+    uint32_t                  acc = 0U;
+
+    for ( uint32_t i = 0; i < BENCH_CLOCK_TABLE_WORDS; ++i )
+    {
+        acc += p[i];
+    }
+    sum = acc;
+    (void)sum;
+}
+
+/**
+ * @brief: Branchy integer loop, xorshift driving data dependent branches
+ **/
+static void __code_loop ( void )
+{
+    volatile uint32_t out  = 0U;
+    uint32_t          seed = 0x2545F491U;
+    uint32_t          acc  = 0U;
+
+    for ( uint32_t i = 0; i < BENCH_CLOCK_LOOP_ROUNDS; ++i )
+    {
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        switch ( seed & 3U )
+        {
+        case 0U:  acc += seed;          break;
+        case 1U:  acc -= seed >> 3;     break;
+        case 2U:  acc ^= seed << 1;     break;
+        default:  acc  = acc * 5U + 1U; break;
+        }
+    }
+    out = acc;
+    (void)out;
+}
+
+/**
+ * @brief: Time one workload
+ *
+ * @param[in]  work: workload to run
+ * @param[out] stat: Pointer to a instance of bench_stat_t
+ **/
+static void bench_work_run ( void ( *work ) ( void ), bench_stat_t * const stat )
+{
+    uint32_t t0;
+
+    for ( uint32_t i = 0; i < s_iterations; ++i )
+    {
+        t0 = bench_timestamp_get();
+        work();
+        bench_stat_add( stat, bench_timestamp_get() - t0 );
+    }
+}
+
+/**
+ * @brief: Print the rows of all the workloads under the current clocks
+ *
+ * @param[in]  mode: name of the profile
+ **/
+static void bench_clock_rows ( const char * const mode )
+{
+    bench_stat_t stat;
+
+    bench_stat_reset( &stat );
+    bench_work_run( __flash_read, &stat );
+    bench_csv_row( BENCH_CLOCK_SUITE, mode, "flash_read", &stat );
+
+    bench_stat_reset( &stat );
+    bench_work_run( __code_loop, &stat );
+    bench_csv_row( BENCH_CLOCK_SUITE, mode, "code_loop", &stat );
+}
+
+/**
+ * @brief: Runner task, runs all the profiles and deletes itself
+ *
+ * @param[in]  argument: Not used
+ **/
+static void bench_clock_task ( void * argument )
+{
+    clock_profile_t start = clock_profile_get();
+
+    (void)argument;
+
+    bench_csv_header( BENCH_CLOCK_SUITE );
+
+    for ( uint32_t p = 0; p < CLOCK_PROFILE_NUM; ++p )
+    {
+        if ( CLOCK_OK != clock_profile_apply( (clock_profile_t)p ) )
+        {
+            LOG( LOG_LEVEL_ERR, "Bench clock profile %u failed",
+                                (unsigned int)p );
+            continue;
+        }
+        bench_clock_rows( clock_profile_name( (clock_profile_t)p ) );
+
+        // ART off once, at the highest latency where it matters most
+        if ( CLOCK_PROFILE_PERFORMANCE == p )
+        {
+            clock_art_set( 0U );
+            bench_clock_rows( "no_art" );
+            clock_profile_apply( CLOCK_PROFILE_PERFORMANCE );
+        }
+    }
+
+    // the boot clocks can not be restored, performance is the default
+    clock_profile_apply( ( CLOCK_PROFILE_BOOT == start ) ?
+                         CLOCK_PROFILE_PERFORMANCE : start );
+    vTaskDelete( NULL );
+}
+
+/**
+ * @brief: Start the clock profile suite
+ * @steps:
+ *      1. Start the timestamp source
+ *      2. Create the runner task, it prints the CSV report and deletes itself
+ *
+ * @param[in]  iterations: samples per case, 0 means default
+ *
+ * @return bench_status_t: execute result of this function
+ **/
+bench_status_t bench_clock_start ( uint32_t iterations )
+{
+    bench_status_t ret = BENCH_OK;
+
+    /************** 1. Start the timestamp source *************/
+    ret = bench_timestamp_init();
+    if ( BENCH_OK != ret )
+    {
+        LOG( LOG_LEVEL_ERR, "Bench timestamp init failed" );
+        return ret;
+    }
+    s_iterations = ( 0U == iterations ) ? BENCH_CLOCK_ITERATIONS : iterations;
+
+    /***************** 2. Create the runner ******************/
+    if ( pdPASS != xTaskCreate( bench_clock_task,
+                                "bench_clock",
+                                BENCH_CLOCK_STACK_WORDS,
+                                NULL,
+                                tskIDLE_PRIORITY + 1,
+                                NULL                       ) )
+    {
+        LOG( LOG_LEVEL_ERR, "Bench runner create failed" );
+        return BENCH_ERRORNOMEMORY;
+    }
+    return ret;
+}
+
+//******************************** Defines **********************************//
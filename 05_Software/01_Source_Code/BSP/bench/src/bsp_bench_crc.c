@@ -0,0 +1,368 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_bench_crc.c
+ *
+ * @par dependencies
+ * - bsp_bench_crc.h
+ * - bsp_crc.h
+ *
+ * @author Damian
+ *
+ * @brief Check the CRC service gives the same CRC-32/MPEG-2 on every path
+ *        and measure the MB/s of each.
+ *
+ * Processing flow:
+ *
+ * Call directly.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+//******************************** Includes *********************************//
+
+#include "bsp_bench_crc.h"
+#include "bsp_common.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+#define BENCH_CRC_SUITE           "crc"
+#define BENCH_CRC_CHECK_BYTES     80U    /* every length up to it            */
+#define BENCH_CRC_CHECK_WORDS     300U   /* across CRC_DMA_MIN_WORDS         */
+#define BENCH_CRC_NO_DMA          0xFFFFFFFFU
+
+typedef enum
+{
+    BENCH_CRC_SW_BITWISE = 0,
+    BENCH_CRC_SW_SLICE8  = 1,
+    BENCH_CRC_HW_CPU     = 2,
+    BENCH_CRC_HW_DMA     = 3,
+} bench_crc_path_t;
+
+static const char * const s_path_name[] =
+{
+    "sw_bitwise", "sw_slice8", "hw_cpu", "hw_dma",
+};
+
+static const uint32_t s_sizes[] = { 64U, 1024U, BENCH_CRC_MAX_BYTES };
+
+static uint32_t         s_iterations = BENCH_CRC_ITERATIONS;
+static bsp_crc_t      * s_crc;                    /* the one timed           */
+static bsp_crc_t        s_sw_crc = { .is_initialized = CRC_NOT_INITED };
+static uint32_t         s_buf[BENCH_CRC_MAX_BYTES / 4U + 1U];
+static uint32_t         s_rand = 0x12345678U;
+static volatile uint32_t s_sink;                  /* keeps the runs          */
+
+/**
+ * @brief: xorshift32, the same sequence on target and host
+ *
+ * @return uint32_t: next pseudo random number
+ **/
+static uint32_t __rand ( void )
+{
+    s_rand ^= s_rand << 13;
+    s_rand ^= s_rand >> 17;
+    s_rand ^= s_rand << 5;
+    return s_rand;
+}
+
+/**
+ * @brief: CRC-32/MPEG-2 one bit per step, the reference
+ *
+ * @param[in]  crc:  the CRC so far
+ * @param[in]  p:    the bytes
+ * @param[in]  len:  number of bytes
+ *
+ * @return uint32_t: the CRC
+ **/
+static uint32_t __ref ( uint32_t crc, const uint8_t * const p, uint32_t len )
+{
+    for ( uint32_t i = 0; i < len; ++i )
+    {
+        crc ^= (uint32_t)p[i] << 24;
+        for ( uint32_t b = 0; b < 8U; ++b )
+        {
+            crc = ( 0U != ( crc & 0x80000000U ) ) ?
+                  ( crc << 1 ) ^ CRC32_MPEG2_POLY : ( crc << 1 );
+        }
+    }
+    return crc;
+}
+
+/**
+ * @brief: Reference of words, each most significant byte first
+ *
+ * @param[in]  words: the words
+ * @param[in]  num:   number of words
+ *
+ * @return uint32_t: the CRC
+ **/
+static uint32_t __ref_words ( const uint32_t * const words, uint32_t num )
+{
+    uint32_t crc = CRC32_MPEG2_INIT;
+    uint8_t  be[4];
+
+    for ( uint32_t i = 0; i < num; ++i )
+    {
+        be[0] = (uint8_t)( words[i] >> 24 );
+        be[1] = (uint8_t)( words[i] >> 16 );
+        be[2] = (uint8_t)( words[i] >> 8 );
+        be[3] = (uint8_t)words[i];
+        crc   = __ref( crc, be, 4U );
+    }
+    return crc;
+}
+
+/**
+ * @brief: Fill the buffer with random bytes
+ **/
+static void __buf_fill ( void )
+{
+    for ( uint32_t i = 0; i < sizeof( s_buf ) / 4U; ++i )
+    {
+        s_buf[i] = __rand();
+    }
+}
+
+/**
+ * @brief: Every path against the reference
+ **/
+static void __check ( void )
+{
+    static const uint8_t check[] = "123456789";
+    const uint8_t      * bytes   = (const uint8_t *)s_buf;
+    uint32_t             ref;
+    uint32_t             got     = 0U;
+    uint32_t             words   = 0U;
+    uint32_t             ok      = 1U;
+
+    __buf_fill();
+    ok &= ( CRC32_MPEG2_CHECK == __ref( CRC32_MPEG2_INIT, check, 9U ) &&
+            CRC32_MPEG2_CHECK == crc32_mpeg2_sw( CRC32_MPEG2_INIT,
+                                                 check, 9U        ) &&
+            CRC_OK == crc_calc( s_crc, check, 9U, &got )            &&
+            CRC32_MPEG2_CHECK == got ) ? 1U : 0U;
+
+    // bytes: every length at every alignment, split in two for the chain
+    for ( uint32_t off = 0; off < 4U; ++off )
+    {
+        for ( uint32_t len = 0; len <= BENCH_CRC_CHECK_BYTES; ++len )
+        {
+            ref = __ref( CRC32_MPEG2_INIT, &bytes[off], len );
+            ok &= ( ref == crc32_mpeg2_sw( CRC32_MPEG2_INIT,
+                                           &bytes[off], len ) ) ? 1U : 0U;
+            ok &= ( ref == crc32_mpeg2_sw(
+                               crc32_mpeg2_sw( CRC32_MPEG2_INIT,
+                                               &bytes[off], len / 2U ),
+                               &bytes[off + len / 2U], len - len / 2U ) ) ?
+                  1U : 0U;
+            ok &= ( CRC_OK == crc_calc( s_crc, &bytes[off], len, &got ) &&
+                    ref == got ) ? 1U : 0U;
+        }
+    }
+
+    // words: through the CPU below CRC_DMA_MIN_WORDS, by DMA above
+    for ( uint32_t num = 0; num <= BENCH_CRC_CHECK_WORDS; ++num )
+    {
+        ref = __ref_words( s_buf, num );
+        ok &= ( ref == crc32_mpeg2_sw_words( CRC32_MPEG2_INIT, s_buf,
+                                             num                   ) ) ?
+              1U : 0U;
+        ok &= ( CRC_OK == crc_calc_words( s_crc, s_buf, num, &got ) &&
+                ref == got ) ? 1U : 0U;
+        words += num;
+    }
+    printf( "# check,unit %s,bytes 0..%u x4 alignments,words %u,%s\r\n",
+            ( NULL != s_crc->p_hw_operation_inst ) ? "yes" : "no",
+            (unsigned int)BENCH_CRC_CHECK_BYTES, (unsigned int)words,
+            ( 0U != ok ) ? "ok" : "MISMATCH" );
+}
+
+#ifndef BENCH_HOST_POSIX
+/**
+ * @brief: The image sectors by DMA, more than one transfer, against the
+ *         tables
+ **/
+static void __flash_check ( void )
+{
+    const uint32_t * image = (const uint32_t *)BENCH_CRC_FLASH_ADDR;
+    uint32_t         num   = BENCH_CRC_FLASH_BYTES / 4U;
+    uint32_t         sw    = crc32_mpeg2_sw_words( CRC32_MPEG2_INIT,
+                                                   image, num       );
+    uint32_t         hw    = 0U;
+    uint32_t         t0    = bench_timestamp_get();
+    crc_status_t     ret   = crc_calc_words( s_crc, image, num, &hw );
+
+    t0 = bench_timestamp_to_ns( bench_timestamp_get() - t0 ) / 1000U;
+    printf( "# flash,%u bytes,%u transfers,%u us,%s\r\n",
+            (unsigned int)BENCH_CRC_FLASH_BYTES,
+            (unsigned int)( ( num + CRC_DMA_MAX_WORDS - 1U ) /
+                            CRC_DMA_MAX_WORDS ),
+            (unsigned int)t0,
+            ( CRC_OK == ret && sw == hw ) ? "ok" : "MISMATCH" );
+}
+#endif /* BENCH_HOST_POSIX */
+
+/**
+ * @brief: One run of a path
+ *
+ * @param[in]  path:  the path
+ * @param[in]  bytes: size of the buffer
+ *
+ * @return uint32_t: the CRC
+ **/
+static uint32_t __run ( bench_crc_path_t path, uint32_t bytes )
+{
+    uint32_t result = 0U;
+
+    switch ( path )
+    {
+    case BENCH_CRC_SW_BITWISE:
+        result = __ref( CRC32_MPEG2_INIT, (const uint8_t *)s_buf, bytes );
+        break;
+    case BENCH_CRC_SW_SLICE8:
+        result = crc32_mpeg2_sw( CRC32_MPEG2_INIT, s_buf, bytes );
+        break;
+    case BENCH_CRC_HW_CPU:
+        crc_calc( s_crc, s_buf, bytes, &result );
+        break;
+    case BENCH_CRC_HW_DMA:
+    default:
+        crc_calc_words( s_crc, s_buf, bytes / 4U, &result );
+        break;
+    }
+    return result;
+}
+
+/**
+ * @brief: Time a path on every size, CSV row and rate line
+ *
+ * @param[in]  path: the path
+ **/
+static void __cost ( bench_crc_path_t path )
+{
+    bench_stat_t stat;
+    char         name[16];
+    uint32_t     ns;
+    uint32_t     t0;
+    uint32_t     runs;
+
+    for ( uint32_t s = 0; s < sizeof( s_sizes ) / sizeof( s_sizes[0] ); ++s )
+    {
+        // the bitwise reference is slow, a few runs are enough
+        runs = ( BENCH_CRC_SW_BITWISE == path ) ? s_iterations / 20U + 1U :
+                                                  s_iterations;
+        bench_stat_reset( &stat );
+        for ( uint32_t i = 0; i < runs; ++i )
+        {
+            t0 = bench_timestamp_get();
+            s_sink = __run( path, s_sizes[s] );
+            bench_stat_add( &stat, bench_timestamp_get() - t0 );
+        }
+        snprintf( name, sizeof( name ), "%uB", (unsigned int)s_sizes[s] );
+        bench_csv_row( BENCH_CRC_SUITE, s_path_name[path], name, &stat );
+
+        // MB/s from the average, one decimal
+        ns = bench_timestamp_to_ns( (uint32_t)( stat.sum / stat.samples ) );
+        ns = ( 0U == ns ) ? 1U : ns;
+        printf( "# rate,%s,%s,%u.%u MB/s\r\n", s_path_name[path], name,
+                (unsigned int)( (uint64_t)s_sizes[s] * 1000U / ns ),
+                (unsigned int)( (uint64_t)s_sizes[s] * 10000U / ns % 10U ) );
+    }
+}
+
+/**
+ * @brief: Runner task, runs every check and deletes itself
+ *
+ * @param[in]  argument: Not used
+ **/
+static void bench_crc_task ( void * argument )
+{
+    uint32_t dma_min;
+
+    (void)argument;
+
+    bench_csv_header( BENCH_CRC_SUITE );
+    __check();
+#ifndef BENCH_HOST_POSIX
+    if ( NULL != s_crc->p_hw_operation_inst )
+    {
+        __flash_check();
+    }
+#endif /* BENCH_HOST_POSIX */
+    __cost( BENCH_CRC_SW_BITWISE );
+    __cost( BENCH_CRC_SW_SLICE8 );
+    if ( NULL != s_crc->p_hw_operation_inst )
+    {
+        // bytes never go by DMA, the byte order is not the one of the unit
+        __cost( BENCH_CRC_HW_CPU );
+        if ( NULL != s_crc->p_hw_operation_inst->pf_crc_dma_start )
+        {
+            dma_min              = s_crc->dma_min_words;
+            s_crc->dma_min_words = 0U;
+            __cost( BENCH_CRC_HW_DMA );
+            s_crc->dma_min_words = dma_min;
+        }
+    }
+
+    vTaskDelete( NULL );
+}
+
+/**
+ * @brief: Start the CRC suite
+ * @steps:
+ *      1. Start the timestamp source
+ *      2. Create the runner task, it prints the CSV report and deletes itself
+ *
+ * @param[in]  iterations: runs per path and size, 0 means default
+ * @param[in]  crc:        instance with the CRC unit, NULL: software only
+ *
+ * @return bench_status_t: execute result of this function
+ **/
+bench_status_t bench_crc_start ( uint32_t iterations, bsp_crc_t * const crc )
+{
+    bench_status_t ret = BENCH_OK;
+
+    /************** 1. Start the timestamp source *************/
+    ret = bench_timestamp_init();
+    if ( BENCH_OK != ret )
+    {
+        LOG( LOG_LEVEL_ERR, "Bench timestamp init failed" );
+        return ret;
+    }
+    s_iterations = ( 0U == iterations ) ? BENCH_CRC_ITERATIONS : iterations;
+    s_crc        = crc;
+    if ( NULL == s_crc )
+    {
+        if ( CRC_INITED != s_sw_crc.is_initialized &&
+             CRC_OK != crc_inst( &s_sw_crc, NULL, NULL, NULL ) )
+        {
+            return BENCH_ERROR;
+        }
+        s_crc = &s_sw_crc;
+    }
+
+    /***************** 2. Create the runner ******************/
+    if ( pdPASS != xTaskCreate( bench_crc_task,
+                                "bench_crc",
+                                BENCH_CRC_STACK_WORDS,
+                                NULL,
+                                tskIDLE_PRIORITY + 1,
+                                NULL                  ) )
+    {
+        LOG( LOG_LEVEL_ERR, "Bench runner create failed" );
+        return BENCH_ERRORNOMEMORY;
+    }
+    return ret;
+}
+
+//******************************** Defines **********************************//
@@ -0,0 +1,811 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_bench_device.c
+ *
+ * @par dependencies
+ * - bsp_bench_device.h
+ * - bsp_led_handler.h
+ * - bsp_signal.h
+ *
+ * @author Damian
+ *
+ * @brief Check the device registry and the LED stack on it against a mock
+ *        OSAL, and measure a lookup and the two ways of an ioctl.
+ *
+ * Processing flow:
+ *
+ * Call directly.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+//******************************** Includes *********************************//
+
+#include "bsp_bench_device.h"
+#include "bsp_led_handler.h"
+#include "bsp_signal.h"
+#include "bsp_common.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include <stdio.h>
+#include <string.h>
+
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+#define BENCH_DEVICE_SUITE        "device"
+#define BENCH_DEVICE_NUM          ( MAX_BSP_DEVICE_NUM + 2U )
+#define BENCH_DEVICE_NAME_LEN     12U
+#define BENCH_DEVICE_LED_PERIOD   100U    /* ms of a twinkle                 */
+#define BENCH_DEVICE_LED_COUNT    3U      /* twinkles                        */
+#define BENCH_DEVICE_QUEUE_DEPTH  4U      /* slots of the mock queue         */
+#define BENCH_DEVICE_WORKER_DEPTH 3U      /* commands of the suite worker    */
+#define BENCH_DEVICE_LED_DONE_BIT ( 1UL << 2 ) /* LED command done         */
+
+typedef struct
+{
+    bsp_device_t          * rival;        /* registered in the open, once    */
+    uint32_t              opens;
+    uint32_t              closes;
+    uint32_t              ioctls;
+    uint32_t              last_cmd;       /* of the last ioctl               */
+    void                  * last_arg;
+} bench_device_mock_t;
+
+typedef struct
+{
+    uint8_t               slot[BENCH_DEVICE_QUEUE_DEPTH][sizeof( bsp_cmd_t )];
+    uint32_t              depth;          /* from the create                 */
+    uint32_t              head;
+    uint32_t              count;
+    uint32_t              creates;
+    uint32_t              deletes;
+} bench_device_queue_t;
+
+typedef struct
+{
+    void                  ( *entry ) ( void * );
+    void                  * argument;
+    uint32_t              priority;
+    uint32_t              creates;
+    uint32_t              fail;           /* refuse the next create          */
+} bench_device_task_t;
+
+typedef struct
+{
+    uint32_t              cmd[BENCH_DEVICE_WORKER_DEPTH];
+    bsp_status_t          result[BENCH_DEVICE_WORKER_DEPTH];
+    uint32_t              num;
+} bench_device_done_t;
+
+typedef struct
+{
+    uint32_t              depth;          /* of the critical section         */
+    uint32_t              enters;
+    uint32_t              exits;
+    uint32_t              inside;         /* open or close in the section    */
+} bench_device_lock_t;
+
+typedef struct
+{
+    uint32_t              on;
+    uint32_t              off;
+    uint32_t              ms;             /* virtual time of the delays      */
+} bench_device_led_t;
+
+static uint32_t             s_iterations = BENCH_DEVICE_ITERATIONS;
+static bench_device_lock_t  s_lock;
+static bench_device_led_t   s_led;
+static bench_device_queue_t s_queue;
+static bench_device_task_t  s_thread;
+static bench_device_done_t  s_done;
+static bench_device_mock_t  s_mocks[BENCH_DEVICE_NUM];
+static bsp_device_t         s_devs[BENCH_DEVICE_NUM];
+static char                 s_names[BENCH_DEVICE_NUM][BENCH_DEVICE_NAME_LEN];
+static bsp_led_driver_t     s_led_inst = {
+    .is_initialized = LED_INST_NOT_INITED,
+};
+static bsp_device_t         s_led_dev;
+
+//******************************** Mock *************************************//
+
+static bsp_status_t __mock_critical_enter ( void )
+{
+#ifndef BENCH_HOST_POSIX
+    taskENTER_CRITICAL();
+#endif /* BENCH_HOST_POSIX */
+    s_lock.depth++;
+    s_lock.enters++;
+    return BSP_OK;
+}
+
+static bsp_status_t __mock_critical_exit ( void )
+{
+    s_lock.depth--;
+    s_lock.exits++;
+#ifndef BENCH_HOST_POSIX
+    taskEXIT_CRITICAL();
+#endif /* BENCH_HOST_POSIX */
+    return BSP_OK;
+}
+
+static bsp_status_t __mock_delay ( const uint32_t delay_ms )
+{
+    s_led.ms += delay_ms;
+    return BSP_OK;
+}
+
+static bsp_status_t __mock_queue_create (
+                                          uint32_t const num,
+                                          uint32_t const size,
+                                          void **  const queue_handler
+                                                                     )
+{
+    if ( num > BENCH_DEVICE_QUEUE_DEPTH || size != sizeof( bsp_cmd_t ) )
+    {
+        return BSP_ERRORNOMEMORY;
+    }
+    s_queue.depth = num;
+    s_queue.head  = 0U;
+    s_queue.count = 0U;
+    s_queue.creates++;
+    *queue_handler = &s_queue;
+    return BSP_OK;
+}
+
+static bsp_status_t __mock_queue_put (
+                                       void *   const queue_handler,
+                                       void *   const item,
+                                       uint32_t       timeout
+                                                                     )
+{
+    bench_device_queue_t * queue = (bench_device_queue_t *)queue_handler;
+
+    (void)timeout;
+    if ( queue->count >= queue->depth )
+    {
+        return BSP_ERRORTIMEOUT;
+    }
+    memcpy( queue->slot[( queue->head + queue->count ) % queue->depth],
+            item, sizeof( bsp_cmd_t ) );
+    queue->count++;
+    return BSP_OK;
+}
+
+static bsp_status_t __mock_queue_get (
+                                       void *   const queue_handler,
+                                       void *   const msg,
+                                       uint32_t       timeout
+                                                                     )
+{
+    bench_device_queue_t * queue = (bench_device_queue_t *)queue_handler;
+
+    (void)timeout;
+    if ( 0U == queue->count )
+    {
+        return BSP_ERRORTIMEOUT;
+    }
+    memcpy( msg, queue->slot[queue->head], sizeof( bsp_cmd_t ) );
+    queue->head = ( queue->head + 1U ) % queue->depth;
+    queue->count--;
+    return BSP_OK;
+}
+
+static bsp_status_t __mock_queue_delete ( void * const queue_handler )
+{
+    (void)queue_handler;
+    s_queue.deletes++;
+    return BSP_OK;
+}
+
+/* records the task, the suite plays it with bsp_worker_run                  */
+static bsp_status_t __mock_thread_create (
+                                           void         ( *entry ) ( void * ),
+                                           const char *   const name,
+                                           uint32_t       const stack_words,
+                                           void *         const argument,
+                                           uint32_t       const priority
+                                                                     )
+{
+    (void)name;
+    (void)stack_words;
+    if ( 0U != s_thread.fail )
+    {
+        s_thread.fail = 0U;
+        return BSP_ERRORNOMEMORY;
+    }
+    s_thread.entry    = entry;
+    s_thread.argument = argument;
+    s_thread.priority = priority;
+    s_thread.creates++;
+    return BSP_OK;
+}
+
+static void __mock_done ( bsp_cmd_t * const cmd, bsp_status_t result )
+{
+    if ( s_done.num < BENCH_DEVICE_WORKER_DEPTH )
+    {
+        s_done.cmd[s_done.num]    = cmd->cmd;
+        s_done.result[s_done.num] = result;
+    }
+    s_done.num++;
+}
+
+static led_inst_status_t __mock_led_on ( void )
+{
+    s_led.on++;
+    return LED_INST_OK;
+}
+
+static led_inst_status_t __mock_led_off ( void )
+{
+    s_led.off++;
+    return LED_INST_OK;
+}
+
+static os_critical_t s_mock_critical =
+{
+    .pf_os_critical_enter = __mock_critical_enter,
+    .pf_os_critical_exit  = __mock_critical_exit,
+};
+
+static os_delay_t s_mock_delay =
+{
+    .pf_os_delay_ms = __mock_delay,
+};
+
+static os_queue_t s_mock_queue =
+{
+    .pf_os_queue_create = __mock_queue_create,
+    .pf_os_queue_put    = __mock_queue_put,
+    .pf_os_queue_get    = __mock_queue_get,
+    .pf_os_queue_delete = __mock_queue_delete,
+};
+
+static os_thread_t s_mock_thread =
+{
+    .pf_os_thread_create = __mock_thread_create,
+};
+
+static bsp_osal_t s_mock_osal =
+{
+    .p_os_critical = &s_mock_critical,
+    .p_os_queue    = &s_mock_queue,
+    .p_os_thread   = &s_mock_thread,
+};
+
+/* the registry alone: no worker on it                                       */
+static bsp_osal_t s_mock_osal_bare =
+{
+    .p_os_critical = &s_mock_critical,
+};
+
+static led_operation_t s_mock_led_ops =
+{
+    .pf_led_on  = __mock_led_on,
+    .pf_led_off = __mock_led_off,
+};
+
+/**
+ * @brief: Open of the mock class, registers the rival of the device first
+ *         as a task preempting the open would
+ **/
+static bsp_status_t bench_mock_open ( bsp_device_t * const dev )
+{
+    bench_device_mock_t * mock  = (bench_device_mock_t *)dev->priv;
+    bsp_device_t        * rival = mock->rival;
+
+    mock->opens++;
+    s_lock.inside += ( 0U != s_lock.depth ) ? 1U : 0U;
+    if ( NULL != rival )
+    {
+        mock->rival = NULL;
+        (void)bsp_device_register( rival );
+    }
+    return BSP_OK;
+}
+
+static bsp_status_t bench_mock_close ( bsp_device_t * const dev )
+{
+    bench_device_mock_t * mock = (bench_device_mock_t *)dev->priv;
+
+    mock->closes++;
+    s_lock.inside += ( 0U != s_lock.depth ) ? 1U : 0U;
+    return BSP_OK;
+}
+
+static bsp_status_t bench_mock_ioctl (
+                                       bsp_device_t * const dev,
+                                       uint32_t             cmd,
+                                       void         * const arg
+                                                                )
+{
+    bench_device_mock_t * mock = (bench_device_mock_t *)dev->priv;
+
+    mock->ioctls++;
+    mock->last_cmd = cmd;
+    mock->last_arg = arg;
+    return BSP_OK;
+}
+
+BSP_DEVICE_CLASS( bench_mock );
+
+//******************************** Mock *************************************//
+
+//******************************** Defines **********************************//
+
+/**
+ * @brief: Mount the registry again on the mock OSAL, every device of the
+ *         suite instantiated and named after its index, no rival
+ *
+ * @return uint32_t: 1 when the registry is empty and the devices ready
+ **/
+static uint32_t __reset ( void )
+{
+    uint32_t ok;
+
+    ok = ( BSP_OK == bsp_core_init( &s_mock_osal ) ) ? 1U : 0U;
+    for ( uint32_t i = 0; i < BENCH_DEVICE_NUM; ++i )
+    {
+        s_mocks[i].rival  = NULL;
+        s_mocks[i].opens  = 0U;
+        s_mocks[i].closes = 0U;
+        s_mocks[i].ioctls = 0U;
+        s_mocks[i].last_cmd = 0U;
+        s_mocks[i].last_arg = NULL;
+        ok &= ( BSP_OK == bsp_device_inst( &s_devs[i], s_names[i],
+                                           &bench_mock_ops,
+                                           &s_mocks[i] ) ) ? 1U : 0U;
+    }
+    return ok;
+}
+
+/**
+ * @brief: Fill the registry, look the devices up, refuse what must be
+ **/
+static void __registry_run ( void )
+{
+    uint32_t ok;
+
+    // full: one device more is refused before its open
+    ok = __reset();
+    for ( uint32_t i = 0; i < MAX_BSP_DEVICE_NUM; ++i )
+    {
+        ok &= ( BSP_OK == bsp_device_register( &s_devs[i] ) ) ? 1U : 0U;
+    }
+    for ( uint32_t i = 0; i < MAX_BSP_DEVICE_NUM; ++i )
+    {
+        ok &= ( &s_devs[i] == bsp_device_find( s_names[i] ) &&
+                1U == s_mocks[i].opens ) ? 1U : 0U;
+    }
+    ok &= ( NULL == bsp_device_find( "bench_none" ) &&
+            NULL == bsp_device_find( NULL ) ) ? 1U : 0U;
+    ok &= ( BSP_ERRORNOMEMORY ==
+            bsp_device_register( &s_devs[MAX_BSP_DEVICE_NUM] ) &&
+            0U == s_mocks[MAX_BSP_DEVICE_NUM].opens &&
+            NULL == bsp_device_find( s_names[MAX_BSP_DEVICE_NUM] ) ) ?
+          1U : 0U;
+    ok &= ( BSP_ERRORSOURCE == bsp_device_register( &s_devs[0] ) &&
+            1U == s_mocks[0].opens ) ? 1U : 0U;
+
+    // taken: a second device of the same name is refused before its open
+    ok &= __reset();
+    ok &= ( BSP_OK == bsp_device_inst( &s_devs[1], s_names[0],
+                                       &bench_mock_ops, &s_mocks[1] ) &&
+            BSP_OK == bsp_device_register( &s_devs[0] ) &&
+            BSP_ERRORPARAMETER == bsp_device_register( &s_devs[1] ) &&
+            0U == s_mocks[1].opens &&
+            &s_devs[0] == bsp_device_find( s_names[0] ) ) ? 1U : 0U;
+
+    // ioctl: only on a registered device
+    ok &= ( BSP_OK == bsp_device_ioctl( &s_devs[0], 0U, NULL ) &&
+            BSP_ERRORSOURCE == bsp_device_ioctl( &s_devs[1], 0U, NULL ) &&
+            BSP_ERRORPARAMETER == bsp_device_ioctl( NULL, 0U, NULL ) &&
+            1U == s_mocks[0].ioctls && 0U == s_mocks[1].ioctls ) ? 1U : 0U;
+    printf( "# registry,%u devices,%s\r\n", (unsigned)MAX_BSP_DEVICE_NUM,
+            ( 0U != ok ) ? "ok" : "MISMATCH" );
+}
+
+/**
+ * @brief: Another registration inside the open takes the name or the last
+ *         slot of the device being registered
+ **/
+static void __race_run ( void )
+{
+    const uint32_t last = MAX_BSP_DEVICE_NUM - 1U;
+    uint32_t       ok;
+
+    // name: the rival has the name of the device
+    ok = __reset();
+    ok &= ( BSP_OK == bsp_device_inst( &s_devs[1], s_names[0],
+                                       &bench_mock_ops, &s_mocks[1] ) ) ?
+          1U : 0U;
+    s_mocks[0].rival = &s_devs[1];
+    ok &= ( BSP_ERRORPARAMETER == bsp_device_register( &s_devs[0] ) &&
+            1U == s_mocks[0].opens && 1U == s_mocks[0].closes &&
+            BSP_NOT_INITED == s_devs[0].is_registered &&
+            1U == s_mocks[1].opens && 0U == s_mocks[1].closes &&
+            &s_devs[1] == bsp_device_find( s_names[0] ) ) ? 1U : 0U;
+    printf( "# name_race,%s\r\n", ( 0U != ok ) ? "ok" : "MISMATCH" );
+
+    // full: the rival takes the last slot
+    ok = __reset();
+    for ( uint32_t i = 0; i < last; ++i )
+    {
+        ok &= ( BSP_OK == bsp_device_register( &s_devs[i] ) ) ? 1U : 0U;
+    }
+    s_mocks[last].rival = &s_devs[MAX_BSP_DEVICE_NUM];
+    ok &= ( BSP_ERRORNOMEMORY == bsp_device_register( &s_devs[last] ) &&
+            1U == s_mocks[last].opens && 1U == s_mocks[last].closes &&
+            BSP_NOT_INITED == s_devs[last].is_registered &&
+            NULL == bsp_device_find( s_names[last] ) &&
+            &s_devs[MAX_BSP_DEVICE_NUM] ==
+            bsp_device_find( s_names[MAX_BSP_DEVICE_NUM] ) ) ? 1U : 0U;
+    printf( "# full_race,%s\r\n", ( 0U != ok ) ? "ok" : "MISMATCH" );
+}
+
+/**
+ * @brief: The critical section of every line so far: balanced, no open or
+ *         close inside it
+ **/
+static void __lock_run ( void )
+{
+    uint32_t ok;
+
+    ok = ( 0U == s_lock.depth && 0U == s_lock.inside &&
+           0U != s_lock.enters && s_lock.enters == s_lock.exits ) ? 1U : 0U;
+    printf( "# lock,%u sections,%s\r\n", (unsigned)s_lock.enters,
+            ( 0U != ok ) ? "ok" : "MISMATCH" );
+}
+
+/**
+ * @brief: A mock LED as a device of the registry under the LED handler
+ **/
+static void __led_run ( void )
+{
+    static led_inst_group_t  group;
+    static bsp_led_handler_t handler = {
+        .is_initialized = LED_HANDLER_NOT_INITED,
+        .led_inst_group = &group,
+    };
+    static bsp_device_t      loose;
+    static time_operation_t  time_ops;
+    uint32_t                 ok;
+    uint32_t                 off;
+
+    ok = __reset();
+    handler.is_initialized = LED_HANDLER_NOT_INITED;
+    s_led_inst.is_initialized = LED_INST_NOT_INITED;
+    ok &= ( LED_HNDLR_OK == led_handler_inst( &handler, &s_mock_delay,
+                                              &s_mock_critical, &time_ops ) &&
+            LED_INST_OK == led_instantiate( &s_led_inst,
+                                            &s_mock_led_ops ) ) ? 1U : 0U;
+
+    // the open of the device turns the LED off
+    off = s_led.off;
+    ok &= ( BSP_OK == bsp_device_inst( &s_led_dev, "bench_led", &led_ops,
+                                       &s_led_inst ) &&
+            BSP_OK == bsp_device_register( &s_led_dev ) &&
+            off + 1U == s_led.off &&
+            &s_led_dev == bsp_device_find( "bench_led" ) &&
+            LED_HNDLR_OK == handler.pf_led_register( &handler,
+                                                     &s_led_dev ) ) ?
+          1U : 0U;
+
+    // refused: a LED not registered, a device of another class
+    ok &= ( BSP_OK == bsp_device_inst( &loose, "bench_loose", &led_ops,
+                                       &s_led_inst ) &&
+            BSP_OK == bsp_device_register( &s_devs[0] ) ) ? 1U : 0U;
+    ok &= ( LED_HNDLR_ERRORSOURCE ==
+            handler.pf_led_register( &handler, &loose ) &&
+            LED_HNDLR_ERRORSOURCE ==
+            handler.pf_led_ctrl( &handler, &loose, 100U, 1U,
+                                 DUTY_MAX_PERCENT ) &&
+            LED_HNDLR_ERRORSOURCE ==
+            handler.pf_led_register( &handler, &s_devs[0] ) &&
+            LED_HNDLR_ERRORSOURCE ==
+            handler.pf_led_ctrl( &handler, &s_devs[0], 100U, 1U,
+                                 DUTY_MAX_PERCENT ) &&
+            0U == s_mocks[0].ioctls ) ? 1U : 0U;
+
+    // twinkle: every period on for half of it, then off
+    s_led.on  = 0U;
+    s_led.off = 0U;
+    s_led.ms  = 0U;
+    ok &= ( LED_HNDLR_OK == handler.pf_led_ctrl( &handler, &s_led_dev,
+                                                 BENCH_DEVICE_LED_PERIOD,
+                                                 BENCH_DEVICE_LED_COUNT,
+                                                 DUTY_50_PERCENT ) &&
+            BENCH_DEVICE_LED_COUNT == s_led.on &&
+            BENCH_DEVICE_LED_COUNT == s_led.off &&
+            BENCH_DEVICE_LED_COUNT * BENCH_DEVICE_LED_PERIOD ==
+            s_led.ms ) ? 1U : 0U;
+    printf( "# led,%u on,%u off,%u ms,%s\r\n", (unsigned)s_led.on,
+            (unsigned)s_led.off, (unsigned)s_led.ms,
+            ( 0U != ok ) ? "ok" : "MISMATCH" );
+}
+
+/**
+ * @brief: A worker on the mock queue and thread, its task played by the
+ *         suite: commands run in order through the vtable, results counted
+ *         and handed to pf_done, a full queue and a failed create refused
+ **/
+static void __worker_run ( void )
+{
+    static bsp_worker_t worker = {
+        .is_initialized = BSP_NOT_INITED,
+    };
+    bsp_cmd_t           cmd = {
+        .dev     = &s_devs[0],
+        .pf_done = __mock_done,
+    };
+    uint32_t            ok;
+
+    // no queue nor thread interface: no worker
+    ok = ( BSP_OK == bsp_core_init( &s_mock_osal_bare ) &&
+           BSP_ERRORPARAMETER == bsp_worker_inst( &worker, "bench_worker",
+                                                  BENCH_DEVICE_WORKER_DEPTH,
+                                                  256U, 1U ) ) ? 1U : 0U;
+
+    // the task not created: the queue deleted, nothing posted
+    ok &= __reset();
+    memset( &s_thread, 0, sizeof( s_thread ) );
+    memset( &s_done, 0, sizeof( s_done ) );
+    s_queue.creates = 0U;
+    s_queue.deletes = 0U;
+    s_thread.fail   = 1U;
+    ok &= ( BSP_ERRORNOMEMORY == bsp_worker_inst( &worker, "bench_worker",
+                                                  BENCH_DEVICE_WORKER_DEPTH,
+                                                  256U, 1U ) &&
+            1U == s_queue.creates && 1U == s_queue.deletes &&
+            BSP_ERRORSOURCE == bsp_worker_post( &worker, &cmd, 0U ) ) ?
+          1U : 0U;
+
+    // created: one task on the worker, at its priority
+    ok &= ( BSP_OK == bsp_worker_inst( &worker, "bench_worker",
+                                       BENCH_DEVICE_WORKER_DEPTH,
+                                       256U, 1U ) &&
+            1U == s_thread.creates && &worker == s_thread.argument &&
+            1U == s_thread.priority && NULL != s_thread.entry &&
+            BENCH_DEVICE_WORKER_DEPTH == s_queue.depth &&
+            BSP_ERRORTIMEOUT == bsp_worker_run( &worker, 0U ) ) ? 1U : 0U;
+
+    // posted: a registered device, one not registered, the first again;
+    // the queue then full, a command without device refused
+    ok &= ( BSP_OK == bsp_device_register( &s_devs[0] ) ) ? 1U : 0U;
+    for ( uint32_t i = 0; i < BENCH_DEVICE_WORKER_DEPTH; ++i )
+    {
+        cmd.dev = ( 1U == i ) ? &s_devs[1] : &s_devs[0];
+        cmd.cmd = i + 1U;
+        cmd.arg = &s_mocks[i];
+        ok &= ( BSP_OK == bsp_worker_post( &worker, &cmd, 0U ) ) ? 1U : 0U;
+    }
+    ok &= ( BSP_ERRORTIMEOUT == bsp_worker_post( &worker, &cmd, 0U ) &&
+            0U == s_mocks[0].ioctls && 0U == s_done.num ) ? 1U : 0U;
+    cmd.dev = NULL;
+    ok &= ( BSP_ERRORPARAMETER == bsp_worker_post( &worker, &cmd, 0U ) ) ?
+          1U : 0U;
+
+    // run: in the posting order, the one not registered failed
+    for ( uint32_t i = 0; i < BENCH_DEVICE_WORKER_DEPTH; ++i )
+    {
+        ok &= ( BSP_OK == bsp_worker_run( &worker, 0U ) ) ? 1U : 0U;
+    }
+    ok &= ( BSP_ERRORTIMEOUT == bsp_worker_run( &worker, 0U ) &&
+            BENCH_DEVICE_WORKER_DEPTH == s_done.num &&
+            1U == s_done.cmd[0] && BSP_OK == s_done.result[0] &&
+            2U == s_done.cmd[1] && BSP_ERRORSOURCE == s_done.result[1] &&
+            3U == s_done.cmd[2] && BSP_OK == s_done.result[2] &&
+            2U == s_mocks[0].ioctls && 0U == s_mocks[1].ioctls &&
+            3U == s_mocks[0].last_cmd && &s_mocks[2] == s_mocks[0].last_arg &&
+            3U == worker.executed && 1U == worker.failed ) ? 1U : 0U;
+    printf( "# worker,%u executed,%u failed,%s\r\n",
+            (unsigned)worker.executed, (unsigned)worker.failed,
+            ( 0U != ok ) ? "ok" : "MISMATCH" );
+}
+
+/**
+ * @brief: The LED handler with a worker: pf_led_ctrl returns at once, the
+ *         worker runs the commands in the posting order, a twinkle with
+ *         the setting of the LED when it starts, every command done sets
+ *         the bit of the handler on the signal of the runner, which owns
+ *         no second signal
+ **/
+static void __led_worker_run ( void )
+{
+    static led_inst_group_t  group;
+    static bsp_led_handler_t handler = {
+        .is_initialized = LED_HANDLER_NOT_INITED,
+        .led_inst_group = &group,
+    };
+    static bsp_worker_t      worker = {
+        .is_initialized = BSP_NOT_INITED,
+    };
+    static time_operation_t  time_ops;
+    static bsp_signal_t      signal;
+    static bsp_signal_t      second;
+    uint32_t                 bits;
+    uint32_t                 ok;
+
+    ok = __reset();
+    s_led_inst.is_initialized = LED_INST_NOT_INITED;
+    // a second signal of the runner refused, bound or at its first wait
+    ok &= ( SIGNAL_OK == signal_instantiate( &signal,
+                                    xTaskGetCurrentTaskHandle() ) &&
+            SIGNAL_ERRORSOURCE == signal_instantiate( &second,
+                                    xTaskGetCurrentTaskHandle() ) &&
+            SIGNAL_OK == signal_instantiate( &second, NULL ) &&
+            SIGNAL_ERRORSOURCE == signal_wait( &second,
+                                               BENCH_DEVICE_LED_DONE_BIT,
+                                               0U, &bits ) ) ? 1U : 0U;
+    ok &= ( LED_HNDLR_OK == led_handler_inst( &handler, &s_mock_delay,
+                                              &s_mock_critical, &time_ops ) &&
+            LED_INST_OK == led_instantiate( &s_led_inst,
+                                            &s_mock_led_ops ) &&
+            BSP_OK == bsp_device_inst( &s_led_dev, "bench_led", &led_ops,
+                                       &s_led_inst ) &&
+            BSP_OK == bsp_device_register( &s_led_dev ) &&
+            BSP_OK == bsp_worker_inst( &worker, "bench_led_worker",
+                                       BENCH_DEVICE_WORKER_DEPTH, 256U,
+                                       1U ) &&
+            LED_HNDLR_OK == handler.pf_led_register( &handler,
+                                                     &s_led_dev ) ) ?
+          1U : 0U;
+    handler.p_worker = &worker;
+    handler.p_signal = &signal;
+    handler.sig_bits = BENCH_DEVICE_LED_DONE_BIT;
+
+    // queued: nothing switched in the caller; then the worker twinkles
+    // with the delay of the handler
+    s_led.on  = 0U;
+    s_led.off = 0U;
+    s_led.ms  = 0U;
+    ok &= ( LED_HNDLR_OK == handler.pf_led_ctrl( &handler, &s_led_dev,
+                                                 BENCH_DEVICE_LED_PERIOD,
+                                                 BENCH_DEVICE_LED_COUNT,
+                                                 DUTY_50_PERCENT ) &&
+            0U == s_led.on && 0U == s_led.off &&
+            SIGNAL_ERRORTIMEOUT == signal_wait( &signal,
+                                                BENCH_DEVICE_LED_DONE_BIT,
+                                                0U, &bits ) &&
+            BSP_OK == bsp_worker_run( &worker, 0U ) &&
+            SIGNAL_OK == signal_wait( &signal, BENCH_DEVICE_LED_DONE_BIT,
+                                      0U, &bits ) &&
+            BENCH_DEVICE_LED_COUNT == s_led.on &&
+            BENCH_DEVICE_LED_COUNT == s_led.off &&
+            BENCH_DEVICE_LED_COUNT * BENCH_DEVICE_LED_PERIOD ==
+            s_led.ms ) ? 1U : 0U;
+
+    // a twinkle and the LED on queued: the twinkle starts with the setting
+    // of the second call, one period all on, then the LED on
+    ok &= ( LED_HNDLR_OK == handler.pf_led_ctrl( &handler, &s_led_dev,
+                                                 BENCH_DEVICE_LED_PERIOD,
+                                                 BENCH_DEVICE_LED_COUNT,
+                                                 DUTY_50_PERCENT ) &&
+            LED_HNDLR_OK == handler.pf_led_ctrl( &handler, &s_led_dev,
+                                                 BENCH_DEVICE_LED_PERIOD,
+                                                 1U, DUTY_MAX_PERCENT ) &&
+            BENCH_DEVICE_LED_COUNT == s_led.on &&
+            BSP_OK == bsp_worker_run( &worker, 0U ) &&
+            BSP_OK == bsp_worker_run( &worker, 0U ) &&
+            BENCH_DEVICE_LED_COUNT + 2U == s_led.on &&
+            BENCH_DEVICE_LED_COUNT + 1U == s_led.off &&
+            ( BENCH_DEVICE_LED_COUNT + 1U ) * BENCH_DEVICE_LED_PERIOD ==
+            s_led.ms &&
+            BSP_ERRORTIMEOUT == bsp_worker_run( &worker, 0U ) &&
+            3U == worker.executed && 0U == worker.failed ) ? 1U : 0U;
+    printf( "# led_worker,%u on,%u off,%u ms,%s\r\n", (unsigned)s_led.on,
+            (unsigned)s_led.off, (unsigned)s_led.ms,
+            ( 0U != ok ) ? "ok" : "MISMATCH" );
+}
+
+/**
+ * @brief: Cost of a lookup in a full registry and of an ioctl on the LED
+ *         through the vtable and as a direct call
+ **/
+static void __cost_run ( void )
+{
+    bench_stat_t   stat[3];
+    bsp_device_t * dev;
+    uint32_t       t0;
+
+    (void)__reset();
+    for ( uint32_t i = 0; i < MAX_BSP_DEVICE_NUM - 1U; ++i )
+    {
+        (void)bsp_device_register( &s_devs[i] );
+    }
+    (void)bsp_device_inst( &s_led_dev, "bench_led", &led_ops, &s_led_inst );
+    (void)bsp_device_register( &s_led_dev );
+
+    bench_stat_reset( &stat[0] );
+    bench_stat_reset( &stat[1] );
+    bench_stat_reset( &stat[2] );
+    for ( uint32_t i = 0; i < s_iterations; ++i )
+    {
+        t0 = bench_timestamp_get();
+        dev = bsp_device_find( "bench_led" );
+        bench_stat_add( &stat[0], bench_timestamp_get() - t0 );
+        t0 = bench_timestamp_get();
+        (void)bsp_device_ioctl( dev, LED_IOCTL_ON, NULL );
+        bench_stat_add( &stat[1], bench_timestamp_get() - t0 );
+        t0 = bench_timestamp_get();
+        (void)BSP_DEVICE_IOCTL_AS( led, dev, LED_IOCTL_OFF, NULL );
+        bench_stat_add( &stat[2], bench_timestamp_get() - t0 );
+    }
+    bench_csv_row( BENCH_DEVICE_SUITE, "cpu", "find", &stat[0] );
+    bench_csv_row( BENCH_DEVICE_SUITE, "cpu", "ioctl", &stat[1] );
+    bench_csv_row( BENCH_DEVICE_SUITE, "cpu", "ioctl_as", &stat[2] );
+}
+
+/**
+ * @brief: Runner task, runs every line and deletes itself
+ *
+ * @param[in]  argument: Not used
+ **/
+static void bench_device_task ( void * argument )
+{
+    (void)argument;
+
+    for ( uint32_t i = 0; i < BENCH_DEVICE_NUM; ++i )
+    {
+        (void)snprintf( s_names[i], BENCH_DEVICE_NAME_LEN, "bench_%u",
+                        (unsigned)i );
+    }
+    bench_csv_header( BENCH_DEVICE_SUITE );
+    __registry_run();
+    __race_run();
+    __lock_run();
+    __led_run();
+    __worker_run();
+    __led_worker_run();
+    __cost_run();
+
+    vTaskDelete( NULL );
+}
+
+/**
+ * @brief: Start the device suite
+ * @steps:
+ *      1. Start the timestamp source
+ *      2. Create the runner task, it prints the CSV report and deletes itself
+ *
+ * @param[in]  iterations: samples of a case, 0 means default
+ *
+ * @return bench_status_t: execute result of this function
+ **/
+bench_status_t bench_device_start ( uint32_t iterations )
+{
+    bench_status_t ret = BENCH_OK;
+
+    /************** 1. Start the timestamp source *************/
+    ret = bench_timestamp_init();
+    if ( BENCH_OK != ret )
+    {
+        LOG( LOG_LEVEL_ERR, "Bench timestamp init failed" );
+        return ret;
+    }
+    s_iterations = ( 0U == iterations ) ? BENCH_DEVICE_ITERATIONS :
+                                          iterations;
+
+    /***************** 2. Create the runner ******************/
+    if ( pdPASS != xTaskCreate( bench_device_task,
+                                "bench_device",
+                                BENCH_DEVICE_STACK_WORDS,
+                                NULL,
+                                tskIDLE_PRIORITY + 1,
+                                NULL                   ) )
+    {
+        LOG( LOG_LEVEL_ERR, "Bench runner create failed" );
+        return BENCH_ERRORNOMEMORY;
+    }
+    return ret;
+}
+
+//******************************** Defines **********************************//
@@ -0,0 +1,238 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_bench_dsp.c
+ *
+ * @par dependencies
+ * - bsp_bench_dsp.h
+ * - bsp_dsp_chain.h
+ *
+ * @author Damian
+ *
+ * @brief Measure the throughput of the DSP chains, one row per chain and
+ *        block size plus the samples per second it sustains.
+ *
+ * Processing flow:
+ *
+ * Call directly.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+//******************************** Includes *********************************//
+
+#include "bsp_bench_dsp.h"
+#include "bsp_dsp_chain.h"
+#include "bsp_common.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+#define BENCH_DSP_SUITE         "dsp"
+
+typedef enum
+{
+    BENCH_DSP_CHAIN_FIR      = 0,    /* FIR                                  */
+    BENCH_DSP_CHAIN_DECIMATE = 1,    /* FIR, decimate                        */
+    BENCH_DSP_CHAIN_SPECTRUM = 2,    /* RFFT, magnitude, stats               */
+    BENCH_DSP_CHAIN_FULL     = 3,    /* FIR, decimate, RFFT, magnitude, stats*/
+    BENCH_DSP_CHAIN_NUM      = 4,    /* number of chains                     */
+} bench_dsp_chain_t;
+
+static const char * const s_chain_name[BENCH_DSP_CHAIN_NUM] =
+{
+    "fir", "decimate", "spectrum", "full",
+};
+
+static const uint32_t   s_block_len[] = { 64U, 128U, 256U };
+
+static uint32_t         s_iterations = BENCH_DSP_ITERATIONS;
+
+static dsp_chain_t      s_chain;
+static dsp_fir_t        s_fir;
+static dsp_decimate_t   s_dec;
+static dsp_rfft_t       s_rfft;
+static dsp_stats_t      s_stats;
+static float32_t        s_coeffs[BENCH_DSP_TAPS];
+static float32_t        s_input[DSP_BLOCK_MAX];
+
+/**
+ * @brief: Fill the input with a tone plus a deterministic noise
+ **/
+static void __input_init ( void )
+{
+    uint32_t seed = 0x2545F491U;
+
+    for ( uint32_t i = 0; i < DSP_BLOCK_MAX; ++i )
+    {
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        s_input[i] = 0.5f * sinf( 0.3f * (float32_t)i ) +
+                     (float32_t)( seed >> 8 ) / 33554432.0f - 0.25f;
+    }
+}
+
+/**
+ * @brief: Build one of the measured chains over block_len samples
+ *
+ * @param[in]  which:     chain to build
+ * @param[in]  block_len: input samples per block
+ *
+ * @return dsp_status_t: execute result of this function
+ **/
+static dsp_status_t __chain_build ( bench_dsp_chain_t which,
+                                    uint32_t          block_len )
+{
+    dsp_status_t ret;
+
+    ret = dsp_chain_inst( &s_chain, s_chain_name[which], block_len,
+                          NULL, NULL );
+    if ( DSP_OK == ret && ( BENCH_DSP_CHAIN_FIR      == which ||
+                            BENCH_DSP_CHAIN_DECIMATE == which ||
+                            BENCH_DSP_CHAIN_FULL     == which    ) )
+    {
+        ret = dsp_chain_add_fir( &s_chain, &s_fir, s_coeffs, BENCH_DSP_TAPS );
+    }
+    if ( DSP_OK == ret && ( BENCH_DSP_CHAIN_DECIMATE == which ||
+                            BENCH_DSP_CHAIN_FULL     == which    ) )
+    {
+        ret = dsp_chain_add_decimate( &s_chain, &s_dec, s_coeffs,
+                                      BENCH_DSP_TAPS, BENCH_DSP_DECIMATE );
+    }
+    if ( DSP_OK == ret && ( BENCH_DSP_CHAIN_SPECTRUM == which ||
+                            BENCH_DSP_CHAIN_FULL     == which    ) )
+    {
+        ret = dsp_chain_add_rfft( &s_chain, &s_rfft );
+        if ( DSP_OK == ret )
+        {
+            ret = dsp_chain_add_magnitude( &s_chain );
+        }
+        if ( DSP_OK == ret )
+        {
+            ret = dsp_chain_add_stats( &s_chain, &s_stats );
+        }
+    }
+    return ret;
+}
+
+/**
+ * @brief: Print the sustained rate of a row as a comment line
+ *
+ * @param[in]  mode:      name of the chain
+ * @param[in]  block_len: input samples per block
+ * @param[in]  stat:      Pointer to a instance of bench_stat_t
+ **/
+static void __rate_print (
+                           const char         * const mode,
+                           uint32_t                   block_len,
+                           const bench_stat_t * const stat
+                                                              )
+{
+    uint32_t avg_ns;
+
+    if ( 0U == stat->samples )
+    {
+        return;
+    }
+    avg_ns = bench_timestamp_to_ns( (uint32_t)( stat->sum / stat->samples ) );
+    if ( 0U == avg_ns )
+    {
+        return;
+    }
+    printf( "# %s,%u,%u samples/s\r\n", mode, (unsigned int)block_len,
+            (unsigned int)( (uint64_t)block_len * 1000000000ULL / avg_ns ) );
+}
+
+/**
+ * @brief: Runner task, runs all the chains and deletes itself
+ *
+ * @param[in]  argument: Not used
+ **/
+static void bench_dsp_task ( void * argument )
+{
+    bench_stat_t stat;
+    char         case_name[16];
+    uint32_t     block_num = sizeof( s_block_len ) / sizeof( s_block_len[0] );
+    uint32_t     t0;
+
+    (void)argument;
+
+    __input_init();
+    dsp_fir_lowpass_design( s_coeffs, BENCH_DSP_TAPS, 0.2f );
+    bench_csv_header( BENCH_DSP_SUITE );
+
+    for ( uint32_t c = 0; c < BENCH_DSP_CHAIN_NUM; ++c )
+    {
+        for ( uint32_t b = 0; b < block_num; ++b )
+        {
+            snprintf( case_name, sizeof( case_name ), "block_%u",
+                      (unsigned int)s_block_len[b] );
+            bench_stat_reset( &stat );
+            if ( DSP_OK != __chain_build( (bench_dsp_chain_t)c,
+                                          s_block_len[b]        ) )
+            {
+                LOG( LOG_LEVEL_ERR, "Bench dsp chain %s build failed",
+                                    s_chain_name[c] );
+                continue;
+            }
+            for ( uint32_t i = 0; i < s_iterations; ++i )
+            {
+                t0 = bench_timestamp_get();
+                dsp_chain_process( &s_chain, s_input );
+                bench_stat_add( &stat, bench_timestamp_get() - t0 );
+            }
+            bench_csv_row( BENCH_DSP_SUITE, s_chain_name[c], case_name, &stat );
+            __rate_print( s_chain_name[c], s_block_len[b], &stat );
+        }
+    }
+
+    vTaskDelete( NULL );
+}
+
+/**
+ * @brief: Start the DSP chain suite
+ * @steps:
+ *      1. Start the timestamp source
+ *      2. Create the runner task, it prints the CSV report and deletes itself
+ *
+ * @param[in]  iterations: samples per case, 0 means default
+ *
+ * @return bench_status_t: execute result of this function
+ **/
+bench_status_t bench_dsp_start ( uint32_t iterations )
+{
+    bench_status_t ret = BENCH_OK;
+
+    /************** 1. Start the timestamp source *************/
+    ret = bench_timestamp_init();
+    if ( BENCH_OK != ret )
+    {
+        LOG( LOG_LEVEL_ERR, "Bench timestamp init failed" );
+        return ret;
+    }
+    s_iterations = ( 0U == iterations ) ? BENCH_DSP_ITERATIONS : iterations;
+
+    /***************** 2. Create the runner ******************/
+    if ( pdPASS != xTaskCreate( bench_dsp_task,
+                                "bench_dsp",
+                                BENCH_DSP_STACK_WORDS,
+                                NULL,
+                                tskIDLE_PRIORITY + 1,
+                                NULL                       ) )
+    {
+        LOG( LOG_LEVEL_ERR, "Bench runner create failed" );
+        return BENCH_ERRORNOMEMORY;
+    }
+    return ret;
+}
+
+//******************************** Defines **********************************//
@@ -0,0 +1,230 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_bench_dsp_feature.c
+ *
+ * @par dependencies
+ * - bsp_bench_dsp_feature.h
+ * - bsp_bench_dsp_feature_ref.h
+ * - bsp_dsp_feature.h
+ *
+ * @author Damian
+ *
+ * @brief Measure the streaming feature extraction per hop and check it
+ *        against the NumPy reference of 08_Tools/dsp_feature.
+ *
+ * Processing flow:
+ *
+ * Call directly.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+//******************************** Includes *********************************//
+
+#include "bsp_bench_dsp_feature.h"
+#include "bsp_bench_dsp_feature_ref.h"
+#include "bsp_dsp_feature.h"
+#include "bsp_common.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include <string.h>
+#include <math.h>
+
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+#define BENCH_DSP_FEATURE_SUITE     "dsp_feature"
+
+typedef struct
+{
+    uint32_t              err;                    /* max column error, 1e-6  */
+    uint32_t              s8_diff;                /* max int8 step difference*/
+} bench_dsp_feature_check_t;
+
+static uint32_t         s_iterations = BENCH_DSP_FEATURE_ITERATIONS;
+
+// far too large for the runner stack
+static dsp_feature_t    s_feat;
+static float32_t        s_hop[DSP_FEATURE_FFT_MAX];
+static int8_t           s_tensor[DSP_FEATURE_COLUMN_MAX * DSP_FEATURE_MEL_MAX];
+
+/**
+ * @brief: Take the next hop of the test signal as float, wrapping around
+ *
+ * @param[in]  hop_len: samples of the hop
+ * @param[in]  pos:     first sample, advanced by hop_len
+ **/
+static void __hop_next ( uint32_t hop_len, uint32_t * const pos )
+{
+    for ( uint32_t i = 0; i < hop_len; ++i )
+    {
+        s_hop[i] = (float32_t)bench_dsp_feature_ref_signal[*pos] / 32768.0f;
+        *pos = ( *pos + 1U ) % BENCH_DSP_FEATURE_REF_LEN;
+    }
+}
+
+/**
+ * @brief: Largest difference of the newest column to the reference
+ *
+ * @param[in]  ref: reference column
+ *
+ * @return uint32_t: in millionths
+ **/
+static uint32_t __column_err ( const float32_t * const ref )
+{
+    float32_t err = 0.0f;
+
+    for ( uint32_t i = 0; i < s_feat.coeff_num; ++i )
+    {
+        if ( fabsf( s_feat.column[i] - ref[i] ) > err )
+        {
+            err = fabsf( s_feat.column[i] - ref[i] );
+        }
+    }
+    return (uint32_t)( err * 1e6f + 0.5f );
+}
+
+/**
+ * @brief: Run one reference case
+ * @steps:
+ *      1. Instantiate the feature extraction
+ *      2. Stream the signal once, time and check every column
+ *      3. Check the int8 spectrogram after the last hop
+ *      4. Keep streaming until the iterations are timed
+ *
+ * @param[in]  ref: the case
+ **/
+static void __case_run ( const bench_dsp_feature_ref_t * const ref )
+{
+    bench_stat_t              stat;
+    bench_dsp_feature_check_t check = { 0U, 0U };
+    uint32_t                  pos = 0U;
+    uint32_t                  t0;
+    uint32_t                  err;
+    uint32_t                  avg_ns;
+    uint32_t                  load = 0U;
+    int32_t                   diff;
+    uint32_t                  len;
+
+    /***************** 1. Instantiate *********************/
+    if ( DSP_OK != dsp_feature_inst( &s_feat, &ref->cfg ) )
+    {
+        LOG( LOG_LEVEL_ERR, "Bench feature %s %s init failed",
+                            ref->mode, ref->case_name );
+        return;
+    }
+
+    /***************** 2. Stream once, check **************/
+    bench_stat_reset( &stat );
+    for ( uint32_t h = 0; h < ref->hops; ++h )
+    {
+        __hop_next( ref->cfg.hop_len, &pos );
+        t0 = bench_timestamp_get();
+        dsp_feature_process( &s_feat, s_hop );
+        bench_stat_add( &stat, bench_timestamp_get() - t0 );
+        err = __column_err( &ref->columns[h * s_feat.coeff_num] );
+        if ( err > check.err )
+        {
+            check.err = err;
+        }
+    }
+
+    /***************** 3. Spectrogram *********************/
+    dsp_feature_to_s8( &s_feat, s_tensor );
+    len = ref->cfg.column_num * s_feat.coeff_num;
+    for ( uint32_t i = 0; i < len; ++i )
+    {
+        diff = (int32_t)s_tensor[i] - ref->tensor[i];
+        diff = ( 0 > diff ) ? -diff : diff;
+        if ( (uint32_t)diff > check.s8_diff )
+        {
+            check.s8_diff = (uint32_t)diff;
+        }
+    }
+
+    /***************** 4. Time the rest *******************/
+    while ( stat.samples < s_iterations )
+    {
+        __hop_next( ref->cfg.hop_len, &pos );
+        t0 = bench_timestamp_get();
+        dsp_feature_process( &s_feat, s_hop );
+        bench_stat_add( &stat, bench_timestamp_get() - t0 );
+    }
+    bench_csv_row( BENCH_DSP_FEATURE_SUITE, ref->mode, ref->case_name, &stat );
+
+    // load in tenths of a percent: hop time over hop_len / sample_rate
+    avg_ns = bench_timestamp_to_ns( (uint32_t)( stat.sum / stat.samples ) );
+    load   = (uint32_t)( (uint64_t)avg_ns * ref->cfg.sample_rate /
+                         ( (uint64_t)ref->cfg.hop_len * 1000000ULL ) );
+    printf( "# %s,%s,frame %u,load %u.%u %%,err %u e-6,s8 diff %u,%s\r\n",
+            ref->mode, ref->case_name, (unsigned int)ref->cfg.frame_len,
+            (unsigned int)( load / 10U ), (unsigned int)( load % 10U ),
+            (unsigned int)check.err, (unsigned int)check.s8_diff,
+            ( BENCH_DSP_FEATURE_TOL >= check.err && 1U >= check.s8_diff ) ?
+            "ok" : "MISMATCH" );
+}
+
+/**
+ * @brief: Runner task, runs every reference case and deletes itself
+ *
+ * @param[in]  argument: Not used
+ **/
+static void bench_dsp_feature_task ( void * argument )
+{
+    (void)argument;
+
+    bench_csv_header( BENCH_DSP_FEATURE_SUITE );
+    for ( uint32_t i = 0; i < BENCH_DSP_FEATURE_REF_CASES; ++i )
+    {
+        __case_run( &bench_dsp_feature_ref_case[i] );
+    }
+
+    vTaskDelete( NULL );
+}
+
+/**
+ * @brief: Start the feature extraction suite
+ * @steps:
+ *      1. Start the timestamp source
+ *      2. Create the runner task, it prints the CSV report and deletes itself
+ *
+ * @param[in]  iterations: hops timed per case, 0 means default
+ *
+ * @return bench_status_t: execute result of this function
+ **/
+bench_status_t bench_dsp_feature_start ( uint32_t iterations )
+{
+    bench_status_t ret = BENCH_OK;
+
+    /************** 1. Start the timestamp source *************/
+    ret = bench_timestamp_init();
+    if ( BENCH_OK != ret )
+    {
+        LOG( LOG_LEVEL_ERR, "Bench timestamp init failed" );
+        return ret;
+    }
+    s_iterations = ( 0U == iterations ) ? BENCH_DSP_FEATURE_ITERATIONS :
+                                          iterations;
+
+    /***************** 2. Create the runner ******************/
+    if ( pdPASS != xTaskCreate( bench_dsp_feature_task,
+                                "bench_feature",
+                                BENCH_DSP_FEATURE_STACK_WORDS,
+                                NULL,
+                                tskIDLE_PRIORITY + 1,
+                                NULL                       ) )
+    {
+        LOG( LOG_LEVEL_ERR, "Bench runner create failed" );
+        return BENCH_ERRORNOMEMORY;
+    }
+    return ret;
+}
+
+//******************************** Defines **********************************//
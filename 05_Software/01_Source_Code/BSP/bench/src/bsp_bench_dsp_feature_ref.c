@@ -0,0 +1,809 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_bench_dsp_feature_ref.c
+ *
+ * @par dependencies
+ * - bsp_dsp_feature.h
+ *
+ * @author Damian
+ *
+ * @brief Reference of the feature bench: the test signal, the float column
+ *        of every hop and the int8 spectrogram after the last hop.
+ *
+ * Processing flow:
+ *
+ * Call directly.
+ *
+ * Generated by 08_Tools/dsp_feature/dsp_feature_ref.py --seed 1,
+ * do not edit.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+//******************************** Includes *********************************//
+
+#include "bsp_bench_dsp_feature_ref.h"
+
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+static const float32_t s_case0_columns[120] =
+{
+    0.88963902f, 8.05493641f, 7.3246789f, 6.1468339f,
+    0.0428885706f, -3.48011136f, -1.26158607f, 1.76902401f,
+    -2.51689696f, -0.266720176f, 15.5310097f, 8.73812199f,
+    7.62930679f, 3.76537538f, -3.40862322f, -5.53450632f,
+    -1.31512511f, 1.20165217f, -1.37912059f, -0.0848170072f,
+    17.7744789f, 6.77762794f, 0.650507271f, -6.48070812f,
+    -7.13336611f, -4.25686693f, 0.997199953f, 1.07056355f,
+    -2.98484254f, -1.85898197f, 15.6769009f, 1.51152265f,
+    -8.06645775f, -9.33944321f, -1.45154953f, 1.3483094f,
+    0.702027559f, -1.40868139f, -2.10091209f, 1.08178258f,
+    15.6491432f, -1.02829707f, -8.93118191f, -2.206074f,
+    5.22748327f, -1.03606629f, -6.87288713f, -2.80202556f,
+    -0.860768497f, 0.396232218f, 13.6533937f, -2.59836149f,
+    -6.18025017f, 2.44899607f, 4.74063492f, -6.34895992f,
+    -6.1055007f, 1.10544848f, -0.00300008594f, -1.83056498f,
+    11.7688942f, -4.99459696f, -3.90312099f, 4.9469552f,
+    0.386664748f, -8.3931179f, 0.12572886f, 2.00936198f,
+    -2.94135761f, 1.08576429f, 11.2054777f, -6.75312328f,
+    -3.01821947f, 5.61797285f, -3.72143579f, -6.76787758f,
+    1.62825763f, -3.59362602f, -2.92764258f, 4.10274124f,
+    11.5433464f, -7.57737255f, -2.00532722f, 5.26182652f,
+    -6.3312788f, -3.88956022f, 0.96846354f, -5.02738523f,
+    -0.583403826f, 0.836957812f, 11.9625683f, -7.30828857f,
+    -0.681567371f, 3.21867514f, -6.44114733f, -0.623796344f,
+    -2.56988239f, -4.02603436f, 0.477859467f, -3.48285437f,
+    12.259408f, -5.84220219f, 0.968306541f, 2.32137465f,
+    -5.40406466f, 0.00537515339f, -4.89803219f, -0.146051928f,
+    -0.725102663f, -3.57324243f, 11.7022085f, -6.64576292f,
+    0.523646593f, -0.240653396f, -4.23336411f, -0.934534609f,
+    -6.6023984f, 2.00360465f, -4.00900078f, -0.441287041f,
+};
+
+static const int8_t    s_case0_tensor[120] =
+{
+    -32, 36, 29, 18, -40, -73, -52, -23, -64, -43, 106, 42,
+    32, -5, -72, -92, -52, -29, -53, -41, 127, 24, -34, -101,
+    -107, -80, -31, -30, -68, -57, 107, -26, -116, -128, -54, -27,
+    -33, -53, -60, -30, 107, -50, -124, -61, 9, -50, -105, -66,
+    -48, -36, 88, -64, -98, -17, 5, -100, -97, -30, -40, -57,
+    71, -87, -77, 7, -36, -119, -39, -21, -68, -30, 65, -104,
+    -68, 13, -75, -104, -25, -74, -68, -1, 69, -111, -59, 9,
+    -100, -77, -31, -87, -45, -32, 73, -109, -46, -10, -101, -46,
+    -64, -78, -36, -73, 75, -95, -31, -18, -91, -40, -86, -41,
+    -47, -74, 70, -103, -35, -42, -80, -49, -102, -21, -78, -44,
+};
+
+static const float32_t s_case1_columns[60] =
+{
+    15.5310097f, 8.73812199f, 7.62930679f, 3.76537538f,
+    -3.40862322f, -5.53450632f, -1.31512511f, 1.20165217f,
+    -1.37912059f, -0.0848170072f, 15.6769009f, 1.51152265f,
+    -8.06645775f, -9.33944321f, -1.45154953f, 1.3483094f,
+    0.702027559f, -1.40868139f, -2.10091209f, 1.08178258f,
+    13.6533937f, -2.59836149f, -6.18025017f, 2.44899607f,
+    4.74063492f, -6.34895992f, -6.1055007f, 1.10544848f,
+    -0.00300008594f, -1.83056498f, 11.2054777f, -6.75312328f,
+    -3.01821947f, 5.61797285f, -3.72143579f, -6.76787758f,
+    1.62825763f, -3.59362602f, -2.92764258f, 4.10274124f,
+    11.9625683f, -7.30828857f, -0.681567371f, 3.21867514f,
+    -6.44114733f, -0.623796344f, -2.56988239f, -4.02603436f,
+    0.477859467f, -3.48285437f, 11.7022085f, -6.64576292f,
+    0.523646593f, -0.240653396f, -4.23336411f, -0.934534609f,
+    -6.6023984f, 2.00360465f, -4.00900078f, -0.441287041f,
+};
+
+static const int8_t    s_case1_tensor[60] =
+{
+    125, 56, 45, 5, -68, -89, -46, -21, -47, -34, 127, -18,
+    -115, -128, -48, -19, -26, -47, -54, -22, 106, -59, -96, -8,
+    15, -98, -95, -22, -33, -52, 81, -102, -64, 24, -71, -102,
+    -16, -70, -63, 9, 89, -107, -40, 0, -99, -39, -59, -74,
+    -28, -69, 86, -101, -28, -35, -76, -43, -100, -13, -74, -37,
+};
+
+static const float32_t s_case2_columns[40] =
+{
+    16.9837055f, 5.29093361f, -1.81488895f, -8.63297939f,
+    -7.200243f, -3.54389501f, 1.14750874f, 0.580788732f,
+    -3.16395974f, -1.16027582f, 12.4999361f, -3.67740989f,
+    -5.15107727f, 3.81968331f, 3.14673901f, -7.7971406f,
+    -3.26183701f, 2.50633931f, -1.4125464f, -1.77195454f,
+    11.7691908f, -7.46074247f, -1.30774355f, 3.96473813f,
+    -6.56189871f, -1.51539445f, -1.05014336f, -4.53212452f,
+    0.393062353f, -2.18184042f, 11.0323582f, -6.52789879f,
+    2.02403641f, -0.949065268f, -2.29762197f, -1.98364484f,
+    -5.84910727f, 2.54576492f, -5.94337034f, 1.87279415f,
+};
+
+static const int8_t    s_case2_tensor[40] =
+{
+    127, 11, -60, -128, -114, -77, -31, -36, -73, -54, 82, -79,
+    -93, -4, -11, -120, -74, -17, -56, -60, 75, -116, -55, -3,
+    -107, -57, -52, -87, -38, -64, 68, -107, -22, -51, -65, -62,
+    -100, -17, -101, -23,
+};
+
+static const float32_t s_case3_columns[640] =
+{
+    1.70754755f, 1.12390757f, 0.878220201f, 0.602193773f,
+    -0.490999848f, -2.11195421f, -3.13493991f, -3.42777491f,
+    -3.93947196f, -3.81845665f, -1.61552119f, 0.39809972f,
+    -0.0876045302f, -2.88853931f, -3.63940287f, -2.75568604f,
+    -2.01603198f, -1.96060348f, -2.50039935f, -2.93009591f,
+    4.88303995f, 4.178092f, 4.4983511f, 2.95325828f,
+    0.999106526f, -0.113034368f, -1.08169973f, -0.72762078f,
+    -1.37682903f, -2.0015583f, -0.0101539958f, 3.13032269f,
+    2.69809318f, -0.433055937f, -0.782488227f, 0.149499789f,
+    0.442302287f, 0.376361996f, 0.0148589173f, -0.139156312f,
+    5.50081396f, 6.18981123f, 6.25620413f, 3.29255629f,
+    0.709812105f, 0.155323282f, -0.690107703f, -0.60864985f,
+    -1.08752966f, -1.91717374f, -0.732949376f, 3.71655011f,
+    3.30192542f, 0.745519698f, 0.589237511f, 0.884034991f,
+    0.972965419f, 0.932550311f, 0.656116009f, 0.781575322f,
+    3.64591265f, 5.49289513f, 6.76329374f, 5.85369158f,
+    4.0687499f, 1.29830372f, -0.707183719f, -1.04839754f,
+    -0.748037457f, -1.03121758f, -0.737241089f, 3.66407943f,
+    3.27670956f, 0.797413826f, 0.902594745f, 1.20554268f,
+    1.16083682f, 1.08765805f, 0.615276396f, 1.12668538f,
+    -0.43663007f, 3.42026997f, 6.06579447f, 6.06081057f,
+    5.9904561f, 4.52951956f, 1.42923903f, -1.41340911f,
+    -0.511460781f, -0.0723530129f, -0.567197204f, 3.53202963f,
+    3.11185074f, 0.139740542f, 0.846005142f, 0.727607667f,
+    1.09552622f, 1.10379112f, 0.882780015f, 1.39706874f,
+    -2.37431908f, 3.46718216f, 5.25490713f, 4.17472553f,
+    5.83172703f, 6.13213301f, 4.72582293f, 1.34869754f,
+    -1.13029444f, -0.805577815f, -0.452892482f, 3.48375225f,
+    2.99011946f, -0.772627592f, 0.0784089863f, -0.220849767f,
+    1.14300954f, 1.49949169f, 0.803386807f, 1.63815498f,
+    -1.29541445f, 3.53146672f, 5.30914974f, 3.09409285f,
+    3.60963869f, 5.76187754f, 6.24269199f, 4.68271542f,
+    0.946632028f, -0.690714061f, -0.317569256f, 3.52949595f,
+    3.08811092f, -0.0529118925f, 0.325119406f, 0.66145426f,
+    0.503521562f, 1.00382459f, 0.780454159f, 1.35124564f,
+    -1.15222156f, 3.48856091f, 5.25455999f, 2.8452065f,
+    -0.236791924f, 3.4669261f, 5.94558239f, 6.2706728f,
+    4.34104347f, 0.310089469f, -0.65035224f, 3.69155383f,
+    3.25821829f, 0.383124739f, 0.468701839f, 1.00394726f,
+    0.778721035f, 0.805966616f, 0.635908306f, 1.24048495f,
+    -1.59556997f, 3.4823668f, 5.27981949f, 2.961169f,
+    -0.735684454f, 0.210778788f, 3.89773393f, 6.12251091f,
+    6.14413691f, 3.48400903f, 0.158664063f, 3.88106918f,
+    3.42431545f, -0.295628726f, -0.141477376f, 0.24837555f,
+    0.681807578f, 0.890915096f, 0.639324367f, 1.01088738f,
+    -0.928551197f, 3.53013277f, 5.30889082f, 3.11974382f,
+    -0.2072891f, 0.117961176f, 0.38690868f, 4.3133049f,
+    6.41510487f, 5.81836843f, 2.17889476f, 3.77886152f,
+    3.33375454f, -0.0759670287f, 0.0635390803f, 0.806935787f,
+    1.19172168f, 1.50201058f, 0.782709718f, 0.869972587f,
+    0.405465931f, 3.4082334f, 5.20984125f, 2.80340648f,
+    0.279146045f, 0.097423099f, -0.106638558f, 1.2730943f,
+    5.21402454f, 6.54533482f, 5.01431084f, 3.79700208f,
+    3.38033032f, 0.0254278798f, 0.830456555f, 0.846031666f,
+    1.08003879f, 1.52412367f, 0.829697728f, 0.627223492f,
+    0.380020231f, 3.49084616f, 5.21238041f, 2.99895048f,
+    -0.273589373f, -0.564974427f, -0.284310549f, 0.669256866f,
+    2.43272305f, 5.97186422f, 6.4163065f, 4.37920952f,
+    3.43723035f, -0.0378495604f, 0.895079792f, 0.701219559f,
+    0.798363388f, 1.22483122f, 1.35419083f, 0.989388168f,
+    -0.940578759f, 3.22927141f, 5.11444712f, 2.81698751f,
+    -0.514900744f, -0.384913445f, -0.254086763f, 0.286265671f,
+    -0.334822595f, 4.07149506f, 6.51849461f, 5.8368187f,
+    3.52842879f, 0.189341083f, 0.537232995f, 0.53397125f,
+    0.156738698f, 0.899083912f, 1.4250282f, 0.934202731f,
+    -1.61428249f, 3.40524554f, 5.14494133f, 2.80932426f,
+    -0.307602108f, -0.21622923f, -0.951429784f, 0.0794544443f,
+    -0.880250514f, 0.814584494f, 5.43784332f, 6.51445341f,
+    4.12651539f, 0.981200337f, 0.206591189f, 0.455439985f,
+    0.457157463f, 0.724564672f, 0.877462268f, 0.9832744f,
+    -1.80831265f, 3.46070981f, 5.19807482f, 2.77822113f,
+    -0.569845438f, -0.432723969f, -0.499443978f, -0.157613963f,
+    -0.935600758f, 0.301894516f, 2.89390397f, 6.01554203f,
+    5.62843609f, 1.67410016f, 0.466807902f, 0.703305542f,
+    0.391725719f, 1.00564444f, 0.664718866f, 1.62855911f,
+    -1.39087927f, 3.44745421f, 5.29935598f, 3.09589314f,
+    -0.790091038f, -0.604854703f, -0.905427217f, -1.10908127f,
+    -0.757317781f, 0.749657094f, 0.651084661f, 5.13587904f,
+    6.60444021f, 4.2647028f, 0.388422012f, 0.694235504f,
+    0.628504395f, 0.950535476f, 1.48129463f, 1.7078861f,
+    -2.25577998f, 3.52293062f, 5.37271023f, 3.11262202f,
+    -1.32402253f, -0.545440912f, -0.0325039364f, -1.47473001f,
+    0.0768943951f, 0.914231122f, 0.43575877f, 3.94714236f,
+    6.43258572f, 5.95087767f, 0.710913658f, 0.763887882f,
+    0.681416571f, 0.662835956f, 1.41538429f, 1.34930003f,
+    -2.72312307f, 3.74538469f, 5.42232418f, 3.07864618f,
+    -0.957556129f, -1.14264131f, 0.17822203f, -0.423867434f,
+    0.193202734f, 0.914594591f, -0.14354071f, 3.68940043f,
+    5.48007298f, 6.61178207f, 3.7609365f, 0.833244026f,
+    0.642970204f, 1.17966568f, 1.11914539f, 1.01647854f,
+    -2.14678264f, 3.54562569f, 5.3515358f, 2.99495769f,
+    -1.1020565f, -0.965103269f, -0.894085824f, -0.756932318f,
+    -0.0052592787f, -0.246721938f, -0.529207528f, 3.79813671f,
+    3.851547f, 6.5075841f, 5.6676693f, 0.629472554f,
+    0.780706525f, 0.952280939f, 0.84053576f, 0.895941675f,
+    -1.7072798f, 3.5463295f, 5.30566835f, 3.05058956f,
+    -1.12128878f, -1.13096595f, -0.138970345f, -0.569600224f,
+    -0.0927644223f, -1.11367679f, 0.288151801f, 3.86427331f,
+    3.39196253f, 5.75870848f, 6.47336435f, 2.49389744f,
+    1.22167826f, 1.00111306f, 0.836600482f, 1.21453714f,
+    -2.65121436f, 3.40466666f, 5.19414091f, 2.8278451f,
+    -1.19924533f, -0.423966765f, -0.0255567227f, -0.210582957f,
+    -0.64776057f, -0.957544923f, 0.695560634f, 3.85869026f,
+    3.45277834f, 3.9390192f, 6.62466335f, 4.94340563f,
+    0.896709979f, 1.3878988f, 1.01309228f, 0.833156765f,
+    -2.07185674f, 3.28941131f, 5.1815834f, 2.92920947f,
+    -0.471930414f, 0.29538995f, 0.0458116345f, 0.0599477515f,
+    0.120328873f, -0.41178149f, 0.231334075f, 3.59095669f,
+    3.15721726f, 1.15070689f, 6.23127413f, 6.15356159f,
+    1.12436116f, 1.61990678f, 0.9248721f, 0.935117781f,
+    -0.756667912f, 3.5810647f, 5.2688365f, 2.92623305f,
+    -0.404548109f, -0.518495858f, 0.708187997f, 0.323096395f,
+    0.298683405f, -0.021219084f, -0.212635234f, 3.48939419f,
+    3.00266981f, 0.67511791f, 5.25525188f, 6.69832277f,
+    3.50869775f, 1.38135779f, 0.911137581f, 1.19417179f,
+    -1.14628816f, 3.41099405f, 5.2869401f, 3.03566289f,
+    -0.182101414f, -0.907408774f, 0.60775584f, 0.0738066807f,
+    -0.194428712f, 0.00490154605f, 0.0939616412f, 3.47394347f,
+    2.96539617f, 0.811842501f, 3.1269474f, 6.65768051f,
+    5.41471815f, 1.30025434f, 0.747299373f, 0.986118019f,
+    -0.93047291f, 3.73893785f, 5.32064629f, 2.88591981f,
+    -0.671349406f, 0.317319989f, 0.672776163f, -0.433377564f,
+    -0.0778655261f, -0.0519399494f, 0.466900021f, 3.52887297f,
+    3.06272125f, 0.962167919f, 0.568178296f, 6.11962318f,
+    6.25688171f, 1.11893618f, 0.530415297f, 0.684933186f,
+    -1.0508287f, 3.40663862f, 5.23381948f, 3.00504899f,
+    -0.553180754f, 0.456370473f, -0.150379047f, -1.16382945f,
+    0.025684312f, -0.212498993f, 0.415592253f, 3.60110188f,
+    3.15349102f, 0.717139781f, 0.345078588f, 5.07859039f,
+    6.67032242f, 3.38482451f, 1.2373296f, 0.772254705f,
+    -1.74078739f, 3.29259586f, 5.16526604f, 2.81647968f,
+    -0.509528875f, -0.601015747f, -0.344971359f, 0.149437815f,
+    0.161028892f, -0.0447334312f, 0.847360909f, 3.64085054f,
+    3.17210507f, -0.361558557f, 0.50185293f, 2.98068738f,
+    6.57967186f, 5.21953583f, 1.11505902f, 0.912178874f,
+    -2.52522945f, 3.55402589f, 5.32121754f, 3.14352202f,
+    -0.324992537f, 0.0151443873f, 0.45244509f, 0.944359899f,
+    0.520847082f, -0.296870202f, 1.14547539f, 3.59909058f,
+    3.10570669f, 0.509966016f, 0.268531352f, 0.686200559f,
+    6.16549015f, 6.14016819f, 0.81670022f, 0.968803823f,
+    -1.15454006f, 3.53305626f, 5.30376005f, 3.02217507f,
+    -0.46580866f, -0.227576956f, 0.188790455f, 0.783619881f,
+    0.315539807f, -0.136621505f, 0.0227559619f, 3.56401181f,
+    3.12102699f, 0.906972826f, 0.572166324f, 0.0377910994f,
+    5.40446568f, 6.65784931f, 2.40411377f, 0.747828245f,
+    -1.25655997f, 3.39430523f, 5.25339127f, 2.96929049f,
+    -1.44940495f, -1.63838899f, -0.098338671f, 0.223618224f,
+    -0.62184149f, 0.0798459277f, -0.0588902608f, 3.56614923f,
+    3.1068182f, 0.512889028f, 0.339280546f, 0.131553039f,
+    3.70688725f, 6.71563244f, 4.68702698f, 0.6705513f,
+    -1.64369249f, 3.63412499f, 5.32083511f, 2.97154212f,
+    0.264541864f, -0.202873379f, -0.191970408f, -0.0807347074f,
+    -1.30135763f, -0.072205618f, 0.413468063f, 3.67469192f,
+    3.21230578f, 0.609561145f, 0.0988593474f, 0.373625398f,
+    1.4365375f, 6.43217182f, 5.86844254f, 1.29399872f,
+    -1.29002023f, 3.51150799f, 5.28713179f, 2.96009183f,
+    0.196479082f, -0.579837859f, -0.580099583f, -0.152585879f,
+    -0.23477307f, -0.476288289f, 0.16612497f, 3.84160066f,
+    3.36584473f, -0.00594527833f, 0.0592463613f, 0.521484196f,
+    1.18738937f, 5.99497986f, 6.48947859f, 1.45081866f,
+};
+
+static const int8_t    s_case3_tensor[640] =
+{
+    7, -7, -13, -20, -46, -84, -109, -116, -128, -125, -72, -25,
+    -36, -103, -121, -100, -82, -81, -94, -104, 82, 66, 73, 36,
+    -10, -37, -60, -51, -67, -82, -34, 41, 30, -44, -53, -30,
+    -23, -25, -34, -37, 97, 113, 115, 44, -17, -30, -50, -49,
+    -60, -80, -51, 55, 45, -16, -20, -13, -11, -12, -18, -15,
+    53, 97, 127, 105, 63, -3, -51, -59, -52, -59, -52, 53,
+    44, -15, -12, -5, -6, -8, -19, -7, -44, 47, 111, 110,
+    109, 74, 0, -68, -46, -36, -48, 50, 40, -31, -14, -17,
+    -8, -8, -13, -1, -91, 49, 91, 65, 105, 112, 79, -2,
+    -61, -53, -45, 49, 37, -52, -32, -39, -7, 2, -15, 5,
+    -65, 50, 92, 40, 52, 103, 115, 78, -11, -50, -42, 50,
+    40, -35, -26, -18, -22, -10, -15, -2, -61, 49, 91, 34,
+    -40, 49, 108, 115, 69, -27, -49, 54, 44, -25, -23, -10,
+    -15, -15, -19, -4, -72, 49, 92, 37, -52, -29, 59, 112,
+    112, 49, -30, 58, 48, -41, -37, -28, -18, -13, -19, -10,
+    -56, 50, 92, 40, -39, -31, -25, 69, 119, 105, 18, 56,
+    45, -36, -32, -15, -6, 2, -15, -13, -24, 47, 90, 33,
+    -27, -32, -37, -4, 90, 122, 85, 56, 47, -33, -14, -14,
+    -8, 2, -14, -19, -25, 49, 90, 37, -41, -47, -41, -18,
+    24, 108, 119, 70, 48, -35, -13, -17, -15, -5, -2, -10,
+    -56, 43, 88, 33, -46, -43, -40, -27, -42, 63, 121, 105,
+    50, -29, -21, -21, -30, -13, 0, -12, -72, 47, 89, 33,
+    -41, -39, -57, -32, -55, -15, 96, 121, 64, -11, -29, -23,
+    -23, -17, -13, -11, -77, 48, 90, 32, -48, -44, -46, -38,
+    -56, -27, 35, 109, 100, 6, -23, -17, -25, -10, -18, 5,
+    -67, 48, 92, 40, -53, -48, -56, -60, -52, -16, -18, 88,
+    123, 68, -25, -17, -19, -11, 1, 7, -88, 50, 94, 40,
+    -66, -47, -35, -69, -32, -12, -24, 60, 119, 108, -17, -16,
+    -18, -18, 0, -2, -99, 55, 95, 39, -57, -61, -30, -44,
+    -29, -12, -37, 54, 97, 124, 56, -14, -19, -6, -7, -10,
+    -85, 50, 94, 37, -60, -57, -55, -52, -34, -40, -47, 56,
+    58, 121, 101, -19, -15, -11, -14, -13, -75, 50, 92, 39,
+    -61, -61, -37, -48, -36, -61, -27, 58, 47, 103, 120, 25,
+    -5, -10, -14, -5, -97, 47, 90, 33, -63, -44, -35, -39,
+    -49, -57, -17, 58, 48, 60, 124, 84, -13, -1, -10, -14,
+    -83, 44, 89, 36, -45, -27, -33, -33, -31, -44, -28, 52,
+    41, -7, 114, 113, -7, 5, -12, -12, -52, 51, 92, 36,
+    -44, -46, -17, -26, -27, -35, -39, 49, 38, -18, 91, 126,
+    50, -1, -12, -6, -61, 47, 92, 38, -38, -56, -20, -32,
+    -39, -34, -32, 49, 37, -15, 41, 125, 95, -3, -16, -11,
+    -56, 55, 93, 35, -50, -26, -18, -44, -36, -35, -23, 50,
+    39, -11, -20, 112, 115, -7, -21, -18, -59, 47, 91, 38,
+    -47, -23, -38, -62, -33, -39, -24, 52, 41, -17, -26, 87,
+    125, 47, -5, -16, -75, 44, 89, 33, -46, -48, -42, -30,
+    -30, -35, -14, 53, 42, -43, -22, 37, 123, 90, -7, -12,
+    -94, 51, 93, 41, -42, -34, -23, -12, -22, -41, -7, 52,
+    40, -22, -28, -18, 113, 112, -15, -11, -62, 50, 92, 38,
+    -45, -39, -30, -15, -26, -37, -33, 51, 40, -12, -20, -33,
+    95, 125, 23, -16, -64, 47, 91, 37, -69, -73, -36, -29,
+    -49, -32, -35, 51, 40, -22, -26, -31, 54, 126, 78, -18,
+    -73, 53, 93, 37, -28, -39, -39, -36, -65, -36, -24, 54,
+    43, -19, -32, -25, 0, 119, 106, -3, -65, 50, 92, 37,
+    -29, -48, -48, -38, -40, -45, -30, 58, 46, -34, -33, -22,
+    -6, 109, 121, 1,
+};
+
+static const float32_t s_case4_columns[320] =
+{
+    4.88303995f, 4.178092f, 4.4983511f, 2.95325828f,
+    0.999106526f, -0.113034368f, -1.08169973f, -0.72762078f,
+    -1.37682903f, -2.0015583f, -0.0101539958f, 3.13032269f,
+    2.69809318f, -0.433055937f, -0.782488227f, 0.149499789f,
+    0.442302287f, 0.376361996f, 0.0148589173f, -0.139156312f,
+    3.64591265f, 5.49289513f, 6.76329374f, 5.85369158f,
+    4.0687499f, 1.29830372f, -0.707183719f, -1.04839754f,
+    -0.748037457f, -1.03121758f, -0.737241089f, 3.66407943f,
+    3.27670956f, 0.797413826f, 0.902594745f, 1.20554268f,
+    1.16083682f, 1.08765805f, 0.615276396f, 1.12668538f,
+    -2.37431908f, 3.46718216f, 5.25490713f, 4.17472553f,
+    5.83172703f, 6.13213301f, 4.72582293f, 1.34869754f,
+    -1.13029444f, -0.805577815f, -0.452892482f, 3.48375225f,
+    2.99011946f, -0.772627592f, 0.0784089863f, -0.220849767f,
+    1.14300954f, 1.49949169f, 0.803386807f, 1.63815498f,
+    -1.15222156f, 3.48856091f, 5.25455999f, 2.8452065f,
+    -0.236791924f, 3.4669261f, 5.94558239f, 6.2706728f,
+    4.34104347f, 0.310089469f, -0.65035224f, 3.69155383f,
+    3.25821829f, 0.383124739f, 0.468701839f, 1.00394726f,
+    0.778721035f, 0.805966616f, 0.635908306f, 1.24048495f,
+    -0.928551197f, 3.53013277f, 5.30889082f, 3.11974382f,
+    -0.2072891f, 0.117961176f, 0.38690868f, 4.3133049f,
+    6.41510487f, 5.81836843f, 2.17889476f, 3.77886152f,
+    3.33375454f, -0.0759670287f, 0.0635390803f, 0.806935787f,
+    1.19172168f, 1.50201058f, 0.782709718f, 0.869972587f,
+    0.380020231f, 3.49084616f, 5.21238041f, 2.99895048f,
+    -0.273589373f, -0.564974427f, -0.284310549f, 0.669256866f,
+    2.43272305f, 5.97186422f, 6.4163065f, 4.37920952f,
+    3.43723035f, -0.0378495604f, 0.895079792f, 0.701219559f,
+    0.798363388f, 1.22483122f, 1.35419083f, 0.989388168f,
+    -1.61428249f, 3.40524554f, 5.14494133f, 2.80932426f,
+    -0.307602108f, -0.21622923f, -0.951429784f, 0.0794544443f,
+    -0.880250514f, 0.814584494f, 5.43784332f, 6.51445341f,
+    4.12651539f, 0.981200337f, 0.206591189f, 0.455439985f,
+    0.457157463f, 0.724564672f, 0.877462268f, 0.9832744f,
+    -1.39087927f, 3.44745421f, 5.29935598f, 3.09589314f,
+    -0.790091038f, -0.604854703f, -0.905427217f, -1.10908127f,
+    -0.757317781f, 0.749657094f, 0.651084661f, 5.13587904f,
+    6.60444021f, 4.2647028f, 0.388422012f, 0.694235504f,
+    0.628504395f, 0.950535476f, 1.48129463f, 1.7078861f,
+    -2.72312307f, 3.74538469f, 5.42232418f, 3.07864618f,
+    -0.957556129f, -1.14264131f, 0.17822203f, -0.423867434f,
+    0.193202734f, 0.914594591f, -0.14354071f, 3.68940043f,
+    5.48007298f, 6.61178207f, 3.7609365f, 0.833244026f,
+    0.642970204f, 1.17966568f, 1.11914539f, 1.01647854f,
+    -1.7072798f, 3.5463295f, 5.30566835f, 3.05058956f,
+    -1.12128878f, -1.13096595f, -0.138970345f, -0.569600224f,
+    -0.0927644223f, -1.11367679f, 0.288151801f, 3.86427331f,
+    3.39196253f, 5.75870848f, 6.47336435f, 2.49389744f,
+    1.22167826f, 1.00111306f, 0.836600482f, 1.21453714f,
+    -2.07185674f, 3.28941131f, 5.1815834f, 2.92920947f,
+    -0.471930414f, 0.29538995f, 0.0458116345f, 0.0599477515f,
+    0.120328873f, -0.41178149f, 0.231334075f, 3.59095669f,
+    3.15721726f, 1.15070689f, 6.23127413f, 6.15356159f,
+    1.12436116f, 1.61990678f, 0.9248721f, 0.935117781f,
+    -1.14628816f, 3.41099405f, 5.2869401f, 3.03566289f,
+    -0.182101414f, -0.907408774f, 0.60775584f, 0.0738066807f,
+    -0.194428712f, 0.00490154605f, 0.0939616412f, 3.47394347f,
+    2.96539617f, 0.811842501f, 3.1269474f, 6.65768051f,
+    5.41471815f, 1.30025434f, 0.747299373f, 0.986118019f,
+    -1.0508287f, 3.40663862f, 5.23381948f, 3.00504899f,
+    -0.553180754f, 0.456370473f, -0.150379047f, -1.16382945f,
+    0.025684312f, -0.212498993f, 0.415592253f, 3.60110188f,
+    3.15349102f, 0.717139781f, 0.345078588f, 5.07859039f,
+    6.67032242f, 3.38482451f, 1.2373296f, 0.772254705f,
+    -2.52522945f, 3.55402589f, 5.32121754f, 3.14352202f,
+    -0.324992537f, 0.0151443873f, 0.45244509f, 0.944359899f,
+    0.520847082f, -0.296870202f, 1.14547539f, 3.59909058f,
+    3.10570669f, 0.509966016f, 0.268531352f, 0.686200559f,
+    6.16549015f, 6.14016819f, 0.81670022f, 0.968803823f,
+    -1.25655997f, 3.39430523f, 5.25339127f, 2.96929049f,
+    -1.44940495f, -1.63838899f, -0.098338671f, 0.223618224f,
+    -0.62184149f, 0.0798459277f, -0.0588902608f, 3.56614923f,
+    3.1068182f, 0.512889028f, 0.339280546f, 0.131553039f,
+    3.70688725f, 6.71563244f, 4.68702698f, 0.6705513f,
+    -1.29002023f, 3.51150799f, 5.28713179f, 2.96009183f,
+    0.196479082f, -0.579837859f, -0.580099583f, -0.152585879f,
+    -0.23477307f, -0.476288289f, 0.16612497f, 3.84160066f,
+    3.36584473f, -0.00594527833f, 0.0592463613f, 0.521484196f,
+    1.18738937f, 5.99497986f, 6.48947859f, 1.45081866f,
+};
+
+static const int8_t    s_case4_tensor[320] =
+{
+    76, 57, 66, 24, -28, -58, -84, -75, -92, -109, -55, 29,
+    18, -67, -76, -51, -43, -45, -55, -59, 43, 93, 127, 102,
+    54, -20, -74, -83, -75, -83, -75, 43, 33, -34, -31, -23,
+    -24, -26, -38, -25, -119, 38, 86, 57, 102, 110, 72, -19,
+    -85, -77, -67, 39, 25, -76, -53, -61, -24, -15, -33, -11,
+    -86, 39, 86, 21, -61, 38, 105, 114, 62, -47, -72, 44,
+    33, -45, -42, -28, -34, -33, -38, -22, -80, 40, 88, 29,
+    -61, -52, -45, 61, 117, 101, 4, 47, 35, -57, -53, -33,
+    -23, -15, -34, -32, -45, 39, 85, 26, -62, -70, -63, -37,
+    10, 106, 117, 63, 37, -56, -31, -36, -34, -22, -19, -28,
+    -98, 37, 83, 21, -63, -61, -81, -53, -79, -33, 91, 120,
+    56, -29, -49, -43, -43, -36, -31, -29, -92, 38, 87, 28,
+    -76, -71, -79, -85, -75, -35, -37, 83, 123, 60, -45, -36,
+    -38, -29, -15, -9, -128, 46, 91, 28, -81, -86, -50, -66,
+    -50, -30, -59, 44, 92, 123, 46, -33, -38, -23, -25, -28,
+    -101, 40, 88, 27, -85, -85, -59, -70, -57, -85, -47, 49,
+    36, 100, 119, 12, -22, -28, -33, -22, -111, 33, 84, 24,
+    -68, -47, -54, -53, -52, -66, -49, 42, 30, -24, 113, 110,
+    -25, -11, -30, -30, -86, 37, 87, 27, -60, -79, -39, -53,
+    -60, -55, -52, 38, 25, -33, 29, 124, 91, -20, -35, -28,
+    -83, 37, 86, 26, -70, -43, -59, -86, -54, -61, -44, 42,
+    30, -36, -46, 82, 124, 36, -22, -34, -123, 41, 88, 29,
+    -64, -55, -43, -30, -41, -63, -24, 42, 28, -41, -48, -37,
+    111, 110, -33, -29, -89, 36, 86, 25, -94, -99, -58, -49,
+    -72, -53, -57, 41, 29, -41, -46, -51, 45, 126, 71, -37,
+    -90, 39, 87, 25, -50, -71, -71, -59, -61, -68, -51, 48,
+    35, -55, -53, -41, -23, 106, 119, -16,
+};
+
+const int16_t bench_dsp_feature_ref_signal[BENCH_DSP_FEATURE_REF_LEN] =
+{
+    566, 5719, 6846, 3358, 5511, 5239, 6826, 12809, 14810,
+    13950, 10958, 10171, 9100, 12953, 14614, 15736, 11631, 7807,
+    6084, 8680, 11416, 11219, 11254, 7209, -740, 1775, 7496,
+    9020, 9267, 6547, 7621, 3084, 7544, 14825, 13461, 11719,
+    7421, 5187, 10543, 13813, 13213, 12597, 10268, 6401, 7975,
+    10304, 11416, 8824, 6291, 2258, -933, -2489, 842, -2489,
+    -4394, -12825, -13093, -15093, -15772, -13794, -15338, -18890, -23967,
+    -24159, -19229, -17174, -14943, -15350, -20805, -16838, -11277, -8459,
+    -5424, -1768, -3027, -1276, 217, 3857, 10902, 12273, 13539,
+    11578, 9693, 13863, 20935, 21833, 17668, 15223, 13715, 14080,
+    16374, 15584, 12131, 6725, 4158, -3386, 327, 876, -3596,
+    -5362, -12010, -12277, -13513, -10403, -8970, -12353, -17667, -20463,
+    -13619, -12753, -9997, -7304, -8670, -7547, -6878, -2097, 2140,
+    7431, 5372, 7288, 9219, 7375, 10259, 18232, 21036, 12351,
+    9175, 11651, 10747, 12317, 10807, 7478, 364, -2193, -3824,
+    -4660, -5032, -9983, -13631, -19177, -19483, -13062, -13278, -13107,
+    -13826, -16417, -14210, -8092, -2336, -503, 4242, 2282, 3377,
+    8131, 14680, 22060, 18057, 18069, 11939, 14985, 17666, 16293,
+    13083, 8714, 2753, -2196, -2127, -5837, -9267, -13039, -18463,
+    -21795, -21940, -18559, -18194, -12535, -14913, -15319, -8865, -1276,
+    4508, 8913, 8878, 15220, 12990, 12803, 17228, 20437, 15772,
+    13733, 7711, 7642, 6473, -386, 982, -7232, -8300, -12638,
+    -11168, -11017, -4279, -4132, -10351, -7601, -5827, 795, 3532,
+    10320, 4305, 3312, 4153, 3709, 5671, 3800, -69, -7594,
+    -10480, -10891, -9647, -7848, -9164, -9240, -11241, -7616, -2072,
+    4966, 8233, 12687, 10343, 12544, 17637, 20826, 19680, 13010,
+    10264, 3529, -3325, -1915, -6762, -11899, -15742, -20772, -20910,
+    -20535, -9739, -9504, -8980, -4172, -2974, 3344, 8225, 12431,
+    12581, 7305, 5457, 1246, 205, 1307, -596, -6146, -11140,
+    -9370, -9797, -2863, 3896, 4188, 7459, 8964, 14089, 15426,
+    18084, 17518, 6865, 8657, -3255, -6558, -6305, -11304, -19175,
+    -19691, -20351, -18885, -11942, -4139, -2309, 1768, 3051, 4750,
+    7593, 11896, 9312, 7030, -939, -4438, -6613, -5293, -6025,
+    -3922, -2406, -3778, 1412, 9918, 15996, 18291, 18149, 13914,
+    13632, 9134, 6910, 2655, -7223, -12253, -20235, -20173, -15382,
+    -10155, -8954, -4823, -5191, 3907, 6490, 8712, 7115, 2541,
+    -4197, -10719, -12236, -10290, -9807, -7157, -6168, -4670, 3081,
+    9077, 19671, 21434, 20393, 17877, 7397, 8555, 3192, 1063,
+    -8595, -12986, -13690, -9759, -4053, 909, 4761, 7479, 5135,
+    1944, 5825, 3079, -1597, -11604, -17120, -23513, -18677, -14460,
+    -5966, -350, 535, 5622, 10703, 17063, 17535, 10684, 5911,
+    -1423, -3658, -9824, -4881, 1669, -144, 2580, 9247, 15379,
+    17132, 19623, 13809, 6851, -5252, -10115, -15570, -14109, -13100,
+    -10180, -8916, -6267, 2978, 9165, 9467, 5324, -2228, -12223,
+    -13391, -13721, -13717, -8822, -9664, -3927, 3331, 15959, 16730,
+    21636, 17579, 8458, 2139, -5642, -8369, -2260, -4179, -1110,
+    833, 10036, 15678, 15950, 15675, 5941, -5043, -13049, -17082,
+    -15125, -13044, -11311, -5983, -4214, 2995, 8174, 10956, 3169,
+    -1727, -12727, -17417, -16373, -8255, -2041, 1983, 6501, 11496,
+    14829, 19039, 16537, 8238, -1799, -9544, -9158, -2245, 7980,
+    12650, 13520, 13376, 10041, 6213, 2520, -3600, -8858, -17957,
+    -16803, -10697, -3978, 7283, 9649, 5611, 761, -5934, -10752,
+    -13043, -13522, -12709, -11841, -3575, 3555, 15278, 19601, 15485,
+    7101, -1492, -8607, -7250, -1234, 5482, 9430, 16585, 14873,
+    17727, 16005, 7091, -3971, -13953, -16027, -11433, -4317, 4592,
+    8574, 8975, -1016, -3951, -9950, -16132, -12660, -18877, -15495,
+    -8793, 4432, 9210, 14177, 9234, -769, -12079, -14111, -6567,
+    -3095, 6353, 13405, 17439, 16215, 14619, 7097, 3809, -3737,
+    -11311, -4397, 4474, 9248, 16901, 17866, 4585, -7867, -15901,
+    -18038, -15747, -8507, -3563, -1773, 3892, 6692, 3219, -2971,
+    -12326, -16596, -19611, -9163, 1661, 14494, 17514, 10909, 3909,
+    -2688, -9980, -6666, -932, 4644, 14088, 17914, 17658, 13893,
+    6832, -1470, -10373, -9461, -3775, 6007, 12197, 14815, 7463,
+    -1369, -14824, -22694, -16050, -6194, -578, 4338, 3743, -1851,
+    -5942, -10391, -13354, -14399, -10233, -2986, 10173, 15785, 14932,
+    9443, -4541, -14733, -10744, 213, 6573, 18707, 19000, 10949,
+    2055, -3472, -6965, -3416, -1383, 411, 6375, 11166, 10584,
+    326, -10217, -15609, -19376, -12296, -2461, 7677, 12265, -2136,
+    -11620, -21726, -18292, -8237, 1389, 11157, 12824, 8353, 4054,
+    -2675, -6289, -4792, 436, 9912, 15080, 22537, 17407, 5110,
+    -4898, -6527, -8976, 3414, 15986, 16254, 10270, -2868, -13461,
+    -18486, -12461, -1288, 6528, 9568, 114, -10840, -18862, -20158,
+    -14029, -3851, 2024, 4945, 3944, 539, -5510, -10522, -11704,
+    -3566, 9407, 13162, 18260, 8412, 739, -9353, -11109, 2130,
+    17576, 21755, 19738, 5330, -11328, -12970, -10236, -1457, 11209,
+    11666, 3136, -5640, -16917, -16024, -13564, -3200, 286, 5855,
+    65, -4578, -14019, -14968, -8547, -5774, 5851, 13492, 9465,
+    1811, -8322, -8166, -2648, 8793, 17575, 19073, 8945, -4219,
+    -15780, -8923, 5717, 18143, 18204, 7935, -9095, -11861, -15941,
+    -1263, 9600, 11092, 3104, -7986, -19729, -18413, -11321, -103,
+    6807, 6629, -4175, -9539, -15281, -11285, -2135, 5562, 12215,
+    9309, 3229, -4593, -4532, -27, 8125, 17368, 16692, 6927,
+    -81, -9133, -3354, 5390, 14103, 13675, 7856, -5913, -12989,
+    -12127, -3547, 8324, 8020, 633, -12355, -21633, -18640, -4836,
+    8091, 6671, -981, -14357, -21153, -13597, 2621, 12966, 13092,
+    4816, -8528, -9508, -4869, 8641, 22540, 19740, 4614, -8376,
+    -7976, -1629, 13184, 15700, 12715, -3733, -11206, -8612, -2413,
+    9499, 9531, 1118, -12391, -15921, -15201, -2456, 1949, 4176,
+    -3384, -11256, -14329, -12575, -2359, 4561, 8828, -1375, -9945,
+    -9342, -5476, 6472, 16180, 11837, 2726, -5403, -1076, 9323,
+    12631, 15778, 7932, -500, -5779, -2417, 4530, 10909, 6608,
+    -2324, -10925, -10961, -6487, 1779, 5789, -2799, -12378, -15089,
+    -11797, -2683, 4037, -132, -5358, -10461, -10144, -4532, 7983,
+    8377, 3520, -3860, -7869, 3103, 10888, 17092, 12413, 4279,
+    -1454, -2416, 9091, 11483, 11074, 2901, -5164, -4259, 828,
+    9003, 7196, -558, -9823, -14507, -189, 2392, 2878, -3711,
+    -13362, -15839, -9779, 4616, 6052, 1926, -8220, -15324, -6559,
+    5907, 13569, 7343, -3183, -9240, 377, 15007, 16838, 12290,
+    122, -7192, -1090, 15133, 20903, 12963, -4663, -8669, -6551,
+    5348, 13124, 5597, -6188, -19310, -14237, -3046, 10753, 1487,
+    -14538, -21481, -17603, 1718, 12940, 2935, -9643, -21126, -11445,
+    7495, 14871, 14876, -3638, -13696, -4612, 13347, 19194, 14900,
+    -2525, -6307, -968, 12261, 20733, 8324, -4827, -7309, -3199,
+    10682, 10965, -638, -12126, -13781, -5790, 2355, 803, -10869,
+    -16025, -11984, -620, 1012, -218, -11577, -15990, -3895, 9005,
+    9982, 468, -8267, -4846, 7672, 14525, 12140, -194, -9170,
+    989, 17006, 21812, 13792, -7650, -9226, 488, 14799, 17378,
+    -248, -13434, -16436, -48, 9777, 5582, -10942, -21990, -12504,
+    -1283, 4572, -1429, -13464, -14702, -3825, 9560, 1706, -7753,
+    -12374, -945, 9823, 12821, 2959, -6877, -2588, 10783, 22230,
+    11115, -3415, -6792, 6629, 19245, 15787, -4807, -12947, -7078,
+    10465, 16517, 5068, -14114, -16394, -8785, 6536, 8032, -12127,
+    -19887, -11332, -419, 5514, -7877, -17832, -12800, -839, 7121,
+    -1240, -9481, -8229, 11660, 15240, 7270, -5474, -7354, 6957,
+    21456, 18069, 127, -8529, -647, 15805, 22480, 3125, -10684,
+    -7672, 8137, 10311, 1512, -12735, -13746, -6073, 4455, -7666,
+    -14091, -13396, -1262, 2891, -1844, -17699, -17365, -1147, 10777,
+    5345, -9996, -18233, 87, 19031, 15680, -447, -12368, 2287,
+    14100, 18126, 6538, -1761, 2744, 14918, 11471, -1073, -5166,
+    1255, 11564, 4922, -8752, -15186, -6079, 8859, 8957, -11892,
+    -23075, -13580, 4715, 6472, -6480, -20289, -7877, 3008, 5882,
+    -3670, -11357, -2587, 10511, 8705, -7392, -7062, 7464, 19194,
+    13872, -5610, -8622, 8135, 23204, 14280, -1802, -11390, 5403,
+    13362, 7505, -6861, -6525, 2789, 5881, -2043, -16056, -11873,
+    4629, 5380, -9185, -23016, -11211, 7949, 9105, -8199, -20036,
+    -6576, 9414, 10713, -4096, -8472, 1484, 13838, 8724, -4224,
+    250, 15085, 21660, 4286, -11915, -895, 16552, 17439, 2168,
+    -11775, -3261, 10135, 8914, -6383, -9363, -2685, 5427, -4344,
+    -20434, -14656, 7934, 3179, -10270, -23678, -11162, 5549, 6295,
+    -7833, -17191, 5, 11714, 8097, -7145, 711, 14721, 13393,
+    -3983, -4932, 5305, 21495, 15457, -3881, -9486, 8782, 17514,
+    7412, -4541, -6983, 9599, -90, -10402, -14224, 5528, 8855,
+    -7940, -22798, -14654, 5940, 6362, -10040, -16617, -4644, 4604,
+    -3018, -12745, -3246, 9480, 7351, -7158, -12003, 7033, 22138,
+    8383, -8880, -2419, 14220, 16110, 1292, -2833, 8149, 12366,
+    726, -9380, 2604, 12827, 8294, -13796, -15676, 1281, 11863,
+    -3543, -18232, -10199, 3531, -2895, -12828, -8475, 4348, 6932,
+    -14313, -20771, 1502, 15897, 3255, -7044, -4912, 10351, 11329,
+    -2778, -927, 15908, 17934, -1220, -9453, 4236, 18994, 10349,
+    -9459, -3270, 12189, 6068, -8239, -4471, 8171, 9330, -10739,
+    -18808, -2583, 8376, -5759, -18796, -10828, 3226, 261, -15028,
+    -6133, 8538, 5354, -12580, -12402, 13285, 14987, 1713, -6872,
+    5533, 15633, 9084, -5600, 5289, 20702, 5575, -13578, -948,
+    18295, 15370, -6836, -9127, 3757, 9724, -7581, -10510, 931,
+    8443, -10038, -19893, -3334, 8761, -4690, -17033, -7532, 5094,
+    -4471, -12128, -4511, 13484, 3090, -12260, -4223, 16568, 15099,
+    -5079, 1632, 14645, 11887, -3955, -1861, 18734, 18385, -4436,
+    -13837, 8154, 15225, -964, -8910, 5496, 9050, -11675, -14452,
+    -1394, 8161, -9926, -24854, -8309, 6494, -5666, -15390, 2066,
+    8140, -9383, -18023, -314, 16447, -101, -9048, 803, 15024,
+    -86, -6581, 10194, 22698, 2438, -7028, 5695, 18826, 9472,
+    -5467, 6874, 17014, -1278, -13807, 2818, 15625, -2818, -19716,
+    -6530, 6888, -3512, -20115, 270, 5089, -11964, -19803, -1031,
+    8436, -8336, -17443, 3400, 7123, -8388, -8497, 10689, 16443,
+    -2710, -6353, 9571, 18517, -1215, -2525, 14616, 9608, -8281,
+    -4141, 15536, 11722, -5447, -6331, 10015, 359, -9480, -4915,
+    13000, -7435, -22737, -7753, 11728, -7926, -19129, 1013, 2578,
+    -14756, -16831, 6110, 10743, -8053, -9697, 9379, 6365, -8892,
+    -327, 20781, 9170, -8590, 2603, 21763, 8638, -2296, 7855,
+    14184, -4220, -11879, 11993, 12951, -6073, -14120, 3889, 562,
+    -16125, -9333, 10502, -1855, -20697, -10038, 4191, -9926, -13818,
+    4897, 4139, -18206, -13813, 10514, 4643, -8492, 1217, 14186,
+    2517, -8513, 11510, 20133, 967, -5944, 10122, 14294, -6184,
+    3230, 20512, 6969, -12747, 1656, 12063, -2350, -12329, 3996,
+    2854, -16973, -15221, 5226, -1042, -15519, -8687, 3054, -11401,
+    -17248, 5983, 9734, -13813, -13449, 6066, 1012, -7167, 4483,
+    14146, -3465, -10943, 12591, 14751, -485, 4334, 20624, 7640,
+    -5411, 10696, 16963, -1778, -5956, 12991, 3601, -12955, -1743,
+    14140, -4594, -18716, 219, 2331, -17062, -6791, 11783, -5963,
+    -21419, -4021, 5061, -9864, -7676, 11203, -295, -18067, 599,
+    17062, -1686, -3511, 18246, 10058, -10319, 7529, 21001, 6707,
+    -5075, 12823, 10194, -11395, 5347, 16588, -1529, -13546, 3994,
+    2405, -15490, -5159, 11849, -8646, -18263, 1677, -2071, -14178,
+    -2377, 8007, -9058, -15818, 3773, 3911, -10599, 6426, 14192,
+    -7649, -9962, 13070, 12828, -3848, 3424, 17292, -1185, -4340,
+    18597, 14136, -8512, 3736, 9162, -9404, -4893, 15135, 3032,
+    -13887, 539, 1108, -17152, -5456, 8389, -8444, -20659, -1047,
+    -2887, -19206, 2362, 12324, -11835, -14290, 8917, 1994, -8201,
+    8894, 13777, -8762, -3599, 13438, 5246, -1375, 18425, 9824,
+    -9281, 4910, 15032, -4416, -503, 13344, 372, -11879, 4756,
+    7423, -12043, -2668, 4243, -13418, -15016, 7882, -2693, -15547,
+    830, -1853, -16389, -6647, 12608, -6766, -9185, 11084, -2373,
+    -14955, 10623, 13580, -6837, 3109, 15314, -1142, -2447, 22561,
+    8098, -4185, 14965, 9084, -6902, 5689, 14131, -9502, -10535,
+    6569, -8042, -11474, 10303, 1589, -20308, -5401, 414, -17993,
+    -4793, 10374, -12288, -17960, 3646, -6684, -9171, 11175, 8438,
+    -10518, 3918, 10740, -6770, 4454, 21842, 933, -2965, 17474,
+    5407, 137, 17743, 10675, -9660, 7316, 5431, -10708, 2673,
+    11600, -10578, -11450, 5465, -12142, -14892, 7046, -4278, -23265,
+    -4390, -4045, -17925, 5286, 11409, -17234, -4526, 11023, -6390,
+    -1342, 15821, -2748, -10754, 14556, 5565, -6439, 19562, 12025,
+    -6293, 11918, 12889, -7531, 9806, 18373, -10505, -2954, 12569,
+    -9509, -6567, 12671, -7956, -15778, 5863, -7323, -16466, 7132,
+    -3425, -21941, 543, -3113, -15716, 4657, 6307, -11492, -1398,
+    6686, -12022, 4807, 17215, -4529, -378, 14709, -3233, 3464,
+    23615, 1431, -1815, 15089, -1781, -8681, 18907, 3489, -7024,
+    9440, -5353, -18312, 9864, 768, -15129, 618, -650, -21778,
+    3126, 5920, -17131, -1201, 3433, -19786, -1902, 12052, -5748,
+    3059, 12573, -12753, 4037, 16735, -402, 7840, 17379, -6334,
+    648, 17129, -2299, 5249, 16716, -6126, -3306, 14755, -5916,
+    -1582, 13783, -8775, -13341, 6065, -11710, -8882, 8580, -14066,
+    -13999, 2674, -11660, -6709, 13414, -12206, -10711, 8313, -8377,
+    -8355, 18600, -3639, -2080, 15965, -89, -1506, 19495, 4443,
+    2555, 16756, -1831, 122, 18108, -434, -303, 14243, -9586,
+    -7293, 12522, -6717, -3640, 8393, -17528, -10937, 2584, -14103,
+    -6146, 6738, -21616, -7508, 4365, -17334, 1482, 8560, -11738,
+    380, 5651, -10756, 10238, 16482, -7197, 10383, 7030, -6608,
+    19982, 15180, -4460, 14808, 2914, -9092, 13931, 5987, -6693,
+    11717, -4594, -16015, 9765, -8334, -5283, 12531, -13564, -11042,
+    5554, -13893, -5758, 6680, -17267, -7667, 2745, -14431, 4629,
+    7429, -12601, 4854, 3714, -12399, 17841, 13195, -5778, 17781,
+    2384, -6862, 20247, 6103, 3437, 20840, -9010, -3648, 14289,
+    -7038, 4638, 9550, -17308, -2122, 1531, -21130, 9155, -1988,
+    -21176, 2941, -13332, -14788, 9324, -7367, -7858, 9171, -16402,
+    -3916, 12489, -10522, 8826, 9464, -14504, 12950, 11228, -4914,
+    21757, 6251, -3490, 14795, -4326, 3442, 19329, -6154, 2204,
+    8612, -15177, 7211, 10964, -13095, 7796, -8343, -17120, 5622,
+    -9536, -7941, 7858, -16415, -7158, 3633, -17593, 7170, 5063,
+    -15143, 6757, -4407, -6116, 18373, -2960, 5823, 12329, -10234,
+    9457, 17201, -3514, 20076, 4151, -7485, 13660, 189, 3436,
+    17027, -11702, -450, 1246, -13844, 9460, -1536, -15573, 5099,
+    -16438, -8827, 8516, -16042, -2246, -399, -22561, 3943, -2664,
+    -7378, 15404, -8463, -2717, 8821, -10117, 13767, 13426, -7365,
+    14191, -3020, 847, 18111, -1281, 12490, 14941, -9586, 9088,
+    4320, -922, 16241, -7303, -7212, 4792, -17314, 5708, 230,
+    -18283, 4742, -14548, -11576, 7871, -15605, 2602, 3496, -18374,
+    5264, -4277, -5432, 13708, -5701, 1649, 7399, -10460, 16938,
+    6541, -1250, 19742, -7028, 5768,
+};
+
+const bench_dsp_feature_ref_t
+                bench_dsp_feature_ref_case[BENCH_DSP_FEATURE_REF_CASES] =
+{
+    {
+        .mode      = "mfcc",
+        .case_name = "hop_160",
+        .cfg       =
+        {
+            .sample_rate = 16000U,
+            .frame_len   = 512U,
+            .hop_len     = 160U,
+            .mel_num     = 40U,
+            .mfcc_num    = 10U,
+            .column_num  = 12U,
+            .f_min       = 20.0f,
+            .f_max       = 8000.0f,
+            .scale       = 0.106329113f,
+            .zero_point  = -40,
+        },
+        .hops      = 12U,
+        .columns   = s_case0_columns,
+        .tensor    = s_case0_tensor,
+    },
+    {
+        .mode      = "mfcc",
+        .case_name = "hop_320",
+        .cfg       =
+        {
+            .sample_rate = 16000U,
+            .frame_len   = 512U,
+            .hop_len     = 320U,
+            .mel_num     = 40U,
+            .mfcc_num    = 10U,
+            .column_num  = 6U,
+            .f_min       = 20.0f,
+            .f_max       = 8000.0f,
+            .scale       = 0.0981033146f,
+            .zero_point  = -33,
+        },
+        .hops      = 6U,
+        .columns   = s_case1_columns,
+        .tensor    = s_case1_tensor,
+    },
+    {
+        .mode      = "mfcc",
+        .case_name = "hop_512",
+        .cfg       =
+        {
+            .sample_rate = 16000U,
+            .frame_len   = 512U,
+            .hop_len     = 512U,
+            .mel_num     = 40U,
+            .mfcc_num    = 10U,
+            .column_num  = 4U,
+            .f_min       = 20.0f,
+            .f_max       = 8000.0f,
+            .scale       = 0.100457586f,
+            .zero_point  = -42,
+        },
+        .hops      = 4U,
+        .columns   = s_case2_columns,
+        .tensor    = s_case2_tensor,
+    },
+    {
+        .mode      = "logmel",
+        .case_name = "hop_64",
+        .cfg       =
+        {
+            .sample_rate = 16000U,
+            .frame_len   = 256U,
+            .hop_len     = 64U,
+            .mel_num     = 20U,
+            .mfcc_num    = 0U,
+            .column_num  = 32U,
+            .f_min       = 125.0f,
+            .f_max       = 7500.0f,
+            .scale       = 0.0419716313f,
+            .zero_point  = -34,
+        },
+        .hops      = 32U,
+        .columns   = s_case3_columns,
+        .tensor    = s_case3_tensor,
+    },
+    {
+        .mode      = "logmel",
+        .case_name = "hop_128",
+        .cfg       =
+        {
+            .sample_rate = 16000U,
+            .frame_len   = 256U,
+            .hop_len     = 128U,
+            .mel_num     = 20U,
+            .mfcc_num    = 0U,
+            .column_num  = 16U,
+            .f_min       = 125.0f,
+            .f_max       = 7500.0f,
+            .scale       = 0.0372016355f,
+            .zero_point  = -55,
+        },
+        .hops      = 16U,
+        .columns   = s_case4_columns,
+        .tensor    = s_case4_tensor,
+    },
+};
+
+//******************************** Defines **********************************//
@@ -0,0 +1,765 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_bench_dsp_kernel.c
+ *
+ * @par dependencies
+ * - bsp_bench_dsp_kernel.h
+ * - bsp_dsp_chain.h
+ *
+ * @author Damian
+ *
+ * @brief Compare the variants of the CMSIS-DSP kernels, one row per variant
+ *        and size plus the throughput and the SNR against a double reference.
+ *
+ * Processing flow:
+ *
+ * Call directly.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+//******************************** Includes *********************************//
+
+#include "bsp_bench_dsp_kernel.h"
+#include "bsp_dsp_chain.h"
+#include "bsp_common.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include <string.h>
+#include <math.h>
+
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+#define BENCH_DSP_KERNEL_SUITE      "dsp_kernel"
+#define BENCH_DSP_KERNEL_LEN        ( 2U * BENCH_DSP_KERNEL_FFT_MAX )
+#define BENCH_DSP_KERNEL_SNR_MAX    9999        /* 999.9 dB in tenths        */
+#define BENCH_DSP_KERNEL_TWO_PI     6.28318530717958647692
+
+#if ( 2U * BENCH_DSP_KERNEL_MAT_MAX * BENCH_DSP_KERNEL_MAT_MAX >              \
+      BENCH_DSP_KERNEL_LEN )                                               || \
+    ( BENCH_DSP_KERNEL_TAPS + DSP_BLOCK_MAX > BENCH_DSP_KERNEL_LEN )
+#error "bench dsp kernel buffers too small for the matrices or the FIR"
+#endif
+
+typedef enum
+{
+    BENCH_DSP_KERNEL_F32     = 0,    /* float                                */
+    BENCH_DSP_KERNEL_Q31     = 1,    /* 1.31 fixed point                     */
+    BENCH_DSP_KERNEL_Q15     = 2,    /* 1.15 fixed point                     */
+} bench_dsp_kernel_fmt_t;
+
+typedef enum
+{
+    BENCH_DSP_KERNEL_FIR_F32      = 0,   /* arm_fir_f32                      */
+    BENCH_DSP_KERNEL_FIR_Q31      = 1,   /* arm_fir_q31                      */
+    BENCH_DSP_KERNEL_FIR_Q31_FAST = 2,   /* arm_fir_fast_q31                 */
+    BENCH_DSP_KERNEL_FIR_Q15      = 3,   /* arm_fir_q15                      */
+    BENCH_DSP_KERNEL_FIR_Q15_FAST = 4,   /* arm_fir_fast_q15                 */
+    BENCH_DSP_KERNEL_FIR_NUM      = 5,   /* number of FIR variants           */
+} bench_dsp_kernel_fir_t;
+
+typedef enum
+{
+    BENCH_DSP_KERNEL_CFFT_RADIX2  = 0,   /* arm_cfft_radix2_f32              */
+    BENCH_DSP_KERNEL_CFFT_RADIX4  = 1,   /* arm_cfft_radix4_f32              */
+    BENCH_DSP_KERNEL_CFFT_MIXED   = 2,   /* arm_cfft_f32                     */
+    BENCH_DSP_KERNEL_CFFT_NUM     = 3,   /* number of CFFT variants          */
+} bench_dsp_kernel_cfft_t;
+
+typedef enum
+{
+    BENCH_DSP_KERNEL_MAT_F32      = 0,   /* arm_mat_mult_f32                 */
+    BENCH_DSP_KERNEL_MAT_Q31      = 1,   /* arm_mat_mult_q31                 */
+    BENCH_DSP_KERNEL_MAT_Q31_FAST = 2,   /* arm_mat_mult_fast_q31            */
+    BENCH_DSP_KERNEL_MAT_Q15      = 3,   /* arm_mat_mult_q15                 */
+    BENCH_DSP_KERNEL_MAT_Q15_FAST = 4,   /* arm_mat_mult_fast_q15            */
+    BENCH_DSP_KERNEL_MAT_NUM      = 5,   /* number of matrix variants        */
+} bench_dsp_kernel_mat_t;
+
+typedef union
+{
+    float32_t             f32[BENCH_DSP_KERNEL_LEN];  /* float view          */
+    q31_t                 q31[BENCH_DSP_KERNEL_LEN];  /* q31 view            */
+    q15_t                 q15[BENCH_DSP_KERNEL_LEN];  /* q15 view            */
+} bench_dsp_kernel_buf_t;
+
+typedef struct
+{
+    double                signal;                 /* energy of the reference */
+    double                noise;                  /* energy of the error     */
+} bench_dsp_kernel_snr_t;
+
+static const char * const s_fir_name[BENCH_DSP_KERNEL_FIR_NUM] =
+{
+    "fir_f32", "fir_q31", "fir_q31_fast", "fir_q15", "fir_q15_fast",
+};
+
+static const bench_dsp_kernel_fmt_t s_fir_fmt[BENCH_DSP_KERNEL_FIR_NUM] =
+{
+    BENCH_DSP_KERNEL_F32, BENCH_DSP_KERNEL_Q31, BENCH_DSP_KERNEL_Q31,
+    BENCH_DSP_KERNEL_Q15, BENCH_DSP_KERNEL_Q15,
+};
+
+static const char * const s_cfft_name[BENCH_DSP_KERNEL_CFFT_NUM] =
+{
+    "cfft_radix2", "cfft_radix4", "cfft_mixed",
+};
+
+static const char * const s_mat_name[BENCH_DSP_KERNEL_MAT_NUM] =
+{
+    "mat_f32", "mat_q31", "mat_q31_fast", "mat_q15", "mat_q15_fast",
+};
+
+static const bench_dsp_kernel_fmt_t s_mat_fmt[BENCH_DSP_KERNEL_MAT_NUM] =
+{
+    BENCH_DSP_KERNEL_F32, BENCH_DSP_KERNEL_Q31, BENCH_DSP_KERNEL_Q31,
+    BENCH_DSP_KERNEL_Q15, BENCH_DSP_KERNEL_Q15,
+};
+
+static const uint32_t   s_block_len[] = { 32U, 64U, 128U, 256U };
+static const uint32_t   s_fft_len[]   = { 64U, 256U, 1024U };
+static const uint32_t   s_mat_dim[]   = { 8U, 16U, 32U };
+
+static uint32_t         s_iterations = BENCH_DSP_KERNEL_ITERATIONS;
+
+static float32_t              s_src[BENCH_DSP_KERNEL_LEN];
+static bench_dsp_kernel_buf_t s_in;
+static bench_dsp_kernel_buf_t s_out;
+static bench_dsp_kernel_buf_t s_state;
+
+static float32_t        s_coeffs_f32[BENCH_DSP_KERNEL_TAPS];
+static q31_t            s_coeffs_q31[BENCH_DSP_KERNEL_TAPS];
+static q15_t            s_coeffs_q15[BENCH_DSP_KERNEL_TAPS];
+static arm_fir_instance_f32 s_fir_f32;
+static arm_fir_instance_q31 s_fir_q31;
+static arm_fir_instance_q15 s_fir_q15;
+
+static float32_t        s_twiddle[2U * BENCH_DSP_KERNEL_FFT_MAX];
+static uint16_t         s_bit_rev[2U * BENCH_DSP_KERNEL_FFT_MAX];
+static uint16_t         s_radix_rev[BENCH_DSP_KERNEL_FFT_MAX / 4U];
+static arm_cfft_instance_f32        s_cfft;
+static arm_cfft_radix2_instance_f32 s_radix2;
+static arm_cfft_radix4_instance_f32 s_radix4;
+
+/**
+ * @brief: Fill the source with a deterministic uniform noise
+ *
+ * @param[in]  len:   number of floats
+ * @param[in]  scale: the values stay in -scale .. scale
+ **/
+static void __src_fill ( uint32_t len, float32_t scale )
+{
+    uint32_t seed = 0x2545F491U;
+
+    for ( uint32_t i = 0; i < len; ++i )
+    {
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        s_src[i] = scale * ( (float32_t)( seed >> 8 ) / 8388608.0f - 1.0f );
+    }
+}
+
+/**
+ * @brief: Round a float to q31, saturated
+ **/
+static q31_t __to_q31 ( float32_t x )
+{
+    double v = floor( (double)x * 2147483648.0 + 0.5 );
+
+    if ( v >= 2147483647.0 )
+    {
+        return INT32_MAX;
+    }
+    else if ( v <= -2147483648.0 )
+    {
+        return INT32_MIN;
+    }
+    return (q31_t)v;
+}
+
+/**
+ * @brief: Round a float to q15, saturated
+ **/
+static q15_t __to_q15 ( float32_t x )
+{
+    double v = floor( (double)x * 32768.0 + 0.5 );
+
+    if ( v >= 32767.0 )
+    {
+        return INT16_MAX;
+    }
+    else if ( v <= -32768.0 )
+    {
+        return INT16_MIN;
+    }
+    return (q15_t)v;
+}
+
+/**
+ * @brief: Copy the source into the input buffer in the given format
+ *
+ * @param[in]  fmt: format of the kernel
+ * @param[in]  len: number of values
+ **/
+static void __src_convert ( bench_dsp_kernel_fmt_t fmt, uint32_t len )
+{
+    for ( uint32_t i = 0; i < len; ++i )
+    {
+        switch ( fmt )
+        {
+        case BENCH_DSP_KERNEL_Q31:
+            s_in.q31[i] = __to_q31( s_src[i] );
+            break;
+        case BENCH_DSP_KERNEL_Q15:
+            s_in.q15[i] = __to_q15( s_src[i] );
+            break;
+        default:
+            s_in.f32[i] = s_src[i];
+            break;
+        }
+    }
+}
+
+/**
+ * @brief: Read one output value back as a double
+ *
+ * @param[in]  fmt: format of the kernel
+ * @param[in]  i:   index in the output buffer
+ *
+ * @return double: value of the output
+ **/
+static double __out_get ( bench_dsp_kernel_fmt_t fmt, uint32_t i )
+{
+    switch ( fmt )
+    {
+    case BENCH_DSP_KERNEL_Q31:
+        return (double)s_out.q31[i] / 2147483648.0;
+    case BENCH_DSP_KERNEL_Q15:
+        return (double)s_out.q15[i] / 32768.0;
+    default:
+        return (double)s_out.f32[i];
+    }
+}
+
+/**
+ * @brief: Add one output and its reference to the SNR energies
+ **/
+static void __snr_add (
+                        bench_dsp_kernel_snr_t * const snr,
+                        double                         ref,
+                        double                         out
+                                                            )
+{
+    snr->signal += ref * ref;
+    snr->noise  += ( ref - out ) * ( ref - out );
+}
+
+/**
+ * @brief: Print the rate and the SNR of a row as a comment line
+ *
+ * @param[in]  mode:      name of the variant
+ * @param[in]  case_name: name of the size
+ * @param[in]  units:     work of one kernel call
+ * @param[in]  unit:      name of the work unit
+ * @param[in]  stat:      Pointer to a instance of bench_stat_t
+ * @param[in]  snr:       energies of the reference and the error
+ **/
+static void __row_print (
+                          const char                   * const mode,
+                          const char                   * const case_name,
+                          uint32_t                             units,
+                          const char                   * const unit,
+                          const bench_stat_t           * const stat,
+                          const bench_dsp_kernel_snr_t * const snr
+                                                                    )
+{
+    uint32_t avg_ns;
+    int32_t  tenths = BENCH_DSP_KERNEL_SNR_MAX;
+
+    if ( 0U == stat->samples )
+    {
+        return;
+    }
+    avg_ns = bench_timestamp_to_ns( (uint32_t)( stat->sum / stat->samples ) );
+    if ( 0U == avg_ns )
+    {
+        return;
+    }
+    if ( snr->noise > 0.0 )
+    {
+        tenths = (int32_t)floor( 100.0 * log10( snr->signal / snr->noise ) +
+                                 0.5 );
+        if ( BENCH_DSP_KERNEL_SNR_MAX < tenths )
+        {
+            tenths = BENCH_DSP_KERNEL_SNR_MAX;
+        }
+        else if ( -BENCH_DSP_KERNEL_SNR_MAX > tenths )
+        {
+            tenths = -BENCH_DSP_KERNEL_SNR_MAX;
+        }
+    }
+    printf( "# %s,%s,%u k%s/s,snr %s%u.%u dB\r\n", mode, case_name,
+            (unsigned int)( (uint64_t)units * 1000000ULL / avg_ns ), unit,
+            ( 0 > tenths ) ? "-" : "",
+            (unsigned int)( ( 0 > tenths ? -tenths : tenths ) / 10 ),
+            (unsigned int)( ( 0 > tenths ? -tenths : tenths ) % 10 ) );
+}
+
+/**
+ * @brief: Initialise the FIR of a variant, the delay line is cleared
+ *
+ * @param[in]  mode:      FIR variant
+ * @param[in]  block_len: samples per call
+ **/
+static void __fir_init ( bench_dsp_kernel_fir_t mode, uint32_t block_len )
+{
+    switch ( mode )
+    {
+    case BENCH_DSP_KERNEL_FIR_Q31:
+    case BENCH_DSP_KERNEL_FIR_Q31_FAST:
+        arm_fir_init_q31( &s_fir_q31, BENCH_DSP_KERNEL_TAPS, s_coeffs_q31,
+                          s_state.q31, block_len );
+        break;
+    case BENCH_DSP_KERNEL_FIR_Q15:
+    case BENCH_DSP_KERNEL_FIR_Q15_FAST:
+        (void)arm_fir_init_q15( &s_fir_q15, BENCH_DSP_KERNEL_TAPS,
+                                s_coeffs_q15, s_state.q15, block_len );
+        break;
+    default:
+        arm_fir_init_f32( &s_fir_f32, BENCH_DSP_KERNEL_TAPS, s_coeffs_f32,
+                          s_state.f32, block_len );
+        break;
+    }
+}
+
+/**
+ * @brief: Filter one block of the input buffer into the output buffer
+ *
+ * @param[in]  mode:      FIR variant
+ * @param[in]  block_len: samples per call
+ **/
+static void __fir_run ( bench_dsp_kernel_fir_t mode, uint32_t block_len )
+{
+    switch ( mode )
+    {
+    case BENCH_DSP_KERNEL_FIR_Q31:
+        arm_fir_q31( &s_fir_q31, s_in.q31, s_out.q31, block_len );
+        break;
+    case BENCH_DSP_KERNEL_FIR_Q31_FAST:
+        arm_fir_fast_q31( &s_fir_q31, s_in.q31, s_out.q31, block_len );
+        break;
+    case BENCH_DSP_KERNEL_FIR_Q15:
+        arm_fir_q15( &s_fir_q15, s_in.q15, s_out.q15, block_len );
+        break;
+    case BENCH_DSP_KERNEL_FIR_Q15_FAST:
+        arm_fir_fast_q15( &s_fir_q15, s_in.q15, s_out.q15, block_len );
+        break;
+    default:
+        arm_fir_f32( &s_fir_f32, s_in.f32, s_out.f32, block_len );
+        break;
+    }
+}
+
+/**
+ * @brief: FIR cases, every variant over every block size
+ * @steps:
+ *      1. Time the variant on the same block, the delay line runs on
+ *      2. Filter one block from a cleared delay line, compare with the
+ *         double convolution of the float input
+ **/
+static void __fir_cases ( void )
+{
+    bench_stat_t           stat;
+    bench_dsp_kernel_snr_t snr;
+    char                   case_name[16];
+    uint32_t               block_num = sizeof( s_block_len ) /
+                                       sizeof( s_block_len[0] );
+    uint32_t               block_len;
+    uint32_t               t0;
+    double                 ref;
+
+    dsp_fir_lowpass_design( s_coeffs_f32, BENCH_DSP_KERNEL_TAPS, 0.2f );
+    for ( uint32_t k = 0; k < BENCH_DSP_KERNEL_TAPS; ++k )
+    {
+        s_coeffs_q31[k] = __to_q31( s_coeffs_f32[k] );
+        s_coeffs_q15[k] = __to_q15( s_coeffs_f32[k] );
+    }
+    __src_fill( DSP_BLOCK_MAX, 0.5f );
+
+    for ( uint32_t b = 0; b < block_num; ++b )
+    {
+        block_len = s_block_len[b];
+        snprintf( case_name, sizeof( case_name ), "block_%u",
+                  (unsigned int)block_len );
+        for ( uint32_t m = 0; m < BENCH_DSP_KERNEL_FIR_NUM; ++m )
+        {
+            /*************** 1. Time the variant ***************/
+            __src_convert( s_fir_fmt[m], block_len );
+            __fir_init( (bench_dsp_kernel_fir_t)m, block_len );
+            bench_stat_reset( &stat );
+            for ( uint32_t i = 0; i < s_iterations; ++i )
+            {
+                t0 = bench_timestamp_get();
+                __fir_run( (bench_dsp_kernel_fir_t)m, block_len );
+                bench_stat_add( &stat, bench_timestamp_get() - t0 );
+            }
+            bench_csv_row( BENCH_DSP_KERNEL_SUITE, s_fir_name[m], case_name,
+                           &stat );
+
+            /*************** 2. Compare with double ************/
+            __fir_init( (bench_dsp_kernel_fir_t)m, block_len );
+            __fir_run( (bench_dsp_kernel_fir_t)m, block_len );
+            memset( &snr, 0, sizeof( snr ) );
+            for ( uint32_t n = 0; n < block_len; ++n )
+            {
+                ref = 0.0;
+                // the taps are stored in time reversed order
+                for ( uint32_t k = 0; k < BENCH_DSP_KERNEL_TAPS && k <= n; ++k )
+                {
+                    ref += (double)s_coeffs_f32[BENCH_DSP_KERNEL_TAPS - 1U - k] *
+                           (double)s_src[n - k];
+                }
+                __snr_add( &snr, ref, __out_get( s_fir_fmt[m], n ) );
+            }
+            __row_print( s_fir_name[m], case_name, block_len, "samples",
+                         &stat, &snr );
+        }
+    }
+}
+
+/**
+ * @brief: Bit reversal table of the radix 2 and 4 CFFTs
+ *
+ * arm_bitreversal_f32 with a factor of 1 reads entry t after the pair of
+ * index 2t, it has to hold the reversed index of 2 * ( t + 1 ).
+ *
+ * @param[in]  len: complex length, power of two
+ **/
+static void __radix_rev_build ( uint32_t len )
+{
+    uint32_t bits = 0U;
+    uint32_t idx;
+    uint32_t rev;
+
+    while ( ( 1UL << bits ) < len )
+    {
+        bits++;
+    }
+    for ( uint32_t t = 0; t < len / 4U; ++t )
+    {
+        idx = 2U * ( t + 1U );
+        rev = 0U;
+        for ( uint32_t b = 0; b < bits; ++b )
+        {
+            rev = ( rev << 1 ) | ( ( idx >> b ) & 1U );
+        }
+        s_radix_rev[t] = (uint16_t)rev;
+    }
+}
+
+/**
+ * @brief: Transform the working copy with one CFFT variant
+ *
+ * @param[in]  mode: CFFT variant
+ **/
+static void __cfft_run ( bench_dsp_kernel_cfft_t mode )
+{
+    switch ( mode )
+    {
+    case BENCH_DSP_KERNEL_CFFT_RADIX2:
+        arm_cfft_radix2_f32( &s_radix2, s_out.f32 );
+        break;
+    case BENCH_DSP_KERNEL_CFFT_RADIX4:
+        arm_cfft_radix4_f32( &s_radix4, s_out.f32 );
+        break;
+    default:
+        arm_cfft_f32( &s_cfft, s_out.f32, 0U, 1U );
+        break;
+    }
+}
+
+/**
+ * @brief: CFFT cases, every variant over every length
+ * @steps:
+ *      1. Build the shared twiddles and both bit reversal tables
+ *      2. Time the variant, the copy of the input stays out of the window
+ *      3. Compare the last result with a double DFT of the float input
+ **/
+static void __cfft_cases ( void )
+{
+    bench_stat_t           stat;
+    bench_dsp_kernel_snr_t snr;
+    char                   case_name[16];
+    uint32_t               len_num = sizeof( s_fft_len ) / sizeof( s_fft_len[0] );
+    uint32_t               len;
+    uint32_t               t0;
+    double                 angle;
+    double                 re;
+    double                 im;
+
+    for ( uint32_t l = 0; l < len_num; ++l )
+    {
+        len = s_fft_len[l];
+        if ( BENCH_DSP_KERNEL_FFT_MAX < len )
+        {
+            continue;
+        }
+        snprintf( case_name, sizeof( case_name ), "len_%u", (unsigned int)len );
+        __src_fill( 2U * len, 0.5f );
+
+        /*************** 1. Build the tables ******************/
+        if ( DSP_OK != dsp_cfft_tables_build( &s_cfft, s_twiddle, s_bit_rev,
+                                              len, s_state.f32            ) )
+        {
+            LOG( LOG_LEVEL_ERR, "Bench cfft %u tables failed",
+                                (unsigned int)len );
+            continue;
+        }
+        __radix_rev_build( len );
+        s_radix2.fftLen           = (uint16_t)len;
+        s_radix2.ifftFlag         = 0U;
+        s_radix2.bitReverseFlag   = 1U;
+        s_radix2.pTwiddle         = s_twiddle;
+        s_radix2.pBitRevTable     = s_radix_rev;
+        s_radix2.twidCoefModifier = 1U;
+        s_radix2.bitRevFactor     = 1U;
+        s_radix2.onebyfftLen      = 1.0f / (float32_t)len;
+        s_radix4.fftLen           = s_radix2.fftLen;
+        s_radix4.ifftFlag         = s_radix2.ifftFlag;
+        s_radix4.bitReverseFlag   = s_radix2.bitReverseFlag;
+        s_radix4.pTwiddle         = s_radix2.pTwiddle;
+        s_radix4.pBitRevTable     = s_radix2.pBitRevTable;
+        s_radix4.twidCoefModifier = s_radix2.twidCoefModifier;
+        s_radix4.bitRevFactor     = s_radix2.bitRevFactor;
+        s_radix4.onebyfftLen      = s_radix2.onebyfftLen;
+
+        for ( uint32_t m = 0; m < BENCH_DSP_KERNEL_CFFT_NUM; ++m )
+        {
+            // radix 4 stages only, the length has to be a power of four
+            if ( BENCH_DSP_KERNEL_CFFT_RADIX4 == m &&
+                 0U == ( len & 0x55555555UL )        )
+            {
+                continue;
+            }
+
+            /*************** 2. Time the variant ***************/
+            bench_stat_reset( &stat );
+            for ( uint32_t i = 0; i < s_iterations; ++i )
+            {
+                memcpy( s_out.f32, s_src, 2U * len * sizeof( float32_t ) );
+                t0 = bench_timestamp_get();
+                __cfft_run( (bench_dsp_kernel_cfft_t)m );
+                bench_stat_add( &stat, bench_timestamp_get() - t0 );
+            }
+            bench_csv_row( BENCH_DSP_KERNEL_SUITE, s_cfft_name[m], case_name,
+                           &stat );
+
+            /*************** 3. Compare with double ************/
+            memset( &snr, 0, sizeof( snr ) );
+            for ( uint32_t k = 0; k < len; ++k )
+            {
+                re = 0.0;
+                im = 0.0;
+                for ( uint32_t n = 0; n < len; ++n )
+                {
+                    angle = -BENCH_DSP_KERNEL_TWO_PI * ( ( k * n ) % len ) / len;
+                    re += s_src[2U * n] * cos( angle ) -
+                          s_src[2U * n + 1U] * sin( angle );
+                    im += s_src[2U * n] * sin( angle ) +
+                          s_src[2U * n + 1U] * cos( angle );
+                }
+                __snr_add( &snr, re, s_out.f32[2U * k] );
+                __snr_add( &snr, im, s_out.f32[2U * k + 1U] );
+            }
+            __row_print( s_cfft_name[m], case_name, len, "points",
+                         &stat, &snr );
+        }
+    }
+}
+
+/**
+ * @brief: Multiply the two input matrices with one variant
+ *
+ * @param[in]  mode: matrix variant
+ * @param[in]  dim:  rows and columns of every matrix
+ **/
+static void __mat_run ( bench_dsp_kernel_mat_t mode, uint32_t dim )
+{
+    arm_matrix_instance_f32 a_f32, b_f32, c_f32;
+    arm_matrix_instance_q31 a_q31, b_q31, c_q31;
+    arm_matrix_instance_q15 a_q15, b_q15, c_q15;
+    uint32_t                n2 = dim * dim;
+
+    switch ( mode )
+    {
+    case BENCH_DSP_KERNEL_MAT_Q31:
+    case BENCH_DSP_KERNEL_MAT_Q31_FAST:
+        arm_mat_init_q31( &a_q31, dim, dim, &s_in.q31[0] );
+        arm_mat_init_q31( &b_q31, dim, dim, &s_in.q31[n2] );
+        arm_mat_init_q31( &c_q31, dim, dim, s_out.q31 );
+        if ( BENCH_DSP_KERNEL_MAT_Q31 == mode )
+        {
+            (void)arm_mat_mult_q31( &a_q31, &b_q31, &c_q31 );
+        }
+        else
+        {
+            (void)arm_mat_mult_fast_q31( &a_q31, &b_q31, &c_q31 );
+        }
+        break;
+    case BENCH_DSP_KERNEL_MAT_Q15:
+    case BENCH_DSP_KERNEL_MAT_Q15_FAST:
+        arm_mat_init_q15( &a_q15, dim, dim, &s_in.q15[0] );
+        arm_mat_init_q15( &b_q15, dim, dim, &s_in.q15[n2] );
+        arm_mat_init_q15( &c_q15, dim, dim, s_out.q15 );
+        // both take a scratch for the transpose of B
+        if ( BENCH_DSP_KERNEL_MAT_Q15 == mode )
+        {
+            (void)arm_mat_mult_q15( &a_q15, &b_q15, &c_q15, s_state.q15 );
+        }
+        else
+        {
+            (void)arm_mat_mult_fast_q15( &a_q15, &b_q15, &c_q15,
+                                         s_state.q15 );
+        }
+        break;
+    default:
+        arm_mat_init_f32( &a_f32, dim, dim, &s_in.f32[0] );
+        arm_mat_init_f32( &b_f32, dim, dim, &s_in.f32[n2] );
+        arm_mat_init_f32( &c_f32, dim, dim, s_out.f32 );
+        (void)arm_mat_mult_f32( &a_f32, &b_f32, &c_f32 );
+        break;
+    }
+}
+
+/**
+ * @brief: Matrix cases, every variant over every dimension
+ * @steps:
+ *      1. Fill A and B below 1 / sqrt( dim ), no sum of products overflows
+ *      2. Time the variant
+ *      3. Compare the result with the double product of the float input
+ **/
+static void __mat_cases ( void )
+{
+    bench_stat_t           stat;
+    bench_dsp_kernel_snr_t snr;
+    char                   case_name[16];
+    uint32_t               dim_num = sizeof( s_mat_dim ) / sizeof( s_mat_dim[0] );
+    uint32_t               dim;
+    uint32_t               n2;
+    uint32_t               t0;
+    double                 ref;
+
+    for ( uint32_t d = 0; d < dim_num; ++d )
+    {
+        dim = s_mat_dim[d];
+        if ( BENCH_DSP_KERNEL_MAT_MAX < dim )
+        {
+            continue;
+        }
+        n2 = dim * dim;
+        snprintf( case_name, sizeof( case_name ), "dim_%u", (unsigned int)dim );
+
+        /*************** 1. Fill A and B **********************/
+        __src_fill( 2U * n2, 0.9f / sqrtf( (float32_t)dim ) );
+
+        for ( uint32_t m = 0; m < BENCH_DSP_KERNEL_MAT_NUM; ++m )
+        {
+            /*************** 2. Time the variant ***************/
+            __src_convert( s_mat_fmt[m], 2U * n2 );
+            bench_stat_reset( &stat );
+            for ( uint32_t i = 0; i < s_iterations; ++i )
+            {
+                t0 = bench_timestamp_get();
+                __mat_run( (bench_dsp_kernel_mat_t)m, dim );
+                bench_stat_add( &stat, bench_timestamp_get() - t0 );
+            }
+            bench_csv_row( BENCH_DSP_KERNEL_SUITE, s_mat_name[m], case_name,
+                           &stat );
+
+            /*************** 3. Compare with double ************/
+            memset( &snr, 0, sizeof( snr ) );
+            for ( uint32_t r = 0; r < dim; ++r )
+            {
+                for ( uint32_t c = 0; c < dim; ++c )
+                {
+                    ref = 0.0;
+                    for ( uint32_t k = 0; k < dim; ++k )
+                    {
+                        ref += (double)s_src[r * dim + k] *
+                               (double)s_src[n2 + k * dim + c];
+                    }
+                    __snr_add( &snr, ref,
+                               __out_get( s_mat_fmt[m], r * dim + c ) );
+                }
+            }
+            __row_print( s_mat_name[m], case_name, n2 * dim, "MAC",
+                         &stat, &snr );
+        }
+    }
+}
+
+/**
+ * @brief: Runner task, runs all the kernels and deletes itself
+ *
+ * @param[in]  argument: Not used
+ **/
+static void bench_dsp_kernel_task ( void * argument )
+{
+    (void)argument;
+
+    bench_csv_header( BENCH_DSP_KERNEL_SUITE );
+    __fir_cases();
+    __cfft_cases();
+    __mat_cases();
+
+    vTaskDelete( NULL );
+}
+
+/**
+ * @brief: Start the DSP kernel suite
+ * @steps:
+ *      1. Start the timestamp source
+ *      2. Create the runner task, it prints the CSV report and deletes itself
+ *
+ * @param[in]  iterations: samples per case, 0 means default
+ *
+ * @return bench_status_t: execute result of this function
+ **/
+bench_status_t bench_dsp_kernel_start ( uint32_t iterations )
+{
+    bench_status_t ret = BENCH_OK;
+
+    /************** 1. Start the timestamp source *************/
+    ret = bench_timestamp_init();
+    if ( BENCH_OK != ret )
+    {
+        LOG( LOG_LEVEL_ERR, "Bench timestamp init failed" );
+        return ret;
+    }
+    s_iterations = ( 0U == iterations ) ? BENCH_DSP_KERNEL_ITERATIONS :
+                                          iterations;
+
+    /***************** 2. Create the runner ******************/
+    if ( pdPASS != xTaskCreate( bench_dsp_kernel_task,
+                                "bench_kernel",
+                                BENCH_DSP_KERNEL_STACK_WORDS,
+                                NULL,
+                                tskIDLE_PRIORITY + 1,
+                                NULL                       ) )
+    {
+        LOG( LOG_LEVEL_ERR, "Bench runner create failed" );
+        return BENCH_ERRORNOMEMORY;
+    }
+    return ret;
+}
+
+//******************************** Defines **********************************//
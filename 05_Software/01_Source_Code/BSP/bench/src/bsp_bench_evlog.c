@@ -0,0 +1,677 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_bench_evlog.c
+ *
+ * @par dependencies
+ * - bsp_bench_evlog.h
+ * - bsp_evlog.h
+ *
+ * @author Damian
+ *
+ * @brief Check the flash event journal against simulated sectors and a
+ *        simulated clock charged with the F411 flash timings: sequence
+ *        and payload round trip, power loss, endurance and budget.
+ *
+ * Processing flow:
+ *
+ * Call directly.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+//******************************** Includes *********************************//
+
+#include "bsp_bench_evlog.h"
+#include "bsp_evlog.h"
+#include "bsp_common.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include <string.h>
+
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+#define BENCH_EVLOG_SUITE         "evlog"
+#define BENCH_EVLOG_SECTORS       2U
+#define BENCH_EVLOG_CUT_SECTOR    1024U  /* small sectors: many wraps        */
+#define BENCH_EVLOG_CUT_RECORDS   300U   /* records per cut run              */
+#define BENCH_EVLOG_CUT_RATE_HZ   2U     /* slow: pages closed by age too    */
+#define BENCH_EVLOG_BURST         1000U  /* records with no service          */
+#define BENCH_EVLOG_WORD_US       16U    /* F411 typ. program, x32           */
+#define BENCH_EVLOG_ERASE_16K_US  250000U
+#define BENCH_EVLOG_ERASE_64K_US  550000U
+#define BENCH_EVLOG_CYCLES        10000U /* F411 sector endurance            */
+#define BENCH_EVLOG_NEVER         0xFFFFFFFFU
+
+typedef struct
+{
+    uint32_t              count;                  /* records read            */
+    uint32_t              first;                  /* oldest sequence         */
+    uint32_t              next;                   /* after the newest        */
+    uint32_t              ok;                     /* 1: nothing out of place */
+} bench_evlog_walk_t;
+
+static uint32_t         s_iterations = BENCH_EVLOG_ITERATIONS;
+
+// simulated flash and clock
+static uint32_t         s_flash0[BENCH_EVLOG_SECTOR0_BYTES / 4U];
+static uint32_t         s_flash1[BENCH_EVLOG_SECTOR1_BYTES / 4U];
+static evlog_sector_t   s_sectors[BENCH_EVLOG_SECTORS];
+static uint64_t         s_clock_us;
+static uint32_t         s_ops;                    /* erases + words so far   */
+static uint32_t         s_cut_at;                 /* lose power at this op   */
+static uint32_t         s_power_lost;
+static uint32_t         s_overwrites;             /* words programmed twice  */
+static uint32_t         s_erases[BENCH_EVLOG_SECTORS];
+static uint32_t         s_torn;                   /* skipped after the cuts  */
+static uint32_t         s_rand = 0x12345678U;
+
+static bsp_evlog_t      s_log;
+static uint32_t         s_seq;                    /* of the next record      */
+static uint64_t         s_record_bytes;           /* header + payload        */
+
+/**
+ * @brief: xorshift32, the same sequence on target and host
+ *
+ * @return uint32_t: next pseudo random number
+ **/
+static uint32_t __rand ( void )
+{
+    s_rand ^= s_rand << 13;
+    s_rand ^= s_rand >> 17;
+    s_rand ^= s_rand << 5;
+    return s_rand;
+}
+
+/**
+ * @brief: CRC-32 (IEEE 802.3) bit by bit, apart from the one of the log
+ *
+ * @param[in]  p:   data
+ * @param[in]  len: bytes
+ *
+ * @return uint32_t: the CRC
+ **/
+static uint32_t __crc32 ( const uint8_t * const p, uint32_t len )
+{
+    uint32_t crc = 0xFFFFFFFFU;
+
+    for ( uint32_t i = 0; i < len; ++i )
+    {
+        crc ^= p[i];
+        for ( uint32_t b = 0; b < 8U; ++b )
+        {
+            crc = ( crc >> 1 ) ^ ( ( 0U != ( crc & 1U ) ) ? 0xEDB88320U : 0U );
+        }
+    }
+    return ~crc;
+}
+
+/**
+ * @brief: Count a flash operation, cut the power when its turn has come
+ *
+ * @return uint32_t: 1 when the power goes now
+ **/
+static uint32_t __sim_cut ( void )
+{
+    s_ops++;
+    if ( s_ops == s_cut_at )
+    {
+        s_power_lost = 1U;
+        return 1U;
+    }
+    return 0U;
+}
+
+static evlog_status_t __sim_erase ( uint32_t sector )
+{
+    uint32_t words;
+
+    if ( 0U != s_power_lost || BENCH_EVLOG_SECTORS <= sector )
+    {
+        return EVLOG_ERROR;
+    }
+    s_erases[sector]++;
+    s_clock_us += ( 16384U >= s_sectors[sector].bytes ) ?
+                  BENCH_EVLOG_ERASE_16K_US : BENCH_EVLOG_ERASE_64K_US;
+    words = s_sectors[sector].bytes / 4U;
+    if ( 0U != __sim_cut() )
+    {
+        words = __rand() % words;
+    }
+    memset( s_sectors[sector].base, 0xFF, words * 4U );
+    return ( 0U != s_power_lost ) ? EVLOG_ERROR : EVLOG_OK;
+}
+
+static evlog_status_t __sim_program ( uint32_t       * const dst,
+                                      const uint32_t * const src,
+                                      uint32_t               words )
+{
+    for ( uint32_t i = 0; i < words; ++i )
+    {
+        if ( 0U != s_power_lost )
+        {
+            return EVLOG_ERROR;
+        }
+        if ( src[i] != ( dst[i] & src[i] ) )
+        {
+            s_overwrites++;
+        }
+        s_clock_us += BENCH_EVLOG_WORD_US;
+        // torn: only some of the bits to clear are cleared
+        dst[i] &= ( 0U != __sim_cut() ) ? ( src[i] | __rand() ) : src[i];
+    }
+    return ( 0U != s_power_lost ) ? EVLOG_ERROR : EVLOG_OK;
+}
+
+static bsp_status_t __sim_time_ms ( uint32_t * const time_ms )
+{
+    *time_ms = (uint32_t)( s_clock_us / 1000U );
+    return BSP_OK;
+}
+
+static bsp_status_t __sim_time_us ( uint64_t * const time_us )
+{
+    *time_us = s_clock_us;
+    return BSP_OK;
+}
+
+static bsp_status_t __sim_critical ( void )
+{
+    return BSP_OK;
+}
+
+static evlog_flash_operation_t s_sim_flash =
+{
+    .pf_flash_erase   = __sim_erase,
+    .pf_flash_program = __sim_program,
+};
+
+static time_operation_t s_sim_time =
+{
+    .pf_get_time_ms = __sim_time_ms,
+    .pf_get_time_us = __sim_time_us,
+};
+
+static os_critical_t s_sim_critical =
+{
+    .pf_os_critical_enter = __sim_critical,
+    .pf_os_critical_exit  = __sim_critical,
+};
+
+/**
+ * @brief: Blank simulated ring of two sectors of the given sizes
+ *
+ * @param[in]  bytes0: bytes of the first sector
+ * @param[in]  bytes1: bytes of the second sector
+ **/
+static void __flash_blank ( uint32_t bytes0, uint32_t bytes1 )
+{
+    memset( s_flash0, 0xFF, sizeof( s_flash0 ) );
+    memset( s_flash1, 0xFF, sizeof( s_flash1 ) );
+    s_sectors[0].base  = s_flash0;
+    s_sectors[0].bytes = bytes0;
+    s_sectors[1].base  = s_flash1;
+    s_sectors[1].bytes = bytes1;
+    s_clock_us         = 0U;
+    s_ops              = 0U;
+    s_cut_at           = BENCH_EVLOG_NEVER;
+    s_power_lost       = 0U;
+    s_overwrites       = 0U;
+    s_record_bytes     = 0U;
+    memset( s_erases, 0, sizeof( s_erases ) );
+}
+
+/**
+ * @brief: Boot: a fresh instance mounted on the simulated ring
+ *
+ * @return evlog_status_t: execute result of evlog_mount
+ **/
+static evlog_status_t __reboot ( void )
+{
+    evlog_status_t ret;
+
+    s_power_lost         = 0U;
+    s_cut_at             = BENCH_EVLOG_NEVER;
+    s_log.is_initialized = EVLOG_NOT_INITED;
+    ret = evlog_inst( &s_log, &s_sim_flash, &s_sim_time, &s_sim_critical,
+                      s_sectors, BENCH_EVLOG_SECTORS                     );
+    if ( EVLOG_OK != ret )
+    {
+        return ret;
+    }
+    ret   = evlog_mount( &s_log );
+    s_seq = s_log.seq_next;
+    return ret;
+}
+
+/**
+ * @brief: Payload length of a sequence number
+ *
+ * @param[in]  seq: sequence number
+ *
+ * @return uint32_t: 0 .. EVLOG_MAX_PAYLOAD
+ **/
+static uint32_t __len ( uint32_t seq )
+{
+    return seq % ( EVLOG_MAX_PAYLOAD + 1U );
+}
+
+/**
+ * @brief: Write the next record, its payload follows from its sequence
+ *
+ * @return evlog_status_t: execute result of evlog_write
+ **/
+static evlog_status_t __record ( void )
+{
+    uint8_t        payload[EVLOG_MAX_PAYLOAD];
+    uint32_t       len = __len( s_seq );
+    evlog_status_t ret;
+
+    for ( uint32_t i = 0; i < len; ++i )
+    {
+        payload[i] = (uint8_t)( s_seq * 7U + i );
+    }
+    ret = evlog_write( &s_log, (uint16_t)s_seq, payload, len );
+    if ( EVLOG_OK == ret )
+    {
+        s_seq++;
+        s_record_bytes += 8U + len;
+    }
+    return ret;
+}
+
+/**
+ * @brief: Records at a steady rate, the writer serviced every period
+ *
+ * @param[in]  records: records to write
+ * @param[in]  rate_hz: records per second
+ **/
+static void __run ( uint32_t records, uint32_t rate_hz )
+{
+    uint64_t serviced_us = s_clock_us;
+
+    for ( uint32_t i = 0; i < records && 0U == s_power_lost; ++i )
+    {
+        __record();
+        s_clock_us += 1000000U / rate_hz;
+        if ( s_clock_us - serviced_us >= EVLOG_SERVICE_MS * 1000U )
+        {
+            serviced_us = s_clock_us;
+            evlog_service( &s_log );
+        }
+    }
+}
+
+/**
+ * @brief: Read the ring oldest first like evlog_dump, check the sequence
+ *         and the payloads
+ *
+ * @param[out] walk: what was read
+ **/
+static void __walk ( bench_evlog_walk_t * const walk )
+{
+    const uint32_t * page;
+    const uint32_t * record;
+    const uint8_t  * payload;
+    uint32_t         s;
+    uint32_t         pages;
+    uint32_t         offset;
+    uint32_t         seq;
+    uint32_t         len;
+
+    memset( walk, 0, sizeof( *walk ) );
+    walk->ok = 1U;
+    for ( uint32_t k = 1; k <= BENCH_EVLOG_SECTORS; ++k )
+    {
+        s     = ( s_log.head_sector + k ) % BENCH_EVLOG_SECTORS;
+        pages = ( s == s_log.head_sector ) ?
+                s_log.head_page : s_sectors[s].bytes / EVLOG_PAGE_BYTES;
+        for ( uint32_t p = 0; p < pages; ++p )
+        {
+            page = &s_sectors[s].base[p * EVLOG_PAGE_WORDS];
+            if ( EVLOG_PAGE_MAGIC != page[0] ||
+                 page[EVLOG_PAGE_WORDS - 1U] !=
+                 __crc32( (const uint8_t *)page, EVLOG_PAGE_BYTES - 4U ) )
+            {
+                continue;                         /* erased or torn */
+            }
+            offset = 0U;
+            for ( uint32_t i = 0; i < ( page[2] & 0xFFFFU ); ++i )
+            {
+                record  = &page[EVLOG_PAGE_HEADER_WORDS + offset / 4U];
+                payload = (const uint8_t *)&record[2];
+                seq     = page[1] + i;
+                len     = ( record[1] >> 16 ) & 0xFFU;
+                offset += 8U + ( ( len + 3U ) & ~3U );
+                if ( 0U != walk->count && seq != walk->next )
+                {
+                    walk->ok = 0U;
+                }
+                if ( ( EVLOG_RECORD_TAG | ( __len( seq ) << 16 ) |
+                       ( seq & 0xFFFFU ) ) != record[1] )
+                {
+                    walk->ok = 0U;
+                    continue;
+                }
+                for ( uint32_t b = 0; b < len; ++b )
+                {
+                    walk->ok &= ( (uint8_t)( seq * 7U + b ) == payload[b] ) ?
+                                1U : 0U;
+                }
+                walk->first = ( 0U == walk->count ) ? seq : walk->first;
+                walk->next  = seq + 1U;
+                walk->count++;
+            }
+        }
+    }
+}
+
+/**
+ * @brief: Records across a wrap of the ring, remount, continue
+ **/
+static void __roundtrip_check ( void )
+{
+    bench_evlog_walk_t walk;
+    bench_evlog_walk_t again;
+    uint32_t           ok = 1U;
+
+    __flash_blank( BENCH_EVLOG_SECTOR0_BYTES, BENCH_EVLOG_SECTOR1_BYTES );
+    ok &= ( EVLOG_OK == __reboot() ) ? 1U : 0U;
+    while ( 3U > s_erases[0] && 0U != ok )
+    {
+        __run( 100U, BENCH_EVLOG_RATE_HZ );
+    }
+    ok &= ( EVLOG_OK == evlog_flush( &s_log ) ) ? 1U : 0U;
+    __walk( &walk );
+    ok &= walk.ok & ( ( walk.next == s_seq && 0U != walk.count ) ? 1U : 0U );
+
+    // the next boot finds the same records and goes on from them
+    ok &= ( EVLOG_OK == __reboot() && walk.next == s_log.seq_next ) ? 1U : 0U;
+    __walk( &again );
+    ok &= ( again.count == walk.count && again.first == walk.first ) ? 1U : 0U;
+    __run( 10U, BENCH_EVLOG_RATE_HZ );
+    ok &= ( EVLOG_OK == evlog_flush( &s_log ) ) ? 1U : 0U;
+    __walk( &again );
+    ok &= again.ok & ( ( again.next == s_seq ) ? 1U : 0U );
+    printf( "# roundtrip,records %u,in the ring %u,oldest %u,%s\r\n",
+            (unsigned int)s_seq, (unsigned int)walk.count,
+            (unsigned int)walk.first, ( 0U != ok ) ? "ok" : "MISMATCH" );
+}
+
+/**
+ * @brief: Oldest record not on the flash yet
+ *
+ * @return uint32_t: its sequence number
+ **/
+static uint32_t __durable_next ( void )
+{
+    if ( 0U != s_log.ram_ready )
+    {
+        return s_log.ram[( s_log.ram_fill + EVLOG_RAM_PAGES -
+                           s_log.ram_ready ) % EVLOG_RAM_PAGES][1];
+    }
+    return ( 0U != s_log.fill_count ) ? s_log.ram[s_log.ram_fill][1] :
+                                        s_log.seq_next;
+}
+
+/**
+ * @brief: Run the workload, the power goes at flash operation cut_at
+ * @steps:
+ *      1. Blank ring, mount, run the workload until the power goes
+ *      2. Reboot, every page written before the cut one is read back
+ *      3. More records, flush, reboot, the sequence goes on
+ *
+ * @param[in]  cut_at: flash operation losing the power, BENCH_EVLOG_NEVER
+ *                     for a run counting them
+ *
+ * @return uint32_t: 1 when the journal came back right
+ **/
+static uint32_t __cut_run ( uint32_t cut_at )
+{
+    bench_evlog_walk_t walk;
+    uint32_t           durable;
+    uint32_t           ok = 1U;
+
+    /***************** 1. Workload ************************/
+    __flash_blank( BENCH_EVLOG_CUT_SECTOR, BENCH_EVLOG_CUT_SECTOR );
+    s_rand = 0x12345678U;
+    if ( EVLOG_OK != __reboot() )
+    {
+        return 0U;
+    }
+    s_cut_at = cut_at;
+    __run( BENCH_EVLOG_CUT_RECORDS, BENCH_EVLOG_CUT_RATE_HZ );
+    durable = __durable_next();
+
+    /***************** 2. Reboot, check *******************/
+    ok &= ( EVLOG_OK == __reboot() ) ? 1U : 0U;
+    s_torn += s_log.torn;
+    __walk( &walk );
+    ok &= walk.ok;
+    if ( 0U != walk.count )
+    {
+        ok &= ( walk.next == s_log.seq_next &&
+                0 <= (int32_t)( walk.next - durable ) ) ? 1U : 0U;
+    }
+    else
+    {
+        ok &= ( 0U == durable ) ? 1U : 0U;
+    }
+
+    /***************** 3. Still usable ********************/
+    __run( 60U, BENCH_EVLOG_CUT_RATE_HZ );
+    ok &= ( EVLOG_OK == evlog_flush( &s_log ) ) ? 1U : 0U;
+    ok &= ( EVLOG_OK == __reboot() ) ? 1U : 0U;
+    __walk( &walk );
+    ok &= walk.ok & ( ( walk.next == s_seq ) ? 1U : 0U );
+    return ( 0U != ok && 0U == s_overwrites ) ? 1U : 0U;
+}
+
+/**
+ * @brief: Cut the power at every flash operation of the workload
+ **/
+static void __power_loss_check ( void )
+{
+    uint32_t ops;
+    uint32_t failed = 0U;
+    uint32_t first  = BENCH_EVLOG_NEVER;
+
+    // a run without cut counts the flash operations of the workload
+    __cut_run( BENCH_EVLOG_NEVER );
+    ops    = s_ops;
+    s_torn = 0U;
+    for ( uint32_t cut = 1U; cut <= ops; ++cut )
+    {
+        if ( 0U == __cut_run( cut ) )
+        {
+            failed++;
+            first = ( BENCH_EVLOG_NEVER == first ) ? cut : first;
+        }
+    }
+    if ( 0U == failed )
+    {
+        printf( "# power_loss,cuts %u,torn seen %u,ok\r\n",
+                (unsigned int)ops, (unsigned int)s_torn );
+        return;
+    }
+    printf( "# power_loss,cuts %u,failed %u,first at %u,MISMATCH\r\n",
+            (unsigned int)ops, (unsigned int)failed, (unsigned int)first );
+}
+
+/**
+ * @brief: Many records at a steady rate: erases, amplification, budget
+ **/
+static void __endurance_check ( void )
+{
+    uint64_t seconds;
+    uint64_t days;
+    uint32_t erases_max;
+    uint32_t busy_per_s;
+    uint32_t ok;
+
+    __flash_blank( BENCH_EVLOG_SECTOR0_BYTES, BENCH_EVLOG_SECTOR1_BYTES );
+    __reboot();
+    __run( BENCH_EVLOG_RECORDS, BENCH_EVLOG_RATE_HZ );
+    seconds    = s_clock_us / 1000000U;
+    busy_per_s = (uint32_t)( s_log.busy_us / seconds );
+    erases_max = ( s_erases[0] > s_erases[1] ) ? s_erases[0] : s_erases[1];
+    // days until the most erased sector reaches BENCH_EVLOG_CYCLES
+    days = (uint64_t)BENCH_EVLOG_CYCLES * seconds /
+           ( (uint64_t)erases_max * 86400U );
+    ok   = ( 0U == s_log.dropped && 0U == s_overwrites &&
+             EVLOG_BUDGET_US >= busy_per_s ) ? 1U : 0U;
+    printf( "# endurance,records %u,at %u Hz,dropped %u,erases %u+%u,"
+            "per 1M records %u,days to %u cycles %u,%s\r\n",
+            (unsigned int)BENCH_EVLOG_RECORDS,
+            (unsigned int)BENCH_EVLOG_RATE_HZ, (unsigned int)s_log.dropped,
+            (unsigned int)s_erases[0], (unsigned int)s_erases[1],
+            (unsigned int)( (uint64_t)( s_erases[0] + s_erases[1] ) *
+                            1000000U / BENCH_EVLOG_RECORDS ),
+            (unsigned int)BENCH_EVLOG_CYCLES, (unsigned int)days,
+            ( 0U != ok ) ? "ok" : "MISMATCH" );
+    printf( "# amplification,pages %u,x100 %u,padding %u%%,"
+            "busy %u us/s,max stall %u ms\r\n",
+            (unsigned int)s_log.pages,
+            (unsigned int)( (uint64_t)s_log.pages * EVLOG_PAGE_BYTES * 100U /
+                            s_record_bytes ),
+            (unsigned int)( (uint64_t)s_log.pad_bytes * 100U /
+                            ( (uint64_t)s_log.pages *
+                              EVLOG_PAGE_DATA_BYTES ) ),
+            (unsigned int)busy_per_s,
+            (unsigned int)( s_log.max_stall_us / 1000U ) );
+}
+
+/**
+ * @brief: Records with no service: the RAM pages take them, then drops
+ **/
+static void __burst_check ( void )
+{
+    bench_evlog_walk_t walk;
+    uint32_t           accepted = 0U;
+    uint32_t           ok;
+
+    __flash_blank( BENCH_EVLOG_SECTOR0_BYTES, BENCH_EVLOG_SECTOR1_BYTES );
+    __reboot();
+    for ( uint32_t i = 0; i < BENCH_EVLOG_BURST; ++i )
+    {
+        accepted += ( EVLOG_OK == __record() ) ? 1U : 0U;
+    }
+    evlog_flush( &s_log );
+    __walk( &walk );
+    ok = ( walk.ok && walk.count == accepted &&
+           EVLOG_RAM_PAGES == s_log.pages &&
+           BENCH_EVLOG_BURST - accepted == s_log.dropped ) ? 1U : 0U;
+    printf( "# burst,records %u,accepted %u,dropped %u,%s\r\n",
+            (unsigned int)BENCH_EVLOG_BURST, (unsigned int)accepted,
+            (unsigned int)s_log.dropped, ( 0U != ok ) ? "ok" : "MISMATCH" );
+}
+
+/**
+ * @brief: Time a write and a mount of a full ring
+ **/
+static void __cost_run ( void )
+{
+    bench_stat_t stat;
+    uint32_t     t0;
+
+    __flash_blank( BENCH_EVLOG_SECTOR0_BYTES, BENCH_EVLOG_SECTOR1_BYTES );
+    __reboot();
+
+    // the flush keeps a RAM page free, out of the timing
+    bench_stat_reset( &stat );
+    for ( uint32_t i = 0; i < s_iterations; ++i )
+    {
+        if ( EVLOG_RAM_PAGES - 1U <= s_log.ram_ready )
+        {
+            evlog_flush( &s_log );
+        }
+        t0 = bench_timestamp_get();
+        __record();
+        bench_stat_add( &stat, bench_timestamp_get() - t0 );
+    }
+    bench_csv_row( BENCH_EVLOG_SUITE, "write", "0_16B_payload", &stat );
+
+    // fill the whole ring, the mount reads its newest page
+    while ( 0U == s_erases[0] )
+    {
+        __run( 100U, BENCH_EVLOG_RATE_HZ );
+    }
+    evlog_flush( &s_log );
+    bench_stat_reset( &stat );
+    for ( uint32_t i = 0; i < s_iterations / 10U + 1U; ++i )
+    {
+        s_log.is_initialized = EVLOG_NOT_INITED;
+        evlog_inst( &s_log, &s_sim_flash, &s_sim_time, &s_sim_critical,
+                    s_sectors, BENCH_EVLOG_SECTORS                     );
+        t0 = bench_timestamp_get();
+        evlog_mount( &s_log );
+        bench_stat_add( &stat, bench_timestamp_get() - t0 );
+    }
+    bench_csv_row( BENCH_EVLOG_SUITE, "mount", "full_ring", &stat );
+}
+
+/**
+ * @brief: Runner task, runs every check and deletes itself
+ *
+ * @param[in]  argument: Not used
+ **/
+static void bench_evlog_task ( void * argument )
+{
+    (void)argument;
+
+    bench_csv_header( BENCH_EVLOG_SUITE );
+    __roundtrip_check();
+    __power_loss_check();
+    __endurance_check();
+    __burst_check();
+    __cost_run();
+
+    vTaskDelete( NULL );
+}
+
+/**
+ * @brief: Start the event journal suite
+ * @steps:
+ *      1. Start the timestamp source
+ *      2. Create the runner task, it prints the CSV report and deletes itself
+ *
+ * @param[in]  iterations: writes and mounts timed, 0 means default
+ *
+ * @return bench_status_t: execute result of this function
+ **/
+bench_status_t bench_evlog_start ( uint32_t iterations )
+{
+    bench_status_t ret = BENCH_OK;
+
+    /************** 1. Start the timestamp source *************/
+    ret = bench_timestamp_init();
+    if ( BENCH_OK != ret )
+    {
+        LOG( LOG_LEVEL_ERR, "Bench timestamp init failed" );
+        return ret;
+    }
+    s_iterations = ( 0U == iterations ) ? BENCH_EVLOG_ITERATIONS :
+                                          iterations;
+
+    /***************** 2. Create the runner ******************/
+    if ( pdPASS != xTaskCreate( bench_evlog_task,
+                                "bench_evlog",
+                                BENCH_EVLOG_STACK_WORDS,
+                                NULL,
+                                tskIDLE_PRIORITY + 1,
+                                NULL                    ) )
+    {
+        LOG( LOG_LEVEL_ERR, "Bench runner create failed" );
+        return BENCH_ERRORNOMEMORY;
+    }
+    return ret;
+}
+
+//******************************** Defines **********************************//
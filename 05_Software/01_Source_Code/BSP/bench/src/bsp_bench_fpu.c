@@ -0,0 +1,332 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_bench_fpu.c
+ *
+ * @par dependencies
+ * - bsp_bench_fpu.h
+ *
+ * @author Damian
+ *
+ * @brief Measure the float kernel throughput and the context switch cost
+ *        with and without FPU context.
+ *
+ * Processing flow:
+ *
+ * Call directly.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+//******************************** Includes *********************************//
+
+#include "bsp_bench_fpu.h"
+#include "bsp_common.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+#define BENCH_FPU_SUITE         "fpu"
+#define BENCH_FPU_X_LEN         ( BENCH_FPU_BLOCK + BENCH_FPU_TAPS - 1U )
+
+typedef struct
+{
+    TaskHandle_t          runner;                     /* waits for the end   */
+    TaskHandle_t          ping;                       /* measuring side      */
+    TaskHandle_t          pong;                       /* echoing side        */
+    uint32_t              use_fpu;                    /* peers touch the FPU */
+    bench_stat_t          * stat;                     /* round trip samples  */
+} bench_fpu_ctx_t;
+
+static uint32_t         s_iterations = BENCH_FPU_ITERATIONS;
+static bench_fpu_ctx_t  s_ctx;
+
+static float            s_x_f32[BENCH_FPU_X_LEN];
+static float            s_h_f32[BENCH_FPU_TAPS];
+static float            s_y_f32[BENCH_FPU_BLOCK];
+static int16_t          s_x_q15[BENCH_FPU_X_LEN];
+static int16_t          s_h_q15[BENCH_FPU_TAPS];
+static int16_t          s_y_q15[BENCH_FPU_BLOCK];
+
+/**
+ * @brief: Fill the kernel inputs with a deterministic pattern
+ **/
+static void __kernel_init ( void )
+{
+    for ( uint32_t i = 0; i < BENCH_FPU_X_LEN; ++i )
+    {
+        s_x_q15[i] = (int16_t)( ( i * 2654435761U ) >> 17 );
+        s_x_f32[i] = (float)s_x_q15[i] / 32768.0f;
+    }
+    for ( uint32_t i = 0; i < BENCH_FPU_TAPS; ++i )
+    {
+        s_h_q15[i] = (int16_t)( 32767 / BENCH_FPU_TAPS );
+        s_h_f32[i] = 1.0f / (float)BENCH_FPU_TAPS;
+    }
+}
+
+/**
+ * @brief: Float FIR over one block
+ **/
+static void __fir_f32 ( void )
+{
+    float acc;
+
+    for ( uint32_t n = 0; n < BENCH_FPU_BLOCK; ++n )
+    {
+        acc = 0.0f;
+        for ( uint32_t k = 0; k < BENCH_FPU_TAPS; ++k )
+        {
+            acc += s_h_f32[k] * s_x_f32[n + k];
+        }
+        s_y_f32[n] = acc;
+    }
+}
+
+/**
+ * @brief: q15 FIR over one block, the integer reference
+ **/
+static void __fir_q15 ( void )
+{
+    int32_t acc;
+
+    for ( uint32_t n = 0; n < BENCH_FPU_BLOCK; ++n )
+    {
+        acc = 0;
+        for ( uint32_t k = 0; k < BENCH_FPU_TAPS; ++k )
+        {
+            acc += (int32_t)s_h_q15[k] * s_x_q15[n + k];
+        }
+        s_y_q15[n] = (int16_t)( acc >> 15 );
+    }
+}
+
+/**
+ * @brief: Float biquad low pass over one block, direct form II transposed
+ **/
+static void __biquad_f32 ( void )
+{
+    static float z1 = 0.0f;
+    static float z2 = 0.0f;
+    const  float b0 = 0.0675f, b1 = 0.1349f, b2 = 0.0675f;
+    const  float a1 = -1.1430f, a2 = 0.4128f;
+    float        x;
+    float        y;
+
+    for ( uint32_t n = 0; n < BENCH_FPU_BLOCK; ++n )
+    {
+        x  = s_x_f32[n];
+        y  = b0 * x + z1;
+        z1 = b1 * x - a1 * y + z2;
+        z2 = b2 * x - a2 * y;
+        s_y_f32[n] = y;
+    }
+}
+
+/**
+ * @brief: Time one kernel
+ *
+ * @param[in]  kernel: kernel to run
+ * @param[out] stat:   Pointer to a instance of bench_stat_t
+ **/
+static void bench_kernel_run ( void ( *kernel ) ( void ),
+                               bench_stat_t * const stat  )
+{
+    uint32_t t0;
+
+    for ( uint32_t i = 0; i < s_iterations; ++i )
+    {
+        t0 = bench_timestamp_get();
+        kernel();
+        bench_stat_add( stat, bench_timestamp_get() - t0 );
+    }
+}
+
+/**
+ * @brief: Execute one float instruction, the task owns an FPU context after
+ **/
+static void __touch_fpu ( void )
+{
+    volatile float f = 1.0f;
+
+    f = f * 1.5f;
+    (void)f;
+}
+
+/**
+ * @brief: Echoing peer, higher priority than ping
+ *
+ * @param[in]  argument: Not used
+ **/
+static void bench_pong_task ( void * argument )
+{
+    (void)argument;
+
+    if ( 0U != s_ctx.use_fpu )
+    {
+        __touch_fpu();
+    }
+    for ( ;; )
+    {
+        ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+        xTaskNotifyGive( s_ctx.ping );
+    }
+}
+
+/**
+ * @brief: Measuring peer, one sample is one round trip to pong
+ *
+ * @param[in]  argument: Not used
+ **/
+static void bench_ping_task ( void * argument )
+{
+    uint32_t t0;
+
+    (void)argument;
+
+    if ( 0U != s_ctx.use_fpu )
+    {
+        __touch_fpu();
+    }
+    for ( uint32_t i = 0; i < s_iterations; ++i )
+    {
+        t0 = bench_timestamp_get();
+        xTaskNotifyGive( s_ctx.pong );
+        ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+        bench_stat_add( s_ctx.stat, bench_timestamp_get() - t0 );
+    }
+    xTaskNotifyGive( s_ctx.runner );
+    vTaskSuspend( NULL );
+}
+
+/**
+ * @brief: Measure the context switch round trip between two fresh tasks
+ * @steps:
+ *      1. Create pong, then ping which starts measuring at once
+ *      2. Wait for ping to finish and delete both
+ *
+ * @param[in]  use_fpu: 1 when both peers own an FPU context
+ * @param[out] stat:    Pointer to a instance of bench_stat_t
+ *
+ * @return bench_status_t: execute result of this function
+ **/
+static bench_status_t bench_ctx_run ( uint32_t             use_fpu,
+                                      bench_stat_t * const stat     )
+{
+    UBaseType_t prio = uxTaskPriorityGet( NULL );
+
+    /*************** 1. Create the peers *****************/
+    s_ctx.runner  = xTaskGetCurrentTaskHandle();
+    s_ctx.use_fpu = use_fpu;
+    s_ctx.stat    = stat;
+    s_ctx.ping    = NULL;
+    if ( pdPASS != xTaskCreate( bench_pong_task, "bench_pong",
+                                BENCH_FPU_STACK_WORDS, NULL,
+                                prio + 2, &s_ctx.pong         ) )
+    {
+        return BENCH_ERRORNOMEMORY;
+    }
+    if ( pdPASS != xTaskCreate( bench_ping_task, "bench_ping",
+                                BENCH_FPU_STACK_WORDS, NULL,
+                                prio + 1, &s_ctx.ping         ) )
+    {
+        vTaskDelete( s_ctx.pong );
+        return BENCH_ERRORNOMEMORY;
+    }
+
+    /************* 2. Wait and clean up *****************/
+    ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+    vTaskDelete( s_ctx.ping );
+    vTaskDelete( s_ctx.pong );
+    return BENCH_OK;
+}
+
+/**
+ * @brief: Runner task, runs all the cases and deletes itself
+ *
+ * @param[in]  argument: Not used
+ **/
+static void bench_fpu_task ( void * argument )
+{
+    bench_stat_t stat;
+
+    (void)argument;
+
+    bench_csv_header( BENCH_FPU_SUITE );
+    __kernel_init();
+
+    bench_stat_reset( &stat );
+    bench_kernel_run( __fir_f32, &stat );
+    bench_csv_row( BENCH_FPU_SUITE, "kernel", "fir_f32", &stat );
+
+    bench_stat_reset( &stat );
+    bench_kernel_run( __fir_q15, &stat );
+    bench_csv_row( BENCH_FPU_SUITE, "kernel", "fir_q15", &stat );
+
+    bench_stat_reset( &stat );
+    bench_kernel_run( __biquad_f32, &stat );
+    bench_csv_row( BENCH_FPU_SUITE, "kernel", "biquad_f32", &stat );
+
+    bench_stat_reset( &stat );
+    if ( BENCH_OK != bench_ctx_run( 0U, &stat ) )
+    {
+        LOG( LOG_LEVEL_ERR, "Bench fpu peers no memory" );
+    }
+    bench_csv_row( BENCH_FPU_SUITE, "ctx_switch", "int_only", &stat );
+
+    bench_stat_reset( &stat );
+    if ( BENCH_OK != bench_ctx_run( 1U, &stat ) )
+    {
+        LOG( LOG_LEVEL_ERR, "Bench fpu peers no memory" );
+    }
+    bench_csv_row( BENCH_FPU_SUITE, "ctx_switch", "fpu_ctx", &stat );
+
+    vTaskDelete( NULL );
+}
+
+/**
+ * @brief: Start the FPU suite
+ * @steps:
+ *      1. Start the timestamp source
+ *      2. Create the runner task, it prints the CSV report and deletes itself
+ *
+ * @param[in]  iterations: samples per case, 0 means default
+ *
+ * @return bench_status_t: execute result of this function
+ **/
+bench_status_t bench_fpu_start ( uint32_t iterations )
+{
+    bench_status_t ret = BENCH_OK;
+
+    /************** 1. Start the timestamp source *************/
+    ret = bench_timestamp_init();
+    if ( BENCH_OK != ret )
+    {
+        LOG( LOG_LEVEL_ERR, "Bench timestamp init failed" );
+        return ret;
+    }
+    s_iterations = ( 0U == iterations ) ? BENCH_FPU_ITERATIONS : iterations;
+
+    /***************** 2. Create the runner ******************/
+    if ( pdPASS != xTaskCreate( bench_fpu_task,
+                                "bench_fpu",
+                                BENCH_FPU_STACK_WORDS,
+                                NULL,
+                                tskIDLE_PRIORITY + 1,
+                                NULL                       ) )
+    {
+        LOG( LOG_LEVEL_ERR, "Bench runner create failed" );
+        return BENCH_ERRORNOMEMORY;
+    }
+    return ret;
+}
+
+//******************************** Defines **********************************//
@@ -0,0 +1,748 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_bench_fwupdate.c
+ *
+ * @par dependencies
+ * - bsp_bench_fwupdate.h
+ * - bsp_fw_update.h
+ *
+ * @author Damian
+ *
+ * @brief Simulate the A/B slots in RAM and check the firmware receiver
+ *        resumes after power cuts and a bad link, and the boot choice.
+ *
+ * Processing flow:
+ *
+ * Call directly.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+//******************************** Includes *********************************//
+
+#include "bsp_bench_fwupdate.h"
+#include "bsp_common.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include <string.h>
+
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+#define BENCH_FW_SUITE            "fwupdate"
+#define BENCH_FW_SLOT_WORDS       ( BENCH_FW_SLOT_BYTES / 4U )
+#define BENCH_FW_IMAGE_WORDS      ( BENCH_FW_IMAGE_BYTES / 4U )
+#define BENCH_FW_CUT_SPAN         4200U  /* flash ops of an update, about    */
+#define BENCH_FW_CUT_DATA         5U     /* first flash op after the header  */
+#define BENCH_FW_LOSS             24U    /* 1 frame in it lost or corrupted  */
+#define BENCH_FW_WINDOW           2U     /* DATA frames sent ahead           */
+#define BENCH_FW_RETRIES          20U    /* frame lost: send again           */
+#define BENCH_FW_MAX_ATTEMPTS     200U   /* per round                        */
+#define BENCH_FW_REPLY_BYTES      512U
+#define BENCH_FW_MAX_REPLIES      8U
+
+typedef struct
+{
+    uint32_t              type;                       /* command answered    */
+    uint32_t              status;                     /* fw_rsp_t            */
+    uint32_t              next;                       /* first word          */
+} bench_fw_reply_t;
+
+static fw_status_t __flash_erase   ( uint32_t slot );
+static fw_status_t __flash_program ( uint32_t       * const dst,
+                                     const uint32_t * const src,
+                                     uint32_t               words );
+static uint32_t    __crc_words     ( const uint32_t * const words,
+                                     uint32_t               num   );
+static fw_status_t __link_read     ( uint8_t  * const buf,
+                                     uint32_t         max,
+                                     uint32_t         timeout_ms,
+                                     uint32_t * const got        );
+static fw_status_t __link_send     ( const uint8_t * const data,
+                                     uint32_t              len   );
+static void        __reboot_req    ( void );
+static bsp_status_t __time_ms      ( uint32_t * const time_ms );
+
+static uint32_t            s_rounds = BENCH_FW_ROUNDS;
+static uint32_t            s_flash[FW_SLOT_NUM][BENCH_FW_SLOT_WORDS];
+static const fw_slot_t     s_slots[FW_SLOT_NUM] =
+{
+    { s_flash[0], BENCH_FW_SLOT_BYTES },
+    { s_flash[1], BENCH_FW_SLOT_BYTES },
+};
+static const fw_operation_t s_ops =
+{
+    .pf_flash_erase   = __flash_erase,
+    .pf_flash_program = __flash_program,
+    .pf_crc_words     = __crc_words,
+};
+static const fw_link_operation_t s_link =
+{
+    .pf_link_read  = __link_read,
+    .pf_link_send  = __link_send,
+    .pf_reboot     = __reboot_req,
+};
+static time_operation_t    s_time = { .pf_get_time_ms = __time_ms };
+static bsp_fw_update_t     s_fw   = { .is_initialized = FW_UPDATE_NOT_INITED };
+static uint32_t            s_image[BENCH_FW_IMAGE_WORDS];
+static uint32_t            s_image_crc;
+static uint8_t             s_tx[FW_FRAME_MAX_PAYLOAD + FW_FRAME_OVERHEAD];
+static uint8_t             s_data[FW_FRAME_MAX_PAYLOAD];   /* off stack  */
+static uint8_t             s_reply[BENCH_FW_REPLY_BYTES];
+static uint32_t            s_reply_len;
+static uint32_t            s_rand     = 0x2545F491U;
+static uint32_t            s_cut_in;              /* flash ops to the cut    */
+static uint32_t            s_cut;                 /* 1: power is off         */
+static uint32_t            s_cuts;
+static uint32_t            s_loss;                /* 1 frame in it, 0: none  */
+static uint32_t            s_lost;
+static uint32_t            s_wire;                /* bytes host to device    */
+static uint32_t            s_data_bytes;          /* block bytes sent        */
+static uint32_t            s_reboots;
+static uint32_t            s_resumed;             /* BEGIN resumed, all runs */
+static bench_stat_t      * s_block_stat;          /* NULL: not timed         */
+
+/**
+ * @brief: xorshift32, the same sequence on target and host
+ *
+ * @return uint32_t: next pseudo random number
+ **/
+static uint32_t __rand ( void )
+{
+    s_rand ^= s_rand << 13;
+    s_rand ^= s_rand >> 17;
+    s_rand ^= s_rand << 5;
+    return s_rand;
+}
+
+/**
+ * @brief: Count a flash operation, 1 when the power goes now
+ *
+ * @return uint32_t: 1 on the cut
+ **/
+static uint32_t __cut_now ( void )
+{
+    if ( 0U != s_cut_in && 0U == --s_cut_in )
+    {
+        s_cut = 1U;
+        ++s_cuts;
+        return 1U;
+    }
+    return 0U;
+}
+
+/**
+ * @brief: Erase a simulated slot, a cut leaves a part of the words erased
+ *
+ * @param[in]  slot: 0 .. FW_SLOT_NUM - 1
+ *
+ * @return fw_status_t: FW_ERROR once the power is off
+ **/
+static fw_status_t __flash_erase ( uint32_t slot )
+{
+    if ( 0U != s_cut || slot >= FW_SLOT_NUM )
+    {
+        return FW_ERROR;
+    }
+    if ( 0U != __cut_now() )
+    {
+        for ( uint32_t i = 0; i < BENCH_FW_SLOT_WORDS; ++i )
+        {
+            s_flash[slot][i] |= ( 0U != ( __rand() & 1U ) ) ? FW_ERASED : 0U;
+        }
+        return FW_ERROR;
+    }
+    memset( s_flash[slot], 0xFF, BENCH_FW_SLOT_BYTES );
+    return FW_OK;
+}
+
+/**
+ * @brief: Program simulated flash, bits only cleared, a cut leaves the word
+ *         with a part of its bits
+ *
+ * @param[in]  dst:   in a slot
+ * @param[in]  src:   the words
+ * @param[in]  words: number of words
+ *
+ * @return fw_status_t: FW_ERROR once the power is off
+ **/
+static fw_status_t __flash_program ( uint32_t       * const dst,
+                                     const uint32_t * const src,
+                                     uint32_t               words )
+{
+    for ( uint32_t i = 0; i < words; ++i )
+    {
+        if ( 0U != s_cut )
+        {
+            return FW_ERROR;
+        }
+        if ( 0U != __cut_now() )
+        {
+            dst[i] &= src[i] | __rand();
+            return FW_ERROR;
+        }
+        dst[i] &= src[i];
+    }
+    return FW_OK;
+}
+
+/**
+ * @brief: CRC of the image words, the tables here
+ **/
+static uint32_t __crc_words ( const uint32_t * const words, uint32_t num )
+{
+    return crc32_mpeg2_sw_words( CRC32_MPEG2_INIT, words, num );
+}
+
+/**
+ * @brief: The runner feeds the receiver itself, nothing to read
+ **/
+static fw_status_t __link_read ( uint8_t  * const buf,
+                                 uint32_t         max,
+                                 uint32_t         timeout_ms,
+                                 uint32_t * const got        )
+{
+    (void)buf;
+    (void)max;
+    (void)timeout_ms;
+    *got = 0U;
+    return FW_OK;
+}
+
+/**
+ * @brief: Replies of the receiver, kept for the host part
+ **/
+static fw_status_t __link_send ( const uint8_t * const data, uint32_t len )
+{
+    if ( s_reply_len + len <= BENCH_FW_REPLY_BYTES )
+    {
+        memcpy( &s_reply[s_reply_len], data, len );
+        s_reply_len += len;
+    }
+    return FW_OK;
+}
+
+/**
+ * @brief: REBOOT of the host, counted only
+ **/
+static void __reboot_req ( void )
+{
+    ++s_reboots;
+}
+
+/**
+ * @brief: Uptime, past FW_CONFIRM_MS: the bench confirms by itself
+ **/
+static bsp_status_t __time_ms ( uint32_t * const time_ms )
+{
+    *time_ms = 0U;
+    return BSP_OK;
+}
+
+/**
+ * @brief: Image of a version, its words depend on the version only
+ *
+ * @param[in]  version: the version
+ **/
+static void __image ( uint32_t version )
+{
+    uint32_t x = 0x9E3779B9U * version + 1U;
+
+    for ( uint32_t i = 0; i < BENCH_FW_IMAGE_WORDS; ++i )
+    {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        s_image[i] = x;
+    }
+    s_image_crc = __crc_words( s_image, BENCH_FW_IMAGE_WORDS );
+}
+
+/**
+ * @brief: Image of a version straight into a slot, as fw_send.py --pack
+ *         for the first download with the probe
+ *
+ * @param[in]  slot:      0 .. FW_SLOT_NUM - 1
+ * @param[in]  version:   the version
+ **/
+static void __install ( uint32_t slot, uint32_t version )
+{
+    fw_header_t * hdr = (fw_header_t *)s_flash[slot];
+
+    __image( version );
+    memset( s_flash[slot], 0xFF, BENCH_FW_SLOT_BYTES );
+    memcpy( &s_flash[slot][FW_HEADER_BYTES / 4U], s_image,
+            BENCH_FW_IMAGE_BYTES );
+    hdr->version   = version;
+    hdr->size      = BENCH_FW_IMAGE_BYTES;
+    hdr->crc       = s_image_crc;
+    memset( hdr->progress, 0, sizeof( hdr->progress ) );
+    hdr->confirmed = FW_MARK;
+    hdr->magic     = FW_MAGIC;
+}
+
+/**
+ * @brief: Power back on: the receiver starts from the flash alone
+ *
+ * @param[in]  running: slot of the running image
+ **/
+static void __power_on ( uint32_t running )
+{
+    s_cut       = 0U;
+    s_reply_len = 0U;
+    s_resumed  += s_fw.resumed;
+    fw_update_inst( &s_fw, &s_ops, &s_link, &s_time, s_slots, running );
+}
+
+/**
+ * @brief: Bytes into the receiver the way its task does: chunk by chunk,
+ *         a flash step now and then, all of them once the host waits
+ *
+ * @param[in]  p: bytes
+ * @param[in]  n: number of bytes
+ **/
+static void __feed ( const uint8_t * p, uint32_t n )
+{
+    uint32_t used;
+    uint32_t busy = 1U;
+    uint32_t t0   = bench_timestamp_get();
+
+    while ( 0U != n && 0U == s_cut )
+    {
+        used = 0U;
+        fw_update_rx( &s_fw, p, ( n < FW_RX_CHUNK ) ? n : FW_RX_CHUNK,
+                      &used );
+        p += used;
+        n -= used;
+        // the flash is slow now and then, the second buffer fills
+        if ( 0U == used || 0U == ( __rand() & 3U ) )
+        {
+            fw_update_service( &s_fw, &busy );
+        }
+    }
+    while ( 0U != busy && 0U == s_cut )
+    {
+        fw_update_service( &s_fw, &busy );
+    }
+    if ( NULL != s_block_stat )
+    {
+        bench_stat_add( s_block_stat, bench_timestamp_get() - t0 );
+    }
+}
+
+/**
+ * @brief: Host part: a frame to the receiver, lost or corrupted now and
+ *         then
+ *
+ * @param[in]  type:    command
+ * @param[in]  payload: may be NULL when len is 0
+ * @param[in]  len:     bytes of the payload
+ **/
+static void __send ( uint32_t type, const void * const payload, uint32_t len )
+{
+    uint32_t crc;
+    uint32_t fault;
+
+    s_tx[0] = FW_SOF0;
+    s_tx[1] = FW_SOF1;
+    s_tx[2] = (uint8_t)type;
+    s_tx[3] = (uint8_t)len;
+    s_tx[4] = (uint8_t)( len >> 8 );
+    if ( 0U != len )
+    {
+        memcpy( &s_tx[5], payload, len );
+    }
+    crc = crc32_mpeg2_sw( CRC32_MPEG2_INIT, &s_tx[2], 3U + len );
+    memcpy( &s_tx[5U + len], &crc, 4U );
+    s_wire += len + FW_FRAME_OVERHEAD;
+
+    // log text of the other tasks between the frames
+    __feed( (const uint8_t *)"# log\r\n", 7U );
+    fault = ( 0U != s_loss ) ? __rand() % s_loss : 1U;
+    if ( 0U == fault )
+    {
+        ++s_lost;
+        if ( 0U != ( __rand() & 1U ) )
+        {
+            return;
+        }
+        s_tx[__rand() % ( len + FW_FRAME_OVERHEAD )] ^= 0x10U;
+    }
+    __feed( s_tx, len + FW_FRAME_OVERHEAD );
+}
+
+/**
+ * @brief: Host part: the replies received, the log text skipped
+ *
+ * @param[out] reply: up to BENCH_FW_MAX_REPLIES
+ *
+ * @return uint32_t: number of replies
+ **/
+static uint32_t __replies ( bench_fw_reply_t * const reply )
+{
+    uint32_t num = 0U;
+    uint32_t len;
+    uint32_t crc;
+
+    for ( uint32_t i = 0; i + FW_FRAME_OVERHEAD <= s_reply_len; )
+    {
+        len = (uint32_t)s_reply[i + 3U] | ( (uint32_t)s_reply[i + 4U] << 8 );
+        if ( FW_SOF0 != s_reply[i] || FW_SOF1 != s_reply[i + 1U] ||
+             i + len + FW_FRAME_OVERHEAD > s_reply_len )
+        {
+            ++i;
+            continue;
+        }
+        memcpy( &crc, &s_reply[i + 5U + len], 4U );
+        if ( crc == crc32_mpeg2_sw( CRC32_MPEG2_INIT, &s_reply[i + 2U],
+                                    3U + len ) &&
+             len >= 8U && num < BENCH_FW_MAX_REPLIES )
+        {
+            reply[num].type   = s_reply[i + 2U] & ~FW_RSP_FLAG;
+            reply[num].status = s_reply[i + 5U];
+            memcpy( &reply[num].next, &s_reply[i + 9U], 4U );
+            ++num;
+        }
+        i += len + FW_FRAME_OVERHEAD;
+    }
+    s_reply_len = 0U;
+    return num;
+}
+
+/**
+ * @brief: Host part: a command without data until its reply comes
+ *
+ * @param[in]  type:    command
+ * @param[in]  payload: may be NULL when len is 0
+ * @param[in]  len:     bytes of the payload
+ * @param[out] reply:   the reply
+ *
+ * @return uint32_t: 1 with a reply, 0 after a cut or too many losses
+ **/
+static uint32_t __command ( uint32_t                 type,
+                            const void       * const payload,
+                            uint32_t                 len,
+                            bench_fw_reply_t * const reply    )
+{
+    bench_fw_reply_t got[BENCH_FW_MAX_REPLIES];
+    uint32_t         num;
+
+    for ( uint32_t retry = 0; retry < BENCH_FW_RETRIES; ++retry )
+    {
+        __send( type, payload, len );
+        if ( 0U != s_cut )
+        {
+            return 0U;
+        }
+        num = __replies( got );
+        for ( uint32_t i = 0; i < num; ++i )
+        {
+            if ( type == got[i].type )
+            {
+                *reply = got[i];
+                return 1U;
+            }
+        }
+    }
+    return 0U;
+}
+
+/**
+ * @brief: Host part: one attempt of an update, what fw_send.py does
+ * @steps:
+ *      1. BEGIN, the receiver tells where to resume
+ *      2. DATA, BENCH_FW_WINDOW blocks ahead of the last acknowledge, go
+ *         back to it when a reply is missing
+ *      3. END, the receiver checks the CRC
+ *
+ * @param[in]  version: of the image in s_image
+ *
+ * @return uint32_t: 1 when the image is complete, 0 after a cut or a
+ *                   session lost
+ **/
+static uint32_t __update ( uint32_t version )
+{
+    bench_fw_reply_t reply[BENCH_FW_MAX_REPLIES];
+    uint32_t         begin[3] = { version, BENCH_FW_IMAGE_BYTES,
+                                  s_image_crc };
+    uint32_t         acked;
+    uint32_t         off;
+    uint32_t         bytes;
+    uint32_t         num;
+
+    /*********************** 1. BEGIN *************************/
+    if ( 0U == __command( FW_CMD_BEGIN, begin, sizeof( begin ), reply ) ||
+         FW_RSP_OK != reply[0].status )
+    {
+        return 0U;
+    }
+    acked = reply[0].next;
+
+    /*********************** 2. DATA **************************/
+    while ( acked < BENCH_FW_IMAGE_BYTES )
+    {
+        for ( uint32_t w = 0; w < BENCH_FW_WINDOW; ++w )
+        {
+            off = acked + w * FW_BLOCK_BYTES;
+            if ( off >= BENCH_FW_IMAGE_BYTES )
+            {
+                break;
+            }
+            bytes = BENCH_FW_IMAGE_BYTES - off;
+            bytes = ( bytes < FW_BLOCK_BYTES ) ? bytes : FW_BLOCK_BYTES;
+            memcpy( s_data, &off, 4U );
+            memcpy( &s_data[4], (const uint8_t *)s_image + off, bytes );
+            s_data_bytes += bytes;
+            __send( FW_CMD_DATA, s_data, 4U + bytes );
+            if ( 0U != s_cut )
+            {
+                return 0U;
+            }
+        }
+        num = __replies( reply );
+        for ( uint32_t i = 0; i < num; ++i )
+        {
+            if ( FW_CMD_DATA != reply[i].type )
+            {
+                continue;
+            }
+            if ( FW_RSP_STATE == reply[i].status )
+            {
+                return 0U;
+            }
+            if ( FW_RSP_OK == reply[i].status && reply[i].next > acked )
+            {
+                acked = reply[i].next;
+            }
+        }
+    }
+
+    /*********************** 3. END ***************************/
+    return ( 0U != __command( FW_CMD_END, NULL, 0U, reply ) &&
+             FW_RSP_OK == reply[0].status ) ? 1U : 0U;
+}
+
+/**
+ * @brief: One update until complete, a new cut armed at every attempt.
+ *         Until the first cut of the round every attempt is cut in the
+ *         first half of the image, after the header: each round with
+ *         faults resumes at least once.
+ *
+ * @param[in]  running: slot running, the image goes into the other one
+ * @param[in]  version: of the image
+ * @param[in]  faults:  1 with cuts and losses
+ *
+ * @return uint32_t: 1 when complete and equal to the image
+ **/
+static uint32_t __round ( uint32_t running, uint32_t version, uint32_t faults )
+{
+    uint32_t target   = ( 0U == running ) ? 1U : 0U;
+    uint32_t attempts = 0U;
+    uint32_t cuts     = s_cuts;
+
+    __image( version );
+    s_loss = ( 0U != faults ) ? BENCH_FW_LOSS : 0U;
+    do
+    {
+        if ( 0U == faults )
+        {
+            s_cut_in = 0U;
+        }
+        else if ( cuts == s_cuts )
+        {
+            s_cut_in = BENCH_FW_CUT_DATA +
+                       __rand() % ( BENCH_FW_IMAGE_WORDS / 2U );
+        }
+        else
+        {
+            s_cut_in = ( 0U != ( __rand() & 1U ) ) ?
+                       1U + __rand() % BENCH_FW_CUT_SPAN : 0U;
+        }
+        __power_on( running );
+        if ( ++attempts > BENCH_FW_MAX_ATTEMPTS )
+        {
+            return 0U;
+        }
+    } while ( 0U == __update( version ) );
+    s_cut_in = 0U;
+    s_loss   = 0U;
+
+    return ( 0 == memcmp( &s_flash[target][FW_HEADER_BYTES / 4U], s_image,
+                          BENCH_FW_IMAGE_BYTES ) &&
+             FW_IMAGE_TRIAL == fw_image_check( &s_slots[target], &s_ops ) ) ?
+           1U : 0U;
+}
+
+/**
+ * @brief: Clean update, its cost per block and on the wire
+ **/
+static void __clean ( void )
+{
+    bench_stat_t stat;
+    uint32_t     ok;
+
+    __install( 0U, 1U );
+    memset( s_flash[1], 0xFF, BENCH_FW_SLOT_BYTES );
+    bench_stat_reset( &stat );
+    s_wire        = 0U;
+    s_data_bytes  = 0U;
+    s_block_stat  = &stat;
+    ok            = __round( 0U, 2U, 0U );
+    s_block_stat  = NULL;
+    bench_csv_row( BENCH_FW_SUITE, "clean", "frame", &stat );
+    printf( "# link,%u image bytes,%u wire bytes,%u ms at %u baud,%s\r\n",
+            (unsigned int)BENCH_FW_IMAGE_BYTES, (unsigned int)s_wire,
+            (unsigned int)( (uint64_t)s_wire * 10000U / BENCH_FW_BAUD ),
+            (unsigned int)BENCH_FW_BAUD,
+            ( 0U != ok && BENCH_FW_IMAGE_BYTES == s_data_bytes ) ?
+            "ok" : "MISMATCH" );
+}
+
+/**
+ * @brief: Updates with power cuts and a bad link, each one resumes
+ **/
+static void __resume ( void )
+{
+    uint32_t ok = 1U;
+    uint32_t once;
+
+    s_cuts       = 0U;
+    s_lost       = 0U;
+    s_resumed    = 0U;
+    s_data_bytes = 0U;
+    // versions above the v2 of the clean line: no round starts complete
+    for ( uint32_t r = 0; r < s_rounds; ++r )
+    {
+        __install( r & 1U, 2U * r + 3U );
+        ok &= __round( r & 1U, 2U * r + 4U, 1U );
+    }
+    s_resumed += s_fw.resumed;
+    once       = s_rounds * BENCH_FW_IMAGE_BYTES;
+    printf( "# resume,%u rounds,%u cuts,%u resumed,%u frames lost,"
+            "%u bytes sent again,%s\r\n",
+            (unsigned int)s_rounds, (unsigned int)s_cuts,
+            (unsigned int)s_resumed, (unsigned int)s_lost,
+            (unsigned int)( ( s_data_bytes > once ) ?
+                            s_data_bytes - once : 0U ),
+            ( 0U != ok && s_cuts >= s_rounds && s_resumed >= s_rounds ) ?
+            "ok" : "MISMATCH" );
+}
+
+/**
+ * @brief: Boot choice: trials, rejection and fall back, confirmation,
+ *         BEGIN refused on an image not confirmed, a corrupted image
+ **/
+static void __boot ( void )
+{
+    bench_fw_reply_t reply;
+    bench_stat_t     stat;
+    uint32_t         begin[3] = { 9U, BENCH_FW_IMAGE_BYTES, 0U };
+    uint32_t         slot = FW_SLOT_NONE;
+    uint32_t         ok   = 1U;
+    uint32_t         t0;
+
+    // A v1 confirmed, B v2 new: B on FW_MAX_TRIALS trials, then A again
+    __install( 0U, 1U );
+    memset( s_flash[1], 0xFF, BENCH_FW_SLOT_BYTES );
+    ok &= __round( 0U, 2U, 0U );
+    for ( uint32_t i = 0; i < FW_MAX_TRIALS; ++i )
+    {
+        ok &= ( FW_OK == fw_select( s_slots, &s_ops, &slot ) &&
+                1U == slot ) ? 1U : 0U;
+    }
+    ok &= ( FW_OK == fw_select( s_slots, &s_ops, &slot ) && 0U == slot &&
+            FW_IMAGE_REJECTED == fw_image_check( &s_slots[1], &s_ops ) ) ?
+          1U : 0U;
+
+    // B v3 new, starts on a trial, confirms: no more trial spent
+    ok &= __round( 0U, 3U, 0U );
+    ok &= ( FW_OK == fw_select( s_slots, &s_ops, &slot ) && 1U == slot ) ?
+          1U : 0U;
+    __power_on( 1U );
+    ok &= ( 0U != __command( FW_CMD_BEGIN, begin, sizeof( begin ),
+                             &reply ) &&
+            FW_RSP_STATE == reply.status ) ? 1U : 0U;
+    ok &= ( FW_OK == fw_update_confirm( &s_fw ) &&
+            FW_MAX_TRIALS - 1U == fw_trials_left( &s_slots[1] ) ) ? 1U : 0U;
+    bench_stat_reset( &stat );
+    for ( uint32_t i = 0; i < 4U; ++i )
+    {
+        t0 = bench_timestamp_get();
+        ok &= ( FW_OK == fw_select( s_slots, &s_ops, &slot ) &&
+                1U == slot ) ? 1U : 0U;
+        bench_stat_add( &stat, bench_timestamp_get() - t0 );
+    }
+    ok &= ( FW_MAX_TRIALS - 1U == fw_trials_left( &s_slots[1] ) ) ? 1U : 0U;
+    bench_csv_row( BENCH_FW_SUITE, "boot", "select", &stat );
+
+    // a bit flipped in B: bad, A starts
+    s_flash[1][FW_HEADER_BYTES / 4U + 100U] ^= 0x00010000U;
+    ok &= ( FW_IMAGE_BAD == fw_image_check( &s_slots[1], &s_ops ) &&
+            FW_OK == fw_select( s_slots, &s_ops, &slot ) && 0U == slot ) ?
+          1U : 0U;
+    printf( "# boot,trials %u,fall back,confirm,refuse,corrupt,%s\r\n",
+            (unsigned int)FW_MAX_TRIALS, ( 0U != ok ) ? "ok" : "MISMATCH" );
+}
+
+/**
+ * @brief: Runner task, runs every check and deletes itself
+ *
+ * @param[in]  argument: Not used
+ **/
+static void bench_fwupdate_task ( void * argument )
+{
+    (void)argument;
+
+    bench_csv_header( BENCH_FW_SUITE );
+    __clean();
+    __resume();
+    __boot();
+
+    vTaskDelete( NULL );
+}
+
+/**
+ * @brief: Start the firmware update suite
+ * @steps:
+ *      1. Start the timestamp source
+ *      2. Create the runner task, it prints the CSV report and deletes itself
+ *
+ * @param[in]  rounds: updates with faults, 0 means default
+ *
+ * @return bench_status_t: execute result of this function
+ **/
+bench_status_t bench_fwupdate_start ( uint32_t rounds )
+{
+    bench_status_t ret = BENCH_OK;
+
+    /************** 1. Start the timestamp source *************/
+    ret = bench_timestamp_init();
+    if ( BENCH_OK != ret )
+    {
+        LOG( LOG_LEVEL_ERR, "Bench timestamp init failed" );
+        return ret;
+    }
+    s_rounds = ( 0U == rounds ) ? BENCH_FW_ROUNDS : rounds;
+
+    /***************** 2. Create the runner ******************/
+    if ( pdPASS != xTaskCreate( bench_fwupdate_task,
+                                "bench_fwupdate",
+                                BENCH_FW_STACK_WORDS,
+                                NULL,
+                                tskIDLE_PRIORITY + 1,
+                                NULL                  ) )
+    {
+        LOG( LOG_LEVEL_ERR, "Bench runner create failed" );
+        return BENCH_ERRORNOMEMORY;
+    }
+    return ret;
+}
+
+//******************************** Defines **********************************//
@@ -0,0 +1,1110 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_bench_i2c.c
+ *
+ * @par dependencies
+ * - bsp_bench_i2c.h
+ * - bsp_i2c.h
+ *
+ * @author Damian
+ *
+ * @brief Check the I2C bus manager against a mock bus of register devices:
+ *        order of the chains, NACK, bus errors, a stuck bus and its
+ *        recovery, the watch, batches and samplers, and measure its CPU
+ *        cost and the bus time of a merged batch.
+ *
+ * Processing flow:
+ *
+ * Call directly.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+//******************************** Includes *********************************//
+
+#include "bsp_bench_i2c.h"
+#include "bsp_common.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include <string.h>
+
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+#define BENCH_I2C_SUITE           "i2c"
+#define BENCH_I2C_DEVICES         3U
+#define BENCH_I2C_REGS            256U       /* of a mock device            */
+#define BENCH_I2C_ABSENT          0x50U      /* no device answers           */
+#define BENCH_I2C_WINDOW          32U        /* registers of a submitter    */
+#define BENCH_I2C_SENSOR          0x80U      /* first register, sensors     */
+#define BENCH_I2C_SENSOR_REGS     16U        /* changing every ms           */
+#define BENCH_I2C_TIMEOUT         20U        /* watch of the check, ms      */
+#define BENCH_I2C_BUS_HZ          400000U    /* fast mode                   */
+#define BENCH_I2C_IMU_REGS        12U        /* accelerometer and gyroscope */
+#define BENCH_I2C_NONE            0xFFFFFFFFU
+#define BENCH_I2C_ALL_BITS        ( ( 1UL << ( BENCH_I2C_USERS + 1U ) ) - 1U )
+
+typedef enum
+{
+    BENCH_I2C_SUBMIT_IDLE   = 0,
+    BENCH_I2C_DONE_NEXT     = 1,
+    BENCH_I2C_DONE_LAST     = 2,
+    BENCH_I2C_END_TO_START  = 3,
+    BENCH_I2C_POLL          = 4,
+    BENCH_I2C_COSTS         = 5,
+} bench_i2c_cost_t;
+
+typedef struct
+{
+    i2c_xfer_t            xfer[BENCH_I2C_CHAIN];
+    uint8_t               data[BENCH_I2C_CHAIN][BENCH_I2C_BYTES];
+    uint8_t               shadow[BENCH_I2C_DEVICES][BENCH_I2C_WINDOW];
+    uint32_t              num;                        /* chain, 0: idle      */
+    uint32_t              seq;                        /* submit order        */
+    uint32_t              started;                    /* by the mock         */
+    uint32_t              fail_from;                  /* num: none fails     */
+} bench_i2c_user_t;
+
+typedef struct
+{
+    //**************************** Running **********************************//
+    uint32_t              busy;                       /* a transaction runs  */
+    uint32_t              any;                        /* not of a submitter  */
+    uint32_t              user;                       /* of the last start   */
+    uint32_t              index;
+    uint8_t               addr;
+    uint16_t              reg;
+    uint32_t              reg_len;
+    i2c_dir_t             dir;
+    uint8_t               * data;
+    uint32_t              len;
+    uint32_t              t_start;                    /* timestamp of it     */
+
+    //**************************** Bus **************************************//
+    uint32_t              dirty;                      /* free after recover  */
+    uint32_t              stuck;                      /* refuses the starts  */
+    uint32_t              hang;                       /* SCL held, no end    */
+    uint8_t               regs[BENCH_I2C_DEVICES][BENCH_I2C_REGS];
+
+    //**************************** Counters *********************************//
+    uint32_t              chains;                     /* first ones started  */
+    uint32_t              refused;
+    uint32_t              aborts;
+    uint32_t              recovers;
+    uint32_t              bus_errors;
+    uint32_t              nacks;
+    uint32_t              wire;                       /* bits on the bus     */
+    uint32_t              bad;                        /* bus rules broken    */
+} bench_i2c_mock_t;
+
+typedef struct
+{
+    i2c_sampler_t         sampler;
+    i2c_xfer_t            xfer[I2C_BATCH_MAX];
+    const uint8_t         * regs;
+    uint32_t              num;
+    uint8_t               data[BENCH_I2C_SENSOR_REGS];
+    uint32_t              stamp;                      /* of the last sample  */
+    uint32_t              bad;
+} bench_i2c_sensor_t;
+
+static const char * const s_cost_name[BENCH_I2C_COSTS] =
+{
+    "submit_idle", "done_next", "done_last", "end_to_start", "poll",
+};
+
+static const uint8_t s_addr[BENCH_I2C_DEVICES] =
+{
+    0x18U,                                    /* accelerometer              */
+    0x48U,                                    /* temperature sensor         */
+    0x76U,                                    /* pressure sensor            */
+};
+
+static uint32_t          s_iterations = BENCH_I2C_ITERATIONS;
+static bsp_i2c_t         s_bus        = { .is_initialized = I2C_NOT_INITED };
+static bsp_signal_t      s_signal = { .is_initialized = SIGNAL_NOT_INITED };
+static bench_i2c_user_t  s_users[BENCH_I2C_USERS];
+static bench_i2c_mock_t  s_mock;
+static bench_stat_t      s_cost[BENCH_I2C_COSTS];
+static uint32_t          s_now;
+static uint32_t          s_seq;
+static uint32_t          s_gaps;                      /* queued, not started */
+static uint32_t          s_done_chains;
+static uint32_t          s_done_xfers;
+static uint32_t          s_failed;
+static uint32_t          s_cancelled;
+static uint32_t          s_rand = 0x2545F491U;
+
+/**
+ * @brief: xorshift32, the same sequence on target and host
+ *
+ * @return uint32_t: next pseudo random number
+ **/
+static uint32_t __rand ( void )
+{
+    s_rand ^= s_rand << 13;
+    s_rand ^= s_rand >> 17;
+    s_rand ^= s_rand << 5;
+    return s_rand;
+}
+
+/**
+ * @brief: Mock device of an address
+ *
+ * @param[in]  addr: 7 bits address
+ *
+ * @return uint32_t: index in s_addr, BENCH_I2C_NONE when none answers
+ **/
+static uint32_t __device ( uint8_t addr )
+{
+    for ( uint32_t d = 0; d < BENCH_I2C_DEVICES; ++d )
+    {
+        if ( addr == s_addr[d] )
+        {
+            return d;
+        }
+    }
+    return BENCH_I2C_NONE;
+}
+
+//******************************** Mock *************************************//
+
+/**
+ * @brief: Submitter that started no chain yet, the first one submitted
+ *
+ * @return uint32_t: the user, BENCH_I2C_NONE when none waits
+ **/
+static uint32_t __oldest ( void )
+{
+    uint32_t user = BENCH_I2C_NONE;
+
+    for ( uint32_t u = 0; u < BENCH_I2C_USERS; ++u )
+    {
+        if ( 0U != s_users[u].num && 0U == s_users[u].started &&
+             s_users[u].fail_from == s_users[u].num &&
+             ( BENCH_I2C_NONE == user || s_users[u].seq < s_users[user].seq ) )
+        {
+            user = u;
+        }
+    }
+    return user;
+}
+
+/**
+ * @brief: Start of a transaction: which one, in order, on a free bus
+ **/
+static i2c_status_t __mock_start ( uint8_t          addr,
+                                   uint16_t         reg,
+                                   uint32_t         reg_len,
+                                   i2c_dir_t        dir,
+                                   uint8_t  * const data,
+                                   uint32_t         len      )
+{
+    i2c_xfer_t * x;
+    uint32_t     u;
+    uint32_t     k = 0U;
+
+    s_mock.bad += ( 0U != s_mock.busy || 0U != s_mock.dirty ) ? 1U : 0U;
+    for ( u = 0; 0U == s_mock.any && u < BENCH_I2C_USERS; ++u )
+    {
+        for ( k = 0; k < s_users[u].num; ++k )
+        {
+            if ( data == s_users[u].xfer[k].data )
+            {
+                break;
+            }
+        }
+        if ( k < s_users[u].num )
+        {
+            break;
+        }
+    }
+    if ( 0U == s_mock.any )
+    {
+        if ( BENCH_I2C_USERS == u )
+        {
+            s_mock.bad++;
+            return I2C_ERROR;
+        }
+        x = &s_users[u].xfer[k];
+        s_mock.bad += ( addr != x->addr || reg != x->reg ||
+                        reg_len != x->reg_len || dir != x->dir ||
+                        len != x->len ) ? 1U : 0U;
+
+        // a chain starts in submit order, goes on without another between
+        if ( 0U == k )
+        {
+            s_mock.bad += ( __oldest() != u ) ? 1U : 0U;
+            s_mock.chains++;
+        }
+        else if ( s_mock.user != u || s_mock.index + 1U != k )
+        {
+            s_mock.bad++;
+        }
+        s_mock.user        = u;
+        s_mock.index       = k;
+        s_users[u].started = k + 1U;
+    }
+
+    // SDA held low: the peripheral sees the bus busy
+    if ( 0U != s_mock.stuck )
+    {
+        s_mock.refused++;
+        s_mock.dirty = 1U;
+        if ( 0U == s_mock.any && k < s_users[u].fail_from )
+        {
+            s_users[u].fail_from = k;
+        }
+        return I2C_ERROR;
+    }
+    s_mock.addr    = addr;
+    s_mock.reg     = reg;
+    s_mock.reg_len = reg_len;
+    s_mock.dir     = dir;
+    s_mock.data    = data;
+    s_mock.len     = len;
+    s_mock.busy    = 1U;
+    s_mock.t_start = bench_timestamp_get();
+    return I2C_OK;
+}
+
+static i2c_status_t __mock_abort ( void )
+{
+    bench_i2c_user_t * user = &s_users[s_mock.user];
+
+    s_mock.bad += ( 0U == s_mock.busy ) ? 1U : 0U;
+    if ( 0U == s_mock.any && 0U != s_mock.busy &&
+         s_mock.index < user->fail_from )
+    {
+        user->fail_from = s_mock.index;
+    }
+    s_mock.busy  = 0U;
+    s_mock.hang  = 0U;
+    s_mock.dirty = 1U;
+    s_mock.aborts++;
+    return I2C_OK;
+}
+
+static i2c_status_t __mock_recover ( void )
+{
+    s_mock.bad  += ( 0U != s_mock.busy ) ? 1U : 0U;
+    s_mock.stuck = 0U;
+    s_mock.dirty = 0U;
+    s_mock.recovers++;
+    return I2C_OK;
+}
+
+static bsp_status_t __mock_critical ( void )
+{
+    // the runner plays the interrupt itself, nothing to mask
+    return BSP_OK;
+}
+
+static i2c_hw_operation_t s_mock_ops =
+{
+    .pf_i2c_start   = __mock_start,
+    .pf_i2c_abort   = __mock_abort,
+    .pf_i2c_recover = __mock_recover,
+};
+
+static os_critical_t s_mock_critical =
+{
+    .pf_os_critical_enter = __mock_critical,
+    .pf_os_critical_exit  = __mock_critical,
+};
+
+//******************************** Mock *************************************//
+
+/**
+ * @brief: End the running transaction as its interrupt would
+ *
+ * @param[in]  event: done, NACK or bus error; done on a missing device is
+ *                    a NACK
+ **/
+static void __pump ( i2c_event_t event )
+{
+    bench_i2c_user_t * user = &s_users[s_mock.user];
+    uint32_t           dev  = __device( s_mock.addr );
+    uint8_t          * r;
+    uint32_t           t0;
+    uint32_t           t1;
+
+    if ( 0U == s_mock.busy || 0U != s_mock.hang )
+    {
+        return;
+    }
+    if ( BENCH_I2C_NONE == dev && I2C_EVENT_DONE == event )
+    {
+        event = I2C_EVENT_NACK;
+    }
+    switch ( event )
+    {
+    case I2C_EVENT_DONE:
+        // START, address, register, repeated START and address, data, STOP
+        for ( uint32_t i = 0; i < s_mock.len; ++i )
+        {
+            r = &s_mock.regs[dev][( s_mock.reg + i ) % BENCH_I2C_REGS];
+            if ( I2C_DIR_READ == s_mock.dir )
+            {
+                s_mock.data[i] = *r;
+            }
+            else
+            {
+                *r = s_mock.data[i];
+            }
+        }
+        s_mock.wire += 2U + 9U * ( 1U + s_mock.reg_len + s_mock.len ) +
+                       ( ( I2C_DIR_READ == s_mock.dir &&
+                           0U != s_mock.reg_len ) ? 10U : 0U );
+        break;
+    case I2C_EVENT_NACK:
+        s_mock.wire += 2U + 9U;
+        s_mock.nacks++;
+        break;
+    default:
+        s_mock.bus_errors++;
+        s_mock.dirty = 1U;
+        break;
+    }
+    if ( 0U == s_mock.any && I2C_EVENT_DONE != event &&
+         s_mock.index < user->fail_from )
+    {
+        user->fail_from = s_mock.index;
+    }
+    s_mock.busy = 0U;
+
+    t0 = bench_timestamp_get();
+    i2c_done_isr( &s_bus, event );
+    t1 = bench_timestamp_get();
+
+    if ( 0U != s_mock.busy )
+    {
+        bench_stat_add( &s_cost[BENCH_I2C_DONE_NEXT], t1 - t0 );
+        bench_stat_add( &s_cost[BENCH_I2C_END_TO_START],
+                        s_mock.t_start - t0                );
+    }
+    else
+    {
+        bench_stat_add( &s_cost[BENCH_I2C_DONE_LAST], t1 - t0 );
+        s_gaps += ( NULL != s_bus.head && 0U == s_mock.dirty ) ? 1U : 0U;
+    }
+}
+
+/**
+ * @brief: End every transaction started, until the bus is idle
+ **/
+static void __drain ( void )
+{
+    while ( 0U != s_mock.busy )
+    {
+        __pump( I2C_EVENT_DONE );
+    }
+}
+
+/**
+ * @brief: A random chain of a submitter on one device, in its registers
+ *
+ * @param[in]  u:    the submitter
+ * @param[in]  addr: of the device, BENCH_I2C_NONE: at random
+ **/
+static void __build ( uint32_t u, uint32_t addr )
+{
+    bench_i2c_user_t * user = &s_users[u];
+    uint32_t           pick = __rand() % 8U;
+    i2c_xfer_t       * x;
+
+    if ( BENCH_I2C_NONE == addr )
+    {
+        addr = ( pick < 7U ) ? s_addr[pick % BENCH_I2C_DEVICES] :
+                               BENCH_I2C_ABSENT;
+    }
+    user->num       = 1U + __rand() % BENCH_I2C_CHAIN;
+    user->seq       = s_seq++;
+    user->started   = 0U;
+    user->fail_from = user->num;
+    for ( uint32_t k = 0; k < user->num; ++k )
+    {
+        x          = &user->xfer[k];
+        x->next    = ( k + 1U < user->num ) ? &user->xfer[k + 1U] : NULL;
+        x->addr    = (uint8_t)addr;
+        x->dir     = ( 0U != ( __rand() & 1U ) ) ? I2C_DIR_READ :
+                                                   I2C_DIR_WRITE;
+        x->len     = 1U + __rand() % BENCH_I2C_BYTES;
+        x->reg     = (uint16_t)( u * BENCH_I2C_WINDOW +
+                                 __rand() % ( BENCH_I2C_WINDOW - x->len ) );
+        x->reg_len = 1U;
+        x->data    = user->data[k];
+        x->signal  = ( NULL == x->next ) ? &s_signal : NULL;
+        x->bits    = 1UL << u;
+        for ( uint32_t i = 0; i < BENCH_I2C_BYTES; ++i )
+        {
+            user->data[k][i] = ( I2C_DIR_WRITE == x->dir ) ?
+                               (uint8_t)__rand() : 0U;
+        }
+    }
+}
+
+/**
+ * @brief: Build and queue a chain, time i2c_submit on an idle bus
+ *
+ * @param[in]  u:    the submitter
+ * @param[in]  addr: of the device, BENCH_I2C_NONE: at random
+ **/
+static void __submit ( uint32_t u, uint32_t addr )
+{
+    uint32_t     idle = ( NULL == s_bus.head ) ? 1U : 0U;
+    uint32_t     t0;
+    uint32_t     t1;
+    i2c_status_t ret;
+
+    __build( u, addr );
+    t0  = bench_timestamp_get();
+    ret = i2c_submit( &s_bus, &s_users[u].xfer[0] );
+    t1  = bench_timestamp_get();
+    if ( 0U != idle && 0U != s_mock.busy )
+    {
+        bench_stat_add( &s_cost[BENCH_I2C_SUBMIT_IDLE], t1 - t0 );
+    }
+    s_mock.bad += ( I2C_OK != ret ) ? 1U : 0U;
+}
+
+/**
+ * @brief: Cancel the chain of a submitter, done or not
+ *
+ * @param[in]  u: the submitter
+ **/
+static void __cancel ( uint32_t u )
+{
+    bench_i2c_user_t * user = &s_users[u];
+    uint32_t           done = 0U;
+
+    while ( done < user->num && 0U != user->xfer[done].done )
+    {
+        ++done;
+    }
+    if ( 0U == user->started )
+    {
+        // at the head while the bus is freed: the cancel starts the next
+        user->fail_from = 0U;
+    }
+    if ( I2C_OK == i2c_cancel( &s_bus, &user->xfer[0] ) )
+    {
+        user->fail_from = ( done < user->fail_from ) ? done : user->fail_from;
+        s_cancelled++;
+    }
+}
+
+/**
+ * @brief: Check the chains done against the registers the submitter wrote,
+ *         nothing run after a failure; the submitter is idle again
+ **/
+static void __collect ( void )
+{
+    bench_i2c_user_t * user;
+    i2c_xfer_t       * x;
+    uint32_t           dev;
+    uint32_t           k;
+    uint8_t          * shadow;
+
+    for ( uint32_t u = 0; u < BENCH_I2C_USERS; ++u )
+    {
+        user = &s_users[u];
+        for ( k = 0; k < user->num && 0U != user->xfer[k].done; ++k )
+        {
+        }
+        if ( 0U == user->num || k < user->num )
+        {
+            continue;
+        }
+        dev = __device( user->xfer[0].addr );
+        for ( k = 0; k < user->num; ++k )
+        {
+            x = &user->xfer[k];
+            if ( k >= user->fail_from )
+            {
+                // one status for the rest, nothing started after it
+                s_mock.bad += ( ( I2C_ERROR != x->status &&
+                                  I2C_ERRORTIMEOUT != x->status ) ||
+                                x->status !=
+                                user->xfer[user->fail_from].status ||
+                                ( k > user->fail_from &&
+                                  k < user->started ) ) ? 1U : 0U;
+                s_failed++;
+                continue;
+            }
+            if ( I2C_OK != x->status || BENCH_I2C_NONE == dev )
+            {
+                s_mock.bad++;
+                continue;
+            }
+            shadow = &user->shadow[dev][x->reg - u * BENCH_I2C_WINDOW];
+            for ( uint32_t i = 0; i < x->len; ++i )
+            {
+                if ( I2C_DIR_WRITE == x->dir )
+                {
+                    shadow[i] = x->data[i];
+                }
+                else
+                {
+                    s_mock.bad += ( shadow[i] != x->data[i] ) ? 1U : 0U;
+                }
+            }
+        }
+        s_done_xfers += user->num;
+        s_done_chains++;
+        user->num = 0U;
+    }
+}
+
+/**
+ * @brief: Submitters, bus events, stuck starts, polls and cancels in
+ *         random order
+ **/
+static void __check ( void )
+{
+    uint32_t r;
+    uint32_t u;
+    uint32_t e;
+    uint32_t loops = 0U;
+
+    s_bus.timeout_ms = BENCH_I2C_TIMEOUT;
+    for ( uint32_t i = 0; i < s_iterations; ++i )
+    {
+        s_now++;
+        r = __rand() % 32U;
+        u = __rand() % BENCH_I2C_USERS;
+        if ( r < 9U )
+        {
+            if ( 0U == s_users[u].num )
+            {
+                __submit( u, BENCH_I2C_NONE );
+            }
+        }
+        else if ( r < 25U )
+        {
+            e = __rand() % 32U;
+            __pump( ( 0U == e ) ? I2C_EVENT_NACK :
+                    ( 1U == e ) ? I2C_EVENT_BUS  : I2C_EVENT_DONE );
+        }
+        else if ( r < 26U )
+        {
+            // SDA held before the next start, or SCL held in this one
+            s_mock.stuck |= __rand() & 1U;
+            s_mock.hang  |= ( 0U == s_mock.stuck ) ? s_mock.busy : 0U;
+        }
+        else if ( r < 29U )
+        {
+            i2c_poll( &s_bus, s_now );
+        }
+        else if ( 0U != s_users[u].num )
+        {
+            __cancel( u );
+        }
+        __collect();
+    }
+
+    // drain: everything queued ends, the bus freed
+    s_mock.stuck = 0U;
+    s_mock.hang  = 0U;
+    while ( ( 0U != s_mock.busy || NULL != s_bus.head ) && loops++ < 1000U )
+    {
+        __drain();
+        i2c_poll( &s_bus, s_now );
+        __collect();
+    }
+    for ( u = 0; u < BENCH_I2C_USERS; ++u )
+    {
+        s_mock.bad += ( 0U != s_users[u].num ) ? 1U : 0U;
+    }
+    s_mock.bad += ( NULL != s_bus.head || 0U != s_mock.dirty ||
+                    s_mock.recovers != s_mock.bus_errors + s_mock.refused +
+                                       s_mock.aborts ||
+                    s_bus.recoveries != s_mock.recovers ||
+                    s_bus.nacks != s_mock.nacks ||
+                    s_bus.xfers + s_bus.errors != s_done_xfers ||
+                    s_bus.errors != s_failed ) ? 1U : 0U;
+
+    printf( "# check,%u chains,%u transactions,%u failed,%u cancelled,"
+            "%u nacks,%u bus errors,%u refused,%u timeouts,"
+            "%u recoveries,%u gaps,%s\r\n",
+            (unsigned int)s_done_chains, (unsigned int)s_done_xfers,
+            (unsigned int)s_failed, (unsigned int)s_cancelled,
+            (unsigned int)s_bus.nacks, (unsigned int)s_mock.bus_errors,
+            (unsigned int)s_mock.refused, (unsigned int)s_bus.timeouts,
+            (unsigned int)s_bus.recoveries, (unsigned int)s_gaps,
+            ( 0U == s_mock.bad && 0U == s_gaps ) ? "ok" : "MISMATCH" );
+}
+
+/**
+ * @brief: A stuck bus refuses the start and is freed at once; after a bus
+ *         error nothing starts until i2c_poll frees the bus; a NACK fails
+ *         its chain, the next one starts from the interrupt
+ **/
+static void __recover ( void )
+{
+    uint32_t bad      = s_mock.bad;
+    uint32_t recovers = s_mock.recovers;
+    uint32_t ok       = 1U;
+
+    /***************** Stuck **************************************/
+    s_mock.stuck = 1U;
+    __submit( 0U, s_addr[0] );
+    ok &= ( 0U != s_users[0].xfer[0].done &&
+            I2C_ERROR == s_users[0].xfer[0].status &&
+            recovers + 1U == s_mock.recovers &&
+            0U == s_mock.dirty && 0U == s_mock.busy ) ? 1U : 0U;
+    __collect();
+
+    /***************** Bus error **********************************/
+    __submit( 0U, s_addr[0] );
+    __submit( 1U, s_addr[1] );
+    __pump( I2C_EVENT_BUS );
+    ok &= ( 0U == s_users[1].started && 0U == s_mock.busy &&
+            0U != s_mock.dirty ) ? 1U : 0U;
+    i2c_poll( &s_bus, s_now );
+    ok &= ( 0U != s_users[1].started && 0U == s_mock.dirty &&
+            recovers + 2U == s_mock.recovers ) ? 1U : 0U;
+    __drain();
+    __collect();
+
+    /***************** NACK ***************************************/
+    __submit( 0U, BENCH_I2C_ABSENT );
+    __submit( 1U, s_addr[1] );
+    __pump( I2C_EVENT_DONE );
+    ok &= ( 0U != s_users[1].started &&
+            recovers + 2U == s_mock.recovers ) ? 1U : 0U;
+    __drain();
+    __collect();
+
+    ok &= ( bad == s_mock.bad && 0U == s_users[0].num &&
+            0U == s_users[1].num ) ? 1U : 0U;
+    printf( "# recover,%s\r\n", ( 0U != ok ) ? "ok" : "MISMATCH" );
+}
+
+/**
+ * @brief: The watch aborts a hung transaction after timeout_ms, the next
+ *         one runs; i2c_transfer times out behind a hung chain, cancelled
+ *         before it started, and running, aborted and the bus freed
+ **/
+static void __timeout ( void )
+{
+    uint32_t     bad      = s_mock.bad;
+    uint32_t     aborts   = s_mock.aborts;
+    uint32_t     timeouts = s_bus.timeouts;
+    uint32_t     t        = s_now;
+    uint32_t     ok       = 1U;
+    uint32_t     bits     = 0U;
+    i2c_status_t ret;
+
+    /***************** Watch **************************************/
+    __submit( 0U, s_addr[0] );
+    __submit( 1U, s_addr[1] );
+    ok &= ( BENCH_I2C_TIMEOUT == i2c_poll( &s_bus, t ) ) ? 1U : 0U;
+    i2c_poll( &s_bus, t + BENCH_I2C_TIMEOUT - 1U );
+    ok &= ( 0U == s_users[0].xfer[0].done ) ? 1U : 0U;
+    i2c_poll( &s_bus, t + BENCH_I2C_TIMEOUT );
+    ok &= ( I2C_ERRORTIMEOUT == s_users[0].xfer[0].status &&
+            0U != s_users[1].started && aborts + 1U == s_mock.aborts &&
+            timeouts + 1U == s_bus.timeouts ) ? 1U : 0U;
+    __drain();
+    __collect();
+    s_now = t + BENCH_I2C_TIMEOUT;
+
+    /***************** Behind a hung chain ************************/
+    // bits of the chains before, a transfer would take them as its end
+    signal_wait( &s_signal, BENCH_I2C_ALL_BITS, 0U, &bits );
+    __submit( 0U, s_addr[0] );
+    __build( 1U, s_addr[1] );
+    ret = i2c_transfer( &s_bus, &s_users[1].xfer[0], 1U );
+    ok &= ( I2C_ERRORTIMEOUT == ret && 0U == s_users[1].started ) ? 1U : 0U;
+    s_users[1].fail_from = 0U;
+    __drain();
+    __collect();
+
+    /***************** Running ************************************/
+    __build( 2U, s_addr[2] );
+    ret = i2c_transfer( &s_bus, &s_users[2].xfer[0], 1U );
+    ok &= ( I2C_ERRORTIMEOUT == ret && 0U != s_users[2].started &&
+            0U == s_mock.busy && 0U == s_mock.dirty &&
+            aborts + 2U == s_mock.aborts ) ? 1U : 0U;
+    __collect();
+
+    ok &= ( bad == s_mock.bad && 0U == s_users[0].num &&
+            0U == s_users[1].num && 0U == s_users[2].num ) ? 1U : 0U;
+    printf( "# timeout,%s\r\n", ( 0U != ok ) ? "ok" : "MISMATCH" );
+}
+
+/**
+ * @brief: i2c_batch_read merges runs of registers, 0xFF and 0x00 not; the
+ *         chain reads every register
+ **/
+static void __batch ( void )
+{
+    static const uint8_t regs[] =
+    {
+        0x80U, 0x81U, 0x82U, 0x83U, 0x84U, 0x85U, 0x8FU, 0xFFU, 0x00U,
+        0x90U, 0x91U,
+    };
+    static const uint32_t lens[] = { 6U, 1U, 1U, 1U, 2U };
+    static i2c_xfer_t     xfer[I2C_BATCH_MAX];
+    static uint8_t        data[sizeof( regs )];
+    const uint32_t        num  = sizeof( regs ) / sizeof( regs[0] );
+    uint32_t              used = 0U;
+    uint32_t              ok   = 1U;
+
+    memset( xfer, 0, sizeof( xfer ) );
+    memset( data, 0, sizeof( data ) );
+    ok &= ( I2C_OK == i2c_batch_read( xfer, I2C_BATCH_MAX, s_addr[2], regs,
+                                      data, num, &used ) &&
+            sizeof( lens ) / sizeof( lens[0] ) == used ) ? 1U : 0U;
+    for ( uint32_t k = 0; 0U != ok && k < used; ++k )
+    {
+        ok &= ( lens[k] == xfer[k].len &&
+                ( ( k + 1U < used ) ? &xfer[k + 1U] : NULL ) ==
+                xfer[k].next ) ? 1U : 0U;
+    }
+
+    s_mock.any = 1U;
+    ok &= ( 0U != ok && I2C_OK == i2c_submit( &s_bus, xfer ) ) ? 1U : 0U;
+    __drain();
+    s_mock.any = 0U;
+    for ( uint32_t i = 0; 0U != ok && i < num; ++i )
+    {
+        ok &= ( s_mock.regs[2][regs[i]] == data[i] &&
+                I2C_OK == xfer[used - 1U].status ) ? 1U : 0U;
+    }
+    ok &= ( I2C_ERRORNOMEMORY == i2c_batch_read( xfer, used - 1U,
+                                                 s_addr[2], regs, data,
+                                                 num, &used ) ) ? 1U : 0U;
+    printf( "# batch,%u registers,%u transactions,%s\r\n",
+            (unsigned int)num, (unsigned int)( sizeof( lens ) /
+                                               sizeof( lens[0] ) ),
+            ( 0U != ok ) ? "ok" : "MISMATCH" );
+}
+
+/**
+ * @brief: pf_sample of the sensors: every byte of one instant, a new one
+ *
+ * @param[in]  sampler: the sampler of a bench_i2c_sensor_t
+ * @param[in]  status:  of its chain
+ **/
+static void __on_sample ( i2c_sampler_t * const sampler,
+                          i2c_status_t          status )
+{
+    bench_i2c_sensor_t * sensor = (bench_i2c_sensor_t *)sampler->arg;
+    uint32_t             stamp  = (uint8_t)( sensor->data[0] -
+                                             sensor->regs[0] );
+
+    if ( I2C_OK != status )
+    {
+        sensor->bad++;
+        return;
+    }
+    for ( uint32_t i = 1; i < sensor->num; ++i )
+    {
+        sensor->bad += ( stamp != (uint8_t)( sensor->data[i] -
+                                             sensor->regs[i] ) ) ? 1U : 0U;
+    }
+    sensor->bad   += ( stamp == sensor->stamp ) ? 1U : 0U;
+    sensor->stamp  = stamp;
+}
+
+/**
+ * @brief: A sensor of the sampler line on a mock device
+ *
+ * @param[in]  sensor: to set up
+ * @param[in]  dev:    mock device
+ * @param[in]  regs:   its registers, num of them
+ * @param[in]  num:    registers
+ * @param[in]  period: ms
+ *
+ * @return uint32_t: 1 when added
+ **/
+static uint32_t __sensor ( bench_i2c_sensor_t * const sensor,
+                           uint32_t                   dev,
+                           const uint8_t      * const regs,
+                           uint32_t                   num,
+                           uint32_t                   period )
+{
+    uint32_t used = 0U;
+
+    memset( sensor, 0, sizeof( *sensor ) );
+    sensor->regs  = regs;
+    sensor->num   = num;
+    sensor->stamp = BENCH_I2C_NONE;
+    if ( I2C_OK != i2c_batch_read( sensor->xfer, I2C_BATCH_MAX,
+                                   s_addr[dev], regs, sensor->data, num,
+                                   &used ) )
+    {
+        return 0U;
+    }
+    sensor->sampler.xfer      = sensor->xfer;
+    sensor->sampler.period_ms = period;
+    sensor->sampler.pf_sample = __on_sample;
+    sensor->sampler.arg       = sensor;
+    return ( I2C_OK == i2c_sampler_add( &s_bus, &sensor->sampler ) ) ?
+           1U : 0U;
+}
+
+/**
+ * @brief: Two sensors sampled by i2c_poll for BENCH_I2C_SAMPLE_MS, the
+ *         accelerometer hung for 25 ms in the middle
+ **/
+static void __sampler ( void )
+{
+    static const uint8_t accel_regs[] =
+    {
+        0x80U, 0x81U, 0x82U, 0x83U, 0x84U, 0x85U,
+    };
+    static const uint8_t temp_regs[] = { 0x80U, 0x81U, 0x88U };
+    static bench_i2c_sensor_t accel;
+    static bench_i2c_sensor_t temp;
+    const uint32_t            hang_from = BENCH_I2C_SAMPLE_MS / 2U + 10U;
+    uint32_t                  ok        = 1U;
+    uint32_t                  now;
+    uint32_t                  wait;
+    uint32_t                  t0;
+
+    s_bus.timeout_ms = I2C_TIMEOUT_MS;
+    s_mock.any       = 1U;
+    ok &= __sensor( &accel, 0U, accel_regs, sizeof( accel_regs ), 10U );
+    ok &= __sensor( &temp,  1U, temp_regs,  sizeof( temp_regs ),  25U );
+
+    for ( uint32_t t = 0; 0U != ok && t < BENCH_I2C_SAMPLE_MS; ++t )
+    {
+        now = s_now + t;
+        for ( uint32_t d = 0; d < BENCH_I2C_DEVICES; ++d )
+        {
+            for ( uint32_t r = 0; r < BENCH_I2C_SENSOR_REGS; ++r )
+            {
+                s_mock.regs[d][BENCH_I2C_SENSOR + r] =
+                    (uint8_t)( now + BENCH_I2C_SENSOR + r );
+            }
+        }
+
+        // both periods are multiples of 5 ms, the chains end in their ms
+        t0   = bench_timestamp_get();
+        wait = i2c_poll( &s_bus, now );
+        if ( 1U < t % 5U )
+        {
+            bench_stat_add( &s_cost[BENCH_I2C_POLL],
+                            bench_timestamp_get() - t0 );
+        }
+        ok &= ( 1U != t || 9U == wait ) ? 1U : 0U;
+        if ( t < hang_from || hang_from + 25U <= t )
+        {
+            __drain();
+        }
+    }
+    s_now     += BENCH_I2C_SAMPLE_MS;
+    s_mock.any = 0U;
+
+    // 200 and 80 periods, two of the accelerometer while it hung
+    ok &= ( BENCH_I2C_SAMPLE_MS / 10U - 2U == accel.sampler.samples &&
+            2U == accel.sampler.overruns &&
+            BENCH_I2C_SAMPLE_MS / 25U == temp.sampler.samples &&
+            0U == temp.sampler.overruns &&
+            0U == accel.sampler.errors + temp.sampler.errors &&
+            0U == accel.bad + temp.bad ) ? 1U : 0U;
+    printf( "# sampler,%u accel samples,%u overruns,%u temp samples,%s\r\n",
+            (unsigned int)accel.sampler.samples,
+            (unsigned int)accel.sampler.overruns,
+            (unsigned int)temp.sampler.samples,
+            ( 0U != ok ) ? "ok" : "MISMATCH" );
+}
+
+/**
+ * @brief: Bits on the wire of a chain, run on the mock
+ *
+ * @param[in]  xfer: first transaction of the chain
+ *
+ * @return uint32_t: bits, 0 when it failed
+ **/
+static uint32_t __wire ( i2c_xfer_t * const xfer )
+{
+    uint32_t     wire = s_mock.wire;
+    i2c_xfer_t * last = xfer;
+
+    while ( NULL != last->next )
+    {
+        last = last->next;
+    }
+    s_mock.any = 1U;
+    if ( I2C_OK != i2c_submit( &s_bus, xfer ) )
+    {
+        s_mock.any = 0U;
+        return 0U;
+    }
+    __drain();
+    s_mock.any = 0U;
+    return ( I2C_OK == last->status ) ? s_mock.wire - wire : 0U;
+}
+
+/**
+ * @brief: An IMU read (accelerometer and gyroscope, 6 registers each) as
+ *         a merged batch and register by register: bits on the bus and
+ *         reads per second at 400 kHz
+ **/
+static void __throughput ( void )
+{
+    static const uint8_t regs[BENCH_I2C_IMU_REGS] =
+    {
+        0x80U, 0x81U, 0x82U, 0x83U, 0x84U, 0x85U,
+        0x88U, 0x89U, 0x8AU, 0x8BU, 0x8CU, 0x8DU,
+    };
+    // static: out of the stack of the runner
+    static i2c_xfer_t merged[I2C_BATCH_MAX];
+    static i2c_xfer_t single[BENCH_I2C_IMU_REGS];
+    static uint8_t    data_m[BENCH_I2C_IMU_REGS];
+    static uint8_t    data_s[BENCH_I2C_IMU_REGS];
+    uint32_t          used = 0U;
+    uint32_t          bits_m;
+    uint32_t          bits_s;
+    uint32_t          rate_m;
+    uint32_t          rate_s;
+    uint32_t          ok;
+
+    memset( merged, 0, sizeof( merged ) );
+    memset( single, 0, sizeof( single ) );
+    i2c_batch_read( merged, I2C_BATCH_MAX, s_addr[0], regs, data_m,
+                    BENCH_I2C_IMU_REGS, &used );
+    for ( uint32_t i = 0; i < BENCH_I2C_IMU_REGS; ++i )
+    {
+        // the list of one register each, as a driver without batches
+        i2c_batch_read( &single[i], 1U, s_addr[0], &regs[i], &data_s[i],
+                        1U, &used );
+        single[i].next = ( i + 1U < BENCH_I2C_IMU_REGS ) ? &single[i + 1U] :
+                                                           NULL;
+    }
+    bits_m = __wire( merged );
+    bits_s = __wire( single );
+    ok     = ( 0U != bits_m && bits_m < bits_s &&
+               0 == memcmp( data_m, data_s, sizeof( data_m ) ) ) ? 1U : 0U;
+    rate_m = ( 0U != bits_m ) ? BENCH_I2C_BUS_HZ / bits_m : 0U;
+    rate_s = ( 0U != bits_s ) ? BENCH_I2C_BUS_HZ / bits_s : 0U;
+
+    printf( "# throughput,%u registers,%u bits merged,%u bits single,"
+            "%u reads/s merged,%u reads/s single at 400 kHz,%s\r\n",
+            (unsigned int)BENCH_I2C_IMU_REGS, (unsigned int)bits_m,
+            (unsigned int)bits_s,
+            (unsigned int)rate_m, (unsigned int)rate_s,
+            ( 0U != ok ) ? "ok" : "MISMATCH" );
+}
+
+#ifndef BENCH_HOST_POSIX
+/**
+ * @brief: The end of the last transaction of a chain notifies its submitter
+ **/
+static void __notify ( void )
+{
+    uint32_t bits = 0U;
+    uint32_t ok;
+
+    // bits of the chains before
+    signal_wait( &s_signal, BENCH_I2C_ALL_BITS, 0U, &bits );
+
+    __submit( 0U, s_addr[0] );
+    __drain();
+    ok = ( SIGNAL_OK == signal_wait( &s_signal, 1UL << 0, 0U, &bits ) &&
+           ( 1UL << 0 ) == bits ) ? 1U : 0U;
+    __collect();
+    printf( "# notify,%s\r\n", ( 0U != ok ) ? "ok" : "MISMATCH" );
+}
+#endif /* BENCH_HOST_POSIX */
+
+/**
+ * @brief: Runner task, runs every check and deletes itself
+ *
+ * @param[in]  argument: Not used
+ **/
+static void bench_i2c_task ( void * argument )
+{
+    (void)argument;
+
+    signal_instantiate( &s_signal, xTaskGetCurrentTaskHandle() );
+    bench_csv_header( BENCH_I2C_SUITE );
+    __check();
+    __recover();
+    __timeout();
+    __batch();
+    __sampler();
+    __throughput();
+#ifndef BENCH_HOST_POSIX
+    __notify();
+#endif /* BENCH_HOST_POSIX */
+    for ( uint32_t c = 0; c < BENCH_I2C_COSTS; ++c )
+    {
+        bench_csv_row( BENCH_I2C_SUITE, "cpu", s_cost_name[c], &s_cost[c] );
+    }
+
+    vTaskDelete( NULL );
+}
+
+/**
+ * @brief: Start the I2C suite
+ * @steps:
+ *      1. Start the timestamp source
+ *      2. Create the runner task, it prints the CSV report and deletes itself
+ *
+ * @param[in]  iterations: random steps of the check, 0 means default
+ *
+ * @return bench_status_t: execute result of this function
+ **/
+bench_status_t bench_i2c_start ( uint32_t iterations )
+{
+    bench_status_t ret = BENCH_OK;
+
+    /************** 1. Start the timestamp source *************/
+    ret = bench_timestamp_init();
+    if ( BENCH_OK != ret )
+    {
+        LOG( LOG_LEVEL_ERR, "Bench timestamp init failed" );
+        return ret;
+    }
+    s_iterations = ( 0U == iterations ) ? BENCH_I2C_ITERATIONS : iterations;
+    if ( I2C_INITED != s_bus.is_initialized &&
+         I2C_OK != i2c_bus_inst( &s_bus, &s_mock_ops, &s_mock_critical ) )
+    {
+        return BENCH_ERROR;
+    }
+    memset( &s_mock, 0, sizeof( s_mock ) );
+    for ( uint32_t d = 0; d < BENCH_I2C_DEVICES; ++d )
+    {
+        for ( uint32_t r = 0; r < BENCH_I2C_REGS; ++r )
+        {
+            s_mock.regs[d][r] = (uint8_t)( d * 37U + r * 5U );
+        }
+        for ( uint32_t u = 0; u < BENCH_I2C_USERS; ++u )
+        {
+            memcpy( s_users[u].shadow[d],
+                    &s_mock.regs[d][u * BENCH_I2C_WINDOW],
+                    BENCH_I2C_WINDOW );
+        }
+    }
+    for ( uint32_t c = 0; c < BENCH_I2C_COSTS; ++c )
+    {
+        bench_stat_reset( &s_cost[c] );
+    }
+
+    /***************** 2. Create the runner ******************/
+    if ( pdPASS != xTaskCreate( bench_i2c_task,
+                                "bench_i2c",
+                                BENCH_I2C_STACK_WORDS,
+                                NULL,
+                                tskIDLE_PRIORITY + 1,
+                                NULL                  ) )
+    {
+        LOG( LOG_LEVEL_ERR, "Bench I2C task create failed" );
+        return BENCH_ERROR;
+    }
+    return BENCH_OK;
+}
+
+//******************************** Defines **********************************//
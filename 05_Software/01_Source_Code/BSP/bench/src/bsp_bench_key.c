@@ -0,0 +1,580 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_bench_key.c
+ *
+ * @par dependencies
+ * - bsp_bench_key.h
+ * - bsp_key_driver.h
+ *
+ * @author Damian
+ *
+ * @brief Replay bounce waveforms against the key state machine, check the
+ *        events it reports and measure the cost of a step.
+ *
+ * Processing flow:
+ *
+ * Call directly.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+//******************************** Includes *********************************//
+
+#include "bsp_bench_key.h"
+#include "bsp_common.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+#define BENCH_KEY_SUITE           "key"
+#define BENCH_KEY_ROUNDS_MAX      2U      /* key_process of one millisecond  */
+#define BENCH_KEY_EVT_MAX         ( BENCH_KEY_ROUNDS_MAX *                   \
+                                    KEY_EVT_MAX_PER_STEP )
+#define BENCH_KEY_WAVE_MAX        ( 2U * ( 1U + BENCH_KEY_BOUNCE_MAX ) )
+#define BENCH_KEY_BOUNCE_STEP     ( ( KEY_DEBOUNCE_MS - 1U ) /               \
+                                    BENCH_KEY_BOUNCE_MAX )
+#define BENCH_KEY_TAIL_MS         ( KEY_DOUBLE_CLICK_MS + KEY_LONG_PRESS_MS )
+#define BENCH_KEY_ALL_EVENTS      ( KEY_EVT_BIT( KEY_EVT_PRESS )        |    \
+                                    KEY_EVT_BIT( KEY_EVT_RELEASE )      |    \
+                                    KEY_EVT_BIT( KEY_EVT_CLICK )        |    \
+                                    KEY_EVT_BIT( KEY_EVT_DOUBLE_CLICK ) |    \
+                                    KEY_EVT_BIT( KEY_EVT_LONG_PRESS )   |    \
+                                    KEY_EVT_BIT( KEY_EVT_REPEAT )         )
+
+typedef struct
+{
+    uint32_t              t_ms;                   /* from the line start     */
+    uint8_t               level;                  /* 1 pressed               */
+} bench_key_edge_t;
+
+typedef struct
+{
+    bsp_key_driver_t      key;                    /* the state machine       */
+    uint8_t               level;                  /* of the pin              */
+    uint8_t               irq;                    /* edge interrupt unmasked */
+    uint8_t               pending;                /* edge taken, not run yet */
+    uint8_t               due_set;                /* due_ms is a deadline    */
+    uint32_t              due_ms;                 /* of key_next_deadline    */
+    uint32_t              irqs;                   /* edges taken             */
+    uint32_t              next;                   /* next edge of the wave   */
+} bench_key_pin_t;
+
+typedef struct
+{
+    const char             * name;
+    const bench_key_edge_t * wave;                /* bounced edges           */
+    uint32_t                 wave_num;
+    const key_event_t      * expect;              /* events, in order        */
+    uint32_t                 expect_num;
+    uint32_t                 edges;               /* debounced edges         */
+    uint32_t                 end_ms;              /* replayed up to          */
+} bench_key_line_t;
+
+typedef struct
+{
+    uint32_t              gestures;               /* press and release       */
+    uint32_t              events;                 /* of the bounced key      */
+    uint32_t              bounces;                /* toggles in the windows  */
+    uint32_t              diffs;                  /* ms the twin differs     */
+    uint32_t              seen;                   /* KEY_EVT_BIT of events   */
+} bench_key_result_t;
+
+/* press at 100 and release at 180, both bouncing */
+static const bench_key_edge_t s_wave_click[] =
+{
+    { 100U, 1U }, { 101U, 0U }, { 102U, 1U }, { 103U, 0U }, { 104U, 1U },
+    { 180U, 0U }, { 181U, 1U }, { 182U, 0U },
+};
+
+static const key_event_t      s_expect_click[] =
+{
+    { 0U, KEY_EVT_PRESS,   0U, 100U },
+    { 0U, KEY_EVT_RELEASE, 0U, 180U },
+    { 0U, KEY_EVT_CLICK,   0U, 180U + KEY_DOUBLE_CLICK_MS },
+};
+
+/* two bouncing clicks, the second press inside the double-click window */
+static const bench_key_edge_t s_wave_double[] =
+{
+    { 100U, 1U }, { 102U, 0U }, { 104U, 1U },
+    { 180U, 0U }, { 183U, 1U }, { 185U, 0U },
+    { 300U, 1U }, { 301U, 0U }, { 302U, 1U },
+    { 400U, 0U }, { 401U, 1U }, { 403U, 0U },
+};
+
+static const key_event_t      s_expect_double[] =
+{
+    { 0U, KEY_EVT_PRESS,        0U, 100U },
+    { 0U, KEY_EVT_RELEASE,      0U, 180U },
+    { 0U, KEY_EVT_PRESS,        0U, 300U },
+    { 0U, KEY_EVT_RELEASE,      0U, 400U },
+    { 0U, KEY_EVT_DOUBLE_CLICK, 0U, 400U },
+};
+
+/* a bouncing press held over the long press and four repeats */
+static const bench_key_edge_t s_wave_long[] =
+{
+    { 1000U, 1U }, { 1002U, 0U }, { 1003U, 1U },
+    { 2250U, 0U }, { 2252U, 1U }, { 2255U, 0U },
+};
+
+static const key_event_t      s_expect_long[] =
+{
+    { 0U, KEY_EVT_PRESS,      0U, 1000U },
+    { 0U, KEY_EVT_LONG_PRESS, 0U, 1000U + KEY_LONG_PRESS_MS },
+    { 0U, KEY_EVT_REPEAT,     1U, 1000U + KEY_LONG_PRESS_MS +
+                                  1U * KEY_REPEAT_MS },
+    { 0U, KEY_EVT_REPEAT,     2U, 1000U + KEY_LONG_PRESS_MS +
+                                  2U * KEY_REPEAT_MS },
+    { 0U, KEY_EVT_REPEAT,     3U, 1000U + KEY_LONG_PRESS_MS +
+                                  3U * KEY_REPEAT_MS },
+    { 0U, KEY_EVT_REPEAT,     4U, 1000U + KEY_LONG_PRESS_MS +
+                                  4U * KEY_REPEAT_MS },
+    { 0U, KEY_EVT_RELEASE,    0U, 2250U },
+};
+
+#define BENCH_KEY_LINE( n, w, e, edges, end )                                \
+    { n, w, sizeof( w ) / sizeof( w[0] ), e, sizeof( e ) / sizeof( e[0] ),   \
+      edges, end }
+
+static const bench_key_line_t s_lines[] =
+{
+    BENCH_KEY_LINE( "click",  s_wave_click,  s_expect_click,  2U, 600U  ),
+    BENCH_KEY_LINE( "double", s_wave_double, s_expect_double, 4U, 800U  ),
+    BENCH_KEY_LINE( "long",   s_wave_long,   s_expect_long,   2U, 2600U ),
+};
+
+static uint32_t             s_iterations = BENCH_KEY_ITERATIONS;
+static uint32_t             s_rand       = 0x2545F491U;
+static bench_key_pin_t    * s_pin;             /* of the running step     */
+static bench_stat_t         s_stat[2];         /* process, deadline       */
+
+static uint32_t __rand ( void )
+{
+    s_rand ^= s_rand << 13;
+    s_rand ^= s_rand >> 17;
+    s_rand ^= s_rand << 5;
+    return s_rand;
+}
+
+//************************** The mocked key pin *****************************//
+
+static key_inst_status_t __pin_read ( uint8_t * const pressed )
+{
+    *pressed = s_pin->level;
+    return KEY_INST_OK;
+}
+
+static key_inst_status_t __pin_irq_enable ( void )
+{
+    s_pin->irq = 1U;
+    return KEY_INST_OK;
+}
+
+static key_inst_status_t __pin_irq_disable ( void )
+{
+    s_pin->irq = 0U;
+    return KEY_INST_OK;
+}
+
+static key_operation_t      s_pin_ops =
+{
+    .pf_key_read        = __pin_read,
+    .pf_key_irq_enable  = __pin_irq_enable,
+    .pf_key_irq_disable = __pin_irq_disable,
+};
+
+/**
+ * @brief: A released pin and a new key on it, run at the first millisecond
+ *         as by the first pass of the handler task
+ *
+ * @param[in]  pin: the pin
+ *
+ * @return uint32_t: 1 when the key is instantiated
+ **/
+static uint32_t __pin_init ( bench_key_pin_t * const pin )
+{
+    pin->level              = 0U;
+    pin->irq                = 0U;
+    pin->pending            = 1U;
+    pin->due_set            = 0U;
+    pin->due_ms             = 0U;
+    pin->irqs               = 0U;
+    pin->next               = 0U;
+    pin->key.is_initialized = KEY_INST_NOT_INITED;
+    s_pin                   = pin;
+    return ( KEY_INST_OK == key_instantiate( &pin->key, &s_pin_ops,
+                                             0U, NULL ) ) ? 1U : 0U;
+}
+
+/**
+ * @brief: Play the edges of one millisecond on the pin, an edge seen with
+ *         the interrupt unmasked masks it, as key_handler_irq
+ *
+ * @param[in]  pin:    the pin
+ * @param[in]  wave:   edges of the pin
+ * @param[in]  num:    edges in the wave
+ * @param[in]  rel_ms: the millisecond, from the line start
+ **/
+static void __pin_apply ( bench_key_pin_t        * const pin,
+                          const bench_key_edge_t * const wave,
+                          uint32_t                       num,
+                          uint32_t                       rel_ms )
+{
+    while ( pin->next < num && rel_ms == wave[pin->next].t_ms )
+    {
+        if ( wave[pin->next].level != pin->level )
+        {
+            pin->level = wave[pin->next].level;
+            if ( 0U != pin->irq )
+            {
+                pin->irq     = 0U;
+                pin->pending = 1U;
+                pin->irqs++;
+            }
+        }
+        pin->next++;
+    }
+}
+
+/**
+ * @brief: Run the key when an edge was taken or its deadline is reached,
+ *         as the handler task
+ *
+ * @param[in]  pin:    the pin
+ * @param[in]  now_ms: the millisecond
+ * @param[in]  cost:   1 to time the calls
+ * @param[out] events: BENCH_KEY_EVT_MAX slots
+ * @param[out] num:    events written
+ **/
+static void __pin_step ( bench_key_pin_t * const pin,
+                         uint32_t                now_ms,
+                         uint32_t                cost,
+                         key_event_t     * const events,
+                         uint32_t        * const num )
+{
+    uint32_t wait = KEY_NO_DEADLINE;
+    uint32_t n    = 0U;
+    uint32_t t0;
+
+    *num = 0U;
+    if ( 0U == pin->pending &&
+         ( 0U == pin->due_set || now_ms != pin->due_ms ) )
+    {
+        return;
+    }
+    pin->pending = 0U;
+    s_pin        = pin;
+    for ( uint32_t round = 0; round < BENCH_KEY_ROUNDS_MAX; ++round )
+    {
+        t0 = bench_timestamp_get();
+        (void)key_process( &pin->key, now_ms, &events[*num], &n );
+        if ( 0U != cost )
+        {
+            bench_stat_add( &s_stat[0], bench_timestamp_get() - t0 );
+        }
+        *num += n;
+        t0    = bench_timestamp_get();
+        wait  = key_next_deadline( &pin->key, now_ms );
+        if ( 0U != cost )
+        {
+            bench_stat_add( &s_stat[1], bench_timestamp_get() - t0 );
+        }
+        if ( 0U != wait )
+        {
+            break;
+        }
+    }
+    pin->due_set = ( KEY_NO_DEADLINE != wait ) ? 1U : 0U;
+    pin->due_ms  = now_ms + wait;
+}
+
+//************************** The mocked key pin *****************************//
+
+/**
+ * @brief: Run and print a line of a recorded waveform
+ * @steps:
+ *      1. Replay the waveform, every event against the next expected one
+ *      2. Check and print
+ *
+ * @param[in]  line: the line
+ **/
+static void __line ( const bench_key_line_t * const line )
+{
+    bench_key_pin_t pin;
+    key_event_t     events[BENCH_KEY_EVT_MAX];
+    uint32_t        num;
+    uint32_t        got   = 0U;
+    uint32_t        wrong = 0U;
+    const key_event_t * e;
+
+    /***************** 1. Replay **************************/
+    if ( 0U == __pin_init( &pin ) )
+    {
+        wrong++;
+    }
+    for ( uint32_t t = 0; t <= line->end_ms; ++t )
+    {
+        __pin_apply( &pin, line->wave, line->wave_num, t );
+        __pin_step( &pin, t, 0U, events, &num );
+        for ( uint32_t i = 0; i < num; ++i, ++got )
+        {
+            e = ( got < line->expect_num ) ? &line->expect[got] : NULL;
+            if ( NULL == e                        ||
+                 e->type    != events[i].type     ||
+                 e->count   != events[i].count    ||
+                 e->time_ms != events[i].time_ms
+                                                    )
+            {
+                wrong++;
+            }
+        }
+    }
+
+    /***************** 2. Check ***************************/
+    if ( got < line->expect_num )
+    {
+        wrong += line->expect_num - got;
+    }
+    printf( "# %s,%u events,%u edges,%u irqs,%u wrong,%s\r\n",
+            line->name, (unsigned int)got, (unsigned int)line->edges,
+            (unsigned int)pin.irqs, (unsigned int)wrong,
+            ( 0U == wrong && line->edges == pin.irqs ) ?
+            "ok" : "MISMATCH" );
+}
+
+/**
+ * @brief: Add a debounced edge and its bounce to a wave
+ *
+ * @param[in]  wave:  the wave
+ * @param[in]  num:   edges in the wave, updated
+ * @param[in]  t_ms:  the edge
+ * @param[in]  level: after the edge
+ *
+ * @return uint32_t: toggles of the bounce
+ **/
+static uint32_t __bounce ( bench_key_edge_t * const wave,
+                           uint32_t         * const num,
+                           uint32_t                 t_ms,
+                           uint8_t                  level )
+{
+    // pairs of toggles, one in each BENCH_KEY_BOUNCE_STEP of the window
+    uint32_t toggles = 2U * ( __rand() % ( BENCH_KEY_BOUNCE_MAX / 2U + 1U ) );
+
+    wave[*num].t_ms  = t_ms;
+    wave[*num].level = level;
+    (*num)++;
+    for ( uint32_t j = 0; j < toggles; ++j )
+    {
+        wave[*num].t_ms  = t_ms + j * BENCH_KEY_BOUNCE_STEP + 1U +
+                           __rand() % BENCH_KEY_BOUNCE_STEP;
+        wave[*num].level = ( 0U == j % 2U ) ? (uint8_t)( 1U - level ) : level;
+        (*num)++;
+    }
+    return toggles;
+}
+
+/**
+ * @brief: Replay the bounced key and its twin side by side, compare the
+ *         events of every millisecond
+ *
+ * @param[in]  a:      the bounced pin
+ * @param[in]  wave_a: its edges
+ * @param[in]  num_a:  edges of wave_a
+ * @param[in]  b:      the twin
+ * @param[in]  wave_b: its edges
+ * @param[in]  num_b:  edges of wave_b
+ * @param[in]  base:   time of the line start
+ * @param[in]  from:   first millisecond, from the line start
+ * @param[in]  to:     end millisecond, excluded
+ * @param[in]  r:      result of the line
+ **/
+static void __replay ( bench_key_pin_t        * const a,
+                       const bench_key_edge_t * const wave_a,
+                       uint32_t                       num_a,
+                       bench_key_pin_t        * const b,
+                       const bench_key_edge_t * const wave_b,
+                       uint32_t                       num_b,
+                       uint32_t                       base,
+                       uint32_t                       from,
+                       uint32_t                       to,
+                       bench_key_result_t     * const r )
+{
+    key_event_t ev_a[BENCH_KEY_EVT_MAX];
+    key_event_t ev_b[BENCH_KEY_EVT_MAX];
+    uint32_t    n_a;
+    uint32_t    n_b;
+    uint32_t    same;
+
+    for ( uint32_t t = from; t < to; ++t )
+    {
+        __pin_apply( a, wave_a, num_a, t );
+        __pin_apply( b, wave_b, num_b, t );
+        __pin_step( a, base + t, 1U, ev_a, &n_a );
+        __pin_step( b, base + t, 0U, ev_b, &n_b );
+
+        same = ( n_a == n_b ) ? 1U : 0U;
+        for ( uint32_t i = 0; i < n_a && 0U != same; ++i )
+        {
+            same = ( ev_a[i].key_id  == ev_b[i].key_id  &&
+                     ev_a[i].type    == ev_b[i].type    &&
+                     ev_a[i].count   == ev_b[i].count   &&
+                     ev_a[i].time_ms == ev_b[i].time_ms    ) ? 1U : 0U;
+        }
+        r->diffs += ( 0U == same ) ? 1U : 0U;
+        for ( uint32_t i = 0; i < n_a; ++i )
+        {
+            r->seen |= KEY_EVT_BIT( ev_a[i].type );
+        }
+        r->events += n_a;
+    }
+}
+
+/**
+ * @brief: Run and print the random line
+ * @steps:
+ *      1. Both keys through their first pass
+ *      2. Random gestures around the double-click and long press times,
+ *         bounced on one key and clean on the twin
+ *      3. Let the last gesture time out, check and print
+ **/
+static void __random_run ( void )
+{
+    bench_key_result_t r    = {0};
+    bench_key_pin_t    a;
+    bench_key_pin_t    b;
+    bench_key_edge_t   wave_a[BENCH_KEY_WAVE_MAX];
+    bench_key_edge_t   wave_b[2];
+    uint32_t           num_a;
+    uint32_t           base = 0U - BENCH_KEY_WRAP_LEAD_MS;
+    uint32_t           t    = 1U;
+    uint32_t           t_release;
+    uint32_t           t_next;
+    uint32_t           ok;
+
+    /***************** 1. First pass **********************/
+    ok = __pin_init( &a ) & __pin_init( &b );
+    __replay( &a, NULL, 0U, &b, NULL, 0U, base, 0U, t, &r );
+
+    /***************** 2. Gestures ************************/
+    for ( r.gestures = 0; r.gestures < s_iterations; ++r.gestures )
+    {
+        switch ( __rand() % 3U )
+        {
+        case 0U:
+            t_release = t + KEY_DEBOUNCE_MS + 1U + __rand() % 200U;
+            break;
+        case 1U:
+            t_release = t + KEY_LONG_PRESS_MS - 40U + __rand() % 80U;
+            break;
+        default:
+            t_release = t + KEY_LONG_PRESS_MS + __rand() % 600U;
+            break;
+        }
+        t_next = t_release + ( ( 0U == __rand() % 2U ) ?
+                 KEY_DEBOUNCE_MS + 1U +
+                 __rand() % ( KEY_DOUBLE_CLICK_MS + 40U - KEY_DEBOUNCE_MS ) :
+                 KEY_DOUBLE_CLICK_MS + __rand() % 600U );
+
+        num_a      = 0U;
+        r.bounces += __bounce( wave_a, &num_a, t, 1U );
+        r.bounces += __bounce( wave_a, &num_a, t_release, 0U );
+        wave_b[0].t_ms  = t;
+        wave_b[0].level = 1U;
+        wave_b[1].t_ms  = t_release;
+        wave_b[1].level = 0U;
+        a.next = 0U;
+        b.next = 0U;
+        __replay( &a, wave_a, num_a, &b, wave_b, 2U, base, t, t_next, &r );
+        t = t_next;
+    }
+
+    /***************** 3. Check ***************************/
+    __replay( &a, NULL, 0U, &b, NULL, 0U, base, t, t + BENCH_KEY_TAIL_MS,
+              &r );
+    if ( 0U != r.diffs                   ||
+         2U * r.gestures != a.irqs       ||
+         2U * r.gestures != b.irqs       ||
+         BENCH_KEY_ALL_EVENTS != r.seen
+                                           )
+    {
+        ok = 0U;
+    }
+    printf( "# random,%u gestures,%u events,%u edges,%u irqs,%u bounces,"
+            "%u diffs,%s\r\n",
+            (unsigned int)r.gestures, (unsigned int)r.events,
+            (unsigned int)( 2U * r.gestures ), (unsigned int)a.irqs,
+            (unsigned int)r.bounces, (unsigned int)r.diffs,
+            ( 0U != ok ) ? "ok" : "MISMATCH" );
+}
+
+/**
+ * @brief: Runner task, runs every line and deletes itself
+ *
+ * @param[in]  argument: Not used
+ **/
+static void bench_key_task ( void * argument )
+{
+    (void)argument;
+
+    bench_csv_header( BENCH_KEY_SUITE );
+    for ( uint32_t i = 0; i < sizeof( s_lines ) / sizeof( s_lines[0] ); ++i )
+    {
+        __line( &s_lines[i] );
+    }
+    bench_stat_reset( &s_stat[0] );
+    bench_stat_reset( &s_stat[1] );
+    __random_run();
+    bench_csv_row( BENCH_KEY_SUITE, "cpu", "process", &s_stat[0] );
+    bench_csv_row( BENCH_KEY_SUITE, "cpu", "deadline", &s_stat[1] );
+
+    vTaskDelete( NULL );
+}
+
+/**
+ * @brief: Start the key suite
+ * @steps:
+ *      1. Start the timestamp source
+ *      2. Create the runner task, it prints the CSV report and deletes itself
+ *
+ * @param[in]  iterations: gestures of the random line, 0 means default
+ *
+ * @return bench_status_t: execute result of this function
+ **/
+bench_status_t bench_key_start ( uint32_t iterations )
+{
+    bench_status_t ret = BENCH_OK;
+
+    /************** 1. Start the timestamp source *************/
+    ret = bench_timestamp_init();
+    if ( BENCH_OK != ret )
+    {
+        LOG( LOG_LEVEL_ERR, "Bench timestamp init failed" );
+        return ret;
+    }
+    s_iterations = ( 0U == iterations ) ? BENCH_KEY_ITERATIONS : iterations;
+
+    /***************** 2. Create the runner ******************/
+    if ( pdPASS != xTaskCreate( bench_key_task,
+                                "bench_key",
+                                BENCH_KEY_STACK_WORDS,
+                                NULL,
+                                tskIDLE_PRIORITY + 1,
+                                NULL                   ) )
+    {
+        LOG( LOG_LEVEL_ERR, "Bench runner create failed" );
+        return BENCH_ERRORNOMEMORY;
+    }
+    return ret;
+}
+
+//******************************** Defines **********************************//
@@ -0,0 +1,548 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_bench_kv.c
+ *
+ * @par dependencies
+ * - bsp_bench_kv.h
+ * - bsp_kv.h
+ *
+ * @author Damian
+ *
+ * @brief Check the flash key/value store against a simulated flash with
+ *        power loss injected at every flash operation, and measure get,
+ *        set, mount and compaction.
+ *
+ * Processing flow:
+ *
+ * Call directly.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+//******************************** Includes *********************************//
+
+#include "bsp_bench_kv.h"
+#include "bsp_kv.h"
+#include "bsp_common.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include <string.h>
+
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+#define BENCH_KV_SUITE            "kv"
+#define BENCH_KV_SECTOR_WORDS     ( BENCH_KV_SECTOR_BYTES / 4U )
+#define BENCH_KV_CUT_SECTOR       1024U  /* small sectors: many compactions  */
+#define BENCH_KV_KEYS             16U    /* keys of the workload             */
+#define BENCH_KV_MAX_LEN          24U    /* longest value of the workload    */
+#define BENCH_KV_WORKLOAD         200U   /* sets and deletes per cut run     */
+#define BENCH_KV_WEAR_SETS        100000U
+#define BENCH_KV_NEVER            0xFFFFFFFFU
+
+typedef struct
+{
+    uint32_t              len;                    /* 0: absent               */
+    uint8_t               value[BENCH_KV_MAX_LEN];
+} bench_kv_value_t;
+
+static uint32_t         s_iterations = BENCH_KV_ITERATIONS;
+
+// simulated flash
+static uint32_t         s_flash[KV_SECTOR_NUM][BENCH_KV_SECTOR_WORDS];
+static uint32_t         s_sector_words;
+static uint32_t         s_ops;                    /* erases + words so far   */
+static uint32_t         s_cut_at;                 /* lose power at this op   */
+static uint32_t         s_power_lost;
+static uint32_t         s_overwrites;             /* words programmed twice  */
+static uint32_t         s_erases[KV_SECTOR_NUM];
+static uint32_t         s_torn;                   /* skipped by the mounts   */
+static uint32_t         s_rand = 0x12345678U;
+
+static bsp_kv_store_t   s_store;
+static bench_kv_value_t s_model[BENCH_KV_KEYS];
+
+/**
+ * @brief: xorshift32, the same sequence on target and host
+ *
+ * @return uint32_t: next pseudo random number
+ **/
+static uint32_t __rand ( void )
+{
+    s_rand ^= s_rand << 13;
+    s_rand ^= s_rand >> 17;
+    s_rand ^= s_rand << 5;
+    return s_rand;
+}
+
+/**
+ * @brief: Count a flash operation, cut the power when its turn has come
+ *
+ * @return uint32_t: 1 when the power goes now
+ **/
+static uint32_t __sim_cut ( void )
+{
+    s_ops++;
+    if ( s_ops == s_cut_at )
+    {
+        s_power_lost = 1U;
+        return 1U;
+    }
+    return 0U;
+}
+
+static kv_status_t __sim_erase ( uint32_t sector )
+{
+    uint32_t words;
+
+    if ( 0U != s_power_lost || KV_SECTOR_NUM <= sector )
+    {
+        return KV_ERROR;
+    }
+    s_erases[sector]++;
+    words = s_sector_words;
+    if ( 0U != __sim_cut() )
+    {
+        words = __rand() % s_sector_words;
+    }
+    memset( s_flash[sector], 0xFF, words * 4U );
+    return ( 0U != s_power_lost ) ? KV_ERROR : KV_OK;
+}
+
+static kv_status_t __sim_program ( uint32_t       * const dst,
+                                   const uint32_t * const src,
+                                   uint32_t               words )
+{
+    for ( uint32_t i = 0; i < words; ++i )
+    {
+        if ( 0U != s_power_lost )
+        {
+            return KV_ERROR;
+        }
+        if ( src[i] != ( dst[i] & src[i] ) )
+        {
+            s_overwrites++;
+        }
+        // torn: only some of the bits to clear are cleared
+        dst[i] &= ( 0U != __sim_cut() ) ? ( src[i] | __rand() ) : src[i];
+    }
+    return ( 0U != s_power_lost ) ? KV_ERROR : KV_OK;
+}
+
+static bsp_status_t __sim_mutex_create ( void ** const mutex_handler )
+{
+    *mutex_handler = &s_store;
+    return BSP_OK;
+}
+
+static bsp_status_t __sim_mutex_lock ( void * const mutex_handler,
+                                       uint32_t     timeout        )
+{
+    (void)mutex_handler;
+    (void)timeout;
+    return BSP_OK;
+}
+
+static bsp_status_t __sim_mutex_unlock ( void * const mutex_handler )
+{
+    (void)mutex_handler;
+    return BSP_OK;
+}
+
+static kv_flash_operation_t s_sim_flash =
+{
+    .pf_flash_erase   = __sim_erase,
+    .pf_flash_program = __sim_program,
+};
+
+static os_mutex_t s_sim_mutex =
+{
+    .pf_os_mutex_create = __sim_mutex_create,
+    .pf_os_mutex_lock   = __sim_mutex_lock,
+    .pf_os_mutex_unlock = __sim_mutex_unlock,
+};
+
+/**
+ * @brief: Blank simulated flash of sectors of the given size
+ *
+ * @param[in]  sector_words: words of a sector
+ **/
+static void __flash_blank ( uint32_t sector_words )
+{
+    memset( s_flash, 0xFF, sizeof( s_flash ) );
+    s_sector_words = sector_words;
+    s_ops          = 0U;
+    s_cut_at       = BENCH_KV_NEVER;
+    s_power_lost   = 0U;
+    s_overwrites   = 0U;
+    memset( s_erases, 0, sizeof( s_erases ) );
+}
+
+/**
+ * @brief: Boot: a fresh instance mounted on the simulated flash
+ *
+ * @return kv_status_t: execute result of kv_store_mount
+ **/
+static kv_status_t __reboot ( void )
+{
+    s_power_lost          = 0U;
+    s_cut_at              = BENCH_KV_NEVER;
+    s_store.is_initialized = KV_STORE_NOT_INITED;
+    if ( KV_OK != kv_store_inst( &s_store, &s_sim_flash, &s_sim_mutex,
+                                 s_flash[0], s_flash[1],
+                                 s_sector_words * 4U                  ) )
+    {
+        return KV_ERROR;
+    }
+    return kv_store_mount( &s_store );
+}
+
+/**
+ * @brief: Next value of the workload, sometimes a delete (len 0)
+ *
+ * @param[out] value: the value
+ **/
+static void __value_next ( bench_kv_value_t * const value )
+{
+    value->len = ( 0U == __rand() % 8U ) ? 0U :
+                 1U + __rand() % BENCH_KV_MAX_LEN;
+    for ( uint32_t i = 0; i < value->len; ++i )
+    {
+        value->value[i] = (uint8_t)__rand();
+    }
+}
+
+/**
+ * @brief: Write a value of the workload into the store
+ *
+ * @param[in]  key:   the key
+ * @param[in]  value: the value, len 0 deletes
+ *
+ * @return kv_status_t: execute result of kv_set / kv_delete
+ **/
+static kv_status_t __value_write ( uint32_t                       key,
+                                   const bench_kv_value_t * const value )
+{
+    return ( 0U == value->len ) ?
+           kv_delete( &s_store, key ) :
+           kv_set( &s_store, key, value->value, value->len );
+}
+
+/**
+ * @brief: Compare the store with a value
+ *
+ * @param[in]  key:   the key
+ * @param[in]  value: expected value, len 0 expects the key absent
+ *
+ * @return uint32_t: 1 when they match
+ **/
+static uint32_t __value_match ( uint32_t                       key,
+                                const bench_kv_value_t * const value )
+{
+    uint8_t     buf[BENCH_KV_MAX_LEN];
+    uint32_t    len = 0U;
+    kv_status_t ret = kv_get( &s_store, key, buf, sizeof( buf ), &len );
+
+    if ( 0U == value->len )
+    {
+        return ( KV_ERRORSOURCE == ret ) ? 1U : 0U;
+    }
+    return ( KV_OK == ret && value->len == len &&
+             0 == memcmp( buf, value->value, len ) ) ? 1U : 0U;
+}
+
+/**
+ * @brief: Set, get, delete, an unchanged value, and all of it after a
+ *         remount
+ **/
+static void __basic_check ( void )
+{
+    bench_kv_value_t value = { 4U, { 1U, 2U, 3U, 4U } };
+    bench_kv_value_t none  = { 0U, { 0U } };
+    uint32_t         ok    = 1U;
+    uint32_t         writes;
+
+    __flash_blank( BENCH_KV_SECTOR_WORDS );
+    ok &= ( KV_OK == __reboot() ) ? 1U : 0U;
+    ok &= ( KV_OK == __value_write( 1U, &value ) ) ? 1U : 0U;
+    writes = s_store.writes;
+    ok &= ( KV_OK == __value_write( 1U, &value ) &&
+            writes == s_store.writes ) ? 1U : 0U;
+    ok &= __value_match( 1U, &value ) & __value_match( 2U, &none );
+    value.value[0] = 9U;
+    ok &= ( KV_OK == __value_write( 2U, &value ) &&
+            KV_OK == kv_delete( &s_store, 1U )    &&
+            KV_OK == kv_store_compact( &s_store ) ) ? 1U : 0U;
+    ok &= ( KV_OK == __reboot() ) ? 1U : 0U;
+    ok &= __value_match( 1U, &none ) & __value_match( 2U, &value );
+    ok &= ( KV_ERRORPARAMETER == kv_set( &s_store, KV_MAX_KEYS,
+                                         value.value, 1U )    &&
+            KV_ERRORPARAMETER == kv_set( &s_store, 0U, value.value,
+                                         KV_MAX_VALUE_LEN + 1U ) ) ? 1U : 0U;
+    printf( "# basic,generation %u,%s\r\n",
+            (unsigned int)s_store.generation, ( 0U != ok ) ? "ok" : "MISMATCH" );
+}
+
+/**
+ * @brief: Run the workload, the power goes at flash operation cut_at
+ * @steps:
+ *      1. Blank flash, mount, run the workload until the power goes
+ *      2. Reboot, every key holds its old value or, for the key being
+ *         written, the new one
+ *      3. Write every key once more, reboot, check again
+ *
+ * @param[in]  cut_at: flash operation losing the power, BENCH_KV_NEVER for
+ *                     a run counting them
+ *
+ * @return uint32_t: 1 when the store came back right
+ **/
+static uint32_t __cut_run ( uint32_t cut_at )
+{
+    bench_kv_value_t next;
+    uint32_t         key = BENCH_KV_NEVER;
+    uint32_t         ok  = 1U;
+
+    /***************** 1. Workload ************************/
+    __flash_blank( BENCH_KV_CUT_SECTOR / 4U );
+    memset( s_model, 0, sizeof( s_model ) );
+    s_rand = 0x12345678U;
+    if ( KV_OK != __reboot() )
+    {
+        return 0U;
+    }
+    s_ops    = 0U;
+    s_cut_at = cut_at;
+    for ( uint32_t i = 0; i < BENCH_KV_WORKLOAD; ++i )
+    {
+        key = __rand() % BENCH_KV_KEYS;
+        __value_next( &next );
+        if ( KV_OK == __value_write( key, &next ) )
+        {
+            s_model[key] = next;
+        }
+        else if ( 0U == s_power_lost )
+        {
+            ok = 0U;
+        }
+        else
+        {
+            break;
+        }
+    }
+
+    /***************** 2. Reboot, check *******************/
+    ok &= ( KV_OK == __reboot() ) ? 1U : 0U;
+    s_torn += s_store.torn;
+    for ( uint32_t k = 0; k < BENCH_KV_KEYS && 0U != ok; ++k )
+    {
+        if ( k == key && 0U == __value_match( k, &s_model[k] ) &&
+             0U != __value_match( k, &next ) )
+        {
+            s_model[k] = next;                    /* the cut one made it */
+        }
+        ok &= __value_match( k, &s_model[k] );
+    }
+
+    /***************** 3. Still usable ********************/
+    for ( uint32_t k = 0; k < BENCH_KV_KEYS && 0U != ok; ++k )
+    {
+        __value_next( &s_model[k] );
+        ok &= ( KV_OK == __value_write( k, &s_model[k] ) ) ? 1U : 0U;
+    }
+    ok &= ( KV_OK == __reboot() ) ? 1U : 0U;
+    for ( uint32_t k = 0; k < BENCH_KV_KEYS && 0U != ok; ++k )
+    {
+        ok &= __value_match( k, &s_model[k] );
+    }
+    return ( 0U != ok && 0U == s_overwrites ) ? 1U : 0U;
+}
+
+/**
+ * @brief: Cut the power at every flash operation of the workload
+ **/
+static void __power_loss_check ( void )
+{
+    uint32_t ops;
+    uint32_t failed = 0U;
+    uint32_t first  = BENCH_KV_NEVER;
+
+    // a run without cut counts the flash operations of the workload
+    __cut_run( BENCH_KV_NEVER );
+    ops    = s_ops;
+    s_torn = 0U;
+    for ( uint32_t cut = 1U; cut <= ops; ++cut )
+    {
+        if ( 0U == __cut_run( cut ) )
+        {
+            failed++;
+            first = ( BENCH_KV_NEVER == first ) ? cut : first;
+        }
+    }
+    if ( 0U == failed )
+    {
+        printf( "# power_loss,cuts %u,torn seen %u,ok\r\n",
+                (unsigned int)ops, (unsigned int)s_torn );
+        return;
+    }
+    printf( "# power_loss,cuts %u,failed %u,first at %u,MISMATCH\r\n",
+            (unsigned int)ops, (unsigned int)failed, (unsigned int)first );
+}
+
+/**
+ * @brief: Many sets of a few keys, count the erases of each sector
+ **/
+static void __wear_check ( void )
+{
+    uint32_t value;
+    uint32_t ok;
+    uint32_t diff;
+
+    __flash_blank( BENCH_KV_SECTOR_WORDS );
+    __reboot();
+    for ( uint32_t i = 0; i < BENCH_KV_WEAR_SETS; ++i )
+    {
+        value = i;
+        kv_set( &s_store, i % BENCH_KV_KEYS, &value, sizeof( value ) );
+    }
+    diff = ( s_erases[0] > s_erases[1] ) ? s_erases[0] - s_erases[1] :
+                                           s_erases[1] - s_erases[0];
+    ok   = ( 1U >= diff && 0U == s_overwrites ) ? 1U : 0U;
+    printf( "# wear,sets %u,records per erase %u,erases %u+%u,%s\r\n",
+            (unsigned int)BENCH_KV_WEAR_SETS,
+            (unsigned int)( s_store.writes /
+                            ( s_erases[0] + s_erases[1] ) ),
+            (unsigned int)s_erases[0], (unsigned int)s_erases[1],
+            ( 0U != ok ) ? "ok" : "MISMATCH" );
+}
+
+/**
+ * @brief: Time get, set, a mount of a full sector and a compaction
+ **/
+static void __cost_run ( void )
+{
+    bench_stat_t stat;
+    uint32_t     value = 0U;
+    uint32_t     t0;
+
+    __flash_blank( BENCH_KV_SECTOR_WORDS );
+    __reboot();
+    for ( uint32_t k = 0; k < BENCH_KV_KEYS; ++k )
+    {
+        kv_set( &s_store, k, &value, sizeof( value ) );
+    }
+
+    bench_stat_reset( &stat );
+    for ( uint32_t i = 0; i < s_iterations; ++i )
+    {
+        t0 = bench_timestamp_get();
+        kv_get( &s_store, i % BENCH_KV_KEYS, &value, sizeof( value ), NULL );
+        bench_stat_add( &stat, bench_timestamp_get() - t0 );
+    }
+    bench_csv_row( BENCH_KV_SUITE, "get", "4B_value", &stat );
+
+    // the max includes the sets paying for a compaction
+    bench_stat_reset( &stat );
+    for ( uint32_t i = 0; i < s_iterations; ++i )
+    {
+        value = i + 1U;
+        t0    = bench_timestamp_get();
+        kv_set( &s_store, i % BENCH_KV_KEYS, &value, sizeof( value ) );
+        bench_stat_add( &stat, bench_timestamp_get() - t0 );
+    }
+    bench_csv_row( BENCH_KV_SUITE, "set", "4B_value", &stat );
+
+    // fill the sector up to the last record before a compaction
+    while ( s_store.tail + 3U <= s_store.sector_words )
+    {
+        value++;
+        kv_set( &s_store, value % BENCH_KV_KEYS, &value, sizeof( value ) );
+    }
+    bench_stat_reset( &stat );
+    for ( uint32_t i = 0; i < s_iterations; ++i )
+    {
+        s_store.is_initialized = KV_STORE_NOT_INITED;
+        kv_store_inst( &s_store, &s_sim_flash, &s_sim_mutex, s_flash[0],
+                       s_flash[1], s_sector_words * 4U                 );
+        t0 = bench_timestamp_get();
+        kv_store_mount( &s_store );
+        bench_stat_add( &stat, bench_timestamp_get() - t0 );
+    }
+    bench_csv_row( BENCH_KV_SUITE, "mount", "full_sector", &stat );
+    printf( "# mount,%u records,%u bytes\r\n",
+            (unsigned int)s_store.scan_records,
+            (unsigned int)BENCH_KV_SECTOR_BYTES );
+
+    // the simulated erase is a memset, the real one takes far longer
+    bench_stat_reset( &stat );
+    for ( uint32_t i = 0; i < s_iterations / 10U + 1U; ++i )
+    {
+        t0 = bench_timestamp_get();
+        kv_store_compact( &s_store );
+        bench_stat_add( &stat, bench_timestamp_get() - t0 );
+    }
+    bench_csv_row( BENCH_KV_SUITE, "compact", "16_keys", &stat );
+}
+
+/**
+ * @brief: Runner task, runs every check and deletes itself
+ *
+ * @param[in]  argument: Not used
+ **/
+static void bench_kv_task ( void * argument )
+{
+    (void)argument;
+
+    bench_csv_header( BENCH_KV_SUITE );
+    __basic_check();
+    __power_loss_check();
+    __wear_check();
+    __cost_run();
+
+    vTaskDelete( NULL );
+}
+
+/**
+ * @brief: Start the key/value store suite
+ * @steps:
+ *      1. Start the timestamp source
+ *      2. Create the runner task, it prints the CSV report and deletes itself
+ *
+ * @param[in]  iterations: gets, sets and mounts timed, 0 means default
+ *
+ * @return bench_status_t: execute result of this function
+ **/
+bench_status_t bench_kv_start ( uint32_t iterations )
+{
+    bench_status_t ret = BENCH_OK;
+
+    /************** 1. Start the timestamp source *************/
+    ret = bench_timestamp_init();
+    if ( BENCH_OK != ret )
+    {
+        LOG( LOG_LEVEL_ERR, "Bench timestamp init failed" );
+        return ret;
+    }
+    s_iterations = ( 0U == iterations ) ? BENCH_KV_ITERATIONS : iterations;
+
+    /***************** 2. Create the runner ******************/
+    if ( pdPASS != xTaskCreate( bench_kv_task,
+                                "bench_kv",
+                                BENCH_KV_STACK_WORDS,
+                                NULL,
+                                tskIDLE_PRIORITY + 1,
+                                NULL                 ) )
+    {
+        LOG( LOG_LEVEL_ERR, "Bench runner create failed" );
+        return BENCH_ERRORNOMEMORY;
+    }
+    return ret;
+}
+
+//******************************** Defines **********************************//
@@ -0,0 +1,548 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_bench_latency.c
+ *
+ * @par dependencies
+ * - bsp_bench_latency.h
+ * - FreeRTOS.h
+ *
+ * @author Damian
+ *
+ * @brief Measure how long it takes for a FreeRTOS primitive to wake a task,
+ *        both from another task and from an ISR.
+ *
+ * Processing flow:
+ *
+ * Call directly.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+//******************************** Includes *********************************//
+
+#include "bsp_bench_latency.h"
+#include "bsp_common.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+#include "event_groups.h"
+#include "stream_buffer.h"
+#include "cmsis_os2.h"
+#include "bsp_signal.h"
+
+#ifndef BENCH_HOST_POSIX
+#include "main.h"
+#endif /* BENCH_HOST_POSIX */
+
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+#define BENCH_LATENCY_SUITE        "latency"
+#define BENCH_LATENCY_QUEUE_LEN    4U          /* items of the bench queue   */
+#define BENCH_LATENCY_STREAM_LEN   16U         /* bytes of the stream buffer */
+#define BENCH_LATENCY_EVT_BIT      ( 1UL << 0 )/* bit set in the event group */
+#define BENCH_LATENCY_TIMEOUT_MS   100U        /* max wait for one sample    */
+
+typedef struct
+{
+    const char     * name;                          /* CSV case name         */
+    bench_status_t ( *pf_create )   ( void );       /* create the object     */
+    void           ( *pf_delete )   ( void );       /* delete the object     */
+    void           ( *pf_give )     ( void );       /* wake from task        */
+    void           ( *pf_give_isr ) ( BaseType_t * const woken );
+                                                    /* wake from ISR         */
+    void           ( *pf_take )     ( void );       /* block in the receiver */
+} bench_latency_case_t;
+
+static SemaphoreHandle_t      s_sem       = NULL;
+static QueueHandle_t          s_queue     = NULL;
+static EventGroupHandle_t     s_evt       = NULL;
+static StreamBufferHandle_t   s_stream    = NULL;
+static osEventFlagsId_t       s_os2_flags = NULL;
+static bsp_signal_t           s_signal;
+static TaskHandle_t           s_receiver  = NULL;
+static uint32_t               s_iterations = BENCH_LATENCY_ITERATIONS;
+
+static volatile uint32_t      s_t0        = 0U;   /* give timestamp          */
+static volatile uint32_t      s_t1        = 0U;   /* wake timestamp          */
+static volatile uint32_t      s_done      = 0U;   /* receiver woke up        */
+static const bench_latency_case_t * volatile s_isr_case = NULL;
+
+//************************ Semaphore give -> take ***************************//
+
+static bench_status_t sem_create ( void )
+{
+    s_sem = xSemaphoreCreateBinary();
+    return ( NULL == s_sem ) ? BENCH_ERRORNOMEMORY : BENCH_OK;
+}
+
+static void sem_delete ( void )
+{
+    vSemaphoreDelete( s_sem );
+    s_sem = NULL;
+}
+
+static void sem_give ( void )
+{
+    xSemaphoreGive( s_sem );
+}
+
+static void sem_give_isr ( BaseType_t * const woken )
+{
+    xSemaphoreGiveFromISR( s_sem, woken );
+}
+
+static void sem_take ( void )
+{
+    xSemaphoreTake( s_sem, portMAX_DELAY );
+}
+
+//************************* Queue send -> receive ***************************//
+
+static bench_status_t queue_create ( void )
+{
+    s_queue = xQueueCreate( BENCH_LATENCY_QUEUE_LEN, sizeof( uint32_t ) );
+    return ( NULL == s_queue ) ? BENCH_ERRORNOMEMORY : BENCH_OK;
+}
+
+static void queue_delete ( void )
+{
+    vQueueDelete( s_queue );
+    s_queue = NULL;
+}
+
+static void queue_give ( void )
+{
+    uint32_t item = 0xA5A5A5A5U;
+
+    xQueueSend( s_queue, &item, 0 );
+}
+
+static void queue_give_isr ( BaseType_t * const woken )
+{
+    uint32_t item = 0xA5A5A5A5U;
+
+    xQueueSendFromISR( s_queue, &item, woken );
+}
+
+static void queue_take ( void )
+{
+    uint32_t item;
+
+    xQueueReceive( s_queue, &item, portMAX_DELAY );
+}
+
+//************************** Task notification ******************************//
+
+static bench_status_t notify_create ( void )
+{
+    return BENCH_OK;
+}
+
+static void notify_delete ( void )
+{
+}
+
+static void notify_give ( void )
+{
+    xTaskNotifyGive( s_receiver );
+}
+
+static void notify_give_isr ( BaseType_t * const woken )
+{
+    vTaskNotifyGiveFromISR( s_receiver, woken );
+}
+
+static void notify_take ( void )
+{
+    ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+}
+
+//***************************** Event group *********************************//
+
+static bench_status_t evt_create ( void )
+{
+    s_evt = xEventGroupCreate();
+    return ( NULL == s_evt ) ? BENCH_ERRORNOMEMORY : BENCH_OK;
+}
+
+static void evt_delete ( void )
+{
+    vEventGroupDelete( s_evt );
+    s_evt = NULL;
+}
+
+static void evt_give ( void )
+{
+    xEventGroupSetBits( s_evt, BENCH_LATENCY_EVT_BIT );
+}
+
+static void evt_give_isr ( BaseType_t * const woken )
+{
+    /* Deferred to the timer daemon by FreeRTOS, the sample includes it */
+    xEventGroupSetBitsFromISR( s_evt, BENCH_LATENCY_EVT_BIT, woken );
+}
+
+static void evt_take ( void )
+{
+    xEventGroupWaitBits( s_evt, BENCH_LATENCY_EVT_BIT,
+                         pdTRUE, pdFALSE, portMAX_DELAY );
+}
+
+//**************************** Stream buffer ********************************//
+
+static bench_status_t stream_create ( void )
+{
+    s_stream = xStreamBufferCreate( BENCH_LATENCY_STREAM_LEN, 1 );
+    return ( NULL == s_stream ) ? BENCH_ERRORNOMEMORY : BENCH_OK;
+}
+
+static void stream_delete ( void )
+{
+    vStreamBufferDelete( s_stream );
+    s_stream = NULL;
+}
+
+static void stream_give ( void )
+{
+    uint32_t item = 0xA5A5A5A5U;
+
+    xStreamBufferSend( s_stream, &item, sizeof( item ), 0 );
+}
+
+static void stream_give_isr ( BaseType_t * const woken )
+{
+    uint32_t item = 0xA5A5A5A5U;
+
+    xStreamBufferSendFromISR( s_stream, &item, sizeof( item ), woken );
+}
+
+static void stream_take ( void )
+{
+    uint32_t item;
+
+    xStreamBufferReceive( s_stream, &item, sizeof( item ), portMAX_DELAY );
+}
+
+//************************ CMSIS-RTOS2 event flags **************************//
+
+static bench_status_t os2_flags_create ( void )
+{
+    s_os2_flags = osEventFlagsNew( NULL );
+    return ( NULL == s_os2_flags ) ? BENCH_ERRORNOMEMORY : BENCH_OK;
+}
+
+static void os2_flags_delete ( void )
+{
+    osEventFlagsDelete( s_os2_flags );
+    s_os2_flags = NULL;
+}
+
+static void os2_flags_give ( void )
+{
+    osEventFlagsSet( s_os2_flags, BENCH_LATENCY_EVT_BIT );
+}
+
+static void os2_flags_give_isr ( BaseType_t * const woken )
+{
+    /* osEventFlagsSet detects the ISR context and yields by itself */
+    (void)woken;
+    osEventFlagsSet( s_os2_flags, BENCH_LATENCY_EVT_BIT );
+}
+
+static void os2_flags_take ( void )
+{
+    osEventFlagsWait( s_os2_flags, BENCH_LATENCY_EVT_BIT,
+                      osFlagsWaitAny, osWaitForever );
+}
+
+//***************************** BSP signal **********************************//
+
+static bench_status_t signal_create ( void )
+{
+    /* bound to the receiver on its first wait */
+    return ( SIGNAL_OK == signal_instantiate( &s_signal, NULL ) )
+           ? BENCH_OK : BENCH_ERROR;
+}
+
+static void signal_delete ( void )
+{
+    s_signal.owner = NULL;
+}
+
+static void signal_give ( void )
+{
+    signal_set( &s_signal, BENCH_LATENCY_EVT_BIT );
+}
+
+static void signal_give_isr ( BaseType_t * const woken )
+{
+    /* signal_set_isr yields by itself */
+    (void)woken;
+    signal_set_isr( &s_signal, BENCH_LATENCY_EVT_BIT );
+}
+
+static void signal_take ( void )
+{
+    uint32_t bits;
+
+    signal_wait( &s_signal, BENCH_LATENCY_EVT_BIT, SIGNAL_WAIT_FOREVER, &bits );
+}
+
+static const bench_latency_case_t s_cases[] =
+{
+    { "semaphore",    sem_create,    sem_delete,    sem_give,
+                      sem_give_isr,    sem_take    },
+    { "queue",        queue_create,  queue_delete,  queue_give,
+                      queue_give_isr,  queue_take  },
+    { "notification", notify_create, notify_delete, notify_give,
+                      notify_give_isr, notify_take },
+    { "event_group",  evt_create,    evt_delete,    evt_give,
+                      evt_give_isr,    evt_take    },
+    { "stream_buffer",stream_create, stream_delete, stream_give,
+                      stream_give_isr, stream_take },
+    { "os2_evt_flags",os2_flags_create, os2_flags_delete, os2_flags_give,
+                      os2_flags_give_isr, os2_flags_take },
+    { "bsp_signal",   signal_create, signal_delete, signal_give,
+                      signal_give_isr, signal_take },
+};
+
+//******************************** Defines **********************************//
+
+#ifndef BENCH_HOST_POSIX
+/**
+ * @brief: Software triggered ISR of the ISR-to-task cases
+ * @steps:
+ *      1. Take the give timestamp
+ *      2. Wake the receiver and yield if required
+ **/
+void BENCH_SWI_IRQHandler ( void )
+{
+    BaseType_t woken = pdFALSE;
+    const bench_latency_case_t * bench_case = s_isr_case;
+
+    if ( NULL == bench_case )
+    {
+        return;
+    }
+    s_t0 = bench_timestamp_get();
+    bench_case->pf_give_isr( &woken );
+    portYIELD_FROM_ISR( woken );
+}
+#endif /* BENCH_HOST_POSIX */
+
+/**
+ * @brief: Receiver task, wakes up on the primitive under test
+ *
+ * @param[in]  argument: Pointer to the bench_latency_case_t under test
+ **/
+static void bench_receiver_task ( void * argument )
+{
+    const bench_latency_case_t * bench_case = argument;
+
+    for ( ;; )
+    {
+        bench_case->pf_take();
+        s_t1   = bench_timestamp_get();
+        s_done = 1U;
+    }
+}
+
+/**
+ * @brief: Take one sample of a case
+ * @steps:
+ *      1. Wake the receiver from the runner task or from the SWI
+ *      2. Wait until the receiver reported its wake timestamp
+ *
+ * @param[in]  bench_case: case under test
+ * @param[in]  from_isr:   0 for task-to-task, 1 for ISR-to-task
+ * @param[out] delta:      measured latency in BENCH_TS_UNIT
+ *
+ * @return bench_status_t: execute result of this function
+ **/
+static bench_status_t bench_latency_sample (
+                               const bench_latency_case_t * const bench_case,
+                               uint32_t                           from_isr,
+                               uint32_t                   * const delta
+                                                                            )
+{
+    uint32_t waited_ms = 0U;
+
+    s_done = 0U;
+
+    /****************** 1. Wake the receiver ******************/
+    if ( 0U == from_isr )
+    {
+        s_t0 = bench_timestamp_get();
+        bench_case->pf_give();
+    }
+#ifndef BENCH_HOST_POSIX
+    else
+    {
+        s_isr_case = bench_case;
+        NVIC_SetPendingIRQ( BENCH_SWI_IRQn );
+    }
+#endif /* BENCH_HOST_POSIX */
+
+    /********** 2. Wait for the deferred wakeups ***********/
+    while ( 0U == s_done )
+    {
+        if ( waited_ms++ >= BENCH_LATENCY_TIMEOUT_MS )
+        {
+            return BENCH_ERRORTIMEOUT;
+        }
+        vTaskDelay( pdMS_TO_TICKS( 1 ) );
+    }
+
+    *delta = s_t1 - s_t0;
+    return BENCH_OK;
+}
+
+/**
+ * @brief: Run one case in one mode and print its CSV row
+ * @steps:
+ *      1. Create the object and the receiver
+ *      2. Drop a warm-up sample then collect the statistic
+ *      3. Delete the receiver and the object
+ *
+ * @param[in]  bench_case: case under test
+ * @param[in]  from_isr:   0 for task-to-task, 1 for ISR-to-task
+ **/
+static void bench_latency_run_case (
+                               const bench_latency_case_t * const bench_case,
+                               uint32_t                           from_isr
+                                                                            )
+{
+    bench_stat_t   stat;
+    uint32_t       delta = 0U;
+    bench_status_t ret;
+
+    bench_stat_reset( &stat );
+
+    /************** 1. Create the resources ***************/
+    if ( BENCH_OK != bench_case->pf_create() )
+    {
+        LOG( LOG_LEVEL_ERR, "Bench %s create failed", bench_case->name );
+        return;
+    }
+    if ( pdPASS != xTaskCreate( bench_receiver_task,
+                                "bench_rx",
+                                BENCH_LATENCY_STACK_WORDS,
+                                (void *)bench_case,
+                                configMAX_PRIORITIES - 1,
+                                &s_receiver                 ) )
+    {
+        LOG( LOG_LEVEL_ERR, "Bench receiver create failed" );
+        bench_case->pf_delete();
+        return;
+    }
+
+    /**************** 2. Collect the samples ***************/
+    ret = bench_latency_sample( bench_case, from_isr, &delta );
+    for ( uint32_t i = 0; ( i < s_iterations ) && ( BENCH_OK == ret ); ++i )
+    {
+        ret = bench_latency_sample( bench_case, from_isr, &delta );
+        if ( BENCH_OK == ret )
+        {
+            bench_stat_add( &stat, delta );
+        }
+    }
+    if ( BENCH_OK != ret )
+    {
+        LOG( LOG_LEVEL_ERR, "Bench %s timeout", bench_case->name );
+    }
+
+    /************** 3. Release the resources **************/
+    s_isr_case = NULL;
+    vTaskDelete( s_receiver );
+    s_receiver = NULL;
+    bench_case->pf_delete();
+
+    bench_csv_row( BENCH_LATENCY_SUITE,
+                   ( 0U == from_isr ) ? "task2task" : "isr2task",
+                   bench_case->name,
+                   &stat                                        );
+
+    /* Let the idle task free the receiver's TCB and stack */
+    vTaskDelay( pdMS_TO_TICKS( 10 ) );
+}
+
+/**
+ * @brief: Runner task, runs all the cases and deletes itself
+ *
+ * @param[in]  argument: Not used
+ **/
+static void bench_runner_task ( void * argument )
+{
+    uint32_t case_num = sizeof( s_cases ) / sizeof( s_cases[0] );
+
+    (void)argument;
+
+#ifndef BENCH_HOST_POSIX
+    HAL_NVIC_SetPriority( BENCH_SWI_IRQn, BENCH_SWI_PRIORITY, 0U );
+    HAL_NVIC_EnableIRQ( BENCH_SWI_IRQn );
+#endif /* BENCH_HOST_POSIX */
+
+    bench_csv_header( BENCH_LATENCY_SUITE );
+    for ( uint32_t i = 0; i < case_num; ++i )
+    {
+        bench_latency_run_case( &s_cases[i], 0U );
+    }
+#ifndef BENCH_HOST_POSIX
+    for ( uint32_t i = 0; i < case_num; ++i )
+    {
+        bench_latency_run_case( &s_cases[i], 1U );
+    }
+    HAL_NVIC_DisableIRQ( BENCH_SWI_IRQn );
+#endif /* BENCH_HOST_POSIX */
+
+    vTaskDelete( NULL );
+}
+
+/**
+ * @brief: Start the latency suite
+ * @steps:
+ *      1. Start the timestamp source
+ *      2. Create the runner task, it prints the CSV report and deletes itself
+ *
+ * @param[in]  iterations: samples per primitive, 0 means default
+ *
+ * @return bench_status_t: execute result of this function
+ **/
+bench_status_t bench_latency_start ( uint32_t iterations )
+{
+    bench_status_t ret = BENCH_OK;
+
+    /************** 1. Start the timestamp source *************/
+    ret = bench_timestamp_init();
+    if ( BENCH_OK != ret )
+    {
+        LOG( LOG_LEVEL_ERR, "Bench timestamp init failed" );
+        return ret;
+    }
+    s_iterations = ( 0U == iterations ) ? BENCH_LATENCY_ITERATIONS
+                                        : iterations;
+
+    /***************** 2. Create the runner ******************/
+    if ( pdPASS != xTaskCreate( bench_runner_task,
+                                "bench_latency",
+                                BENCH_LATENCY_STACK_WORDS,
+                                NULL,
+                                tskIDLE_PRIORITY + 1,
+                                NULL                       ) )
+    {
+        LOG( LOG_LEVEL_ERR, "Bench runner create failed" );
+        return BENCH_ERRORNOMEMORY;
+    }
+    return ret;
+}
+
+//******************************** Defines **********************************//
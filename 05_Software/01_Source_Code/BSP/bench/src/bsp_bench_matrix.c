@@ -0,0 +1,857 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_bench_matrix.c
+ *
+ * @par dependencies
+ * - bsp_bench_matrix.h
+ * - bsp_matrix.h
+ * - bsp_led_handler.h
+ *
+ * @author Damian
+ *
+ * @brief Check the LED matrix scan engine against a mock slot timer and
+ *        shift chain: the slots at the clocks of the profiles, the bit
+ *        planes, the light of every pixel in every frame, frames of one
+ *        image while the images change, and measure the cost of a frame.
+ *
+ * Processing flow:
+ *
+ * Call directly.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+//******************************** Includes *********************************//
+
+#include "bsp_bench_matrix.h"
+#include "bsp_led_handler.h"
+#include "bsp_common.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include <string.h>
+
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+#define BENCH_MATRIX_SUITE        "matrix"
+#define BENCH_MATRIX_TICK_HZ      10000000U  /* TIM4 after its prescaler    */
+#define BENCH_MATRIX_PIXELS       ( MATRIX_MAX_ROWS * MATRIX_MAX_COLS )
+#define BENCH_MATRIX_IMAGES       16U        /* shown, not yet scanned      */
+#define BENCH_MATRIX_SIZES        6U
+#define BENCH_MATRIX_CLOCKS       6U
+#define BENCH_MATRIX_LED_X        3U
+#define BENCH_MATRIX_LED_Y        2U
+#define BENCH_MATRIX_LED_LEVEL    0xC0U
+
+typedef enum
+{
+    BENCH_MATRIX_SHOW    = 0,
+    BENCH_MATRIX_SLOT    = 1,
+    BENCH_MATRIX_COSTS   = 2,
+} bench_matrix_cost_t;
+
+typedef struct
+{
+    uint32_t              rows;
+    uint32_t              cols;
+    uint32_t              bits;
+    uint32_t              hz;                         /* refresh asked       */
+} bench_matrix_size_t;
+
+typedef struct
+{
+    //**************************** Timer ************************************//
+    uint32_t              hz;                         /* tick clock          */
+    uint32_t              running;
+    uint32_t              period;                     /* of the slot on      */
+    uint32_t              preload;                    /* of the next slot    */
+    uint32_t              starts;
+    uint32_t              stops;
+    uint32_t              bad;                        /* rules broken        */
+
+    //**************************** Shift chain ******************************//
+    uint32_t              shifted;                    /* 1: pattern waiting  */
+    uint32_t              s_row;
+    uint8_t               s_cols[MATRIX_COL_BYTES];
+    uint32_t              lit;                        /* 0: outputs blank    */
+    uint32_t              l_row;
+    uint8_t               l_cols[MATRIX_COL_BYTES];
+
+    //**************************** Eye **************************************//
+    uint32_t              rows;
+    uint32_t              cols;
+    uint32_t              bits;
+    uint32_t              slot;                       /* in the frame        */
+    uint32_t              ticks;                      /* of the frame        */
+    uint32_t              light[BENCH_MATRIX_PIXELS]; /* ticks lit           */
+    uint32_t              seen[BENCH_MATRIX_PIXELS];  /* of the last frame   */
+    uint32_t              frames;                     /* complete ones       */
+    uint32_t              torn;                       /* no whole image      */
+    uint32_t              frame_ticks;                /* of the last one     */
+    uint32_t              image;                      /* of the last one     */
+    uint32_t              shown;                      /* images shown        */
+    uint8_t               images[BENCH_MATRIX_IMAGES][BENCH_MATRIX_PIXELS];
+    uint32_t              bases[BENCH_MATRIX_IMAGES];
+} bench_matrix_mock_t;
+
+static const char * const s_cost_name[BENCH_MATRIX_COSTS] =
+{
+    "show", "slot",
+};
+
+static const bench_matrix_size_t s_sizes[BENCH_MATRIX_SIZES] =
+{
+    {  1U,  1U, 1U, 200U },
+    {  8U,  8U, 4U, 100U },
+    {  8U,  8U, 8U,  60U },
+    { 12U, 10U, 3U, 200U },
+    { 16U,  9U, 6U, 120U },
+    { 16U, 16U, 5U, 100U },
+};
+
+/* TIM4 ticks of the profiles PERFORMANCE, BALANCED, LOW_POWER first */
+static const uint32_t s_clocks[BENCH_MATRIX_CLOCKS] =
+{
+    10000000U, 8400000U, 1600000U, 100000000U, 1000000U, 0U,
+};
+
+static uint32_t            s_rounds = BENCH_MATRIX_ROUNDS;
+static bsp_matrix_t        s_matrix = { .is_initialized = MATRIX_NOT_INITED };
+static bench_matrix_mock_t s_mock;
+static bench_stat_t        s_cost[BENCH_MATRIX_COSTS];
+static uint32_t            s_rand = 0x2545F491U;
+
+/**
+ * @brief: xorshift32, the same sequence on target and host
+ *
+ * @return uint32_t: next pseudo random number
+ **/
+static uint32_t __rand ( void )
+{
+    s_rand ^= s_rand << 13;
+    s_rand ^= s_rand >> 17;
+    s_rand ^= s_rand << 5;
+    return s_rand;
+}
+
+//******************************** Mock *************************************//
+
+static uint32_t __mock_clock_hz ( void )
+{
+    return s_mock.hz;
+}
+
+static void __mock_latch ( void )
+{
+    // a latch without a pattern shifted shows the last one again
+    s_mock.bad    += ( 0U == s_mock.shifted ) ? 1U : 0U;
+    s_mock.shifted = 0U;
+    s_mock.lit     = 1U;
+    s_mock.l_row   = s_mock.s_row;
+    memcpy( s_mock.l_cols, s_mock.s_cols, MATRIX_COL_BYTES );
+}
+
+static void __mock_next ( uint32_t              row,
+                          const uint8_t * const cols,
+                          uint32_t              ticks )
+{
+    s_mock.bad    += ( 0U != s_mock.shifted || row >= s_mock.rows ||
+                       0U == ticks || MATRIX_MAX_PERIOD < ticks ) ? 1U : 0U;
+    s_mock.shifted = 1U;
+    s_mock.s_row   = row;
+    s_mock.preload = ticks;
+    memcpy( s_mock.s_cols, cols, MATRIX_COL_BYTES );
+}
+
+static matrix_status_t __mock_start ( void )
+{
+    s_mock.bad    += ( 0U != s_mock.running || 0U == s_mock.shifted ) ?
+                     1U : 0U;
+    // the update event loads the preload: the blank lead as long as slot 0
+    s_mock.period  = s_mock.preload;
+    s_mock.running = 1U;
+    s_mock.lit     = 0U;
+    s_mock.slot    = 0U;
+    s_mock.ticks   = 0U;
+    memset( s_mock.light, 0, sizeof( s_mock.light ) );
+    s_mock.starts++;
+    return MATRIX_OK;
+}
+
+static matrix_status_t __mock_stop ( void )
+{
+    s_mock.running = 0U;
+    s_mock.lit     = 0U;
+    s_mock.shifted = 0U;
+    s_mock.stops++;
+    return MATRIX_OK;
+}
+
+static bsp_status_t __mock_critical ( void )
+{
+    // the runner plays the interrupt itself, nothing to mask
+    return BSP_OK;
+}
+
+static bsp_status_t __mock_delay ( const uint32_t delay_ms )
+{
+    (void)delay_ms;
+    return BSP_OK;
+}
+
+static matrix_hw_operation_t s_mock_ops =
+{
+    .pf_matrix_clock_hz = __mock_clock_hz,
+    .pf_matrix_latch    = __mock_latch,
+    .pf_matrix_next     = __mock_next,
+    .pf_matrix_start    = __mock_start,
+    .pf_matrix_stop     = __mock_stop,
+};
+
+static os_critical_t s_mock_critical =
+{
+    .pf_os_critical_enter = __mock_critical,
+    .pf_os_critical_exit  = __mock_critical,
+};
+
+static os_delay_t s_mock_delay =
+{
+    .pf_os_delay_ms = __mock_delay,
+};
+
+//******************************** Mock *************************************//
+
+//******************************** Eye **************************************//
+
+/**
+ * @brief: Light of the frame against an image
+ *
+ * @param[in]  i: image
+ *
+ * @return uint32_t: 1 when every pixel got its level * base
+ **/
+static uint32_t __match ( uint32_t i )
+{
+    const uint8_t * img   = s_mock.images[i % BENCH_MATRIX_IMAGES];
+    uint32_t        base  = s_mock.bases[i % BENCH_MATRIX_IMAGES];
+    uint32_t        shift = 8U - s_mock.bits;
+
+    if ( s_mock.ticks != s_mock.rows * ( ( 1U << s_mock.bits ) - 1U ) * base )
+    {
+        return 0U;
+    }
+    for ( uint32_t p = 0; p < s_mock.rows * s_mock.cols; ++p )
+    {
+        if ( s_mock.light[p] != ( (uint32_t)img[p] >> shift ) * base )
+        {
+            return 0U;
+        }
+    }
+    return 1U;
+}
+
+/**
+ * @brief: A frame complete: one image, not older than the one before
+ **/
+static void __frame ( void )
+{
+    uint32_t i = s_mock.image;
+
+    while ( i < s_mock.shown && 0U == __match( i ) )
+    {
+        ++i;
+    }
+    s_mock.torn       += ( i >= s_mock.shown ) ? 1U : 0U;
+    s_mock.bad        += ( i >= s_mock.shown ||
+                           i + BENCH_MATRIX_IMAGES < s_mock.shown ) ? 1U : 0U;
+    s_mock.image       = i;
+    s_mock.frame_ticks = s_mock.ticks;
+    memcpy( s_mock.seen, s_mock.light, sizeof( s_mock.seen ) );
+    s_mock.frames++;
+    s_mock.slot        = 0U;
+    s_mock.ticks       = 0U;
+    memset( s_mock.light, 0, sizeof( s_mock.light ) );
+}
+
+/**
+ * @brief: The timer ends the slot on: its light gathered, the preloaded
+ *         period loaded, the interrupt
+ **/
+static void __update ( void )
+{
+    uint32_t t0;
+    uint32_t t1;
+    uint32_t row = s_mock.l_row;
+
+    if ( 0U != s_mock.lit )
+    {
+        // rows in order, bits slots each, plane b lasting base << b
+        s_mock.bad += ( row != s_mock.slot / s_mock.bits ) ? 1U : 0U;
+        for ( uint32_t x = 0; x < s_mock.cols; ++x )
+        {
+            if ( 0U != ( s_mock.l_cols[x / 8U] & ( 0x80U >> ( x % 8U ) ) ) )
+            {
+                s_mock.light[row * s_mock.cols + x] += s_mock.period;
+            }
+        }
+        s_mock.ticks += s_mock.period;
+        if ( ++s_mock.slot == s_mock.rows * s_mock.bits )
+        {
+            __frame();
+        }
+    }
+    s_mock.period = s_mock.preload;
+
+    t0 = bench_timestamp_get();
+    matrix_timer_isr( &s_matrix );
+    t1 = bench_timestamp_get();
+    bench_stat_add( &s_cost[BENCH_MATRIX_SLOT], t1 - t0 );
+}
+
+/**
+ * @brief: Run the timer for some frames more
+ *
+ * @param[in]  frames: complete ones to see
+ **/
+static void __run ( uint32_t frames )
+{
+    uint32_t end   = s_mock.frames + frames;
+    uint32_t limit = ( frames + 1U ) * s_mock.rows * s_mock.bits + 1U;
+
+    while ( 0U != s_mock.running && s_mock.frames < end && 0U != limit-- )
+    {
+        __update();
+    }
+    s_mock.bad += ( s_mock.frames != end ) ? 1U : 0U;
+}
+
+//******************************** Eye **************************************//
+
+/**
+ * @brief: A fresh matrix on the mock
+ *
+ * @param[in]  size: rows, columns, bits, refresh
+ * @param[in]  hz:   tick clock
+ *
+ * @return uint32_t: 1 when set up
+ **/
+static uint32_t __matrix ( const bench_matrix_size_t * const size,
+                           uint32_t                          hz )
+{
+    uint32_t bad = s_mock.bad;
+
+    memset( &s_mock, 0, sizeof( s_mock ) );
+    s_mock.bad  = bad;
+    s_mock.hz   = hz;
+    s_mock.rows = size->rows;
+    s_mock.cols = size->cols;
+    s_mock.bits = size->bits;
+    s_matrix.is_initialized = MATRIX_NOT_INITED;
+    return ( MATRIX_OK == matrix_inst( &s_matrix, &s_mock_ops,
+                                       &s_mock_critical, size->rows,
+                                       size->cols, size->bits, size->hz ) ) ?
+           1U : 0U;
+}
+
+/**
+ * @brief: Random brightness into the matrix and show it, the image kept
+ *
+ * @param[in]  timed: 1: the show into the costs
+ **/
+static void __paint ( uint32_t timed )
+{
+    uint8_t         * img = s_mock.images[s_mock.shown % BENCH_MATRIX_IMAGES];
+    uint32_t          t0;
+    uint32_t          t1;
+    matrix_status_t   ret;
+
+    for ( uint32_t y = 0; y < s_mock.rows; ++y )
+    {
+        for ( uint32_t x = 0; x < s_mock.cols; ++x )
+        {
+            img[y * s_mock.cols + x] = (uint8_t)__rand();
+            s_mock.bad += ( MATRIX_OK != matrix_set_pixel( &s_matrix, x, y,
+                                             img[y * s_mock.cols + x] ) ) ?
+                          1U : 0U;
+        }
+    }
+    t0  = bench_timestamp_get();
+    ret = matrix_show( &s_matrix );
+    t1  = bench_timestamp_get();
+    if ( 0U != timed )
+    {
+        bench_stat_add( &s_cost[BENCH_MATRIX_SHOW], t1 - t0 );
+    }
+    s_mock.bases[s_mock.shown % BENCH_MATRIX_IMAGES] = s_matrix.timing.base;
+    s_mock.shown++;
+    s_mock.bad += ( MATRIX_OK != ret || 0U == s_mock.running ) ? 1U : 0U;
+}
+
+/**
+ * @brief: Bases at the clocks against a reference, for sizes and rates
+ **/
+static void __timing ( void )
+{
+    static const uint32_t rows[3]  = { 1U, 8U, 16U };
+    static const uint32_t bits[4]  = { 1U, 4U, 5U, 8U };
+    static const uint32_t rates[3] = { 50U, 100U, 400U };
+    matrix_timing_t       t;
+    matrix_status_t       ret;
+    uint32_t              bad     = 0U;
+    uint32_t              refused = 0U;
+    uint32_t              total   = 0U;
+    uint32_t              hz;
+    uint32_t              units;
+    uint32_t              fits;
+    double                want;
+    uint32_t              base;
+
+    for ( uint32_t c = 0; c < BENCH_MATRIX_CLOCKS; ++c )
+    {
+        hz = s_clocks[c];
+        for ( uint32_t r = 0; r < 3U; ++r )
+        {
+            for ( uint32_t b = 0; b < 4U; ++b )
+            {
+                for ( uint32_t f = 0; f < 3U; ++f )
+                {
+                    units = rows[r] * ( ( 1U << bits[b] ) - 1U );
+                    want  = (double)hz / ( (double)units * rates[f] );
+                    base  = (uint32_t)( want + 0.5 );
+                    fits  = ( 0U != base &&
+                              (double)base * 1e9 / hz >=
+                              (double)MATRIX_MIN_SLOT_NS &&
+                              ( (uint64_t)base << ( bits[b] - 1U ) ) <=
+                              MATRIX_MAX_PERIOD ) ? 1U : 0U;
+                    memset( &t, 0, sizeof( t ) );
+                    ret = matrix_timing( rows[r], bits[b], rates[f], hz, &t );
+                    total++;
+                    if ( MATRIX_OK != ret )
+                    {
+                        refused++;
+                        bad += fits;
+                        continue;
+                    }
+                    // the rate of the rounded base, to the mHz
+                    bad += ( 0U == fits || base != t.base || hz != t.tick_hz ||
+                             units * base != t.frame ||
+                             (uint32_t)( (double)hz * 1000.0 / t.frame + 0.5 )
+                             != t.refresh_mhz ) ? 1U : 0U;
+                }
+            }
+        }
+        // the board: 16 rows of 5 bits at 100 Hz
+        if ( c < 3U )
+        {
+            ret = matrix_timing( 16U, 5U, 100U, hz, &t );
+            bad += ( MATRIX_OK != ret ) ? 1U : 0U;
+            printf( "# timing,16 rows 5 bits,%u Hz,%u base,%u frame,"
+                    "%u mHz\r\n", (unsigned int)hz, (unsigned int)t.base,
+                    (unsigned int)t.frame, (unsigned int)t.refresh_mhz );
+        }
+    }
+    // wrong sizes
+    bad += ( MATRIX_ERRORPARAMETER != matrix_timing( 0U, 4U, 100U,
+                                          BENCH_MATRIX_TICK_HZ, &t ) ||
+             MATRIX_ERRORPARAMETER != matrix_timing( 17U, 4U, 100U,
+                                          BENCH_MATRIX_TICK_HZ, &t ) ||
+             MATRIX_ERRORPARAMETER != matrix_timing( 8U, 9U, 100U,
+                                          BENCH_MATRIX_TICK_HZ, &t ) ) ?
+           1U : 0U;
+    printf( "# timing,%u cases,%u refused,%s\r\n", (unsigned int)total,
+            (unsigned int)refused, ( 0U == bad ) ? "ok" : "MISMATCH" );
+}
+
+/**
+ * @brief: Random rows, bit by bit
+ **/
+static void __encode ( void )
+{
+    uint8_t  pixels[MATRIX_MAX_COLS];
+    uint8_t  planes[MATRIX_MAX_BITS][MATRIX_COL_BYTES];
+    uint32_t bad = 0U;
+    uint32_t cols;
+    uint32_t bits;
+    uint32_t want;
+    uint32_t got;
+
+    for ( uint32_t r = 0; r < s_rounds; ++r )
+    {
+        cols = 1U + __rand() % MATRIX_MAX_COLS;
+        bits = 1U + __rand() % MATRIX_MAX_BITS;
+        for ( uint32_t x = 0; x < cols; ++x )
+        {
+            pixels[x] = (uint8_t)__rand();
+        }
+        memset( planes, 0xA5, sizeof( planes ) );
+        matrix_encode( pixels, cols, bits, &planes[0][0] );
+        for ( uint32_t b = 0; b < bits; ++b )
+        {
+            for ( uint32_t x = 0; x < 8U * MATRIX_COL_BYTES; ++x )
+            {
+                want = ( x < cols ) ? ( pixels[x] >> ( 8U - bits + b ) ) & 1U :
+                                      0U;
+                got  = ( planes[b][x / 8U] >> ( 7U - x % 8U ) ) & 1U;
+                bad += ( want != got ) ? 1U : 0U;
+            }
+        }
+    }
+    printf( "# encode,%u rounds,%s\r\n", (unsigned int)s_rounds,
+            ( 0U == bad ) ? "ok" : "MISMATCH" );
+}
+
+/**
+ * @brief: Matrices of every size, an image each, frame by frame
+ **/
+static void __scan ( void )
+{
+    const bench_matrix_size_t * size;
+    uint32_t                    bad    = 0U;
+    uint32_t                    frames = 0U;
+    uint32_t                    mhz;
+
+    for ( uint32_t s = 0; s < BENCH_MATRIX_SIZES; ++s )
+    {
+        size = &s_sizes[s];
+        if ( 0U == __matrix( size, BENCH_MATRIX_TICK_HZ ) )
+        {
+            bad++;
+            continue;
+        }
+        __paint( 1U );
+        __run( BENCH_MATRIX_FRAMES );
+        // the rate seen on the outputs
+        mhz  = ( 0U == s_mock.frame_ticks ) ? 0U :
+               (uint32_t)( ( (uint64_t)BENCH_MATRIX_TICK_HZ * 1000U +
+                             s_mock.frame_ticks / 2U ) / s_mock.frame_ticks );
+        // stopped right after the latch of the first slot of a frame
+        bad += ( 0U != s_mock.image || mhz != s_matrix.timing.refresh_mhz ||
+                 s_matrix.slots != s_mock.frames * size->rows * size->bits +
+                                   1U ) ? 1U : 0U;
+        frames += s_mock.frames;
+        printf( "# scan,%ux%u,%u bits,%u Hz asked,%u mHz seen,%u slots a "
+                "frame\r\n", (unsigned int)size->rows,
+                (unsigned int)size->cols, (unsigned int)size->bits,
+                (unsigned int)size->hz, (unsigned int)mhz,
+                (unsigned int)( size->rows * size->bits ) );
+        matrix_stop( &s_matrix );
+    }
+    bad += s_mock.bad;
+    s_mock.bad = 0U;
+    printf( "# scan,%u frames,planes %u bytes,%s\r\n", (unsigned int)frames,
+            (unsigned int)sizeof( s_matrix.planes ),
+            ( 0U == bad ) ? "ok" : "MISMATCH" );
+}
+
+/**
+ * @brief: Images shown at random slots while scanning: whole frames of
+ *         them in order, the last one on at the end
+ **/
+static void __tear ( void )
+{
+    const bench_matrix_size_t * size = &s_sizes[BENCH_MATRIX_SIZES - 1U];
+    uint32_t                    bad  = 0U;
+    uint32_t                    slots;
+
+    if ( 0U == __matrix( size, BENCH_MATRIX_TICK_HZ ) )
+    {
+        bad++;
+    }
+    __paint( 1U );
+    slots = size->rows * size->bits;
+    for ( uint32_t r = 0; r < s_rounds; ++r )
+    {
+        // about one show a frame, sometimes two in one
+        for ( uint32_t n = __rand() % ( 2U * slots ); 0U != n; --n )
+        {
+            __update();
+        }
+        __paint( 1U );
+    }
+    __run( 2U );
+    // every image swapped in or taken back, every frame a whole image, the
+    // last image on: how many were skipped depends on the draw only
+    bad += ( 0U != s_mock.torn ||
+             s_mock.image + 1U != s_mock.shown ||
+             s_matrix.frames + s_matrix.skipped != s_mock.shown ) ? 1U : 0U;
+    bad += s_mock.bad;
+    s_mock.bad = 0U;
+    printf( "# tear,%u images,%u frames,%u torn,%u swapped,%u skipped,"
+            "%s\r\n",
+            (unsigned int)s_mock.shown, (unsigned int)s_mock.frames,
+            (unsigned int)s_mock.torn, (unsigned int)s_matrix.frames,
+            (unsigned int)s_matrix.skipped,
+            ( 0U == bad ) ? "ok" : "MISMATCH" );
+    matrix_stop( &s_matrix );
+}
+
+/**
+ * @brief: The timing follows the clock from the next image, a too slow
+ *         clock refused with the scan going on
+ **/
+static void __clock ( void )
+{
+    const bench_matrix_size_t * size = &s_sizes[BENCH_MATRIX_SIZES - 1U];
+    uint32_t                    ok   = __matrix( size, BENCH_MATRIX_TICK_HZ );
+    uint32_t                    base;
+
+    __paint( 0U );
+    __run( 1U );
+    base = s_matrix.timing.base;
+
+    // LOW_POWER profile: the frames of the image before keep their base
+    s_mock.hz = 1600000U;
+    __run( 1U );
+    ok &= ( s_mock.frame_ticks == 16U * 31U * base ) ? 1U : 0U;
+    __paint( 0U );
+    __run( 2U );
+    ok &= ( 1U == s_mock.image && 32U == s_matrix.timing.base &&
+            s_mock.frame_ticks == 16U * 31U * 32U ) ? 1U : 0U;
+
+    // too slow for a tick a base: refused, the image before still scanned
+    s_mock.hz = 20000U;
+    ok &= ( MATRIX_ERRORPARAMETER == matrix_show( &s_matrix ) ) ? 1U : 0U;
+    __run( 1U );
+    ok &= ( 1U == s_mock.image && 0U != s_mock.running &&
+            0U == s_mock.bad ) ? 1U : 0U;
+    s_mock.bad = 0U;
+    matrix_stop( &s_matrix );
+    printf( "# clock,%s\r\n", ( 0U != ok ) ? "ok" : "MISMATCH" );
+}
+
+/**
+ * @brief: Stop blanks the outputs, an interrupt after it does nothing,
+ *         show starts the scan again from the first slot
+ **/
+static void __stop ( void )
+{
+    uint32_t ok = __matrix( &s_sizes[1], BENCH_MATRIX_TICK_HZ );
+    uint32_t slots;
+
+    __paint( 0U );
+    for ( uint32_t n = __rand() % 50U; 0U != n; --n )
+    {
+        __update();
+    }
+    ok &= ( MATRIX_OK == matrix_stop( &s_matrix ) &&
+            0U == s_mock.running && 0U == s_mock.lit ) ? 1U : 0U;
+    slots = s_matrix.slots;
+    matrix_timer_isr( &s_matrix );
+    ok &= ( slots == s_matrix.slots && 0U == s_mock.shifted ) ? 1U : 0U;
+
+    // the frame cut by the stop is not one
+    s_mock.image = s_mock.shown;
+    __paint( 0U );
+    __run( 2U );
+    ok &= ( 2U == s_mock.starts && s_mock.image + 1U == s_mock.shown &&
+            0U == s_mock.bad ) ? 1U : 0U;
+    s_mock.bad = 0U;
+    matrix_stop( &s_matrix );
+    printf( "# stop,%s\r\n", ( 0U != ok ) ? "ok" : "MISMATCH" );
+}
+
+//******************************** Led **************************************//
+
+static led_inst_status_t __led_on ( void )
+{
+    return matrix_led_set( &s_matrix, BENCH_MATRIX_LED_X, BENCH_MATRIX_LED_Y,
+                           BENCH_MATRIX_LED_LEVEL, 1U );
+}
+
+static led_inst_status_t __led_off ( void )
+{
+    return matrix_led_set( &s_matrix, BENCH_MATRIX_LED_X, BENCH_MATRIX_LED_Y,
+                           BENCH_MATRIX_LED_LEVEL, 0U );
+}
+
+static led_operation_t s_led_ops =
+{
+    .pf_led_on  = __led_on,
+    .pf_led_off = __led_off,
+};
+
+//******************************** Led **************************************//
+
+/**
+ * @brief: A pixel as a registered LED device: on and off through pf_led_ctrl
+ **/
+static void __led ( void )
+{
+    static led_inst_group_t  group;
+    static bsp_led_handler_t handler = {
+        .is_initialized = LED_HANDLER_NOT_INITED,
+        .led_inst_group = &group,
+    };
+    static bsp_led_driver_t  led = { .is_initialized = LED_INST_NOT_INITED };
+    static bsp_device_t      dev;
+#ifdef BENCH_HOST_POSIX
+    static bsp_osal_t        osal = { .p_os_critical = &s_mock_critical };
+#endif /* BENCH_HOST_POSIX */
+    static time_operation_t  time_ops;
+    const uint32_t           p    = BENCH_MATRIX_LED_Y * 8U +
+                                    BENCH_MATRIX_LED_X;
+    const uint32_t           on   = ( BENCH_MATRIX_LED_LEVEL >> 4 );
+    uint32_t                 ok;
+    uint32_t                 lit;
+
+    ok = __matrix( &s_sizes[1], BENCH_MATRIX_TICK_HZ );
+    handler.is_initialized = LED_HANDLER_NOT_INITED;
+    led.is_initialized     = LED_INST_NOT_INITED;
+    ok &= ( LED_HNDLR_OK == led_handler_inst( &handler, &s_mock_delay,
+                                              &s_mock_critical,
+                                              &time_ops ) ) ? 1U : 0U;
+
+#ifdef BENCH_HOST_POSIX
+    // on target MX_FREERTOS_Init mounted the OSAL of the registry
+    ok &= ( BSP_OK == bsp_core_init( &osal ) ) ? 1U : 0U;
+#endif /* BENCH_HOST_POSIX */
+    // instantiate and the open of the device turn the LED off: the scan
+    // starts dark
+    ok &= ( LED_INST_OK == led_instantiate( &led, &s_led_ops ) &&
+            BSP_OK == bsp_device_inst( &dev, "bench_matrix_led", &led_ops,
+                                       &led ) &&
+            BSP_OK == bsp_device_register( &dev ) &&
+            LED_HNDLR_OK == handler.pf_led_register( &handler, &dev ) ) ?
+          1U : 0U;
+    __run( 2U );
+    ok &= ( 0U == s_mock.seen[p] ) ? 1U : 0U;
+
+    // the last frame after the show: every pixel dark but this one
+    ok &= ( LED_HNDLR_OK == handler.pf_led_ctrl( &handler, &dev, 1000U, 1U,
+                                                 DUTY_MAX_PERCENT ) ) ?
+          1U : 0U;
+    __run( 2U );
+    lit = 0U;
+    for ( uint32_t i = 0; i < 64U; ++i )
+    {
+        lit += ( 0U != s_mock.seen[i] ) ? 1U : 0U;
+    }
+    ok &= ( 1U == lit && on * s_matrix.timing.base == s_mock.seen[p] ) ?
+          1U : 0U;
+
+    ok &= ( LED_HNDLR_OK == handler.pf_led_ctrl( &handler, &dev, 1000U, 1U,
+                                                 DUTY_00_PERCENT ) ) ?
+          1U : 0U;
+    __run( 2U );
+    ok &= ( 0U == s_mock.seen[p] && 4U == s_matrix.frames &&
+            1U == s_mock.starts ) ? 1U : 0U;
+    s_mock.bad = 0U;
+    matrix_stop( &s_matrix );
+    printf( "# led,%s\r\n", ( 0U != ok ) ? "ok" : "MISMATCH" );
+}
+
+/**
+ * @brief: Cost of a frame of the board against its time: the interrupts of
+ *         its slots and a show
+ **/
+static void __load ( void )
+{
+    const bench_matrix_size_t * size  = &s_sizes[BENCH_MATRIX_SIZES - 1U];
+    matrix_timing_t             t;
+    uint32_t                    slots = size->rows * size->bits;
+    uint64_t                    slot_ns;
+    uint64_t                    show_ns;
+    uint64_t                    frame_ns;
+    uint64_t                    busy_ns;
+
+    if ( 0U == s_cost[BENCH_MATRIX_SLOT].samples ||
+         0U == s_cost[BENCH_MATRIX_SHOW].samples ||
+         MATRIX_OK != matrix_timing( size->rows, size->bits, size->hz,
+                                     BENCH_MATRIX_TICK_HZ, &t ) )
+    {
+        return;
+    }
+    slot_ns  = bench_timestamp_to_ns( (uint32_t)(
+                   s_cost[BENCH_MATRIX_SLOT].sum /
+                   s_cost[BENCH_MATRIX_SLOT].samples ) );
+    show_ns  = bench_timestamp_to_ns( s_cost[BENCH_MATRIX_SHOW].max );
+    frame_ns = (uint64_t)t.frame * 1000000000U / BENCH_MATRIX_TICK_HZ;
+    busy_ns  = slots * slot_ns + show_ns;
+    // a show every frame is the worst case, an animation at the refresh
+    printf( "# load,%ux%u %u bits,%u slots,slot avg %u ns,show max %u ns,"
+            "%u us a frame of %u us,%u permille\r\n",
+            (unsigned int)size->rows, (unsigned int)size->cols,
+            (unsigned int)size->bits, (unsigned int)slots,
+            (unsigned int)slot_ns, (unsigned int)show_ns,
+            (unsigned int)( busy_ns / 1000U ),
+            (unsigned int)( frame_ns / 1000U ),
+            (unsigned int)( busy_ns * 1000U / frame_ns ) );
+}
+
+/**
+ * @brief: Runner task, runs every check and deletes itself
+ *
+ * @param[in]  argument: Not used
+ **/
+static void bench_matrix_task ( void * argument )
+{
+    (void)argument;
+
+    bench_csv_header( BENCH_MATRIX_SUITE );
+    __timing();
+    __encode();
+    __scan();
+    __tear();
+    __clock();
+    __stop();
+    __led();
+    for ( uint32_t c = 0; c < BENCH_MATRIX_COSTS; ++c )
+    {
+        bench_csv_row( BENCH_MATRIX_SUITE, "cpu", s_cost_name[c],
+                       &s_cost[c] );
+    }
+    __load();
+
+    vTaskDelete( NULL );
+}
+
+/**
+ * @brief: Start the LED matrix suite
+ * @steps:
+ *      1. Start the timestamp source
+ *      2. Create the runner task, it prints the CSV report and deletes itself
+ *
+ * @param[in]  rounds: repeats of the random cases, 0 means default
+ *
+ * @return bench_status_t: execute result of this function
+ **/
+bench_status_t bench_matrix_start ( uint32_t rounds )
+{
+    bench_status_t ret = BENCH_OK;
+
+    /************** 1. Start the timestamp source *************/
+    ret = bench_timestamp_init();
+    if ( BENCH_OK != ret )
+    {
+        LOG( LOG_LEVEL_ERR, "Bench timestamp init failed" );
+        return ret;
+    }
+    s_rounds = ( 0U == rounds ) ? BENCH_MATRIX_ROUNDS : rounds;
+    memset( &s_mock, 0, sizeof( s_mock ) );
+    for ( uint32_t c = 0; c < BENCH_MATRIX_COSTS; ++c )
+    {
+        bench_stat_reset( &s_cost[c] );
+    }
+
+    /***************** 2. Create the runner ******************/
+    if ( pdPASS != xTaskCreate( bench_matrix_task,
+                                "bench_matrix",
+                                BENCH_MATRIX_STACK_WORDS,
+                                NULL,
+                                tskIDLE_PRIORITY + 1,
+                                NULL                  ) )
+    {
+        LOG( LOG_LEVEL_ERR, "Bench matrix task create failed" );
+        return BENCH_ERROR;
+    }
+    return BENCH_OK;
+}
+
+//******************************** Defines **********************************//
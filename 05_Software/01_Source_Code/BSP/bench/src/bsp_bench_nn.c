@@ -0,0 +1,191 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_bench_nn.c
+ *
+ * @par dependencies
+ * - bsp_bench_nn.h
+ * - bsp_nn_runtime.h
+ * - bsp_nn_model_demo.h
+ *
+ * @author Damian
+ *
+ * @brief Measure the inference time of the nn runtime and check its output
+ *        under the offline arena plan and the runtime first fit.
+ *
+ * Processing flow:
+ *
+ * Call directly.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+//******************************** Includes *********************************//
+
+#include "bsp_bench_nn.h"
+#include "bsp_nn_runtime.h"
+#include "bsp_nn_model_demo.h"
+#include "bsp_common.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include <string.h>
+
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+#define BENCH_NN_SUITE          "nn"
+
+static uint32_t         s_iterations = BENCH_NN_ITERATIONS;
+
+static nn_runtime_t     s_rt;
+static nn_model_t       s_model_first_fit;
+// uint32_t keeps the arena 4 byte aligned
+static uint32_t         s_arena[BENCH_NN_ARENA_BYTES / sizeof( uint32_t )];
+
+/**
+ * @brief: Index of the first output byte that differs from the expected one
+ *
+ * @param[in]  out: output of the runtime
+ *
+ * @return uint32_t: NN_MODEL_DEMO_OUTPUT_LEN when the output is bit exact
+ **/
+static uint32_t __output_compare ( const int8_t * const out )
+{
+    uint32_t i;
+
+    for ( i = 0; i < NN_MODEL_DEMO_OUTPUT_LEN; ++i )
+    {
+        if ( out[i] != nn_model_demo_expected[i] )
+        {
+            break;
+        }
+    }
+    return i;
+}
+
+/**
+ * @brief: Run one plan of the model, one CSV row and one comment line
+ * @steps:
+ *      1. Plan the arena
+ *      2. Time the copy of the input plus the invoke
+ *      3. Compare the output with the generator
+ *
+ * @param[in]  model: the demo model, with or without its offline plan
+ * @param[in]  plan:  name of the plan, the case column
+ **/
+static void __model_run (
+                          const nn_model_t * const model,
+                          const char       * const plan
+                                                          )
+{
+    bench_stat_t stat;
+    uint32_t     t0;
+    uint32_t     diff;
+    nn_status_t  ret = NN_OK;
+
+    /***************** 1. Plan the arena ******************/
+    if ( NN_OK != nn_runtime_inst( &s_rt, model, (int8_t *)s_arena,
+                                   sizeof( s_arena )              ) )
+    {
+        LOG( LOG_LEVEL_ERR, "Bench nn model %s %s init failed",
+                            model->name, plan );
+        return;
+    }
+
+    /***************** 2. Time the invoke *****************/
+    bench_stat_reset( &stat );
+    for ( uint32_t i = 0; i < s_iterations && NN_OK == ret; ++i )
+    {
+        t0 = bench_timestamp_get();
+        memcpy( nn_runtime_input( &s_rt ), nn_model_demo_input,
+                NN_MODEL_DEMO_INPUT_LEN );
+        ret = nn_runtime_invoke( &s_rt );
+        bench_stat_add( &stat, bench_timestamp_get() - t0 );
+    }
+    bench_csv_row( BENCH_NN_SUITE, model->name, plan, &stat );
+
+    /***************** 3. Compare *************************/
+    diff = __output_compare( nn_runtime_output( &s_rt ) );
+    printf( "# %s,%s,arena %u bytes,scratch %u bytes,%s\r\n",
+            model->name, plan, (unsigned int)s_rt.act_size,
+            (unsigned int)s_rt.scratch_size,
+            ( NN_OK == ret && NN_MODEL_DEMO_OUTPUT_LEN == diff ) ?
+            "bit exact" : "MISMATCH" );
+    if ( NN_MODEL_DEMO_OUTPUT_LEN != diff )
+    {
+        LOG( LOG_LEVEL_ERR, "Bench nn output %u is %d, expected %d",
+                            (unsigned int)diff,
+                            (int)nn_runtime_output( &s_rt )[diff],
+                            (int)nn_model_demo_expected[diff] );
+    }
+}
+
+/**
+ * @brief: Runner task, runs the model and deletes itself
+ * @steps:
+ *      1. The offline plan of the generator
+ *      2. The first fit of the runtime, same model without the offsets
+ *
+ * @param[in]  argument: Not used
+ **/
+static void bench_nn_task ( void * argument )
+{
+    (void)argument;
+
+    bench_csv_header( BENCH_NN_SUITE );
+
+    /***************** 1. Offline plan ********************/
+    __model_run( &nn_model_demo, "offline" );
+
+    /***************** 2. Runtime first fit ***************/
+    s_model_first_fit         = nn_model_demo;
+    s_model_first_fit.offsets = NULL;
+    __model_run( &s_model_first_fit, "first_fit" );
+
+    vTaskDelete( NULL );
+}
+
+/**
+ * @brief: Start the nn runtime suite
+ * @steps:
+ *      1. Start the timestamp source
+ *      2. Create the runner task, it prints the CSV report and deletes itself
+ *
+ * @param[in]  iterations: samples per case, 0 means default
+ *
+ * @return bench_status_t: execute result of this function
+ **/
+bench_status_t bench_nn_start ( uint32_t iterations )
+{
+    bench_status_t ret = BENCH_OK;
+
+    /************** 1. Start the timestamp source *************/
+    ret = bench_timestamp_init();
+    if ( BENCH_OK != ret )
+    {
+        LOG( LOG_LEVEL_ERR, "Bench timestamp init failed" );
+        return ret;
+    }
+    s_iterations = ( 0U == iterations ) ? BENCH_NN_ITERATIONS : iterations;
+
+    /***************** 2. Create the runner ******************/
+    if ( pdPASS != xTaskCreate( bench_nn_task,
+                                "bench_nn",
+                                BENCH_NN_STACK_WORDS,
+                                NULL,
+                                tskIDLE_PRIORITY + 1,
+                                NULL                       ) )
+    {
+        LOG( LOG_LEVEL_ERR, "Bench runner create failed" );
+        return BENCH_ERRORNOMEMORY;
+    }
+    return ret;
+}
+
+//******************************** Defines **********************************//
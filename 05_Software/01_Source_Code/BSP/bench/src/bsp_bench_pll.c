@@ -0,0 +1,477 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_bench_pll.c
+ *
+ * @par dependencies
+ * - bsp_bench_pll.h
+ * - bsp_clock.h
+ *
+ * @author Damian
+ *
+ * @brief Check the PLL solver and the flash latency table of the clock
+ *        profiles against the limits of the F411, and measure a solve.
+ *
+ * Processing flow:
+ *
+ * Call directly.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+//******************************** Includes *********************************//
+
+#include "bsp_bench_pll.h"
+#include "bsp_common.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+#define BENCH_PLL_SUITE           "pll"
+
+/* the F411 limits, written again from the reference manual */
+#define BENCH_PLL_IN_MIN_HZ       1000000ULL
+#define BENCH_PLL_IN_MAX_HZ       2000000ULL
+#define BENCH_PLL_VCO_MIN_HZ      100000000ULL
+#define BENCH_PLL_VCO_MAX_HZ      432000000ULL
+#define BENCH_PLL_USB_MAX_HZ      48000000ULL
+#define BENCH_PLL_M_MIN           2U
+#define BENCH_PLL_M_MAX           63U
+#define BENCH_PLL_N_MIN           50U
+#define BENCH_PLL_N_MAX           432U
+#define BENCH_PLL_P_MAX           8U
+#define BENCH_PLL_Q_MIN           2U
+#define BENCH_PLL_Q_MAX           15U
+
+typedef struct
+{
+    const char            * name;
+    uint32_t              src_hz;                 /* PLL input               */
+    uint32_t              sysclk_hz;              /* target                  */
+    clock_status_t        status;                 /* expected                */
+    uint32_t              usb_hz;                 /* expected, 0 not checked */
+} bench_pll_target_t;
+
+typedef struct
+{
+    uint32_t              hclk_hz;
+    clock_status_t        status;                 /* expected                */
+    uint32_t              latency;                /* expected wait states    */
+} bench_pll_latency_t;
+
+typedef struct
+{
+    uint32_t              targets;
+    uint32_t              solved;
+    uint32_t              unreachable;
+    uint32_t              wrong;                  /* not as the search       */
+} bench_pll_result_t;
+
+static const bench_pll_target_t s_targets[] =
+{
+    { "performance", CLOCK_HSE_HZ, 100000000U, CLOCK_OK,             0U  },
+    { "balanced",    CLOCK_HSE_HZ,  84000000U, CLOCK_OK,             0U  },
+    { "hsi_100",     CLOCK_HSI_HZ, 100000000U, CLOCK_OK,             0U  },
+    { "usb_96",      CLOCK_HSE_HZ,  96000000U, CLOCK_OK,  CLOCK_USB_HZ   },
+    { "usb_48",      CLOCK_HSE_HZ,  48000000U, CLOCK_OK,  CLOCK_USB_HZ   },
+    { "vco_max",     CLOCK_HSE_HZ, 216000000U, CLOCK_OK,             0U  },
+    { "vco_over",    CLOCK_HSE_HZ, 217000000U, CLOCK_ERRORPARAMETER, 0U  },
+    { "vco_min",     CLOCK_HSE_HZ,  12500000U, CLOCK_OK,             0U  },
+    { "vco_under",   CLOCK_HSE_HZ,  12000000U, CLOCK_ERRORPARAMETER, 0U  },
+    { "in_min",         2000000U, 100000000U, CLOCK_OK,             0U  },
+    { "in_under",       1500000U, 100000000U, CLOCK_ERRORPARAMETER, 0U  },
+    { "m_max",        126000000U, 100000000U, CLOCK_OK,             0U  },
+    { "m_over",       130000000U, 100000000U, CLOCK_ERRORPARAMETER, 0U  },
+    { "not_exact",   CLOCK_HSE_HZ, 100000001U, CLOCK_ERRORPARAMETER, 0U  },
+    { "no_source",             0U, 100000000U, CLOCK_ERRORPARAMETER, 0U  },
+    { "no_target",   CLOCK_HSE_HZ,         0U, CLOCK_ERRORPARAMETER, 0U  },
+};
+
+static const uint32_t           s_sources[] =
+{
+    CLOCK_HSE_HZ, CLOCK_HSI_HZ, 8000000U, 12000000U, 26000000U,
+    2000000U, 1500000U, 126000000U, 130000000U,
+};
+
+static const bench_pll_latency_t s_latency[] =
+{
+    {         0U, CLOCK_OK,             0U },
+    {  30000000U, CLOCK_OK,             0U },
+    {  30000001U, CLOCK_OK,             1U },
+    {  64000000U, CLOCK_OK,             1U },
+    {  64000001U, CLOCK_OK,             2U },
+    {  90000000U, CLOCK_OK,             2U },
+    {  90000001U, CLOCK_OK,             3U },
+    { 100000000U, CLOCK_OK,             3U },
+    { 100000001U, CLOCK_ERRORPARAMETER, 0U },
+};
+
+static uint32_t             s_iterations = BENCH_PLL_ITERATIONS;
+static uint32_t             s_rand       = 0x2545F491U;
+
+static uint32_t __rand ( void )
+{
+    s_rand ^= s_rand << 13;
+    s_rand ^= s_rand >> 17;
+    s_rand ^= s_rand << 5;
+    return s_rand;
+}
+
+/**
+ * @brief: Check a PLL against every limit, the target and the USB clock
+ *
+ * @param[in]  src_hz:    PLL input
+ * @param[in]  sysclk_hz: target
+ * @param[in]  pll:       the dividers
+ *
+ * @return uint32_t: 1 when valid
+ **/
+static uint32_t __valid ( uint32_t                  src_hz,
+                          uint32_t                  sysclk_hz,
+                          const clock_pll_t * const pll )
+{
+    // the VCO output times M, so every test stays in integers
+    uint64_t vco_m = (uint64_t)src_hz * pll->plln;
+
+    if ( pll->pllm < BENCH_PLL_M_MIN   || pll->pllm > BENCH_PLL_M_MAX   ||
+         pll->plln < BENCH_PLL_N_MIN   || pll->plln > BENCH_PLL_N_MAX   ||
+         pll->pllq < BENCH_PLL_Q_MIN   || pll->pllq > BENCH_PLL_Q_MAX   ||
+         pll->pllp < 2U || pll->pllp > BENCH_PLL_P_MAX || 0U != pll->pllp % 2U
+                                                                          )
+    {
+        return 0U;
+    }
+    if ( src_hz < BENCH_PLL_IN_MIN_HZ * pll->pllm                   ||
+         src_hz > BENCH_PLL_IN_MAX_HZ * pll->pllm                   ||
+         vco_m  < BENCH_PLL_VCO_MIN_HZ * pll->pllm                  ||
+         vco_m  > BENCH_PLL_VCO_MAX_HZ * pll->pllm                  ||
+         vco_m != (uint64_t)sysclk_hz * pll->pllm * pll->pllp
+                                                                      )
+    {
+        return 0U;
+    }
+    // USB at most 48 MHz, and not with a smaller Q
+    if ( vco_m > BENCH_PLL_USB_MAX_HZ * pll->pllm * pll->pllq ||
+         ( BENCH_PLL_Q_MIN != pll->pllq &&
+           vco_m <= BENCH_PLL_USB_MAX_HZ * pll->pllm * ( pll->pllq - 1U ) )
+                                                                            )
+    {
+        return 0U;
+    }
+    return 1U;
+}
+
+/**
+ * @brief: Search every M and P, lowest M first, then lowest P
+ *
+ * @param[in]  src_hz:    PLL input
+ * @param[in]  sysclk_hz: target
+ * @param[out] pll:       the first valid dividers
+ *
+ * @return uint32_t: 1 when found
+ **/
+static uint32_t __search ( uint32_t            src_hz,
+                           uint32_t            sysclk_hz,
+                           clock_pll_t * const pll )
+{
+    uint64_t vco_m;
+
+    if ( 0U == src_hz || 0U == sysclk_hz )
+    {
+        return 0U;
+    }
+    for ( uint32_t m = BENCH_PLL_M_MIN; m <= BENCH_PLL_M_MAX; ++m )
+    {
+        for ( uint32_t p = 2U; p <= BENCH_PLL_P_MAX; p += 2U )
+        {
+            vco_m = (uint64_t)sysclk_hz * p * m;
+            if ( 0U != vco_m % src_hz )
+            {
+                continue;
+            }
+            pll->pllm = m;
+            pll->plln = (uint32_t)( vco_m / src_hz );
+            pll->pllp = p;
+            for ( pll->pllq = BENCH_PLL_Q_MIN;
+                  pll->pllq <= BENCH_PLL_Q_MAX; ++pll->pllq )
+            {
+                if ( 0U != __valid( src_hz, sysclk_hz, pll ) )
+                {
+                    return 1U;
+                }
+            }
+        }
+    }
+    return 0U;
+}
+
+/**
+ * @brief: Solve one target and compare it with the search
+ *
+ * @param[in]  src_hz:    PLL input
+ * @param[in]  sysclk_hz: target
+ * @param[in]  r:         result of the line
+ * @param[out] pll:       the solved dividers
+ *
+ * @return clock_status_t: of clock_pll_solve
+ **/
+static clock_status_t __check ( uint32_t                   src_hz,
+                                uint32_t                   sysclk_hz,
+                                bench_pll_result_t * const r,
+                                clock_pll_t        * const pll )
+{
+    clock_pll_t    ref   = { 0U };
+    uint32_t       found = __search( src_hz, sysclk_hz, &ref );
+    clock_status_t ret;
+
+    pll->pllm = 0U;
+    pll->plln = 0U;
+    pll->pllp = 0U;
+    pll->pllq = 0U;
+    ret       = clock_pll_solve( src_hz, sysclk_hz, pll );
+    r->targets++;
+    if ( CLOCK_OK == ret )
+    {
+        r->solved++;
+        if ( 0U == found                                      ||
+             0U == __valid( src_hz, sysclk_hz, pll )          ||
+             ref.pllm != pll->pllm || ref.plln != pll->plln   ||
+             ref.pllp != pll->pllp || ref.pllq != pll->pllq
+                                                                )
+        {
+            r->wrong++;
+        }
+    }
+    else
+    {
+        r->unreachable++;
+        r->wrong += ( 0U != found || CLOCK_ERRORPARAMETER != ret ) ? 1U : 0U;
+    }
+    return ret;
+}
+
+/**
+ * @brief: Run and print the fixed targets
+ **/
+static void __targets_run ( void )
+{
+    const bench_pll_target_t * t;
+    bench_pll_result_t         r;
+    clock_pll_t                pll;
+    clock_status_t             ret;
+    uint32_t                   usb;
+
+    for ( uint32_t i = 0; i < sizeof( s_targets ) / sizeof( s_targets[0] );
+          ++i )
+    {
+        t             = &s_targets[i];
+        r.targets     = 0U;
+        r.solved      = 0U;
+        r.unreachable = 0U;
+        r.wrong       = 0U;
+        ret           = __check( t->src_hz, t->sysclk_hz, &r, &pll );
+        usb = ( CLOCK_OK == ret ) ?
+              (uint32_t)( (uint64_t)t->src_hz * pll.plln /
+                          ( (uint64_t)pll.pllm * pll.pllq ) ) : 0U;
+        if ( t->status != ret || ( 0U != t->usb_hz && t->usb_hz != usb ) )
+        {
+            r.wrong++;
+        }
+        printf( "# %s,%u Hz,%u Hz,M %u N %u P %u Q %u,%u usb Hz,%s\r\n",
+                t->name, (unsigned int)t->src_hz,
+                (unsigned int)t->sysclk_hz, (unsigned int)pll.pllm,
+                (unsigned int)pll.plln, (unsigned int)pll.pllp,
+                (unsigned int)pll.pllq, (unsigned int)usb,
+                ( 0U == r.wrong ) ? "ok" : "MISMATCH" );
+    }
+
+    // no output: refused before anything else
+    ret = clock_pll_solve( CLOCK_HSE_HZ, 100000000U, NULL );
+    printf( "# no_output,%s\r\n",
+            ( CLOCK_ERRORPARAMETER == ret ) ? "ok" : "MISMATCH" );
+}
+
+/**
+ * @brief: Print the line of a sweep or random result
+ *
+ * @param[in]  name: the line
+ * @param[in]  r:    its result
+ **/
+static void __print ( const char * const name, const bench_pll_result_t * r )
+{
+    printf( "# %s,%u targets,%u solved,%u unreachable,%u wrong,%s\r\n",
+            name, (unsigned int)r->targets, (unsigned int)r->solved,
+            (unsigned int)r->unreachable, (unsigned int)r->wrong,
+            ( 0U == r->wrong && 0U != r->solved && 0U != r->unreachable ) ?
+            "ok" : "MISMATCH" );
+}
+
+/**
+ * @brief: Run and print the sweep and the random targets
+ * @steps:
+ *      1. Every step of the sweep from every source
+ *      2. Random targets in Hz, half of them made from random dividers
+ **/
+static void __search_run ( void )
+{
+    bench_pll_result_t r        = {0};
+    clock_pll_t        pll;
+    uint32_t           sources  = sizeof( s_sources ) / sizeof( s_sources[0] );
+    uint32_t           src;
+    uint32_t           target;
+    uint64_t           div;
+
+    /***************** 1. Sweep ***************************/
+    for ( uint32_t s = 0; s < sources; ++s )
+    {
+        for ( uint32_t hz = BENCH_PLL_SWEEP_STEP_HZ;
+              hz <= BENCH_PLL_SWEEP_MAX_HZ; hz += BENCH_PLL_SWEEP_STEP_HZ )
+        {
+            (void)__check( s_sources[s], hz, &r, &pll );
+        }
+    }
+    __print( "sweep", &r );
+
+    /***************** 2. Random **************************/
+    r.targets     = 0U;
+    r.solved      = 0U;
+    r.unreachable = 0U;
+    r.wrong       = 0U;
+    for ( uint32_t i = 0; i < s_iterations; ++i )
+    {
+        src = s_sources[__rand() % sources];
+        if ( 0U == __rand() % 2U )
+        {
+            target = 1U + __rand() % BENCH_PLL_RANDOM_MAX_HZ;
+        }
+        else
+        {
+            // src * N / ( M * P ), rounded down when it does not divide
+            div    = (uint64_t)( BENCH_PLL_M_MIN +
+                                 __rand() % ( BENCH_PLL_M_MAX -
+                                              BENCH_PLL_M_MIN + 1U ) ) *
+                     ( 2U * ( 1U + __rand() % ( BENCH_PLL_P_MAX / 2U ) ) );
+            target = (uint32_t)( (uint64_t)src *
+                                 ( BENCH_PLL_N_MIN + __rand() %
+                                   ( BENCH_PLL_N_MAX - BENCH_PLL_N_MIN ) ) /
+                                 div );
+            target = ( 0U == target ) ? 1U : target;
+        }
+        (void)__check( src, target, &r, &pll );
+    }
+    __print( "random", &r );
+}
+
+/**
+ * @brief: Run and print the latency line
+ **/
+static void __latency_run ( void )
+{
+    uint32_t       wrong = 0U;
+    uint32_t       latency;
+    clock_status_t ret;
+
+    for ( uint32_t i = 0; i < sizeof( s_latency ) / sizeof( s_latency[0] );
+          ++i )
+    {
+        latency = 0xFFU;
+        ret     = clock_flash_latency( s_latency[i].hclk_hz, &latency );
+        if ( s_latency[i].status != ret ||
+             ( CLOCK_OK == ret && s_latency[i].latency != latency ) )
+        {
+            wrong++;
+        }
+    }
+    printf( "# latency,%u edges,%u wrong,%s\r\n",
+            (unsigned int)( sizeof( s_latency ) / sizeof( s_latency[0] ) ),
+            (unsigned int)wrong, ( 0U == wrong ) ? "ok" : "MISMATCH" );
+}
+
+/**
+ * @brief: Time a solve with an exact match and one without
+ **/
+static void __cost_run ( void )
+{
+    bench_stat_t stat[2];
+    clock_pll_t  pll;
+    uint32_t     t0;
+
+    bench_stat_reset( &stat[0] );
+    bench_stat_reset( &stat[1] );
+    for ( uint32_t i = 0; i < s_iterations; ++i )
+    {
+        t0 = bench_timestamp_get();
+        (void)clock_pll_solve( CLOCK_HSE_HZ, 100000000U, &pll );
+        bench_stat_add( &stat[0], bench_timestamp_get() - t0 );
+        t0 = bench_timestamp_get();
+        (void)clock_pll_solve( CLOCK_HSE_HZ, 100000001U, &pll );
+        bench_stat_add( &stat[1], bench_timestamp_get() - t0 );
+    }
+    bench_csv_row( BENCH_PLL_SUITE, "cpu", "solve", &stat[0] );
+    bench_csv_row( BENCH_PLL_SUITE, "cpu", "unreachable", &stat[1] );
+}
+
+/**
+ * @brief: Runner task, runs every line and deletes itself
+ *
+ * @param[in]  argument: Not used
+ **/
+static void bench_pll_task ( void * argument )
+{
+    (void)argument;
+
+    bench_csv_header( BENCH_PLL_SUITE );
+    __targets_run();
+    __search_run();
+    __latency_run();
+    __cost_run();
+
+    vTaskDelete( NULL );
+}
+
+/**
+ * @brief: Start the PLL suite
+ * @steps:
+ *      1. Start the timestamp source
+ *      2. Create the runner task, it prints the CSV report and deletes itself
+ *
+ * @param[in]  iterations: random targets and samples, 0 means default
+ *
+ * @return bench_status_t: execute result of this function
+ **/
+bench_status_t bench_pll_start ( uint32_t iterations )
+{
+    bench_status_t ret = BENCH_OK;
+
+    /************** 1. Start the timestamp source *************/
+    ret = bench_timestamp_init();
+    if ( BENCH_OK != ret )
+    {
+        LOG( LOG_LEVEL_ERR, "Bench timestamp init failed" );
+        return ret;
+    }
+    s_iterations = ( 0U == iterations ) ? BENCH_PLL_ITERATIONS : iterations;
+
+    /***************** 2. Create the runner ******************/
+    if ( pdPASS != xTaskCreate( bench_pll_task,
+                                "bench_pll",
+                                BENCH_PLL_STACK_WORDS,
+                                NULL,
+                                tskIDLE_PRIORITY + 1,
+                                NULL                   ) )
+    {
+        LOG( LOG_LEVEL_ERR, "Bench runner create failed" );
+        return BENCH_ERRORNOMEMORY;
+    }
+    return ret;
+}
+
+//******************************** Defines **********************************//
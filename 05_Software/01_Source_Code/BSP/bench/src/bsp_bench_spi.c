@@ -0,0 +1,688 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_bench_spi.c
+ *
+ * @par dependencies
+ * - bsp_bench_spi.h
+ * - bsp_spi.h
+ *
+ * @author Damian
+ *
+ * @brief Check the SPI bus manager against a mock DMA engine: order of the
+ *        chains, chip-select, set up of the devices, errors, cancel, and
+ *        measure its CPU cost and the time from a DMA end to the next start.
+ *
+ * Processing flow:
+ *
+ * Call directly.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+//******************************** Includes *********************************//
+
+#include "bsp_bench_spi.h"
+#include "bsp_common.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include <string.h>
+
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+#define BENCH_SPI_SUITE           "spi"
+#define BENCH_SPI_DEVICES         3U
+#define BENCH_SPI_NONE            0xFFFFFFFFU
+#define BENCH_SPI_ALL_BITS        ( ( 1UL << ( BENCH_SPI_USERS + 1U ) ) - 1U )
+
+typedef enum
+{
+    BENCH_SPI_SUBMIT_IDLE   = 0,
+    BENCH_SPI_SUBMIT_QUEUED = 1,
+    BENCH_SPI_DONE_NEXT     = 2,
+    BENCH_SPI_DONE_LAST     = 3,
+    BENCH_SPI_END_TO_START  = 4,
+    BENCH_SPI_COSTS         = 5,
+} bench_spi_cost_t;
+
+typedef struct
+{
+    spi_xfer_t            xfer[BENCH_SPI_CHAIN];
+    uint8_t               tx[BENCH_SPI_CHAIN][BENCH_SPI_BYTES];
+    uint8_t               rx[BENCH_SPI_CHAIN][BENCH_SPI_BYTES];
+    uint32_t              num;                        /* chain, 0: idle      */
+    uint32_t              seq;                        /* submit order        */
+    uint32_t              started;                    /* by the mock         */
+    uint32_t              fail_from;                  /* num: none fails     */
+} bench_spi_user_t;
+
+typedef struct
+{
+    //**************************** Running **********************************//
+    uint32_t              busy;                       /* a transfer runs     */
+    uint32_t              user;                       /* of the last start   */
+    uint32_t              index;
+    uint32_t              t_start;                    /* timestamp of it     */
+
+    //**************************** Lines ************************************//
+    uint32_t              cs_low;                     /* bit per line        */
+    uint32_t              mode;                       /* set up              */
+    uint32_t              hz;
+
+    //**************************** Counters *********************************//
+    uint32_t              selects;                    /* CS falling edges    */
+    uint32_t              configs;
+    uint32_t              stops;
+    uint32_t              resets;                     /* stops waited for    */
+    uint32_t              held;                       /* submitted meanwhile */
+    uint32_t              critical;                   /* nesting depth       */
+    uint32_t              chains;                     /* first ones started  */
+    uint32_t              fail_start;                 /* next start fails    */
+    uint32_t              bad;                        /* bus rules broken    */
+} bench_spi_mock_t;
+
+static const char * const s_cost_name[BENCH_SPI_COSTS] =
+{
+    "submit_idle", "submit_queued", "done_next", "done_last", "end_to_start",
+};
+
+static const spi_device_t s_devices[BENCH_SPI_DEVICES] =
+{
+    { 0U, SPI_MODE_0, 8000000U },             /* shift-register chain       */
+    { 1U, SPI_MODE_3, 1000000U },             /* another mode and clock     */
+    { 2U, SPI_MODE_0, 8000000U },             /* same set up as the first   */
+};
+
+static uint32_t          s_iterations = BENCH_SPI_ITERATIONS;
+static bsp_spi_t         s_bus        = { .is_initialized = SPI_NOT_INITED };
+static bsp_signal_t      s_signal = { .is_initialized = SIGNAL_NOT_INITED };
+static bench_spi_user_t  s_users[BENCH_SPI_USERS];
+static bench_spi_mock_t  s_mock;
+static bench_stat_t      s_cost[BENCH_SPI_COSTS];
+static uint32_t          s_seq;
+static uint32_t          s_gaps;                      /* queued, not started */
+static uint32_t          s_done_chains;
+static uint32_t          s_done_xfers;
+static uint32_t          s_failed;
+static uint32_t          s_cancelled;
+static uint32_t          s_rand = 0x2545F491U;
+
+/**
+ * @brief: xorshift32, the same sequence on target and host
+ *
+ * @return uint32_t: next pseudo random number
+ **/
+static uint32_t __rand ( void )
+{
+    s_rand ^= s_rand << 13;
+    s_rand ^= s_rand >> 17;
+    s_rand ^= s_rand << 5;
+    return s_rand;
+}
+
+/**
+ * @brief: Answer of the mock device to a byte
+ *
+ * @param[in]  out: byte clocked out, its index when nothing goes out
+ * @param[in]  cs:  chip-select line of the device
+ *
+ * @return uint8_t: byte clocked in
+ **/
+static uint8_t __answer ( uint32_t out, uint32_t cs )
+{
+    return (uint8_t)( out ^ ( 0xA5U + cs * 17U ) );
+}
+
+/**
+ * @brief: A random chain of a submitter on one device
+ *
+ * @param[in]  u: the submitter
+ **/
+static void __build ( uint32_t u )
+{
+    bench_spi_user_t   * user = &s_users[u];
+    const spi_device_t * dev  = &s_devices[__rand() % BENCH_SPI_DEVICES];
+    spi_xfer_t         * x;
+    uint32_t             kind;
+
+    user->num       = 1U + __rand() % BENCH_SPI_CHAIN;
+    user->seq       = s_seq++;
+    user->started   = 0U;
+    user->fail_from = user->num;
+    for ( uint32_t k = 0; k < user->num; ++k )
+    {
+        x       = &user->xfer[k];
+        kind    = __rand() % 4U;
+        x->next = ( k + 1U < user->num ) ? &user->xfer[k + 1U] : NULL;
+        x->device = dev;
+        x->tx     = ( 0U == kind ) ? NULL : user->tx[k];
+        x->rx     = ( 1U == kind ) ? NULL : user->rx[k];
+        x->len    = 1U + __rand() % BENCH_SPI_BYTES;
+        // the flag of the last one of a chain is ignored
+        x->flags  = SPI_XFER_KEEP_CS;
+        x->signal = ( NULL == x->next ) ? &s_signal : NULL;
+        x->bits   = 1UL << u;
+        for ( uint32_t i = 0; i < BENCH_SPI_BYTES; ++i )
+        {
+            user->tx[k][i] = (uint8_t)__rand();
+            user->rx[k][i] = 0U;
+        }
+    }
+}
+
+//******************************** Mock *************************************//
+
+static spi_status_t __mock_configure ( spi_mode_t mode, uint32_t max_hz )
+{
+    if ( 0U != s_mock.cs_low ||
+         ( (uint32_t)mode == s_mock.mode && max_hz == s_mock.hz ) )
+    {
+        s_mock.bad++;
+    }
+    s_mock.mode = (uint32_t)mode;
+    s_mock.hz   = max_hz;
+    s_mock.configs++;
+    return SPI_OK;
+}
+
+static spi_status_t __mock_cs ( uint32_t cs, uint32_t active )
+{
+    uint32_t bit = 1UL << cs;
+
+    if ( 0U != active )
+    {
+        s_mock.bad     += ( 0U != ( s_mock.cs_low & bit ) ) ? 1U : 0U;
+        s_mock.cs_low  |= bit;
+        s_mock.selects++;
+    }
+    else
+    {
+        s_mock.bad     += ( 0U == ( s_mock.cs_low & bit ) ) ? 1U : 0U;
+        s_mock.cs_low  &= ~bit;
+    }
+    return SPI_OK;
+}
+
+/**
+ * @brief: Submitter that started no chain yet, the first one submitted
+ *
+ * @return uint32_t: the user, BENCH_SPI_NONE when none waits
+ **/
+static uint32_t __oldest ( void )
+{
+    uint32_t user = BENCH_SPI_NONE;
+
+    for ( uint32_t u = 0; u < BENCH_SPI_USERS; ++u )
+    {
+        if ( 0U != s_users[u].num && 0U == s_users[u].started &&
+             s_users[u].fail_from == s_users[u].num &&
+             ( BENCH_SPI_NONE == user || s_users[u].seq < s_users[user].seq ) )
+        {
+            user = u;
+        }
+    }
+    return user;
+}
+
+/**
+ * @brief: Start of a transfer: which one, in order, on the right device
+ **/
+static spi_status_t __mock_dma_start ( const uint8_t * const tx,
+                                       uint8_t       * const rx,
+                                       uint32_t              len )
+{
+    const spi_device_t * dev;
+    uint32_t             u;
+    uint32_t             k = 0U;
+
+    for ( u = 0; u < BENCH_SPI_USERS; ++u )
+    {
+        for ( k = 0; k < s_users[u].num; ++k )
+        {
+            if ( tx == s_users[u].xfer[k].tx && rx == s_users[u].xfer[k].rx )
+            {
+                break;
+            }
+        }
+        if ( k < s_users[u].num )
+        {
+            break;
+        }
+    }
+    if ( BENCH_SPI_USERS == u || len != s_users[u].xfer[k].len )
+    {
+        s_mock.bad++;
+        return SPI_ERROR;
+    }
+
+    // no abort settling, one chip-select low, the one of the device, in
+    // its mode and clock
+    dev = s_users[u].xfer[k].device;
+    if ( 0U != s_mock.busy || s_mock.stops != s_mock.resets ||
+         ( 1UL << dev->cs ) != s_mock.cs_low ||
+         (uint32_t)dev->mode != s_mock.mode || dev->max_hz != s_mock.hz )
+    {
+        s_mock.bad++;
+    }
+
+    // a chain starts in submit order, goes on without another in between
+    if ( 0U == k )
+    {
+        s_mock.bad += ( __oldest() != u ) ? 1U : 0U;
+        s_mock.chains++;
+    }
+    else if ( s_mock.user != u || s_mock.index + 1U != k )
+    {
+        s_mock.bad++;
+    }
+    s_mock.user         = u;
+    s_mock.index        = k;
+    s_users[u].started  = k + 1U;
+
+    if ( 0U != s_mock.fail_start )
+    {
+        s_mock.fail_start    = 0U;
+        s_users[u].fail_from = k;
+        return SPI_ERROR;
+    }
+    s_mock.busy    = 1U;
+    s_mock.t_start = bench_timestamp_get();
+    return SPI_OK;
+}
+
+static spi_status_t __mock_dma_stop ( void )
+{
+    // switched off inside the critical section, the wait comes after
+    s_mock.bad += ( 0U == s_mock.critical ||
+                    s_mock.stops != s_mock.resets ) ? 1U : 0U;
+    s_mock.busy = 0U;
+    s_mock.stops++;
+    return SPI_OK;
+}
+
+static spi_status_t __mock_dma_reset ( void )
+{
+    // waits outside the critical section, once per stop
+    s_mock.bad += ( 0U != s_mock.critical ||
+                    s_mock.stops != s_mock.resets + 1U ) ? 1U : 0U;
+
+    // another task submits while the streams settle: queued, not started
+    for ( uint32_t u = 0; u < BENCH_SPI_USERS; ++u )
+    {
+        if ( 0U == s_users[u].num )
+        {
+            __build( u );
+            s_mock.bad += ( SPI_OK != spi_submit( &s_bus,
+                                                  &s_users[u].xfer[0] ) ) ?
+                          1U : 0U;
+            s_mock.held++;
+            break;
+        }
+    }
+    s_mock.resets++;
+    return SPI_OK;
+}
+
+static bsp_status_t __mock_critical_enter ( void )
+{
+    // the runner plays the interrupt itself, nothing to mask
+    s_mock.critical++;
+    return BSP_OK;
+}
+
+static bsp_status_t __mock_critical_exit ( void )
+{
+    s_mock.critical--;
+    return BSP_OK;
+}
+
+static spi_hw_operation_t s_mock_ops =
+{
+    .pf_spi_configure = __mock_configure,
+    .pf_spi_cs        = __mock_cs,
+    .pf_spi_dma_start = __mock_dma_start,
+    .pf_spi_dma_stop  = __mock_dma_stop,
+    .pf_spi_dma_reset = __mock_dma_reset,
+};
+
+static os_critical_t s_mock_critical =
+{
+    .pf_os_critical_enter = __mock_critical_enter,
+    .pf_os_critical_exit  = __mock_critical_exit,
+};
+
+//******************************** Mock *************************************//
+
+/**
+ * @brief: End the running transfer as the DMA interrupt would
+ *
+ * @param[in]  ok: 1 complete, 0 error
+ **/
+static void __pump ( uint32_t ok )
+{
+    bench_spi_user_t * user;
+    spi_xfer_t       * x;
+    uint32_t           t0;
+    uint32_t           t1;
+
+    if ( 0U == s_mock.busy )
+    {
+        return;
+    }
+    user = &s_users[s_mock.user];
+    x    = &user->xfer[s_mock.index];
+    for ( uint32_t i = 0; 0U != ok && NULL != x->rx && i < x->len; ++i )
+    {
+        x->rx[i] = __answer( ( NULL != x->tx ) ? x->tx[i] : i,
+                             x->device->cs                   );
+    }
+    if ( 0U == ok && s_mock.index < user->fail_from )
+    {
+        user->fail_from = s_mock.index;
+    }
+    s_mock.busy = 0U;
+
+    t0 = bench_timestamp_get();
+    spi_dma_done_isr( &s_bus, ok );
+    t1 = bench_timestamp_get();
+
+    if ( 0U != s_mock.busy )
+    {
+        bench_stat_add( &s_cost[BENCH_SPI_DONE_NEXT], t1 - t0 );
+        bench_stat_add( &s_cost[BENCH_SPI_END_TO_START],
+                        s_mock.t_start - t0                );
+    }
+    else
+    {
+        bench_stat_add( &s_cost[BENCH_SPI_DONE_LAST], t1 - t0 );
+        s_gaps += ( NULL != s_bus.head ) ? 1U : 0U;
+    }
+}
+
+/**
+ * @brief: Build and queue a chain, time spi_submit
+ *
+ * @param[in]  u: the submitter
+ **/
+static void __submit ( uint32_t u )
+{
+    bench_spi_cost_t cost = ( NULL == s_bus.head ) ? BENCH_SPI_SUBMIT_IDLE :
+                                                     BENCH_SPI_SUBMIT_QUEUED;
+    uint32_t         t0;
+    spi_status_t     ret;
+
+    __build( u );
+    t0  = bench_timestamp_get();
+    ret = spi_submit( &s_bus, &s_users[u].xfer[0] );
+    bench_stat_add( &s_cost[cost], bench_timestamp_get() - t0 );
+    s_mock.bad += ( SPI_OK != ret ) ? 1U : 0U;
+}
+
+/**
+ * @brief: Cancel the chain of a submitter, done or not
+ *
+ * @param[in]  u: the submitter
+ **/
+static void __cancel ( uint32_t u )
+{
+    bench_spi_user_t * user = &s_users[u];
+    uint32_t           done = 0U;
+
+    while ( done < user->num && 0U != user->xfer[done].done )
+    {
+        ++done;
+    }
+    if ( SPI_OK == spi_cancel( &s_bus, &user->xfer[0] ) )
+    {
+        user->fail_from = ( done < user->fail_from ) ? done : user->fail_from;
+        s_cancelled++;
+    }
+}
+
+/**
+ * @brief: Check the chains done: status, answers, nothing run after a
+ *         failure; the submitter is idle again
+ **/
+static void __collect ( void )
+{
+    bench_spi_user_t * user;
+    spi_xfer_t       * x;
+    uint32_t           k;
+
+    for ( uint32_t u = 0; u < BENCH_SPI_USERS; ++u )
+    {
+        user = &s_users[u];
+        for ( k = 0; k < user->num && 0U != user->xfer[k].done; ++k )
+        {
+        }
+        if ( 0U == user->num || k < user->num )
+        {
+            continue;
+        }
+        for ( k = 0; k < user->num; ++k )
+        {
+            x = &user->xfer[k];
+            if ( k < user->fail_from )
+            {
+                s_mock.bad += ( SPI_OK != x->status ) ? 1U : 0U;
+                for ( uint32_t i = 0; NULL != x->rx && i < x->len; ++i )
+                {
+                    s_mock.bad += ( x->rx[i] !=
+                                    __answer( ( NULL != x->tx ) ? x->tx[i] : i,
+                                              x->device->cs ) ) ? 1U : 0U;
+                }
+            }
+            else
+            {
+                // nothing of the chain started after the failed one
+                s_mock.bad += ( SPI_ERROR != x->status ||
+                                ( k > user->fail_from &&
+                                  k < user->started ) ) ? 1U : 0U;
+                s_failed++;
+            }
+        }
+        s_done_xfers += user->num;
+        s_done_chains++;
+        user->num = 0U;
+    }
+}
+
+/**
+ * @brief: Submitters, engine ends, errors and cancels in random order
+ **/
+static void __check ( void )
+{
+    uint32_t r;
+    uint32_t u;
+
+    for ( uint32_t i = 0; i < s_iterations; ++i )
+    {
+        r = __rand() % 32U;
+        u = __rand() % BENCH_SPI_USERS;
+        if ( r < 10U )
+        {
+            if ( 0U == s_users[u].num )
+            {
+                __submit( u );
+            }
+        }
+        else if ( r < 29U )
+        {
+            __pump( ( 0U != __rand() % 32U ) ? 1U : 0U );
+        }
+        else if ( r < 30U )
+        {
+            s_mock.fail_start = 1U;
+        }
+        else if ( 0U != s_users[u].num )
+        {
+            __cancel( u );
+        }
+        __collect();
+    }
+
+    // drain: everything queued ends, the lines go high
+    s_mock.fail_start = 0U;
+    while ( 0U != s_mock.busy )
+    {
+        __pump( 1U );
+        __collect();
+    }
+    for ( u = 0; u < BENCH_SPI_USERS; ++u )
+    {
+        s_mock.bad += ( 0U != s_users[u].num ) ? 1U : 0U;
+    }
+    s_mock.bad += ( NULL != s_bus.head || 0U != s_mock.cs_low ||
+                    s_mock.selects != s_mock.chains ||
+                    s_mock.stops != s_mock.resets || 0U != s_mock.critical ||
+                    s_mock.configs != s_bus.reconfigs ||
+                    s_bus.xfers + s_bus.errors != s_done_xfers ||
+                    s_bus.errors != s_failed ) ? 1U : 0U;
+
+    printf( "# check,%u chains,%u transfers,%u failed,%u cancelled,"
+            "%u aborts,%u held,%u set ups,%u gaps,%s\r\n",
+            (unsigned int)s_done_chains, (unsigned int)s_done_xfers,
+            (unsigned int)s_failed, (unsigned int)s_cancelled,
+            (unsigned int)s_mock.resets, (unsigned int)s_mock.held,
+            (unsigned int)s_bus.reconfigs, (unsigned int)s_gaps,
+            ( 0U == s_mock.bad && 0U == s_gaps ) ? "ok" : "MISMATCH" );
+}
+
+/**
+ * @brief: spi_transfer behind a chain that never ends: timeout, cancelled
+ *         before it started; the chain after it runs once the first one
+ *         is cancelled
+ **/
+static void __timeout ( void )
+{
+    uint32_t     bad  = s_mock.bad;
+    uint32_t     ok   = 1U;
+    uint32_t     bits = 0U;
+    spi_status_t ret;
+
+    // bits of the chains before, a transfer would take them as its end
+    signal_wait( &s_signal, BENCH_SPI_ALL_BITS, 0U, &bits );
+
+    __submit( 0U );
+    __build( 1U );
+    ret = spi_transfer( &s_bus, &s_users[1].xfer[0], 1U );
+    ok &= ( SPI_ERRORTIMEOUT == ret && 0U == s_users[1].started ) ? 1U : 0U;
+    s_users[1].fail_from = 0U;
+    __collect();
+
+    __submit( 2U );
+    __cancel( 0U );
+    ok &= ( 0U != s_users[2].started ) ? 1U : 0U;
+    while ( 0U != s_mock.busy )
+    {
+        __pump( 1U );
+    }
+    __collect();
+    ok &= ( bad == s_mock.bad && 0U == s_users[0].num &&
+            0U == s_users[1].num && 0U == s_users[2].num ) ? 1U : 0U;
+    printf( "# timeout,%s\r\n", ( 0U != ok ) ? "ok" : "MISMATCH" );
+}
+
+#ifndef BENCH_HOST_POSIX
+/**
+ * @brief: The end of the last transfer of a chain notifies its submitter
+ **/
+static void __notify ( void )
+{
+    uint32_t bits = 0U;
+    uint32_t ok;
+
+    // bits of the chains before
+    signal_wait( &s_signal, BENCH_SPI_ALL_BITS, 0U, &bits );
+
+    __submit( 0U );
+    while ( 0U != s_mock.busy )
+    {
+        __pump( 1U );
+    }
+    ok = ( SIGNAL_OK == signal_wait( &s_signal, 1UL << 0, 0U, &bits ) &&
+           ( 1UL << 0 ) == bits ) ? 1U : 0U;
+    __collect();
+    printf( "# notify,%s\r\n", ( 0U != ok ) ? "ok" : "MISMATCH" );
+}
+#endif /* BENCH_HOST_POSIX */
+
+/**
+ * @brief: Runner task, runs every check and deletes itself
+ *
+ * @param[in]  argument: Not used
+ **/
+static void bench_spi_task ( void * argument )
+{
+    (void)argument;
+
+    signal_instantiate( &s_signal, xTaskGetCurrentTaskHandle() );
+    bench_csv_header( BENCH_SPI_SUITE );
+    __check();
+    __timeout();
+#ifndef BENCH_HOST_POSIX
+    __notify();
+#endif /* BENCH_HOST_POSIX */
+    for ( uint32_t c = 0; c < BENCH_SPI_COSTS; ++c )
+    {
+        bench_csv_row( BENCH_SPI_SUITE, "cpu", s_cost_name[c], &s_cost[c] );
+    }
+
+    vTaskDelete( NULL );
+}
+
+/**
+ * @brief: Start the SPI suite
+ * @steps:
+ *      1. Start the timestamp source
+ *      2. Create the runner task, it prints the CSV report and deletes itself
+ *
+ * @param[in]  iterations: random steps of the check, 0 means default
+ *
+ * @return bench_status_t: execute result of this function
+ **/
+bench_status_t bench_spi_start ( uint32_t iterations )
+{
+    bench_status_t ret = BENCH_OK;
+
+    /************** 1. Start the timestamp source *************/
+    ret = bench_timestamp_init();
+    if ( BENCH_OK != ret )
+    {
+        LOG( LOG_LEVEL_ERR, "Bench timestamp init failed" );
+        return ret;
+    }
+    s_iterations = ( 0U == iterations ) ? BENCH_SPI_ITERATIONS : iterations;
+    if ( SPI_INITED != s_bus.is_initialized &&
+         SPI_OK != spi_bus_inst( &s_bus, &s_mock_ops, &s_mock_critical ) )
+    {
+        return BENCH_ERROR;
+    }
+    memset( &s_mock, 0, sizeof( s_mock ) );
+    for ( uint32_t c = 0; c < BENCH_SPI_COSTS; ++c )
+    {
+        bench_stat_reset( &s_cost[c] );
+    }
+
+    /***************** 2. Create the runner ******************/
+    if ( pdPASS != xTaskCreate( bench_spi_task,
+                                "bench_spi",
+                                BENCH_SPI_STACK_WORDS,
+                                NULL,
+                                tskIDLE_PRIORITY + 1,
+                                NULL                  ) )
+    {
+        LOG( LOG_LEVEL_ERR, "Bench SPI task create failed" );
+        return BENCH_ERROR;
+    }
+    return BENCH_OK;
+}
+
+//******************************** Defines **********************************//
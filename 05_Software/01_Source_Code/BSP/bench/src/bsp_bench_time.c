@@ -0,0 +1,464 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_bench_time.c
+ *
+ * @par dependencies
+ * - bsp_bench_time.h
+ * - bsp_time.h
+ *
+ * @author Damian
+ *
+ * @brief Check the time service across wraps of the 32-bit cycle counter,
+ *        with the tick interrupt and clock changes preempting its readers,
+ *        and measure the cost of a read.
+ *
+ * Processing flow:
+ *
+ * Call directly.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+//******************************** Includes *********************************//
+
+#include "bsp_bench_time.h"
+#include "bsp_common.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+#ifndef BENCH_HOST_POSIX
+#include "main.h"
+#endif /* BENCH_HOST_POSIX */
+
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+#define BENCH_TIME_SUITE          "time"
+#define BENCH_TIME_HALF_WRAP      0x80000000ULL /* a step this long: a wrap
+                                                   taken twice or missed   */
+#define BENCH_TIME_READS_MAX      20000000U     /* target: the wrap never
+                                                   came, CYCCNT not moved  */
+
+#ifdef BENCH_HOST_POSIX
+#define BENCH_TIME_STEP_MAX       ( 1UL << 24 ) /* cycles per counter read */
+#define BENCH_TIME_TICK_MAX       ( 1ULL << 28 )/* a tick at least every   */
+#define BENCH_TIME_WRAPS          64U           /* of every line           */
+#else
+#define BENCH_TIME_WRAPS          1U            /* of the wrap line        */
+#endif /* BENCH_HOST_POSIX */
+
+typedef enum
+{
+    BENCH_TIME_WRAP  = 0,                       /* ticks between reads     */
+    BENCH_TIME_RACE  = 1,                       /* ticks inside the reads  */
+    BENCH_TIME_CLOCK = 2,                       /* rebases inside them too */
+} bench_time_mode_t;
+
+typedef struct
+{
+    uint32_t              reads;                  /* cycles and us read      */
+    uint32_t              wraps;                  /* of the 32-bit counter   */
+    uint32_t              preempted;              /* reads a tick ran inside */
+    uint32_t              rebases;                /* time_set_core_clock     */
+    uint32_t              back;                   /* before the read before  */
+    uint32_t              jumps;                  /* half a wrap after it    */
+    uint32_t              wrong;                  /* host: not the count     */
+} bench_time_result_t;
+
+static const char * const s_mode_name[] =
+{
+    "wrap", "race", "clock",
+};
+
+static uint32_t             s_iterations = BENCH_TIME_ITERATIONS;
+
+#ifdef BENCH_HOST_POSIX
+/* the core clock of the time service, changed by the clock line */
+uint32_t SystemCoreClock = 100000000U;
+
+static const uint32_t       s_clock_hz[] =
+{
+    16000000U, 25000000U, 48000000U, 84000000U, 100000000U,
+};
+
+static uint32_t             s_rand = 0x2545F491U;
+
+// the counter: low half of s_truth, 0 when time_init takes it
+static uint64_t             s_truth;
+static uint64_t             s_read;                /* s_truth, last read    */
+static uint32_t             s_step    = BENCH_TIME_STEP_MAX;
+static uint64_t             s_tick_at;             /* s_read of the tick    */
+static uint32_t             s_ticks;
+static uint32_t             s_rebases;
+static bench_time_mode_t    s_mode;
+static uint32_t             s_armed;               /* a read of the runner  */
+static uint32_t             s_inside;              /* a preemption running  */
+
+// what time_get_us has to return: the base of the last rebase
+static uint64_t             s_m_cyc_base;
+static uint64_t             s_m_us_base;
+static uint32_t             s_m_cyc_per_us;
+
+static uint32_t __rand ( void )
+{
+    s_rand ^= s_rand << 13;
+    s_rand ^= s_rand >> 17;
+    s_rand ^= s_rand << 5;
+    return s_rand;
+}
+
+/**
+ * @brief: The tick interrupt, from the runner or inside a read
+ **/
+static void __tick ( void )
+{
+    time_tick_isr();
+    s_tick_at = s_read;
+    s_ticks++;
+}
+
+/**
+ * @brief: A core clock change, the base of the model moves with it
+ *
+ * @param[in]  hz: new core clock
+ **/
+static void __rebase ( uint32_t hz )
+{
+    SystemCoreClock = hz;
+    time_set_core_clock( hz );
+    // the last read of the counter was the one of the rebase
+    s_m_us_base    += ( s_read - s_m_cyc_base ) / s_m_cyc_per_us;
+    s_m_cyc_base    = s_read;
+    s_m_cyc_per_us  = hz / 1000000U;
+    s_rebases++;
+}
+
+/**
+ * @brief: The interrupts of the line, once per read of the runner
+ **/
+static void __preempt ( void )
+{
+    s_inside = 1U;
+    if ( BENCH_TIME_WRAP != s_mode &&
+         ( 0U == __rand() % 2U || s_truth - s_tick_at > BENCH_TIME_TICK_MAX ) )
+    {
+        __tick();
+    }
+    if ( BENCH_TIME_CLOCK == s_mode && 0U == __rand() % 8U )
+    {
+        __rebase( s_clock_hz[__rand() % ( sizeof( s_clock_hz ) /
+                                          sizeof( s_clock_hz[0] ) )] );
+    }
+    s_inside = 0U;
+}
+
+/**
+ * @brief: CYCCNT of the time service: time passes; a read of the runner
+ *         is preempted right before the counter is sampled, time passing
+ *         in the interrupts, or right after it
+ *
+ * @return uint32_t: the counter
+ **/
+uint32_t bench_time_cyccnt ( void )
+{
+    uint32_t preempt = ( 0U != s_armed && 0U == s_inside ) ? 1U : 0U;
+    uint32_t after   = ( 0U != preempt ) ? ( __rand() & 1U ) : 0U;
+    uint64_t sample;
+
+    s_truth += ( 0U != s_step ) ? __rand() % s_step : 0U;
+    if ( 0U != preempt && 0U == after )
+    {
+        __preempt();
+        s_truth += ( 0U != s_step ) ? __rand() % s_step : 0U;
+    }
+    sample = s_truth;
+    if ( 0U != after )
+    {
+        __preempt();
+    }
+    s_read = sample;
+    return (uint32_t)sample;
+}
+
+/**
+ * @brief: Model from a rebase with the counter held still
+ **/
+static void __anchor ( void )
+{
+    s_step = 0U;
+    time_set_core_clock( SystemCoreClock );
+    s_m_cyc_base   = s_read;
+    s_m_cyc_per_us = SystemCoreClock / 1000000U;
+    s_m_us_base    = time_get_us();
+    s_step         = BENCH_TIME_STEP_MAX;
+}
+
+static uint32_t __ticks ( void )
+{
+    return s_ticks;
+}
+
+static uint32_t __rebases ( void )
+{
+    return s_rebases;
+}
+#else
+static uint32_t             s_rebases;
+
+/**
+ * @brief: CYCCNT forward to BENCH_TIME_LEAD_MS before its wrap
+ **/
+static void __jump ( void )
+{
+    uint32_t lead    = ( SystemCoreClock / 1000U ) * BENCH_TIME_LEAD_MS;
+    uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+    if ( DWT->CYCCNT < 0U - lead )
+    {
+        DWT->CYCCNT = 0U - lead;
+    }
+    __set_PRIMASK( primask );
+}
+
+static uint32_t __ticks ( void )
+{
+    return HAL_GetTick();
+}
+
+static uint32_t __rebases ( void )
+{
+    return s_rebases;
+}
+#endif /* BENCH_HOST_POSIX */
+
+/**
+ * @brief: Read cycles and microseconds once and check them
+ * @steps:
+ *      1. Read, the preemptions of the line may run inside; host: the
+ *         exact count and microseconds
+ *      2. Against the read before: monotonic, no wrap missed or doubled
+ *
+ * @param[in]  r:      result of the line
+ * @param[in]  prev_c: cycles of the read before, updated
+ * @param[in]  prev_u: microseconds of the read before, updated
+ **/
+static void __read ( bench_time_result_t * const r,
+                     uint64_t            * const prev_c,
+                     uint64_t            * const prev_u )
+{
+    uint32_t ticks   = __ticks();
+    uint32_t rebases = __rebases();
+    uint64_t c;
+    uint64_t u;
+
+    /***************** 1. Read ****************************/
+#ifdef BENCH_HOST_POSIX
+    s_armed = 1U;
+    c       = time_get_cycles();
+    r->wrong += ( c != s_read ) ? 1U : 0U;
+    u       = time_get_us();
+    r->wrong += ( u != s_m_us_base + ( s_read - s_m_cyc_base ) /
+                       s_m_cyc_per_us ) ? 1U : 0U;
+    s_armed = 0U;
+#else
+    c = time_get_cycles();
+    u = time_get_us();
+#endif /* BENCH_HOST_POSIX */
+
+    /***************** 2. Against the read before *********/
+    r->preempted += ( ticks != __ticks() ) ? 1U : 0U;
+    r->rebases   += __rebases() - rebases;
+    if ( c < *prev_c || u < *prev_u )
+    {
+        r->back++;
+    }
+    else if ( c - *prev_c >= BENCH_TIME_HALF_WRAP )
+    {
+        r->jumps++;
+    }
+    r->wraps += ( ( c >> 32 ) != ( *prev_c >> 32 ) ) ? 1U : 0U;
+    r->reads++;
+    *prev_c = c;
+    *prev_u = u;
+}
+
+/**
+ * @brief: Run and print one line
+ * @steps:
+ *      1. Host: model from a rebase; target: the counter before its wrap
+ *      2. Read until the reads and the wraps of the line are done
+ *      3. Check and print
+ *
+ * @param[in]  mode: the line
+ **/
+static void __line ( bench_time_mode_t mode )
+{
+    bench_time_result_t r = {0};
+    uint64_t            prev_c;
+    uint64_t            prev_u;
+    uint32_t            wraps = BENCH_TIME_WRAPS;
+    uint32_t            ok;
+
+    /***************** 1. Set up **************************/
+#ifdef BENCH_HOST_POSIX
+    s_mode = mode;
+    __anchor();
+#else
+    if ( BENCH_TIME_WRAP == mode )
+    {
+        __jump();
+    }
+    else
+    {
+        wraps = 0U;
+    }
+#endif /* BENCH_HOST_POSIX */
+    prev_c = time_get_cycles();
+    prev_u = time_get_us();
+
+    /***************** 2. Read ****************************/
+    while ( r.reads < s_iterations ||
+            ( r.wraps < wraps && r.reads < BENCH_TIME_READS_MAX ) )
+    {
+        __read( &r, &prev_c, &prev_u );
+#ifdef BENCH_HOST_POSIX
+        if ( BENCH_TIME_WRAP == mode &&
+             s_truth - s_tick_at > BENCH_TIME_TICK_MAX )
+        {
+            __tick();
+        }
+#else
+        if ( BENCH_TIME_CLOCK == mode && 0U == r.reads % 1000U )
+        {
+            time_set_core_clock( SystemCoreClock );
+            s_rebases++;
+        }
+#endif /* BENCH_HOST_POSIX */
+    }
+
+    /***************** 3. Check ***************************/
+    ok = ( 0U == r.back && 0U == r.jumps && 0U == r.wrong &&
+           r.wraps >= wraps                                ) ? 1U : 0U;
+#ifdef BENCH_HOST_POSIX
+    if ( ( BENCH_TIME_WRAP != mode && 0U == r.preempted ) ||
+         ( BENCH_TIME_CLOCK == mode && 0U == r.rebases  ) )
+    {
+        ok = 0U;
+    }
+#endif /* BENCH_HOST_POSIX */
+    printf( "# %s,%u reads,%u wraps,%u preempted,%u rebases,%u back,"
+            "%u jumps,%u wrong,%s\r\n",
+            s_mode_name[mode], (unsigned int)r.reads,
+            (unsigned int)r.wraps, (unsigned int)r.preempted,
+            (unsigned int)r.rebases, (unsigned int)r.back,
+            (unsigned int)r.jumps, (unsigned int)r.wrong,
+            ( 0U != ok ) ? "ok" : "MISMATCH" );
+}
+
+/**
+ * @brief: Time the reads and the tick, nothing preempting on the host
+ **/
+static void __cost_run ( void )
+{
+    bench_stat_t stat[4];
+    uint32_t     t0;
+
+#ifdef BENCH_HOST_POSIX
+    s_mode = BENCH_TIME_WRAP;
+#endif /* BENCH_HOST_POSIX */
+    for ( uint32_t c = 0; c < 4U; ++c )
+    {
+        bench_stat_reset( &stat[c] );
+    }
+    for ( uint32_t i = 0; i < s_iterations; ++i )
+    {
+        t0 = bench_timestamp_get();
+        (void)time_get_cycles();
+        bench_stat_add( &stat[0], bench_timestamp_get() - t0 );
+        t0 = bench_timestamp_get();
+        (void)time_get_us();
+        bench_stat_add( &stat[1], bench_timestamp_get() - t0 );
+        t0 = bench_timestamp_get();
+        (void)time_get_ms();
+        bench_stat_add( &stat[2], bench_timestamp_get() - t0 );
+        t0 = bench_timestamp_get();
+        time_tick_isr();
+        bench_stat_add( &stat[3], bench_timestamp_get() - t0 );
+    }
+    bench_csv_row( BENCH_TIME_SUITE, "cpu", "cycles", &stat[0] );
+    bench_csv_row( BENCH_TIME_SUITE, "cpu", "us", &stat[1] );
+    bench_csv_row( BENCH_TIME_SUITE, "cpu", "ms", &stat[2] );
+    bench_csv_row( BENCH_TIME_SUITE, "cpu", "tick_isr", &stat[3] );
+}
+
+/**
+ * @brief: Runner task, runs every line and deletes itself
+ *
+ * @param[in]  argument: Not used
+ **/
+static void bench_time_task ( void * argument )
+{
+    (void)argument;
+
+    bench_csv_header( BENCH_TIME_SUITE );
+    __line( BENCH_TIME_WRAP );
+    __line( BENCH_TIME_RACE );
+    __line( BENCH_TIME_CLOCK );
+    __cost_run();
+
+    vTaskDelete( NULL );
+}
+
+/**
+ * @brief: Start the time suite
+ * @steps:
+ *      1. Start the timestamp source
+ *      2. Create the runner task, it prints the CSV report and deletes itself
+ *
+ * @param[in]  iterations: reads of a line at least, 0 means default
+ *
+ * @return bench_status_t: execute result of this function
+ **/
+bench_status_t bench_time_start ( uint32_t iterations )
+{
+    bench_status_t ret = BENCH_OK;
+
+    /************** 1. Start the timestamp source *************/
+    ret = bench_timestamp_init();
+    if ( BENCH_OK != ret )
+    {
+        LOG( LOG_LEVEL_ERR, "Bench timestamp init failed" );
+        return ret;
+    }
+    s_iterations = ( 0U == iterations ) ? BENCH_TIME_ITERATIONS : iterations;
+#ifdef BENCH_HOST_POSIX
+    // the service of the host reads the counter of the suite
+    if ( TIME_OK != time_init() )
+    {
+        return BENCH_ERRORSOURCE;
+    }
+#endif /* BENCH_HOST_POSIX */
+
+    /***************** 2. Create the runner ******************/
+    if ( pdPASS != xTaskCreate( bench_time_task,
+                                "bench_time",
+                                BENCH_TIME_STACK_WORDS,
+                                NULL,
+                                tskIDLE_PRIORITY + 1,
+                                NULL                   ) )
+    {
+        LOG( LOG_LEVEL_ERR, "Bench runner create failed" );
+        return BENCH_ERRORNOMEMORY;
+    }
+    return ret;
+}
+
+//******************************** Defines **********************************//
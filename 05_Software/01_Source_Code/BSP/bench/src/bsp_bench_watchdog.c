@@ -0,0 +1,491 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_bench_watchdog.c
+ *
+ * @par dependencies
+ * - bsp_bench_watchdog.h
+ * - bsp_watchdog.h
+ *
+ * @author Damian
+ *
+ * @brief Check the watchdog supervisor against a simulated watchdog and
+ *        measure the cost of a check-in and of a supervisor round.
+ *
+ * Processing flow:
+ *
+ * Call directly.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+//******************************** Includes *********************************//
+
+#include "bsp_bench_watchdog.h"
+#include "bsp_watchdog.h"
+#include "bsp_common.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include <string.h>
+
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+#define BENCH_WATCHDOG_SUITE      "watchdog"
+#define BENCH_WDG_PERIOD_MS       100U    /* supervisor period of the sim    */
+#define BENCH_WDG_TIMEOUT_MS      1000U   /* simulated watchdog timeout      */
+#define BENCH_WDG_RUN_MS          10000U  /* simulated time per scenario     */
+#define BENCH_WDG_CLIENTS         3U      /* clients of a scenario           */
+#define BENCH_WDG_NEVER           0xFFFFFFFFU
+
+typedef struct
+{
+    uint32_t              interval_ms;            /* check-in every          */
+    uint32_t              stop_ms;                /* no check-in from        */
+    uint32_t              resume_ms;              /* check-ins again from    */
+} bench_wdg_schedule_t;
+
+typedef struct
+{
+    const char            * name;                 /* scenario                */
+    bench_wdg_schedule_t  client[BENCH_WDG_CLIENTS];
+    uint32_t              expect_starved;         /* bitmap of the clients   */
+} bench_wdg_scenario_t;
+
+typedef struct
+{
+    uint32_t              starved;                /* bitmap at the end       */
+    uint32_t              flag_ms[BENCH_WDG_CLIENTS]; /* round flagging it   */
+    uint32_t              last_ms[BENCH_WDG_CLIENTS]; /* last real check-in  */
+    uint32_t              first_flag_ms;          /* first starved round     */
+    uint32_t              reset_ms;               /* simulated expiry        */
+    uint32_t              late_kicks;             /* kicks after a starve    */
+} bench_wdg_result_t;
+
+/* the same three clients in every scenario, deadlines in ms */
+static const char * const s_client_name[BENCH_WDG_CLIENTS] =
+{
+    "key", "led", "uart",
+};
+static const uint32_t s_client_deadline[BENCH_WDG_CLIENTS] =
+{
+    300U, 500U, 800U,
+};
+
+static const bench_wdg_scenario_t s_scenario[] =
+{
+    { "all_live", { { 100U, BENCH_WDG_NEVER, 0U },
+                    { 250U, BENCH_WDG_NEVER, 0U },
+                    { 700U, BENCH_WDG_NEVER, 0U } }, 0x0U },
+    // just inside: the supervisor stamps a check-in with its next round
+    { "edge",     { { 290U, BENCH_WDG_NEVER, 0U },
+                    { 480U, BENCH_WDG_NEVER, 0U },
+                    { 790U, BENCH_WDG_NEVER, 0U } }, 0x0U },
+    { "miss",     { { 100U, BENCH_WDG_NEVER, 0U },
+                    { 250U, 3000U, BENCH_WDG_NEVER },
+                    { 700U, BENCH_WDG_NEVER, 0U } }, 0x2U },
+    { "late",     { { 100U, BENCH_WDG_NEVER, 0U },
+                    { 250U, 3000U, 3800U },
+                    { 700U, BENCH_WDG_NEVER, 0U } }, 0x2U },
+    { "two_miss", { { 100U, 2000U, BENCH_WDG_NEVER },
+                    { 250U, BENCH_WDG_NEVER, 0U },
+                    { 700U, 2100U, BENCH_WDG_NEVER } }, 0x5U },
+};
+
+static uint32_t             s_iterations = BENCH_WATCHDOG_ITERATIONS;
+
+// simulated clock and watchdog
+static uint32_t             s_sim_ms;
+static uint32_t             s_sim_timeout_ms;
+static uint32_t             s_sim_kick_ms;
+static uint32_t             s_sim_kicks;
+
+// mock thread interface, the supervisor task is recorded, never run
+static uint32_t             s_thread_fail;
+static uint32_t             s_thread_creates;
+static void                 * s_thread_arg;
+static uint32_t             s_thread_stack;
+static uint32_t             s_thread_priority;
+
+static bsp_wdg_supervisor_t s_supervisor;
+
+static bsp_status_t __sim_get_time_ms ( uint32_t * const time_ms )
+{
+    *time_ms = s_sim_ms;
+    return BSP_OK;
+}
+
+static bsp_status_t __sim_get_time_us ( uint64_t * const time_us )
+{
+    *time_us = (uint64_t)s_sim_ms * 1000U;
+    return BSP_OK;
+}
+
+static bsp_status_t __sim_delay_ms ( const uint32_t delay_ms )
+{
+    s_sim_ms += delay_ms;
+    return BSP_OK;
+}
+
+static wdg_status_t __sim_wdg_start ( uint32_t timeout_ms )
+{
+    s_sim_timeout_ms = timeout_ms;
+    s_sim_kick_ms    = s_sim_ms;
+    s_sim_kicks      = 0U;
+    return WDG_OK;
+}
+
+static wdg_status_t __sim_wdg_kick ( void )
+{
+    s_sim_kick_ms = s_sim_ms;
+    s_sim_kicks++;
+    return WDG_OK;
+}
+
+static bsp_status_t __mock_thread_create (
+                                           void         ( *entry ) ( void * ),
+                                           const char *   const name,
+                                           uint32_t       const stack_words,
+                                           void *         const argument,
+                                           uint32_t       const priority
+                                                                     )
+{
+    (void)entry;
+    (void)name;
+    if ( 0U != s_thread_fail )
+    {
+        return BSP_ERRORNOMEMORY;
+    }
+    s_thread_creates++;
+    s_thread_arg      = argument;
+    s_thread_stack    = stack_words;
+    s_thread_priority = priority;
+    return BSP_OK;
+}
+
+static time_operation_t s_sim_time =
+{
+    .pf_get_time_ms = __sim_get_time_ms,
+    .pf_get_time_us = __sim_get_time_us,
+};
+
+static os_delay_t s_sim_delay =
+{
+    .pf_os_delay_ms = __sim_delay_ms,
+};
+
+static os_thread_t s_mock_thread =
+{
+    .pf_os_thread_create = __mock_thread_create,
+};
+
+static wdg_operation_t s_sim_wdg =
+{
+    .pf_wdg_start = __sim_wdg_start,
+    .pf_wdg_kick  = __sim_wdg_kick,
+};
+
+/**
+ * @brief: Fresh supervisor on the simulated clock and watchdog
+ *
+ * @return wdg_status_t: execute result of wdg_supervisor_inst
+ **/
+static wdg_status_t __supervisor_new ( void )
+{
+    s_sim_ms                    = 0U;
+    s_supervisor.is_initialized = WDG_SUPERVISOR_NOT_INITED;
+    return wdg_supervisor_inst( &s_supervisor, &s_sim_wdg, &s_sim_time,
+                                &s_sim_delay, &s_mock_thread,
+                                BENCH_WDG_PERIOD_MS, BENCH_WDG_TIMEOUT_MS );
+}
+
+/**
+ * @brief: Run one scenario on the simulated clock
+ * @steps:
+ *      1. Fresh supervisor, register the clients, start the watchdog
+ *      2. Every ms: the clients due check in, a round every period
+ *      3. Stop when the simulated watchdog expires
+ *
+ * @param[in]  scenario: the scenario
+ * @param[out] result:   what happened
+ **/
+static void __scenario_run ( const bench_wdg_scenario_t * const scenario,
+                             bench_wdg_result_t         * const result    )
+{
+    const bench_wdg_schedule_t * sched;
+    uint32_t                     id[BENCH_WDG_CLIENTS];
+    uint32_t                     next_ms[BENCH_WDG_CLIENTS];
+    uint32_t                     starved;
+
+    /***************** 1. Set up **************************/
+    memset( result, 0, sizeof( *result ) );
+    result->first_flag_ms = BENCH_WDG_NEVER;
+    result->reset_ms      = BENCH_WDG_NEVER;
+    __supervisor_new();
+    for ( uint32_t c = 0; c < BENCH_WDG_CLIENTS; ++c )
+    {
+        s_supervisor.pf_client_register( &s_supervisor, s_client_name[c],
+                                         s_client_deadline[c], &id[c]      );
+        next_ms[c]         = scenario->client[c].interval_ms;
+        result->flag_ms[c] = BENCH_WDG_NEVER;
+    }
+    s_sim_wdg.pf_wdg_start( BENCH_WDG_TIMEOUT_MS );
+
+    /***************** 2. Step the clock ******************/
+    for ( s_sim_ms = 0U; s_sim_ms < BENCH_WDG_RUN_MS; ++s_sim_ms )
+    {
+        for ( uint32_t c = 0; c < BENCH_WDG_CLIENTS; ++c )
+        {
+            sched = &scenario->client[c];
+            if ( s_sim_ms < next_ms[c] )
+            {
+                continue;
+            }
+            next_ms[c] += sched->interval_ms;
+            if ( s_sim_ms < sched->stop_ms || s_sim_ms >= sched->resume_ms )
+            {
+                wdg_checkin( &s_supervisor, id[c] );
+                result->last_ms[c] = ( s_sim_ms < sched->stop_ms ) ?
+                                     s_sim_ms : result->last_ms[c];
+            }
+        }
+        if ( 0U == s_sim_ms % BENCH_WDG_PERIOD_MS )
+        {
+            starved = s_supervisor.starved;
+            if ( WDG_OK == wdg_supervisor_poll( &s_supervisor ) &&
+                 BENCH_WDG_NEVER != result->first_flag_ms        )
+            {
+                result->late_kicks++;
+            }
+            for ( uint32_t c = 0; c < BENCH_WDG_CLIENTS; ++c )
+            {
+                if ( 0U != ( ( s_supervisor.starved & ~starved ) &
+                             ( 1UL << id[c] ) ) )
+                {
+                    result->flag_ms[c]    = s_sim_ms;
+                    result->first_flag_ms = ( BENCH_WDG_NEVER ==
+                                              result->first_flag_ms ) ?
+                                            s_sim_ms : result->first_flag_ms;
+                }
+            }
+        }
+
+        /************* 3. Simulated expiry ****************/
+        if ( s_sim_ms - s_sim_kick_ms > s_sim_timeout_ms )
+        {
+            result->reset_ms = s_sim_ms;
+            break;
+        }
+    }
+    result->starved = s_supervisor.starved;
+}
+
+/**
+ * @brief: Check and print one scenario
+ *
+ * @param[in]  scenario: the scenario
+ **/
+static void __scenario_check ( const bench_wdg_scenario_t * const scenario )
+{
+    bench_wdg_result_t result;
+    uint32_t           ok = 1U;
+    uint32_t           detect_ms;
+    uint32_t           detect_max = 0U;
+
+    __scenario_run( scenario, &result );
+
+    /***************** All live: no flag, no reset ********/
+    if ( 0U == scenario->expect_starved )
+    {
+        ok = ( 0U == result.starved                 &&
+               BENCH_WDG_NEVER == result.reset_ms    &&
+               s_sim_kicks == s_supervisor.rounds     ) ? 1U : 0U;
+        printf( "# %s,starved -,detect -,reset -,%s\r\n",
+                scenario->name, ( 0U != ok ) ? "ok" : "MISMATCH" );
+        return;
+    }
+
+    /***************** Miss: flagged in time, reset *******/
+    if ( scenario->expect_starved != result.starved ||
+         BENCH_WDG_NEVER == result.reset_ms         ||
+         0U != result.late_kicks                    ||
+         result.reset_ms - result.first_flag_ms > BENCH_WDG_TIMEOUT_MS )
+    {
+        ok = 0U;
+    }
+    printf( "# %s,starved ", scenario->name );
+    for ( uint32_t c = 0; c < BENCH_WDG_CLIENTS; ++c )
+    {
+        if ( 0U == ( result.starved & ( 1UL << c ) ) )
+        {
+            continue;
+        }
+        // the round stamps a check-in up to one period late
+        detect_ms  = result.flag_ms[c] - result.last_ms[c];
+        detect_max = ( detect_ms > detect_max ) ? detect_ms : detect_max;
+        if ( detect_ms <= s_client_deadline[c] ||
+             detect_ms >= s_client_deadline[c] + 2U * BENCH_WDG_PERIOD_MS )
+        {
+            ok = 0U;
+        }
+        printf( "%s%s", s_client_name[c],
+                ( 0U != ( result.starved >> ( c + 1U ) ) ) ? "+" : "" );
+    }
+    printf( ",detect %u ms,reset %u ms,%s\r\n",
+            (unsigned int)detect_max,
+            (unsigned int)( result.reset_ms - result.first_flag_ms ),
+            ( 0U != ok ) ? "ok" : "MISMATCH" );
+}
+
+/**
+ * @brief: A deadline the timeout can not cover has to be rejected
+ **/
+static void __register_check ( void )
+{
+    uint32_t id;
+    uint32_t ok;
+
+    __supervisor_new();
+    ok = ( WDG_ERRORPARAMETER == s_supervisor.pf_client_register(
+                &s_supervisor, "slow", BENCH_WDG_TIMEOUT_MS - 50U, &id ) &&
+           WDG_ERRORPARAMETER == s_supervisor.pf_client_register(
+                &s_supervisor, "fast", BENCH_WDG_PERIOD_MS / 2U, &id )   &&
+           WDG_OK == s_supervisor.pf_client_register(
+                &s_supervisor, "fits", BENCH_WDG_TIMEOUT_MS -
+                                       2U * BENCH_WDG_PERIOD_MS, &id ) ) ?
+         1U : 0U;
+    printf( "# register,rejected slow fast,-,-,%s\r\n",
+            ( 0U != ok ) ? "ok" : "MISMATCH" );
+}
+
+/**
+ * @brief: wdg_supervisor_start starts the watchdog and creates the task
+ *         through the thread interface, a failed create is reported
+ **/
+static void __start_check ( void )
+{
+    uint32_t ok;
+
+    __supervisor_new();
+    s_sim_timeout_ms = 0U;
+    s_thread_creates = 0U;
+    s_thread_fail    = 0U;
+    ok = ( WDG_OK == wdg_supervisor_start( &s_supervisor ) &&
+           BENCH_WDG_TIMEOUT_MS == s_sim_timeout_ms &&
+           1U == s_thread_creates && &s_supervisor == s_thread_arg &&
+           WDG_SUPERVISOR_STACK_WORDS == s_thread_stack &&
+           (uint32_t)WDG_SUPERVISOR_PRIORITY == s_thread_priority ) ?
+         1U : 0U;
+
+    s_thread_fail = 1U;
+    ok &= ( WDG_ERRORNOMEMORY == wdg_supervisor_start( &s_supervisor ) &&
+            1U == s_thread_creates ) ? 1U : 0U;
+    s_thread_fail = 0U;
+    printf( "# start,created %u,-,-,%s\r\n", (unsigned int)s_thread_creates,
+            ( 0U != ok ) ? "ok" : "MISMATCH" );
+}
+
+/**
+ * @brief: Time a check-in and a round over MAX_WDG_CLIENT_NUM clients
+ **/
+static void __cost_run ( void )
+{
+    bench_stat_t stat_in;
+    bench_stat_t stat_poll;
+    uint32_t     id;
+    uint32_t     t0;
+
+    __supervisor_new();
+    for ( uint32_t c = 0; c < MAX_WDG_CLIENT_NUM; ++c )
+    {
+        s_supervisor.pf_client_register( &s_supervisor, "client",
+                                         500U, &id                );
+    }
+    s_sim_wdg.pf_wdg_start( BENCH_WDG_TIMEOUT_MS );
+
+    bench_stat_reset( &stat_in );
+    bench_stat_reset( &stat_poll );
+    for ( uint32_t i = 0; i < s_iterations; ++i )
+    {
+        for ( uint32_t c = 0; c < MAX_WDG_CLIENT_NUM; ++c )
+        {
+            t0 = bench_timestamp_get();
+            wdg_checkin( &s_supervisor, c );
+            bench_stat_add( &stat_in, bench_timestamp_get() - t0 );
+        }
+        t0 = bench_timestamp_get();
+        wdg_supervisor_poll( &s_supervisor );
+        bench_stat_add( &stat_poll, bench_timestamp_get() - t0 );
+        s_sim_ms += BENCH_WDG_PERIOD_MS;
+    }
+    bench_csv_row( BENCH_WATCHDOG_SUITE, "checkin", "32_clients", &stat_in );
+    bench_csv_row( BENCH_WATCHDOG_SUITE, "poll", "32_clients", &stat_poll );
+}
+
+/**
+ * @brief: Runner task, runs every scenario and deletes itself
+ *
+ * @param[in]  argument: Not used
+ **/
+static void bench_watchdog_task ( void * argument )
+{
+    (void)argument;
+
+    bench_csv_header( BENCH_WATCHDOG_SUITE );
+    for ( uint32_t i = 0; i < sizeof( s_scenario ) / sizeof( s_scenario[0] );
+          ++i )
+    {
+        __scenario_check( &s_scenario[i] );
+    }
+    __register_check();
+    __start_check();
+    __cost_run();
+
+    vTaskDelete( NULL );
+}
+
+/**
+ * @brief: Start the watchdog supervisor suite
+ * @steps:
+ *      1. Start the timestamp source
+ *      2. Create the runner task, it prints the CSV report and deletes itself
+ *
+ * @param[in]  iterations: check-ins and rounds timed, 0 means default
+ *
+ * @return bench_status_t: execute result of this function
+ **/
+bench_status_t bench_watchdog_start ( uint32_t iterations )
+{
+    bench_status_t ret = BENCH_OK;
+
+    /************** 1. Start the timestamp source *************/
+    ret = bench_timestamp_init();
+    if ( BENCH_OK != ret )
+    {
+        LOG( LOG_LEVEL_ERR, "Bench timestamp init failed" );
+        return ret;
+    }
+    s_iterations = ( 0U == iterations ) ? BENCH_WATCHDOG_ITERATIONS :
+                                          iterations;
+
+    /***************** 2. Create the runner ******************/
+    if ( pdPASS != xTaskCreate( bench_watchdog_task,
+                                "bench_watchdog",
+                                BENCH_WATCHDOG_STACK_WORDS,
+                                NULL,
+                                tskIDLE_PRIORITY + 1,
+                                NULL                       ) )
+    {
+        LOG( LOG_LEVEL_ERR, "Bench runner create failed" );
+        return BENCH_ERRORNOMEMORY;
+    }
+    return ret;
+}
+
+//******************************** Defines **********************************//
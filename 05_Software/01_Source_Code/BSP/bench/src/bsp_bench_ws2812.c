@@ -0,0 +1,793 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_bench_ws2812.c
+ *
+ * @par dependencies
+ * - bsp_bench_ws2812.h
+ * - bsp_ws2812.h
+ * - bsp_led_handler.h
+ *
+ * @author Damian
+ *
+ * @brief Check the WS2812 strip driver against a mock timer DMA: the timing
+ *        of the bits at the clocks of the profiles, the encoding, the frames
+ *        on the wire and the reset between them, and measure the refill
+ *        interrupt against the time of a half.
+ *
+ * Processing flow:
+ *
+ * Call directly.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+//******************************** Includes *********************************//
+
+#include "bsp_bench_ws2812.h"
+#include "bsp_led_handler.h"
+#include "bsp_common.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include <string.h>
+
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+#define BENCH_WS2812_SUITE        "ws2812"
+#define BENCH_WS2812_TIM_HZ       100000000U  /* PERFORMANCE profile, TIM3  */
+#define BENCH_WS2812_MAX_BYTES    ( BENCH_WS2812_MAX_LEDS * 4U )
+#define BENCH_WS2812_CLOCKS       11U
+#define BENCH_WS2812_LENGTHS      6U
+#define BENCH_WS2812_LED_INDEX    3U
+#define BENCH_WS2812_LED_COLOR    WS2812_RGB( 0x12U, 0x34U, 0x56U )
+
+typedef enum
+{
+    BENCH_WS2812_SHOW    = 0,
+    BENCH_WS2812_REFILL  = 1,
+    BENCH_WS2812_STOP    = 2,
+    BENCH_WS2812_COSTS   = 3,
+} bench_ws2812_cost_t;
+
+typedef struct
+{
+    const char            * name;
+    uint32_t              t0h_ns;
+    uint32_t              t1h_ns;
+    uint32_t              bit_ns;
+    uint32_t              reset_ns;
+    uint32_t              bpp;
+} bench_ws2812_part_t;
+
+typedef struct
+{
+    //**************************** Engine ***********************************//
+    uint32_t              hz;                         /* timer clock         */
+    const uint16_t        * ring;
+    uint32_t              slots;
+    uint32_t              period;                     /* of the last start   */
+    uint32_t              running;
+    uint32_t              half;                       /* being sent          */
+    uint32_t              starts;
+    uint32_t              stops;
+    uint32_t              bad;                        /* rules broken        */
+
+    //**************************** Wire *************************************//
+    uint16_t              t0h;                        /* duties of the strip */
+    uint16_t              t1h;
+    uint32_t              gap_slots;                  /* low run, at least   */
+    uint32_t              low;                        /* slots low in a row  */
+    uint32_t              bits;                       /* of the frame read   */
+    uint32_t              frame_bits;                 /* expected            */
+    uint32_t              frames;                     /* complete ones       */
+    uint8_t               bytes[BENCH_WS2812_MAX_BYTES];
+} bench_ws2812_mock_t;
+
+static const char * const s_cost_name[BENCH_WS2812_COSTS] =
+{
+    "show", "refill", "stop",
+};
+
+/* datasheet times, kept apart from the table of the driver                */
+static const bench_ws2812_part_t s_parts[WS2812_TYPES] =
+{
+    { "ws2812b",     400U, 800U, 1250U, 280000U, 3U },
+    { "sk6812",      300U, 600U, 1250U,  80000U, 3U },
+    { "sk6812_rgbw", 300U, 600U, 1250U,  80000U, 4U },
+};
+
+/* profiles PERFORMANCE, BALANCED, LOW_POWER first, printed */
+static const uint32_t s_clocks[BENCH_WS2812_CLOCKS] =
+{
+    100000000U, 84000000U, 16000000U, 50000000U, 42000000U, 8000000U,
+    4000000U, 3000000U, 2000000U, 1000000U, 0U,
+};
+
+static const uint32_t s_lengths[BENCH_WS2812_LENGTHS] =
+{
+    1U, 7U, 8U, 9U, 60U, BENCH_WS2812_MAX_LEDS,
+};
+
+static uint32_t            s_rounds = BENCH_WS2812_ROUNDS;
+static bsp_ws2812_t        s_strip  = { .is_initialized = WS2812_NOT_INITED };
+static uint8_t             s_pixels[BENCH_WS2812_MAX_BYTES];
+static uint8_t             s_expect[BENCH_WS2812_MAX_BYTES];
+static bench_ws2812_mock_t s_mock;
+static bench_stat_t        s_cost[BENCH_WS2812_COSTS];
+static uint32_t            s_rand = 0x2545F491U;
+
+/**
+ * @brief: xorshift32, the same sequence on target and host
+ *
+ * @return uint32_t: next pseudo random number
+ **/
+static uint32_t __rand ( void )
+{
+    s_rand ^= s_rand << 13;
+    s_rand ^= s_rand >> 17;
+    s_rand ^= s_rand << 5;
+    return s_rand;
+}
+
+//******************************** Mock *************************************//
+
+static uint32_t __mock_clock_hz ( void )
+{
+    return s_mock.hz;
+}
+
+static ws2812_status_t __mock_dma_start ( const uint16_t * const ring,
+                                          uint32_t               slots,
+                                          uint32_t               period )
+{
+    s_mock.bad    += ( 0U != s_mock.running || ring != s_strip.ring ||
+                       WS2812_RING_SLOTS != slots ) ? 1U : 0U;
+    s_mock.ring    = ring;
+    s_mock.slots   = slots;
+    s_mock.period  = period;
+    s_mock.half    = 0U;
+    s_mock.running = 1U;
+    s_mock.starts++;
+    return WS2812_OK;
+}
+
+static ws2812_status_t __mock_dma_stop ( void )
+{
+    s_mock.running = 0U;
+    s_mock.stops++;
+    return WS2812_OK;
+}
+
+static bsp_status_t __mock_critical ( void )
+{
+    // the runner plays the interrupt itself, nothing to mask
+    return BSP_OK;
+}
+
+static bsp_status_t __mock_delay ( const uint32_t delay_ms )
+{
+    (void)delay_ms;
+    return BSP_OK;
+}
+
+static ws2812_hw_operation_t s_mock_ops =
+{
+    .pf_ws2812_clock_hz  = __mock_clock_hz,
+    .pf_ws2812_dma_start = __mock_dma_start,
+    .pf_ws2812_dma_stop  = __mock_dma_stop,
+};
+
+static os_critical_t s_mock_critical =
+{
+    .pf_os_critical_enter = __mock_critical,
+    .pf_os_critical_exit  = __mock_critical,
+};
+
+static os_delay_t s_mock_delay =
+{
+    .pf_os_delay_ms = __mock_delay,
+};
+
+//******************************** Mock *************************************//
+
+//******************************** Wire *************************************//
+
+/**
+ * @brief: One slot on the wire, decoded as the strip does
+ *
+ * @param[in]  duty: high ticks of the period, 0 is low
+ **/
+static void __wire ( uint16_t duty )
+{
+    uint32_t byte;
+
+    if ( 0U == duty )
+    {
+        if ( 0U != s_mock.bits )
+        {
+            // low after bits: the end of a frame
+            s_mock.bad += ( s_mock.frame_bits != s_mock.bits ) ? 1U : 0U;
+            s_mock.frames++;
+            s_mock.bits = 0U;
+        }
+        s_mock.low++;
+        return;
+    }
+    if ( duty != s_mock.t0h && duty != s_mock.t1h )
+    {
+        s_mock.bad++;
+        return;
+    }
+    if ( 0U == s_mock.bits )
+    {
+        // a new frame: the strip latched the one before only after a reset
+        s_mock.bad += ( 0U != s_mock.frames &&
+                        s_mock.low < s_mock.gap_slots ) ? 1U : 0U;
+        s_mock.low = 0U;
+    }
+    if ( s_mock.bits >= 8U * BENCH_WS2812_MAX_BYTES )
+    {
+        s_mock.bad++;
+        return;
+    }
+    byte = s_mock.bits / 8U;
+    if ( 0U == s_mock.bits % 8U )
+    {
+        s_mock.bytes[byte] = 0U;
+    }
+    s_mock.bytes[byte] = (uint8_t)( ( s_mock.bytes[byte] << 1 ) |
+                                    ( ( duty == s_mock.t1h ) ? 1U : 0U ) );
+    s_mock.bits++;
+}
+
+/**
+ * @brief: The DMA sends the half it reads, then its interrupt
+ *
+ * @param[in]  isr: 0: the interrupt is lost
+ **/
+static void __pump ( uint32_t isr )
+{
+    uint32_t half = s_mock.half;
+    uint32_t t0;
+    uint32_t t1;
+
+    for ( uint32_t i = 0; i < WS2812_HALF_SLOTS; ++i )
+    {
+        __wire( s_mock.ring[half * WS2812_HALF_SLOTS + i] );
+    }
+    s_mock.half ^= 1U;
+    if ( 0U == isr )
+    {
+        return;
+    }
+
+    t0 = bench_timestamp_get();
+    ws2812_dma_isr( &s_strip, half );
+    t1 = bench_timestamp_get();
+    bench_stat_add( &s_cost[( 0U != s_mock.running ) ? BENCH_WS2812_REFILL :
+                                                       BENCH_WS2812_STOP],
+                    t1 - t0 );
+}
+
+/**
+ * @brief: Run the DMA until the strip stops it, check the line is low and
+ *         the reset out at that point
+ *
+ * @param[in]  halves: at most, then it is a mismatch
+ **/
+static void __drain ( uint32_t halves )
+{
+    while ( 0U != s_mock.running && 0U != halves-- )
+    {
+        __pump( 1U );
+    }
+    s_mock.bad += ( 0U != s_mock.running || 0U != s_strip.busy ||
+                    0U != s_mock.bits || s_mock.low < s_mock.gap_slots ) ?
+                  1U : 0U;
+}
+
+//******************************** Wire *************************************//
+
+/**
+ * @brief: A fresh strip on the mock, the wire decoder set to its timing
+ *
+ * @param[in]  type: part
+ * @param[in]  leds: on the strip
+ * @param[in]  hz:   timer clock
+ *
+ * @return uint32_t: 1 when set up
+ **/
+static uint32_t __strip ( ws2812_type_t type, uint32_t leds, uint32_t hz )
+{
+    const bench_ws2812_part_t * part = &s_parts[type];
+    ws2812_timing_t             timing;
+    uint32_t                    bad  = s_mock.bad;
+    uint64_t                    bit;
+
+    if ( WS2812_OK != ws2812_timing( type, hz, &timing ) )
+    {
+        return 0U;
+    }
+    memset( &s_mock, 0, sizeof( s_mock ) );
+    s_mock.bad        = bad;
+    s_mock.hz         = hz;
+    s_mock.t0h        = timing.t0h;
+    s_mock.t1h        = timing.t1h;
+    s_mock.frame_bits = leds * part->bpp * 8U;
+    // whole periods low, as long as the datasheet reset
+    bit               = (uint64_t)timing.period * 1000000000U;
+    s_mock.gap_slots  = (uint32_t)( ( (uint64_t)part->reset_ns * hz +
+                                      bit - 1U ) / bit );
+    s_strip.is_initialized = WS2812_NOT_INITED;
+    return ( WS2812_OK == ws2812_inst( &s_strip, &s_mock_ops, &s_mock_critical,
+                                       type, s_pixels, leds ) ) ? 1U : 0U;
+}
+
+/**
+ * @brief: Random colours into the strip, the expected wire bytes kept
+ *
+ * @param[in]  type: part
+ * @param[in]  leds: on the strip
+ **/
+static void __paint ( ws2812_type_t type, uint32_t leds )
+{
+    uint32_t   bpp = s_parts[type].bpp;
+    uint32_t   color;
+    uint8_t  * e;
+
+    for ( uint32_t i = 0; i < leds; ++i )
+    {
+        color = __rand();
+        e     = &s_expect[i * bpp];
+        e[0]  = (uint8_t)( color >> 8 );              /* green first        */
+        e[1]  = (uint8_t)( color >> 16 );
+        e[2]  = (uint8_t)( color );
+        if ( 4U == bpp )
+        {
+            e[3] = (uint8_t)( color >> 24 );
+        }
+        s_mock.bad += ( WS2812_OK != ws2812_set_pixel( &s_strip, i, color ) ) ?
+                      1U : 0U;
+    }
+}
+
+/**
+ * @brief: ws2812_show on an idle strip, timed
+ **/
+static void __show ( void )
+{
+    uint32_t        t0 = bench_timestamp_get();
+    ws2812_status_t ret = ws2812_show( &s_strip );
+
+    bench_stat_add( &s_cost[BENCH_WS2812_SHOW], bench_timestamp_get() - t0 );
+    s_mock.bad += ( WS2812_OK != ret || 1U != s_mock.running ) ? 1U : 0U;
+}
+
+/**
+ * @brief: Halves a frame takes at most, with its reset and the stop
+ *
+ * @return uint32_t: halves
+ **/
+static uint32_t __halves ( void )
+{
+    return ( s_mock.frame_bits + s_strip.timing.reset_slots ) /
+           WS2812_HALF_SLOTS + 4U;
+}
+
+/**
+ * @brief: Nearest ticks of a time, in picoseconds of a tick
+ *
+ * @param[in]  ps: of a tick
+ * @param[in]  ns: time
+ *
+ * @return uint32_t: ticks
+ **/
+static uint32_t __nearest ( uint64_t ps, uint32_t ns )
+{
+    return (uint32_t)( ( (uint64_t)ns * 1000U + ps / 2U ) / ps );
+}
+
+/**
+ * @brief: Ticks off a time by more than the tolerance
+ *
+ * @param[in]  ps:    of a tick
+ * @param[in]  ticks: count
+ * @param[in]  ns:    nominal time
+ *
+ * @return uint32_t: 1 when out of tolerance
+ **/
+static uint32_t __out ( uint64_t ps, uint32_t ticks, uint32_t ns )
+{
+    int64_t err = (int64_t)( ticks * ps ) - (int64_t)ns * 1000;
+
+    return ( err >  (int64_t)WS2812_TOLERANCE_NS * 1000 ||
+             err < -(int64_t)WS2812_TOLERANCE_NS * 1000 ) ? 1U : 0U;
+}
+
+/**
+ * @brief: Ticks of every part at the clocks against the datasheet
+ **/
+static void __timing ( void )
+{
+    const bench_ws2812_part_t * part;
+    ws2812_timing_t             t;
+    ws2812_status_t             ret;
+    uint32_t                    bad     = 0U;
+    uint32_t                    refused = 0U;
+    uint32_t                    hz;
+    uint32_t                    want;
+    uint32_t                    n[3];        /* period, t0h, t1h           */
+    uint32_t                    fits;
+    uint64_t                    ps      = 1U;  /* of a tick             */
+
+    for ( uint32_t k = 0; k < WS2812_TYPES; ++k )
+    {
+        part = &s_parts[k];
+        for ( uint32_t c = 0; c < BENCH_WS2812_CLOCKS; ++c )
+        {
+            hz = s_clocks[c];
+            memset( &t, 0, sizeof( t ) );
+            ret = ws2812_timing( (ws2812_type_t)k, hz, &t );
+
+            // the nearest ticks, each within the tolerance, 0 < t0h < t1h
+            fits = 0U;
+            if ( 0U != hz )
+            {
+                ps   = 1000000000000ULL / hz;
+                n[0] = __nearest( ps, part->bit_ns );
+                n[1] = __nearest( ps, part->t0h_ns );
+                n[2] = __nearest( ps, part->t1h_ns );
+                fits = ( 0U != n[1] && n[1] < n[2] && n[2] < n[0] &&
+                         0U == __out( ps, n[0], part->bit_ns ) &&
+                         0U == __out( ps, n[1], part->t0h_ns ) &&
+                         0U == __out( ps, n[2], part->t1h_ns ) ) ? 1U : 0U;
+            }
+            if ( WS2812_OK != ret )
+            {
+                refused++;
+                bad += fits;
+                continue;
+            }
+            bad += ( 0U == fits || t.tim_hz != hz || n[0] != t.period ||
+                     n[1] != t.t0h || n[2] != t.t1h ) ? 1U : 0U;
+
+            // reset: the datasheet time plus the slot in flight, 8 aligned
+            want = (uint32_t)( ( (uint64_t)part->reset_ns * 1000U +
+                                 t.period * ps - 1U ) /
+                               ( t.period * ps ) ) + 1U;
+            bad += ( 0U != t.reset_slots % 8U || t.reset_slots < want ||
+                     t.reset_slots >= want + 8U ) ? 1U : 0U;
+            if ( c < 3U )
+            {
+                printf( "# timing,%s,%u Hz,%u period,%u t0h,%u t1h,"
+                        "%u reset\r\n", part->name, (unsigned int)hz,
+                        (unsigned int)t.period, (unsigned int)t.t0h,
+                        (unsigned int)t.t1h, (unsigned int)t.reset_slots );
+            }
+        }
+    }
+    // 2 MHz, 1 MHz and 0 Hz cannot make any part
+    bad += ( refused != 3U * WS2812_TYPES ) ? 1U : 0U;
+    printf( "# timing,%u clocks,%u refused,%s\r\n",
+            (unsigned int)( BENCH_WS2812_CLOCKS * WS2812_TYPES ),
+            (unsigned int)refused, ( 0U == bad ) ? "ok" : "MISMATCH" );
+}
+
+/**
+ * @brief: Random bytes, slot by slot
+ **/
+static void __encode ( void )
+{
+    ws2812_timing_t t;
+    uint16_t        slots[8U * 64U];
+    uint8_t         bytes[64];
+    uint32_t        bad = 0U;
+    uint32_t        num;
+
+    ws2812_timing( WS2812_TYPE_WS2812B, BENCH_WS2812_TIM_HZ, &t );
+    for ( uint32_t r = 0; r < s_rounds; ++r )
+    {
+        num = 1U + __rand() % 64U;
+        for ( uint32_t i = 0; i < num; ++i )
+        {
+            bytes[i] = (uint8_t)__rand();
+        }
+        ws2812_encode( &t, bytes, num, slots );
+        for ( uint32_t i = 0; i < 8U * num; ++i )
+        {
+            bad += ( slots[i] != ( ( 0U != ( bytes[i / 8U] &
+                                             ( 0x80U >> ( i % 8U ) ) ) ) ?
+                                   t.t1h : t.t0h ) ) ? 1U : 0U;
+        }
+    }
+    printf( "# encode,%u rounds,%u t0h,%u t1h,%s\r\n",
+            (unsigned int)s_rounds, (unsigned int)t.t0h,
+            (unsigned int)t.t1h, ( 0U == bad ) ? "ok" : "MISMATCH" );
+}
+
+/**
+ * @brief: Strips of every length and part, one frame each, off the wire
+ **/
+static void __stream ( void )
+{
+    uint32_t bad    = 0U;
+    uint32_t frames = 0U;
+    uint32_t leds;
+
+    for ( uint32_t k = 0; k < WS2812_TYPES; ++k )
+    {
+        for ( uint32_t l = 0; l < BENCH_WS2812_LENGTHS; ++l )
+        {
+            leds = s_lengths[l];
+            if ( 0U == __strip( (ws2812_type_t)k, leds,
+                                BENCH_WS2812_TIM_HZ ) )
+            {
+                bad++;
+                continue;
+            }
+            __paint( (ws2812_type_t)k, leds );
+            __show();
+            __drain( __halves() );
+            bad += ( 1U != s_mock.frames || 1U != s_strip.frames ||
+                     1U != s_mock.stops  || 0U != s_strip.late   ||
+                     0 != memcmp( s_mock.bytes, s_expect,
+                                  leds * s_parts[k].bpp ) ) ? 1U : 0U;
+            frames += s_mock.frames;
+        }
+    }
+    bad += s_mock.bad;
+    s_mock.bad = 0U;
+    printf( "# stream,%u frames,ring %u bytes,%u expanded for %u LEDs,%s\r\n",
+            (unsigned int)frames, (unsigned int)sizeof( s_strip.ring ),
+            (unsigned int)( BENCH_WS2812_MAX_LEDS * 24U * sizeof( uint16_t ) ),
+            (unsigned int)BENCH_WS2812_MAX_LEDS,
+            ( 0U == bad ) ? "ok" : "MISMATCH" );
+}
+
+/**
+ * @brief: Show while streaming, at a random point of the frame, its reset
+ *         or the idle halves before the stop
+ **/
+static void __pending ( void )
+{
+    uint32_t bad = 0U;
+    uint32_t leds;
+    uint32_t at;
+
+    for ( uint32_t r = 0; r < s_rounds; ++r )
+    {
+        leds = 1U + __rand() % 100U;
+        if ( 0U == __strip( WS2812_TYPE_WS2812B, leds, BENCH_WS2812_TIM_HZ ) )
+        {
+            bad++;
+            continue;
+        }
+        __paint( WS2812_TYPE_WS2812B, leds );
+        __show();
+        at = __rand() % __halves();
+        while ( 0U != s_mock.running && 0U != at-- )
+        {
+            __pump( 1U );
+        }
+        // the second frame: these pixels, whatever the first one got
+        __paint( WS2812_TYPE_WS2812B, leds );
+        bad += ( WS2812_OK != ws2812_show( &s_strip ) ) ? 1U : 0U;
+        __drain( 2U * __halves() );
+        bad += ( 2U != s_mock.frames || 2U != s_strip.frames ||
+                 0 != memcmp( s_mock.bytes, s_expect, leds * 3U ) ) ? 1U : 0U;
+    }
+    bad += s_mock.bad;
+    s_mock.bad = 0U;
+    printf( "# pending,%u rounds,%s\r\n", (unsigned int)s_rounds,
+            ( 0U == bad ) ? "ok" : "MISMATCH" );
+}
+
+/**
+ * @brief: A half interrupt lost: counted, the strip still stops
+ **/
+static void __late ( void )
+{
+    uint32_t ok = __strip( WS2812_TYPE_WS2812B, 60U, BENCH_WS2812_TIM_HZ );
+
+    __paint( WS2812_TYPE_WS2812B, 60U );
+    __show();
+    __pump( 1U );
+    __pump( 0U );
+    __pump( 1U );
+    while ( 0U != s_mock.running )
+    {
+        __pump( 1U );
+    }
+    ok &= ( 0U != s_strip.late && 0U == s_strip.busy ) ? 1U : 0U;
+    s_mock.bad = 0U;
+    printf( "# late,%u lost,%s\r\n", (unsigned int)s_strip.late,
+            ( 0U != ok ) ? "ok" : "MISMATCH" );
+}
+
+/**
+ * @brief: The timing follows the clock of the timer at an idle show
+ **/
+static void __clock ( void )
+{
+    uint32_t ok = __strip( WS2812_TYPE_SK6812, 8U, BENCH_WS2812_TIM_HZ );
+
+    __paint( WS2812_TYPE_SK6812, 8U );
+    __show();
+    __drain( __halves() );
+    ok &= ( 125U == s_mock.period ) ? 1U : 0U;
+
+    // LOW_POWER profile: 20 ticks a bit
+    s_mock.hz = 16000000U;
+    ok &= ( WS2812_OK == ws2812_show( &s_strip ) && 20U == s_mock.period &&
+            16000000U == s_strip.timing.tim_hz ) ? 1U : 0U;
+    s_mock.t0h = s_strip.timing.t0h;
+    s_mock.t1h = s_strip.timing.t1h;
+    __drain( __halves() );
+
+    // too slow for the part: refused, idle, the DMA not started
+    s_mock.hz = 1000000U;
+    ok &= ( WS2812_ERRORPARAMETER == ws2812_show( &s_strip ) &&
+            0U == s_strip.busy && 2U == s_mock.starts ) ? 1U : 0U;
+    ok &= ( 0U == s_mock.bad ) ? 1U : 0U;
+    s_mock.bad = 0U;
+    printf( "# clock,%s\r\n", ( 0U != ok ) ? "ok" : "MISMATCH" );
+}
+
+//******************************** Led **************************************//
+
+static led_inst_status_t __led_on ( void )
+{
+    return ws2812_led_set( &s_strip, BENCH_WS2812_LED_INDEX,
+                           BENCH_WS2812_LED_COLOR, 1U );
+}
+
+static led_inst_status_t __led_off ( void )
+{
+    return ws2812_led_set( &s_strip, BENCH_WS2812_LED_INDEX,
+                           BENCH_WS2812_LED_COLOR, 0U );
+}
+
+static led_operation_t s_led_ops =
+{
+    .pf_led_on  = __led_on,
+    .pf_led_off = __led_off,
+};
+
+//******************************** Led **************************************//
+
+/**
+ * @brief: A pixel as a registered LED device: on and off through pf_led_ctrl
+ **/
+static void __led ( void )
+{
+    static led_inst_group_t  group;
+    static bsp_led_handler_t handler = {
+        .is_initialized = LED_HANDLER_NOT_INITED,
+        .led_inst_group = &group,
+    };
+    static bsp_led_driver_t  led = { .is_initialized = LED_INST_NOT_INITED };
+    static bsp_device_t      dev;
+#ifdef BENCH_HOST_POSIX
+    static bsp_osal_t        osal = { .p_os_critical = &s_mock_critical };
+#endif /* BENCH_HOST_POSIX */
+    static time_operation_t  time_ops;
+    uint32_t                 ok;
+    uint8_t                * p = &s_mock.bytes[BENCH_WS2812_LED_INDEX * 3U];
+
+    ok = __strip( WS2812_TYPE_WS2812B, 8U, BENCH_WS2812_TIM_HZ );
+    handler.is_initialized = LED_HANDLER_NOT_INITED;
+    led.is_initialized     = LED_INST_NOT_INITED;
+    ok &= ( LED_HNDLR_OK == led_handler_inst( &handler, &s_mock_delay,
+                                              &s_mock_critical,
+                                              &time_ops ) ) ? 1U : 0U;
+
+#ifdef BENCH_HOST_POSIX
+    // on target MX_FREERTOS_Init mounted the OSAL of the registry
+    ok &= ( BSP_OK == bsp_core_init( &osal ) ) ? 1U : 0U;
+#endif /* BENCH_HOST_POSIX */
+    // instantiate and the open of the device turn the LED off: two frames
+    ok &= ( LED_INST_OK == led_instantiate( &led, &s_led_ops ) &&
+            BSP_OK == bsp_device_inst( &dev, "bench_ws2812_led", &led_ops,
+                                       &led ) &&
+            BSP_OK == bsp_device_register( &dev ) &&
+            LED_HNDLR_OK == handler.pf_led_register( &handler, &dev ) ) ?
+          1U : 0U;
+    __drain( __halves() );
+
+    ok &= ( LED_HNDLR_OK == handler.pf_led_ctrl( &handler, &dev, 1000U, 1U,
+                                                 DUTY_MAX_PERCENT ) ) ?
+          1U : 0U;
+    __drain( __halves() );
+    ok &= ( 0x34U == p[0] && 0x12U == p[1] && 0x56U == p[2] ) ? 1U : 0U;
+
+    ok &= ( LED_HNDLR_OK == handler.pf_led_ctrl( &handler, &dev, 1000U, 1U,
+                                                 DUTY_00_PERCENT ) ) ?
+          1U : 0U;
+    __drain( __halves() );
+    ok &= ( 0U == p[0] && 0U == p[1] && 0U == p[2] &&
+            4U == s_strip.frames && 0U == s_mock.bad ) ? 1U : 0U;
+    s_mock.bad = 0U;
+    printf( "# led,%s\r\n", ( 0U != ok ) ? "ok" : "MISMATCH" );
+}
+
+/**
+ * @brief: Runner task, runs every check and deletes itself
+ *
+ * @param[in]  argument: Not used
+ **/
+static void bench_ws2812_task ( void * argument )
+{
+    (void)argument;
+
+    bench_csv_header( BENCH_WS2812_SUITE );
+    __timing();
+    __encode();
+    __stream();
+    __pending();
+    __late();
+    __clock();
+    __led();
+    for ( uint32_t c = 0; c < BENCH_WS2812_COSTS; ++c )
+    {
+        bench_csv_row( BENCH_WS2812_SUITE, "cpu", s_cost_name[c],
+                       &s_cost[c] );
+    }
+    // a half of the ring leaves this long to the refill of the other
+    printf( "# load,refill max %u ns,half %u ns\r\n",
+            (unsigned int)bench_timestamp_to_ns(
+                              s_cost[BENCH_WS2812_REFILL].max ),
+            (unsigned int)( WS2812_HALF_SLOTS * 1250U ) );
+
+    vTaskDelete( NULL );
+}
+
+/**
+ * @brief: Start the WS2812 suite
+ * @steps:
+ *      1. Start the timestamp source
+ *      2. Create the runner task, it prints the CSV report and deletes itself
+ *
+ * @param[in]  rounds: repeats of the random cases, 0 means default
+ *
+ * @return bench_status_t: execute result of this function
+ **/
+bench_status_t bench_ws2812_start ( uint32_t rounds )
+{
+    bench_status_t ret = BENCH_OK;
+
+    /************** 1. Start the timestamp source *************/
+    ret = bench_timestamp_init();
+    if ( BENCH_OK != ret )
+    {
+        LOG( LOG_LEVEL_ERR, "Bench timestamp init failed" );
+        return ret;
+    }
+    s_rounds = ( 0U == rounds ) ? BENCH_WS2812_ROUNDS : rounds;
+    memset( &s_mock, 0, sizeof( s_mock ) );
+    for ( uint32_t c = 0; c < BENCH_WS2812_COSTS; ++c )
+    {
+        bench_stat_reset( &s_cost[c] );
+    }
+
+    /***************** 2. Create the runner ******************/
+    if ( pdPASS != xTaskCreate( bench_ws2812_task,
+                                "bench_ws2812",
+                                BENCH_WS2812_STACK_WORDS,
+                                NULL,
+                                tskIDLE_PRIORITY + 1,
+                                NULL                  ) )
+    {
+        LOG( LOG_LEVEL_ERR, "Bench WS2812 task create failed" );
+        return BENCH_ERROR;
+    }
+    return BENCH_OK;
+}
+
+//******************************** Defines **********************************//
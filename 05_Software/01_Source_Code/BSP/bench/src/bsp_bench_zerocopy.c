@@ -0,0 +1,230 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_bench_zerocopy.c
+ *
+ * @par dependencies
+ * - bsp_bench_zerocopy.h
+ * - bsp_msgpool.h
+ *
+ * @author Damian
+ *
+ * @brief Compare a copying FreeRTOS queue with the zero-copy bsp_msgpool_t
+ *        hand-over for message sizes from 16 B to 1 KB.
+ *
+ * Processing flow:
+ *
+ * Call directly.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+//******************************** Includes *********************************//
+
+#include <string.h>
+#include "bsp_bench_zerocopy.h"
+#include "bsp_msgpool.h"
+#include "bsp_common.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+#define BENCH_ZEROCOPY_SUITE        "zerocopy"
+
+static const uint32_t s_sizes[] = { 16U, 64U, 256U, 1024U };
+static uint32_t       s_iterations = BENCH_ZEROCOPY_ITERATIONS;
+
+/**
+ * @brief: Measure the copying queue for one message size
+ * @steps:
+ *      1. Create a queue whose items are the messages themselves
+ *      2. Fill a local message, send it, receive it into another one
+ *
+ * @param[in]  size: bytes of a message
+ * @param[out] stat: Pointer to a instance of bench_stat_t
+ *
+ * @return bench_status_t: execute result of this function
+ **/
+static bench_status_t bench_copy_run ( uint32_t             size,
+                                       bench_stat_t * const stat  )
+{
+    QueueHandle_t  queue;
+    uint8_t      * tx;
+    uint8_t      * rx;
+    uint32_t       t0;
+    volatile uint32_t sink;
+
+    /************** 1. Create the resources ***************/
+    queue = xQueueCreate( BENCH_ZEROCOPY_DEPTH, size );
+    tx    = pvPortMalloc( size );
+    rx    = pvPortMalloc( size );
+    if ( NULL == queue || NULL == tx || NULL == rx )
+    {
+        if ( NULL != queue ) vQueueDelete( queue );
+        vPortFree( tx );
+        vPortFree( rx );
+        return BENCH_ERRORNOMEMORY;
+    }
+
+    /**************** 2. Collect the samples ***************/
+    for ( uint32_t i = 0; i < s_iterations; ++i )
+    {
+        t0 = bench_timestamp_get();
+        memset( tx, (int)i, size );
+        xQueueSend( queue, tx, 0 );
+        xQueueReceive( queue, rx, 0 );
+        sink = rx[0];
+        bench_stat_add( stat, bench_timestamp_get() - t0 );
+    }
+    (void)sink;
+
+    vQueueDelete( queue );
+    vPortFree( tx );
+    vPortFree( rx );
+    return BENCH_OK;
+}
+
+/**
+ * @brief: Measure the zero-copy pool hand-over for one message size
+ * @steps:
+ *      1. Create a pool of message blocks and a queue of pointers
+ *      2. Alloc and fill a block, send its pointer, receive it and free it
+ *
+ * @param[in]  size: bytes of a message
+ * @param[out] stat: Pointer to a instance of bench_stat_t
+ *
+ * @return bench_status_t: execute result of this function
+ **/
+static bench_status_t bench_zerocopy_run ( uint32_t             size,
+                                           bench_stat_t * const stat  )
+{
+    bsp_msgpool_t  pool;
+    bsp_msgq_t     msgq;
+    void         * storage;
+    uint32_t       storage_size = MSGPOOL_STORAGE_SIZE( size,
+                                                        BENCH_ZEROCOPY_DEPTH );
+    uint8_t      * tx;
+    void         * rx;
+    uint32_t       t0;
+    volatile uint32_t sink;
+
+    /************** 1. Create the resources ***************/
+    // heap_4 returns portBYTE_ALIGNMENT (8) aligned blocks
+    storage = pvPortMalloc( storage_size );
+    if ( NULL == storage )
+    {
+        return BENCH_ERRORNOMEMORY;
+    }
+    if ( MSGPOOL_OK != msgpool_instantiate( &pool, storage,
+                                            storage_size, size ) ||
+         MSGPOOL_OK != msgq_instantiate( &msgq, BENCH_ZEROCOPY_DEPTH )
+                                                                  )
+    {
+        vPortFree( storage );
+        return BENCH_ERRORNOMEMORY;
+    }
+
+    /**************** 2. Collect the samples ***************/
+    for ( uint32_t i = 0; i < s_iterations; ++i )
+    {
+        t0 = bench_timestamp_get();
+        msgpool_alloc( &pool, (void **)&tx );
+        memset( tx, (int)i, size );
+        msgq_send( &msgq, tx, 0U );
+        msgq_receive( &msgq, &rx, 0U );
+        sink = ( (uint8_t *)rx )[0];
+        msgpool_free( &pool, rx );
+        bench_stat_add( stat, bench_timestamp_get() - t0 );
+    }
+    (void)sink;
+
+    vQueueDelete( msgq.queue );
+    vPortFree( storage );
+    return BENCH_OK;
+}
+
+/**
+ * @brief: Runner task, runs all the sizes and deletes itself
+ *
+ * @param[in]  argument: Not used
+ **/
+static void bench_zerocopy_task ( void * argument )
+{
+    bench_stat_t stat;
+    char         case_name[8];
+    uint32_t     size_num = sizeof( s_sizes ) / sizeof( s_sizes[0] );
+
+    (void)argument;
+
+    bench_csv_header( BENCH_ZEROCOPY_SUITE );
+    for ( uint32_t i = 0; i < size_num; ++i )
+    {
+        snprintf( case_name, sizeof( case_name ), "%uB",
+                  (unsigned int)s_sizes[i] );
+
+        bench_stat_reset( &stat );
+        if ( BENCH_OK != bench_copy_run( s_sizes[i], &stat ) )
+        {
+            LOG( LOG_LEVEL_ERR, "Bench copy %s no memory", case_name );
+        }
+        bench_csv_row( BENCH_ZEROCOPY_SUITE, "copy", case_name, &stat );
+
+        bench_stat_reset( &stat );
+        if ( BENCH_OK != bench_zerocopy_run( s_sizes[i], &stat ) )
+        {
+            LOG( LOG_LEVEL_ERR, "Bench zerocopy %s no memory", case_name );
+        }
+        bench_csv_row( BENCH_ZEROCOPY_SUITE, "zerocopy", case_name, &stat );
+    }
+
+    vTaskDelete( NULL );
+}
+
+/**
+ * @brief: Start the zero-copy suite
+ * @steps:
+ *      1. Start the timestamp source
+ *      2. Create the runner task, it prints the CSV report and deletes itself
+ *
+ * @param[in]  iterations: samples per message size, 0 means default
+ *
+ * @return bench_status_t: execute result of this function
+ **/
+bench_status_t bench_zerocopy_start ( uint32_t iterations )
+{
+    bench_status_t ret = BENCH_OK;
+
+    /************** 1. Start the timestamp source *************/
+    ret = bench_timestamp_init();
+    if ( BENCH_OK != ret )
+    {
+        LOG( LOG_LEVEL_ERR, "Bench timestamp init failed" );
+        return ret;
+    }
+    s_iterations = ( 0U == iterations ) ? BENCH_ZEROCOPY_ITERATIONS
+                                        : iterations;
+
+    /***************** 2. Create the runner ******************/
+    if ( pdPASS != xTaskCreate( bench_zerocopy_task,
+                                "bench_zerocopy",
+                                BENCH_ZEROCOPY_STACK_WORDS,
+                                NULL,
+                                tskIDLE_PRIORITY + 1,
+                                NULL                       ) )
+    {
+        LOG( LOG_LEVEL_ERR, "Bench runner create failed" );
+        return BENCH_ERRORNOMEMORY;
+    }
+    return ret;
+}
+
+//******************************** Defines **********************************//
@@ -0,0 +1,178 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_clock.h
+ *
+ * @par dependencies
+ * - stdint.h
+ *
+ * @author Damian
+ *
+ * @brief Switch the clock tree between presets: PLL, bus dividers, flash
+ *        latency, regulator scale and ART accelerator set together.
+ *
+ * Processing flow:
+ *
+ * clock_listener_register (UART, ...) -> clock_profile_apply
+ *      -> PLL solved for the preset -> HSI as bridge -> VOS -> PLL on
+ *      -> SYSCLK, dividers, flash latency (HAL_RCC_ClockConfig, this also
+ *         reloads the TIM1 timebase prescaler through HAL_InitTick)
+ *      -> ART caches reset and enabled -> SysTick reload rescaled
+ *      -> time_set_core_clock -> listeners (UART BRR, ...)
+ *
+ *  profile       source  SYSCLK   APB1/APB2  latency  VOS  ART
+ *  PERFORMANCE   HSE     100 MHz  50/100     3 WS     1    PRFT+I+D
+ *  BALANCED      HSE      84 MHz  42/84      2 WS     2    I+D
+ *  LOW_POWER     HSI      16 MHz  16/16      0 WS     3    I+D
+ *
+ * The flash latency follows the 2.7 V - 3.6 V table of the F411 reference
+ * manual. clock_pll_solve and clock_flash_latency are plain arithmetic with
+ * no register access, the only part built on the host (BENCH_HOST_POSIX).
+ * The rest must run in thread mode, from one task (or before the
+ * scheduler), while no transfer depends on the bus clocks.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+#ifndef __BSP_CLOCK_H__
+#define __BSP_CLOCK_H__
+
+//******************************** Includes *********************************//
+
+#include <stdint.h>
+#include <stddef.h>
+
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+#define MAX_CLOCK_LISTENER_NUM  4U        /* Max number of clock listeners   */
+#define CLOCK_HSE_HZ            25000000U /* crystal of the board            */
+#define CLOCK_HSI_HZ            16000000U /* internal RC oscillator          */
+#define CLOCK_USB_HZ            48000000U /* max of the PLL Q output         */
+
+#define CLOCK_ART_PREFETCH      ( 1U << 0 )   /* flash prefetch buffer       */
+#define CLOCK_ART_ICACHE        ( 1U << 1 )   /* ART instruction cache       */
+#define CLOCK_ART_DCACHE        ( 1U << 2 )   /* ART data cache              */
+
+typedef enum
+{
+    CLOCK_OK              = 0,       /* CLOCK operate successfully           */
+    CLOCK_ERROR           = 1,       /* CLOCK error without case matched     */
+    CLOCK_ERRORTIMEOUT    = 2,       /* CLOCK oscillator or PLL not ready    */
+    CLOCK_ERRORSOURCE     = 3,       /* CLOCK HSE not available              */
+    CLOCK_ERRORPARAMETER  = 4,       /* CLOCK parameter error                */
+    CLOCK_ERRORNOMEMORY   = 5,       /* CLOCK out of memory                  */
+    CLOCK_ERRORISR        = 6,       /* CLOCK not allowed in ISR context     */
+    CLOCK_RESERVED        = 0xFF,    /* CLOCK reserved                       */
+} clock_status_t;
+
+typedef enum
+{
+    CLOCK_PROFILE_PERFORMANCE = 0,   /* 100 MHz from HSE, all of ART         */
+    CLOCK_PROFILE_BALANCED    = 1,   /* 84 MHz from HSE, caches only         */
+    CLOCK_PROFILE_LOW_POWER   = 2,   /* 16 MHz from HSI, PLL off             */
+    CLOCK_PROFILE_NUM         = 3,   /* number of profiles                   */
+    CLOCK_PROFILE_BOOT        = 0xFF,/* the one set by SystemClock_Config    */
+} clock_profile_t;
+
+typedef struct
+{
+    uint32_t              pllm;                   /* input divider, 2..63    */
+    uint32_t              plln;                   /* VCO multiplier, 50..432 */
+    uint32_t              pllp;                   /* SYSCLK divider, 2..8    */
+    uint32_t              pllq;                   /* USB divider, 2..15      */
+} clock_pll_t;
+
+/* called after each profile change with the new SystemCoreClock            */
+typedef void ( *pf_clock_changed_t ) ( uint32_t core_clock_hz );
+
+//******************************** Defines **********************************//
+
+//******************************* Declaring *********************************//
+
+/**
+ * @brief: Find the PLL dividers giving exactly sysclk_hz
+ * @steps:
+ *      1. Walk M from the highest VCO input (lowest jitter) down to 1 MHz
+ *      2. Take the first P whose VCO output is in range with an integer N
+ *      3. Take the smallest Q keeping the USB clock at most 48 MHz
+ *
+ * @param[in]  src_hz:    PLL input, HSE or HSI
+ * @param[in]  sysclk_hz: wanted PLL P output
+ * @param[out] pll:       the dividers
+ *
+ * @return clock_status_t: CLOCK_ERRORPARAMETER when there is no exact match
+ **/
+clock_status_t clock_pll_solve (
+                                 uint32_t            src_hz,
+                                 uint32_t            sysclk_hz,
+                                 clock_pll_t * const pll
+                                                            );
+
+/**
+ * @brief: Flash wait states needed by a HCLK, 2.7 V - 3.6 V supply
+ *
+ * @param[in]  hclk_hz: AHB clock
+ * @param[out] latency: wait states, the value of FLASH_LATENCY_x
+ *
+ * @return clock_status_t: CLOCK_ERRORPARAMETER above 100 MHz
+ **/
+clock_status_t clock_flash_latency ( uint32_t hclk_hz, uint32_t * const latency );
+
+/**
+ * @brief: Switch the whole clock tree to a profile
+ * @steps:
+ *      1. Solve the PLL and the flash latency of the preset
+ *      2. Start HSE (nothing is touched when it does not come up), run from
+ *         HSI, set the regulator scale, start the PLL, switch the buses
+ *      3. Reset and enable the ART accelerator as the preset says
+ *      4. Rescale SysTick, rebase the time service, call the listeners
+ *
+ * @param[in]  profile: one of CLOCK_PROFILE_PERFORMANCE .. LOW_POWER
+ *
+ * @return clock_status_t: execute result of this function
+ **/
+clock_status_t clock_profile_apply ( clock_profile_t profile );
+
+/**
+ * @brief: Reset the ART caches and enable the requested parts, the flash
+ *         latency is not changed
+ *
+ * @param[in]  art: CLOCK_ART_* bits
+ **/
+void clock_art_set ( uint32_t art );
+
+/**
+ * @brief: Profile applied last
+ *
+ * @return clock_profile_t: CLOCK_PROFILE_BOOT until the first apply
+ **/
+clock_profile_t clock_profile_get ( void );
+
+/**
+ * @brief: Printable name of a profile
+ *
+ * @param[in]  profile: any clock_profile_t
+ *
+ * @return const char *: name, "boot" for CLOCK_PROFILE_BOOT
+ **/
+const char * clock_profile_name ( clock_profile_t profile );
+
+/**
+ * @brief: Add a callback run after every profile change, e.g. to rewrite a
+ *         UART BRR or a TIM prescaler
+ *
+ * @param[in]  pf_changed: callback, called in the applying task
+ *
+ * @return clock_status_t: execute result of this function
+ **/
+clock_status_t clock_listener_register ( pf_clock_changed_t pf_changed );
+
+//******************************* Declaring *********************************//
+#endif // __BSP_CLOCK_H__
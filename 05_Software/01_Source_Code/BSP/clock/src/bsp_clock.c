@@ -0,0 +1,465 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_clock.c
+ *
+ * @par dependencies
+ * - bsp_clock.h
+ * - bsp_time.h
+ *
+ * @author Damian
+ *
+ * @brief Switch the clock tree between presets: PLL, bus dividers, flash
+ *        latency, regulator scale and ART accelerator set together.
+ *
+ * Processing flow:
+ *
+ * Call directly.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+//******************************** Includes *********************************//
+
+#include "bsp_clock.h"
+#include "bsp_common.h"
+#include "bsp_time.h"
+
+#ifndef BENCH_HOST_POSIX
+#include "main.h"
+#endif /* BENCH_HOST_POSIX */
+
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+BSP_STATUS_CHECK( CLOCK );
+
+#define CLOCK_VCO_IN_MIN_HZ     1000000U      /* PLL input range             */
+#define CLOCK_VCO_IN_MAX_HZ     2000000U
+#define CLOCK_VCO_OUT_MIN_HZ    100000000U    /* VCO output range            */
+#define CLOCK_VCO_OUT_MAX_HZ    432000000U
+#define CLOCK_PLLM_MIN          2U
+#define CLOCK_PLLM_MAX          63U
+#define CLOCK_PLLN_MIN          50U
+#define CLOCK_PLLN_MAX          432U
+#define CLOCK_PLLQ_MIN          2U
+#define CLOCK_PLLQ_MAX          15U
+#define CLOCK_VOS3_MAX_HZ       64000000U     /* max HCLK of scale 3         */
+#define CLOCK_VOS2_MAX_HZ       84000000U     /* max HCLK of scale 2         */
+
+/* max HCLK of 0, 1, 2 and 3 wait states, 2.7 V - 3.6 V                      */
+static const uint32_t s_latency_max_hz[] =
+{
+    30000000U, 64000000U, 90000000U, 100000000U
+};
+
+// the host build (BENCH_HOST_POSIX) only takes the arithmetic, no RCC
+#ifndef BENCH_HOST_POSIX
+typedef struct
+{
+    const char            * name;                 /* printable name          */
+    uint32_t              src_hz;                 /* HSE or HSI              */
+    uint32_t              sysclk_hz;              /* == src_hz: PLL off      */
+    uint32_t              apb1_div;               /* RCC_HCLK_DIVx, <= 50MHz */
+    uint32_t              apb2_div;               /* RCC_HCLK_DIVx           */
+    uint32_t              art;                    /* CLOCK_ART_* bits        */
+} clock_preset_t;
+
+static const clock_preset_t s_preset[CLOCK_PROFILE_NUM] =
+{
+    { "performance", CLOCK_HSE_HZ, 100000000U, RCC_HCLK_DIV2, RCC_HCLK_DIV1,
+      CLOCK_ART_PREFETCH | CLOCK_ART_ICACHE | CLOCK_ART_DCACHE              },
+    { "balanced",    CLOCK_HSE_HZ,  84000000U, RCC_HCLK_DIV2, RCC_HCLK_DIV1,
+      CLOCK_ART_ICACHE | CLOCK_ART_DCACHE                                   },
+    { "low_power",   CLOCK_HSI_HZ,  16000000U, RCC_HCLK_DIV1, RCC_HCLK_DIV1,
+      CLOCK_ART_ICACHE | CLOCK_ART_DCACHE                                   },
+};
+
+static clock_profile_t    s_profile = CLOCK_PROFILE_BOOT;
+static uint32_t           s_listener_num = 0U;
+static pf_clock_changed_t s_listener[MAX_CLOCK_LISTENER_NUM];
+#endif /* BENCH_HOST_POSIX */
+
+/**
+ * @brief: Find the PLL dividers giving exactly sysclk_hz
+ * @steps:
+ *      1. Walk M from the highest VCO input (lowest jitter) down to 1 MHz
+ *      2. Take the first P whose VCO output is in range with an integer N
+ *      3. Take the smallest Q keeping the USB clock at most 48 MHz
+ *
+ * @param[in]  src_hz:    PLL input, HSE or HSI
+ * @param[in]  sysclk_hz: wanted PLL P output
+ * @param[out] pll:       the dividers
+ *
+ * @return clock_status_t: CLOCK_ERRORPARAMETER when there is no exact match
+ **/
+clock_status_t clock_pll_solve (
+                                 uint32_t            src_hz,
+                                 uint32_t            sysclk_hz,
+                                 clock_pll_t * const pll
+                                                            )
+{
+    uint32_t m_first;
+    uint64_t vco_out;
+    uint64_t n_scaled;
+    uint32_t q;
+
+    if ( NULL == pll || 0U == src_hz || 0U == sysclk_hz )
+    {
+        return CLOCK_ERRORPARAMETER;
+    }
+
+    /*********** 1. Highest VCO input first ************/
+    m_first = ( src_hz + CLOCK_VCO_IN_MAX_HZ - 1U ) / CLOCK_VCO_IN_MAX_HZ;
+    if ( m_first < CLOCK_PLLM_MIN )
+    {
+        m_first = CLOCK_PLLM_MIN;
+    }
+    for ( uint32_t m = m_first;
+          m <= CLOCK_PLLM_MAX && src_hz / m >= CLOCK_VCO_IN_MIN_HZ;
+          ++m )
+    {
+        /******** 2. First P with an exact N ***********/
+        for ( uint32_t p = 2U; p <= 8U; p += 2U )
+        {
+            vco_out = (uint64_t)sysclk_hz * p;
+            if ( vco_out < CLOCK_VCO_OUT_MIN_HZ ||
+                 vco_out > CLOCK_VCO_OUT_MAX_HZ )
+            {
+                continue;
+            }
+            // N = vco_out * M / src, must divide exactly
+            n_scaled = vco_out * m;
+            if ( 0U != ( n_scaled % src_hz )              ||
+                 n_scaled / src_hz < CLOCK_PLLN_MIN       ||
+                 n_scaled / src_hz > CLOCK_PLLN_MAX
+                                                            )
+            {
+                continue;
+            }
+
+            /******** 3. USB clock at most 48 MHz ******/
+            q = (uint32_t)( ( vco_out + CLOCK_USB_HZ - 1U ) / CLOCK_USB_HZ );
+            if ( q < CLOCK_PLLQ_MIN )
+            {
+                q = CLOCK_PLLQ_MIN;
+            }
+            if ( q > CLOCK_PLLQ_MAX )
+            {
+                continue;
+            }
+            pll->pllm = m;
+            pll->plln = (uint32_t)( n_scaled / src_hz );
+            pll->pllp = p;
+            pll->pllq = q;
+            return CLOCK_OK;
+        }
+    }
+    return CLOCK_ERRORPARAMETER;
+}
+
+/**
+ * @brief: Flash wait states needed by a HCLK, 2.7 V - 3.6 V supply
+ *
+ * @param[in]  hclk_hz: AHB clock
+ * @param[out] latency: wait states, the value of FLASH_LATENCY_x
+ *
+ * @return clock_status_t: CLOCK_ERRORPARAMETER above 100 MHz
+ **/
+clock_status_t clock_flash_latency ( uint32_t hclk_hz, uint32_t * const latency )
+{
+    if ( NULL == latency )
+    {
+        return CLOCK_ERRORPARAMETER;
+    }
+    for ( uint32_t ws = 0U;
+          ws < sizeof( s_latency_max_hz ) / sizeof( s_latency_max_hz[0] );
+          ++ws )
+    {
+        if ( hclk_hz <= s_latency_max_hz[ws] )
+        {
+            *latency = ws;
+            return CLOCK_OK;
+        }
+    }
+    return CLOCK_ERRORPARAMETER;
+}
+
+#ifndef BENCH_HOST_POSIX
+/**
+ * @brief: Regulator scale allowing a HCLK
+ *
+ * @param[in]  hclk_hz: AHB clock
+ *
+ * @return uint32_t: PWR_REGULATOR_VOLTAGE_SCALEx
+ **/
+static uint32_t __vos_get ( uint32_t hclk_hz )
+{
+    if ( hclk_hz <= CLOCK_VOS3_MAX_HZ )
+    {
+        return PWR_REGULATOR_VOLTAGE_SCALE3;
+    }
+    else if ( hclk_hz <= CLOCK_VOS2_MAX_HZ )
+    {
+        return PWR_REGULATOR_VOLTAGE_SCALE2;
+    }
+    return PWR_REGULATOR_VOLTAGE_SCALE1;
+}
+
+/**
+ * @brief: Reset the ART caches and enable the requested parts, the flash
+ *         latency is not changed
+ *
+ * @param[in]  art: CLOCK_ART_* bits
+ **/
+void clock_art_set ( uint32_t art )
+{
+    // the caches may only be reset while disabled
+    __HAL_FLASH_PREFETCH_BUFFER_DISABLE();
+    __HAL_FLASH_INSTRUCTION_CACHE_DISABLE();
+    __HAL_FLASH_DATA_CACHE_DISABLE();
+    __HAL_FLASH_INSTRUCTION_CACHE_RESET();
+    __HAL_FLASH_DATA_CACHE_RESET();
+    if ( 0U != ( art & CLOCK_ART_ICACHE ) )
+    {
+        __HAL_FLASH_INSTRUCTION_CACHE_ENABLE();
+    }
+    if ( 0U != ( art & CLOCK_ART_DCACHE ) )
+    {
+        __HAL_FLASH_DATA_CACHE_ENABLE();
+    }
+    if ( 0U != ( art & CLOCK_ART_PREFETCH ) )
+    {
+        __HAL_FLASH_PREFETCH_BUFFER_ENABLE();
+    }
+}
+
+/**
+ * @brief: Program the oscillators, the PLL, the regulator and the buses
+ *
+ * @param[in]  preset:  the preset to switch to
+ * @param[in]  pll:     solved dividers, unused when the PLL stays off
+ * @param[in]  latency: flash wait states of the preset
+ *
+ * @return clock_status_t: execute result of this function
+ **/
+static clock_status_t __tree_set (
+                                   const clock_preset_t * const preset,
+                                   const clock_pll_t    * const pll,
+                                   uint32_t                     latency
+                                                                         )
+{
+    RCC_OscInitTypeDef osc     = { 0 };
+    RCC_ClkInitTypeDef clk     = { 0 };
+    uint32_t           use_pll = ( preset->src_hz != preset->sysclk_hz );
+    uint32_t           use_hse = ( CLOCK_HSE_HZ == preset->src_hz );
+
+    /************ 1. HSI for the bridge, HSE when used ************/
+    osc.OscillatorType      = RCC_OSCILLATORTYPE_HSI;
+    osc.HSIState            = RCC_HSI_ON;
+    osc.HSICalibrationValue = RCC_HSICALIBRATION_DEFAULT;
+    osc.PLL.PLLState        = RCC_PLL_NONE;
+    if ( 0U != use_hse )
+    {
+        osc.OscillatorType |= RCC_OSCILLATORTYPE_HSE;
+        osc.HSEState        = RCC_HSE_ON;
+    }
+    if ( HAL_OK != HAL_RCC_OscConfig( &osc ) )
+    {
+        LOG( LOG_LEVEL_ERR, "Clock oscillator start failed" );
+        return CLOCK_ERRORSOURCE;
+    }
+
+    /************** 2. Run from HSI, stop the PLL ****************/
+    clk.ClockType      = RCC_CLOCKTYPE_HCLK | RCC_CLOCKTYPE_SYSCLK |
+                         RCC_CLOCKTYPE_PCLK1 | RCC_CLOCKTYPE_PCLK2;
+    clk.SYSCLKSource   = RCC_SYSCLKSOURCE_HSI;
+    clk.AHBCLKDivider  = RCC_SYSCLK_DIV1;
+    clk.APB1CLKDivider = RCC_HCLK_DIV1;
+    clk.APB2CLKDivider = RCC_HCLK_DIV1;
+    if ( HAL_OK != HAL_RCC_ClockConfig( &clk, __HAL_FLASH_GET_LATENCY() ) )
+    {
+        return CLOCK_ERRORTIMEOUT;
+    }
+    osc.OscillatorType = RCC_OSCILLATORTYPE_NONE;
+    osc.PLL.PLLState   = RCC_PLL_OFF;
+    if ( HAL_OK != HAL_RCC_OscConfig( &osc ) )
+    {
+        return CLOCK_ERRORTIMEOUT;
+    }
+
+    /******** 3. Regulator scale, only writable with PLL off ******/
+    __HAL_RCC_PWR_CLK_ENABLE();
+    __HAL_PWR_VOLTAGESCALING_CONFIG( __vos_get( preset->sysclk_hz ) );
+
+    /********************** 4. Start the PLL **********************/
+    if ( 0U != use_pll )
+    {
+        osc.PLL.PLLState  = RCC_PLL_ON;
+        osc.PLL.PLLSource = ( 0U != use_hse ) ? RCC_PLLSOURCE_HSE :
+                                                RCC_PLLSOURCE_HSI;
+        osc.PLL.PLLM      = pll->pllm;
+        osc.PLL.PLLN      = pll->plln;
+        osc.PLL.PLLP      = pll->pllp;
+        osc.PLL.PLLQ      = pll->pllq;
+        if ( HAL_OK != HAL_RCC_OscConfig( &osc ) )
+        {
+            LOG( LOG_LEVEL_ERR, "Clock PLL lock failed" );
+            return CLOCK_ERRORTIMEOUT;
+        }
+    }
+
+    /******* 5. SYSCLK, dividers and latency in HAL order *********/
+    clk.SYSCLKSource   = ( 0U != use_pll ) ? RCC_SYSCLKSOURCE_PLLCLK :
+                         ( 0U != use_hse ) ? RCC_SYSCLKSOURCE_HSE    :
+                                             RCC_SYSCLKSOURCE_HSI;
+    clk.APB1CLKDivider = preset->apb1_div;
+    clk.APB2CLKDivider = preset->apb2_div;
+    if ( HAL_OK != HAL_RCC_ClockConfig( &clk, latency ) )
+    {
+        return CLOCK_ERRORTIMEOUT;
+    }
+
+    /************ 6. The PLL does not use HSE any more ************/
+    if ( 0U == use_hse )
+    {
+        osc.OscillatorType = RCC_OSCILLATORTYPE_HSE;
+        osc.HSEState       = RCC_HSE_OFF;
+        osc.PLL.PLLState   = RCC_PLL_NONE;
+        (void)HAL_RCC_OscConfig( &osc );
+    }
+    return CLOCK_OK;
+}
+
+/**
+ * @brief: Switch the whole clock tree to a profile
+ * @steps:
+ *      1. Solve the PLL and the flash latency of the preset
+ *      2. Start HSE (nothing is touched when it does not come up), run from
+ *         HSI, set the regulator scale, start the PLL, switch the buses
+ *      3. Reset and enable the ART accelerator as the preset says
+ *      4. Rescale SysTick, rebase the time service, call the listeners
+ *
+ * @param[in]  profile: one of CLOCK_PROFILE_PERFORMANCE .. LOW_POWER
+ *
+ * @return clock_status_t: execute result of this function
+ **/
+clock_status_t clock_profile_apply ( clock_profile_t profile )
+{
+    const clock_preset_t * preset;
+    clock_pll_t            pll    = { 0U };
+    uint32_t               latency;
+    uint32_t               old_hz = SystemCoreClock;
+    uint32_t               reload;
+    clock_status_t         ret;
+
+    /************ 1. Checking the input parameters **********/
+    if ( 0U != __get_IPSR() )
+    {
+        return CLOCK_ERRORISR;
+    }
+    else if ( profile >= CLOCK_PROFILE_NUM )
+    {
+        LOG( LOG_LEVEL_ERR, "Clock profile %d unknown", profile );
+        return CLOCK_ERRORPARAMETER;
+    }
+    preset = &s_preset[profile];
+    if ( CLOCK_OK != clock_flash_latency( preset->sysclk_hz, &latency ) ||
+         ( preset->src_hz != preset->sysclk_hz &&
+           CLOCK_OK != clock_pll_solve( preset->src_hz,
+                                        preset->sysclk_hz, &pll ) )
+                                                                          )
+    {
+        LOG( LOG_LEVEL_ERR, "Clock profile %s not reachable", preset->name );
+        return CLOCK_ERRORPARAMETER;
+    }
+
+    /************** 2. Oscillators, PLL and buses ***********/
+    ret = __tree_set( preset, &pll, latency );
+
+    /************************ 3. ART ************************/
+    if ( CLOCK_OK == ret )
+    {
+        clock_art_set( preset->art );
+        s_profile = profile;
+    }
+
+    /**** 4. Propagate, also after a failure left us on HSI ****/
+    if ( old_hz != SystemCoreClock )
+    {
+        // the scheduler tick counts core cycles, keep its period
+        if ( 0U != ( SysTick->CTRL & SysTick_CTRL_ENABLE_Msk ) )
+        {
+            reload = (uint32_t)( ( (uint64_t)( SysTick->LOAD + 1U ) *
+                                   SystemCoreClock ) / old_hz           );
+            SysTick->LOAD = reload - 1U;
+            SysTick->VAL  = 0U;
+        }
+        (void)time_set_core_clock( SystemCoreClock );
+        for ( uint32_t i = 0; i < s_listener_num; ++i )
+        {
+            s_listener[i]( SystemCoreClock );
+        }
+    }
+    return ret;
+}
+
+/**
+ * @brief: Profile applied last
+ *
+ * @return clock_profile_t: CLOCK_PROFILE_BOOT until the first apply
+ **/
+clock_profile_t clock_profile_get ( void )
+{
+    return s_profile;
+}
+
+/**
+ * @brief: Printable name of a profile
+ *
+ * @param[in]  profile: any clock_profile_t
+ *
+ * @return const char *: name, "boot" for CLOCK_PROFILE_BOOT
+ **/
+const char * clock_profile_name ( clock_profile_t profile )
+{
+    if ( profile >= CLOCK_PROFILE_NUM )
+    {
+        return "boot";
+    }
+    return s_preset[profile].name;
+}
+
+/**
+ * @brief: Add a callback run after every profile change, e.g. to rewrite a
+ *         UART BRR or a TIM prescaler
+ *
+ * @param[in]  pf_changed: callback, called in the applying task
+ *
+ * @return clock_status_t: execute result of this function
+ **/
+clock_status_t clock_listener_register ( pf_clock_changed_t pf_changed )
+{
+    if ( NULL == pf_changed )
+    {
+        LOG( LOG_LEVEL_ERR, "Input parameter is null" );
+        return CLOCK_ERRORPARAMETER;
+    }
+    else if ( s_listener_num >= MAX_CLOCK_LISTENER_NUM )
+    {
+        LOG( LOG_LEVEL_ERR, "Clock listener group is full" );
+        return CLOCK_ERRORNOMEMORY;
+    }
+    s_listener[s_listener_num] = pf_changed;
+    s_listener_num++;
+    return CLOCK_OK;
+}
+#endif /* BENCH_HOST_POSIX */
+
+//******************************** Defines **********************************//
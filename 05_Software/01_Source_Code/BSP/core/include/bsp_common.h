@@ -0,0 +1,126 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_common.h
+ *
+ * @par dependencies
+ * - stdio.h
+ * - stdint.h
+ *
+ * @author Damian
+ *
+ * @brief Provide the log macro, init flags and status codes shared by all the
+ *        BSP modules.
+ *
+ * Processing flow:
+ *
+ * Call directly.
+ *
+ * The module status enums (LED_INST_*, KEY_HNDLR_*, ...) keep the values of
+ * bsp_status_t, so a module result can always be cast to bsp_status_t; the
+ * source of every module pins its enum with BSP_STATUS_CHECK.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+#ifndef __BSP_COMMON_H__
+#define __BSP_COMMON_H__
+
+//******************************** Includes *********************************//
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stddef.h>
+
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+#define OS_SUPPORTING                       /* OS is available               */
+#define LOG_LEVEL_DEFAULT LOG_LEVEL_WARN    /* Level until one is stored     */
+#define CURRENT_LOG_LEVEL bsp_log_level     /* Define the level of log       */
+#define LOG(level, fmt, ...) \
+        do { \
+            if (level >= CURRENT_LOG_LEVEL) { \
+                const char *level_str[] = {"DBG ", "INFO", "WARN", "ERR "}; \
+                printf("[%s]%s:%d " fmt "\r\n", level_str[level], \
+                                              __FILE__, \
+                                              __LINE__, \
+                                              ##__VA_ARGS__); \
+            } \
+        } while (0)
+
+#define BSP_WAIT_FOREVER  0xFFFFFFFFU       /* block until done, in ms       */
+
+/*
+ * Hot function executed from SRAM: the homework_06_release scatter file
+ * places .RamFunc in RW_IRAM1, the debug target keeps it in flash.
+ */
+#if defined ( __CC_ARM ) || defined ( __GNUC__ )
+#define BSP_RAMFUNC       __attribute__((section(".RamFunc")))
+#else
+#define BSP_RAMFUNC
+#endif
+
+/*
+ * Variable kept over a reset: both scatter files place .bss.noinit in the
+ * UNINIT region RW_NOINIT, __main neither copies nor clears it. The content
+ * is random after a power on, check it before use.
+ */
+#if defined ( __CC_ARM )
+#define BSP_NOINIT        __attribute__((section(".bss.noinit"), zero_init))
+#elif defined ( __GNUC__ )
+#define BSP_NOINIT        __attribute__((section(".bss.noinit")))
+#else
+#define BSP_NOINIT
+#endif
+
+typedef enum {
+    LOG_LEVEL_DBG       = 0,        /* Print DBG & INFO & WARN & ERR         */
+    LOG_LEVEL_INFO      = 1,        /* Print INFO & WARN & ERR               */
+    LOG_LEVEL_WARN      = 2,        /* Print WARN & ERR                      */
+    LOG_LEVEL_ERR       = 3,        /* Print ERR                             */
+    LOG_LEVEL_OFF       = 4,        /* Print nothing                         */
+} log_level_t;
+
+/* level LOG prints from, defined in bsp_device.c, any task may change it */
+extern volatile log_level_t bsp_log_level;
+
+typedef enum
+{
+    BSP_INITED          = 0,        /* BSP object initialized                */
+    BSP_NOT_INITED      = 1,        /* BSP object not initialized            */
+} bsp_init_t;
+
+typedef enum
+{
+    BSP_OK              = 0,         /* BSP operate successfully             */
+    BSP_ERROR           = 1,         /* BSP error without case matched       */
+    BSP_ERRORTIMEOUT    = 2,         /* BSP operate failed with timeout      */
+    BSP_ERRORSOURCE     = 3,         /* BSP resource not available           */
+    BSP_ERRORPARAMETER  = 4,         /* BSP parameter error                  */
+    BSP_ERRORNOMEMORY   = 5,         /* BSP out of memory                    */
+    BSP_ERRORISR        = 6,         /* BSP not allowed in ISR context       */
+    BSP_RESERVED        = 0xFF,      /* BSP reserved                         */
+} bsp_status_t;
+
+/* the build fails when a value of <prefix>_status_t drifts from bsp_status_t */
+#define BSP_STATUS_CHECK(prefix) \
+        typedef char prefix##_status_check_t[ \
+            ( (int)BSP_OK             == (int)prefix##_OK             && \
+              (int)BSP_ERROR          == (int)prefix##_ERROR          && \
+              (int)BSP_ERRORTIMEOUT   == (int)prefix##_ERRORTIMEOUT   && \
+              (int)BSP_ERRORSOURCE    == (int)prefix##_ERRORSOURCE    && \
+              (int)BSP_ERRORPARAMETER == (int)prefix##_ERRORPARAMETER && \
+              (int)BSP_ERRORNOMEMORY  == (int)prefix##_ERRORNOMEMORY  && \
+              (int)BSP_ERRORISR       == (int)prefix##_ERRORISR       && \
+              (int)BSP_RESERVED       == (int)prefix##_RESERVED ) ? 1 : -1 ]
+
+//******************************** Defines **********************************//
+
+#endif // __BSP_COMMON_H__
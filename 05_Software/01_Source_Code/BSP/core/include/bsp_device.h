@@ -0,0 +1,251 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_device.h
+ *
+ * @par dependencies
+ * - bsp_common.h
+ * - bsp_osal.h
+ *
+ * @author Damian
+ *
+ * @brief Provide the device object, the device registry and the command
+ *        queue worker shared by the BSP drivers.
+ *
+ * Processing flow:
+ *
+ * bsp_core_init -> bsp_device_inst -> bsp_device_register -> bsp_device_find
+ *                                                         -> ioctl
+ *               -> bsp_worker_inst -> bsp_worker_post (any task)
+ *                                  -> worker task -> bsp_worker_run
+ *                                                 -> pf_ioctl -> pf_done
+ *
+ * A device class provides <cls>_open, <cls>_close and <cls>_ioctl and builds
+ * its vtable with BSP_DEVICE_CLASS( <cls> ), the LED driver is one (led_ops).
+ * Generic code calls through the vtable with BSP_DEVICE_IOCTL, a hot path
+ * knowing the class at compile time uses BSP_DEVICE_IOCTL_AS, which is a
+ * direct call the compiler can inline.
+ *
+ * A worker runs the commands posted to it in its own task, in their
+ * posting order: a driver hands it what would block its caller, the LED
+ * handler its twinkles.
+ *
+ * The registry only takes the critical section of the OSAL, a worker its
+ * queue and thread interfaces; a host build passes mock ones and plays the
+ * worker task with bsp_worker_run.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+#ifndef __BSP_DEVICE_H__
+#define __BSP_DEVICE_H__
+
+//******************************** Includes *********************************//
+
+#include "bsp_common.h"
+#include "bsp_osal.h"
+
+//******************************** Includes *********************************//
+
+typedef struct bsp_device bsp_device_t;
+typedef struct bsp_cmd    bsp_cmd_t;
+
+//******************************** Defines **********************************//
+
+#define MAX_BSP_DEVICE_NUM    16U           /* Max number of registered dev  */
+
+/* vtable of a device class from <cls>_open, <cls>_close and <cls>_ioctl    */
+#define BSP_DEVICE_CLASS(cls) \
+        const bsp_device_ops_t cls##_ops = { cls##_open,  \
+                                             cls##_close, \
+                                             cls##_ioctl }
+
+/* call through the vtable, the class of dev is not known                    */
+#define BSP_DEVICE_IOCTL(dev, cmd, arg) \
+        ( (dev)->p_ops->pf_ioctl( (dev), (cmd), (arg) ) )
+
+/* call specialised at compile time, no indirection on the hot path          */
+#define BSP_DEVICE_IOCTL_AS(cls, dev, cmd, arg) \
+        ( cls##_ioctl( (dev), (cmd), (arg) ) )
+
+typedef struct
+{
+    bsp_status_t ( *pf_open )  ( bsp_device_t * const dev );
+    bsp_status_t ( *pf_close ) ( bsp_device_t * const dev );
+    bsp_status_t ( *pf_ioctl ) (
+                                 bsp_device_t * const dev,
+                                 uint32_t             cmd,
+                                 void         * const arg
+                                                          );
+} bsp_device_ops_t;
+
+typedef struct bsp_device
+{
+    //************************** Internal status ****************************//
+    bsp_init_t               is_initialized;          /* record init status  */
+    bsp_init_t               is_registered;           /* opened and listed   */
+
+    //****************************** Property *******************************//
+    const char               * name;                  /* key of the registry */
+    void                     * priv;                  /* driver instance     */
+
+    //************************ Interface from driver ************************//
+    const bsp_device_ops_t   * p_ops;                 /* class vtable        */
+} bsp_device_t;
+
+typedef void ( *pf_bsp_cmd_done_t ) ( bsp_cmd_t * const cmd,
+                                      bsp_status_t       result );
+
+typedef struct bsp_cmd
+{
+    bsp_device_t             * dev;                   /* target device       */
+    uint32_t                 cmd;                     /* ioctl command       */
+    void                     * arg;                   /* ioctl argument      */
+    pf_bsp_cmd_done_t        pf_done;                 /* NULL: fire & forget */
+    void                     * context;               /* for pf_done         */
+} bsp_cmd_t;
+
+typedef struct
+{
+    //************************** Internal status ****************************//
+    bsp_init_t               is_initialized;          /* record init status  */
+    void                     * queue;                 /* queue of bsp_cmd_t  */
+    uint32_t                 executed;                /* commands run        */
+    uint32_t                 failed;                  /* commands not BSP_OK */
+} bsp_worker_t;
+
+//******************************** Defines **********************************//
+
+//******************************* Declaring *********************************//
+
+/**
+ * @brief: Mount the OS interfaces used by the registry and the workers,
+ *         empty the registry
+ *
+ * @param[in]  osal: Pointer to a instance of bsp_osal_t, must stay valid,
+ *                   p_os_critical is required, p_os_queue and p_os_thread
+ *                   only by bsp_worker_inst
+ *
+ * @return bsp_status_t: execute result of this function
+ **/
+bsp_status_t bsp_core_init ( bsp_osal_t * const osal );
+
+/**
+ * @brief: Instantiate a bsp_device_t
+ *
+ * @param[in]  dev:  Pointer to a instance of bsp_device_t
+ * @param[in]  name: name of the device, must stay valid
+ * @param[in]  ops:  vtable of the device class
+ * @param[in]  priv: driver instance behind the device
+ *
+ * @return bsp_status_t: execute result of this function
+ **/
+bsp_status_t bsp_device_inst (
+                               bsp_device_t           * const dev,
+                               const char             * const name,
+                               const bsp_device_ops_t * const ops,
+                               void                   * const priv
+                                                                    );
+
+/**
+ * @brief: Open a device and add it into the registry
+ * @steps:
+ *      1. Check the name is not taken and the registry is not full
+ *      2. Open the device, outside of the critical section
+ *      3. Check both again and add it into the registry, close it when
+ *         another task took the name or the last slot meanwhile
+ *
+ * @param[in]  dev: Pointer to a instance of bsp_device_t
+ *
+ * @return bsp_status_t: execute result of this function
+ **/
+bsp_status_t bsp_device_register ( bsp_device_t * const dev );
+
+/**
+ * @brief: Look a registered device up by name
+ *
+ * @param[in]  name: name of the device
+ *
+ * @return bsp_device_t *: the device, NULL when not registered
+ **/
+bsp_device_t * bsp_device_find ( const char * const name );
+
+/**
+ * @brief: Checked ioctl through the vtable
+ *
+ * @param[in]  dev: Pointer to a registered bsp_device_t
+ * @param[in]  cmd: ioctl command of the device class
+ * @param[in]  arg: ioctl argument of the device class
+ *
+ * @return bsp_status_t: execute result of the ioctl
+ **/
+bsp_status_t bsp_device_ioctl (
+                                bsp_device_t * const dev,
+                                uint32_t             cmd,
+                                void         * const arg
+                                                          );
+
+/**
+ * @brief: Instantiate a worker running device commands in its own task
+ * @steps:
+ *      1. Create the command queue
+ *      2. Create the worker task
+ *
+ * @param[in]  worker:      Pointer to a instance of bsp_worker_t
+ * @param[in]  name:        name of the worker task
+ * @param[in]  depth:       number of commands the queue holds
+ * @param[in]  stack_words: stack of the worker task
+ * @param[in]  priority:    priority of the worker task
+ *
+ * @return bsp_status_t: execute result of this function
+ **/
+bsp_status_t bsp_worker_inst (
+                               bsp_worker_t * const worker,
+                               const char   * const name,
+                               uint32_t             depth,
+                               uint32_t             stack_words,
+                               uint32_t             priority
+                                                              );
+
+/**
+ * @brief: Post a command to a worker, it is copied into the queue
+ *
+ * @param[in]  worker:     Pointer to a instance of bsp_worker_t
+ * @param[in]  cmd:        command to run, dev must be registered when it
+ *                         runs, arg must stay valid until then
+ * @param[in]  timeout_ms: max wait for a free slot, 0 from ISR
+ *
+ * @return bsp_status_t: execute result of this function
+ **/
+bsp_status_t bsp_worker_post (
+                               bsp_worker_t    * const worker,
+                               const bsp_cmd_t * const cmd,
+                               uint32_t                timeout_ms
+                                                                 );
+
+/**
+ * @brief: Run the next command of a worker, the worker task calls it
+ *         forever; a host build calls it to play the task
+ * @steps:
+ *      1. Take the next command from the queue
+ *      2. Run its ioctl through the vtable, count the result
+ *      3. Hand the result to pf_done
+ *
+ * @param[in]  worker:     Pointer to a instance of bsp_worker_t
+ * @param[in]  timeout_ms: max wait for a command
+ *
+ * @return bsp_status_t: BSP_ERRORTIMEOUT when no command came, else
+ *                       BSP_OK, the result of the command goes to pf_done
+ **/
+bsp_status_t bsp_worker_run (
+                              bsp_worker_t * const worker,
+                              uint32_t             timeout_ms
+                                                             );
+
+//******************************* Declaring *********************************//
+#endif // __BSP_DEVICE_H__
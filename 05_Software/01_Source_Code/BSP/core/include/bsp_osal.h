@@ -0,0 +1,118 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_osal.h
+ *
+ * @par dependencies
+ * - bsp_common.h
+ *
+ * @author Damian
+ *
+ * @brief Provide the OS and time interfaces the core hands to the BSP
+ *        modules.
+ *
+ * Processing flow:
+ *
+ * The core fills one instance of every interface (see freertos.c) and
+ * passes them to the modules, either one by one as the led handler takes
+ * them, or grouped in a bsp_osal_t. A host build passes mock instances.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+#ifndef __BSP_OSAL_H__
+#define __BSP_OSAL_H__
+
+//******************************** Includes *********************************//
+
+#include "bsp_common.h"
+
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+typedef struct
+{
+    bsp_status_t ( *pf_get_time_ms )  ( uint32_t * const );
+    bsp_status_t ( *pf_get_time_us )  ( uint64_t * const );
+} time_operation_t;
+
+typedef struct
+{
+    bsp_status_t ( *pf_os_delay_ms )  ( const uint32_t );
+} os_delay_t;
+
+typedef struct
+{
+    bsp_status_t ( *pf_os_critical_enter )  ( void );
+    bsp_status_t ( *pf_os_critical_exit )   ( void );
+} os_critical_t;
+
+typedef struct
+{
+    /* OS mutex create, with priority inheritance */
+    bsp_status_t ( *pf_os_mutex_create ) ( void ** const mutex_handler );
+    /* OS mutex lock, task context only */
+    bsp_status_t ( *pf_os_mutex_lock )   (
+                                                void *   const mutex_handler,
+                                                uint32_t       timeout       );
+    /* OS mutex unlock */
+    bsp_status_t ( *pf_os_mutex_unlock ) ( void * const mutex_handler );
+} os_mutex_t;
+
+typedef struct
+{
+    /* OS queue create */
+    bsp_status_t ( *pf_os_queue_create ) (
+                                                uint32_t const num,
+                                                uint32_t const size,
+                                                void **  const queue_handler );
+
+    /* OS queue put */
+    bsp_status_t ( *pf_os_queue_put ) (
+                                                void *   const queue_handler,
+                                                void *   const item,
+                                                uint32_t       timeout       );
+
+    /* OS queue get */
+    bsp_status_t ( *pf_os_queue_get ) (
+                                                void *   const queue_handler,
+                                                void *   const msg,
+                                                uint32_t       timeout       );
+
+    /* OS queue delete */
+    bsp_status_t ( *pf_os_queue_delete ) (
+                                                void *   const queue_handler
+                                                                             );
+
+} os_queue_t;
+
+typedef struct
+{
+    /* OS thread create, priority 0 is the lowest */
+    bsp_status_t ( *pf_os_thread_create ) (
+                                        void         ( *entry ) ( void * ),
+                                        const char *   const name,
+                                        uint32_t       const stack_words,
+                                        void *         const argument,
+                                        uint32_t       const priority    );
+} os_thread_t;
+
+typedef struct
+{
+    os_delay_t            * p_os_delay;             /* os delay interface    */
+    os_queue_t            * p_os_queue;             /* os queue interface    */
+    os_critical_t         * p_os_critical;          /* os critical interface */
+    os_mutex_t            * p_os_mutex;             /* os mutex interface    */
+    os_thread_t           * p_os_thread;            /* os thread interface   */
+    time_operation_t      * p_time_operation_inst;  /* time ops interface    */
+} bsp_osal_t;
+
+//******************************** Defines **********************************//
+
+#endif // __BSP_OSAL_H__
@@ -0,0 +1,408 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_device.c
+ *
+ * @par dependencies
+ * - bsp_device.h
+ *
+ * @author Damian
+ *
+ * @brief Provide the device object, the device registry and the command
+ *        queue worker shared by the BSP drivers.
+ *
+ * Processing flow:
+ *
+ * Call directly.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+//******************************** Includes *********************************//
+
+#include <string.h>
+#include "bsp_device.h"
+
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+typedef struct
+{
+    uint32_t           dev_num;                       /* num of devices      */
+    bsp_device_t     * dev_array[MAX_BSP_DEVICE_NUM]; /* registered devices  */
+} bsp_device_group_t;
+
+volatile log_level_t        bsp_log_level = LOG_LEVEL_DEFAULT;
+
+static bsp_osal_t         * s_osal      = NULL;
+static bsp_device_group_t   s_dev_group = { 0U };
+
+/**
+ * @brief: Worker task, runs the commands in their posting order
+ *
+ * @param[in]  argument: Pointer to a instance of bsp_worker_t
+ **/
+static void bsp_worker_task ( void * argument )
+{
+    bsp_worker_t * worker = (bsp_worker_t *)argument;
+
+    for ( ;; )
+    {
+        (void)bsp_worker_run( worker, BSP_WAIT_FOREVER );
+    }
+}
+
+/**
+ * @brief: Mount the OS interfaces used by the registry and the workers,
+ *         empty the registry
+ *
+ * @param[in]  osal: Pointer to a instance of bsp_osal_t, must stay valid,
+ *                   p_os_critical is required, p_os_queue and p_os_thread
+ *                   only by bsp_worker_inst
+ *
+ * @return bsp_status_t: execute result of this function
+ **/
+bsp_status_t bsp_core_init ( bsp_osal_t * const osal )
+{
+    if ( NULL == osal                ||
+         NULL == osal->p_os_critical
+                                       )
+    {
+        LOG( LOG_LEVEL_ERR, "Input parameter is null" );
+        return BSP_ERRORPARAMETER;
+    }
+    s_osal              = osal;
+    s_dev_group.dev_num = 0U;
+    return BSP_OK;
+}
+
+/**
+ * @brief: Instantiate a bsp_device_t
+ *
+ * @param[in]  dev:  Pointer to a instance of bsp_device_t
+ * @param[in]  name: name of the device, must stay valid
+ * @param[in]  ops:  vtable of the device class
+ * @param[in]  priv: driver instance behind the device
+ *
+ * @return bsp_status_t: execute result of this function
+ **/
+bsp_status_t bsp_device_inst (
+                               bsp_device_t           * const dev,
+                               const char             * const name,
+                               const bsp_device_ops_t * const ops,
+                               void                   * const priv
+                                                                    )
+{
+    /********** 1. Checking the input parameters **********/
+    if ( NULL == dev           ||
+         NULL == name          ||
+         NULL == ops           ||
+         NULL == ops->pf_open  ||
+         NULL == ops->pf_close ||
+         NULL == ops->pf_ioctl
+                                 )
+    {
+        LOG( LOG_LEVEL_ERR, "Input parameter is null" );
+        return BSP_ERRORPARAMETER;
+    }
+
+    /************* 2. Initialize the instance *************/
+    dev->name           = name;
+    dev->p_ops          = ops;
+    dev->priv           = priv;
+    dev->is_registered  = BSP_NOT_INITED;
+    dev->is_initialized = BSP_INITED;
+    return BSP_OK;
+}
+
+/**
+ * @brief: Open a device and add it into the registry
+ * @steps:
+ *      1. Check the name is not taken and the registry is not full
+ *      2. Open the device, outside of the critical section
+ *      3. Check both again and add it into the registry, close it when
+ *         another task took the name or the last slot meanwhile
+ *
+ * @param[in]  dev: Pointer to a instance of bsp_device_t
+ *
+ * @return bsp_status_t: execute result of this function
+ **/
+bsp_status_t bsp_device_register ( bsp_device_t * const dev )
+{
+    bsp_status_t ret;
+
+    /********** 1. Checking the input parameters **********/
+    if ( NULL == dev || NULL == s_osal )
+    {
+        LOG( LOG_LEVEL_ERR, "Input parameter is null or core not inited" );
+        return BSP_ERRORPARAMETER;
+    }
+    else if ( BSP_INITED != dev->is_initialized ||
+              BSP_INITED == dev->is_registered  )
+    {
+        LOG( LOG_LEVEL_ERR, "Device not initialized or registered twice" );
+        return BSP_ERRORSOURCE;
+    }
+    else if ( NULL != bsp_device_find( dev->name ) )
+    {
+        LOG( LOG_LEVEL_ERR, "Device %s already registered", dev->name );
+        return BSP_ERRORPARAMETER;
+    }
+    else if ( s_dev_group.dev_num >= MAX_BSP_DEVICE_NUM )
+    {
+        LOG( LOG_LEVEL_ERR, "Device registry is full" );
+        return BSP_ERRORNOMEMORY;
+    }
+
+    /**************** 2. Open the device ******************/
+    ret = dev->p_ops->pf_open( dev );
+    if ( BSP_OK != ret )
+    {
+        LOG( LOG_LEVEL_ERR, "Device %s open failed %d", dev->name, ret );
+        return ret;
+    }
+
+    /********** 3. Adding the dev into the group **********/
+    // the checks of step 1 ran unlocked: a task preempting the open may
+    // have registered the same name or taken the last slot
+    s_osal->p_os_critical->pf_os_critical_enter();
+    if ( NULL != bsp_device_find( dev->name ) )
+    {
+        ret = BSP_ERRORPARAMETER;
+    }
+    else if ( s_dev_group.dev_num >= MAX_BSP_DEVICE_NUM )
+    {
+        ret = BSP_ERRORNOMEMORY;
+    }
+    else
+    {
+        // fill the slot before publishing it to the lock-free readers
+        s_dev_group.dev_array[s_dev_group.dev_num] = dev;
+        s_dev_group.dev_num++;
+        dev->is_registered = BSP_INITED;
+        ret = BSP_OK;
+    }
+    s_osal->p_os_critical->pf_os_critical_exit();
+
+    if ( BSP_OK != ret )
+    {
+        dev->p_ops->pf_close( dev );
+        LOG( LOG_LEVEL_ERR, "Device %s refused, name taken or registry full",
+                            dev->name );
+    }
+    return ret;
+}
+
+/**
+ * @brief: Look a registered device up by name
+ *
+ * @param[in]  name: name of the device
+ *
+ * @return bsp_device_t *: the device, NULL when not registered
+ **/
+bsp_device_t * bsp_device_find ( const char * const name )
+{
+    uint32_t dev_num = s_dev_group.dev_num;
+
+    if ( NULL == name )
+    {
+        return NULL;
+    }
+    for ( uint32_t i = 0; i < dev_num; ++i )
+    {
+        if ( 0 == strcmp( s_dev_group.dev_array[i]->name, name ) )
+        {
+            return s_dev_group.dev_array[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief: Checked ioctl through the vtable
+ *
+ * @param[in]  dev: Pointer to a registered bsp_device_t
+ * @param[in]  cmd: ioctl command of the device class
+ * @param[in]  arg: ioctl argument of the device class
+ *
+ * @return bsp_status_t: execute result of the ioctl
+ **/
+bsp_status_t bsp_device_ioctl (
+                                bsp_device_t * const dev,
+                                uint32_t             cmd,
+                                void         * const arg
+                                                          )
+{
+    if ( NULL == dev )
+    {
+        return BSP_ERRORPARAMETER;
+    }
+    else if ( BSP_INITED != dev->is_registered )
+    {
+        return BSP_ERRORSOURCE;
+    }
+    return BSP_DEVICE_IOCTL( dev, cmd, arg );
+}
+
+/**
+ * @brief: Instantiate a worker running device commands in its own task
+ * @steps:
+ *      1. Create the command queue
+ *      2. Create the worker task
+ *
+ * @param[in]  worker:      Pointer to a instance of bsp_worker_t
+ * @param[in]  name:        name of the worker task
+ * @param[in]  depth:       number of commands the queue holds
+ * @param[in]  stack_words: stack of the worker task
+ * @param[in]  priority:    priority of the worker task
+ *
+ * @return bsp_status_t: execute result of this function
+ **/
+bsp_status_t bsp_worker_inst (
+                               bsp_worker_t * const worker,
+                               const char   * const name,
+                               uint32_t             depth,
+                               uint32_t             stack_words,
+                               uint32_t             priority
+                                                              )
+{
+    bsp_status_t ret;
+
+    /********** 1. Checking the input parameters **********/
+    if ( NULL == worker              ||
+         NULL == name                ||
+         0U   == depth               ||
+         NULL == s_osal              ||
+         NULL == s_osal->p_os_queue  ||
+         NULL == s_osal->p_os_thread
+                                       )
+    {
+        LOG( LOG_LEVEL_ERR, "Input parameter is null or core not inited" );
+        return BSP_ERRORPARAMETER;
+    }
+
+    /************* 2. Create the command queue ************/
+    worker->executed = 0U;
+    worker->failed   = 0U;
+    ret = s_osal->p_os_queue->pf_os_queue_create( depth,
+                                                  sizeof( bsp_cmd_t ),
+                                                  &worker->queue );
+    if ( BSP_OK != ret )
+    {
+        LOG( LOG_LEVEL_ERR, "Worker %s queue create failed", name );
+        return ret;
+    }
+
+    /************* 3. Create the worker task **************/
+    // inited first: the task may preempt this function right away
+    worker->is_initialized = BSP_INITED;
+    ret = s_osal->p_os_thread->pf_os_thread_create( bsp_worker_task,
+                                                    name,
+                                                    stack_words,
+                                                    worker,
+                                                    priority );
+    if ( BSP_OK != ret )
+    {
+        LOG( LOG_LEVEL_ERR, "Worker %s task create failed", name );
+        worker->is_initialized = BSP_NOT_INITED;
+        s_osal->p_os_queue->pf_os_queue_delete( worker->queue );
+        worker->queue = NULL;
+    }
+    return ret;
+}
+
+/**
+ * @brief: Post a command to a worker, it is copied into the queue
+ *
+ * @param[in]  worker:     Pointer to a instance of bsp_worker_t
+ * @param[in]  cmd:        command to run, dev must be registered when it
+ *                         runs, arg must stay valid until then
+ * @param[in]  timeout_ms: max wait for a free slot, 0 from ISR
+ *
+ * @return bsp_status_t: execute result of this function
+ **/
+bsp_status_t bsp_worker_post (
+                               bsp_worker_t    * const worker,
+                               const bsp_cmd_t * const cmd,
+                               uint32_t                timeout_ms
+                                                                 )
+{
+    if ( NULL == worker ||
+         NULL == cmd    ||
+         NULL == cmd->dev
+                          )
+    {
+        return BSP_ERRORPARAMETER;
+    }
+    else if ( BSP_INITED != worker->is_initialized )
+    {
+        return BSP_ERRORSOURCE;
+    }
+    return s_osal->p_os_queue->pf_os_queue_put( worker->queue,
+                                                (void *)cmd,
+                                                timeout_ms );
+}
+
+/**
+ * @brief: Run the next command of a worker, the worker task calls it
+ *         forever; a host build calls it to play the task
+ * @steps:
+ *      1. Take the next command from the queue
+ *      2. Run its ioctl through the vtable, count the result
+ *      3. Hand the result to pf_done
+ *
+ * @param[in]  worker:     Pointer to a instance of bsp_worker_t
+ * @param[in]  timeout_ms: max wait for a command
+ *
+ * @return bsp_status_t: BSP_ERRORTIMEOUT when no command came, else
+ *                       BSP_OK, the result of the command goes to pf_done
+ **/
+bsp_status_t bsp_worker_run (
+                              bsp_worker_t * const worker,
+                              uint32_t             timeout_ms
+                                                             )
+{
+    bsp_cmd_t    cmd;
+    bsp_status_t ret;
+
+    if ( NULL == worker )
+    {
+        return BSP_ERRORPARAMETER;
+    }
+    else if ( BSP_INITED != worker->is_initialized )
+    {
+        return BSP_ERRORSOURCE;
+    }
+
+    /************ 1. Take the next command ***************/
+    if ( BSP_OK != s_osal->p_os_queue->pf_os_queue_get( worker->queue,
+                                                        &cmd,
+                                                        timeout_ms ) )
+    {
+        return BSP_ERRORTIMEOUT;
+    }
+
+    /************ 2. Run it through the vtable ***********/
+    // checked: the device may have been refused since the post
+    ret = bsp_device_ioctl( cmd.dev, cmd.cmd, cmd.arg );
+    worker->executed++;
+    if ( BSP_OK != ret )
+    {
+        worker->failed++;
+    }
+
+    /*************** 3. Report the result ****************/
+    if ( NULL != cmd.pf_done )
+    {
+        cmd.pf_done( &cmd, ret );
+    }
+    return BSP_OK;
+}
+
+//******************************** Defines **********************************//
@@ -0,0 +1,218 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_crc.h
+ *
+ * @par dependencies
+ * - bsp_osal.h
+ *
+ * @author Damian
+ *
+ * @brief CRC-32/MPEG-2 service: the STM32 CRC unit fed by the CPU or by a
+ *        DMA stream, a slice-by-8 table implementation without it, the same
+ *        results on both.
+ *
+ * Processing flow:
+ *
+ * crc_inst (hardware operations or NULL for software only)
+ * crc_calc       -> bytes: the unit takes the whole words, byte reversed,
+ *                   the last 1..3 bytes go through the tables
+ * crc_calc_words -> words: the unit takes them as they are, by DMA from
+ *                   dma_min_words on, the caller blocks until the DMA
+ *                   complete interrupt calls crc_dma_done_isr
+ * crc32_mpeg2_sw -> tables only, any context, continues a CRC
+ *
+ * CRC-32/MPEG-2: polynomial 0x04C11DB7, init 0xFFFFFFFF, bits not
+ * reflected, no final XOR; "123456789" gives CRC32_MPEG2_CHECK. The F4
+ * unit computes it over 32-bit words, most significant byte first, and has
+ * no byte order option, so:
+ *
+ *  crc_calc       CRC-32/MPEG-2 of the bytes in memory order
+ *  crc_calc_words CRC-32/MPEG-2 of the words, each most significant byte
+ *                 first, what the unit and the DMA compute natively: on
+ *                 the little endian core crc_calc of the bytes of every
+ *                 word reversed
+ *
+ * The unit always restarts from 0xFFFFFFFF, so a CRC over several buffers
+ * runs in software: crc32_mpeg2_sw( crc32_mpeg2_sw( CRC32_MPEG2_INIT, a ),
+ * b ). The unit is shared by the tasks through the mutex.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+#ifndef __BSP_CRC_H__
+#define __BSP_CRC_H__
+
+//******************************** Includes *********************************//
+
+#include "bsp_osal.h"
+#include <stdint.h>
+
+//******************************** Includes *********************************//
+
+typedef struct bsp_crc bsp_crc_t;
+
+//******************************** Defines **********************************//
+
+#define CRC32_MPEG2_POLY          0x04C11DB7U
+#define CRC32_MPEG2_INIT          0xFFFFFFFFU
+#define CRC32_MPEG2_CHECK         0x0376E6E7U /* of "123456789"             */
+#define CRC_DMA_MIN_WORDS         128U       /* fewer: the CPU feeds them   */
+#define CRC_DMA_MAX_WORDS         0xFFFFU    /* of one DMA transfer (NDTR)  */
+#define CRC_LOCK_TIMEOUT_MS       100U       /* wait for the unit           */
+#define CRC_DMA_TIMEOUT_MS        100U       /* wait for one DMA transfer   */
+
+typedef enum
+{
+    CRC_OK                       = 0,  /* CRC operate successfully           */
+    CRC_ERROR                    = 1,  /* CRC DMA transfer error             */
+    CRC_ERRORTIMEOUT             = 2,  /* CRC unit busy or DMA too long      */
+    CRC_ERRORSOURCE              = 3,  /* CRC not initialized                */
+    CRC_ERRORPARAMETER           = 4,  /* CRC parameter error                */
+    CRC_ERRORNOMEMORY            = 5,  /* CRC mutex or queue not created     */
+    CRC_ERRORISR                 = 6,  /* CRC not allowed in ISR context     */
+    CRC_RESERVED                 = 0xFF,/* CRC reserved                      */
+} crc_status_t;
+
+typedef enum
+{
+    CRC_INITED     = 0,  /* crc service initialized                          */
+    CRC_NOT_INITED = 1,  /* crc service not initialized                      */
+} crc_init_t;
+
+typedef struct
+{
+    /* data register back to 0xFFFFFFFF                                    */
+    crc_status_t ( *pf_crc_reset )     ( void );
+    /* CPU writes of words at any alignment, reverse: bytes of each word   */
+    crc_status_t ( *pf_crc_feed )      ( const void * const data,
+                                         uint32_t           words,
+                                         uint32_t           reverse );
+    /* DMA into the data register, NULL: the CPU feeds every buffer        */
+    crc_status_t ( *pf_crc_dma_start ) ( const uint32_t * const words,
+                                         uint32_t               num   );
+    /* abort a DMA transfer after a timeout                                */
+    crc_status_t ( *pf_crc_dma_stop )  ( void );
+    /* data register                                                       */
+    uint32_t     ( *pf_crc_read )      ( void );
+} crc_hw_operation_t;
+
+typedef struct bsp_crc
+{
+    //************************* Internal property ***************************//
+    crc_init_t            is_initialized;             /* record init status  */
+    void                  * mutex;                    /* owner of the unit   */
+    void                  * done_queue;               /* DMA result, 1 item  */
+    uint32_t              dma_min_words;              /* CRC_DMA_MIN_WORDS   */
+
+    //***************************** Statistics ******************************//
+    uint32_t              hw_calls;                   /* CPU fed the unit    */
+    uint32_t              dma_calls;                  /* DMA fed the unit    */
+    uint32_t              sw_calls;                   /* tables only         */
+    uint32_t              dma_errors;                 /* error or timeout    */
+
+    //************************ Interface from core **************************//
+    crc_hw_operation_t    * p_hw_operation_inst;      /* NULL: software      */
+
+    //************************ Interface from RTOS **************************//
+    os_mutex_t            * p_os_mutex;             /* os mutex interface    */
+    os_queue_t            * p_os_queue;             /* os queue interface    */
+
+} bsp_crc_t;
+
+//******************************** Defines **********************************//
+
+//******************************* Declaring *********************************//
+
+/**
+ * @brief: Instantiate a bsp_crc_t
+ * @steps:
+ *      1. Build the slice-by-8 tables
+ *      2. Adding the hardware and OS interfaces into the instance
+ *      3. Create the mutex of the unit and the queue of the DMA result
+ *
+ * @param[in]  crc:      Pointer to a instance of bsp_crc_t
+ * @param[in]  hw_ops:   Pointer to a instance of crc_hw_operation_t, NULL
+ *                       for software only
+ * @param[in]  os_mutex: Pointer to a instance of os_mutex_t, with hw_ops
+ * @param[in]  os_queue: Pointer to a instance of os_queue_t, with DMA
+ *
+ * @return crc_status_t: execute result of this function
+ **/
+crc_status_t crc_inst (
+                        bsp_crc_t          * const crc,
+                        crc_hw_operation_t * const hw_ops,
+                        os_mutex_t         * const os_mutex,
+                        os_queue_t         * const os_queue
+                                                             );
+
+/**
+ * @brief: CRC-32/MPEG-2 of bytes, task context
+ *
+ * @param[in]  crc:    Pointer to a instance of bsp_crc_t
+ * @param[in]  data:   the bytes, any alignment
+ * @param[in]  len:    number of bytes
+ * @param[out] result: the CRC
+ *
+ * @return crc_status_t: execute result of this function
+ **/
+crc_status_t crc_calc ( bsp_crc_t  * const crc,
+                        const void * const data,
+                        uint32_t           len,
+                        uint32_t   * const result );
+
+/**
+ * @brief: CRC-32/MPEG-2 of words, most significant byte first, task context
+ *
+ * @param[in]  crc:    Pointer to a instance of bsp_crc_t
+ * @param[in]  words:  the words, aligned
+ * @param[in]  num:    number of words
+ * @param[out] result: the CRC
+ *
+ * @return crc_status_t: execute result of this function
+ **/
+crc_status_t crc_calc_words ( bsp_crc_t      * const crc,
+                              const uint32_t * const words,
+                              uint32_t               num,
+                              uint32_t       * const result );
+
+/**
+ * @brief: End of a DMA transfer, from its complete or error callback
+ *
+ * @param[in]  crc: Pointer to a instance of bsp_crc_t
+ * @param[in]  ok:  1 on transfer complete, 0 on transfer error
+ **/
+void crc_dma_done_isr ( bsp_crc_t * const crc, uint32_t ok );
+
+/**
+ * @brief: CRC-32/MPEG-2 of bytes with the slice-by-8 tables
+ *
+ * @param[in]  crc:  CRC32_MPEG2_INIT, or the CRC of the bytes before
+ * @param[in]  data: the bytes, any alignment
+ * @param[in]  len:  number of bytes
+ *
+ * @return uint32_t: the CRC
+ **/
+uint32_t crc32_mpeg2_sw ( uint32_t crc, const void * const data,
+                          uint32_t len                           );
+
+/**
+ * @brief: CRC-32/MPEG-2 of words, most significant byte first, with the
+ *         slice-by-8 tables
+ *
+ * @param[in]  crc:   CRC32_MPEG2_INIT, or the CRC of the words before
+ * @param[in]  words: the words, aligned
+ * @param[in]  num:   number of words
+ *
+ * @return uint32_t: the CRC
+ **/
+uint32_t crc32_mpeg2_sw_words ( uint32_t crc, const uint32_t * const words,
+                                uint32_t num                              );
+
+//******************************* Declaring *********************************//
+#endif // __BSP_CRC_H__
@@ -0,0 +1,481 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_crc.c
+ *
+ * @par dependencies
+ * - bsp_crc.h
+ * - bsp_common.h
+ *
+ * @author Damian
+ *
+ * @brief CRC-32/MPEG-2 service: the STM32 CRC unit fed by the CPU or by a
+ *        DMA stream, a slice-by-8 table implementation without it, the same
+ *        results on both.
+ *
+ * Processing flow:
+ *
+ * Call directly.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+//******************************** Includes *********************************//
+
+#include "bsp_crc.h"
+#include "bsp_common.h"
+
+#ifndef BENCH_HOST_POSIX
+#include "main.h"
+#endif /* BENCH_HOST_POSIX */
+
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+BSP_STATUS_CHECK( CRC );
+
+/* s_crc_table[k][b]: CRC of byte b followed by k zero bytes, 8 KiB */
+static uint32_t s_crc_table[8][256];
+static uint32_t s_crc_table_built;
+
+/**
+ * @brief: Build the tables once, concurrent callers write the same values
+ **/
+static void __table_build ( void )
+{
+    uint32_t c;
+
+    for ( uint32_t i = 0; i < 256U; ++i )
+    {
+        c = i << 24;
+        for ( uint32_t b = 0; b < 8U; ++b )
+        {
+            c = ( 0U != ( c & 0x80000000U ) ) ?
+                ( c << 1 ) ^ CRC32_MPEG2_POLY : ( c << 1 );
+        }
+        s_crc_table[0][i] = c;
+    }
+    for ( uint32_t k = 1; k < 8U; ++k )
+    {
+        for ( uint32_t i = 0; i < 256U; ++i )
+        {
+            c                 = s_crc_table[k - 1U][i];
+            s_crc_table[k][i] = ( c << 8 ) ^ s_crc_table[0][c >> 24];
+        }
+    }
+    s_crc_table_built = 1U;
+}
+
+/**
+ * @brief: Eight bytes at once, given as two words most significant first
+ *
+ * @param[in]  crc: the CRC so far
+ * @param[in]  hi:  bytes 0..3
+ * @param[in]  lo:  bytes 4..7
+ *
+ * @return uint32_t: the CRC
+ **/
+static uint32_t __slice8 ( uint32_t crc, uint32_t hi, uint32_t lo )
+{
+    crc ^= hi;
+    return s_crc_table[7][crc >> 24]             ^
+           s_crc_table[6][( crc >> 16 ) & 0xFFU] ^
+           s_crc_table[5][( crc >> 8 ) & 0xFFU]  ^
+           s_crc_table[4][crc & 0xFFU]           ^
+           s_crc_table[3][lo >> 24]              ^
+           s_crc_table[2][( lo >> 16 ) & 0xFFU]  ^
+           s_crc_table[1][( lo >> 8 ) & 0xFFU]   ^
+           s_crc_table[0][lo & 0xFFU];
+}
+
+/**
+ * @brief: Four bytes at once, given as a word most significant first
+ *
+ * @param[in]  crc: the CRC so far
+ * @param[in]  w:   bytes 0..3
+ *
+ * @return uint32_t: the CRC
+ **/
+static uint32_t __slice4 ( uint32_t crc, uint32_t w )
+{
+    crc ^= w;
+    return s_crc_table[3][crc >> 24]             ^
+           s_crc_table[2][( crc >> 16 ) & 0xFFU] ^
+           s_crc_table[1][( crc >> 8 ) & 0xFFU]  ^
+           s_crc_table[0][crc & 0xFFU];
+}
+
+/**
+ * @brief: Four bytes of memory as a word, the first one most significant
+ *
+ * @param[in]  p: the bytes, any alignment
+ *
+ * @return uint32_t: the word
+ **/
+static uint32_t __load_be ( const uint8_t * const p )
+{
+    return ( (uint32_t)p[0] << 24 ) | ( (uint32_t)p[1] << 16 ) |
+           ( (uint32_t)p[2] << 8 )  |   (uint32_t)p[3];
+}
+
+/**
+ * @brief: Checking the service can be used from here
+ *
+ * @param[in]  crc:    Pointer to a instance of bsp_crc_t
+ * @param[in]  data:   the input
+ * @param[in]  result: the output
+ *
+ * @return crc_status_t: CRC_OK when it can
+ **/
+static crc_status_t __ready ( const bsp_crc_t * const crc,
+                              const void      * const data,
+                              const uint32_t  * const result )
+{
+    if ( NULL == crc || NULL == data || NULL == result )
+    {
+        LOG( LOG_LEVEL_ERR, "Input parameter is null" );
+        return CRC_ERRORPARAMETER;
+    }
+    else if ( CRC_INITED != crc->is_initialized )
+    {
+        LOG( LOG_LEVEL_ERR, "CRC service not initialized" );
+        return CRC_ERRORSOURCE;
+    }
+#ifndef BENCH_HOST_POSIX
+    else if ( 0U != __get_IPSR() )
+    {
+        return CRC_ERRORISR;
+    }
+#endif /* BENCH_HOST_POSIX */
+    return CRC_OK;
+}
+
+/**
+ * @brief: Words into the unit by DMA, transfers of CRC_DMA_MAX_WORDS
+ *
+ * @param[in]  crc:   Pointer to a instance of bsp_crc_t
+ * @param[in]  words: the words
+ * @param[in]  num:   number of words
+ *
+ * @return crc_status_t: execute result of this function
+ **/
+static crc_status_t __dma_feed ( bsp_crc_t      * const crc,
+                                 const uint32_t * const words,
+                                 uint32_t               num   )
+{
+    crc_hw_operation_t * hw = crc->p_hw_operation_inst;
+    uint32_t             done;
+    uint32_t             chunk;
+    uint32_t             ok;
+
+    for ( done = 0U; done < num; done += chunk )
+    {
+        chunk = ( num - done > CRC_DMA_MAX_WORDS ) ? CRC_DMA_MAX_WORDS :
+                                                     num - done;
+        if ( CRC_OK != hw->pf_crc_dma_start( &words[done], chunk ) )
+        {
+            crc->dma_errors++;
+            return CRC_ERROR;
+        }
+        if ( BSP_OK != crc->p_os_queue->pf_os_queue_get(
+                                   crc->done_queue, &ok, CRC_DMA_TIMEOUT_MS ) )
+        {
+            hw->pf_crc_dma_stop();
+            crc->dma_errors++;
+            LOG( LOG_LEVEL_ERR, "CRC DMA timeout" );
+            return CRC_ERRORTIMEOUT;
+        }
+        if ( 0U == ok )
+        {
+            crc->dma_errors++;
+            return CRC_ERROR;
+        }
+    }
+    return CRC_OK;
+}
+
+/**
+ * @brief: Instantiate a bsp_crc_t
+ * @steps:
+ *      1. Build the slice-by-8 tables
+ *      2. Adding the hardware and OS interfaces into the instance
+ *      3. Create the mutex of the unit and the queue of the DMA result
+ *
+ * @param[in]  crc:      Pointer to a instance of bsp_crc_t
+ * @param[in]  hw_ops:   Pointer to a instance of crc_hw_operation_t, NULL
+ *                       for software only
+ * @param[in]  os_mutex: Pointer to a instance of os_mutex_t, with hw_ops
+ * @param[in]  os_queue: Pointer to a instance of os_queue_t, with DMA
+ *
+ * @return crc_status_t: execute result of this function
+ **/
+crc_status_t crc_inst (
+                        bsp_crc_t          * const crc,
+                        crc_hw_operation_t * const hw_ops,
+                        os_mutex_t         * const os_mutex,
+                        os_queue_t         * const os_queue
+                                                             )
+{
+    /********** 1. Checking the input parameters **********/
+    if ( NULL == crc )
+    {
+        LOG( LOG_LEVEL_ERR, "Input parameter is null" );
+        return CRC_ERRORPARAMETER;
+    }
+    if ( NULL != hw_ops &&
+         ( NULL == hw_ops->pf_crc_reset                        ||
+           NULL == hw_ops->pf_crc_feed                         ||
+           NULL == hw_ops->pf_crc_read                         ||
+           NULL == os_mutex                                    ||
+           NULL == os_mutex->pf_os_mutex_create                ||
+           NULL == os_mutex->pf_os_mutex_lock                  ||
+           NULL == os_mutex->pf_os_mutex_unlock                ||
+           ( NULL != hw_ops->pf_crc_dma_start &&
+             ( NULL == hw_ops->pf_crc_dma_stop               ||
+               NULL == os_queue                              ||
+               NULL == os_queue->pf_os_queue_create          ||
+               NULL == os_queue->pf_os_queue_put             ||
+               NULL == os_queue->pf_os_queue_get ) ) ) )
+    {
+        LOG( LOG_LEVEL_ERR, "Input parameter is null" );
+        return CRC_ERRORPARAMETER;
+    }
+
+    /************** 2. Checking the resource **************/
+    if ( CRC_INITED == crc->is_initialized )
+    {
+        LOG( LOG_LEVEL_WARN, "CRC service already initialized" );
+        return CRC_ERRORSOURCE;
+    }
+    if ( 0U == s_crc_table_built )
+    {
+        __table_build();
+    }
+
+    /************** 3. Adding the interfaces **************/
+    // 3.1 mount external interfaces
+    crc->p_hw_operation_inst = hw_ops;
+    crc->p_os_mutex          = os_mutex;
+    crc->p_os_queue          = os_queue;
+
+    /************* 4. Initialize the instance *************/
+    crc->mutex         = NULL;
+    crc->done_queue    = NULL;
+    crc->dma_min_words = CRC_DMA_MIN_WORDS;
+    crc->hw_calls      = 0U;
+    crc->dma_calls     = 0U;
+    crc->sw_calls      = 0U;
+    crc->dma_errors    = 0U;
+    if ( NULL != hw_ops )
+    {
+        if ( BSP_OK != os_mutex->pf_os_mutex_create( &crc->mutex ) )
+        {
+            LOG( LOG_LEVEL_ERR, "CRC mutex create failed" );
+            return CRC_ERRORNOMEMORY;
+        }
+        if ( NULL != hw_ops->pf_crc_dma_start &&
+             BSP_OK != os_queue->pf_os_queue_create( 1U, sizeof( uint32_t ),
+                                                     &crc->done_queue     ) )
+        {
+            LOG( LOG_LEVEL_ERR, "CRC queue create failed" );
+            return CRC_ERRORNOMEMORY;
+        }
+    }
+
+    crc->is_initialized = CRC_INITED;
+    return CRC_OK;
+}
+
+/**
+ * @brief: CRC-32/MPEG-2 of bytes, task context
+ * @steps:
+ *      1. No unit: tables only
+ *      2. The whole words through the unit, byte reversed
+ *      3. The last 1..3 bytes through the tables, from the unit result
+ *
+ * @param[in]  crc:    Pointer to a instance of bsp_crc_t
+ * @param[in]  data:   the bytes, any alignment
+ * @param[in]  len:    number of bytes
+ * @param[out] result: the CRC
+ *
+ * @return crc_status_t: execute result of this function
+ **/
+crc_status_t crc_calc ( bsp_crc_t  * const crc,
+                        const void * const data,
+                        uint32_t           len,
+                        uint32_t   * const result )
+{
+    const uint8_t      * p   = (const uint8_t *)data;
+    crc_hw_operation_t * hw;
+    uint32_t             value;
+    crc_status_t         ret = __ready( crc, data, result );
+
+    if ( CRC_OK != ret )
+    {
+        return ret;
+    }
+    hw = crc->p_hw_operation_inst;
+
+    /***************** 1. Software ************************/
+    if ( NULL == hw || 4U > len )
+    {
+        crc->sw_calls++;
+        *result = crc32_mpeg2_sw( CRC32_MPEG2_INIT, p, len );
+        return CRC_OK;
+    }
+
+    /***************** 2. Whole words *********************/
+    if ( BSP_OK != crc->p_os_mutex->pf_os_mutex_lock( crc->mutex,
+                                                      CRC_LOCK_TIMEOUT_MS ) )
+    {
+        return CRC_ERRORTIMEOUT;
+    }
+    hw->pf_crc_reset();
+    hw->pf_crc_feed( p, len / 4U, 1U );
+    value = hw->pf_crc_read();
+    crc->hw_calls++;
+    crc->p_os_mutex->pf_os_mutex_unlock( crc->mutex );
+
+    /***************** 3. Tail ****************************/
+    *result = crc32_mpeg2_sw( value, &p[len & ~3U], len & 3U );
+    return CRC_OK;
+}
+
+/**
+ * @brief: CRC-32/MPEG-2 of words, most significant byte first, task context
+ * @steps:
+ *      1. No unit: tables only
+ *      2. From dma_min_words on, by DMA; otherwise the CPU feeds the unit
+ *
+ * @param[in]  crc:    Pointer to a instance of bsp_crc_t
+ * @param[in]  words:  the words, aligned
+ * @param[in]  num:    number of words
+ * @param[out] result: the CRC
+ *
+ * @return crc_status_t: execute result of this function
+ **/
+crc_status_t crc_calc_words ( bsp_crc_t      * const crc,
+                              const uint32_t * const words,
+                              uint32_t               num,
+                              uint32_t       * const result )
+{
+    crc_hw_operation_t * hw;
+    crc_status_t         ret = __ready( crc, words, result );
+
+    if ( CRC_OK != ret )
+    {
+        return ret;
+    }
+    hw = crc->p_hw_operation_inst;
+
+    /***************** 1. Software ************************/
+    if ( NULL == hw )
+    {
+        crc->sw_calls++;
+        *result = crc32_mpeg2_sw_words( CRC32_MPEG2_INIT, words, num );
+        return CRC_OK;
+    }
+
+    /***************** 2. Unit ****************************/
+    if ( BSP_OK != crc->p_os_mutex->pf_os_mutex_lock( crc->mutex,
+                                                      CRC_LOCK_TIMEOUT_MS ) )
+    {
+        return CRC_ERRORTIMEOUT;
+    }
+    hw->pf_crc_reset();
+    if ( NULL != hw->pf_crc_dma_start && crc->dma_min_words <= num )
+    {
+        ret = __dma_feed( crc, words, num );
+        crc->dma_calls++;
+    }
+    else
+    {
+        hw->pf_crc_feed( words, num, 0U );
+        crc->hw_calls++;
+    }
+    *result = hw->pf_crc_read();
+    crc->p_os_mutex->pf_os_mutex_unlock( crc->mutex );
+    return ret;
+}
+
+/**
+ * @brief: End of a DMA transfer, from its complete or error callback
+ *
+ * @param[in]  crc: Pointer to a instance of bsp_crc_t
+ * @param[in]  ok:  1 on transfer complete, 0 on transfer error
+ **/
+void crc_dma_done_isr ( bsp_crc_t * const crc, uint32_t ok )
+{
+    if ( NULL == crc || NULL == crc->done_queue )
+    {
+        return;
+    }
+    crc->p_os_queue->pf_os_queue_put( crc->done_queue, &ok, 0U );
+}
+
+/**
+ * @brief: CRC-32/MPEG-2 of bytes with the slice-by-8 tables
+ *
+ * @param[in]  crc:  CRC32_MPEG2_INIT, or the CRC of the bytes before
+ * @param[in]  data: the bytes, any alignment
+ * @param[in]  len:  number of bytes
+ *
+ * @return uint32_t: the CRC
+ **/
+uint32_t crc32_mpeg2_sw ( uint32_t crc, const void * const data,
+                          uint32_t len                           )
+{
+    const uint8_t * p = (const uint8_t *)data;
+
+    if ( 0U == s_crc_table_built )
+    {
+        __table_build();
+    }
+    for ( ; 8U <= len; len -= 8U, p += 8 )
+    {
+        crc = __slice8( crc, __load_be( p ), __load_be( &p[4] ) );
+    }
+    for ( ; 0U < len; --len, ++p )
+    {
+        crc = ( crc << 8 ) ^ s_crc_table[0][( crc >> 24 ) ^ *p];
+    }
+    return crc;
+}
+
+/**
+ * @brief: CRC-32/MPEG-2 of words, most significant byte first, with the
+ *         slice-by-8 tables
+ *
+ * @param[in]  crc:   CRC32_MPEG2_INIT, or the CRC of the words before
+ * @param[in]  words: the words, aligned
+ * @param[in]  num:   number of words
+ *
+ * @return uint32_t: the CRC
+ **/
+uint32_t crc32_mpeg2_sw_words ( uint32_t crc, const uint32_t * const words,
+                                uint32_t num                              )
+{
+    uint32_t i = 0U;
+
+    if ( 0U == s_crc_table_built )
+    {
+        __table_build();
+    }
+    for ( ; i + 2U <= num; i += 2U )
+    {
+        crc = __slice8( crc, words[i], words[i + 1U] );
+    }
+    if ( i < num )
+    {
+        crc = __slice4( crc, words[i] );
+    }
+    return crc;
+}
+
+//******************************** Defines **********************************//
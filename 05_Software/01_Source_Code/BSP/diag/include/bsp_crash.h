@@ -0,0 +1,170 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_crash.h
+ *
+ * @par dependencies
+ * - stdint.h
+ *
+ * @author Damian
+ *
+ * @brief Post-mortem record of a fault, kept over the reset and printed on
+ *        the next boot.
+ *
+ * Processing flow:
+ *
+ * HardFault / MemManage / BusFault / UsageFault_Handler
+ *      -> stacked frame of MSP or PSP (EXC_RETURN bit 2)
+ *      -> crash_fault_capture -> record in RW_NOINIT -> NVIC_SystemReset
+ * Error_Handler / stack overflow hook -> crash_capture -> same record
+ * main -> crash_report (print the record once) -> crash_init
+ *
+ * The record holds the registers stacked by the exception entry, the fault
+ * status and address registers, the running task and a bounded snapshot of
+ * the stack above the faulting SP. It lives in a BSP_NOINIT variable: the
+ * scatter files of both targets keep RW_NOINIT out of the start up copy and
+ * clear, a CRC-32 tells a sealed record from power on garbage.
+ *
+ * The fault handlers are defined here, the ones of stm32f4xx_it.c are off
+ * in the .ioc ("Generate IRQ handler" unchecked). With a debugger attached
+ * the capture stops on a breakpoint before the reset.
+ *
+ * crash_report prints "crash,<key>,<value>" lines; feed the log and the
+ * .axf to 08_Tools/crash/crash_decode.py to decode the fault status and to
+ * resolve pc, lr and the code addresses on the stack.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+#ifndef __BSP_CRASH_H__
+#define __BSP_CRASH_H__
+
+//******************************** Includes *********************************//
+
+#include <stdint.h>
+
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+#define CRASH_STACK_WORDS   32U           /* stack snapshot above the SP     */
+#define CRASH_NAME_LEN      16U           /* configMAX_TASK_NAME_LEN         */
+#define CRASH_RAM_END       0x2001FC00U   /* RW_NOINIT, end of the stacks    */
+
+/* address the caller returns to, the pc of a software crash */
+#if defined ( __CC_ARM )
+#define CRASH_CALLER()      ( (uint32_t)__return_address() )
+#elif defined ( __GNUC__ )
+#define CRASH_CALLER()      ( (uint32_t)__builtin_return_address( 0 ) )
+#else
+#define CRASH_CALLER()      ( 0U )
+#endif
+
+typedef enum
+{
+    CRASH_OK                     = 0,  /* CRASH operate successfully         */
+    CRASH_ERROR                  = 1,  /* CRASH error without case matched   */
+    CRASH_ERRORTIMEOUT           = 2,  /* CRASH operate failed with timeout  */
+    CRASH_ERRORSOURCE            = 3,  /* CRASH resource not available       */
+    CRASH_ERRORPARAMETER         = 4,  /* CRASH parameter error              */
+    CRASH_ERRORNOMEMORY          = 5,  /* CRASH out of memory                */
+    CRASH_ERRORISR               = 6,  /* CRASH not allowed in ISR context   */
+    CRASH_RESERVED               = 0xFF,/* CRASH reserved                    */
+} crash_status_t;
+
+typedef enum
+{
+    CRASH_HARDFAULT              = 0,  /* HardFault_Handler                  */
+    CRASH_MEMMANAGE              = 1,  /* MemManage_Handler                  */
+    CRASH_BUSFAULT               = 2,  /* BusFault_Handler                   */
+    CRASH_USAGEFAULT             = 3,  /* UsageFault_Handler                 */
+    CRASH_ERROR_HANDLER          = 4,  /* Error_Handler of the HAL init      */
+    CRASH_STACK_OVERFLOW         = 5,  /* vApplicationStackOverflowHook      */
+    CRASH_TYPE_NUM               = 6,  /* number of crash types              */
+} crash_type_t;
+
+typedef struct
+{
+    uint32_t              magic;                      /* CRASH_MAGIC_xxx     */
+    uint32_t              count;                      /* crashes since POR   */
+    uint32_t              type;                       /* crash_type_t        */
+    uint32_t              tick;                       /* HAL tick, ms        */
+    uint32_t              r0;                         /* stacked by the      */
+    uint32_t              r1;                         /* exception entry,    */
+    uint32_t              r2;                         /* 0 for a software    */
+    uint32_t              r3;                         /* crash               */
+    uint32_t              r12;
+    uint32_t              lr;
+    uint32_t              pc;                         /* faulting pc         */
+    uint32_t              xpsr;
+    uint32_t              exc_return;                 /* 0: software crash   */
+    uint32_t              sp;                         /* SP before the fault */
+    uint32_t              cfsr;                       /* SCB fault status    */
+    uint32_t              hfsr;
+    uint32_t              mmfar;
+    uint32_t              bfar;
+    char                  task[CRASH_NAME_LEN];       /* "" before start     */
+    uint32_t              stack_words;                /* valid in stack[]    */
+    uint32_t              stack[CRASH_STACK_WORDS];   /* from sp upwards     */
+    uint32_t              crc;                        /* CRC-32 of the above */
+} crash_record_t;
+
+//******************************** Defines **********************************//
+
+//******************************* Declaring *********************************//
+
+/**
+ * @brief: Route the configurable faults to their own handler
+ * @steps:
+ *      1. Enable MemManage, BusFault and UsageFault in SCB->SHCSR, else they
+ *         escalate to HardFault and CFSR is the only hint left
+ *
+ * @return crash_status_t: execute result of this function
+ **/
+crash_status_t crash_init ( void );
+
+/**
+ * @brief: Print the record of the last crash once
+ * @steps:
+ *      1. Nothing to do without a sealed record
+ *      2. Print the record as "crash,<key>,<value>" lines
+ *      3. Mark it reported, the count keeps going until a power on
+ *
+ * @return crash_status_t: CRASH_ERROR when a record is there but its CRC
+ *                         does not match, CRASH_OK otherwise
+ **/
+crash_status_t crash_report ( void );
+
+/**
+ * @brief: Record a software crash and reset, never returns
+ * @steps:
+ *      1. Current SP, the caller as pc and lr
+ *      2. Common part: fault status, task, stack snapshot, seal, reset
+ *
+ * @param[in]  type:   CRASH_ERROR_HANDLER or CRASH_STACK_OVERFLOW
+ * @param[in]  caller: CRASH_CALLER() of the function giving up
+ **/
+void crash_capture ( crash_type_t type, uint32_t caller );
+
+/**
+ * @brief: Record a fault and reset, entered from the fault handlers only
+ * @steps:
+ *      1. Stacked registers when the frame lies in SRAM
+ *      2. SP before the exception: basic or extended frame, aligner
+ *      3. Common part: fault status, task, stack snapshot, seal, reset
+ *
+ * @param[in]  frame:      exception frame on MSP or PSP
+ * @param[in]  exc_return: LR on handler entry
+ * @param[in]  type:       crash_type_t of the handler
+ **/
+void crash_fault_capture ( const uint32_t * const frame,
+                           uint32_t               exc_return,
+                           uint32_t               type        );
+
+//******************************* Declaring *********************************//
+#endif // __BSP_CRASH_H__
@@ -0,0 +1,82 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_stack_report.h
+ *
+ * @par dependencies
+ * - stdint.h
+ *
+ * @author Damian
+ *
+ * @brief Report the stack high water mark of every task at runtime.
+ *
+ * Processing flow:
+ *
+ * stack_report_start -> report task -> stack_report_print every period
+ *
+ * Define STACK_REPORT_ENABLE in the target options to start the report from
+ * MX_FREERTOS_Init. Compare the output with the static bound printed by
+ * 08_Tools/stack_analysis/stack_report.py before shrinking a stack: the
+ * watermark only covers the paths exercised so far, the static bound covers
+ * all the direct calls.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+#ifndef __BSP_STACK_REPORT_H__
+#define __BSP_STACK_REPORT_H__
+
+//******************************** Includes *********************************//
+
+#include <stdint.h>
+#include <stdio.h>
+
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+#define STACK_REPORT_PERIOD_MS     10000U     /* default report period       */
+#define STACK_REPORT_STACK_WORDS   192U       /* stack of the report task    */
+
+typedef enum
+{
+    STACK_REPORT_OK              = 0,  /* REPORT operate successfully        */
+    STACK_REPORT_ERROR           = 1,  /* REPORT error without case matched  */
+    STACK_REPORT_ERRORTIMEOUT    = 2,  /* REPORT operate failed with timeout */
+    STACK_REPORT_ERRORSOURCE     = 3,  /* REPORT resource not available      */
+    STACK_REPORT_ERRORPARAMETER  = 4,  /* REPORT parameter error             */
+    STACK_REPORT_ERRORNOMEMORY   = 5,  /* REPORT out of memory               */
+    STACK_REPORT_ERRORISR        = 6,  /* REPORT not allowed in ISR context  */
+    STACK_REPORT_RESERVED        = 0xFF,/* REPORT reserved                   */
+} stack_report_status_t;
+
+//******************************** Defines **********************************//
+
+//******************************* Declaring *********************************//
+
+/**
+ * @brief: Print the high water mark of every task as CSV
+ * @steps:
+ *      1. Take a snapshot of all the tasks
+ *      2. Print name, priority, state and the minimum free stack in bytes
+ *
+ * @return stack_report_status_t: execute result of this function
+ **/
+stack_report_status_t stack_report_print ( void );
+
+/**
+ * @brief: Create the task printing the report periodically
+ *
+ * @param[in]  period_ms: report period, 0 means STACK_REPORT_PERIOD_MS
+ *
+ * @return stack_report_status_t: execute result of this function
+ **/
+stack_report_status_t stack_report_start ( uint32_t period_ms );
+
+//******************************* Declaring *********************************//
+#endif // __BSP_STACK_REPORT_H__
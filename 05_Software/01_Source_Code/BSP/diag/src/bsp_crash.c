@@ -0,0 +1,403 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_crash.c
+ *
+ * @par dependencies
+ * - bsp_crash.h
+ * - main.h
+ * - FreeRTOS.h
+ *
+ * @author Damian
+ *
+ * @brief Post-mortem record of a fault, kept over the reset and printed on
+ *        the next boot.
+ *
+ * Processing flow:
+ *
+ * Call directly.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+//******************************** Includes *********************************//
+
+#include "bsp_crash.h"
+#include "bsp_common.h"
+#include "main.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include <stddef.h>
+#include <string.h>
+
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+BSP_STATUS_CHECK( CRASH );
+
+#define CRASH_MAGIC_SEALED    0xC0DEDEADU   /* record waits for the report  */
+#define CRASH_MAGIC_REPORTED  0xC0DE600DU   /* printed, count still valid   */
+#define CRASH_CRC_LEN         offsetof( crash_record_t, crc )
+
+static BSP_NOINIT crash_record_t s_record;
+
+static const char * const s_type_str[CRASH_TYPE_NUM] =
+{
+    "hardfault", "memmanage", "busfault", "usagefault",
+    "error_handler", "stack_overflow",
+};
+
+/**
+ * @brief: CRC-32 (IEEE 802.3, reflected) of the record, bit by bit: runs
+ *         once per crash and once per boot
+ *
+ * @param[in]  record: the record, up to the crc field
+ *
+ * @return uint32_t: the CRC
+ **/
+static uint32_t __record_crc ( const crash_record_t * const record )
+{
+    const uint8_t * p   = (const uint8_t *)record;
+    uint32_t        crc = 0xFFFFFFFFU;
+
+    for ( uint32_t i = 0; i < CRASH_CRC_LEN; ++i )
+    {
+        crc ^= p[i];
+        for ( uint32_t b = 0; b < 8U; ++b )
+        {
+            crc = ( crc >> 1 ) ^ ( 0xEDB88320U & ( 0U - ( crc & 1U ) ) );
+        }
+    }
+    return ~crc;
+}
+
+/**
+ * @brief: Whether [addr, addr + len) lies in the SRAM below RW_NOINIT, a
+ *         read outside would fault again inside the fault handler
+ *
+ * @param[in]  addr: first byte
+ * @param[in]  len:  bytes
+ *
+ * @return uint32_t: 1 when readable
+ **/
+static uint32_t __in_ram ( uint32_t addr, uint32_t len )
+{
+    return ( 0U == ( addr & 3U )      &&
+             SRAM1_BASE <= addr       &&
+             CRASH_RAM_END >= len     &&
+             CRASH_RAM_END - len >= addr ) ? 1U : 0U;
+}
+
+/**
+ * @brief: Start a record, the count survives until a power on
+ *
+ * @param[in]  type: crash_type_t
+ **/
+static void __record_start ( uint32_t type )
+{
+    uint32_t count = 0U;
+
+    if ( CRASH_MAGIC_SEALED   == s_record.magic ||
+         CRASH_MAGIC_REPORTED == s_record.magic )
+    {
+        count = s_record.count;
+    }
+    memset( &s_record, 0, sizeof( s_record ) );
+    s_record.count = count + 1U;
+    s_record.type  = type;
+    s_record.tick  = HAL_GetTick();
+}
+
+/**
+ * @brief: Common end of every capture, never returns
+ * @steps:
+ *      1. Fault status and address registers
+ *      2. Name of the running task once the scheduler is up
+ *      3. Snapshot of the stack above the SP, bounded by RW_NOINIT
+ *      4. Seal, stop for a debugger, reset
+ *
+ * @param[in]  sp: SP of the crashed context
+ **/
+static void __record_finish ( uint32_t sp )
+{
+    const char * name;
+
+    /***************** 1. Fault status ********************/
+    s_record.sp    = sp;
+    s_record.cfsr  = SCB->CFSR;
+    s_record.hfsr  = SCB->HFSR;
+    s_record.mmfar = SCB->MMFAR;
+    s_record.bfar  = SCB->BFAR;
+
+    /***************** 2. Running task ********************/
+    if ( taskSCHEDULER_NOT_STARTED != xTaskGetSchedulerState() )
+    {
+        name = pcTaskGetName( NULL );
+        for ( uint32_t i = 0;
+              i < CRASH_NAME_LEN - 1U && '\0' != name[i];
+              ++i )
+        {
+            s_record.task[i] = name[i];
+        }
+    }
+
+    /***************** 3. Stack snapshot ******************/
+    for ( uint32_t i = 0; i < CRASH_STACK_WORDS; ++i )
+    {
+        if ( 0U == __in_ram( sp + i * 4U, 4U ) )
+        {
+            break;
+        }
+        s_record.stack[i]    = ( (const uint32_t *)sp )[i];
+        s_record.stack_words = i + 1U;
+    }
+
+    /***************** 4. Seal and reset ******************/
+    s_record.crc   = __record_crc( &s_record );
+    s_record.magic = CRASH_MAGIC_SEALED;
+    __DSB();
+    if ( 0U != ( CoreDebug->DHCSR & CoreDebug_DHCSR_C_DEBUGEN_Msk ) )
+    {
+        __BKPT( 0 );
+    }
+    NVIC_SystemReset();
+}
+
+/**
+ * @brief: Route the configurable faults to their own handler
+ * @steps:
+ *      1. Enable MemManage, BusFault and UsageFault in SCB->SHCSR, else they
+ *         escalate to HardFault and CFSR is the only hint left
+ *
+ * @return crash_status_t: execute result of this function
+ **/
+crash_status_t crash_init ( void )
+{
+    /*************** 1. Enable the fault handlers ***************/
+    SCB->SHCSR |= SCB_SHCSR_MEMFAULTENA_Msk |
+                  SCB_SHCSR_BUSFAULTENA_Msk |
+                  SCB_SHCSR_USGFAULTENA_Msk;
+    __DSB();
+    __ISB();
+    return CRASH_OK;
+}
+
+/**
+ * @brief: Print the record of the last crash once
+ * @steps:
+ *      1. Nothing to do without a sealed record
+ *      2. Print the record as "crash,<key>,<value>" lines
+ *      3. Mark it reported, the count keeps going until a power on
+ *
+ * @return crash_status_t: CRASH_ERROR when a record is there but its CRC
+ *                         does not match, CRASH_OK otherwise
+ **/
+crash_status_t crash_report ( void )
+{
+    static const char * const reg_str[] =
+    {
+        "r0", "r1", "r2", "r3", "r12", "lr", "pc", "xpsr", "exc_return",
+        "sp", "cfsr", "hfsr", "mmfar", "bfar",
+    };
+    // r0 .. bfar follow each other in crash_record_t
+    const uint32_t * reg = &s_record.r0;
+    uint32_t         i;
+
+    /****************** 1. Sealed record ******************/
+    if ( CRASH_MAGIC_SEALED != s_record.magic )
+    {
+        return CRASH_OK;
+    }
+    if ( s_record.crc != __record_crc( &s_record ) ||
+         CRASH_TYPE_NUM <= s_record.type           ||
+         CRASH_STACK_WORDS < s_record.stack_words )
+    {
+        s_record.magic = CRASH_MAGIC_REPORTED;
+        printf( "# crash record corrupt\r\n" );
+        return CRASH_ERROR;
+    }
+
+    /****************** 2. Print it ***********************/
+    s_record.task[CRASH_NAME_LEN - 1U] = '\0';
+    printf( "# crash\r\n" );
+    printf( "crash,type,%s\r\n", s_type_str[s_record.type] );
+    printf( "crash,count,%u\r\n", (unsigned int)s_record.count );
+    printf( "crash,tick,%u\r\n", (unsigned int)s_record.tick );
+    printf( "crash,task,%s\r\n", s_record.task );
+    for ( i = 0; i < sizeof( reg_str ) / sizeof( reg_str[0] ); ++i )
+    {
+        printf( "crash,%s,0x%08X\r\n", reg_str[i], (unsigned int)reg[i] );
+    }
+    for ( i = 0; i < s_record.stack_words; ++i )
+    {
+        if ( 0U == ( i % 4U ) )
+        {
+            printf( "crash,stack,0x%08X",
+                    (unsigned int)( s_record.sp + i * 4U ) );
+        }
+        printf( ",0x%08X", (unsigned int)s_record.stack[i] );
+        if ( 3U == ( i % 4U ) || s_record.stack_words == i + 1U )
+        {
+            printf( "\r\n" );
+        }
+    }
+    printf( "# crash end\r\n" );
+
+    /****************** 3. Reported ***********************/
+    s_record.magic = CRASH_MAGIC_REPORTED;
+    return CRASH_OK;
+}
+
+/**
+ * @brief: Record a software crash and reset, never returns
+ * @steps:
+ *      1. Current SP, the caller as pc and lr
+ *      2. Common part: fault status, task, stack snapshot, seal, reset
+ *
+ * @param[in]  type:   CRASH_ERROR_HANDLER or CRASH_STACK_OVERFLOW
+ * @param[in]  caller: CRASH_CALLER() of the function giving up
+ **/
+void crash_capture ( crash_type_t type, uint32_t caller )
+{
+    uint32_t sp;
+
+    __disable_irq();
+
+    /*************** 1. SP and caller *********************/
+    sp = ( 0U == __get_IPSR() &&
+           0U != ( __get_CONTROL() & CONTROL_SPSEL_Msk ) ) ? __get_PSP() :
+                                                             __get_MSP();
+    __record_start( (uint32_t)type );
+    s_record.pc = caller;
+    s_record.lr = caller;
+
+    /*************** 2. Common part ***********************/
+    __record_finish( sp );
+}
+
+/**
+ * @brief: Record a fault and reset, entered from the fault handlers only
+ * @steps:
+ *      1. Stacked registers when the frame lies in SRAM
+ *      2. SP before the exception: basic or extended frame, aligner
+ *      3. Common part: fault status, task, stack snapshot, seal, reset
+ *
+ * @param[in]  frame:      exception frame on MSP or PSP
+ * @param[in]  exc_return: LR on handler entry
+ * @param[in]  type:       crash_type_t of the handler
+ **/
+void crash_fault_capture ( const uint32_t * const frame,
+                           uint32_t               exc_return,
+                           uint32_t               type        )
+{
+    uint32_t sp = (uint32_t)frame;
+
+    __disable_irq();
+    __record_start( type );
+    s_record.exc_return = exc_return;
+
+    /*************** 1. Stacked registers *****************/
+    if ( 0U != __in_ram( sp, 8U * 4U ) )
+    {
+        s_record.r0   = frame[0];
+        s_record.r1   = frame[1];
+        s_record.r2   = frame[2];
+        s_record.r3   = frame[3];
+        s_record.r12  = frame[4];
+        s_record.lr   = frame[5];
+        s_record.pc   = frame[6];
+        s_record.xpsr = frame[7];
+
+        /*********** 2. SP before the exception ***********/
+        // bit 4 clear: s0-s15 and FPSCR were stacked as well
+        sp += ( 0U != ( exc_return & 0x10U ) ) ? 8U * 4U : 26U * 4U;
+        // bit 9 of the stacked xPSR: one pad word for the 8 byte alignment
+        sp += ( 0U != ( s_record.xpsr & ( 1UL << 9 ) ) ) ? 4U : 0U;
+    }
+
+    /*************** 3. Common part ***********************/
+    __record_finish( sp );
+}
+
+/*
+ * The handlers only pick the stack the frame was pushed to and pass the
+ * type: r0 frame, r1 EXC_RETURN, r2 type. No C prologue may run before,
+ * hence assembler.
+ *
+ * TBD: not run on the board yet. The GNU variant was only assembled on a
+ *      host for cortex-m4, the armcc one not at all. Check every handler
+ *      once (UDF, a load from 0xCCCCCCCC, a jump to 0xE0000000, a fault
+ *      with SHCSR cleared) and decode the record with crash_decode.py.
+ */
+#if defined ( __CC_ARM )
+
+static __asm void __crash_entry ( void )
+{
+    PRESERVE8
+
+    TST     lr, #4
+    ITE     EQ
+    MRSEQ   r0, msp
+    MRSNE   r0, psp
+    MOV     r1, lr
+    B       __cpp( crash_fault_capture )
+}
+
+__asm void HardFault_Handler ( void )
+{
+    MOVS    r2, #__cpp( CRASH_HARDFAULT )
+    B       __cpp( __crash_entry )
+}
+
+__asm void MemManage_Handler ( void )
+{
+    MOVS    r2, #__cpp( CRASH_MEMMANAGE )
+    B       __cpp( __crash_entry )
+}
+
+__asm void BusFault_Handler ( void )
+{
+    MOVS    r2, #__cpp( CRASH_BUSFAULT )
+    B       __cpp( __crash_entry )
+}
+
+__asm void UsageFault_Handler ( void )
+{
+    MOVS    r2, #__cpp( CRASH_USAGEFAULT )
+    B       __cpp( __crash_entry )
+}
+
+#elif defined ( __GNUC__ )
+
+__attribute__((naked, used)) static void __crash_entry ( void )
+{
+    __asm volatile ( "tst     lr, #4                \n"
+                     "ite     eq                    \n"
+                     "mrseq   r0, msp               \n"
+                     "mrsne   r0, psp               \n"
+                     "mov     r1, lr                \n"
+                     "b       crash_fault_capture   \n" );
+}
+
+#define CRASH_HANDLER( name, type )                                          \
+    __attribute__((naked)) void name ( void )                                \
+    {                                                                        \
+        __asm volatile ( "movs    r2, %0                \n"                  \
+                         "b       __crash_entry         \n"                  \
+                         : : "i" ( type ) );                                 \
+    }
+
+CRASH_HANDLER( HardFault_Handler,  CRASH_HARDFAULT  )
+CRASH_HANDLER( MemManage_Handler,  CRASH_MEMMANAGE  )
+CRASH_HANDLER( BusFault_Handler,   CRASH_BUSFAULT   )
+CRASH_HANDLER( UsageFault_Handler, CRASH_USAGEFAULT )
+
+#endif
+
+//******************************** Defines **********************************//
@@ -0,0 +1,128 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_stack_report.c
+ *
+ * @par dependencies
+ * - bsp_stack_report.h
+ * - FreeRTOS.h
+ *
+ * @author Damian
+ *
+ * @brief Report the stack high water mark of every task at runtime.
+ *
+ * Processing flow:
+ *
+ * Call directly.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+//******************************** Includes *********************************//
+
+#include "bsp_stack_report.h"
+#include "bsp_common.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+BSP_STATUS_CHECK( STACK_REPORT );
+
+#define STACK_REPORT_SPARE_TASKS   2U     /* tasks created during snapshot  */
+
+static uint32_t s_period_ms = STACK_REPORT_PERIOD_MS;
+
+/**
+ * @brief: Print the high water mark of every task as CSV
+ * @steps:
+ *      1. Take a snapshot of all the tasks
+ *      2. Print name, priority, state and the minimum free stack in bytes
+ *
+ * @return stack_report_status_t: execute result of this function
+ **/
+stack_report_status_t stack_report_print ( void )
+{
+    static const char state_str[] = { 'X', 'R', 'B', 'S', 'D', '?' };
+    TaskStatus_t * status;
+    UBaseType_t    task_num;
+    UBaseType_t    free_words;
+
+    /************** 1. Take a snapshot of the tasks **************/
+    task_num = uxTaskGetNumberOfTasks() + STACK_REPORT_SPARE_TASKS;
+    status   = pvPortMalloc( task_num * sizeof( TaskStatus_t ) );
+    if ( NULL == status )
+    {
+        LOG( LOG_LEVEL_ERR, "Stack report no memory" );
+        return STACK_REPORT_ERRORNOMEMORY;
+    }
+    task_num = uxTaskGetSystemState( status, task_num, NULL );
+
+    /*************** 2. Print one line per task ******************/
+    printf( "# stack\r\n" );
+    printf( "task,priority,state,free_min_bytes\r\n" );
+    for ( UBaseType_t i = 0; i < task_num; ++i )
+    {
+        free_words = uxTaskGetStackHighWaterMark( status[i].xHandle );
+        printf( "%s,%u,%c,%u\r\n",
+                status[i].pcTaskName,
+                (unsigned int)status[i].uxCurrentPriority,
+                state_str[ ( status[i].eCurrentState < eInvalid )
+                           ? status[i].eCurrentState : eInvalid ],
+                (unsigned int)( free_words * sizeof( StackType_t ) ) );
+    }
+    printf( "heap,free_min_bytes,%u\r\n",
+            (unsigned int)xPortGetMinimumEverFreeHeapSize() );
+
+    vPortFree( status );
+    return STACK_REPORT_OK;
+}
+
+/**
+ * @brief: Report task, prints the report every period
+ *
+ * @param[in]  argument: Not used
+ **/
+static void stack_report_task ( void * argument )
+{
+    (void)argument;
+
+    for ( ;; )
+    {
+        vTaskDelay( pdMS_TO_TICKS( s_period_ms ) );
+        stack_report_print();
+    }
+}
+
+/**
+ * @brief: Create the task printing the report periodically
+ *
+ * @param[in]  period_ms: report period, 0 means STACK_REPORT_PERIOD_MS
+ *
+ * @return stack_report_status_t: execute result of this function
+ **/
+stack_report_status_t stack_report_start ( uint32_t period_ms )
+{
+    s_period_ms = ( 0U == period_ms ) ? STACK_REPORT_PERIOD_MS : period_ms;
+
+    if ( pdPASS != xTaskCreate( stack_report_task,
+                                "stack_report",
+                                STACK_REPORT_STACK_WORDS,
+                                NULL,
+                                tskIDLE_PRIORITY + 1,
+                                NULL                      ) )
+    {
+        LOG( LOG_LEVEL_ERR, "Stack report task create failed" );
+        return STACK_REPORT_ERRORNOMEMORY;
+    }
+    return STACK_REPORT_OK;
+}
+
+//******************************** Defines **********************************//
@@ -0,0 +1,330 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_dsp_chain.h
+ *
+ * @par dependencies
+ * - arm_math.h
+ *
+ * @author Damian
+ *
+ * @brief Chain CMSIS-DSP stages over one block of samples, every stage works
+ *        in place on the two ping-pong buffers of the chain.
+ *
+ * Processing flow:
+ *
+ * dsp_chain_inst -> dsp_chain_add_fir / _decimate / _rfft / _magnitude /
+ *                   _stats (in processing order)
+ *                -> dsp_chain_process (each block) -> stages -> pf_block_done
+ *
+ *  stage       in -> out length   buffer
+ *  FIR         n  -> n            in place
+ *  DECIMATE    n  -> n / M        in place
+ *  RFFT        n  -> n            to the other buffer, packed: [0] DC,
+ *                                 [1] Nyquist, then re/im of bins 1..n/2-1
+ *  MAGNITUDE   n  -> n / 2        in place, [0] is |DC|
+ *  STATS       n  -> n            read only, mean / rms / max
+ *
+ * The vendored CMSIS-DSP has no arm_common_tables.c, so the stock FFT init
+ * functions can not link. dsp_chain_add_rfft builds the twiddle and the bit
+ * reversal tables at run time into a caller provided dsp_rfft_t, the tables
+ * equal the CMSIS ones. dsp_rfft_tables_build does the same for tables
+ * outside a chain, longer than DSP_BLOCK_MAX. Nothing here touches the
+ * hardware or the RTOS, the file builds on the host with the portable C
+ * sources of CMSIS-DSP.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+#ifndef __BSP_DSP_CHAIN_H__
+#define __BSP_DSP_CHAIN_H__
+
+//******************************** Includes *********************************//
+
+#include "arm_math.h"
+#include <stdint.h>
+#include <stddef.h>
+
+//******************************** Includes *********************************//
+
+typedef struct dsp_chain dsp_chain_t;
+
+//******************************** Defines **********************************//
+
+#define DSP_BLOCK_MAX           256U      /* max samples of one block        */
+#define DSP_FIR_TAPS_MAX        64U       /* max taps of a FIR or decimator  */
+#define DSP_RFFT_LEN_MIN        32U       /* smallest arm_rfft_fast length   */
+#define MAX_DSP_STAGE_NUM       6U        /* Max number of stages per chain  */
+
+typedef enum
+{
+    DSP_CHAIN_INITED     = 0,       /* DSP chain initialized                 */
+    DSP_CHAIN_NOT_INITED = 1,       /* DSP chain not initialized             */
+} dsp_chain_init_t;
+
+typedef enum
+{
+    DSP_OK              = 0,         /* DSP operate successfully             */
+    DSP_ERROR           = 1,         /* DSP error without case matched       */
+    DSP_ERRORTIMEOUT    = 2,         /* DSP operate timeout                  */
+    DSP_ERRORSOURCE     = 3,         /* DSP chain not ready or full          */
+    DSP_ERRORPARAMETER  = 4,         /* DSP parameter or length error        */
+    DSP_ERRORNOMEMORY   = 5,         /* DSP out of memory                    */
+    DSP_ERRORISR        = 6,         /* DSP not allowed in ISR context       */
+    DSP_RESERVED        = 0xFF,      /* DSP reserved                         */
+} dsp_status_t;
+
+typedef enum
+{
+    DSP_STAGE_FIR       = 0,         /* arm_fir_f32                          */
+    DSP_STAGE_DECIMATE  = 1,         /* arm_fir_decimate_f32                 */
+    DSP_STAGE_RFFT      = 2,         /* arm_rfft_fast_f32                    */
+    DSP_STAGE_MAGNITUDE = 3,         /* arm_cmplx_mag_f32                    */
+    DSP_STAGE_STATS     = 4,         /* arm_mean / arm_rms / arm_max         */
+} dsp_stage_type_t;
+
+typedef struct
+{
+    arm_fir_instance_f32          inst;                   /* CMSIS instance  */
+    float32_t     state[DSP_FIR_TAPS_MAX + DSP_BLOCK_MAX - 1U];   /* delays  */
+} dsp_fir_t;
+
+typedef struct
+{
+    arm_fir_decimate_instance_f32 inst;                   /* CMSIS instance  */
+    float32_t     state[DSP_FIR_TAPS_MAX + DSP_BLOCK_MAX - 1U];   /* delays  */
+} dsp_decimate_t;
+
+typedef struct
+{
+    arm_rfft_fast_instance_f32    inst;                   /* CMSIS instance  */
+    float32_t     twiddle[DSP_BLOCK_MAX];                 /* CFFT twiddles   */
+    float32_t     twiddle_rfft[DSP_BLOCK_MAX];            /* split twiddles  */
+    uint16_t      bit_rev[DSP_BLOCK_MAX];                 /* swap pairs x 8  */
+} dsp_rfft_t;
+
+typedef struct
+{
+    float32_t             mean;                       /* mean of the block   */
+    float32_t             rms;                        /* rms of the block    */
+    float32_t             max;                        /* largest sample      */
+    uint32_t              max_index;                  /* index of the max    */
+} dsp_stats_t;
+
+typedef struct
+{
+    dsp_stage_type_t      type;                       /* what the stage runs */
+    uint32_t              in_len;                     /* samples taken       */
+    void                  * p_stage;                  /* dsp_fir_t, ...      */
+} dsp_stage_t;
+
+/* called in the processing context after the last stage of every block     */
+typedef void ( *pf_dsp_block_done_t ) (
+                                        dsp_chain_t     * const chain,
+                                        const float32_t * const out,
+                                        uint32_t                len,
+                                        void            * const context
+                                                                          );
+
+typedef struct dsp_chain
+{
+    //************************** Internal status ****************************//
+    dsp_chain_init_t      is_initialized;             /* record init status  */
+    uint32_t              out_len;                    /* len after the stages*/
+    uint32_t              blocks;                     /* blocks processed    */
+
+    //****************************** Property *******************************//
+    const char            * name;                     /* printable name      */
+    uint32_t              block_len;                  /* samples per block   */
+    uint32_t              stage_num;                  /* num of stages       */
+    dsp_stage_t           stage_array[MAX_DSP_STAGE_NUM]; /* stages in order */
+    float32_t             buf[2][DSP_BLOCK_MAX];      /* ping-pong buffers   */
+
+    //************************* Interface for APP ***************************//
+    pf_dsp_block_done_t   pf_block_done;              /* result callback     */
+    void                  * p_context;                /* callback argument   */
+} dsp_chain_t;
+
+//******************************** Defines **********************************//
+
+//******************************* Declaring *********************************//
+
+/**
+ * @brief: Instantiate a dsp_chain_t without any stage
+ *
+ * @param[in]  chain:      Pointer to a instance of dsp_chain_t
+ * @param[in]  name:       printable name, kept by pointer
+ * @param[in]  block_len:  input samples per block, 1 .. DSP_BLOCK_MAX
+ * @param[in]  block_done: result callback, may be NULL
+ * @param[in]  context:    argument of the callback
+ *
+ * @return dsp_status_t: execute result of this function
+ **/
+dsp_status_t dsp_chain_inst (
+                              dsp_chain_t         * const chain,
+                              const char          * const name,
+                              uint32_t                    block_len,
+                              pf_dsp_block_done_t         block_done,
+                              void                * const context
+                                                                     );
+
+/**
+ * @brief: Append a FIR filter
+ *
+ * @param[in]  chain:  Pointer to a instance of dsp_chain_t
+ * @param[in]  fir:    storage of the filter, lives as long as the chain
+ * @param[in]  coeffs: taps in time reversed order, kept by pointer
+ * @param[in]  taps:   1 .. DSP_FIR_TAPS_MAX
+ *
+ * @return dsp_status_t: execute result of this function
+ **/
+dsp_status_t dsp_chain_add_fir (
+                                 dsp_chain_t     * const chain,
+                                 dsp_fir_t       * const fir,
+                                 const float32_t * const coeffs,
+                                 uint16_t                taps
+                                                              );
+
+/**
+ * @brief: Append an anti alias FIR and keep every factor-th sample
+ *
+ * @param[in]  chain:  Pointer to a instance of dsp_chain_t
+ * @param[in]  dec:    storage of the decimator, lives as long as the chain
+ * @param[in]  coeffs: taps in time reversed order, kept by pointer
+ * @param[in]  taps:   1 .. DSP_FIR_TAPS_MAX
+ * @param[in]  factor: decimation factor, must divide the current length
+ *
+ * @return dsp_status_t: execute result of this function
+ **/
+dsp_status_t dsp_chain_add_decimate (
+                                      dsp_chain_t     * const chain,
+                                      dsp_decimate_t  * const dec,
+                                      const float32_t * const coeffs,
+                                      uint16_t                taps,
+                                      uint8_t                 factor
+                                                                      );
+
+/**
+ * @brief: Append a real FFT over the current length
+ * @steps:
+ *      1. Check the length is a power of two from DSP_RFFT_LEN_MIN
+ *      2. Fill the twiddle tables of the CFFT and of the real split
+ *      3. Probe the CFFT with an impulse to find the bit reversal pairs
+ *
+ * @param[in]  chain: Pointer to a instance of dsp_chain_t
+ * @param[in]  rfft:  storage of the tables, lives as long as the chain
+ *
+ * @return dsp_status_t: execute result of this function
+ **/
+dsp_status_t dsp_chain_add_rfft ( dsp_chain_t * const chain,
+                                  dsp_rfft_t  * const rfft   );
+
+/**
+ * @brief: Append the magnitude of a packed RFFT spectrum
+ *
+ * @param[in]  chain: Pointer to a instance of dsp_chain_t
+ *
+ * @return dsp_status_t: DSP_ERRORPARAMETER when the last stage is no RFFT
+ **/
+dsp_status_t dsp_chain_add_magnitude ( dsp_chain_t * const chain );
+
+/**
+ * @brief: Append mean, rms and max of the current block
+ *
+ * @param[in]  chain: Pointer to a instance of dsp_chain_t
+ * @param[out] stats: rewritten after every block
+ *
+ * @return dsp_status_t: execute result of this function
+ **/
+dsp_status_t dsp_chain_add_stats ( dsp_chain_t * const chain,
+                                   dsp_stats_t * const stats  );
+
+/**
+ * @brief: Run one block through every stage
+ * @steps:
+ *      1. Copy the block into the first buffer, the input is not touched
+ *      2. Run the stages in place, RFFT swaps to the other buffer
+ *      3. Hand the result to pf_block_done
+ *
+ * @param[in]  chain: Pointer to a instance of dsp_chain_t
+ * @param[in]  in:    block_len samples
+ *
+ * @return dsp_status_t: execute result of this function
+ **/
+dsp_status_t dsp_chain_process ( dsp_chain_t     * const chain,
+                                 const float32_t * const in     );
+
+/**
+ * @brief: Build the twiddle and bit reversal tables of arm_cfft_f32 at run
+ *         time, the values equal the CMSIS constant tables
+ * @steps:
+ *      1. Twiddles cos / sin of 2*pi*k/len for k below len
+ *      2. Run the CFFT without bit reversal on an impulse at sample 1, the
+ *         phase of each output names the bin it holds
+ *      3. Break the resulting permutation into swaps, stored as byte
+ *         offsets of complex floats like arm_bitreversal_32 expects
+ *
+ * @param[out] inst:    CFFT instance, points to the tables afterwards
+ * @param[out] twiddle: 2 * len floats
+ * @param[out] bit_rev: 2 * len entries
+ * @param[in]  len:     complex length, power of two from 16 to 4096
+ * @param[in]  probe:   2 * len floats of scratch
+ *
+ * @return dsp_status_t: execute result of this function
+ **/
+dsp_status_t dsp_cfft_tables_build (
+                                     arm_cfft_instance_f32 * const inst,
+                                     float32_t             * const twiddle,
+                                     uint16_t              * const bit_rev,
+                                     uint32_t                      len,
+                                     float32_t             * const probe
+                                                                        );
+
+/**
+ * @brief: Build the tables of arm_rfft_fast_f32 at run time, the values
+ *         equal the CMSIS constant tables
+ * @steps:
+ *      1. Tables of the half length CFFT
+ *      2. Split twiddles sin / cos of 2*pi*k/len
+ *
+ * @param[out] inst:         RFFT instance, points to the tables afterwards
+ * @param[out] twiddle:      len floats, twiddles of the CFFT
+ * @param[out] split:        len floats, twiddles of the real split
+ * @param[out] bit_rev:      len entries
+ * @param[in]  len:          real length, power of two from 32 to 8192
+ * @param[in]  probe:        len floats of scratch
+ *
+ * @return dsp_status_t: execute result of this function
+ **/
+dsp_status_t dsp_rfft_tables_build (
+                                     arm_rfft_fast_instance_f32 * const inst,
+                                     float32_t                  * const twiddle,
+                                     float32_t                  * const split,
+                                     uint16_t                   * const bit_rev,
+                                     uint32_t                           len,
+                                     float32_t                  * const probe
+                                                                             );
+
+/**
+ * @brief: Design a windowed sinc (Hamming) low pass with unit DC gain, the
+ *         taps are symmetric so the time reversed order is the same
+ *
+ * @param[out] coeffs: taps
+ * @param[in]  taps:   1 .. DSP_FIR_TAPS_MAX, odd gives a centred delay
+ * @param[in]  cutoff: corner over the sample rate, 0 .. 0.5
+ *
+ * @return dsp_status_t: execute result of this function
+ **/
+dsp_status_t dsp_fir_lowpass_design (
+                                      float32_t * const coeffs,
+                                      uint16_t          taps,
+                                      float32_t         cutoff
+                                                              );
+
+//******************************* Declaring *********************************//
+#endif // __BSP_DSP_CHAIN_H__
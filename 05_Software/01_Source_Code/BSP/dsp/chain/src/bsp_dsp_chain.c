@@ -0,0 +1,571 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_dsp_chain.c
+ *
+ * @par dependencies
+ * - bsp_dsp_chain.h
+ * - bsp_common.h
+ *
+ * @author Damian
+ *
+ * @brief Chain CMSIS-DSP stages over one block of samples, every stage works
+ *        in place on the two ping-pong buffers of the chain.
+ *
+ * Processing flow:
+ *
+ * Call directly.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+//******************************** Includes *********************************//
+
+#include "bsp_dsp_chain.h"
+#include "bsp_common.h"
+#include <string.h>
+#include <math.h>
+
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+BSP_STATUS_CHECK( DSP );
+
+#define DSP_TWO_PI              6.28318530717958647692
+
+/**
+ * @brief: Check a chain can take one more stage
+ *
+ * @param[in]  chain: Pointer to a instance of dsp_chain_t
+ *
+ * @return dsp_status_t: execute result of this function
+ **/
+static dsp_status_t __stage_check ( dsp_chain_t * const chain )
+{
+    if ( NULL == chain )
+    {
+        LOG( LOG_LEVEL_ERR, "Input parameter is null" );
+        return DSP_ERRORPARAMETER;
+    }
+    else if ( DSP_CHAIN_INITED != chain->is_initialized )
+    {
+        LOG( LOG_LEVEL_ERR, "DSP chain not initialized" );
+        return DSP_ERRORSOURCE;
+    }
+    else if ( MAX_DSP_STAGE_NUM <= chain->stage_num )
+    {
+        LOG( LOG_LEVEL_ERR, "DSP chain %s is full", chain->name );
+        return DSP_ERRORSOURCE;
+    }
+    return DSP_OK;
+}
+
+/**
+ * @brief: Append a stage, the output length becomes out_len
+ *
+ * @param[in]  chain:   Pointer to a instance of dsp_chain_t
+ * @param[in]  type:    type of the stage
+ * @param[in]  p_stage: storage of the stage
+ * @param[in]  out_len: length after the stage
+ **/
+static void __stage_append (
+                             dsp_chain_t    * const chain,
+                             dsp_stage_type_t       type,
+                             void           * const p_stage,
+                             uint32_t               out_len
+                                                            )
+{
+    dsp_stage_t * stage = &chain->stage_array[chain->stage_num];
+
+    stage->type    = type;
+    stage->in_len  = chain->out_len;
+    stage->p_stage = p_stage;
+    chain->stage_num++;
+    chain->out_len = out_len;
+}
+
+/**
+ * @brief: Instantiate a dsp_chain_t without any stage
+ *
+ * @param[in]  chain:      Pointer to a instance of dsp_chain_t
+ * @param[in]  name:       printable name, kept by pointer
+ * @param[in]  block_len:  input samples per block, 1 .. DSP_BLOCK_MAX
+ * @param[in]  block_done: result callback, may be NULL
+ * @param[in]  context:    argument of the callback
+ *
+ * @return dsp_status_t: execute result of this function
+ **/
+dsp_status_t dsp_chain_inst (
+                              dsp_chain_t         * const chain,
+                              const char          * const name,
+                              uint32_t                    block_len,
+                              pf_dsp_block_done_t         block_done,
+                              void                * const context
+                                                                     )
+{
+    if ( NULL == chain || NULL == name       ||
+         0U == block_len                     ||
+         DSP_BLOCK_MAX < block_len
+                                               )
+    {
+        LOG( LOG_LEVEL_ERR, "Input parameter error" );
+        return DSP_ERRORPARAMETER;
+    }
+
+    chain->name          = name;
+    chain->block_len     = block_len;
+    chain->out_len       = block_len;
+    chain->stage_num     = 0U;
+    chain->blocks        = 0U;
+    chain->pf_block_done = block_done;
+    chain->p_context     = context;
+
+    chain->is_initialized = DSP_CHAIN_INITED;
+    return DSP_OK;
+}
+
+/**
+ * @brief: Append a FIR filter
+ *
+ * @param[in]  chain:  Pointer to a instance of dsp_chain_t
+ * @param[in]  fir:    storage of the filter, lives as long as the chain
+ * @param[in]  coeffs: taps in time reversed order, kept by pointer
+ * @param[in]  taps:   1 .. DSP_FIR_TAPS_MAX
+ *
+ * @return dsp_status_t: execute result of this function
+ **/
+dsp_status_t dsp_chain_add_fir (
+                                 dsp_chain_t     * const chain,
+                                 dsp_fir_t       * const fir,
+                                 const float32_t * const coeffs,
+                                 uint16_t                taps
+                                                              )
+{
+    dsp_status_t ret = __stage_check( chain );
+
+    if ( DSP_OK != ret )
+    {
+        return ret;
+    }
+    if ( NULL == fir || NULL == coeffs || 0U == taps ||
+         DSP_FIR_TAPS_MAX < taps
+                                                       )
+    {
+        LOG( LOG_LEVEL_ERR, "Input parameter error" );
+        return DSP_ERRORPARAMETER;
+    }
+
+    arm_fir_init_f32( &fir->inst, taps, coeffs, fir->state, chain->out_len );
+    __stage_append( chain, DSP_STAGE_FIR, fir, chain->out_len );
+    return DSP_OK;
+}
+
+/**
+ * @brief: Append an anti alias FIR and keep every factor-th sample
+ *
+ * @param[in]  chain:  Pointer to a instance of dsp_chain_t
+ * @param[in]  dec:    storage of the decimator, lives as long as the chain
+ * @param[in]  coeffs: taps in time reversed order, kept by pointer
+ * @param[in]  taps:   1 .. DSP_FIR_TAPS_MAX
+ * @param[in]  factor: decimation factor, must divide the current length
+ *
+ * @return dsp_status_t: execute result of this function
+ **/
+dsp_status_t dsp_chain_add_decimate (
+                                      dsp_chain_t     * const chain,
+                                      dsp_decimate_t  * const dec,
+                                      const float32_t * const coeffs,
+                                      uint16_t                taps,
+                                      uint8_t                 factor
+                                                                      )
+{
+    dsp_status_t ret = __stage_check( chain );
+
+    if ( DSP_OK != ret )
+    {
+        return ret;
+    }
+    if ( NULL == dec || NULL == coeffs || 0U == taps ||
+         DSP_FIR_TAPS_MAX < taps                      ||
+         0U == factor
+                                                       )
+    {
+        LOG( LOG_LEVEL_ERR, "Input parameter error" );
+        return DSP_ERRORPARAMETER;
+    }
+
+    // also refuses a factor not dividing the block
+    if ( ARM_MATH_SUCCESS != arm_fir_decimate_init_f32( &dec->inst, taps,
+                                                        factor, coeffs,
+                                                        dec->state,
+                                                        chain->out_len ) )
+    {
+        LOG( LOG_LEVEL_ERR, "DSP chain %s decimate by %u of %u samples",
+                            chain->name, (unsigned int)factor,
+                            (unsigned int)chain->out_len );
+        return DSP_ERRORPARAMETER;
+    }
+    __stage_append( chain, DSP_STAGE_DECIMATE, dec, chain->out_len / factor );
+    return DSP_OK;
+}
+
+/**
+ * @brief: Append a real FFT over the current length
+ * @steps:
+ *      1. Check the length is a power of two from DSP_RFFT_LEN_MIN
+ *      2. Fill the twiddle tables of the CFFT and of the real split
+ *      3. Probe the CFFT with an impulse to find the bit reversal pairs
+ *
+ * @param[in]  chain: Pointer to a instance of dsp_chain_t
+ * @param[in]  rfft:  storage of the tables, lives as long as the chain
+ *
+ * @return dsp_status_t: execute result of this function
+ **/
+dsp_status_t dsp_chain_add_rfft ( dsp_chain_t * const chain,
+                                  dsp_rfft_t  * const rfft   )
+{
+    dsp_status_t ret = __stage_check( chain );
+    uint32_t     n;
+
+    if ( DSP_OK != ret )
+    {
+        return ret;
+    }
+
+    /*************** 1. Checking the length ***************/
+    n = chain->out_len;
+    if ( NULL == rfft || DSP_RFFT_LEN_MIN > n || 0U != ( n & ( n - 1U ) ) )
+    {
+        LOG( LOG_LEVEL_ERR, "DSP chain %s RFFT of %u samples",
+                            chain->name, (unsigned int)n );
+        return DSP_ERRORPARAMETER;
+    }
+
+    /************ 2. 3. Tables, buf[1] as probe ***********/
+    dsp_rfft_tables_build( &rfft->inst, rfft->twiddle, rfft->twiddle_rfft,
+                           rfft->bit_rev, n, chain->buf[1] );
+    __stage_append( chain, DSP_STAGE_RFFT, rfft, n );
+    return DSP_OK;
+}
+
+/**
+ * @brief: Append the magnitude of a packed RFFT spectrum
+ *
+ * @param[in]  chain: Pointer to a instance of dsp_chain_t
+ *
+ * @return dsp_status_t: DSP_ERRORPARAMETER when the last stage is no RFFT
+ **/
+dsp_status_t dsp_chain_add_magnitude ( dsp_chain_t * const chain )
+{
+    dsp_status_t ret = __stage_check( chain );
+
+    if ( DSP_OK != ret )
+    {
+        return ret;
+    }
+    if ( 0U == chain->stage_num ||
+         DSP_STAGE_RFFT != chain->stage_array[chain->stage_num - 1U].type )
+    {
+        LOG( LOG_LEVEL_ERR, "DSP chain %s magnitude needs a RFFT",
+                            chain->name );
+        return DSP_ERRORPARAMETER;
+    }
+
+    __stage_append( chain, DSP_STAGE_MAGNITUDE, NULL, chain->out_len / 2U );
+    return DSP_OK;
+}
+
+/**
+ * @brief: Append mean, rms and max of the current block
+ *
+ * @param[in]  chain: Pointer to a instance of dsp_chain_t
+ * @param[out] stats: rewritten after every block
+ *
+ * @return dsp_status_t: execute result of this function
+ **/
+dsp_status_t dsp_chain_add_stats ( dsp_chain_t * const chain,
+                                   dsp_stats_t * const stats  )
+{
+    dsp_status_t ret = __stage_check( chain );
+
+    if ( DSP_OK != ret )
+    {
+        return ret;
+    }
+    if ( NULL == stats )
+    {
+        LOG( LOG_LEVEL_ERR, "Input parameter is null" );
+        return DSP_ERRORPARAMETER;
+    }
+
+    __stage_append( chain, DSP_STAGE_STATS, stats, chain->out_len );
+    return DSP_OK;
+}
+
+/**
+ * @brief: Run one block through every stage
+ * @steps:
+ *      1. Copy the block into the first buffer, the input is not touched
+ *      2. Run the stages in place, RFFT swaps to the other buffer
+ *      3. Hand the result to pf_block_done
+ *
+ * @param[in]  chain: Pointer to a instance of dsp_chain_t
+ * @param[in]  in:    block_len samples
+ *
+ * @return dsp_status_t: execute result of this function
+ **/
+dsp_status_t dsp_chain_process ( dsp_chain_t     * const chain,
+                                 const float32_t * const in     )
+{
+    dsp_stage_t * stage;
+    dsp_stats_t * stats;
+    float32_t   * data;
+    float32_t     dc;
+    uint32_t      cur = 0U;
+
+    if ( NULL == chain || NULL == in                ||
+         DSP_CHAIN_INITED != chain->is_initialized
+                                                      )
+    {
+        return DSP_ERRORPARAMETER;
+    }
+
+    /****************** 1. Take the block ******************/
+    memcpy( chain->buf[0], in, chain->block_len * sizeof( float32_t ) );
+
+    /****************** 2. Run the stages ******************/
+    for ( uint32_t i = 0; i < chain->stage_num; ++i )
+    {
+        stage = &chain->stage_array[i];
+        data  = chain->buf[cur];
+        switch ( stage->type )
+        {
+        case DSP_STAGE_FIR:
+            arm_fir_f32( &( (dsp_fir_t *)stage->p_stage )->inst,
+                         data, data, stage->in_len );
+            break;
+        case DSP_STAGE_DECIMATE:
+            arm_fir_decimate_f32( &( (dsp_decimate_t *)stage->p_stage )->inst,
+                                  data, data, stage->in_len );
+            break;
+        case DSP_STAGE_RFFT:
+            // the CFFT runs in place on the input, the split needs a target
+            arm_rfft_fast_f32( &( (dsp_rfft_t *)stage->p_stage )->inst,
+                               data, chain->buf[cur ^ 1U], 0U );
+            cur ^= 1U;
+            break;
+        case DSP_STAGE_MAGNITUDE:
+            // bin 0 packs DC with Nyquist, keep the DC part only
+            dc = data[0];
+            arm_cmplx_mag_f32( data, data, stage->in_len / 2U );
+            data[0] = fabsf( dc );
+            break;
+        case DSP_STAGE_STATS:
+            stats = (dsp_stats_t *)stage->p_stage;
+            arm_mean_f32( data, stage->in_len, &stats->mean );
+            arm_rms_f32( data, stage->in_len, &stats->rms );
+            arm_max_f32( data, stage->in_len, &stats->max, &stats->max_index );
+            break;
+        default:
+            return DSP_ERROR;
+        }
+    }
+    chain->blocks++;
+
+    /****************** 3. Hand the result ******************/
+    if ( NULL != chain->pf_block_done )
+    {
+        chain->pf_block_done( chain, chain->buf[cur], chain->out_len,
+                              chain->p_context );
+    }
+    return DSP_OK;
+}
+
+/**
+ * @brief: Build the twiddle and bit reversal tables of arm_cfft_f32 at run
+ *         time, the values equal the CMSIS constant tables
+ * @steps:
+ *      1. Twiddles cos / sin of 2*pi*k/len for k below len
+ *      2. Run the CFFT without bit reversal on an impulse at sample 1, the
+ *         phase of each output names the bin it holds
+ *      3. Break the resulting permutation into swaps, stored as byte
+ *         offsets of complex floats like arm_bitreversal_32 expects
+ *
+ * @param[out] inst:    CFFT instance, points to the tables afterwards
+ * @param[out] twiddle: 2 * len floats
+ * @param[out] bit_rev: 2 * len entries
+ * @param[in]  len:     complex length, power of two from 16 to 4096
+ * @param[in]  probe:   2 * len floats of scratch
+ *
+ * @return dsp_status_t: execute result of this function
+ **/
+dsp_status_t dsp_cfft_tables_build (
+                                     arm_cfft_instance_f32 * const inst,
+                                     float32_t             * const twiddle,
+                                     uint16_t              * const bit_rev,
+                                     uint32_t                      len,
+                                     float32_t             * const probe
+                                                                        )
+{
+    uint32_t count = 0U;
+    uint32_t d;
+    int32_t  k;
+
+    if ( NULL == inst || NULL == twiddle || NULL == bit_rev ||
+         NULL == probe || 16U > len || 4096U < len          ||
+         0U != ( len & ( len - 1U ) )
+                                                              )
+    {
+        LOG( LOG_LEVEL_ERR, "Input parameter error" );
+        return DSP_ERRORPARAMETER;
+    }
+
+    /***************** 1. Twiddle factors *****************/
+    for ( uint32_t i = 0; i < len; ++i )
+    {
+        twiddle[2U * i]      = (float32_t)cos( DSP_TWO_PI * i / len );
+        twiddle[2U * i + 1U] = (float32_t)sin( DSP_TWO_PI * i / len );
+    }
+    inst->fftLen       = (uint16_t)len;
+    inst->pTwiddle     = twiddle;
+    inst->pBitRevTable = bit_rev;
+    inst->bitRevLength = 0U;
+
+    /***************** 2. Probe the order *****************/
+    memset( probe, 0, 2U * len * sizeof( float32_t ) );
+    probe[2] = 1.0f;
+    arm_cfft_f32( inst, probe, 0U, 0U );
+    // probe[j] only overwrites outputs already read, it becomes the bin
+    for ( uint32_t j = 0; j < len; ++j )
+    {
+        k = (int32_t)floorf( atan2f( -probe[2U * j + 1U], probe[2U * j] ) *
+                             (float32_t)len / (float32_t)DSP_TWO_PI + 0.5f );
+        probe[j] = (float32_t)( ( k % (int32_t)len + (int32_t)len ) %
+                                (int32_t)len );
+    }
+
+    /**************** 3. Swaps of the cycles **************/
+    for ( uint32_t j = 0; j < len; ++j )
+    {
+        while ( (uint32_t)probe[j] != j )
+        {
+            d = (uint32_t)probe[j];
+            bit_rev[count++] = (uint16_t)( j * 8U );
+            bit_rev[count++] = (uint16_t)( d * 8U );
+            probe[j] = probe[d];
+            probe[d] = (float32_t)d;
+        }
+    }
+    inst->bitRevLength = (uint16_t)count;
+    return DSP_OK;
+}
+
+/**
+ * @brief: Build the tables of arm_rfft_fast_f32 at run time, the values
+ *         equal the CMSIS constant tables
+ * @steps:
+ *      1. Tables of the half length CFFT
+ *      2. Split twiddles sin / cos of 2*pi*k/len
+ *
+ * @param[out] inst:         RFFT instance, points to the tables afterwards
+ * @param[out] twiddle:      len floats, twiddles of the CFFT
+ * @param[out] split:        len floats, twiddles of the real split
+ * @param[out] bit_rev:      len entries
+ * @param[in]  len:          real length, power of two from 32 to 8192
+ * @param[in]  probe:        len floats of scratch
+ *
+ * @return dsp_status_t: execute result of this function
+ **/
+dsp_status_t dsp_rfft_tables_build (
+                                     arm_rfft_fast_instance_f32 * const inst,
+                                     float32_t                  * const twiddle,
+                                     float32_t                  * const split,
+                                     uint16_t                   * const bit_rev,
+                                     uint32_t                           len,
+                                     float32_t                  * const probe
+                                                                             )
+{
+    dsp_status_t ret;
+
+    if ( NULL == inst || NULL == split )
+    {
+        LOG( LOG_LEVEL_ERR, "Input parameter is null" );
+        return DSP_ERRORPARAMETER;
+    }
+
+    /*************** 1. Half length CFFT ******************/
+    ret = dsp_cfft_tables_build( &inst->Sint, twiddle, bit_rev, len / 2U,
+                                 probe );
+    if ( DSP_OK != ret )
+    {
+        return ret;
+    }
+
+    /*************** 2. Split twiddles ********************/
+    for ( uint32_t i = 0; i < len / 2U; ++i )
+    {
+        split[2U * i]      = (float32_t)sin( DSP_TWO_PI * i / len );
+        split[2U * i + 1U] = (float32_t)cos( DSP_TWO_PI * i / len );
+    }
+    inst->fftLenRFFT   = (uint16_t)len;
+    inst->pTwiddleRFFT = split;
+    return DSP_OK;
+}
+
+/**
+ * @brief: Design a windowed sinc (Hamming) low pass with unit DC gain, the
+ *         taps are symmetric so the time reversed order is the same
+ *
+ * @param[out] coeffs: taps
+ * @param[in]  taps:   1 .. DSP_FIR_TAPS_MAX, odd gives a centred delay
+ * @param[in]  cutoff: corner over the sample rate, 0 .. 0.5
+ *
+ * @return dsp_status_t: execute result of this function
+ **/
+dsp_status_t dsp_fir_lowpass_design (
+                                      float32_t * const coeffs,
+                                      uint16_t          taps,
+                                      float32_t         cutoff
+                                                              )
+{
+    float32_t mid = (float32_t)( taps - 1U ) * 0.5f;
+    float32_t sum = 0.0f;
+    float32_t t;
+
+    if ( NULL == coeffs || 0U == taps || DSP_FIR_TAPS_MAX < taps ||
+         0.0f >= cutoff || 0.5f < cutoff
+                                                                   )
+    {
+        LOG( LOG_LEVEL_ERR, "Input parameter error" );
+        return DSP_ERRORPARAMETER;
+    }
+
+    for ( uint32_t i = 0; i < taps; ++i )
+    {
+        t = (float32_t)i - mid;
+        coeffs[i] = ( 0.0f == t ) ?
+                    2.0f * cutoff :
+                    sinf( (float32_t)DSP_TWO_PI * cutoff * t ) /
+                    ( (float32_t)( DSP_TWO_PI * 0.5 ) * t );
+        if ( 1U < taps )
+        {
+            coeffs[i] *= 0.54f - 0.46f * cosf( (float32_t)DSP_TWO_PI *
+                                               (float32_t)i /
+                                               (float32_t)( taps - 1U ) );
+        }
+        sum += coeffs[i];
+    }
+    for ( uint32_t i = 0; i < taps; ++i )
+    {
+        coeffs[i] /= sum;
+    }
+    return DSP_OK;
+}
+
+//******************************** Defines **********************************//
@@ -0,0 +1,175 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_dsp_feature.h
+ *
+ * @par dependencies
+ * - bsp_dsp_chain.h
+ *
+ * @author Damian
+ *
+ * @brief Streaming log mel spectrogram and MFCC, one feature column per hop
+ *        of new samples, for the input of an int8 nn model.
+ *
+ * Processing flow:
+ *
+ * dsp_feature_inst (window, RFFT tables, mel filterbank, DCT)
+ *      -> dsp_feature_process (each hop of hop_len samples)
+ *           -> window ring -> RFFT -> power -> mel -> log [-> DCT]
+ *           -> feat->column (float) + one int8 column in the spectrogram
+ *      -> dsp_feature_to_s8 (columns oldest first, the nn input tensor)
+ *
+ * The last frame_len samples stay in a ring, a hop only writes its own
+ * samples and the window is applied while reading the ring out into the
+ * RFFT buffer, so nothing of the older hops is copied or recomputed. The
+ * spectrogram is a ring of int8 columns as well, a hop replaces the oldest
+ * column only. Before the first full frame the ring holds zeros.
+ *
+ *  step        what                                  values
+ *  window      periodic Hann                         frame_len
+ *  power       |X[k]|^2 of the RFFT                  frame_len / 2 + 1
+ *  mel         triangular HTK mel bands, f_min..f_max mel_num
+ *  log         ln( mel + DSP_FEATURE_LOG_FLOOR )      mel_num
+ *  DCT         orthonormal DCT-II, when mfcc_num > 0  mfcc_num
+ *  int8        round( v / scale ) + zero_point        coeff_num
+ *
+ * Every buffer lives in dsp_feature_t, nothing is allocated. The filterbank
+ * keeps only the non zero weights of each band. The RFFT tables are built
+ * at run time by dsp_rfft_tables_build, the vendored CMSIS-DSP has no
+ * constant tables. Nothing here touches the hardware or the RTOS.
+ *
+ * 08_Tools/dsp_feature/dsp_feature_ref.py computes the same features in
+ * double with NumPy, the feature bench compares both.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+#ifndef __BSP_DSP_FEATURE_H__
+#define __BSP_DSP_FEATURE_H__
+
+//******************************** Includes *********************************//
+
+#include "bsp_dsp_chain.h"
+
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+#define DSP_FEATURE_FFT_MAX     512U      /* max frame_len, RFFT length      */
+#define DSP_FEATURE_MEL_MAX     40U       /* max mel bands                   */
+#define DSP_FEATURE_MFCC_MAX    13U       /* max MFCC coefficients           */
+#define DSP_FEATURE_COLUMN_MAX  49U       /* max columns of the spectrogram  */
+#define DSP_FEATURE_LOG_FLOOR   1e-6f     /* added to the mel energy         */
+
+typedef enum
+{
+    DSP_FEATURE_INITED     = 0,     /* DSP feature initialized               */
+    DSP_FEATURE_NOT_INITED = 1,     /* DSP feature not initialized           */
+} dsp_feature_init_t;
+
+typedef struct
+{
+    uint32_t              sample_rate;                /* Hz                  */
+    uint16_t              frame_len;                  /* window, power of 2  */
+    uint16_t              hop_len;                    /* 1 .. frame_len      */
+    uint8_t               mel_num;                    /* 1 .. MEL_MAX        */
+    uint8_t               mfcc_num;                   /* 0: log mel only     */
+    uint8_t               column_num;                 /* 1 .. COLUMN_MAX     */
+    float32_t             f_min;                      /* lowest mel edge, Hz */
+    float32_t             f_max;                      /* highest edge, Hz    */
+    float32_t             scale;                      /* of the int8 output  */
+    int8_t                zero_point;                 /* of the int8 output  */
+} dsp_feature_cfg_t;
+
+typedef struct
+{
+    //************************** Internal status ****************************//
+    dsp_feature_init_t    is_initialized;             /* record init status  */
+    uint32_t              hops;                       /* columns computed    */
+    uint32_t              ring_pos;                   /* oldest sample       */
+    uint32_t              column_pos;                 /* oldest column       */
+
+    //****************************** Property *******************************//
+    dsp_feature_cfg_t     cfg;                        /* copy of the config  */
+    uint32_t              coeff_num;                  /* values per column   */
+    arm_rfft_fast_instance_f32 rfft;                  /* CMSIS instance      */
+    float32_t             twiddle[DSP_FEATURE_FFT_MAX];       /* CFFT        */
+    float32_t             split[DSP_FEATURE_FFT_MAX];         /* real split  */
+    uint16_t              bit_rev[DSP_FEATURE_FFT_MAX];       /* swap pairs  */
+    float32_t             window[DSP_FEATURE_FFT_MAX];        /* Hann        */
+    uint16_t              mel_start[DSP_FEATURE_MEL_MAX];     /* first bin   */
+    uint16_t              mel_len[DSP_FEATURE_MEL_MAX];       /* bins        */
+    float32_t             mel_weight[DSP_FEATURE_FFT_MAX + 2U]; /* non zero  */
+    float32_t             dct[DSP_FEATURE_MFCC_MAX * DSP_FEATURE_MEL_MAX];
+
+    //****************************** Buffers ********************************//
+    float32_t             ring[DSP_FEATURE_FFT_MAX];  /* last frame_len in   */
+    float32_t             frame[DSP_FEATURE_FFT_MAX]; /* windowed, power     */
+    float32_t             spectrum[DSP_FEATURE_FFT_MAX]; /* packed RFFT out  */
+    float32_t             mel[DSP_FEATURE_MEL_MAX];   /* log mel energies    */
+    float32_t             column[DSP_FEATURE_MEL_MAX];   /* newest column    */
+    int8_t                out[DSP_FEATURE_COLUMN_MAX * DSP_FEATURE_MEL_MAX];
+} dsp_feature_t;
+
+//******************************** Defines **********************************//
+
+//******************************* Declaring *********************************//
+
+/**
+ * @brief: Instantiate a dsp_feature_t
+ * @steps:
+ *      1. Check the config against the limits
+ *      2. Periodic Hann window
+ *      3. RFFT tables of frame_len, frame as probe
+ *      4. Mel filterbank, every band needs one bin at least
+ *      5. DCT-II matrix when MFCC are asked for
+ *      6. Clear the sample ring and the spectrogram
+ *
+ * @param[in]  feat: Pointer to a instance of dsp_feature_t
+ * @param[in]  cfg:  config, copied
+ *
+ * @return dsp_status_t: DSP_ERRORPARAMETER when the config is out of range
+ *                       or a mel band holds no FFT bin
+ **/
+dsp_status_t dsp_feature_inst (
+                                dsp_feature_t           * const feat,
+                                const dsp_feature_cfg_t * const cfg
+                                                                   );
+
+/**
+ * @brief: Take one hop of samples and compute one feature column
+ * @steps:
+ *      1. Write the hop over the oldest samples of the ring
+ *      2. Window the ring, oldest sample first, into the frame
+ *      3. RFFT and power spectrum
+ *      4. Mel bands and log
+ *      5. DCT when MFCC are asked for
+ *      6. Quantise the column over the oldest one of the spectrogram
+ *
+ * @param[in]  feat: Pointer to a instance of dsp_feature_t
+ * @param[in]  in:   hop_len samples
+ *
+ * @return dsp_status_t: execute result of this function
+ **/
+dsp_status_t dsp_feature_process ( dsp_feature_t   * const feat,
+                                   const float32_t * const in    );
+
+/**
+ * @brief: Copy the spectrogram oldest column first, [column_num, coeff_num]
+ *         is the [H, W] of a one channel nn input tensor
+ *
+ * @param[in]  feat: Pointer to a instance of dsp_feature_t
+ * @param[out] out:  column_num * coeff_num bytes
+ *
+ * @return dsp_status_t: execute result of this function
+ **/
+dsp_status_t dsp_feature_to_s8 ( const dsp_feature_t * const feat,
+                                 int8_t              * const out   );
+
+//******************************* Declaring *********************************//
+#endif // __BSP_DSP_FEATURE_H__
@@ -0,0 +1,399 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_dsp_feature.c
+ *
+ * @par dependencies
+ * - bsp_dsp_feature.h
+ * - bsp_common.h
+ *
+ * @author Damian
+ *
+ * @brief Streaming log mel spectrogram and MFCC, one feature column per hop
+ *        of new samples, for the input of an int8 nn model.
+ *
+ * Processing flow:
+ *
+ * Call directly.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+//******************************** Includes *********************************//
+
+#include "bsp_dsp_feature.h"
+#include "bsp_common.h"
+#include <string.h>
+#include <math.h>
+
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+#define DSP_FEATURE_TWO_PI      6.28318530717958647692
+#define DSP_FEATURE_PI          3.14159265358979323846
+
+/**
+ * @brief: HTK mel of a frequency
+ **/
+static double __hz_to_mel ( double hz )
+{
+    return 2595.0 * log10( 1.0 + hz / 700.0 );
+}
+
+/**
+ * @brief: Frequency of a HTK mel
+ **/
+static double __mel_to_hz ( double mel )
+{
+    return 700.0 * ( pow( 10.0, mel / 2595.0 ) - 1.0 );
+}
+
+/**
+ * @brief: Check a config against the limits of dsp_feature_t
+ *
+ * @param[in]  cfg: the config
+ *
+ * @return dsp_status_t: execute result of this function
+ **/
+static dsp_status_t __cfg_check ( const dsp_feature_cfg_t * const cfg )
+{
+    uint32_t n = cfg->frame_len;
+
+    if ( DSP_RFFT_LEN_MIN > n || DSP_FEATURE_FFT_MAX < n ||
+         0U != ( n & ( n - 1U ) )                         ||
+         0U == cfg->hop_len || n < cfg->hop_len           ||
+         0U == cfg->mel_num || DSP_FEATURE_MEL_MAX < cfg->mel_num       ||
+         DSP_FEATURE_MFCC_MAX < cfg->mfcc_num || cfg->mel_num < cfg->mfcc_num ||
+         0U == cfg->column_num || DSP_FEATURE_COLUMN_MAX < cfg->column_num ||
+         0U == cfg->sample_rate || 0.0f > cfg->f_min      ||
+         cfg->f_max <= cfg->f_min                         ||
+         (float32_t)cfg->sample_rate / 2.0f < cfg->f_max  ||
+         0.0f >= cfg->scale
+                                                            )
+    {
+        return DSP_ERRORPARAMETER;
+    }
+    return DSP_OK;
+}
+
+/**
+ * @brief: Sparse triangular mel filterbank over the power bins
+ * @steps:
+ *      1. mel_num + 2 edges equally spaced in mel from f_min to f_max
+ *      2. Weight of bin k in band m rises from edge m to edge m+1 and falls
+ *         to edge m+2, only the non zero run of each band is kept
+ *
+ * @param[in]  feat: Pointer to a instance of dsp_feature_t
+ *
+ * @return dsp_status_t: DSP_ERRORPARAMETER when a band holds no bin
+ **/
+static dsp_status_t __mel_build ( dsp_feature_t * const feat )
+{
+    const dsp_feature_cfg_t * cfg = &feat->cfg;
+    uint32_t                  bins = cfg->frame_len / 2U + 1U;
+    uint32_t                  count = 0U;
+    double                    mel_lo = __hz_to_mel( cfg->f_min );
+    double                    step;
+    double                    edge[3];
+    double                    hz;
+    double                    w;
+
+    step = ( __hz_to_mel( cfg->f_max ) - mel_lo ) / ( cfg->mel_num + 1U );
+    for ( uint32_t m = 0; m < cfg->mel_num; ++m )
+    {
+        /*************** 1. Edges of the band *****************/
+        for ( uint32_t e = 0; e < 3U; ++e )
+        {
+            edge[e] = __mel_to_hz( mel_lo + step * ( m + e ) );
+        }
+
+        /*************** 2. Non zero run **********************/
+        feat->mel_start[m] = 0U;
+        feat->mel_len[m]   = 0U;
+        for ( uint32_t k = 0; k < bins; ++k )
+        {
+            hz = (double)k * cfg->sample_rate / cfg->frame_len;
+            w  = ( hz - edge[0] ) / ( edge[1] - edge[0] );
+            if ( ( edge[2] - hz ) / ( edge[2] - edge[1] ) < w )
+            {
+                w = ( edge[2] - hz ) / ( edge[2] - edge[1] );
+            }
+            if ( 0.0 >= w )
+            {
+                if ( 0U != feat->mel_len[m] )
+                {
+                    break;
+                }
+                continue;
+            }
+            if ( 0U == feat->mel_len[m] )
+            {
+                feat->mel_start[m] = (uint16_t)k;
+            }
+            feat->mel_weight[count++] = (float32_t)w;
+            feat->mel_len[m]++;
+        }
+        if ( 0U == feat->mel_len[m] )
+        {
+            LOG( LOG_LEVEL_ERR, "DSP feature mel band %u has no bin",
+                                (unsigned int)m );
+            return DSP_ERRORPARAMETER;
+        }
+    }
+    return DSP_OK;
+}
+
+/**
+ * @brief: Round a feature to int8 with the output scale
+ *
+ * @param[in]  cfg: the config
+ * @param[in]  v:   the feature
+ *
+ * @return int8_t: saturated
+ **/
+static int8_t __quantise ( const dsp_feature_cfg_t * const cfg, float32_t v )
+{
+    float32_t q = v / cfg->scale;
+    int32_t   r;
+
+    r = (int32_t)( ( 0.0f <= q ) ? q + 0.5f : q - 0.5f ) + cfg->zero_point;
+    if ( 127 < r )
+    {
+        r = 127;
+    }
+    else if ( -128 > r )
+    {
+        r = -128;
+    }
+    return (int8_t)r;
+}
+
+/**
+ * @brief: Instantiate a dsp_feature_t
+ * @steps:
+ *      1. Check the config against the limits
+ *      2. Periodic Hann window
+ *      3. RFFT tables of frame_len, frame as probe
+ *      4. Mel filterbank, every band needs one bin at least
+ *      5. DCT-II matrix when MFCC are asked for
+ *      6. Clear the sample ring and the spectrogram
+ *
+ * @param[in]  feat: Pointer to a instance of dsp_feature_t
+ * @param[in]  cfg:  config, copied
+ *
+ * @return dsp_status_t: DSP_ERRORPARAMETER when the config is out of range
+ *                       or a mel band holds no FFT bin
+ **/
+dsp_status_t dsp_feature_inst (
+                                dsp_feature_t           * const feat,
+                                const dsp_feature_cfg_t * const cfg
+                                                                   )
+{
+    uint32_t     n;
+    uint32_t     mel_num;
+    dsp_status_t ret;
+
+    /********** 1. Checking the input parameters **********/
+    if ( NULL == feat || NULL == cfg || DSP_OK != __cfg_check( cfg ) )
+    {
+        LOG( LOG_LEVEL_ERR, "Input parameter error" );
+        return DSP_ERRORPARAMETER;
+    }
+    feat->is_initialized = DSP_FEATURE_NOT_INITED;
+    feat->cfg            = *cfg;
+    feat->coeff_num      = ( 0U != cfg->mfcc_num ) ? cfg->mfcc_num :
+                                                     cfg->mel_num;
+    n                    = cfg->frame_len;
+    mel_num              = cfg->mel_num;
+
+    /*************** 2. Hann window ***********************/
+    for ( uint32_t i = 0; i < n; ++i )
+    {
+        feat->window[i] = (float32_t)( 0.5 - 0.5 * cos( DSP_FEATURE_TWO_PI *
+                                                        i / n ) );
+    }
+
+    /*************** 3. RFFT tables ***********************/
+    ret = dsp_rfft_tables_build( &feat->rfft, feat->twiddle, feat->split,
+                                 feat->bit_rev, n, feat->frame );
+    if ( DSP_OK != ret )
+    {
+        return ret;
+    }
+
+    /*************** 4. Mel filterbank ********************/
+    ret = __mel_build( feat );
+    if ( DSP_OK != ret )
+    {
+        return ret;
+    }
+
+    /*************** 5. DCT-II, orthonormal ***************/
+    for ( uint32_t i = 0; i < cfg->mfcc_num; ++i )
+    {
+        for ( uint32_t m = 0; m < mel_num; ++m )
+        {
+            feat->dct[i * mel_num + m] = (float32_t)(
+                sqrt( ( 0U == i ? 1.0 : 2.0 ) / mel_num ) *
+                cos( DSP_FEATURE_PI * i * ( m + 0.5 ) / mel_num ) );
+        }
+    }
+
+    /*************** 6. Clear the history *****************/
+    memset( feat->ring, 0, sizeof( feat->ring ) );
+    memset( feat->column, 0, sizeof( feat->column ) );
+    memset( feat->out, __quantise( cfg, 0.0f ), sizeof( feat->out ) );
+    feat->ring_pos       = 0U;
+    feat->column_pos     = 0U;
+    feat->hops           = 0U;
+
+    feat->is_initialized = DSP_FEATURE_INITED;
+    return DSP_OK;
+}
+
+/**
+ * @brief: Take one hop of samples and compute one feature column
+ * @steps:
+ *      1. Write the hop over the oldest samples of the ring
+ *      2. Window the ring, oldest sample first, into the frame
+ *      3. RFFT and power spectrum
+ *      4. Mel bands and log
+ *      5. DCT when MFCC are asked for
+ *      6. Quantise the column over the oldest one of the spectrogram
+ *
+ * @param[in]  feat: Pointer to a instance of dsp_feature_t
+ * @param[in]  in:   hop_len samples
+ *
+ * @return dsp_status_t: execute result of this function
+ **/
+dsp_status_t dsp_feature_process ( dsp_feature_t   * const feat,
+                                   const float32_t * const in    )
+{
+    const dsp_feature_cfg_t * cfg;
+    const float32_t         * weight;
+    uint32_t                  n;
+    uint32_t                  head;
+    int8_t                  * out;
+
+    if ( NULL == feat || NULL == in )
+    {
+        LOG( LOG_LEVEL_ERR, "Input parameter is null" );
+        return DSP_ERRORPARAMETER;
+    }
+    else if ( DSP_FEATURE_INITED != feat->is_initialized )
+    {
+        LOG( LOG_LEVEL_ERR, "DSP feature not initialized" );
+        return DSP_ERRORSOURCE;
+    }
+    cfg = &feat->cfg;
+    n   = cfg->frame_len;
+
+    /*************** 1. Hop into the ring *****************/
+    head = n - feat->ring_pos;
+    if ( cfg->hop_len <= head )
+    {
+        memcpy( &feat->ring[feat->ring_pos], in,
+                cfg->hop_len * sizeof( float32_t ) );
+    }
+    else
+    {
+        memcpy( &feat->ring[feat->ring_pos], in, head * sizeof( float32_t ) );
+        memcpy( feat->ring, &in[head],
+                ( cfg->hop_len - head ) * sizeof( float32_t ) );
+    }
+    feat->ring_pos = ( feat->ring_pos + cfg->hop_len ) % n;
+
+    /*************** 2. Window, oldest first **************/
+    head = n - feat->ring_pos;
+    arm_mult_f32( &feat->ring[feat->ring_pos], feat->window, feat->frame,
+                  head );
+    if ( 0U != feat->ring_pos )
+    {
+        arm_mult_f32( feat->ring, &feat->window[head], &feat->frame[head],
+                      feat->ring_pos );
+    }
+
+    /*************** 3. RFFT, power into frame ************/
+    arm_rfft_fast_f32( &feat->rfft, feat->frame, feat->spectrum, 0U );
+    // packed: [0] DC, [1] Nyquist, then re/im of bins 1 .. n/2-1
+    feat->frame[0]      = feat->spectrum[0] * feat->spectrum[0];
+    feat->frame[n / 2U] = feat->spectrum[1] * feat->spectrum[1];
+    arm_cmplx_mag_squared_f32( &feat->spectrum[2], &feat->frame[1],
+                               n / 2U - 1U );
+
+    /*************** 4. Mel bands, log ********************/
+    weight = feat->mel_weight;
+    for ( uint32_t m = 0; m < cfg->mel_num; ++m )
+    {
+        arm_dot_prod_f32( &feat->frame[feat->mel_start[m]], weight,
+                          feat->mel_len[m], &feat->mel[m] );
+        feat->mel[m] = logf( feat->mel[m] + DSP_FEATURE_LOG_FLOOR );
+        weight += feat->mel_len[m];
+    }
+
+    /*************** 5. DCT *******************************/
+    if ( 0U != cfg->mfcc_num )
+    {
+        for ( uint32_t i = 0; i < cfg->mfcc_num; ++i )
+        {
+            arm_dot_prod_f32( &feat->dct[i * cfg->mel_num], feat->mel,
+                              cfg->mel_num, &feat->column[i] );
+        }
+    }
+    else
+    {
+        memcpy( feat->column, feat->mel, cfg->mel_num * sizeof( float32_t ) );
+    }
+
+    /*************** 6. Spectrogram column ****************/
+    out = &feat->out[feat->column_pos * feat->coeff_num];
+    for ( uint32_t i = 0; i < feat->coeff_num; ++i )
+    {
+        out[i] = __quantise( cfg, feat->column[i] );
+    }
+    feat->column_pos = ( feat->column_pos + 1U ) % cfg->column_num;
+    feat->hops++;
+    return DSP_OK;
+}
+
+/**
+ * @brief: Copy the spectrogram oldest column first, [column_num, coeff_num]
+ *         is the [H, W] of a one channel nn input tensor
+ *
+ * @param[in]  feat: Pointer to a instance of dsp_feature_t
+ * @param[out] out:  column_num * coeff_num bytes
+ *
+ * @return dsp_status_t: execute result of this function
+ **/
+dsp_status_t dsp_feature_to_s8 ( const dsp_feature_t * const feat,
+                                 int8_t              * const out   )
+{
+    uint32_t older;
+    uint32_t newer;
+
+    if ( NULL == feat || NULL == out )
+    {
+        LOG( LOG_LEVEL_ERR, "Input parameter is null" );
+        return DSP_ERRORPARAMETER;
+    }
+    else if ( DSP_FEATURE_INITED != feat->is_initialized )
+    {
+        LOG( LOG_LEVEL_ERR, "DSP feature not initialized" );
+        return DSP_ERRORSOURCE;
+    }
+
+    // column_pos is the oldest column, it runs to the end of the ring
+    older = ( feat->cfg.column_num - feat->column_pos ) * feat->coeff_num;
+    newer = feat->column_pos * feat->coeff_num;
+    memcpy( out, &feat->out[newer], older );
+    memcpy( &out[older], feat->out, newer );
+    return DSP_OK;
+}
+
+//******************************** Defines **********************************//
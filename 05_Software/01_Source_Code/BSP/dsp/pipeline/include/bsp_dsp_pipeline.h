@@ -0,0 +1,156 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_dsp_pipeline.h
+ *
+ * @par dependencies
+ * - bsp_dsp_chain.h
+ * - bsp_osal.h
+ * - bsp_signal.h
+ *
+ * @author Damian
+ *
+ * @brief Stream ADC samples from a circular DMA into the DSP chains, one
+ *        half of the ring is processed while the other one fills.
+ *
+ * Processing flow:
+ *
+ * dsp_pipeline_inst -> pf_chain_register (every chain) -> dsp_pipeline_start
+ * pipeline task     -> pf_adc_start (ring of 2 x DSP_ADC_BLOCK samples)
+ * DMA half / full   -> dsp_pipeline_irq -> pipeline task
+ *                   -> half to float -> dsp_chain_process (every chain)
+ *
+ * The ADC writes half 0 while the task works on half 1 and the other way
+ * round. A half still not taken when the DMA completes it again counts as
+ * an overrun, its samples are lost. The task converts a half as soon as it
+ * wakes up, the chains only see the float copy, so the DMA has a full half
+ * period before the ring catches up.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+#ifndef __BSP_DSP_PIPELINE_H__
+#define __BSP_DSP_PIPELINE_H__
+
+//******************************** Includes *********************************//
+
+#include "bsp_dsp_chain.h"
+#include "bsp_osal.h"
+#include "bsp_signal.h"
+#include <stdint.h>
+
+//******************************** Includes *********************************//
+
+typedef struct bsp_dsp_pipeline bsp_dsp_pipeline_t;
+
+//******************************** Defines **********************************//
+
+#define DSP_ADC_BLOCK             256U       /* samples of one ring half     */
+#define DSP_ADC_MID_SCALE         2048.0f    /* 12 bit mid scale, 0 V .. 3V3 */
+#define MAX_DSP_CHAIN_NUM         4U         /* Max number of chains         */
+#define DSP_PIPELINE_STACK_WORDS  512U       /* stack of the pipeline task   */
+#define DSP_PIPELINE_PRIORITY     ( configMAX_PRIORITIES - 3 )
+#define DSP_HALF_ALL              0x3U       /* signal bits of both halves   */
+
+typedef enum
+{
+    DSP_PIPELINE_INITED     = 0,    /* DSP pipeline initialized              */
+    DSP_PIPELINE_NOT_INITED = 1,    /* DSP pipeline not initialized          */
+} dsp_pipeline_init_t;
+
+typedef struct
+{
+    /* start the sampling into a circular ring of len halfwords            */
+    dsp_status_t ( *pf_adc_start ) ( uint16_t * const buf, uint32_t len );
+    /* stop the sampling                                                   */
+    dsp_status_t ( *pf_adc_stop )  ( void );
+} dsp_adc_operation_t;
+
+typedef dsp_status_t ( *pf_dsp_chain_register_t ) (
+                                    bsp_dsp_pipeline_t * const pipeline,
+                                    dsp_chain_t        * const chain
+                                                                            );
+
+typedef struct
+{
+    uint32_t              chain_num;                      /* num of chains   */
+    dsp_chain_t         * chain_array[MAX_DSP_CHAIN_NUM]; /* chain array     */
+} dsp_chain_group_t;
+
+typedef struct bsp_dsp_pipeline
+{
+    //************************* Internal property ***************************//
+    dsp_pipeline_init_t   is_initialized;             /* record init status  */
+    dsp_chain_group_t     chain_group;                /* chains fed per block*/
+    uint16_t              adc_buf[2U * DSP_ADC_BLOCK];/* DMA ring, 2 halves  */
+    float32_t             input[DSP_ADC_BLOCK];       /* half as float       */
+    bsp_signal_t          wakeup;                     /* DMA irq -> task     */
+    volatile uint32_t     ready;                      /* halves not taken    */
+    uint32_t              next_half;                  /* half taken next     */
+    uint32_t              overruns;                   /* halves lost         */
+    uint32_t              blocks;                     /* halves processed    */
+    uint32_t              max_busy_us;                /* worst block time    */
+
+    //************************ Interface from core **************************//
+    dsp_adc_operation_t   * p_adc_operation_inst;     /* ADC ops interface   */
+    time_operation_t      * p_time_operation_inst;    /* time ops interface  */
+
+    //************************ Interface from RTOS **************************//
+    os_critical_t         * p_os_critical;          /* os critical interface */
+
+    //******************** Interface for iternal driver *********************//
+    pf_dsp_chain_register_t pf_chain_register;        /* register a chain    */
+
+} bsp_dsp_pipeline_t;
+
+//******************************** Defines **********************************//
+
+//******************************* Declaring *********************************//
+
+/**
+ * @brief: Instantiate a bsp_dsp_pipeline_t
+ * @steps:
+ *      1. Adding the ADC, OS and time interfaces into the instance
+ *      2. Clear the chain group and the counters
+ *
+ * @param[in]  pipeline:    Pointer to a instance of bsp_dsp_pipeline_t
+ * @param[in]  adc_ops:     Pointer to a instance of dsp_adc_operation_t
+ * @param[in]  os_critical: Pointer to a instance of os_critical_t
+ * @param[in]  time_ops:    Pointer to a instance of time_operation_t
+ *
+ * @return dsp_status_t: execute result of this function
+ **/
+dsp_status_t dsp_pipeline_inst (
+                                 bsp_dsp_pipeline_t  * const pipeline,
+                                 dsp_adc_operation_t * const adc_ops,
+                                 os_critical_t       * const os_critical,
+                                 time_operation_t    * const time_ops
+                                                                        );
+
+/**
+ * @brief: Create the pipeline task, it starts the ADC
+ *
+ * @param[in]  pipeline: Pointer to a instance of bsp_dsp_pipeline_t
+ *
+ * @return dsp_status_t: execute result of this function
+ **/
+dsp_status_t dsp_pipeline_start ( bsp_dsp_pipeline_t * const pipeline );
+
+/**
+ * @brief: DMA half / full complete, call it from the HAL ADC callbacks
+ * @steps:
+ *      1. Count an overrun when the half was not taken yet
+ *      2. Mark the half ready and wake up the pipeline task
+ *
+ * @param[in]  pipeline: Pointer to a instance of bsp_dsp_pipeline_t
+ * @param[in]  half:     0 for half complete, 1 for full complete
+ **/
+void dsp_pipeline_irq ( bsp_dsp_pipeline_t * const pipeline, uint32_t half );
+
+//******************************* Declaring *********************************//
+#endif // __BSP_DSP_PIPELINE_H__
@@ -0,0 +1,290 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_dsp_pipeline.c
+ *
+ * @par dependencies
+ * - bsp_dsp_pipeline.h
+ *
+ * @author Damian
+ *
+ * @brief Stream ADC samples from a circular DMA into the DSP chains, one
+ *        half of the ring is processed while the other one fills.
+ *
+ * Processing flow:
+ *
+ * Call directly.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+//******************************** Includes *********************************//
+
+#include "bsp_dsp_pipeline.h"
+
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+/**
+ * @brief: Take the next half when the DMA completed it
+ *
+ * @param[in]  pipeline: Pointer to a instance of bsp_dsp_pipeline_t
+ *
+ * @return uint32_t: 1 when the half was taken and converted
+ **/
+static uint32_t __half_take ( bsp_dsp_pipeline_t * const pipeline )
+{
+    uint32_t         bit   = 1UL << pipeline->next_half;
+    uint32_t         taken;
+    const uint16_t * raw   = &pipeline->adc_buf[pipeline->next_half *
+                                                DSP_ADC_BLOCK];
+
+    pipeline->p_os_critical->pf_os_critical_enter();
+    taken            = pipeline->ready & bit;
+    pipeline->ready &= ~bit;
+    pipeline->p_os_critical->pf_os_critical_exit();
+
+    if ( 0U == taken )
+    {
+        return 0U;
+    }
+    // the DMA comes back to this half one half period later
+    for ( uint32_t i = 0; i < DSP_ADC_BLOCK; ++i )
+    {
+        pipeline->input[i] = ( (float32_t)raw[i] - DSP_ADC_MID_SCALE ) /
+                             DSP_ADC_MID_SCALE;
+    }
+    pipeline->next_half ^= 1U;
+    return 1U;
+}
+
+/**
+ * @brief: Pipeline task, processes the ring halves in order
+ * @steps:
+ *      1. Bind the wake up signal to this task and start the ADC
+ *      2. Take every completed half, run all the chains on it
+ *      3. Sleep until the DMA completes the next half
+ *
+ * @param[in]  argument: Pointer to a instance of bsp_dsp_pipeline_t
+ **/
+static void dsp_pipeline_task ( void * argument )
+{
+    bsp_dsp_pipeline_t * pipeline = (bsp_dsp_pipeline_t *)argument;
+    uint32_t             bits;
+    uint64_t             t0;
+    uint64_t             t1;
+
+    /********* 1. Bind the signal, start the ADC **********/
+    signal_instantiate( &pipeline->wakeup, xTaskGetCurrentTaskHandle() );
+    if ( DSP_OK != pipeline->p_adc_operation_inst->pf_adc_start(
+                                            pipeline->adc_buf,
+                                            2U * DSP_ADC_BLOCK   ) )
+    {
+        LOG( LOG_LEVEL_ERR, "DSP pipeline ADC start failed" );
+        vTaskDelete( NULL );
+    }
+
+    for ( ;; )
+    {
+        /*************** 2. Run the chains ****************/
+        while ( 0U != __half_take( pipeline ) )
+        {
+            t0 = 0U;
+            t1 = 0U;
+            pipeline->p_time_operation_inst->pf_get_time_us( &t0 );
+            for ( uint32_t i = 0; i < pipeline->chain_group.chain_num; ++i )
+            {
+                dsp_chain_process( pipeline->chain_group.chain_array[i],
+                                   pipeline->input                       );
+            }
+            pipeline->p_time_operation_inst->pf_get_time_us( &t1 );
+            if ( t1 - t0 > pipeline->max_busy_us )
+            {
+                pipeline->max_busy_us = (uint32_t)( t1 - t0 );
+            }
+            pipeline->blocks++;
+        }
+
+        /*************** 3. Sleep until needed *************/
+        signal_wait( &pipeline->wakeup, DSP_HALF_ALL,
+                     SIGNAL_WAIT_FOREVER, &bits       );
+    }
+}
+
+/**
+ * @brief: Register a chain into the pipeline, before dsp_pipeline_start
+ *
+ * @param[in]  pipeline: Pointer to a instance of bsp_dsp_pipeline_t
+ * @param[in]  chain:    chain taking DSP_ADC_BLOCK samples per block
+ *
+ * @return dsp_status_t: execute result of this function
+ **/
+static dsp_status_t dsp_chain_register (
+                                         bsp_dsp_pipeline_t * const pipeline,
+                                         dsp_chain_t        * const chain
+                                                                          )
+{
+    dsp_chain_group_t * group;
+
+    if ( NULL == pipeline || NULL == chain )
+    {
+        LOG( LOG_LEVEL_ERR, "Input parameter is null" );
+        return DSP_ERRORPARAMETER;
+    }
+    else if ( DSP_PIPELINE_INITED != pipeline->is_initialized ||
+              DSP_CHAIN_INITED    != chain->is_initialized
+                                                               )
+    {
+        LOG( LOG_LEVEL_ERR, "DSP pipeline or chain not initialized" );
+        return DSP_ERRORSOURCE;
+    }
+    else if ( DSP_ADC_BLOCK != chain->block_len )
+    {
+        LOG( LOG_LEVEL_ERR, "DSP chain %s takes %u samples, not %u",
+                            chain->name, (unsigned int)chain->block_len,
+                            (unsigned int)DSP_ADC_BLOCK );
+        return DSP_ERRORPARAMETER;
+    }
+
+    group = &pipeline->chain_group;
+    if ( MAX_DSP_CHAIN_NUM <= group->chain_num )
+    {
+        LOG( LOG_LEVEL_ERR, "DSP pipeline chain group is full" );
+        return DSP_ERRORNOMEMORY;
+    }
+    group->chain_array[group->chain_num++] = chain;
+    return DSP_OK;
+}
+
+/**
+ * @brief: Instantiate a bsp_dsp_pipeline_t
+ * @steps:
+ *      1. Adding the ADC, OS and time interfaces into the instance
+ *      2. Clear the chain group and the counters
+ *
+ * @param[in]  pipeline:    Pointer to a instance of bsp_dsp_pipeline_t
+ * @param[in]  adc_ops:     Pointer to a instance of dsp_adc_operation_t
+ * @param[in]  os_critical: Pointer to a instance of os_critical_t
+ * @param[in]  time_ops:    Pointer to a instance of time_operation_t
+ *
+ * @return dsp_status_t: execute result of this function
+ **/
+dsp_status_t dsp_pipeline_inst (
+                                 bsp_dsp_pipeline_t  * const pipeline,
+                                 dsp_adc_operation_t * const adc_ops,
+                                 os_critical_t       * const os_critical,
+                                 time_operation_t    * const time_ops
+                                                                        )
+{
+    /********** 1. Checking the input parameters **********/
+    if ( NULL == pipeline                 ||
+         NULL == adc_ops                  ||
+         NULL == adc_ops->pf_adc_start    ||
+         NULL == os_critical              ||
+         NULL == time_ops                 ||
+         NULL == time_ops->pf_get_time_us
+                                            )
+    {
+        LOG( LOG_LEVEL_ERR, "Input parameter is null" );
+        return DSP_ERRORPARAMETER;
+    }
+
+    /************** 2. Checking the resource **************/
+    if ( DSP_PIPELINE_INITED == pipeline->is_initialized )
+    {
+        LOG( LOG_LEVEL_WARN, "DSP pipeline already initialized" );
+        return DSP_ERRORSOURCE;
+    }
+
+    /************** 3. Adding the interfaces **************/
+    // 3.1 mount external interfaces
+    pipeline->p_adc_operation_inst  = adc_ops;
+    pipeline->p_os_critical         = os_critical;
+    pipeline->p_time_operation_inst = time_ops;
+    // 3.2 mount internal interfaces
+    pipeline->pf_chain_register     = dsp_chain_register;
+
+    /************* 4. Initialize the instance *************/
+    pipeline->chain_group.chain_num = 0U;
+    pipeline->ready                 = 0U;
+    pipeline->next_half             = 0U;
+    pipeline->overruns              = 0U;
+    pipeline->blocks                = 0U;
+    pipeline->max_busy_us           = 0U;
+    signal_instantiate( &pipeline->wakeup, NULL );
+
+    pipeline->is_initialized = DSP_PIPELINE_INITED;
+    return DSP_OK;
+}
+
+/**
+ * @brief: Create the pipeline task, it starts the ADC
+ *
+ * @param[in]  pipeline: Pointer to a instance of bsp_dsp_pipeline_t
+ *
+ * @return dsp_status_t: execute result of this function
+ **/
+dsp_status_t dsp_pipeline_start ( bsp_dsp_pipeline_t * const pipeline )
+{
+    if ( NULL == pipeline )
+    {
+        LOG( LOG_LEVEL_ERR, "Input parameter is null" );
+        return DSP_ERRORPARAMETER;
+    }
+    else if ( DSP_PIPELINE_INITED != pipeline->is_initialized )
+    {
+        LOG( LOG_LEVEL_ERR, "DSP pipeline not initialized" );
+        return DSP_ERRORSOURCE;
+    }
+
+    if ( pdPASS != xTaskCreate( dsp_pipeline_task,
+                                "dsp_pipeline",
+                                DSP_PIPELINE_STACK_WORDS,
+                                pipeline,
+                                DSP_PIPELINE_PRIORITY,
+                                NULL                      ) )
+    {
+        LOG( LOG_LEVEL_ERR, "DSP pipeline task create failed" );
+        return DSP_ERRORNOMEMORY;
+    }
+    return DSP_OK;
+}
+
+/**
+ * @brief: DMA half / full complete, call it from the HAL ADC callbacks
+ * @steps:
+ *      1. Count an overrun when the half was not taken yet
+ *      2. Mark the half ready and wake up the pipeline task
+ *
+ * @param[in]  pipeline: Pointer to a instance of bsp_dsp_pipeline_t
+ * @param[in]  half:     0 for half complete, 1 for full complete
+ **/
+void dsp_pipeline_irq ( bsp_dsp_pipeline_t * const pipeline, uint32_t half )
+{
+    uint32_t bit = 1UL << ( half & 1U );
+
+    if ( NULL == pipeline                                 ||
+         DSP_PIPELINE_INITED != pipeline->is_initialized
+                                                            )
+    {
+        return;
+    }
+
+    /************* 1. Count the lost half **************/
+    if ( 0U != ( pipeline->ready & bit ) )
+    {
+        pipeline->overruns++;
+    }
+
+    /************* 2. Wake up the task *****************/
+    pipeline->ready |= bit;
+    signal_set_isr( &pipeline->wakeup, bit );
+}
+
+//******************************** Defines **********************************//
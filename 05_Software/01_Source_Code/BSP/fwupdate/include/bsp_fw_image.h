@@ -0,0 +1,210 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_fw_image.h
+ *
+ * @par dependencies
+ * - stdint.h
+ *
+ * @author Damian
+ *
+ * @brief A/B firmware slots: the image header, its checks and the boot
+ *        choice, shared by the boot loader and the receiver of bsp_fw_update.
+ *
+ * Processing flow:
+ *
+ * fw_image_check -> state of a slot from its header and the CRC of its image
+ * fw_select      -> boot loader: the slot to start, spends a trial of an
+ *                   image not confirmed yet, rejects it once out of trials
+ * fw_progress    -> receiver: blocks already in the flash, where to resume
+ *
+ * Flash of the F411 with the boot loader:
+ *
+ *  sector 0      0x08000000  16 KiB   boot loader (MDK-ARM/boot.uvprojx)
+ *  sectors 1, 2  0x08004000  32 KiB   KV store (bsp_kv)
+ *  sectors 3, 4  0x0800C000  80 KiB   event log (bsp_evlog)
+ *  sector 5      0x08020000 128 KiB   slot A: header, image at +0x200
+ *  sector 6      0x08040000 128 KiB   slot B: header, image at +0x200
+ *  sector 7      0x08060000 128 KiB   free
+ *
+ * The application is linked once per slot (targets homework_06_slot_a and
+ * homework_06_slot_b), its vector table right after the header, where the
+ * boot loader points VTOR to.
+ *
+ * A slot starts with its header, one sector erase resets it. Every field is
+ * written once, from erased to its value, the flash only clears bits:
+ *
+ *  version, size, crc   the session, when the receiver starts the image
+ *  progress             a bit cleared per block written and read back, the
+ *                       receiver resumes after the last one in a row
+ *  magic                FW_MAGIC once the CRC of the whole image matched,
+ *                       the last word written: no magic, no boot
+ *  trials               a bit cleared by the boot loader per start of an
+ *                       image not confirmed, FW_MAX_TRIALS in all
+ *  confirmed            FW_MARK, by the image itself once it runs well
+ *  rejected             FW_MARK, out of trials, never started again; or
+ *                       a session the receiver dropped, the next BEGIN
+ *                       erases the slot even after a reset
+ *
+ * The boot loader starts the valid image of the highest version that is
+ * not rejected: confirmed as it is, else on a trial. An image that never
+ * confirms runs FW_MAX_TRIALS times, then the other slot runs again.
+ *
+ * The CRC is CRC-32/MPEG-2 over the words of the image, what the CRC unit
+ * computes natively (crc_calc_words of bsp_crc).
+ *
+ * Nothing here touches the hardware: the flash and the CRC come through
+ * fw_operation_t, so the host bench runs it on slots in RAM.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+#ifndef __BSP_FW_IMAGE_H__
+#define __BSP_FW_IMAGE_H__
+
+//******************************** Includes *********************************//
+
+#include <stdint.h>
+
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+#define FW_SLOT_NUM               2U         /* slots A and B               */
+#define FW_SLOT_NONE              0xFFFFFFFFU /* not running from a slot    */
+#define FW_SLOT_A_ADDR            0x08020000U /* sector 5                   */
+#define FW_SLOT_B_ADDR            0x08040000U /* sector 6                   */
+#define FW_SLOT_BYTES             0x00020000U /* one 128 KiB sector         */
+#define FW_HEADER_BYTES           0x200U     /* image after it, VTOR align  */
+#define FW_BLOCK_BYTES            1024U      /* unit of the progress        */
+#define FW_BLOCK_WORDS            ( FW_BLOCK_BYTES / 4U )
+#define FW_PROGRESS_WORDS         4U         /* 128 blocks                  */
+#define FW_MAX_TRIALS             3U         /* starts without confirmation */
+#define FW_MAGIC                  0x46574131U /* "FWA1"                     */
+#define FW_MARK                   0x00000000U /* confirmed, rejected        */
+#define FW_ERASED                 0xFFFFFFFFU
+
+typedef enum
+{
+    FW_OK                        = 0,  /* FW operate successfully            */
+    FW_ERROR                     = 1,  /* FW flash program or erase error    */
+    FW_ERRORTIMEOUT              = 2,  /* FW host or link too slow           */
+    FW_ERRORSOURCE               = 3,  /* FW no image to start / no session  */
+    FW_ERRORPARAMETER            = 4,  /* FW parameter error                 */
+    FW_ERRORNOMEMORY             = 5,  /* FW no block buffer free            */
+    FW_ERRORISR                  = 6,  /* FW not allowed in ISR context      */
+    FW_RESERVED                  = 0xFF,/* FW reserved                       */
+} fw_status_t;
+
+typedef enum
+{
+    FW_IMAGE_EMPTY               = 0,  /* header erased                      */
+    FW_IMAGE_PARTIAL             = 1,  /* session, no magic yet              */
+    FW_IMAGE_BAD                 = 2,  /* magic, size or CRC wrong           */
+    FW_IMAGE_REJECTED            = 3,  /* out of trials, or session dropped  */
+    FW_IMAGE_TRIAL               = 4,  /* valid, not confirmed yet           */
+    FW_IMAGE_CONFIRMED           = 5,  /* valid and confirmed                */
+} fw_image_state_t;
+
+typedef struct
+{
+    uint32_t              magic;                      /* FW_MAGIC, last      */
+    uint32_t              version;                    /* highest boots       */
+    uint32_t              size;                       /* bytes, words only   */
+    uint32_t              crc;                        /* of the image words  */
+    uint32_t              progress[FW_PROGRESS_WORDS];/* bit 0: block done   */
+    uint32_t              trials;                     /* bit 0: trial spent  */
+    uint32_t              confirmed;                  /* FW_MARK: confirmed  */
+    uint32_t              rejected;                   /* FW_MARK: rejected   */
+} fw_header_t;
+
+typedef struct
+{
+    uint32_t              * base;                     /* header, memory map  */
+    uint32_t              bytes;                      /* header and image    */
+} fw_slot_t;
+
+typedef struct
+{
+    /* erase a whole slot, 0 .. FW_SLOT_NUM - 1, NULL in the boot loader   */
+    fw_status_t ( *pf_flash_erase )   ( uint32_t slot );
+    /* program words, clearing bits only                                   */
+    fw_status_t ( *pf_flash_program ) ( uint32_t       * const dst,
+                                        const uint32_t * const src,
+                                        uint32_t               words );
+    /* CRC-32/MPEG-2 of words, most significant byte first                 */
+    uint32_t    ( *pf_crc_words )     ( const uint32_t * const words,
+                                        uint32_t               num   );
+} fw_operation_t;
+
+//******************************** Defines **********************************//
+
+//******************************* Declaring *********************************//
+
+/**
+ * @brief: State of a slot, checks the CRC of a complete image
+ *
+ * @param[in]  slot: the slot
+ * @param[in]  ops:  Pointer to a instance of fw_operation_t
+ *
+ * @return fw_image_state_t: state of the slot
+ **/
+fw_image_state_t fw_image_check ( const fw_slot_t      * const slot,
+                                  const fw_operation_t * const ops   );
+
+/**
+ * @brief: Trials left to an image not confirmed
+ *
+ * @param[in]  slot: the slot
+ *
+ * @return uint32_t: 0 .. FW_MAX_TRIALS
+ **/
+uint32_t fw_trials_left ( const fw_slot_t * const slot );
+
+/**
+ * @brief: Program one word of a header, clearing bits only
+ *
+ * @param[in]  word:  in the header of a slot
+ * @param[in]  value: new value, bits set in it stay as they are
+ * @param[in]  ops:   Pointer to a instance of fw_operation_t
+ *
+ * @return fw_status_t: execute result of this function
+ **/
+fw_status_t fw_mark ( uint32_t             * const word,
+                      uint32_t                     value,
+                      const fw_operation_t * const ops   );
+
+/**
+ * @brief: Choose the slot to start
+ * @steps:
+ *      1. Check the slots, the valid ones not rejected are candidates
+ *      2. Highest version first, slot A on a tie
+ *      3. Confirmed: start it. Else spend a trial and start it, or reject
+ *         it when out of trials and go on with the next candidate
+ *
+ * @param[in]  slots: FW_SLOT_NUM slots
+ * @param[in]  ops:   Pointer to a instance of fw_operation_t
+ * @param[out] slot:  the slot to start
+ *
+ * @return fw_status_t: FW_ERRORSOURCE when no image can start
+ **/
+fw_status_t fw_select ( const fw_slot_t      * const slots,
+                        const fw_operation_t * const ops,
+                        uint32_t             * const slot   );
+
+/**
+ * @brief: Blocks of the session written in a row from the first one
+ *
+ * @param[in]  slot: the slot
+ *
+ * @return uint32_t: number of blocks, the receiver resumes after them
+ **/
+uint32_t fw_progress ( const fw_slot_t * const slot );
+
+//******************************* Declaring *********************************//
+#endif // __BSP_FW_IMAGE_H__
@@ -0,0 +1,252 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_fw_update.h
+ *
+ * @par dependencies
+ * - bsp_osal.h
+ * - bsp_fw_image.h
+ * - bsp_crc.h
+ *
+ * @author Damian
+ *
+ * @brief Receiver of a firmware image over a serial link into the slot not
+ *        running: streamed block by block into the flash, resumable after
+ *        a reset or a broken link.
+ *
+ * Processing flow:
+ *
+ * fw_update_inst -> fw_update_start -> task: link read -> fw_update_rx
+ *                                              -> fw_update_service
+ * fw_update_rx      -> frames from the host, a block of DATA goes into a
+ *                      free RAM buffer and is acknowledged at once
+ * fw_update_service -> the flash: erase at BEGIN, one block buffer written
+ *                      and read back, its progress bit, the CRC and the
+ *                      magic at END
+ *
+ * Two block buffers: the host sends the next block while the last one is
+ * written, the link DMA keeps receiving while the flash stalls the core.
+ * A block is acknowledged once in RAM, it is durable once its progress bit
+ * is in the header (bsp_fw_image.h); after a reset the host asks again and
+ * resumes after the last durable block.
+ *
+ * Frames, both ways, little endian:
+ *
+ *  0xA5 0x5A type len(2) payload(len) crc(4)  CRC-32/MPEG-2 of type..payload
+ *
+ *  host              payload                   reply (type | 0x80)
+ *  FW_CMD_QUERY      -                         status info
+ *  FW_CMD_BEGIN      version size crc          status offset, after the erase
+ *  FW_CMD_DATA       offset block              status next offset
+ *  FW_CMD_END        -                         status, after the CRC check
+ *  FW_CMD_REBOOT     -                         status, then the reset
+ *
+ *  status(1) state(1) running(1) target(1) then the words of the reply
+ *
+ * DATA carries exactly one block at a multiple of FW_BLOCK_BYTES, the last
+ * one shorter. An offset already received is acknowledged again, one ahead
+ * gets FW_RSP_OFFSET with the offset expected. Bytes between the frames
+ * (the log on the same USART) are skipped.
+ *
+ * The running image is confirmed after FW_CONFIRM_MS; a BEGIN is refused
+ * before, the other slot holds the image to fall back to.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+#ifndef __BSP_FW_UPDATE_H__
+#define __BSP_FW_UPDATE_H__
+
+//******************************** Includes *********************************//
+
+#include "bsp_osal.h"
+#include "bsp_fw_image.h"
+#include "bsp_crc.h"
+#include <stdint.h>
+
+//******************************** Includes *********************************//
+
+typedef struct bsp_fw_update bsp_fw_update_t;
+
+//******************************** Defines **********************************//
+
+#define FW_SOF0                   0xA5U
+#define FW_SOF1                   0x5AU
+#define FW_FRAME_OVERHEAD         9U         /* SOF, type, len, crc         */
+#define FW_FRAME_MAX_PAYLOAD      ( 4U + FW_BLOCK_BYTES )
+#define FW_BLOCK_BUFFERS          2U         /* one written, one received   */
+#define FW_RX_CHUNK               256U       /* bytes read from the link    */
+#define FW_POLL_MS                100U       /* link read, nothing to write */
+#define FW_CONFIRM_MS             10000U     /* uptime to confirm the image */
+#define FW_UPDATE_STACK_WORDS     384U       /* stack of the receiver       */
+
+#define FW_CMD_QUERY              0x01U
+#define FW_CMD_BEGIN              0x02U
+#define FW_CMD_DATA               0x03U
+#define FW_CMD_END                0x04U
+#define FW_CMD_REBOOT             0x05U
+#define FW_RSP_FLAG               0x80U
+
+typedef enum
+{
+    FW_RSP_OK                    = 0,  /* done                               */
+    FW_RSP_OFFSET                = 1,  /* not the offset expected            */
+    FW_RSP_SIZE                  = 2,  /* size, offset or length wrong       */
+    FW_RSP_STATE                 = 3,  /* no session, or image not confirmed */
+    FW_RSP_FLASH                 = 4,  /* flash error, BEGIN again           */
+    FW_RSP_CRC                   = 5,  /* CRC of the image wrong             */
+} fw_rsp_t;
+
+typedef enum
+{
+    FW_RX_IDLE                   = 0,  /* no session                         */
+    FW_RX_BEGIN                  = 1,  /* erase / resume pending             */
+    FW_RX_DATA                   = 2,  /* blocks coming                      */
+    FW_RX_END                    = 3,  /* CRC check pending                  */
+    FW_RX_DONE                   = 4,  /* image complete in the target slot  */
+} fw_rx_state_t;
+
+typedef enum
+{
+    FW_UPDATE_INITED     = 0,  /* fw update initialized                      */
+    FW_UPDATE_NOT_INITED = 1,  /* fw update not initialized                  */
+} fw_update_init_t;
+
+typedef struct
+{
+    /* read what the link received, up to max bytes, waits timeout_ms      */
+    fw_status_t ( *pf_link_read )  ( uint8_t  * const buf,
+                                     uint32_t         max,
+                                     uint32_t         timeout_ms,
+                                     uint32_t * const got        );
+    /* send a whole reply frame                                            */
+    fw_status_t ( *pf_link_send )  ( const uint8_t * const data,
+                                     uint32_t              len   );
+    /* reset into the boot loader                                          */
+    void        ( *pf_reboot )     ( void );
+} fw_link_operation_t;
+
+typedef struct bsp_fw_update
+{
+    //************************* Internal property ***************************//
+    fw_update_init_t      is_initialized;             /* record init status  */
+    fw_slot_t             slot[FW_SLOT_NUM];          /* A, B                */
+    uint32_t              running;                    /* FW_SLOT_NONE: none  */
+    uint32_t              target;                     /* slot received into  */
+    fw_rx_state_t         state;                      /* of the session      */
+    uint32_t              version;                    /* of the session      */
+    uint32_t              size;                       /*   bytes             */
+    uint32_t              crc;                        /*   of the words      */
+    uint32_t              next;                       /* offset expected     */
+    uint32_t              force_erase;                /* BEGIN starts over   */
+    uint32_t              confirmed;                  /* running one marked  */
+    uint8_t               frame[FW_FRAME_MAX_PAYLOAD + FW_FRAME_OVERHEAD];
+    uint32_t              frame_len;                  /* bytes in frame[]    */
+    uint32_t              frame_held;                 /* DATA, no buffer yet */
+    uint32_t              block[FW_BLOCK_BUFFERS][FW_BLOCK_WORDS];
+    uint32_t              block_offset[FW_BLOCK_BUFFERS];
+    uint32_t              block_bytes[FW_BLOCK_BUFFERS];
+    uint32_t              block_head;                 /* next one filled     */
+    uint32_t              block_ready;                /* filled, not written */
+    uint8_t               rx[FW_RX_CHUNK];            /* read, not parsed    */
+    uint32_t              rx_len;
+
+    //***************************** Statistics ******************************//
+    uint32_t              frames;                     /* with a good CRC     */
+    uint32_t              bad_frames;                 /* CRC or length wrong */
+    uint32_t              blocks;                     /* written and checked */
+    uint32_t              resumed;                    /* BEGIN resumed       */
+    uint32_t              erases;                     /* slot erased         */
+    uint32_t              flash_errors;               /* program or readback */
+
+    //************************ Interface from core **************************//
+    const fw_operation_t      * p_operation_inst;     /* flash and CRC       */
+    const fw_link_operation_t * p_link_inst;          /* serial link         */
+    time_operation_t      * p_time_operation_inst;    /* time ops interface  */
+
+} bsp_fw_update_t;
+
+//******************************** Defines **********************************//
+
+//******************************* Declaring *********************************//
+
+/**
+ * @brief: Instantiate a bsp_fw_update_t
+ * @steps:
+ *      1. Adding the flash, link and time interfaces into the instance
+ *      2. Take the slots, the target is the one not running
+ *
+ * @param[in]  fw:       Pointer to a instance of bsp_fw_update_t
+ * @param[in]  ops:      Pointer to a instance of fw_operation_t
+ * @param[in]  link:     Pointer to a instance of fw_link_operation_t
+ * @param[in]  time_ops: Pointer to a instance of time_operation_t
+ * @param[in]  slots:    FW_SLOT_NUM slots, copied
+ * @param[in]  running:  slot of the running image, FW_SLOT_NONE refuses
+ *                       every BEGIN (the image is not in a slot)
+ *
+ * @return fw_status_t: execute result of this function
+ **/
+fw_status_t fw_update_inst (
+                             bsp_fw_update_t           * const fw,
+                             const fw_operation_t      * const ops,
+                             const fw_link_operation_t * const link,
+                             time_operation_t          * const time_ops,
+                             const fw_slot_t           * const slots,
+                             uint32_t                          running
+                                                                        );
+
+/**
+ * @brief: Create the receiver task, priority tskIDLE_PRIORITY + 2
+ *
+ * @param[in]  fw: Pointer to a instance of bsp_fw_update_t
+ *
+ * @return fw_status_t: execute result of this function
+ **/
+fw_status_t fw_update_start ( bsp_fw_update_t * const fw );
+
+/**
+ * @brief: Parse bytes from the link, answer the frames
+ *
+ * Stops at a DATA frame while both block buffers wait for the flash, the
+ * rest is for the next call after fw_update_service.
+ *
+ * @param[in]  fw:   Pointer to a instance of bsp_fw_update_t
+ * @param[in]  data: bytes received
+ * @param[in]  len:  number of bytes
+ * @param[out] used: bytes parsed
+ *
+ * @return fw_status_t: FW_ERRORNOMEMORY when stopped at a DATA frame
+ **/
+fw_status_t fw_update_rx ( bsp_fw_update_t * const fw,
+                           const uint8_t   * const data,
+                           uint32_t                len,
+                           uint32_t        * const used  );
+
+/**
+ * @brief: One flash step: a block, or the erase of BEGIN, or the check of
+ *         END once the blocks are written
+ *
+ * @param[in]  fw:   Pointer to a instance of bsp_fw_update_t
+ * @param[out] busy: 1 when a step was done, more may follow
+ *
+ * @return fw_status_t: FW_ERROR on a flash error, the session is over
+ **/
+fw_status_t fw_update_service ( bsp_fw_update_t * const fw,
+                                uint32_t        * const busy );
+
+/**
+ * @brief: Confirm the running image, the boot loader keeps starting it
+ *
+ * @param[in]  fw: Pointer to a instance of bsp_fw_update_t
+ *
+ * @return fw_status_t: execute result of this function
+ **/
+fw_status_t fw_update_confirm ( bsp_fw_update_t * const fw );
+
+//******************************* Declaring *********************************//
+#endif // __BSP_FW_UPDATE_H__
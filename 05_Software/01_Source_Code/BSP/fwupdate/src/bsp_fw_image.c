@@ -0,0 +1,259 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_fw_image.c
+ *
+ * @par dependencies
+ * - bsp_fw_image.h
+ *
+ * @author Damian
+ *
+ * @brief A/B firmware slots: the image header, its checks and the boot
+ *        choice, shared by the boot loader and the receiver of bsp_fw_update.
+ *
+ * Processing flow:
+ *
+ * Call directly.
+ *
+ * The boot loader links this file alone: no LOG, no RTOS, no library call.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+//******************************** Includes *********************************//
+
+#include "bsp_fw_image.h"
+#include <stddef.h>
+
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+#define FW_TRIALS_MASK            ( ( 1UL << FW_MAX_TRIALS ) - 1UL )
+
+/**
+ * @brief: Header of a slot
+ *
+ * @param[in]  slot: the slot
+ *
+ * @return const fw_header_t *: at the base of the slot
+ **/
+static const fw_header_t * __header ( const fw_slot_t * const slot )
+{
+    return (const fw_header_t *)slot->base;
+}
+
+/**
+ * @brief: Bits cleared in a word
+ *
+ * @param[in]  value: the word
+ *
+ * @return uint32_t: 0 .. 32
+ **/
+static uint32_t __cleared ( uint32_t value )
+{
+    uint32_t count = 0U;
+
+    value = ~value;
+    while ( 0U != value )
+    {
+        value &= value - 1U;
+        ++count;
+    }
+    return count;
+}
+
+/**
+ * @brief: State of a slot, checks the CRC of a complete image
+ * @steps:
+ *      1. Erased header: empty. No magic: a session not complete
+ *      2. Size out of the slot or CRC of the image wrong: bad
+ *      3. Rejected, confirmed, or on trial
+ *
+ * @param[in]  slot: the slot
+ * @param[in]  ops:  Pointer to a instance of fw_operation_t
+ *
+ * @return fw_image_state_t: state of the slot
+ **/
+fw_image_state_t fw_image_check ( const fw_slot_t      * const slot,
+                                  const fw_operation_t * const ops   )
+{
+    const fw_header_t * hdr = __header( slot );
+
+    /******************** 1. Empty, partial *******************/
+    if ( FW_ERASED == hdr->magic   && FW_ERASED == hdr->version &&
+         FW_ERASED == hdr->size    && FW_ERASED == hdr->crc )
+    {
+        return FW_IMAGE_EMPTY;
+    }
+    if ( FW_MAGIC != hdr->magic )
+    {
+        return FW_IMAGE_PARTIAL;
+    }
+
+    /********************** 2. Bad image **********************/
+    if ( 0U == hdr->size || 0U != ( hdr->size & 3U ) ||
+         hdr->size > slot->bytes - FW_HEADER_BYTES )
+    {
+        return FW_IMAGE_BAD;
+    }
+    if ( hdr->crc != ops->pf_crc_words(
+                         &slot->base[FW_HEADER_BYTES / 4U], hdr->size / 4U ) )
+    {
+        return FW_IMAGE_BAD;
+    }
+
+    /*************** 3. Rejected, confirmed, trial ************/
+    if ( FW_ERASED != hdr->rejected )
+    {
+        return FW_IMAGE_REJECTED;
+    }
+    return ( FW_MARK == hdr->confirmed ) ? FW_IMAGE_CONFIRMED :
+                                           FW_IMAGE_TRIAL;
+}
+
+/**
+ * @brief: Trials left to an image not confirmed
+ *
+ * @param[in]  slot: the slot
+ *
+ * @return uint32_t: 0 .. FW_MAX_TRIALS
+ **/
+uint32_t fw_trials_left ( const fw_slot_t * const slot )
+{
+    return FW_MAX_TRIALS -
+           __cleared( __header( slot )->trials | ~FW_TRIALS_MASK );
+}
+
+/**
+ * @brief: Program one word of a header, clearing bits only
+ *
+ * @param[in]  word:  in the header of a slot
+ * @param[in]  value: new value, bits set in it stay as they are
+ * @param[in]  ops:   Pointer to a instance of fw_operation_t
+ *
+ * @return fw_status_t: execute result of this function
+ **/
+fw_status_t fw_mark ( uint32_t             * const word,
+                      uint32_t                     value,
+                      const fw_operation_t * const ops   )
+{
+    uint32_t next = *word & value;
+
+    if ( next == *word )
+    {
+        return FW_OK;
+    }
+    if ( FW_OK != ops->pf_flash_program( word, &next, 1U ) )
+    {
+        return FW_ERROR;
+    }
+    return ( next == *word ) ? FW_OK : FW_ERROR;
+}
+
+/**
+ * @brief: Choose the slot to start
+ * @steps:
+ *      1. Check the slots, the valid ones not rejected are candidates
+ *      2. Highest version first, slot A on a tie
+ *      3. Confirmed: start it. Else spend a trial and start it, or reject
+ *         it when out of trials and go on with the next candidate
+ *
+ * @param[in]  slots: FW_SLOT_NUM slots
+ * @param[in]  ops:   Pointer to a instance of fw_operation_t
+ * @param[out] slot:  the slot to start
+ *
+ * @return fw_status_t: FW_ERRORSOURCE when no image can start
+ **/
+fw_status_t fw_select ( const fw_slot_t      * const slots,
+                        const fw_operation_t * const ops,
+                        uint32_t             * const slot   )
+{
+    fw_image_state_t state[FW_SLOT_NUM];
+    uint32_t         order[FW_SLOT_NUM];
+    uint32_t         num = 0U;
+    uint32_t         tmp;
+    uint32_t       * hdr;
+
+    if ( NULL == slots || NULL == ops || NULL == slot )
+    {
+        return FW_ERRORPARAMETER;
+    }
+
+    /********************* 1. Candidates **********************/
+    for ( uint32_t i = 0; i < FW_SLOT_NUM; ++i )
+    {
+        state[i] = fw_image_check( &slots[i], ops );
+        if ( FW_IMAGE_TRIAL == state[i] || FW_IMAGE_CONFIRMED == state[i] )
+        {
+            order[num++] = i;
+        }
+    }
+
+    /************** 2. Highest version first ******************/
+    for ( uint32_t i = 1; i < num; ++i )
+    {
+        for ( uint32_t j = i; j > 0U &&
+              __header( &slots[order[j]] )->version >
+              __header( &slots[order[j - 1U]] )->version; --j )
+        {
+            tmp           = order[j];
+            order[j]      = order[j - 1U];
+            order[j - 1U] = tmp;
+        }
+    }
+
+    /************* 3. Confirmed, trial, rejected **************/
+    for ( uint32_t i = 0; i < num; ++i )
+    {
+        hdr = slots[order[i]].base;
+        if ( FW_IMAGE_CONFIRMED == state[order[i]] )
+        {
+            *slot = order[i];
+            return FW_OK;
+        }
+        if ( 0U != fw_trials_left( &slots[order[i]] ) )
+        {
+            // spend the lowest trial left, a torn bit is spent already
+            tmp = ( (fw_header_t *)hdr )->trials;
+            if ( FW_OK != fw_mark( &( (fw_header_t *)hdr )->trials,
+                                   ~( tmp & ( 0U - tmp ) ), ops ) )
+            {
+                // not recorded, it would start without limit
+                continue;
+            }
+            *slot = order[i];
+            return FW_OK;
+        }
+        (void)fw_mark( &( (fw_header_t *)hdr )->rejected, FW_MARK, ops );
+    }
+    return FW_ERRORSOURCE;
+}
+
+/**
+ * @brief: Blocks of the session written in a row from the first one
+ *
+ * @param[in]  slot: the slot
+ *
+ * @return uint32_t: number of blocks, the receiver resumes after them
+ **/
+uint32_t fw_progress ( const fw_slot_t * const slot )
+{
+    const fw_header_t * hdr    = __header( slot );
+    uint32_t            blocks = 0U;
+
+    while ( blocks < FW_PROGRESS_WORDS * 32U &&
+            0U == ( hdr->progress[blocks / 32U] &
+                    ( 1UL << ( blocks % 32U ) ) ) )
+    {
+        ++blocks;
+    }
+    return blocks;
+}
+
+//******************************** Defines **********************************//
@@ -0,0 +1,782 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_fw_update.c
+ *
+ * @par dependencies
+ * - bsp_fw_update.h
+ * - bsp_common.h
+ *
+ * @author Damian
+ *
+ * @brief Receiver of a firmware image over a serial link into the slot not
+ *        running: streamed block by block into the flash, resumable after
+ *        a reset or a broken link.
+ *
+ * Processing flow:
+ *
+ * Call directly.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+//******************************** Includes *********************************//
+
+#include "bsp_fw_update.h"
+#include "bsp_common.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include <string.h>
+
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+BSP_STATUS_CHECK( FW );
+
+#define FW_REPLY_WORDS            4U         /* most words in a reply       */
+
+/**
+ * @brief: Little endian word at p
+ *
+ * @param[in]  p: 4 bytes
+ *
+ * @return uint32_t: the word
+ **/
+static uint32_t __get_le32 ( const uint8_t * const p )
+{
+    return   (uint32_t)p[0]         | ( (uint32_t)p[1] << 8 ) |
+           ( (uint32_t)p[2] << 16 ) | ( (uint32_t)p[3] << 24 );
+}
+
+/**
+ * @brief: Little endian word to p
+ *
+ * @param[in]  p:     4 bytes
+ * @param[in]  value: the word
+ **/
+static void __put_le32 ( uint8_t * const p, uint32_t value )
+{
+    p[0] = (uint8_t)value;
+    p[1] = (uint8_t)( value >> 8 );
+    p[2] = (uint8_t)( value >> 16 );
+    p[3] = (uint8_t)( value >> 24 );
+}
+
+/**
+ * @brief: Header of a slot
+ *
+ * @param[in]  fw:   Pointer to a instance of bsp_fw_update_t
+ * @param[in]  slot: 0 .. FW_SLOT_NUM - 1
+ *
+ * @return fw_header_t *: at the base of the slot
+ **/
+static fw_header_t * __header ( bsp_fw_update_t * const fw, uint32_t slot )
+{
+    return (fw_header_t *)fw->slot[slot].base;
+}
+
+/**
+ * @brief: Send a reply frame
+ *
+ * @param[in]  fw:     Pointer to a instance of bsp_fw_update_t
+ * @param[in]  cmd:    command answered
+ * @param[in]  status: fw_rsp_t
+ * @param[in]  words:  words after the status bytes
+ * @param[in]  num:    0 .. FW_REPLY_WORDS
+ **/
+static void __reply ( bsp_fw_update_t * const fw,
+                      uint32_t                cmd,
+                      fw_rsp_t                status,
+                      const uint32_t  * const words,
+                      uint32_t                num    )
+{
+    uint8_t  out[FW_FRAME_OVERHEAD + 4U + 4U * FW_REPLY_WORDS];
+    uint32_t len = 4U + 4U * num;
+
+    out[0] = FW_SOF0;
+    out[1] = FW_SOF1;
+    out[2] = (uint8_t)( cmd | FW_RSP_FLAG );
+    out[3] = (uint8_t)len;
+    out[4] = 0U;
+    out[5] = (uint8_t)status;
+    out[6] = (uint8_t)fw->state;
+    out[7] = (uint8_t)fw->running;
+    out[8] = (uint8_t)fw->target;
+    for ( uint32_t i = 0; i < num; ++i )
+    {
+        __put_le32( &out[9U + 4U * i], words[i] );
+    }
+    __put_le32( &out[5U + len],
+                crc32_mpeg2_sw( CRC32_MPEG2_INIT, &out[2], 3U + len ) );
+    fw->p_link_inst->pf_link_send( out, FW_FRAME_OVERHEAD + len );
+}
+
+/**
+ * @brief: Reply of a status and the offset expected
+ *
+ * @param[in]  fw:     Pointer to a instance of bsp_fw_update_t
+ * @param[in]  cmd:    command answered
+ * @param[in]  status: fw_rsp_t
+ **/
+static void __reply_next ( bsp_fw_update_t * const fw,
+                           uint32_t                cmd,
+                           fw_rsp_t                status )
+{
+    __reply( fw, cmd, status, &fw->next, 1U );
+}
+
+/**
+ * @brief: Drop the session in the target slot, the next BEGIN erases even
+ *         after a reset: the header is marked rejected
+ *
+ * @param[in]  fw: Pointer to a instance of bsp_fw_update_t
+ **/
+static void __drop ( bsp_fw_update_t * const fw )
+{
+    fw->state       = FW_RX_IDLE;
+    fw->force_erase = 1U;
+    fw->block_ready = 0U;
+    (void)fw_mark( &__header( fw, fw->target )->rejected, FW_MARK,
+                   fw->p_operation_inst );
+}
+
+/**
+ * @brief: End the session after a flash error, the next BEGIN erases
+ *
+ * @param[in]  fw: Pointer to a instance of bsp_fw_update_t
+ **/
+static void __fail ( bsp_fw_update_t * const fw )
+{
+    ++fw->flash_errors;
+    __drop( fw );
+}
+
+/**
+ * @brief: Write a block buffer into the target slot, read it back, clear
+ *         its progress bit
+ * @steps:
+ *      1. Words already there are skipped (a block written again after a
+ *         reset), a bit to set back is an error
+ *      2. Read back, then the progress bit
+ *
+ * @param[in]  fw:  Pointer to a instance of bsp_fw_update_t
+ * @param[in]  idx: block buffer
+ *
+ * @return fw_status_t: execute result of this function
+ **/
+static fw_status_t __block_write ( bsp_fw_update_t * const fw, uint32_t idx )
+{
+    const fw_operation_t * ops   = fw->p_operation_inst;
+    const uint32_t       * src   = fw->block[idx];
+    uint32_t             * dst   = &fw->slot[fw->target].base[
+                                       ( FW_HEADER_BYTES +
+                                         fw->block_offset[idx] ) / 4U];
+    uint32_t               words = fw->block_bytes[idx] / 4U;
+    uint32_t               k     = fw->block_offset[idx] / FW_BLOCK_BYTES;
+    uint32_t               erased = 1U;
+
+    /**************** 1. Program what is missing **************/
+    for ( uint32_t i = 0; i < words; ++i )
+    {
+        if ( 0U != ( src[i] & ~dst[i] ) )
+        {
+            return FW_ERROR;
+        }
+        erased &= ( FW_ERASED == dst[i] ) ? 1U : 0U;
+    }
+    if ( 0U != erased )
+    {
+        if ( FW_OK != ops->pf_flash_program( dst, src, words ) )
+        {
+            return FW_ERROR;
+        }
+    }
+    else
+    {
+        for ( uint32_t i = 0; i < words; ++i )
+        {
+            if ( src[i] != dst[i] &&
+                 FW_OK != ops->pf_flash_program( &dst[i], &src[i], 1U ) )
+            {
+                return FW_ERROR;
+            }
+        }
+    }
+
+    /**************** 2. Read back, progress bit **************/
+    if ( 0 != memcmp( dst, src, words * 4U ) )
+    {
+        return FW_ERROR;
+    }
+    ++fw->blocks;
+    return fw_mark( &__header( fw, fw->target )->progress[k / 32U],
+                    ~( 1UL << ( k % 32U ) ), ops );
+}
+
+/**
+ * @brief: Settle a BEGIN: resume the session in the slot or start it over
+ * @steps:
+ *      1. Same session in the header, not dropped: resume, else erase and
+ *         write it
+ *      2. Resume after the blocks written in a row, reply
+ *
+ * @param[in]  fw: Pointer to a instance of bsp_fw_update_t
+ *
+ * @return fw_status_t: execute result of this function
+ **/
+static fw_status_t __begin_settle ( bsp_fw_update_t * const fw )
+{
+    const fw_operation_t * ops     = fw->p_operation_inst;
+    fw_header_t          * hdr     = __header( fw, fw->target );
+    uint32_t               session[3];
+
+    /*********************** 1. Session ***********************/
+    session[0] = fw->version;
+    session[1] = fw->size;
+    session[2] = fw->crc;
+    if ( 0U           == fw->force_erase &&
+         FW_ERASED    == hdr->rejected   &&
+         hdr->version == fw->version     &&
+         hdr->size    == fw->size        &&
+         hdr->crc     == fw->crc )
+    {
+        ++fw->resumed;
+    }
+    else
+    {
+        ++fw->erases;
+        if ( FW_OK != ops->pf_flash_erase( fw->target )                ||
+             FW_OK != ops->pf_flash_program( &hdr->version, session, 3U ) ||
+             0 != memcmp( &hdr->version, session, sizeof( session ) ) )
+        {
+            __fail( fw );
+            __reply_next( fw, FW_CMD_BEGIN, FW_RSP_FLASH );
+            return FW_ERROR;
+        }
+        fw->force_erase = 0U;
+    }
+
+    /*********************** 2. Resume ************************/
+    fw->next = fw_progress( &fw->slot[fw->target] ) * FW_BLOCK_BYTES;
+    if ( fw->next >= fw->size )
+    {
+        fw->next = fw->size;
+    }
+    fw->state = ( fw->next == fw->size && FW_MAGIC == hdr->magic ) ?
+                FW_RX_DONE : FW_RX_DATA;
+    __reply_next( fw, FW_CMD_BEGIN, FW_RSP_OK );
+    return FW_OK;
+}
+
+/**
+ * @brief: Settle an END: every block written, the CRC, then the magic
+ *
+ * @param[in]  fw: Pointer to a instance of bsp_fw_update_t
+ *
+ * @return fw_status_t: execute result of this function
+ **/
+static fw_status_t __end_settle ( bsp_fw_update_t * const fw )
+{
+    const fw_operation_t * ops = fw->p_operation_inst;
+    const fw_slot_t      * slot = &fw->slot[fw->target];
+    fw_header_t          * hdr = __header( fw, fw->target );
+
+    if ( fw_progress( slot ) * FW_BLOCK_BYTES < fw->size ||
+         fw->crc != ops->pf_crc_words( &slot->base[FW_HEADER_BYTES / 4U],
+                                       fw->size / 4U ) )
+    {
+        // a block lost under a torn erase, only a new session helps
+        __drop( fw );
+        __reply_next( fw, FW_CMD_END, FW_RSP_CRC );
+        return FW_ERROR;
+    }
+    if ( FW_OK != fw_mark( &hdr->magic, FW_MAGIC, ops ) )
+    {
+        __fail( fw );
+        __reply_next( fw, FW_CMD_END, FW_RSP_FLASH );
+        return FW_ERROR;
+    }
+    fw->state = FW_RX_DONE;
+    __reply_next( fw, FW_CMD_END, FW_RSP_OK );
+    return FW_OK;
+}
+
+/**
+ * @brief: QUERY, the session in RAM or else the one in the target header
+ *
+ * @param[in]  fw: Pointer to a instance of bsp_fw_update_t
+ **/
+static void __on_query ( bsp_fw_update_t * const fw )
+{
+    const fw_header_t * hdr = __header( fw, fw->target );
+    uint32_t            info[FW_REPLY_WORDS];
+
+    if ( FW_RX_IDLE != fw->state )
+    {
+        info[0] = fw->version;
+        info[1] = fw->size;
+        info[2] = fw->crc;
+        info[3] = fw->next;
+    }
+    else
+    {
+        info[0] = hdr->version;
+        info[1] = hdr->size;
+        info[2] = hdr->crc;
+        info[3] = fw_progress( &fw->slot[fw->target] ) * FW_BLOCK_BYTES;
+    }
+    __reply( fw, FW_CMD_QUERY, FW_RSP_OK, info, FW_REPLY_WORDS );
+}
+
+/**
+ * @brief: BEGIN, checked here, settled by fw_update_service
+ *
+ * @param[in]  fw:      Pointer to a instance of bsp_fw_update_t
+ * @param[in]  payload: version, size, crc
+ * @param[in]  len:     bytes of the payload
+ **/
+static void __on_begin ( bsp_fw_update_t * const fw,
+                         const uint8_t   * const payload,
+                         uint32_t                len      )
+{
+    uint32_t version;
+    uint32_t size;
+    uint32_t crc;
+
+    if ( FW_SLOT_NONE == fw->running || 0U == fw->confirmed )
+    {
+        // the target holds the only image to fall back to
+        __reply_next( fw, FW_CMD_BEGIN, FW_RSP_STATE );
+        return;
+    }
+    version = ( 12U == len ) ? __get_le32( &payload[0] ) : 0U;
+    size    = ( 12U == len ) ? __get_le32( &payload[4] ) : 0U;
+    crc     = ( 12U == len ) ? __get_le32( &payload[8] ) : 0U;
+    if ( 0U == size || 0U != ( size & 3U ) ||
+         size > fw->slot[fw->target].bytes - FW_HEADER_BYTES ||
+         ( size + FW_BLOCK_BYTES - 1U ) / FW_BLOCK_BYTES >
+         FW_PROGRESS_WORDS * 32U )
+    {
+        __reply_next( fw, FW_CMD_BEGIN, FW_RSP_SIZE );
+        return;
+    }
+
+    // blocks of another session are dropped, the same one goes on
+    if ( version != fw->version || size != fw->size || crc != fw->crc )
+    {
+        fw->block_ready = 0U;
+    }
+    fw->version = version;
+    fw->size    = size;
+    fw->crc     = crc;
+    fw->state   = FW_RX_BEGIN;
+}
+
+/**
+ * @brief: DATA, one block into a free buffer
+ *
+ * @param[in]  fw:      Pointer to a instance of bsp_fw_update_t
+ * @param[in]  payload: offset, block
+ * @param[in]  len:     bytes of the payload
+ *
+ * @return fw_status_t: FW_ERRORNOMEMORY when no buffer is free
+ **/
+static fw_status_t __on_data ( bsp_fw_update_t * const fw,
+                               const uint8_t   * const payload,
+                               uint32_t                len      )
+{
+    uint32_t offset = ( len >= 4U ) ? __get_le32( payload ) : FW_ERASED;
+    uint32_t bytes  = len - 4U;
+    uint32_t idx    = fw->block_head;
+
+    if ( FW_RX_DATA != fw->state || len < 4U )
+    {
+        __reply_next( fw, FW_CMD_DATA, FW_RSP_STATE );
+        return FW_OK;
+    }
+    if ( offset < fw->next && 0U == offset % FW_BLOCK_BYTES )
+    {
+        // the acknowledge was lost, the host sent it again
+        __reply_next( fw, FW_CMD_DATA, FW_RSP_OK );
+        return FW_OK;
+    }
+    if ( offset != fw->next )
+    {
+        __reply_next( fw, FW_CMD_DATA, FW_RSP_OFFSET );
+        return FW_OK;
+    }
+    if ( bytes != ( ( fw->size - offset < FW_BLOCK_BYTES ) ?
+                    fw->size - offset : FW_BLOCK_BYTES ) )
+    {
+        __reply_next( fw, FW_CMD_DATA, FW_RSP_SIZE );
+        return FW_OK;
+    }
+    if ( FW_BLOCK_BUFFERS == fw->block_ready )
+    {
+        return FW_ERRORNOMEMORY;
+    }
+    memcpy( fw->block[idx], &payload[4], bytes );
+    fw->block_offset[idx] = offset;
+    fw->block_bytes[idx]  = bytes;
+    fw->block_head        = ( idx + 1U ) % FW_BLOCK_BUFFERS;
+    ++fw->block_ready;
+    fw->next += bytes;
+    __reply_next( fw, FW_CMD_DATA, FW_RSP_OK );
+    return FW_OK;
+}
+
+/**
+ * @brief: A frame with a good CRC
+ *
+ * @param[in]  fw: Pointer to a instance of bsp_fw_update_t
+ *
+ * @return fw_status_t: FW_ERRORNOMEMORY when a DATA frame has to wait
+ **/
+static fw_status_t __dispatch ( bsp_fw_update_t * const fw )
+{
+    const uint8_t * payload = &fw->frame[5];
+    uint32_t        len     = fw->frame_len - FW_FRAME_OVERHEAD;
+
+    switch ( fw->frame[2] )
+    {
+    case FW_CMD_QUERY:
+        __on_query( fw );
+        break;
+    case FW_CMD_BEGIN:
+        __on_begin( fw, payload, len );
+        break;
+    case FW_CMD_DATA:
+        return __on_data( fw, payload, len );
+    case FW_CMD_END:
+        if ( FW_RX_DONE == fw->state )
+        {
+            __reply_next( fw, FW_CMD_END, FW_RSP_OK );
+        }
+        else if ( FW_RX_DATA == fw->state && fw->next == fw->size )
+        {
+            fw->state = FW_RX_END;
+        }
+        else
+        {
+            __reply_next( fw, FW_CMD_END, FW_RSP_STATE );
+        }
+        break;
+    case FW_CMD_REBOOT:
+        __reply_next( fw, FW_CMD_REBOOT, FW_RSP_OK );
+        fw->p_link_inst->pf_reboot();
+        break;
+    default:
+        break;
+    }
+    return FW_OK;
+}
+
+/**
+ * @brief: Receiver task, link -> frames -> flash, confirms the image
+ *
+ * @param[in]  argument: Pointer to a instance of bsp_fw_update_t
+ **/
+static void fw_update_task ( void * argument )
+{
+    bsp_fw_update_t * fw       = (bsp_fw_update_t *)argument;
+    uint32_t          busy     = 0U;
+    uint32_t          got;
+    uint32_t          used;
+    uint32_t          now_ms   = 0U;
+
+    for ( ;; )
+    {
+        got = 0U;
+        fw->p_link_inst->pf_link_read( &fw->rx[fw->rx_len],
+                                       FW_RX_CHUNK - fw->rx_len,
+                                       ( 0U != busy ) ? 0U : FW_POLL_MS,
+                                       &got );
+        fw->rx_len += got;
+        used = 0U;
+        fw_update_rx( fw, fw->rx, fw->rx_len, &used );
+        memmove( fw->rx, &fw->rx[used], fw->rx_len - used );
+        fw->rx_len -= used;
+        fw_update_service( fw, &busy );
+        busy |= ( 0U != fw->block_ready ) ? 1U : 0U;
+
+        if ( 0U == fw->confirmed && FW_SLOT_NONE != fw->running )
+        {
+            fw->p_time_operation_inst->pf_get_time_ms( &now_ms );
+            if ( now_ms >= FW_CONFIRM_MS )
+            {
+                fw_update_confirm( fw );
+            }
+        }
+    }
+}
+
+/**
+ * @brief: Instantiate a bsp_fw_update_t
+ * @steps:
+ *      1. Adding the flash, link and time interfaces into the instance
+ *      2. Take the slots, the target is the one not running
+ *
+ * @param[in]  fw:       Pointer to a instance of bsp_fw_update_t
+ * @param[in]  ops:      Pointer to a instance of fw_operation_t
+ * @param[in]  link:     Pointer to a instance of fw_link_operation_t
+ * @param[in]  time_ops: Pointer to a instance of time_operation_t
+ * @param[in]  slots:    FW_SLOT_NUM slots, copied
+ * @param[in]  running:  slot of the running image, FW_SLOT_NONE refuses
+ *                       every BEGIN (the image is not in a slot)
+ *
+ * @return fw_status_t: execute result of this function
+ **/
+fw_status_t fw_update_inst (
+                             bsp_fw_update_t           * const fw,
+                             const fw_operation_t      * const ops,
+                             const fw_link_operation_t * const link,
+                             time_operation_t          * const time_ops,
+                             const fw_slot_t           * const slots,
+                             uint32_t                          running
+                                                                        )
+{
+    if ( NULL == fw                          ||
+         NULL == ops                         ||
+         NULL == ops->pf_flash_erase         ||
+         NULL == ops->pf_flash_program       ||
+         NULL == ops->pf_crc_words           ||
+         NULL == link                        ||
+         NULL == link->pf_link_read          ||
+         NULL == link->pf_link_send          ||
+         NULL == link->pf_reboot             ||
+         NULL == time_ops                    ||
+         NULL == time_ops->pf_get_time_ms    ||
+         NULL == slots                       ||
+         ( FW_SLOT_NONE != running && running >= FW_SLOT_NUM ) )
+    {
+        LOG( LOG_LEVEL_ERR, "Input parameter is null" );
+        return FW_ERRORPARAMETER;
+    }
+
+    /************* 1. Adding the interfaces *******************/
+    memset( fw, 0, sizeof( *fw ) );
+    fw->p_operation_inst      = ops;
+    fw->p_link_inst           = link;
+    fw->p_time_operation_inst = time_ops;
+
+    /******************* 2. Take the slots ********************/
+    for ( uint32_t i = 0; i < FW_SLOT_NUM; ++i )
+    {
+        fw->slot[i] = slots[i];
+    }
+    fw->running   = running;
+    fw->target    = ( 0U == running ) ? 1U : 0U;
+    fw->state     = FW_RX_IDLE;
+    fw->version   = FW_ERASED;
+    fw->confirmed = ( FW_SLOT_NONE != running &&
+                      FW_MARK == __header( fw, running )->confirmed ) ?
+                    1U : 0U;
+    fw->is_initialized = FW_UPDATE_INITED;
+    return FW_OK;
+}
+
+/**
+ * @brief: Create the receiver task, priority tskIDLE_PRIORITY + 2
+ *
+ * @param[in]  fw: Pointer to a instance of bsp_fw_update_t
+ *
+ * @return fw_status_t: execute result of this function
+ **/
+fw_status_t fw_update_start ( bsp_fw_update_t * const fw )
+{
+    if ( NULL == fw || FW_UPDATE_INITED != fw->is_initialized )
+    {
+        LOG( LOG_LEVEL_ERR, "Firmware update not initialized" );
+        return FW_ERRORSOURCE;
+    }
+    if ( pdPASS != xTaskCreate( fw_update_task,
+                                "fw_update",
+                                FW_UPDATE_STACK_WORDS,
+                                fw,
+                                tskIDLE_PRIORITY + 2,
+                                NULL                  ) )
+    {
+        LOG( LOG_LEVEL_ERR, "Firmware update task create failed" );
+        return FW_ERRORNOMEMORY;
+    }
+    return FW_OK;
+}
+
+/**
+ * @brief: Parse bytes from the link, answer the frames
+ * @steps:
+ *      1. A DATA frame held for a buffer goes first
+ *      2. Per byte: sync on the SOF, the length, the whole frame
+ *      3. Good CRC: dispatch, stop when a DATA frame has to wait
+ *
+ * @param[in]  fw:   Pointer to a instance of bsp_fw_update_t
+ * @param[in]  data: bytes received
+ * @param[in]  len:  number of bytes
+ * @param[out] used: bytes parsed
+ *
+ * @return fw_status_t: FW_ERRORNOMEMORY when stopped at a DATA frame
+ **/
+fw_status_t fw_update_rx ( bsp_fw_update_t * const fw,
+                           const uint8_t   * const data,
+                           uint32_t                len,
+                           uint32_t        * const used  )
+{
+    uint32_t plen;
+    uint32_t i;
+
+    if ( NULL == fw || NULL == used || ( NULL == data && 0U != len ) )
+    {
+        return FW_ERRORPARAMETER;
+    }
+    *used = 0U;
+
+    /******************* 1. Held DATA frame *******************/
+    if ( 0U != fw->frame_held )
+    {
+        if ( FW_OK != __dispatch( fw ) )
+        {
+            return FW_ERRORNOMEMORY;
+        }
+        fw->frame_held = 0U;
+        fw->frame_len  = 0U;
+    }
+
+    for ( i = 0; i < len; ++i )
+    {
+        /************** 2. Sync, length, frame ****************/
+        if ( 0U == fw->frame_len )
+        {
+            if ( FW_SOF0 == data[i] )
+            {
+                fw->frame[fw->frame_len++] = data[i];
+            }
+            continue;
+        }
+        if ( 1U == fw->frame_len )
+        {
+            fw->frame_len = ( FW_SOF1 == data[i] ) ? 2U :
+                            ( FW_SOF0 == data[i] ) ? 1U : 0U;
+            fw->frame[1]  = data[i];
+            continue;
+        }
+        fw->frame[fw->frame_len++] = data[i];
+        if ( fw->frame_len < 5U )
+        {
+            continue;
+        }
+        plen = (uint32_t)fw->frame[3] | ( (uint32_t)fw->frame[4] << 8 );
+        if ( plen > FW_FRAME_MAX_PAYLOAD )
+        {
+            ++fw->bad_frames;
+            fw->frame_len = 0U;
+            continue;
+        }
+        if ( fw->frame_len < plen + FW_FRAME_OVERHEAD )
+        {
+            continue;
+        }
+
+        /****************** 3. CRC, dispatch ******************/
+        if ( crc32_mpeg2_sw( CRC32_MPEG2_INIT, &fw->frame[2], 3U + plen ) !=
+             __get_le32( &fw->frame[5U + plen] ) )
+        {
+            ++fw->bad_frames;
+            fw->frame_len = 0U;
+            continue;
+        }
+        ++fw->frames;
+        if ( FW_OK != __dispatch( fw ) )
+        {
+            fw->frame_held = 1U;
+            *used          = i + 1U;
+            return FW_ERRORNOMEMORY;
+        }
+        fw->frame_len = 0U;
+    }
+    *used = len;
+    return FW_OK;
+}
+
+/**
+ * @brief: One flash step: a block, or the erase of BEGIN, or the check of
+ *         END once the blocks are written
+ * @steps:
+ *      1. The oldest block buffer filled
+ *      2. Else a BEGIN or an END to settle
+ *
+ * @param[in]  fw:   Pointer to a instance of bsp_fw_update_t
+ * @param[out] busy: 1 when a step was done, more may follow
+ *
+ * @return fw_status_t: FW_ERROR on a flash error, the session is over
+ **/
+fw_status_t fw_update_service ( bsp_fw_update_t * const fw,
+                                uint32_t        * const busy )
+{
+    uint32_t idx;
+
+    if ( NULL == fw || NULL == busy )
+    {
+        return FW_ERRORPARAMETER;
+    }
+    *busy = 0U;
+
+    /******************** 1. Block buffer *********************/
+    if ( 0U != fw->block_ready )
+    {
+        *busy = 1U;
+        idx   = ( fw->block_head + FW_BLOCK_BUFFERS - fw->block_ready ) %
+                FW_BLOCK_BUFFERS;
+        if ( FW_OK != __block_write( fw, idx ) )
+        {
+            __fail( fw );
+            return FW_ERROR;
+        }
+        --fw->block_ready;
+        return FW_OK;
+    }
+
+    /******************* 2. BEGIN, END ************************/
+    if ( FW_RX_BEGIN == fw->state )
+    {
+        *busy = 1U;
+        return __begin_settle( fw );
+    }
+    if ( FW_RX_END == fw->state )
+    {
+        *busy = 1U;
+        return __end_settle( fw );
+    }
+    return FW_OK;
+}
+
+/**
+ * @brief: Confirm the running image, the boot loader keeps starting it
+ *
+ * @param[in]  fw: Pointer to a instance of bsp_fw_update_t
+ *
+ * @return fw_status_t: execute result of this function
+ **/
+fw_status_t fw_update_confirm ( bsp_fw_update_t * const fw )
+{
+    if ( NULL == fw || FW_UPDATE_INITED != fw->is_initialized ||
+         FW_SLOT_NONE == fw->running )
+    {
+        return FW_ERRORSOURCE;
+    }
+    if ( FW_OK != fw_mark( &__header( fw, fw->running )->confirmed, FW_MARK,
+                           fw->p_operation_inst ) )
+    {
+        ++fw->flash_errors;
+        return FW_ERROR;
+    }
+    fw->confirmed = 1U;
+    return FW_OK;
+}
+
+//******************************** Defines **********************************//
@@ -0,0 +1,393 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_i2c.h
+ *
+ * @par dependencies
+ * - bsp_osal.h
+ * - bsp_signal.h
+ *
+ * @author Damian
+ *
+ * @brief I2C bus manager: the tasks queue register transactions to the
+ *        devices of one bus, the DMA runs them one after the other, a
+ *        stuck bus is freed, the sensors are sampled from one task.
+ *
+ * Processing flow:
+ *
+ * i2c_bus_inst (hardware operations of the bus)
+ * i2c_submit        -> a transaction, or a chain of them, at the end of the
+ *                      queue; starts it when the bus is idle, returns
+ * i2c_done_isr      -> end of a transaction (done, NACK or bus error): the
+ *                      next one in the queue started from here, then the
+ *                      submitter notified
+ * i2c_transfer      -> i2c_submit and wait for the notification, a chain
+ *                      still queued or running at the timeout is cancelled
+ * i2c_reg_read/write-> one register transaction with i2c_transfer
+ * i2c_batch_read    -> a chain reading a list of registers of one device
+ * i2c_sampler_add   -> a chain run every period_ms by i2c_poll
+ * i2c_poll          -> recovery, the watch of the running transaction and
+ *                      the samplers; from one task, it tells how long that
+ *                      task may sleep
+ *
+ * The queue is the one of bsp_spi: no task owns the bus, there is no bus
+ * mutex, a submit links the transactions inside a short critical section
+ * and the interrupt of the one before starts the next one.
+ *
+ * A transaction is START, the address, reg_len bytes of the register
+ * (MSB first), then the data written, or a repeated START and the data
+ * read; reg_len 0 reads or writes the data alone. A chain (transactions
+ * linked by next) is queued at once, a failed transaction fails the rest
+ * of its chain: a batch is read whole or not at all.
+ *
+ * A NACK fails the chain and the bus goes on. A bus error, a start
+ * refused (the peripheral sees the bus busy) or a transaction running
+ * longer than timeout_ms leaves the bus in an unknown state: the chain
+ * fails and nothing starts until pf_i2c_recover freed the bus in task
+ * context, from i2c_poll or from the next call of the tasks. signal of the
+ * bus wakes the task of i2c_poll for it.
+ *
+ * A sampler is a chain of a sensor, read every period_ms by i2c_poll: the
+ * sensors need no task of their own, their chains are queued by the task
+ * of i2c_poll, which gets pf_sample once a chain ended. A chain still
+ * running when the next period is due is an overrun, that period skipped.
+ *
+ * The transactions and their buffers belong to the bus from i2c_submit
+ * until done is set: static, or on the stack of a task that waits for them.
+ *
+ * The completion interrupts must be masked by the critical section of the
+ * OS (FreeRTOS: at or below configMAX_SYSCALL_INTERRUPT_PRIORITY).
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+#ifndef __BSP_I2C_H__
+#define __BSP_I2C_H__
+
+//******************************** Includes *********************************//
+
+#include "bsp_osal.h"
+#include "bsp_signal.h"
+#include <stdint.h>
+
+//******************************** Includes *********************************//
+
+typedef struct bsp_i2c     bsp_i2c_t;
+typedef struct i2c_xfer    i2c_xfer_t;
+typedef struct i2c_sampler i2c_sampler_t;
+
+//******************************** Defines **********************************//
+
+#define I2C_XFER_MAX_BYTES        0xFFFFU    /* of one DMA transfer (NDTR)  */
+#define I2C_REG_MAX_BYTES         2U         /* register address bytes      */
+#define I2C_TIMEOUT_MS            50U        /* i2c_transfer default, watch */
+#define I2C_SIGNAL_BIT            ( 1UL << 31 ) /* of the register helpers  */
+#define I2C_BATCH_MAX             8U         /* chain of a register helper  */
+#define I2C_POLL_IDLE             0xFFFFFFFFU /* i2c_poll: nothing to wait  */
+
+typedef enum
+{
+    I2C_OK                       = 0,  /* I2C operate successfully           */
+    I2C_ERROR                    = 1,  /* I2C NACK, bus error, chain failed  */
+    I2C_ERRORTIMEOUT             = 2,  /* I2C not done in time, cancelled    */
+    I2C_ERRORSOURCE              = 3,  /* I2C bus not initialized            */
+    I2C_ERRORPARAMETER           = 4,  /* I2C parameter error                */
+    I2C_ERRORNOMEMORY            = 5,  /* I2C transaction already queued     */
+    I2C_ERRORISR                 = 6,  /* I2C not allowed in ISR context     */
+    I2C_RESERVED                 = 0xFF,/* I2C reserved                      */
+} i2c_status_t;
+
+typedef enum
+{
+    I2C_INITED     = 0,  /* i2c bus initialized                              */
+    I2C_NOT_INITED = 1,  /* i2c bus not initialized                          */
+} i2c_init_t;
+
+typedef enum
+{
+    I2C_DIR_WRITE                = 0,  /* register, then the data written    */
+    I2C_DIR_READ                 = 1,  /* register, repeated START, read     */
+} i2c_dir_t;
+
+typedef enum
+{
+    I2C_EVENT_DONE               = 0,  /* transaction complete, STOP sent    */
+    I2C_EVENT_NACK               = 1,  /* address or data NACK, STOP sent    */
+    I2C_EVENT_BUS                = 2,  /* bus error, arbitration lost, DMA   */
+} i2c_event_t;
+
+typedef struct i2c_xfer
+{
+    //****************************** Property *******************************//
+    i2c_xfer_t            * next;                     /* chain, NULL: last   */
+    uint8_t               addr;                       /* 7 bits, unshifted   */
+    i2c_dir_t             dir;                        /* read or write       */
+    uint16_t              reg;                        /* register address    */
+    uint32_t              reg_len;                    /* 0 .. REG_MAX_BYTES  */
+    uint8_t               * data;                     /* read into, written  */
+    uint32_t              len;                        /* bytes, 1 .. MAX     */
+    bsp_signal_t          * signal;                   /* NULL: not notified  */
+    uint32_t              bits;                       /* set on the signal   */
+
+    //************************** Internal status ****************************//
+    i2c_xfer_t            * link;                     /* queue of the bus    */
+    uint32_t              chain_end;                  /* last of its chain   */
+    uint32_t              queued;                     /* 1: the bus owns it  */
+    volatile uint32_t     done;                       /* 1: status is final  */
+    volatile i2c_status_t status;                     /* I2C_OK, ERROR, TIME */
+} i2c_xfer_t;
+
+typedef struct i2c_sampler
+{
+    //****************************** Property *******************************//
+    i2c_xfer_t            * xfer;                     /* chain of the sensor */
+    uint32_t              period_ms;                  /* between two starts  */
+    /* chain ended, from i2c_poll: the data of a I2C_OK chain is the sample */
+    void ( *pf_sample ) ( i2c_sampler_t * const sampler,
+                          i2c_status_t          status );
+    void                  * arg;                      /* of pf_sample        */
+
+    //************************** Internal status ****************************//
+    i2c_sampler_t         * next;                     /* samplers of the bus */
+    i2c_xfer_t            * last;                     /* of the chain        */
+    uint32_t              due_ms;                     /* next start          */
+    uint32_t              armed;                      /* due_ms set          */
+    uint32_t              busy;                       /* chain queued        */
+
+    //***************************** Statistics ******************************//
+    uint32_t              samples;                    /* chains I2C_OK       */
+    uint32_t              errors;                     /* chains failed       */
+    uint32_t              overruns;                   /* periods skipped     */
+} i2c_sampler_t;
+
+typedef struct
+{
+    /* START, address, register, data written or read; its end calls
+       i2c_done_isr. Called from i2c_done_isr and inside the critical
+       section: sets the transfer going and returns, never waits on the
+       bus or the tick; I2C_ERROR when the bus is busy                       */
+    i2c_status_t ( *pf_i2c_start )   ( uint8_t          addr,
+                                       uint16_t         reg,
+                                       uint32_t         reg_len,
+                                       i2c_dir_t        dir,
+                                       uint8_t  * const data,
+                                       uint32_t         len      );
+    /* abort the transaction running, no i2c_done_isr after it; inside
+       the critical section, never waits                                     */
+    i2c_status_t ( *pf_i2c_abort )   ( void );
+    /* free the bus: SCL pulsed until SDA is high, a STOP, the peripheral
+       reset and set up again; task context                                */
+    i2c_status_t ( *pf_i2c_recover ) ( void );
+} i2c_hw_operation_t;
+
+typedef struct bsp_i2c
+{
+    //************************** Internal status ****************************//
+    i2c_init_t            is_initialized;             /* record init status  */
+    i2c_xfer_t            * volatile head;            /* running, or NULL    */
+    i2c_xfer_t            * tail;                     /* last queued         */
+    volatile uint32_t     recover;                    /* bus to be freed     */
+    i2c_sampler_t         * samplers;                 /* of i2c_poll         */
+    const i2c_xfer_t      * watch;                    /* head seen by poll   */
+    uint32_t              watch_ends;                 /* ends seen with it   */
+    uint32_t              watch_ms;                   /* seen first at       */
+
+    //****************************** Property *******************************//
+    uint32_t              timeout_ms;                 /* longest transaction */
+    bsp_signal_t          * signal;                   /* task of i2c_poll    */
+    uint32_t              sig_bits;                   /* set on the signal   */
+
+    //***************************** Statistics ******************************//
+    uint32_t              xfers;                      /* completed           */
+    uint32_t              bytes;                      /* of the completed    */
+    uint32_t              chained;                    /* started from the ISR*/
+    uint32_t              errors;                     /* failed, cancelled   */
+    uint32_t              nacks;                      /* NACK events         */
+    uint32_t              timeouts;                   /* aborted by the watch*/
+    uint32_t              recoveries;                 /* pf_i2c_recover runs */
+
+    //************************ Interface from core **************************//
+    i2c_hw_operation_t    * p_hw_operation_inst;      /* the bus             */
+
+    //************************ Interface from RTOS **************************//
+    os_critical_t         * p_os_critical;          /* os critical interface */
+
+} bsp_i2c_t;
+
+//******************************** Defines **********************************//
+
+//******************************* Declaring *********************************//
+
+/**
+ * @brief: Instantiate a bsp_i2c_t
+ * @steps:
+ *      1. Adding the hardware and OS interfaces into the instance
+ *      2. Empty queue, no sampler, timeout_ms I2C_TIMEOUT_MS, no signal
+ *
+ * @param[in]  i2c:         Pointer to a instance of bsp_i2c_t
+ * @param[in]  hw_ops:      Pointer to a instance of i2c_hw_operation_t
+ * @param[in]  os_critical: Pointer to a instance of os_critical_t
+ *
+ * @return i2c_status_t: execute result of this function
+ **/
+i2c_status_t i2c_bus_inst (
+                            bsp_i2c_t          * const i2c,
+                            i2c_hw_operation_t * const hw_ops,
+                            os_critical_t      * const os_critical
+                                                                   );
+
+/**
+ * @brief: Queue a transaction or a chain of them, task context, returns
+ *         at once
+ * @steps:
+ *      1. Check the chain: address, register, length, not queued already
+ *      2. Link it behind the last queued transaction, or start it when idle
+ *      3. A bus to be freed: free it, then start the queue
+ *
+ * @param[in]  i2c:  Pointer to a instance of bsp_i2c_t
+ * @param[in]  xfer: first transaction of the chain
+ *
+ * @return i2c_status_t: execute result of this function
+ **/
+i2c_status_t i2c_submit ( bsp_i2c_t * const i2c, i2c_xfer_t * const xfer );
+
+/**
+ * @brief: Queue a chain and wait for its last transaction, task context
+ * @steps:
+ *      1. i2c_submit
+ *      2. Wait for the signal of the last transaction
+ *      3. Timeout: cancel the chain, or take it when it just ended
+ *
+ * @param[in]  i2c:        Pointer to a instance of bsp_i2c_t
+ * @param[in]  xfer:       first transaction of the chain, the last one
+ *                         with a signal owned by the calling task
+ * @param[in]  timeout_ms: max wait for the whole chain
+ *
+ * @return i2c_status_t: status of the chain
+ **/
+i2c_status_t i2c_transfer ( bsp_i2c_t  * const i2c,
+                            i2c_xfer_t * const xfer,
+                            uint32_t           timeout_ms );
+
+/**
+ * @brief: Take a queued chain back before it ran, or abort it running; a
+ *         chain aborted leaves the bus to be freed, freed from here
+ *
+ * @param[in]  i2c:  Pointer to a instance of bsp_i2c_t
+ * @param[in]  xfer: first transaction of the chain
+ *
+ * @return i2c_status_t: I2C_OK when cancelled, I2C_ERRORSOURCE when it had
+ *                       ended already, its status is final
+ **/
+i2c_status_t i2c_cancel ( bsp_i2c_t * const i2c, i2c_xfer_t * const xfer );
+
+/**
+ * @brief: Read registers of a device, from reg on, task context
+ *
+ * @param[in]  i2c:    Pointer to a instance of bsp_i2c_t
+ * @param[in]  signal: signal owned by the calling task, I2C_SIGNAL_BIT
+ * @param[in]  addr:   7 bits address of the device
+ * @param[in]  reg:    first register, 8 bits
+ * @param[out] data:   len bytes, the registers from reg on
+ * @param[in]  len:    bytes, more than one needs register auto-increment
+ *
+ * @return i2c_status_t: status of the transaction
+ **/
+i2c_status_t i2c_reg_read ( bsp_i2c_t    * const i2c,
+                            bsp_signal_t * const signal,
+                            uint8_t              addr,
+                            uint8_t              reg,
+                            uint8_t      * const data,
+                            uint32_t             len     );
+
+/**
+ * @brief: Write registers of a device, from reg on, task context
+ *
+ * @param[in]  i2c:    Pointer to a instance of bsp_i2c_t
+ * @param[in]  signal: signal owned by the calling task, I2C_SIGNAL_BIT
+ * @param[in]  addr:   7 bits address of the device
+ * @param[in]  reg:    first register, 8 bits
+ * @param[in]  data:   len bytes, written from reg on
+ * @param[in]  len:    bytes, more than one needs register auto-increment
+ *
+ * @return i2c_status_t: status of the transaction
+ **/
+i2c_status_t i2c_reg_write ( bsp_i2c_t     * const i2c,
+                             bsp_signal_t  * const signal,
+                             uint8_t               addr,
+                             uint8_t               reg,
+                             const uint8_t * const data,
+                             uint32_t              len     );
+
+/**
+ * @brief: Build a chain reading a list of registers of one device
+ * @steps:
+ *      1. Registers following each other in the list and in the device
+ *         merged into one transaction, read by register auto-increment
+ *      2. The transactions linked by next, the last one NULL
+ *
+ * @param[in]  xfer: room for the chain
+ * @param[in]  max:  transactions in xfer
+ * @param[in]  addr: 7 bits address of the device
+ * @param[in]  regs: num registers, 8 bits
+ * @param[out] data: num bytes, data[i] read from regs[i]
+ * @param[in]  num:  registers in the list
+ * @param[out] used: transactions of the chain
+ *
+ * @return i2c_status_t: I2C_ERRORNOMEMORY when max is too small
+ **/
+i2c_status_t i2c_batch_read ( i2c_xfer_t    * const xfer,
+                              uint32_t              max,
+                              uint8_t               addr,
+                              const uint8_t * const regs,
+                              uint8_t       * const data,
+                              uint32_t              num,
+                              uint32_t      * const used );
+
+/**
+ * @brief: Add a sampler to the ones of i2c_poll, task context
+ * @steps:
+ *      1. Check the sampler: chain, period, callback
+ *      2. Its last transaction notifies the task of i2c_poll
+ *      3. Linked to the samplers of the bus, first start at the next poll
+ *
+ * @param[in]  i2c:     Pointer to a instance of bsp_i2c_t
+ * @param[in]  sampler: xfer, period_ms, pf_sample and arg set
+ *
+ * @return i2c_status_t: execute result of this function
+ **/
+i2c_status_t i2c_sampler_add ( bsp_i2c_t     * const i2c,
+                               i2c_sampler_t * const sampler );
+
+/**
+ * @brief: Service of the bus, from one task, when signal of the bus is set
+ *         and when the time it returns has passed
+ * @steps:
+ *      1. A bus to be freed: free it, start the queue again
+ *      2. Watch: a transaction running for timeout_ms is aborted, its
+ *         chain fails with I2C_ERRORTIMEOUT, the bus is freed
+ *      3. Samplers: pf_sample for the chains ended, the ones due queued
+ *
+ * @param[in]  i2c:    Pointer to a instance of bsp_i2c_t
+ * @param[in]  now_ms: time in ms, wraps
+ *
+ * @return uint32_t: ms until the next call is needed, I2C_POLL_IDLE when
+ *                   only signal of the bus calls for one
+ **/
+uint32_t i2c_poll ( bsp_i2c_t * const i2c, uint32_t now_ms );
+
+/**
+ * @brief: End of a transaction, from its complete or error callback
+ *
+ * @param[in]  i2c:   Pointer to a instance of bsp_i2c_t
+ * @param[in]  event: done, NACK, or a bus error
+ **/
+void i2c_done_isr ( bsp_i2c_t * const i2c, i2c_event_t event );
+
+//******************************* Declaring *********************************//
+#endif // __BSP_I2C_H__
@@ -0,0 +1,921 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_i2c.c
+ *
+ * @par dependencies
+ * - bsp_i2c.h
+ * - bsp_common.h
+ *
+ * @author Damian
+ *
+ * @brief I2C bus manager: the tasks queue register transactions to the
+ *        devices of one bus, the DMA runs them one after the other, a
+ *        stuck bus is freed, the sensors are sampled from one task.
+ *
+ * Processing flow:
+ *
+ * Call directly.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+//******************************** Includes *********************************//
+
+#include "bsp_i2c.h"
+#include "bsp_common.h"
+
+#ifndef BENCH_HOST_POSIX
+#include "main.h"
+#endif /* BENCH_HOST_POSIX */
+
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+BSP_STATUS_CHECK( I2C );
+
+#define I2C_ADDR_MAX              0x7FU      /* 7 bits addresses            */
+
+typedef enum
+{
+    I2C_NOTIFY_NONE = 0,                /* cancelled, the caller knows       */
+    I2C_NOTIFY_TASK = 1,                /* from the tasks                    */
+    I2C_NOTIFY_ISR  = 2,                /* from i2c_done_isr                 */
+} i2c_notify_t;
+
+typedef enum
+{
+    I2C_RECOVER_NONE    = 0,            /* bus free, the queue runs          */
+    I2C_RECOVER_PENDING = 1,            /* bus to be freed, nothing starts   */
+    I2C_RECOVER_RUNNING = 2,            /* pf_i2c_recover called by a task   */
+} i2c_recover_t;
+
+/**
+ * @brief: Checking the bus can be used from here
+ *
+ * @param[in]  i2c: Pointer to a instance of bsp_i2c_t
+ * @param[in]  obj: the transaction or sampler
+ *
+ * @return i2c_status_t: I2C_OK when it can
+ **/
+static i2c_status_t __ready ( const bsp_i2c_t * const i2c,
+                              const void      * const obj )
+{
+    if ( NULL == i2c || NULL == obj )
+    {
+        LOG( LOG_LEVEL_ERR, "Input parameter is null" );
+        return I2C_ERRORPARAMETER;
+    }
+    else if ( I2C_INITED != i2c->is_initialized )
+    {
+        LOG( LOG_LEVEL_ERR, "I2C bus not initialized" );
+        return I2C_ERRORSOURCE;
+    }
+#ifndef BENCH_HOST_POSIX
+    else if ( 0U != __get_IPSR() )
+    {
+        return I2C_ERRORISR;
+    }
+#endif /* BENCH_HOST_POSIX */
+    return I2C_OK;
+}
+
+/**
+ * @brief: Wake the task of i2c_poll, the bus is to be freed
+ *
+ * @param[in]  i2c:    Pointer to a instance of bsp_i2c_t
+ * @param[in]  notify: context of the notification
+ **/
+static void __wake ( bsp_i2c_t * const i2c, i2c_notify_t notify )
+{
+    if ( NULL == i2c->signal || 0U == i2c->sig_bits )
+    {
+        return;
+    }
+    if ( I2C_NOTIFY_ISR == notify )
+    {
+        signal_set_isr( i2c->signal, i2c->sig_bits );
+    }
+    else
+    {
+        signal_set( i2c->signal, i2c->sig_bits );
+    }
+}
+
+/**
+ * @brief: Take transactions off the head of the queue, up to the end of the
+ *         chain of the first one, or that first one only
+ *
+ * @param[in]  i2c:   Pointer to a instance of bsp_i2c_t
+ * @param[in]  chain: 1: the whole chain, 0: one transaction
+ *
+ * @return i2c_xfer_t *: the first one taken, linked to the others by link
+ **/
+static i2c_xfer_t * __detach ( bsp_i2c_t * const i2c, uint32_t chain )
+{
+    i2c_xfer_t * first = i2c->head;
+    i2c_xfer_t * last  = first;
+
+    while ( 0U != chain && 0U == last->chain_end && NULL != last->link )
+    {
+        last = last->link;
+    }
+    i2c->head  = last->link;
+    last->link = NULL;
+    if ( NULL == i2c->head )
+    {
+        i2c->tail = NULL;
+    }
+    return first;
+}
+
+/**
+ * @brief: Final status of detached transactions, the submitters notified
+ *
+ * @param[in]  i2c:    Pointer to a instance of bsp_i2c_t
+ * @param[in]  xfer:   the first one, linked to the others by link
+ * @param[in]  status: I2C_OK, or the failure of all of them
+ * @param[in]  notify: context of the notification, or none
+ **/
+static void __finish ( bsp_i2c_t    * const i2c,
+                       i2c_xfer_t   *       xfer,
+                       i2c_status_t         status,
+                       i2c_notify_t         notify )
+{
+    i2c_xfer_t   * next;
+    bsp_signal_t * signal;
+    uint32_t       bits;
+
+    for ( ; NULL != xfer; xfer = next )
+    {
+        // the submitter may reuse it once done is set: read it all before
+        next         = xfer->link;
+        signal       = xfer->signal;
+        bits         = xfer->bits;
+        xfer->link   = NULL;
+        xfer->queued = 0U;
+        if ( I2C_OK == status )
+        {
+            i2c->xfers++;
+            i2c->bytes += xfer->len;
+        }
+        else
+        {
+            i2c->errors++;
+        }
+        xfer->status = status;
+        xfer->done   = 1U;
+
+        if ( NULL == signal || I2C_NOTIFY_NONE == notify )
+        {
+            continue;
+        }
+        if ( I2C_NOTIFY_ISR == notify )
+        {
+            signal_set_isr( signal, bits );
+        }
+        else
+        {
+            signal_set( signal, bits );
+        }
+    }
+}
+
+/**
+ * @brief: Start the transaction at the head of the queue
+ * @steps:
+ *      1. Bus to be freed: nothing starts
+ *      2. Start the DMA transaction
+ *      3. Refused: the peripheral sees the bus busy, or it is stuck; fail
+ *         the chain, the bus is to be freed
+ *
+ * @param[in]  i2c:    Pointer to a instance of bsp_i2c_t
+ * @param[in]  notify: context, for the chain failing here
+ **/
+static void __run ( bsp_i2c_t * const i2c, i2c_notify_t notify )
+{
+    i2c_xfer_t * xfer = i2c->head;
+
+    /******************** 1. Bus to be freed **************/
+    if ( NULL == xfer || I2C_RECOVER_NONE != i2c->recover )
+    {
+        return;
+    }
+
+    /******************** 2. Start ************************/
+    if ( I2C_OK == i2c->p_hw_operation_inst->pf_i2c_start( xfer->addr,
+                                                           xfer->reg,
+                                                           xfer->reg_len,
+                                                           xfer->dir,
+                                                           xfer->data,
+                                                           xfer->len ) )
+    {
+        return;
+    }
+
+    /******************** 3. Refused **********************/
+    i2c->recover = I2C_RECOVER_PENDING;
+    __finish( i2c, __detach( i2c, 1U ), I2C_ERROR, notify );
+    __wake( i2c, notify );
+}
+
+/**
+ * @brief: Free the bus when it is to be freed, then start the queue again;
+ *         task context, outside of the critical section
+ * @steps:
+ *      1. Take the recovery, another task may be running it
+ *      2. pf_i2c_recover
+ *      3. Start the head of the queue
+ *
+ * @param[in]  i2c: Pointer to a instance of bsp_i2c_t
+ **/
+static void __recover ( bsp_i2c_t * const i2c )
+{
+    /******************** 1. Take it **********************/
+    i2c->p_os_critical->pf_os_critical_enter();
+    if ( I2C_RECOVER_PENDING != i2c->recover )
+    {
+        i2c->p_os_critical->pf_os_critical_exit();
+        return;
+    }
+    i2c->recover = I2C_RECOVER_RUNNING;
+    i2c->p_os_critical->pf_os_critical_exit();
+
+    /******************** 2. Free the bus *****************/
+    // SCL pulses and a STOP, some 100 us: the queue waits, not the ISRs
+    if ( I2C_OK != i2c->p_hw_operation_inst->pf_i2c_recover() )
+    {
+        LOG( LOG_LEVEL_WARN, "I2C bus recovery failed" );
+    }
+
+    /******************** 3. Start again ******************/
+    i2c->p_os_critical->pf_os_critical_enter();
+    i2c->recoveries++;
+    i2c->recover = I2C_RECOVER_NONE;
+    i2c->watch   = NULL;
+    __run( i2c, I2C_NOTIFY_TASK );
+    i2c->p_os_critical->pf_os_critical_exit();
+}
+
+/**
+ * @brief: Instantiate a bsp_i2c_t
+ * @steps:
+ *      1. Adding the hardware and OS interfaces into the instance
+ *      2. Empty queue, no sampler, timeout_ms I2C_TIMEOUT_MS, no signal
+ *
+ * @param[in]  i2c:         Pointer to a instance of bsp_i2c_t
+ * @param[in]  hw_ops:      Pointer to a instance of i2c_hw_operation_t
+ * @param[in]  os_critical: Pointer to a instance of os_critical_t
+ *
+ * @return i2c_status_t: execute result of this function
+ **/
+i2c_status_t i2c_bus_inst (
+                            bsp_i2c_t          * const i2c,
+                            i2c_hw_operation_t * const hw_ops,
+                            os_critical_t      * const os_critical
+                                                                   )
+{
+    /********** 1. Checking the input parameters **********/
+    if ( NULL == i2c                                 ||
+         NULL == hw_ops                              ||
+         NULL == hw_ops->pf_i2c_start                ||
+         NULL == hw_ops->pf_i2c_abort                ||
+         NULL == hw_ops->pf_i2c_recover              ||
+         NULL == os_critical                         ||
+         NULL == os_critical->pf_os_critical_enter   ||
+         NULL == os_critical->pf_os_critical_exit )
+    {
+        LOG( LOG_LEVEL_ERR, "Input parameter is null" );
+        return I2C_ERRORPARAMETER;
+    }
+
+    /************** 2. Checking the resource **************/
+    if ( I2C_INITED == i2c->is_initialized )
+    {
+        LOG( LOG_LEVEL_WARN, "I2C bus already initialized" );
+        return I2C_ERRORSOURCE;
+    }
+
+    /************** 3. Adding the interfaces **************/
+    // 3.1 mount external interfaces
+    i2c->p_hw_operation_inst = hw_ops;
+    i2c->p_os_critical       = os_critical;
+
+    /************* 4. Initialize the instance *************/
+    i2c->head       = NULL;
+    i2c->tail       = NULL;
+    i2c->recover    = I2C_RECOVER_NONE;
+    i2c->samplers   = NULL;
+    i2c->watch      = NULL;
+    i2c->watch_ends = 0U;
+    i2c->watch_ms   = 0U;
+    i2c->timeout_ms = I2C_TIMEOUT_MS;
+    i2c->signal     = NULL;
+    i2c->sig_bits   = 0U;
+    i2c->xfers      = 0U;
+    i2c->bytes      = 0U;
+    i2c->chained    = 0U;
+    i2c->errors     = 0U;
+    i2c->nacks      = 0U;
+    i2c->timeouts   = 0U;
+    i2c->recoveries = 0U;
+
+    i2c->is_initialized = I2C_INITED;
+    return I2C_OK;
+}
+
+/**
+ * @brief: Queue a transaction or a chain of them, task context, returns
+ *         at once
+ * @steps:
+ *      1. Check the chain: address, register, length, not queued already
+ *      2. Link it behind the last queued transaction, or start it when idle
+ *      3. A bus to be freed: free it, then start the queue
+ *
+ * @param[in]  i2c:  Pointer to a instance of bsp_i2c_t
+ * @param[in]  xfer: first transaction of the chain
+ *
+ * @return i2c_status_t: execute result of this function
+ **/
+i2c_status_t i2c_submit ( bsp_i2c_t * const i2c, i2c_xfer_t * const xfer )
+{
+    i2c_xfer_t   * last = NULL;
+    i2c_status_t   ret  = __ready( i2c, xfer );
+
+    if ( I2C_OK != ret )
+    {
+        return ret;
+    }
+
+    /********** 1. Checking the input parameters **********/
+    for ( i2c_xfer_t * x = xfer; NULL != x; x = x->next )
+    {
+        if ( I2C_ADDR_MAX < x->addr || I2C_REG_MAX_BYTES < x->reg_len ||
+             NULL == x->data || 0U == x->len || I2C_XFER_MAX_BYTES < x->len )
+        {
+            LOG( LOG_LEVEL_ERR, "I2C transaction invalid" );
+            return I2C_ERRORPARAMETER;
+        }
+    }
+
+    /******************* 2. Queue it **********************/
+    i2c->p_os_critical->pf_os_critical_enter();
+    for ( i2c_xfer_t * x = xfer; NULL != x; x = x->next )
+    {
+        if ( 0U != x->queued )
+        {
+            i2c->p_os_critical->pf_os_critical_exit();
+            LOG( LOG_LEVEL_ERR, "I2C transaction already queued" );
+            return I2C_ERRORNOMEMORY;
+        }
+    }
+    for ( i2c_xfer_t * x = xfer; NULL != x; x = x->next )
+    {
+        x->link      = x->next;
+        x->chain_end = ( NULL == x->next ) ? 1U : 0U;
+        x->queued    = 1U;
+        x->done      = 0U;
+        x->status    = I2C_RESERVED;
+        last         = x;
+    }
+    if ( NULL != i2c->tail )
+    {
+        // running: the interrupt of the one before starts it
+        i2c->tail->link = xfer;
+        i2c->tail       = last;
+    }
+    else
+    {
+        i2c->head = xfer;
+        i2c->tail = last;
+        __run( i2c, I2C_NOTIFY_TASK );
+    }
+    i2c->p_os_critical->pf_os_critical_exit();
+
+    /******************* 3. Bus to be freed ***************/
+    __recover( i2c );
+    return I2C_OK;
+}
+
+/**
+ * @brief: Queue a chain and wait for its last transaction, task context
+ * @steps:
+ *      1. i2c_submit
+ *      2. Wait for the signal of the last transaction
+ *      3. Timeout: cancel the chain, or take it when it just ended
+ *
+ * @param[in]  i2c:        Pointer to a instance of bsp_i2c_t
+ * @param[in]  xfer:       first transaction of the chain, the last one
+ *                         with a signal owned by the calling task
+ * @param[in]  timeout_ms: max wait for the whole chain
+ *
+ * @return i2c_status_t: status of the chain
+ **/
+i2c_status_t i2c_transfer ( bsp_i2c_t  * const i2c,
+                            i2c_xfer_t * const xfer,
+                            uint32_t           timeout_ms )
+{
+    i2c_xfer_t   * last = xfer;
+    uint32_t       bits = 0U;
+    i2c_status_t   ret;
+
+    if ( NULL == xfer )
+    {
+        LOG( LOG_LEVEL_ERR, "Input parameter is null" );
+        return I2C_ERRORPARAMETER;
+    }
+    while ( NULL != last->next )
+    {
+        last = last->next;
+    }
+    if ( NULL == last->signal || 0U == last->bits )
+    {
+        LOG( LOG_LEVEL_ERR, "I2C chain without a signal" );
+        return I2C_ERRORPARAMETER;
+    }
+
+    /********************* 1. Submit **********************/
+    ret = i2c_submit( i2c, xfer );
+    if ( I2C_OK != ret )
+    {
+        return ret;
+    }
+
+    /********************* 2. Wait ************************/
+    // a failed transaction fails the rest: the last one carries the result
+    if ( SIGNAL_OK == signal_wait( last->signal, last->bits, timeout_ms,
+                                   &bits ) )
+    {
+        // a bus error of this chain: free the bus for the ones behind it
+        __recover( i2c );
+        return last->status;
+    }
+
+    /********************* 3. Timeout *********************/
+    if ( I2C_OK == i2c_cancel( i2c, xfer ) )
+    {
+        LOG( LOG_LEVEL_ERR, "I2C transaction timeout" );
+        return I2C_ERRORTIMEOUT;
+    }
+    // ended right at the timeout: its bit is set, take it
+    signal_wait( last->signal, last->bits, 0U, &bits );
+    return last->status;
+}
+
+/**
+ * @brief: Take a queued chain back before it ran, or abort it running; a
+ *         chain aborted leaves the bus to be freed, freed from here
+ * @steps:
+ *      1. First transaction of the chain still queued, none: it ended
+ *      2. Running: abort it, the bus is to be freed; at the head while the
+ *         bus is to be freed: not started, taken off
+ *      3. Waiting: unlink it from the queue
+ *      4. Free the bus, start the next chain
+ *
+ * @param[in]  i2c:  Pointer to a instance of bsp_i2c_t
+ * @param[in]  xfer: first transaction of the chain
+ *
+ * @return i2c_status_t: I2C_OK when cancelled, I2C_ERRORSOURCE when it had
+ *                       ended already, its status is final
+ **/
+i2c_status_t i2c_cancel ( bsp_i2c_t * const i2c, i2c_xfer_t * const xfer )
+{
+    i2c_xfer_t   * first = xfer;
+    i2c_xfer_t   * last;
+    i2c_xfer_t   * prev;
+    i2c_status_t   ret   = __ready( i2c, xfer );
+
+    if ( I2C_OK != ret )
+    {
+        return ret;
+    }
+
+    i2c->p_os_critical->pf_os_critical_enter();
+
+    /***************** 1. Still queued ********************/
+    while ( NULL != first && 0U == first->queued )
+    {
+        first = first->next;
+    }
+    if ( NULL == first )
+    {
+        i2c->p_os_critical->pf_os_critical_exit();
+        return I2C_ERRORSOURCE;
+    }
+
+    /***************** 2. Running *************************/
+    if ( i2c->head == first )
+    {
+        if ( I2C_RECOVER_NONE == i2c->recover )
+        {
+            // stopped in the middle of a byte: a device may hold SDA low
+            i2c->p_hw_operation_inst->pf_i2c_abort();
+            i2c->recover = I2C_RECOVER_PENDING;
+        }
+        __finish( i2c, __detach( i2c, 1U ), I2C_ERROR, I2C_NOTIFY_NONE );
+    }
+
+    /***************** 3. Waiting *************************/
+    // a chain runs from its head to its end: none of it ran yet
+    else
+    {
+        for ( prev = i2c->head; NULL != prev && prev->link != first;
+              prev = prev->link )
+        {
+        }
+        for ( last = first; 0U == last->chain_end && NULL != last->link;
+              last = last->link )
+        {
+        }
+        if ( NULL != prev )
+        {
+            prev->link = last->link;
+            if ( i2c->tail == last )
+            {
+                i2c->tail = prev;
+            }
+            last->link = NULL;
+            __finish( i2c, first, I2C_ERROR, I2C_NOTIFY_NONE );
+        }
+    }
+    i2c->p_os_critical->pf_os_critical_exit();
+
+    /***************** 4. Free the bus ********************/
+    __recover( i2c );
+    return I2C_OK;
+}
+
+/**
+ * @brief: Read registers of a device, from reg on, task context
+ *
+ * @param[in]  i2c:    Pointer to a instance of bsp_i2c_t
+ * @param[in]  signal: signal owned by the calling task, I2C_SIGNAL_BIT
+ * @param[in]  addr:   7 bits address of the device
+ * @param[in]  reg:    first register, 8 bits
+ * @param[out] data:   len bytes, the registers from reg on
+ * @param[in]  len:    bytes, more than one needs register auto-increment
+ *
+ * @return i2c_status_t: status of the transaction
+ **/
+i2c_status_t i2c_reg_read ( bsp_i2c_t    * const i2c,
+                            bsp_signal_t * const signal,
+                            uint8_t              addr,
+                            uint8_t              reg,
+                            uint8_t      * const data,
+                            uint32_t             len     )
+{
+    // on the stack: i2c_transfer returns once the bus gave it back
+    i2c_xfer_t xfer = {
+        .next    = NULL,
+        .addr    = addr,
+        .dir     = I2C_DIR_READ,
+        .reg     = reg,
+        .reg_len = 1U,
+        .data    = data,
+        .len     = len,
+        .signal  = signal,
+        .bits    = I2C_SIGNAL_BIT,
+    };
+
+    return i2c_transfer( i2c, &xfer, I2C_TIMEOUT_MS );
+}
+
+/**
+ * @brief: Write registers of a device, from reg on, task context
+ *
+ * @param[in]  i2c:    Pointer to a instance of bsp_i2c_t
+ * @param[in]  signal: signal owned by the calling task, I2C_SIGNAL_BIT
+ * @param[in]  addr:   7 bits address of the device
+ * @param[in]  reg:    first register, 8 bits
+ * @param[in]  data:   len bytes, written from reg on
+ * @param[in]  len:    bytes, more than one needs register auto-increment
+ *
+ * @return i2c_status_t: status of the transaction
+ **/
+i2c_status_t i2c_reg_write ( bsp_i2c_t     * const i2c,
+                             bsp_signal_t  * const signal,
+                             uint8_t               addr,
+                             uint8_t               reg,
+                             const uint8_t * const data,
+                             uint32_t              len     )
+{
+    // the DMA only reads the data of a write
+    i2c_xfer_t xfer = {
+        .next    = NULL,
+        .addr    = addr,
+        .dir     = I2C_DIR_WRITE,
+        .reg     = reg,
+        .reg_len = 1U,
+        .data    = (uint8_t *)data,
+        .len     = len,
+        .signal  = signal,
+        .bits    = I2C_SIGNAL_BIT,
+    };
+
+    return i2c_transfer( i2c, &xfer, I2C_TIMEOUT_MS );
+}
+
+/**
+ * @brief: Build a chain reading a list of registers of one device
+ * @steps:
+ *      1. Registers following each other in the list and in the device
+ *         merged into one transaction, read by register auto-increment
+ *      2. The transactions linked by next, the last one NULL
+ *
+ * @param[in]  xfer: room for the chain, none of it queued
+ * @param[in]  max:  transactions in xfer
+ * @param[in]  addr: 7 bits address of the device
+ * @param[in]  regs: num registers, 8 bits
+ * @param[out] data: num bytes, data[i] read from regs[i]
+ * @param[in]  num:  registers in the list
+ * @param[out] used: transactions of the chain
+ *
+ * @return i2c_status_t: I2C_ERRORNOMEMORY when max is too small
+ **/
+i2c_status_t i2c_batch_read ( i2c_xfer_t    * const xfer,
+                              uint32_t              max,
+                              uint8_t               addr,
+                              const uint8_t * const regs,
+                              uint8_t       * const data,
+                              uint32_t              num,
+                              uint32_t      * const used )
+{
+    i2c_xfer_t * x = NULL;
+    uint32_t     n = 0U;
+
+    /********** 1. Checking the input parameters **********/
+    if ( NULL == xfer || NULL == regs || NULL == data || NULL == used )
+    {
+        LOG( LOG_LEVEL_ERR, "Input parameter is null" );
+        return I2C_ERRORPARAMETER;
+    }
+    if ( 0U == num || I2C_ADDR_MAX < addr )
+    {
+        return I2C_ERRORPARAMETER;
+    }
+
+    /*************** 2. Merge and link ********************/
+    for ( uint32_t i = 0; i < num; ++i )
+    {
+        // one START, address and register for the whole run; 0xFF ends it
+        if ( NULL != x && (uint32_t)regs[i] == regs[i - 1U] + 1U )
+        {
+            x->len++;
+            continue;
+        }
+        if ( max == n )
+        {
+            return I2C_ERRORNOMEMORY;
+        }
+        if ( NULL != x )
+        {
+            x->next = &xfer[n];
+        }
+        x          = &xfer[n++];
+        x->next    = NULL;
+        x->addr    = addr;
+        x->dir     = I2C_DIR_READ;
+        x->reg     = regs[i];
+        x->reg_len = 1U;
+        x->data    = &data[i];
+        x->len     = 1U;
+        x->signal  = NULL;
+        x->bits    = 0U;
+        x->link    = NULL;
+        x->queued  = 0U;
+    }
+    *used = n;
+    return I2C_OK;
+}
+
+/**
+ * @brief: Add a sampler to the ones of i2c_poll, task context
+ * @steps:
+ *      1. Check the sampler: chain, period, callback
+ *      2. Its last transaction notifies the task of i2c_poll
+ *      3. Linked to the samplers of the bus, first start at the next poll
+ *
+ * @param[in]  i2c:     Pointer to a instance of bsp_i2c_t
+ * @param[in]  sampler: xfer, period_ms, pf_sample and arg set
+ *
+ * @return i2c_status_t: execute result of this function
+ **/
+i2c_status_t i2c_sampler_add ( bsp_i2c_t     * const i2c,
+                               i2c_sampler_t * const sampler )
+{
+    i2c_xfer_t   * last;
+    i2c_status_t   ret = __ready( i2c, sampler );
+
+    if ( I2C_OK != ret )
+    {
+        return ret;
+    }
+
+    /********** 1. Checking the input parameters **********/
+    if ( NULL == sampler->xfer || 0U == sampler->period_ms ||
+         NULL == sampler->pf_sample )
+    {
+        LOG( LOG_LEVEL_ERR, "I2C sampler invalid" );
+        return I2C_ERRORPARAMETER;
+    }
+    for ( i2c_sampler_t * s = i2c->samplers; NULL != s; s = s->next )
+    {
+        if ( sampler == s )
+        {
+            return I2C_ERRORNOMEMORY;
+        }
+    }
+
+    /*************** 2. Notify the poll task **************/
+    for ( last = sampler->xfer; NULL != last->next; last = last->next )
+    {
+    }
+    last->signal      = i2c->signal;
+    last->bits        = i2c->sig_bits;
+    sampler->last     = last;
+    sampler->due_ms   = 0U;
+    sampler->armed    = 0U;
+    sampler->busy     = 0U;
+    sampler->samples  = 0U;
+    sampler->errors   = 0U;
+    sampler->overruns = 0U;
+
+    /*************** 3. Link it ***************************/
+    i2c->p_os_critical->pf_os_critical_enter();
+    sampler->next = i2c->samplers;
+    i2c->samplers = sampler;
+    i2c->p_os_critical->pf_os_critical_exit();
+    __wake( i2c, I2C_NOTIFY_TASK );
+    return I2C_OK;
+}
+
+/**
+ * @brief: Service of the bus, from one task, when signal of the bus is set
+ *         and when the time it returns has passed
+ * @steps:
+ *      1. A bus to be freed: free it, start the queue again
+ *      2. Samplers: pf_sample for the chains ended, the ones due queued
+ *      3. Watch: a transaction running for timeout_ms is aborted, its
+ *         chain fails with I2C_ERRORTIMEOUT, the bus is freed
+ *
+ * @param[in]  i2c:    Pointer to a instance of bsp_i2c_t
+ * @param[in]  now_ms: time in ms, wraps
+ *
+ * @return uint32_t: ms until the next call is needed, I2C_POLL_IDLE when
+ *                   only signal of the bus calls for one
+ **/
+uint32_t i2c_poll ( bsp_i2c_t * const i2c, uint32_t now_ms )
+{
+    uint32_t     wait = I2C_POLL_IDLE;
+    uint32_t     left;
+    uint32_t     ends;
+    i2c_status_t status;
+
+    if ( NULL == i2c || I2C_INITED != i2c->is_initialized )
+    {
+        LOG( LOG_LEVEL_ERR, "I2C bus not initialized" );
+        return I2C_POLL_IDLE;
+    }
+
+    /***************** 1. Bus to be freed *****************/
+    __recover( i2c );
+
+    /***************** 2. Samplers ************************/
+    for ( i2c_sampler_t * s = i2c->samplers; NULL != s; s = s->next )
+    {
+        if ( 0U != s->busy && 0U != s->last->done )
+        {
+            s->busy = 0U;
+            status  = s->last->status;
+            if ( I2C_OK == status )
+            {
+                s->samples++;
+            }
+            else
+            {
+                s->errors++;
+            }
+            s->pf_sample( s, status );
+        }
+        if ( 0U == s->armed )
+        {
+            s->due_ms = now_ms;
+            s->armed  = 1U;
+        }
+        if ( (int32_t)( now_ms - s->due_ms ) >= 0 )
+        {
+            if ( 0U != s->busy )
+            {
+                s->overruns++;
+            }
+            else if ( I2C_OK == i2c_submit( i2c, s->xfer ) )
+            {
+                s->busy = 1U;
+            }
+            else
+            {
+                s->errors++;
+            }
+            // keep the phase, unless the poll came a whole period late
+            s->due_ms += s->period_ms;
+            if ( (int32_t)( now_ms - s->due_ms ) >= 0 )
+            {
+                s->overruns++;
+                s->due_ms = now_ms + s->period_ms;
+            }
+        }
+        left = s->due_ms - now_ms;
+        wait = ( left < wait ) ? left : wait;
+    }
+
+    /***************** 3. Watch ***************************/
+    i2c->p_os_critical->pf_os_critical_enter();
+    ends = i2c->xfers + i2c->errors;
+    if ( NULL == i2c->head || I2C_RECOVER_NONE != i2c->recover )
+    {
+        i2c->watch = NULL;
+    }
+    else if ( i2c->watch != i2c->head || i2c->watch_ends != ends )
+    {
+        // running since the last poll at most: watched from now on
+        i2c->watch      = i2c->head;
+        i2c->watch_ends = ends;
+        i2c->watch_ms   = now_ms;
+    }
+    else if ( now_ms - i2c->watch_ms >= i2c->timeout_ms )
+    {
+        i2c->p_hw_operation_inst->pf_i2c_abort();
+        i2c->recover = I2C_RECOVER_PENDING;
+        i2c->watch   = NULL;
+        i2c->timeouts++;
+        __finish( i2c, __detach( i2c, 1U ), I2C_ERRORTIMEOUT,
+                  I2C_NOTIFY_TASK );
+        LOG( LOG_LEVEL_WARN, "I2C transaction timeout, bus recovery" );
+    }
+    if ( NULL != i2c->watch )
+    {
+        left = i2c->timeout_ms - ( now_ms - i2c->watch_ms );
+        wait = ( left < wait ) ? left : wait;
+    }
+    i2c->p_os_critical->pf_os_critical_exit();
+    __recover( i2c );
+
+    return wait;
+}
+
+/**
+ * @brief: End of a transaction, from its complete or error callback
+ * @steps:
+ *      1. Done: that one off the queue; NACK or bus error: its chain
+ *      2. Bus error: nothing starts, the task of i2c_poll frees the bus
+ *      3. Otherwise start the next transaction, then notify
+ *
+ * @param[in]  i2c:   Pointer to a instance of bsp_i2c_t
+ * @param[in]  event: done, NACK, or a bus error
+ **/
+void i2c_done_isr ( bsp_i2c_t * const i2c, i2c_event_t event )
+{
+    i2c_xfer_t * done;
+
+    // the tasks touch the queue in a critical section only: no lock here;
+    // nothing runs while the bus is to be freed, a late event is dropped
+    if ( NULL == i2c || NULL == i2c->head ||
+         I2C_RECOVER_NONE != i2c->recover )
+    {
+        return;
+    }
+
+    /***************** 1. Off the queue *******************/
+    done = __detach( i2c, ( I2C_EVENT_DONE == event ) ? 0U : 1U );
+
+    /***************** 2. Bus error ***********************/
+    if ( I2C_EVENT_BUS == event )
+    {
+        i2c->recover = I2C_RECOVER_PENDING;
+        __wake( i2c, I2C_NOTIFY_ISR );
+    }
+
+    /***************** 3. Next one, then notify ***********/
+    else
+    {
+        if ( I2C_EVENT_NACK == event )
+        {
+            i2c->nacks++;
+        }
+        if ( NULL != i2c->head )
+        {
+            i2c->chained++;
+            __run( i2c, I2C_NOTIFY_ISR );
+        }
+    }
+    __finish( i2c, done, ( I2C_EVENT_DONE == event ) ? I2C_OK : I2C_ERROR,
+              I2C_NOTIFY_ISR );
+}
+
+//******************************** Defines **********************************//
@@ -0,0 +1,204 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_key_driver.h
+ *
+ * @par dependencies
+ * - stdio.h
+ * - stdint.h
+ *
+ * @author Damian
+ *
+ * @brief Provide the debounce and gesture state machine of one key.
+ *
+ * Processing flow:
+ *
+ * key_instantiate -> key_process (on every edge interrupt and every deadline)
+ *                 -> key_next_deadline
+ *
+ * Debounce is leading-edge: the first edge seen on a stable key is reported
+ * at once, then the edge interrupt stays masked for debounce_ms and the level
+ * is sampled again when the window ends. A press is so reported in the time
+ * of one interrupt plus one context switch, and a bouncing contact costs a
+ * single interrupt.
+ *
+ * The state machine only talks to the hardware through key_operation_t and
+ * takes the time as a parameter, no OS call is made here, so a recorded or
+ * synthetic bounce waveform can be replayed against it on a host.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+#ifndef __BSP_KEY_DRIVER_H__
+#define __BSP_KEY_DRIVER_H__
+
+//******************************** Includes *********************************//
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stddef.h>
+
+//******************************** Includes *********************************//
+
+typedef struct bsp_key_driver bsp_key_driver_t;
+
+//******************************** Defines **********************************//
+
+#define KEY_DEBOUNCE_MS       20U       /* mask window after an edge         */
+#define KEY_DOUBLE_CLICK_MS   250U      /* max gap between two clicks, 0 off */
+#define KEY_LONG_PRESS_MS     800U      /* hold time of a long press         */
+#define KEY_REPEAT_MS         100U      /* repeat period after a long press  */
+
+#define KEY_NO_DEADLINE       0xFFFFFFFFU   /* nothing to do until an edge   */
+#define KEY_EVT_MAX_PER_STEP  3U        /* events one key_process may emit   */
+#define KEY_EVT_BIT(type)     ( 1UL << (uint32_t)(type) )
+
+typedef enum
+{
+    KEY_INST_INITED     = 0,        /* KEY inst initialized                  */
+    KEY_INST_NOT_INITED = 1,        /* KEY inst not initialized              */
+} key_inst_init_t;
+
+typedef enum
+{
+    KEY_INST_OK              = 0,    /* KEY operate successfully             */
+    KEY_INST_ERROR           = 1,    /* KEY error without case matched       */
+    KEY_INST_ERRORTIMEOUT    = 2,    /* KEY operate failed with timeout      */
+    KEY_INST_ERRORSOURCE     = 3,    /* KEY resource not available           */
+    KEY_INST_ERRORPARAMETER  = 4,    /* KEY parameter error                  */
+    KEY_INST_ERRORNOMEMORY   = 5,    /* KEY out of memory                    */
+    KEY_INST_ERRORISR        = 6,    /* KEY not allowed in ISR context       */
+    KEY_INST_RESERVED        = 0xFF, /* KEY reserved                         */
+} key_inst_status_t;
+
+typedef enum
+{
+    KEY_EVT_NONE         = 0,       /* no event                              */
+    KEY_EVT_PRESS        = 1,       /* debounced press, reported at once     */
+    KEY_EVT_RELEASE      = 2,       /* debounced release                     */
+    KEY_EVT_CLICK        = 3,       /* single click, after the double window */
+    KEY_EVT_DOUBLE_CLICK = 4,       /* second release inside the window      */
+    KEY_EVT_LONG_PRESS   = 5,       /* held for long_press_ms                */
+    KEY_EVT_REPEAT       = 6,       /* held on, every repeat_ms              */
+} key_event_type_t;
+
+typedef enum
+{
+    KEY_FSM_IDLE           = 0,     /* released, no click pending            */
+    KEY_FSM_PRESSED        = 1,     /* pressed, waiting for long press       */
+    KEY_FSM_CLICKED        = 2,     /* released once, waiting second press   */
+    KEY_FSM_HELD           = 3,     /* long press reported, repeating        */
+    KEY_FSM_DOUBLE_PRESSED = 4,     /* pressed again in the double window    */
+} key_fsm_state_t;
+
+typedef struct
+{
+    key_inst_status_t ( *pf_key_read )        ( uint8_t * const pressed );
+    key_inst_status_t ( *pf_key_irq_enable )  ( void );
+    key_inst_status_t ( *pf_key_irq_disable ) ( void );
+} key_operation_t;
+
+typedef struct
+{
+    uint32_t            debounce_ms;                  /* KEY_DEBOUNCE_MS     */
+    uint32_t            double_click_ms;              /* KEY_DOUBLE_CLICK_MS */
+    uint32_t            long_press_ms;                /* KEY_LONG_PRESS_MS   */
+    uint32_t            repeat_ms;                    /* KEY_REPEAT_MS       */
+} key_timing_t;
+
+typedef struct
+{
+    uint8_t             key_id;                       /* source key          */
+    key_event_type_t    type;                         /* what happened       */
+    uint16_t            count;                        /* repeat number       */
+    uint32_t            time_ms;                      /* when it happened    */
+} key_event_t;
+
+typedef struct bsp_key_driver
+{
+    //************************** Internal status ****************************//
+    key_inst_init_t     is_initialized;               /* record init status  */
+    key_fsm_state_t     state;                        /* gesture state       */
+    uint8_t             stable;                       /* debounced level     */
+    uint8_t             debouncing;                   /* irq masked window   */
+    uint16_t            repeat_count;                 /* repeats of a hold   */
+    uint32_t            debounce_end_ms;              /* end of the window   */
+    uint32_t            deadline_ms;                  /* gesture timeout     */
+
+    //****************************** Property *******************************//
+    uint8_t             key_id;                       /* id in the events    */
+    key_timing_t        timing;                       /* gesture timings     */
+
+    //************************ Interface from core **************************//
+    key_operation_t     * p_key_operation_inst;       /* key ops interface   */
+} bsp_key_driver_t;
+
+//******************************** Defines **********************************//
+
+//******************************* Declaring *********************************//
+
+/**
+ * @brief: Instantiate a bsp_key_driver_t
+ * @steps:
+ *      1. Refuse an instance that is initialized already
+ *      2. Adding the Core interfaces into the instance of bsp_key_driver_t
+ *      3. Take the timings, the defaults when timing is NULL
+ *      4. Start released with the edge interrupt masked
+ *
+ * @param[in]  key_inst: Pointer to a instance of bsp_key_driver_t, its
+ *                       is_initialized must start as KEY_INST_NOT_INITED
+ * @param[in]  key_ops:  Pointer to a instance of key_operation_t
+ * @param[in]  key_id:   id reported in the events of this key
+ * @param[in]  timing:   Pointer to the timings, NULL for the defaults
+ *
+ * @return key_inst_status_t: execute result of this function
+ **/
+key_inst_status_t key_instantiate (
+                               bsp_key_driver_t    * const key_inst,
+                               key_operation_t     * const key_ops,
+                               uint8_t                     key_id,
+                               const key_timing_t  * const timing
+                                                                    );
+
+/**
+ * @brief: Run the state machine of a key, call it after its edge interrupt
+ *         and whenever the deadline of key_next_deadline is reached
+ * @steps:
+ *      1. Run the gesture timeouts
+ *      2. Close an expired debounce window or take a new edge
+ *      3. Unmask the edge interrupt when the key is stable
+ *
+ * @param[in]  key_inst: Pointer to a instance of bsp_key_driver_t
+ * @param[in]  now_ms:   current time in milliseconds, may wrap
+ * @param[out] events:   KEY_EVT_MAX_PER_STEP slots for the emitted events
+ * @param[out] num:      number of events written
+ *
+ * @return key_inst_status_t: execute result of this function
+ **/
+key_inst_status_t key_process (
+                               bsp_key_driver_t    * const key_inst,
+                               uint32_t                    now_ms,
+                               key_event_t         * const events,
+                               uint32_t            * const num
+                                                                    );
+
+/**
+ * @brief: Time left until the key needs key_process again
+ *
+ * @param[in]  key_inst: Pointer to a instance of bsp_key_driver_t
+ * @param[in]  now_ms:   current time in milliseconds, may wrap
+ *
+ * @return uint32_t: milliseconds to wait, KEY_NO_DEADLINE when idle
+ **/
+uint32_t key_next_deadline (
+                               const bsp_key_driver_t * const key_inst,
+                               uint32_t                       now_ms
+                                                                    );
+
+//******************************* Declaring *********************************//
+#endif // __BSP_KEY_DRIVER_H__
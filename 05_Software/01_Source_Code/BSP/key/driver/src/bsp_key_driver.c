@@ -0,0 +1,387 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_key_driver.c
+ *
+ * @par dependencies
+ * - bsp_key_driver.h
+ *
+ * @author Damian
+ *
+ * @brief Provide the debounce and gesture state machine of one key.
+ *
+ * Processing flow:
+ *
+ * Call directly.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+//******************************** Includes *********************************//
+
+#include "bsp_key_driver.h"
+#include "bsp_common.h"
+
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+BSP_STATUS_CHECK( KEY_INST );
+
+/**
+ * @brief: Check if a wrapping millisecond deadline is reached
+ *
+ * @param[in]  now_ms:      current time
+ * @param[in]  deadline_ms: deadline
+ *
+ * @return uint8_t: 1 when reached
+ **/
+static uint8_t __reached ( uint32_t now_ms, uint32_t deadline_ms )
+{
+    return ( (int32_t)( now_ms - deadline_ms ) >= 0 ) ? 1U : 0U;
+}
+
+/**
+ * @brief: Append one event to the output of key_process
+ *
+ * @param[in]  key_inst: Pointer to a instance of bsp_key_driver_t
+ * @param[in]  type:     event type
+ * @param[in]  now_ms:   event time
+ * @param[out] events:   output array
+ * @param[out] num:      number of events in the output array
+ **/
+static void __emit (
+                     bsp_key_driver_t * const key_inst,
+                     key_event_type_t         type,
+                     uint32_t                 now_ms,
+                     key_event_t      * const events,
+                     uint32_t         * const num
+                                                      )
+{
+    if ( *num >= KEY_EVT_MAX_PER_STEP )
+    {
+        return;
+    }
+    events[*num].key_id  = key_inst->key_id;
+    events[*num].type    = type;
+    events[*num].count   = ( KEY_EVT_REPEAT == type ) ?
+                           key_inst->repeat_count : 0U;
+    events[*num].time_ms = now_ms;
+    (*num)++;
+}
+
+/**
+ * @brief: Run the gesture timeout of the current state
+ * @steps:
+ *      1. A press held long enough becomes a long press, then repeats
+ *      2. A click not followed by a second press becomes a single click
+ *
+ * @param[in]  key_inst: Pointer to a instance of bsp_key_driver_t
+ * @param[in]  now_ms:   current time
+ * @param[out] events:   output array
+ * @param[out] num:      number of events in the output array
+ **/
+static void __on_timeout (
+                           bsp_key_driver_t * const key_inst,
+                           uint32_t                 now_ms,
+                           key_event_t      * const events,
+                           uint32_t         * const num
+                                                            )
+{
+    if ( KEY_FSM_IDLE == key_inst->state                  ||
+         0U == __reached( now_ms, key_inst->deadline_ms )
+                                                            )
+    {
+        return;
+    }
+
+    switch ( key_inst->state )
+    {
+    /************* 1. Long press and repeat ***************/
+    case KEY_FSM_DOUBLE_PRESSED:
+        // the first click is over, the second press turned into a hold
+        __emit( key_inst, KEY_EVT_CLICK, now_ms, events, num );
+        // fall through
+    case KEY_FSM_PRESSED:
+        __emit( key_inst, KEY_EVT_LONG_PRESS, now_ms, events, num );
+        key_inst->state        = KEY_FSM_HELD;
+        key_inst->repeat_count = 0U;
+        key_inst->deadline_ms  = now_ms + key_inst->timing.repeat_ms;
+        break;
+
+    case KEY_FSM_HELD:
+        key_inst->repeat_count++;
+        __emit( key_inst, KEY_EVT_REPEAT, now_ms, events, num );
+        // keep the period, but never burst when the caller was late
+        key_inst->deadline_ms += key_inst->timing.repeat_ms;
+        if ( __reached( now_ms, key_inst->deadline_ms ) )
+        {
+            key_inst->deadline_ms = now_ms + key_inst->timing.repeat_ms;
+        }
+        break;
+
+    /***************** 2. Single click ********************/
+    case KEY_FSM_CLICKED:
+        __emit( key_inst, KEY_EVT_CLICK, now_ms, events, num );
+        key_inst->state = KEY_FSM_IDLE;
+        break;
+
+    default:
+        key_inst->state = KEY_FSM_IDLE;
+        break;
+    }
+}
+
+/**
+ * @brief: Take a debounced level change
+ * @steps:
+ *      1. Open the debounce window, the edge interrupt stays masked
+ *      2. Report the press or release and advance the gestures
+ *
+ * @param[in]  key_inst: Pointer to a instance of bsp_key_driver_t
+ * @param[in]  pressed:  new level
+ * @param[in]  now_ms:   current time
+ * @param[out] events:   output array
+ * @param[out] num:      number of events in the output array
+ **/
+static void __on_edge (
+                        bsp_key_driver_t * const key_inst,
+                        uint8_t                  pressed,
+                        uint32_t                 now_ms,
+                        key_event_t      * const events,
+                        uint32_t         * const num
+                                                         )
+{
+    /*************** 1. Open the debounce window ***************/
+    key_inst->p_key_operation_inst->pf_key_irq_disable();
+    key_inst->stable          = pressed;
+    key_inst->debouncing      = 1U;
+    key_inst->debounce_end_ms = now_ms + key_inst->timing.debounce_ms;
+
+    /*************** 2. Advance the gestures *******************/
+    if ( 0U != pressed )
+    {
+        __emit( key_inst, KEY_EVT_PRESS, now_ms, events, num );
+        key_inst->state       = ( KEY_FSM_CLICKED == key_inst->state ) ?
+                                KEY_FSM_DOUBLE_PRESSED : KEY_FSM_PRESSED;
+        key_inst->deadline_ms = now_ms + key_inst->timing.long_press_ms;
+        return;
+    }
+
+    __emit( key_inst, KEY_EVT_RELEASE, now_ms, events, num );
+    switch ( key_inst->state )
+    {
+    case KEY_FSM_PRESSED:
+        if ( 0U == key_inst->timing.double_click_ms )
+        {
+            __emit( key_inst, KEY_EVT_CLICK, now_ms, events, num );
+            key_inst->state = KEY_FSM_IDLE;
+        }
+        else
+        {
+            key_inst->state       = KEY_FSM_CLICKED;
+            key_inst->deadline_ms = now_ms + key_inst->timing.double_click_ms;
+        }
+        break;
+
+    case KEY_FSM_DOUBLE_PRESSED:
+        __emit( key_inst, KEY_EVT_DOUBLE_CLICK, now_ms, events, num );
+        key_inst->state = KEY_FSM_IDLE;
+        break;
+
+    default:
+        key_inst->state = KEY_FSM_IDLE;
+        break;
+    }
+}
+
+/**
+ * @brief: Instantiate a bsp_key_driver_t
+ * @steps:
+ *      1. Refuse an instance that is initialized already
+ *      2. Adding the Core interfaces into the instance of bsp_key_driver_t
+ *      3. Take the timings, the defaults when timing is NULL
+ *      4. Start released with the edge interrupt masked
+ *
+ * @param[in]  key_inst: Pointer to a instance of bsp_key_driver_t, its
+ *                       is_initialized must start as KEY_INST_NOT_INITED
+ * @param[in]  key_ops:  Pointer to a instance of key_operation_t
+ * @param[in]  key_id:   id reported in the events of this key
+ * @param[in]  timing:   Pointer to the timings, NULL for the defaults
+ *
+ * @return key_inst_status_t: execute result of this function
+ **/
+key_inst_status_t key_instantiate (
+                               bsp_key_driver_t    * const key_inst,
+                               key_operation_t     * const key_ops,
+                               uint8_t                     key_id,
+                               const key_timing_t  * const timing
+                                                                    )
+{
+    /********** 1. Checking the input parameters **********/
+    if ( NULL == key_inst                      ||
+         NULL == key_ops                       ||
+         NULL == key_ops->pf_key_read          ||
+         NULL == key_ops->pf_key_irq_enable    ||
+         NULL == key_ops->pf_key_irq_disable
+                                                 )
+    {
+        LOG( LOG_LEVEL_ERR, "Input parameter is null" );
+        return KEY_INST_ERRORPARAMETER;
+    }
+    if ( NULL != timing               &&
+         ( 0U == timing->debounce_ms   ||
+           0U == timing->long_press_ms ||
+           0U == timing->repeat_ms       )
+                                        )
+    {
+        LOG( LOG_LEVEL_ERR, "Key timing can not be 0" );
+        return KEY_INST_ERRORPARAMETER;
+    }
+
+    /************** 2. Checking the resource **************/
+    if ( KEY_INST_INITED == key_inst->is_initialized )
+    {
+        LOG( LOG_LEVEL_WARN, "KEY inst already initialized" );
+        return KEY_INST_ERRORSOURCE;
+    }
+
+    /************** 3. Adding the interfaces **************/
+    key_inst->p_key_operation_inst = key_ops;
+    key_inst->key_id               = key_id;
+    if ( NULL == timing )
+    {
+        key_inst->timing.debounce_ms     = KEY_DEBOUNCE_MS;
+        key_inst->timing.double_click_ms = KEY_DOUBLE_CLICK_MS;
+        key_inst->timing.long_press_ms   = KEY_LONG_PRESS_MS;
+        key_inst->timing.repeat_ms       = KEY_REPEAT_MS;
+    }
+    else
+    {
+        key_inst->timing = *timing;
+    }
+
+    /************* 4. Initialize the instance *************/
+    key_ops->pf_key_irq_disable();
+    key_inst->state           = KEY_FSM_IDLE;
+    key_inst->stable          = 0U;
+    key_inst->debouncing      = 0U;
+    key_inst->repeat_count    = 0U;
+    key_inst->debounce_end_ms = 0U;
+    key_inst->deadline_ms     = 0U;
+    key_inst->is_initialized  = KEY_INST_INITED;
+    return KEY_INST_OK;
+}
+
+/**
+ * @brief: Run the state machine of a key, call it after its edge interrupt
+ *         and whenever the deadline of key_next_deadline is reached
+ * @steps:
+ *      1. Run the gesture timeouts
+ *      2. Close an expired debounce window or take a new edge
+ *      3. Unmask the edge interrupt when the key is stable
+ *
+ * @param[in]  key_inst: Pointer to a instance of bsp_key_driver_t
+ * @param[in]  now_ms:   current time in milliseconds, may wrap
+ * @param[out] events:   KEY_EVT_MAX_PER_STEP slots for the emitted events
+ * @param[out] num:      number of events written
+ *
+ * @return key_inst_status_t: execute result of this function
+ **/
+key_inst_status_t key_process (
+                               bsp_key_driver_t    * const key_inst,
+                               uint32_t                    now_ms,
+                               key_event_t         * const events,
+                               uint32_t            * const num
+                                                                    )
+{
+    uint8_t pressed = 0U;
+
+    if ( NULL == key_inst ||
+         NULL == events   ||
+         NULL == num
+                            )
+    {
+        return KEY_INST_ERRORPARAMETER;
+    }
+    *num = 0U;
+    if ( KEY_INST_INITED != key_inst->is_initialized )
+    {
+        return KEY_INST_ERRORSOURCE;
+    }
+
+    /*************** 1. Run the gesture timeouts ***************/
+    // first, so a timeout due before a new edge is reported before it
+    __on_timeout( key_inst, now_ms, events, num );
+
+    /*************** 2. Debounce window and edges *************/
+    if ( 0U != key_inst->debouncing )
+    {
+        if ( 0U == __reached( now_ms, key_inst->debounce_end_ms ) )
+        {
+            return KEY_INST_OK;
+        }
+        key_inst->debouncing = 0U;
+    }
+    key_inst->p_key_operation_inst->pf_key_read( &pressed );
+    if ( pressed != key_inst->stable )
+    {
+        __on_edge( key_inst, pressed, now_ms, events, num );
+        return KEY_INST_OK;
+    }
+
+    /*************** 3. Unmask the edge interrupt *************/
+    // an edge between the read and the unmask would be lost, read again
+    key_inst->p_key_operation_inst->pf_key_irq_enable();
+    key_inst->p_key_operation_inst->pf_key_read( &pressed );
+    if ( pressed != key_inst->stable )
+    {
+        __on_edge( key_inst, pressed, now_ms, events, num );
+    }
+    return KEY_INST_OK;
+}
+
+/**
+ * @brief: Time left until the key needs key_process again
+ *
+ * @param[in]  key_inst: Pointer to a instance of bsp_key_driver_t
+ * @param[in]  now_ms:   current time in milliseconds, may wrap
+ *
+ * @return uint32_t: milliseconds to wait, KEY_NO_DEADLINE when idle
+ **/
+uint32_t key_next_deadline (
+                               const bsp_key_driver_t * const key_inst,
+                               uint32_t                       now_ms
+                                                                    )
+{
+    uint32_t wait_ms = KEY_NO_DEADLINE;
+    uint32_t left;
+
+    if ( NULL == key_inst                              ||
+         KEY_INST_INITED != key_inst->is_initialized
+                                                         )
+    {
+        return KEY_NO_DEADLINE;
+    }
+
+    if ( 0U != key_inst->debouncing )
+    {
+        left    = __reached( now_ms, key_inst->debounce_end_ms ) ?
+                  0U : key_inst->debounce_end_ms - now_ms;
+        wait_ms = left;
+    }
+    if ( KEY_FSM_IDLE != key_inst->state )
+    {
+        left    = __reached( now_ms, key_inst->deadline_ms ) ?
+                  0U : key_inst->deadline_ms - now_ms;
+        wait_ms = ( left < wait_ms ) ? left : wait_ms;
+    }
+    return wait_ms;
+}
+
+//******************************** Defines **********************************//
@@ -0,0 +1,181 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_key_handler.h
+ *
+ * @par dependencies
+ * - bsp_key_driver.h
+ * - bsp_osal.h
+ * - bsp_signal.h
+ *
+ * @author Damian
+ *
+ * @brief Run the keys from their edge interrupts and deliver the key events
+ *        to the subscribers.
+ *
+ * Processing flow:
+ *
+ * key_handler_inst -> pf_key_register (every key) -> pf_key_subscribe
+ *                  -> key_handler_start
+ * EXTI callback    -> key_handler_irq -> handler task -> key_process
+ *                  -> signal bits / queue items of the subscribers
+ *
+ * The handler task blocks on a task notification with the nearest deadline
+ * of all the keys as timeout, so nothing runs while no key is touched.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+#ifndef __BSP_KEY_HANDLER_H__
+#define __BSP_KEY_HANDLER_H__
+
+//******************************** Includes *********************************//
+
+#include "bsp_key_driver.h"
+#include "bsp_osal.h"
+#include "bsp_signal.h"
+#include <stdint.h>
+#include <stdio.h>
+
+//******************************** Includes *********************************//
+
+typedef struct bsp_key_handler bsp_key_handler_t;
+
+//******************************** Defines **********************************//
+
+#define MAX_KEY_INST_NUM          8U         /* Max number of key inst       */
+#define MAX_KEY_SUB_NUM           4U         /* Max number of subscribers    */
+#define KEY_HANDLER_STACK_WORDS   256U       /* stack of the handler task    */
+#define KEY_HANDLER_PRIORITY      ( configMAX_PRIORITIES - 2 )
+#define KEY_ALL_KEYS              0xFFFFFFFFU    /* key mask of every key    */
+
+typedef enum
+{
+    KEY_HANDLER_INITED     = 0,     /* KEY handler initialized               */
+    KEY_HANDLER_NOT_INITED = 1,     /* KEY handler not initialized           */
+} key_handler_init_t;
+
+typedef enum
+{
+    KEY_HNDLR_OK              = 0,        /* HNDLR operate successfully      */
+    KEY_HNDLR_ERROR           = 1,        /* HNDLR error                     */
+    KEY_HNDLR_ERRORTIMEOUT    = 2,        /* HNDLR operate timeout           */
+    KEY_HNDLR_ERRORSOURCE     = 3,        /* HNDLR resource not available    */
+    KEY_HNDLR_ERRORPARAMETER  = 4,        /* HNDLR parameter error           */
+    KEY_HNDLR_ERRORNOMEMORY   = 5,        /* HNDLR out of memory             */
+    KEY_HNDLR_ERRORISR        = 6,        /* HNDLR not allowed in ISR        */
+    KEY_HNDLR_RESERVED        = 0xFF,     /* HNDLR reserved                  */
+} key_handler_status_t;
+
+typedef enum
+{
+    KEY_SUB_SIGNAL = 0,     /* set KEY_EVT_BIT(type) on a bsp_signal_t       */
+    KEY_SUB_QUEUE  = 1,     /* put a key_event_t into an os_queue_t queue    */
+} key_sub_type_t;
+
+typedef struct
+{
+    key_sub_type_t        type;                       /* delivery path       */
+    uint32_t              key_mask;                   /* 1 << key_id, keys   */
+    uint32_t              event_mask;                 /* KEY_EVT_BIT(type)   */
+    void                  * target;                   /* signal or queue     */
+} key_subscriber_t;
+
+typedef key_handler_status_t ( *pf_key_register_t ) (
+                                    bsp_key_handler_t * const key_handler,
+                                    bsp_key_driver_t  * const key_driver
+                                                                            );
+
+typedef key_handler_status_t ( *pf_key_subscribe_t ) (
+                                    bsp_key_handler_t      * const key_handler,
+                                    const key_subscriber_t * const subscriber
+                                                                            );
+
+typedef struct
+{
+    uint32_t           key_inst_num;                      /* num of key inst */
+    bsp_key_driver_t * key_inst_array[MAX_KEY_INST_NUM];  /* key inst array  */
+} key_inst_group_t;
+
+typedef struct
+{
+    uint32_t           sub_num;                           /* num of subs     */
+    key_subscriber_t   sub_array[MAX_KEY_SUB_NUM];        /* subscribers     */
+} key_sub_group_t;
+
+typedef struct bsp_key_handler
+{
+    //************************* Internal property ***************************//
+    key_handler_init_t    is_initialized;             /* record init status  */
+    key_inst_group_t      key_inst_group;             /* key inst group      */
+    key_sub_group_t       key_sub_group;              /* subscriber group    */
+    bsp_signal_t          wakeup;                     /* edge irq -> task    */
+    uint32_t              dropped;                    /* events not queued   */
+
+    //************************ Interface from core **************************//
+    time_operation_t      * p_time_operation_inst;    /* time ops interface  */
+
+    //************************ Interface from RTOS **************************//
+    os_queue_t            * p_os_queue;             /* os queue interface    */
+    os_critical_t         * p_os_critical;          /* os critical interface */
+
+    //************************* Interface for APP ***************************//
+    pf_key_subscribe_t    pf_key_subscribe;           /* add a subscriber    */
+
+    //******************** Interface for iternal driver *********************//
+    pf_key_register_t     pf_key_register;            /* register key inst   */
+
+} bsp_key_handler_t;
+
+//******************************** Defines **********************************//
+
+//******************************* Declaring *********************************//
+
+/**
+ * @brief: Instantiate a bsp_key_handler_t
+ * @steps:
+ *      1. Adding the OS interfaces into the instance of bsp_key_handler_t
+ *      2. Adding the time interfaces into the instance of bsp_key_handler_t
+ *      3. Clear the key and subscriber groups
+ *
+ * @param[in]  key_handler: Pointer to a instance of bsp_key_handler_t
+ * @param[in]  os_queue:    Pointer to a instance of os_queue_t
+ * @param[in]  os_critical: Pointer to a instance of os_critical_t
+ * @param[in]  time_ops:    Pointer to a instance of time_operation_t
+ *
+ * @return key_handler_status_t: execute result of this function
+ **/
+key_handler_status_t key_handler_inst (
+                                        bsp_key_handler_t * const key_handler,
+                                        os_queue_t        * const os_queue,
+                                        os_critical_t     * const os_critical,
+                                        time_operation_t  * const time_ops
+                                                                            );
+
+/**
+ * @brief: Create the handler task, the keys start to be served
+ *
+ * @param[in]  key_handler: Pointer to a instance of bsp_key_handler_t
+ *
+ * @return key_handler_status_t: execute result of this function
+ **/
+key_handler_status_t key_handler_start ( bsp_key_handler_t * const key_handler );
+
+/**
+ * @brief: Edge interrupt of a key, call it from the EXTI callback
+ * @steps:
+ *      1. Mask the edge interrupt of the key against the bounce
+ *      2. Wake up the handler task
+ *
+ * @param[in]  key_handler: Pointer to a instance of bsp_key_handler_t
+ * @param[in]  key_id:      id of the key which saw the edge
+ **/
+void key_handler_irq ( bsp_key_handler_t * const key_handler, uint8_t key_id );
+
+//******************************* Declaring *********************************//
+#endif // __BSP_KEY_HANDLER_H__
@@ -0,0 +1,395 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_key_handler.c
+ *
+ * @par dependencies
+ * - bsp_key_handler.h
+ *
+ * @author Damian
+ *
+ * @brief Run the keys from their edge interrupts and deliver the key events
+ *        to the subscribers.
+ *
+ * Processing flow:
+ *
+ * Call directly.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+//******************************** Includes *********************************//
+
+#include "bsp_key_handler.h"
+
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+BSP_STATUS_CHECK( KEY_HNDLR );
+
+/**
+ * @brief: Deliver one event to every matching subscriber
+ *
+ * @param[in]  key_handler: Pointer to a instance of bsp_key_handler_t
+ * @param[in]  event:       event to deliver
+ **/
+static void __dispatch (
+                         bsp_key_handler_t * const key_handler,
+                         key_event_t       * const event
+                                                              )
+{
+    key_subscriber_t * sub;
+    uint32_t           sub_num  = key_handler->key_sub_group.sub_num;
+    uint32_t           key_bit  = 1UL << event->key_id;
+    uint32_t           evt_bit  = KEY_EVT_BIT( event->type );
+
+    for ( uint32_t i = 0; i < sub_num; ++i )
+    {
+        sub = &key_handler->key_sub_group.sub_array[i];
+        if ( 0U == ( sub->key_mask   & key_bit ) ||
+             0U == ( sub->event_mask & evt_bit )
+                                                   )
+        {
+            continue;
+        }
+
+        if ( KEY_SUB_SIGNAL == sub->type )
+        {
+            signal_set( (bsp_signal_t *)sub->target, evt_bit );
+        }
+        else if ( BSP_OK != key_handler->p_os_queue->pf_os_queue_put(
+                                                    sub->target, event, 0U ) )
+        {
+            // never block the keys on a slow consumer
+            key_handler->dropped++;
+        }
+    }
+}
+
+/**
+ * @brief: Handler task, serves the keys on edges and deadlines only
+ * @steps:
+ *      1. Bind the wake up signal to this task
+ *      2. Run every key, deliver the events
+ *      3. Sleep until the next edge or the nearest deadline
+ *
+ * @param[in]  argument: Pointer to a instance of bsp_key_handler_t
+ **/
+static void key_handler_task ( void * argument )
+{
+    bsp_key_handler_t * key_handler = (bsp_key_handler_t *)argument;
+    key_event_t         events[KEY_EVT_MAX_PER_STEP];
+    uint32_t            num;
+    uint32_t            bits;
+    uint32_t            now_ms;
+    uint32_t            wait_ms;
+    uint32_t            next_ms;
+    bsp_key_driver_t  * key_inst;
+
+    /*************** 1. Bind the wake up signal ****************/
+    // edges before this point are picked up by the first pass below
+    signal_instantiate( &key_handler->wakeup, xTaskGetCurrentTaskHandle() );
+
+    for ( ;; )
+    {
+        /************* 2. Run every key ****************/
+        now_ms  = 0U;
+        wait_ms = KEY_NO_DEADLINE;
+        key_handler->p_time_operation_inst->pf_get_time_ms( &now_ms );
+        for ( uint32_t i = 0; i < key_handler->key_inst_group.key_inst_num;
+              ++i )
+        {
+            key_inst = key_handler->key_inst_group.key_inst_array[i];
+            key_process( key_inst, now_ms, events, &num );
+            for ( uint32_t j = 0; j < num; ++j )
+            {
+                __dispatch( key_handler, &events[j] );
+            }
+            next_ms = key_next_deadline( key_inst, now_ms );
+            wait_ms = ( next_ms < wait_ms ) ? next_ms : wait_ms;
+        }
+
+        /************* 3. Sleep until needed ***********/
+        if ( 0U == wait_ms )
+        {
+            continue;
+        }
+        signal_wait( &key_handler->wakeup,
+                     KEY_ALL_KEYS,
+                     ( KEY_NO_DEADLINE == wait_ms ) ?
+                     SIGNAL_WAIT_FOREVER : wait_ms,
+                     &bits                                );
+    }
+}
+
+/**
+ * @brief: Register a key instance into a key handler
+ * @steps:
+ *      1. Check the key id is free and usable as a mask bit
+ *      2. Adding the inst into inst group
+ *      3. Let the task unmask the new key
+ *
+ * @param[in]  key_handler:   Pointer to a instance of bsp_key_handler_t
+ * @param[in]  key_inst:      Pointer to a instance of bsp_key_driver_t
+ *
+ * @return key_handler_status_t: execute result of this function
+ **/
+static key_handler_status_t key_register (
+                      bsp_key_handler_t * const key_handler,  /* key handler */
+                      bsp_key_driver_t  * const key_inst      /* key inst    */
+                                                            )
+{
+    uint32_t             key_inst_num;
+    key_handler_status_t ret = KEY_HNDLR_OK;
+
+    /********** 1. Checking the input parameters **********/
+    if ( NULL == key_handler ||
+         NULL == key_inst
+                               )
+    {
+        LOG( LOG_LEVEL_ERR, "Input parameter is null" );
+        return KEY_HNDLR_ERRORPARAMETER;
+    }
+    else if ( KEY_HANDLER_NOT_INITED == key_handler->is_initialized ||
+              KEY_INST_NOT_INITED    == key_inst->is_initialized )
+    {
+        LOG( LOG_LEVEL_ERR, "KEY handler or inst not initialized" );
+        return KEY_HNDLR_ERRORSOURCE;
+    }
+    else if ( key_inst->key_id >= 32U )
+    {
+        LOG( LOG_LEVEL_ERR, "KEY id %u out of range", key_inst->key_id );
+        return KEY_HNDLR_ERRORPARAMETER;
+    }
+
+    /********* 2. Adding the inst into inst group *********/
+    key_handler->p_os_critical->pf_os_critical_enter();
+    key_inst_num = key_handler->key_inst_group.key_inst_num;
+    for ( uint32_t i = 0; i < key_inst_num; ++i )
+    {
+        if ( key_handler->key_inst_group.key_inst_array[i]->key_id ==
+             key_inst->key_id )
+        {
+            ret = KEY_HNDLR_ERRORPARAMETER;
+        }
+    }
+    if ( KEY_HNDLR_OK == ret && key_inst_num >= MAX_KEY_INST_NUM )
+    {
+        ret = KEY_HNDLR_ERRORNOMEMORY;
+    }
+    if ( KEY_HNDLR_OK == ret )
+    {
+        // fill the slot before publishing it to the task
+        key_handler->key_inst_group.key_inst_array[key_inst_num] = key_inst;
+        key_handler->key_inst_group.key_inst_num++;
+    }
+    key_handler->p_os_critical->pf_os_critical_exit();
+
+    if ( KEY_HNDLR_OK != ret )
+    {
+        LOG( LOG_LEVEL_ERR, "KEY inst %u not registered", key_inst->key_id );
+        return ret;
+    }
+
+    /************* 3. Wake up a running task **************/
+    // not running yet: the first pass of the task serves the key anyway
+    signal_set( &key_handler->wakeup, 1UL << key_inst->key_id );
+    return KEY_HNDLR_OK;
+}
+
+/**
+ * @brief: Add a subscriber to the key events
+ * @steps:
+ *      1. Check the delivery path
+ *      2. Adding the subscriber into the subscriber group
+ *
+ * @param[in]  key_handler:   Pointer to a instance of bsp_key_handler_t
+ * @param[in]  subscriber:    subscriber to copy into the handler
+ *
+ * @return key_handler_status_t: execute result of this function
+ **/
+static key_handler_status_t key_subscribe (
+                                    bsp_key_handler_t      * const key_handler,
+                                    const key_subscriber_t * const subscriber
+                                                                            )
+{
+    uint32_t             sub_num;
+    key_handler_status_t ret = KEY_HNDLR_OK;
+
+    /********** 1. Checking the input parameters **********/
+    if ( NULL == key_handler        ||
+         NULL == subscriber         ||
+         NULL == subscriber->target
+                                      )
+    {
+        LOG( LOG_LEVEL_ERR, "Input parameter is null" );
+        return KEY_HNDLR_ERRORPARAMETER;
+    }
+    else if ( KEY_HANDLER_NOT_INITED == key_handler->is_initialized )
+    {
+        LOG( LOG_LEVEL_ERR, "KEY handler not initialized" );
+        return KEY_HNDLR_ERRORSOURCE;
+    }
+    else if ( KEY_SUB_SIGNAL != subscriber->type &&
+              KEY_SUB_QUEUE  != subscriber->type )
+    {
+        LOG( LOG_LEVEL_ERR, "KEY subscriber type %d", subscriber->type );
+        return KEY_HNDLR_ERRORPARAMETER;
+    }
+
+    /********* 2. Adding the subscriber into group ********/
+    key_handler->p_os_critical->pf_os_critical_enter();
+    sub_num = key_handler->key_sub_group.sub_num;
+    if ( sub_num < MAX_KEY_SUB_NUM )
+    {
+        key_handler->key_sub_group.sub_array[sub_num] = *subscriber;
+        key_handler->key_sub_group.sub_num++;
+    }
+    else
+    {
+        ret = KEY_HNDLR_ERRORNOMEMORY;
+    }
+    key_handler->p_os_critical->pf_os_critical_exit();
+
+    if ( KEY_HNDLR_OK != ret )
+    {
+        LOG( LOG_LEVEL_ERR, "KEY subscriber group is full" );
+    }
+    return ret;
+}
+
+/**
+ * @brief: Instantiate a bsp_key_handler_t
+ * @steps:
+ *      1. Adding the OS interfaces into the instance of bsp_key_handler_t
+ *      2. Adding the time interfaces into the instance of bsp_key_handler_t
+ *      3. Clear the key and subscriber groups
+ *
+ * @param[in]  key_handler: Pointer to a instance of bsp_key_handler_t
+ * @param[in]  os_queue:    Pointer to a instance of os_queue_t
+ * @param[in]  os_critical: Pointer to a instance of os_critical_t
+ * @param[in]  time_ops:    Pointer to a instance of time_operation_t
+ *
+ * @return key_handler_status_t: execute result of this function
+ **/
+key_handler_status_t key_handler_inst (
+                                        bsp_key_handler_t * const key_handler,
+                                        os_queue_t        * const os_queue,
+                                        os_critical_t     * const os_critical,
+                                        time_operation_t  * const time_ops
+                                                                            )
+{
+    /********** 1. Checking the input parameters **********/
+    if ( NULL == key_handler              ||
+         NULL == os_queue                 ||
+         NULL == os_critical              ||
+         NULL == time_ops                 ||
+         NULL == time_ops->pf_get_time_ms
+                                            )
+    {
+        LOG( LOG_LEVEL_ERR, "Input parameter is null" );
+        return KEY_HNDLR_ERRORPARAMETER;
+    }
+
+    /************** 2. Checking the resource **************/
+    if ( KEY_HANDLER_INITED == key_handler->is_initialized )
+    {
+        LOG( LOG_LEVEL_WARN, "KEY handler already initialized" );
+        return KEY_HNDLR_ERRORSOURCE;
+    }
+
+    /************** 3. Adding the interfaces **************/
+    // 3.1 mount external interfaces
+    key_handler->p_time_operation_inst = time_ops;
+    key_handler->p_os_queue            = os_queue;
+    key_handler->p_os_critical         = os_critical;
+    // 3.2 mount internal interfaces
+    key_handler->pf_key_register       = key_register;
+    key_handler->pf_key_subscribe      = key_subscribe;
+
+    /************* 4. Initialize the instance *************/
+    key_handler->key_inst_group.key_inst_num = 0U;
+    key_handler->key_sub_group.sub_num       = 0U;
+    key_handler->dropped                     = 0U;
+    signal_instantiate( &key_handler->wakeup, NULL );
+
+    key_handler->is_initialized = KEY_HANDLER_INITED;
+    return KEY_HNDLR_OK;
+}
+
+/**
+ * @brief: Create the handler task, the keys start to be served
+ *
+ * @param[in]  key_handler: Pointer to a instance of bsp_key_handler_t
+ *
+ * @return key_handler_status_t: execute result of this function
+ **/
+key_handler_status_t key_handler_start ( bsp_key_handler_t * const key_handler )
+{
+    if ( NULL == key_handler )
+    {
+        LOG( LOG_LEVEL_ERR, "Input parameter is null" );
+        return KEY_HNDLR_ERRORPARAMETER;
+    }
+    else if ( KEY_HANDLER_NOT_INITED == key_handler->is_initialized )
+    {
+        LOG( LOG_LEVEL_ERR, "KEY handler not initialized" );
+        return KEY_HNDLR_ERRORSOURCE;
+    }
+
+    if ( pdPASS != xTaskCreate( key_handler_task,
+                                "key_handler",
+                                KEY_HANDLER_STACK_WORDS,
+                                key_handler,
+                                KEY_HANDLER_PRIORITY,
+                                NULL                      ) )
+    {
+        LOG( LOG_LEVEL_ERR, "KEY handler task create failed" );
+        return KEY_HNDLR_ERRORNOMEMORY;
+    }
+    return KEY_HNDLR_OK;
+}
+
+/**
+ * @brief: Edge interrupt of a key, call it from the EXTI callback
+ * @steps:
+ *      1. Mask the edge interrupt of the key against the bounce
+ *      2. Wake up the handler task
+ *
+ * @param[in]  key_handler: Pointer to a instance of bsp_key_handler_t
+ * @param[in]  key_id:      id of the key which saw the edge
+ **/
+void key_handler_irq ( bsp_key_handler_t * const key_handler, uint8_t key_id )
+{
+    bsp_key_driver_t * key_inst;
+
+    if ( NULL == key_handler                              ||
+         KEY_HANDLER_INITED != key_handler->is_initialized
+                                                            )
+    {
+        return;
+    }
+
+    for ( uint32_t i = 0; i < key_handler->key_inst_group.key_inst_num; ++i )
+    {
+        key_inst = key_handler->key_inst_group.key_inst_array[i];
+        if ( key_id != key_inst->key_id )
+        {
+            continue;
+        }
+        /************ 1. Mask the bouncing edge ************/
+        key_inst->p_key_operation_inst->pf_key_irq_disable();
+
+        /************ 2. Wake up the handler task **********/
+        signal_set_isr( &key_handler->wakeup, 1UL << key_id );
+        return;
+    }
+}
+
+//******************************** Defines **********************************//
@@ -6,6 +6,8 @@
  * @file bsp_led_driver.h
  * 
  * @par dependencies 
+ * - bsp_common.h
+ * - bsp_device.h
  * - stdio.h
  * - stdint.h
  * 
@@ -15,7 +17,12 @@
  * 
  * Processing flow:
  * 
- * Call directly.
+ * led_instantiate -> bsp_device_inst( dev, name, &led_ops, led_inst )
+ *                 -> bsp_device_register -> LED handler -> led_ioctl
+ *
+ * The LED is a device class of the registry: led_ops is its vtable, the
+ * priv of the device is the bsp_led_driver_t. LED_IOCTL_TWINKLE blocks for
+ * count periods, the handler runs it inline or posts it to a worker.
  * 
  * @version V1.0 2025-04-26
  *
@@ -28,6 +35,8 @@
 
 //******************************** Includes *********************************//
 
+#include "bsp_common.h"
+#include "bsp_device.h"
 #include <stdint.h>
 #include <stdio.h>
 #include <stddef.h>
@@ -38,27 +47,6 @@ typedef struct bsp_led_driver bsp_led_driver_t;
 
 //******************************** Defines **********************************//
 
-#define OS_SUPPORTING                       /* OS is available               */
-#define CURRENT_LOG_LEVEL LOG_LEVEL_WARN    /* Define the level of log       */
-#define LOG(level, fmt, ...) \
-        do { \
-            if (level >= CURRENT_LOG_LEVEL) { \
-                const char *level_str[] = {"DBG ", "INFO", "WARN", "ERR "}; \
-                printf("[%s]%s:%d " fmt "\r\n", level_str[level], \
-                                              __FILE__, \
-                                              __LINE__, \
-                                              ##__VA_ARGS__); \
-            } \
-        } while (0)
-
-typedef enum {
-    LOG_LEVEL_DBG       = 0,        /* Print DBG & INFO & WARN & ERR         */
-    LOG_LEVEL_INFO      = 1,        /* Print INFO & WARN & ERR               */
-    LOG_LEVEL_WARN      = 2,        /* Print WARN & ERR                      */
-    LOG_LEVEL_ERR       = 3,        /* Print ERR                             */
-    LOG_LEVEL_OFF       = 4,        /* Print nothing                         */
-} log_level_t;
-
 typedef enum
 {
     LED_INST_INITED     = 0,        /* LED handler initialized               */
@@ -77,6 +65,14 @@ typedef enum
     LED_INST_RESERVED        = 0xFF, /* LED reserved                         */
 } led_inst_status_t;
 
+typedef enum
+{
+    LED_IOCTL_ON       = 0,         /* turn the LED on, arg NULL             */
+    LED_IOCTL_OFF      = 1,         /* turn the LED off, arg NULL            */
+    LED_IOCTL_TWINKLE  = 2,         /* period, count, duty of the LED, arg   */
+                                    /* the os_delay_t of the caller          */
+} led_ioctl_t;
+
 typedef struct
 {
     led_inst_status_t ( *pf_led_on )  ( void );
@@ -133,5 +129,43 @@ led_inst_status_t led_instantiate (
                                bsp_led_driver_t    * const led_inst,
                                led_operation_t     * const led_ops
                                                                     );
+
+/**
+ * @brief: Open the LED device: the LED off
+ *
+ * @param[in]  dev: device whose priv is an instantiated bsp_led_driver_t
+ *
+ * @return bsp_status_t: execute result of this function
+ **/
+bsp_status_t led_open ( bsp_device_t * const dev );
+
+/**
+ * @brief: Close the LED device: the LED off
+ *
+ * @param[in]  dev: device whose priv is an instantiated bsp_led_driver_t
+ *
+ * @return bsp_status_t: execute result of this function
+ **/
+bsp_status_t led_close ( bsp_device_t * const dev );
+
+/**
+ * @brief: Run a led_ioctl_t command, the LED handler calls it directly
+ *         with BSP_DEVICE_IOCTL_AS( led, ... )
+ *
+ * @param[in]  dev: device whose priv is an instantiated bsp_led_driver_t
+ * @param[in]  cmd: one of led_ioctl_t
+ * @param[in]  arg: os_delay_t for LED_IOCTL_TWINKLE, else not used
+ *
+ * @return bsp_status_t: execute result of this function
+ **/
+bsp_status_t led_ioctl (
+                         bsp_device_t * const dev,
+                         uint32_t             cmd,
+                         void         * const arg
+                                                  );
+
+/* vtable of the LED device class                                            */
+extern const bsp_device_ops_t led_ops;
+
 //******************************* Declaring *********************************//
 #endif // __BSP_LED_DRIVER_H__
@@ -31,6 +31,8 @@
 
 //******************************** Defines **********************************//
 
+BSP_STATUS_CHECK( LED_INST );
+
 /**
  * @brief: initialize the led
  * @steps:
@@ -104,4 +106,115 @@ led_inst_status_t led_instantiate (
     led_inst->is_initialized = LED_INST_INITED;
     return ret;
 }
+
+/**
+ * @brief: Twinkle the led with its period, count and duty
+ * @steps:
+ *      1. Split the period by the duty
+ *      2. Every period the led on, then off
+ *
+ * @param[in]  led_inst: Pointer to a instance of bsp_led_driver_t
+ * @param[in]  os_delay: delay of the task running the twinkle
+ *
+ * @return bsp_status_t: execute result of this function
+ **/
+BSP_RAMFUNC static bsp_status_t led_twinkle (
+                                  bsp_led_driver_t * const led_inst,
+                                  os_delay_t       * const os_delay
+                                                                    )
+{
+    led_operation_t * ops           = led_inst->p_led_operation_inst;
+    uint32_t          period_local  = led_inst->period_ms;
+    uint32_t          count_local   = led_inst->count;
+    uint32_t          turn_on_time;
+    uint32_t          turn_off_time;
+
+    if ( NULL == os_delay )
+    {
+        return BSP_ERRORPARAMETER;
+    }
+
+    /************* 1. Split the period by duty ************/
+    turn_on_time  = ( led_inst->duty * period_local ) / 10;
+    turn_off_time = period_local - turn_on_time;
+
+    /***************** 2. Do opreration *******************/
+    for ( uint32_t i = 0; i < count_local; ++i )
+    {
+        // 2.1 turn on the led
+        ops->pf_led_on();
+        // 2.2 wait for turn_on_time
+        os_delay->pf_os_delay_ms( turn_on_time );
+        // 2.3 turn off the led
+        ops->pf_led_off();
+        // 2.4 wait for turn_off_time
+        os_delay->pf_os_delay_ms( turn_off_time );
+    }
+    return BSP_OK;
+}
+
+/**
+ * @brief: Open the LED device: the LED off
+ *
+ * @param[in]  dev: device whose priv is an instantiated bsp_led_driver_t
+ *
+ * @return bsp_status_t: execute result of this function
+ **/
+bsp_status_t led_open ( bsp_device_t * const dev )
+{
+    bsp_led_driver_t * led_inst = (bsp_led_driver_t *)dev->priv;
+
+    if ( NULL == led_inst || LED_INST_INITED != led_inst->is_initialized )
+    {
+        LOG( LOG_LEVEL_ERR, "LED inst not initialized" );
+        return BSP_ERRORSOURCE;
+    }
+    return (bsp_status_t)led_inst->p_led_operation_inst->pf_led_off();
+}
+
+/**
+ * @brief: Close the LED device: the LED off
+ *
+ * @param[in]  dev: device whose priv is an instantiated bsp_led_driver_t
+ *
+ * @return bsp_status_t: execute result of this function
+ **/
+bsp_status_t led_close ( bsp_device_t * const dev )
+{
+    return led_open( dev );
+}
+
+/**
+ * @brief: Run a led_ioctl_t command, the LED handler calls it directly
+ *         with BSP_DEVICE_IOCTL_AS( led, ... )
+ *
+ * @param[in]  dev: device whose priv is an instantiated bsp_led_driver_t
+ * @param[in]  cmd: one of led_ioctl_t
+ * @param[in]  arg: os_delay_t for LED_IOCTL_TWINKLE, else not used
+ *
+ * @return bsp_status_t: execute result of this function
+ **/
+BSP_RAMFUNC bsp_status_t led_ioctl (
+                                     bsp_device_t * const dev,
+                                     uint32_t             cmd,
+                                     void         * const arg
+                                                              )
+{
+    bsp_led_driver_t * led_inst = (bsp_led_driver_t *)dev->priv;
+
+    // led_inst_status_t and bsp_status_t share their values
+    switch ( cmd )
+    {
+    case LED_IOCTL_ON:
+        return (bsp_status_t)led_inst->p_led_operation_inst->pf_led_on();
+    case LED_IOCTL_OFF:
+        return (bsp_status_t)led_inst->p_led_operation_inst->pf_led_off();
+    case LED_IOCTL_TWINKLE:
+        return led_twinkle( led_inst, (os_delay_t *)arg );
+    default:
+        return BSP_ERRORPARAMETER;
+    }
+}
+
+BSP_DEVICE_CLASS( led );
 //******************************** Defines **********************************//
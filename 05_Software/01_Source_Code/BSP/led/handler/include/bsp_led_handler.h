@@ -6,6 +6,8 @@
  * @file bsp_led_handler.h
  * 
  * @par dependencies 
+ * - bsp_osal.h
+ * - bsp_signal.h
  * - stdio.h
  * - stdint.h
  * 
@@ -15,7 +17,19 @@
  * 
  * Processing flow:
  * 
- * Call directly.
+ * led_handler_inst -> pf_led_register( registered LED device )
+ *                  -> pf_led_ctrl -> led_ioctl of the device
+ *                                 -> bsp_worker_post ( p_worker set )
+ *
+ * The LEDs are devices of the registry of the led class (led_ops), see
+ * bsp_led_driver.h.
+ *
+ * Without a worker pf_led_ctrl runs the command in the caller and a twinkle
+ * blocks it for count periods. With p_worker set, pf_led_ctrl queues the
+ * command and returns, the worker runs the commands in their order; a
+ * twinkle takes the period, count and duty of the LED when it starts.
+ * With p_signal set too, the worker sets sig_bits on it when a command is
+ * done, so the owner task can wait for the LED without polling.
  * 
  * @version V1.0 2025-05-03
  *
@@ -29,6 +43,10 @@
 //******************************** Includes *********************************//
 
 #include "bsp_led_driver.h"
+#include "bsp_osal.h"
+#ifdef OS_SUPPORTING
+#include "bsp_signal.h"
+#endif /* OS_SUPPORTING */
 #include <stdint.h>
 #include <stdio.h>
 
@@ -38,7 +56,6 @@ typedef struct bsp_led_handler bsp_led_handler_t;
 
 //******************************** Defines **********************************//
 
-#define OS_SUPPORTING                       /* OS is available               */
 #define INIT_PATTERN      0xA6A6A6A6U       /* Init pattern for led driver   */
 #define MAX_LED_INST_NUM  10                /* Max number of led inst        */
 
@@ -64,7 +81,7 @@ typedef enum
 
 typedef led_handler_status_t ( *pf_led_ctrl_t ) (
                         bsp_led_handler_t * const led_handler, /* led ins    */
-                        bsp_led_driver_t  * const led_inst,    /* led inst   */
+                        bsp_device_t      * const led_dev,     /* led device */
                         uint32_t                 period,       /* period_ms  */
                         uint32_t                 count,        /* count      */
                         led_duty_t               duty          /* duty       */
@@ -72,59 +89,13 @@ typedef led_handler_status_t ( *pf_led_ctrl_t ) (
 
 typedef led_handler_status_t ( *pf_led_register_t ) ( 
                                     bsp_led_handler_t * const led_handler,
-                                    bsp_led_driver_t  * const led_driver
+                                    bsp_device_t      * const led_dev
                                                                             );  
 
-typedef struct
-{
-    led_handler_status_t ( *pf_get_time_ms )  ( uint32_t * const );
-} time_operation_t;
-
-#ifdef OS_SUPPORTING
-typedef struct
-{
-    led_handler_status_t ( *pf_os_delay_ms )  ( const uint32_t );
-} os_delay_t;
-
-typedef struct
-{
-    led_handler_status_t ( *pf_os_critical_enter )  ( void );
-    led_handler_status_t ( *pf_os_critical_exit )   ( void );
-} os_critical_t;
-
-typedef struct
-{
-    /* OS queue create */
-    led_handler_status_t ( *pf_os_queue_create ) (
-                                                uint32_t const num,
-                                                uint32_t const size,
-                                                void **  const queue_handler );
-    
-    /* OS queue put */
-    led_handler_status_t ( *pf_os_queue_put ) (
-                                                void *   const queue_handler,
-                                                void *   const item,
-                                                uint32_t       timeout       );
-
-    /* OS queue get */
-    led_handler_status_t ( *pf_os_queue_get ) (
-                                                void *   const queue_handler,
-                                                void *   const msg,
-                                                uint32_t       timeout       );
-
-    /* OS queue delete */
-    led_handler_status_t ( *pf_os_queue_delete ) (
-                                                void *   const queue_handler
-                                                                             );
-
-} os_queue_t;
-
-#endif  // OS_SUPPORTING
-
 typedef struct
 {
     uint32_t           led_inst_num;                      /* num of led inst */
-    bsp_led_driver_t * led_inst_array[MAX_LED_INST_NUM];  /* led inst array  */
+    bsp_device_t     * led_inst_array[MAX_LED_INST_NUM];  /* led devices     */
 } led_inst_group_t;
 
 typedef struct bsp_led_handler
@@ -142,8 +113,10 @@ typedef struct bsp_led_handler
     //************************ Interface from RTOS **************************//
 #ifdef OS_SUPPORTING
     os_delay_t            * p_os_delay;             /* os delay interface    */
-    os_queue_t            * p_os_queue;             /* os queue interface    */
     os_critical_t         * p_os_critical;          /* os critical interface */
+    bsp_worker_t          * p_worker;               /* NULL: in the caller   */
+    bsp_signal_t          * p_signal;               /* NULL: not notified    */
+    uint32_t              sig_bits;                 /* set at a command done */
 
 #endif /* OS_SUPPORTING */ 
 
@@ -169,7 +142,7 @@ typedef struct bsp_led_handler
  * @param[in]  led_handler: Pointer to a instance of bsp_led_handler_t
  * @param[in]  time_ops:    Pointer to a instance of time_base_t
  * @param[in]  os_delay:    Pointer to a instance of os_delay_t
- * @param[in]  os_queue:    Pointer to a instance of os_queue_t
+ * @param[in]  os_critical: Pointer to a instance of os_critical_t
  * 
  * @return led_handler_status_t: execute result of this function
  **/
@@ -177,7 +150,6 @@ led_handler_status_t led_handler_inst (
                                         bsp_led_handler_t * const led_handler,
 #ifdef OS_SUPPORTING   
                                         os_delay_t        * const os_delay,
-                                        os_queue_t        * const os_queue,
                                         os_critical_t     * const os_critical,
 #endif /* OS_SUPPORTING */  
                                         time_operation_t  * const time_ops
@@ -31,6 +31,8 @@
 
 //******************************** Defines **********************************//
 
+BSP_STATUS_CHECK( LED_HNDLR );
+
 /**
  * @brief: initialize the group of led inst
  * @steps:
@@ -43,7 +45,7 @@
  * @return led_status_t: execute result of this function
  **/
 static led_handler_status_t __array_init ( 
-                                           bsp_led_driver_t * array[],
+                                           bsp_device_t     * array[],
                                            uint32_t           array_size 
                                                                          )
 {
@@ -51,57 +53,90 @@ static led_handler_status_t __array_init (
 
     for ( int i = 0; i < array_size; ++i )
     {
-        array[i] = (bsp_led_driver_t *)INIT_PATTERN;
+        array[i] = (bsp_device_t *)INIT_PATTERN;
     }
     // TBD: need to check the memory is available or not
     return ret;
 }
 
+/**
+ * @brief: Check a device is a registered LED
+ *
+ * @param[in]  led_dev: Pointer to a instance of bsp_device_t
+ *
+ * @return uint32_t: 1 when it is
+ **/
+static uint32_t __is_led ( const bsp_device_t * const led_dev )
+{
+    return ( BSP_INITED == led_dev->is_registered &&
+             &led_ops   == led_dev->p_ops            ) ? 1U : 0U;
+}
+
+#ifdef OS_SUPPORTING
+/**
+ * @brief: Done callback of a queued command, in the worker task
+ *
+ * @param[in]  cmd:    the command run, context is the led handler
+ * @param[in]  result: result of the ioctl, counted by the worker
+ **/
+static void __led_done ( bsp_cmd_t * const cmd, bsp_status_t result )
+{
+    bsp_led_handler_t * led_handler = (bsp_led_handler_t *)cmd->context;
+
+    (void)result;
+    if ( NULL != led_handler->p_signal )
+    {
+        signal_set( led_handler->p_signal, led_handler->sig_bits );
+    }
+}
+#endif /* OS_SUPPORTING */
+
 /**
  * @brief: Operate the led
  * @steps:
- *      1. Analyze the parameters of led
- *      2. do the appropriate operation of led
+ *      1. Without a worker, run the command in the caller
+ *      2. Else queue it to the worker, in order with the ones before,
+ *         p_signal is set when it is done
  * 
- * @param[in]  self:   Pointer to a instance of bsp_led_driver_t
+ * @param[in]  led_handler: Pointer to a instance of bsp_led_handler_t
+ * @param[in]  led_dev:     registered LED device
+ * @param[in]  cmd:         one of led_ioctl_t
  * 
  * @return led_status_t: execute result of this function
  **/
-static led_handler_status_t led_twinkle ( 
+BSP_RAMFUNC static led_handler_status_t led_operate ( 
                                   bsp_led_handler_t * const led_handler,
-                                  bsp_led_driver_t  * const led_inst
+                                  bsp_device_t      * const led_dev,
+                                  led_ioctl_t               cmd
                                                                         )
 {
-    uint32_t             period_local;
-    uint32_t             count_local;
-    led_duty_t           duty_local;
-    uint32_t             turn_on_time;
-    uint32_t             turn_off_time;
-    led_handler_status_t ret           = LED_HNDLR_OK;
+    bsp_cmd_t    work;
+    bsp_status_t ret;
+
     /************** 1. Checking the instance **************/
     // No need to check it again, already checked in led_ctrl
 
-    /****************** 2. Do opreration ******************/
-    period_local   = led_inst->period_ms;
-    count_local    = led_inst->count;
-    duty_local     = led_inst->duty;
-    turn_on_time   = ( duty_local * period_local ) / 10;
-    turn_off_time  = period_local - turn_on_time;
-    
-    for ( uint32_t i = 0; i < count_local; ++i )
+    /*************** 2. Run it in the caller **************/
+    if ( NULL == led_handler->p_worker )
     {
-        /* @TODO: need to consider multi_task*/
-        // 2.1 turn on the led
-        led_inst->p_led_operation_inst->pf_led_on();
-        // 2.2 wait for turn_on_time
-        led_handler->p_os_delay->pf_os_delay_ms( turn_on_time );
-        // 2.3 turn off the led
-        led_inst->p_led_operation_inst->pf_led_off();
-        // 2.4 wait for turn_off_time
-        led_handler->p_os_delay->pf_os_delay_ms( turn_off_time );
+        // the class is known: a direct call
+        ret = BSP_DEVICE_IOCTL_AS( led, led_dev, cmd,
+                                   led_handler->p_os_delay );
+        return ( BSP_OK == ret ) ? LED_HNDLR_OK : LED_HNDLR_ERROR;
     }
 
-    return ret;
+    /*************** 3. Queue it to the worker ************/
+    work.dev     = led_dev;
+    work.cmd     = cmd;
+    work.arg     = led_handler->p_os_delay;
+    work.pf_done = __led_done;
+    work.context = led_handler;
+    if ( BSP_OK != bsp_worker_post( led_handler->p_worker, &work, 0U ) )
+    {
+        LOG( LOG_LEVEL_ERR, "LED worker queue is full" );
+        return LED_HNDLR_ERRORNOMEMORY;
+    }
+    return LED_HNDLR_OK;
 }
  
 /**
@@ -111,25 +146,26 @@ static led_handler_status_t led_twinkle (
  *      2. control the led
  * 
  * @param[in]  led_handler:   Pointer to a instance of bsp_led_handler_t
- * @param[in]  led_inst:      Pointer to a instance of bsp_led_driver_t
+ * @param[in]  led_dev:       registered LED device
  * @param[in]  period:        Period of twinkling
  * @param[in]  count:         Count of twinkling
  * @param[in]  duty:          Duty cycle
  * 
  * @return led_status_t: execute result of this function
  **/
-static led_handler_status_t led_ctrl (
+BSP_RAMFUNC static led_handler_status_t led_ctrl (
                        bsp_led_handler_t * const led_handler, /* led handler */
-                       bsp_led_driver_t  * const led_inst,    /* led inst    */
+                       bsp_device_t      * const led_dev,     /* led device  */
                        uint32_t                  period,      /* period_ms   */
                        uint32_t                  count,       /* count       */
                        led_duty_t                duty         /* duty        */
                                                               )
 {
     led_handler_status_t ret = LED_HNDLR_OK;
+    bsp_led_driver_t   * led_inst;
 
     /************** 1. Checking the instance **************/
-    if ( NULL == led_inst )
+    if ( NULL == led_dev )
     {
         LOG( LOG_LEVEL_ERR, "Input parameter is null" );
         ret = LED_HNDLR_ERRORPARAMETER;
@@ -141,12 +177,13 @@ static led_handler_status_t led_ctrl (
         ret = LED_HNDLR_ERRORSOURCE;
         return ret;
     }
-    else if ( LED_INST_NOT_INITED == led_inst->is_initialized )
+    else if ( 0U == __is_led( led_dev ) )
     {
-        LOG( LOG_LEVEL_ERR, "LED inst not initialized" );
+        LOG( LOG_LEVEL_ERR, "Device is not a registered LED" );
         ret = LED_HNDLR_ERRORSOURCE;
         return ret;
     }
+    led_inst = (bsp_led_driver_t *)led_dev->priv;
     
     /********** 2. Checking the input parameters **********/
     if ( period > 10000            ||
@@ -167,28 +204,28 @@ static led_handler_status_t led_ctrl (
 
     /*************** 4. Call fun begin work ***************/
     if ( DUTY_00_PERCENT == duty )
-        led_inst->p_led_operation_inst->pf_led_off();
+        ret = led_operate( led_handler, led_dev, LED_IOCTL_OFF );
     else if ( DUTY_MAX_PERCENT == duty )
-        led_inst->p_led_operation_inst->pf_led_on();
+        ret = led_operate( led_handler, led_dev, LED_IOCTL_ON );
     else
-        led_twinkle( led_handler, led_inst );
+        ret = led_operate( led_handler, led_dev, LED_IOCTL_TWINKLE );
 
     return ret;
 }
 
 /**
- * @brief: Register a led instance into a led handler
+ * @brief: Register a led device into a led handler
  * @steps:
  *      1. Set the values of parameter of led
  * 
  * @param[in]  led_handler:   Pointer to a instance of bsp_led_handler_t
- * @param[in]  led_inst:      Pointer to a instance of bsp_led_driver_t
+ * @param[in]  led_dev:       LED device, registered in the registry
  * 
  * @return led_handler_status_t: execute result of this function
  **/
 static led_handler_status_t led_register (
                       bsp_led_handler_t * const led_handler,  /* led handler */
-                      bsp_led_driver_t  * const led_inst      /* led inst    */
+                      bsp_device_t      * const led_dev       /* led device  */
                                                             )
 {
     uint32_t led_inst_num;
@@ -196,7 +233,7 @@ static led_handler_status_t led_register (
 
     /********** 1. Checking the input parameters **********/
     if ( NULL == led_handler ||
-         NULL == led_inst
+         NULL == led_dev
                                )
     {
         LOG( LOG_LEVEL_ERR, "Input parameter is null" );
@@ -204,9 +241,9 @@ static led_handler_status_t led_register (
         return ret;
     }
     else if ( LED_HANDLER_NOT_INITED ==  led_handler->is_initialized ||
-             LED_INST_NOT_INITED == led_inst->is_initialized )
+              0U == __is_led( led_dev )                              )
     {
-        LOG( LOG_LEVEL_ERR, "LED handler or inst not initialized" );
+        LOG( LOG_LEVEL_ERR, "LED handler not initialized or not a LED" );
         ret = LED_HNDLR_ERRORSOURCE;
         return ret;
     }
@@ -219,7 +256,7 @@ static led_handler_status_t led_register (
     led_inst_num = led_handler->led_inst_group->led_inst_num;
     if ( led_inst_num < MAX_LED_INST_NUM )
     {
-        led_handler->led_inst_group->led_inst_array[led_inst_num] = led_inst;
+        led_handler->led_inst_group->led_inst_array[led_inst_num] = led_dev;
         led_handler->led_inst_group->led_inst_num++;
     }
     else
@@ -245,6 +282,7 @@ static led_handler_status_t led_register (
  * @param[in]  led_handler: Pointer to a instance of bsp_led_handler_t
  * @param[in]  time_ops:    Pointer to a instance of time_base_t
  * @param[in]  os_delay:    Pointer to a instance of os_delay_t
+ * @param[in]  os_critical: Pointer to a instance of os_critical_t
  * 
  * @return led_handler_status_t: execute result of this function
  **/
@@ -252,7 +290,6 @@ led_handler_status_t led_handler_inst (
                                         bsp_led_handler_t * const led_handler,  
 #ifdef OS_SUPPORTING   
                                         os_delay_t        * const os_delay,
-                                        os_queue_t        * const os_queue,
                                         os_critical_t     * const os_critical,
 #endif /* OS_SUPPORTING */  
                                         time_operation_t  * const time_ops
@@ -266,7 +303,6 @@ led_handler_status_t led_handler_inst (
         NULL == led_handler ||
 #ifdef OS_SUPPORTING
         NULL == os_delay    ||
-        NULL == os_queue    ||
         NULL == os_critical ||
 #endif // OS_SUPPORTING
         NULL == time_ops
@@ -289,8 +325,10 @@ led_handler_status_t led_handler_inst (
     led_handler->p_time_operation_inst  = time_ops;
 #ifdef OS_SUPPORTING
     led_handler->p_os_delay             = os_delay;
-    led_handler->p_os_queue             = os_queue;
     led_handler->p_os_critical          = os_critical;
+    led_handler->p_worker               = NULL;
+    led_handler->p_signal               = NULL;
+    led_handler->sig_bits               = 0U;
 #endif
     // 3.2 mount internal interfaces
     led_handler->pf_led_ctrl            = led_ctrl;
@@ -306,7 +344,7 @@ led_handler_status_t led_handler_inst (
         led_handler->p_time_operation_inst  = NULL;
 #ifdef OS_SUPPORTING
         led_handler->p_os_delay             = NULL;
-        led_handler->p_os_queue             = NULL;
+        led_handler->p_os_critical          = NULL;
 #endif
         led_handler->pf_led_ctrl            = NULL;
         led_handler->pf_led_register        = NULL;
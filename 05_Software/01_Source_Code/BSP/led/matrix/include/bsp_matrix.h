@@ -0,0 +1,297 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_matrix.h
+ *
+ * @par dependencies
+ * - bsp_osal.h
+ * - bsp_signal.h
+ * - bsp_led_driver.h
+ *
+ * @author Damian
+ *
+ * @brief Multiplexed LED matrix, 1x1 to 16x16: a timer interrupt scans the
+ *        rows through a shift-register chain, binary code modulation gives
+ *        every pixel its own brightness, a second frame buffer takes the
+ *        next image while the first one is on.
+ *
+ * Processing flow:
+ *
+ * matrix_inst (hardware operations, rows, columns, bits, refresh)
+ * matrix_set_pixel  -> brightness of a pixel in the pixels, 0 .. 255
+ * matrix_show       -> pixels encoded into the bit planes of the back
+ *                      buffer, taken by the scan at the start of its next
+ *                      frame; idle: the scan started
+ * matrix_timer_isr  -> update of the slot timer: the pattern shifted before
+ *                      latched to the outputs, the length of the next slot
+ *                      preloaded, its pattern shifted
+ * matrix_stop       -> timer off, outputs blank
+ *
+ * One row is on at a time. A brightness of bits bits is a level 0 .. 2^bits
+ * - 1; a row is on for bits slots, the slot of bit b lasting base << b
+ * ticks with the columns whose level has bit b set. A pixel is lit level *
+ * base ticks a frame, a frame lasts rows * (2^bits - 1) * base ticks, and
+ * takes rows * bits interrupts whatever the level: 16 rows of 5 bits at
+ * 100 Hz are 8000 interrupts a second, of a latch and a shift of 4 bytes.
+ *
+ * The timer preloads its period: the length written at an update is the one
+ * of the slot after the next update, the interrupt only has to be done
+ * before it. Its latency moves the latch, never the length of a slot. The
+ * shortest slot holds the interrupt and the shift of the next pattern:
+ * matrix_timing refuses a base below MATRIX_MIN_SLOT_NS, and a longest slot
+ * over MATRIX_MAX_PERIOD ticks.
+ *
+ * The scan reads the front buffer only. matrix_show encodes into the back
+ * one, then marks it ready; the interrupt swaps them when it shifts the
+ * first slot of a frame, so a frame is all of one image. A show taking
+ * back a buffer not yet swapped counts a skipped frame, the newest image
+ * wins. The timing is read with the clock at every show and goes with the
+ * buffer: a clock profile change takes effect at the next image.
+ *
+ * The interrupt must be masked by the critical section of the OS (FreeRTOS:
+ * at or below configMAX_SYSCALL_INTERRUPT_PRIORITY).
+ *
+ * matrix_led_set lets a pixel stand for a bsp_led_driver_t, as
+ * ws2812_led_set does for a pixel of a strip.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+#ifndef __BSP_MATRIX_H__
+#define __BSP_MATRIX_H__
+
+//******************************** Includes *********************************//
+
+#include "bsp_osal.h"
+#include "bsp_signal.h"
+#include "bsp_led_driver.h"
+#include <stdint.h>
+
+//******************************** Includes *********************************//
+
+typedef struct bsp_matrix bsp_matrix_t;
+
+//******************************** Defines **********************************//
+
+#define MATRIX_MAX_ROWS           16U
+#define MATRIX_MAX_COLS           16U
+#define MATRIX_MAX_BITS           8U     /* levels of a pixel: 2^bits       */
+#define MATRIX_COL_BYTES          ( ( MATRIX_MAX_COLS + 7U ) / 8U )
+#define MATRIX_MAX_PERIOD         0x10000U /* ticks of a slot, 16 bit timer */
+#define MATRIX_MIN_SLOT_NS        4000U  /* interrupt, shift of the next    */
+
+typedef enum
+{
+    MATRIX_OK                    = 0,  /* MATRIX operate successfully        */
+    MATRIX_ERROR                 = 1,  /* MATRIX error without case matched  */
+    MATRIX_ERRORTIMEOUT          = 2,  /* MATRIX operate failed with timeout */
+    MATRIX_ERRORSOURCE           = 3,  /* MATRIX not initialized            */
+    MATRIX_ERRORPARAMETER        = 4,  /* MATRIX parameter error, clock      */
+    MATRIX_ERRORNOMEMORY         = 5,  /* MATRIX out of memory               */
+    MATRIX_ERRORISR              = 6,  /* MATRIX not allowed in ISR context  */
+    MATRIX_RESERVED              = 0xFF,/* MATRIX reserved                   */
+} matrix_status_t;
+
+typedef enum
+{
+    MATRIX_INITED     = 0,  /* matrix initialized                            */
+    MATRIX_NOT_INITED = 1,  /* matrix not initialized                        */
+} matrix_init_t;
+
+typedef struct
+{
+    uint32_t              tick_hz;                    /* slot timer clock    */
+    uint32_t              base;                       /* ticks of bit 0 slot */
+    uint32_t              frame;                      /* ticks of a frame    */
+    uint32_t              refresh_mhz;                /* frames in 1000 s    */
+} matrix_timing_t;
+
+typedef struct
+{
+    /* clock of the slot timer, after its prescaler, read at every show    */
+    uint32_t        ( *pf_matrix_clock_hz ) ( void );
+    /* from the interrupt: the pattern shifted before to the outputs       */
+    void            ( *pf_matrix_latch )    ( void );
+    /* from the interrupt: the pattern of a row into the shift registers,
+       outputs unchanged; ticks preloaded, the length of its slot          */
+    void            ( *pf_matrix_next )     ( uint32_t              row,
+                                              const uint8_t * const cols,
+                                              uint32_t              ticks );
+    /* timer on: first update after the ticks of the pattern shifted       */
+    matrix_status_t ( *pf_matrix_start )    ( void );
+    /* timer off, outputs blank                                            */
+    matrix_status_t ( *pf_matrix_stop )     ( void );
+} matrix_hw_operation_t;
+
+typedef struct bsp_matrix
+{
+    //************************** Internal status ****************************//
+    matrix_init_t         is_initialized;             /* record init status  */
+    matrix_timing_t       timing;                     /* of the last clock   */
+    matrix_timing_t       buf_timing[2];              /* of each buffer      */
+    uint32_t              front;                      /* buffer scanned      */
+    uint32_t              row;                        /* of the slot shifted */
+    uint32_t              plane;                      /* of the slot shifted */
+    volatile uint32_t     ready;                      /* 1: back to swap in  */
+    volatile uint32_t     running;                    /* 1: timer scanning   */
+    uint8_t               planes[2][MATRIX_MAX_ROWS][MATRIX_MAX_BITS]
+                                [MATRIX_COL_BYTES];   /* column bits, MSB 0  */
+
+    //****************************** Property *******************************//
+    uint32_t              rows;                       /* 1 .. MAX_ROWS       */
+    uint32_t              cols;                       /* 1 .. MAX_COLS       */
+    uint32_t              bits;                       /* 1 .. MAX_BITS       */
+    uint32_t              refresh_hz;                 /* frames a second     */
+    uint8_t               pixels[MATRIX_MAX_ROWS * MATRIX_MAX_COLS];
+    bsp_signal_t          * signal;                   /* NULL: not notified  */
+    uint32_t              sig_bits;                   /* set at a swap       */
+
+    //***************************** Statistics ******************************//
+    uint32_t              scans;                      /* frames scanned      */
+    uint32_t              frames;                     /* images swapped in   */
+    uint32_t              skipped;                    /* taken back unshown  */
+    uint32_t              slots;                      /* interrupts          */
+
+    //************************ Interface from core **************************//
+    matrix_hw_operation_t * p_hw_operation_inst;      /* timer, shift chain  */
+
+    //************************ Interface from RTOS **************************//
+    os_critical_t         * p_os_critical;          /* os critical interface */
+
+} bsp_matrix_t;
+
+//******************************** Defines **********************************//
+
+//******************************* Declaring *********************************//
+
+/**
+ * @brief: Ticks of the slots at a timer clock, nearest to a refresh rate
+ * @steps:
+ *      1. Base: a frame of rows * (2^bits - 1) bases at refresh_hz, rounded
+ *      2. Base not shorter than MATRIX_MIN_SLOT_NS, longest slot fits
+ *      3. Frame and the refresh rate the rounding gives
+ *
+ * @param[in]  rows:       scanned
+ * @param[in]  bits:       of a level
+ * @param[in]  refresh_hz: frames a second asked
+ * @param[in]  tick_hz:    slot timer clock
+ * @param[out] timing:     the ticks
+ *
+ * @return matrix_status_t: MATRIX_ERRORPARAMETER when the clock cannot make
+ *                          the slots
+ **/
+matrix_status_t matrix_timing ( uint32_t                rows,
+                                uint32_t                bits,
+                                uint32_t                refresh_hz,
+                                uint32_t                tick_hz,
+                                matrix_timing_t * const timing );
+
+/**
+ * @brief: Bit planes of a row of pixels
+ *
+ * @param[in]  pixels: cols brightness, 0 .. 255
+ * @param[in]  cols:   1 .. MATRIX_MAX_COLS
+ * @param[in]  bits:   1 .. MATRIX_MAX_BITS, the top bits of a brightness
+ * @param[out] planes: bits * MATRIX_COL_BYTES, plane b at b *
+ *                     MATRIX_COL_BYTES; column 0 the MSB of the first byte
+ **/
+void matrix_encode ( const uint8_t * pixels,
+                     uint32_t        cols,
+                     uint32_t        bits,
+                     uint8_t *       planes );
+
+/**
+ * @brief: Instantiate a bsp_matrix_t
+ * @steps:
+ *      1. Adding the hardware and OS interfaces into the instance
+ *      2. Pixels all off, scan stopped
+ *
+ * @param[in]  matrix:      Pointer to a instance of bsp_matrix_t
+ * @param[in]  hw_ops:      Pointer to a instance of matrix_hw_operation_t
+ * @param[in]  os_critical: Pointer to a instance of os_critical_t
+ * @param[in]  rows:        1 .. MATRIX_MAX_ROWS
+ * @param[in]  cols:        1 .. MATRIX_MAX_COLS
+ * @param[in]  bits:        1 .. MATRIX_MAX_BITS, levels of a pixel 2^bits
+ * @param[in]  refresh_hz:  frames a second
+ *
+ * @return matrix_status_t: execute result of this function
+ **/
+matrix_status_t matrix_inst (
+                              bsp_matrix_t          * const matrix,
+                              matrix_hw_operation_t * const hw_ops,
+                              os_critical_t         * const os_critical,
+                              uint32_t                      rows,
+                              uint32_t                      cols,
+                              uint32_t                      bits,
+                              uint32_t                      refresh_hz
+                                                                      );
+
+/**
+ * @brief: Brightness of one pixel in the pixels, shown by matrix_show
+ *
+ * @param[in]  matrix: Pointer to a instance of bsp_matrix_t
+ * @param[in]  x:      column
+ * @param[in]  y:      row
+ * @param[in]  level:  0 .. 255, the top bits of it shown
+ *
+ * @return matrix_status_t: execute result of this function
+ **/
+matrix_status_t matrix_set_pixel ( bsp_matrix_t * const matrix,
+                                   uint32_t             x,
+                                   uint32_t             y,
+                                   uint8_t              level );
+
+/**
+ * @brief: Show the pixels, task context, returns at once
+ * @steps:
+ *      1. Timer clock changed: timing again
+ *      2. Back buffer not swapped in yet: taken back, skipped
+ *      3. Pixels encoded into the back buffer, marked ready
+ *      4. Scan stopped: the buffer swapped in, scan started
+ *
+ * @param[in]  matrix: Pointer to a instance of bsp_matrix_t
+ *
+ * @return matrix_status_t: execute result of this function
+ **/
+matrix_status_t matrix_show ( bsp_matrix_t * const matrix );
+
+/**
+ * @brief: Stop the scan, outputs blank, task context
+ *
+ * @param[in]  matrix: Pointer to a instance of bsp_matrix_t
+ *
+ * @return matrix_status_t: execute result of this function
+ **/
+matrix_status_t matrix_stop ( bsp_matrix_t * const matrix );
+
+/**
+ * @brief: Update of the slot timer, from its interrupt
+ *
+ * @param[in]  matrix: Pointer to a instance of bsp_matrix_t
+ **/
+void matrix_timer_isr ( bsp_matrix_t * const matrix );
+
+/**
+ * @brief: One pixel as a LED: level or off, shown at once
+ *
+ * @param[in]  matrix: Pointer to a instance of bsp_matrix_t
+ * @param[in]  x:      column
+ * @param[in]  y:      row
+ * @param[in]  level:  when on
+ * @param[in]  on:     1: level, 0: off
+ *
+ * @return led_inst_status_t: for the pf_led_on/pf_led_off of the core
+ **/
+led_inst_status_t matrix_led_set ( bsp_matrix_t * const matrix,
+                                   uint32_t             x,
+                                   uint32_t             y,
+                                   uint8_t              level,
+                                   uint32_t             on );
+
+//******************************* Declaring *********************************//
+#endif // __BSP_MATRIX_H__
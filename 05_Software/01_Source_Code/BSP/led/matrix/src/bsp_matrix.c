@@ -0,0 +1,505 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_matrix.c
+ *
+ * @par dependencies
+ * - bsp_matrix.h
+ * - bsp_common.h
+ *
+ * @author Damian
+ *
+ * @brief Multiplexed LED matrix: rows scanned from the interrupt of a slot
+ *        timer, per pixel brightness by binary code modulation, the bit
+ *        planes double buffered.
+ *
+ * Processing flow:
+ *
+ * Call directly.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+//******************************** Includes *********************************//
+
+#include "bsp_matrix.h"
+#include "bsp_common.h"
+#include <string.h>
+
+#ifndef BENCH_HOST_POSIX
+#include "main.h"
+#endif /* BENCH_HOST_POSIX */
+
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+BSP_STATUS_CHECK( MATRIX );
+
+#define MATRIX_NS_PER_S           1000000000ULL
+
+/**
+ * @brief: Checking the matrix can be used from here
+ *
+ * @param[in]  matrix: Pointer to a instance of bsp_matrix_t
+ *
+ * @return matrix_status_t: MATRIX_OK when it can
+ **/
+static matrix_status_t __ready ( const bsp_matrix_t * const matrix )
+{
+    if ( NULL == matrix )
+    {
+        LOG( LOG_LEVEL_ERR, "Input parameter is null" );
+        return MATRIX_ERRORPARAMETER;
+    }
+    else if ( MATRIX_INITED != matrix->is_initialized )
+    {
+        LOG( LOG_LEVEL_ERR, "LED matrix not initialized" );
+        return MATRIX_ERRORSOURCE;
+    }
+#ifndef BENCH_HOST_POSIX
+    else if ( 0U != __get_IPSR() )
+    {
+        return MATRIX_ERRORISR;
+    }
+#endif /* BENCH_HOST_POSIX */
+    return MATRIX_OK;
+}
+
+/**
+ * @brief: Ticks of the slots at a timer clock, nearest to a refresh rate
+ * @steps:
+ *      1. Base: a frame of rows * (2^bits - 1) bases at refresh_hz, rounded
+ *      2. Base not shorter than MATRIX_MIN_SLOT_NS, longest slot fits
+ *      3. Frame and the refresh rate the rounding gives
+ *
+ * @param[in]  rows:       scanned
+ * @param[in]  bits:       of a level
+ * @param[in]  refresh_hz: frames a second asked
+ * @param[in]  tick_hz:    slot timer clock
+ * @param[out] timing:     the ticks
+ *
+ * @return matrix_status_t: MATRIX_ERRORPARAMETER when the clock cannot make
+ *                          the slots
+ **/
+matrix_status_t matrix_timing ( uint32_t                rows,
+                                uint32_t                bits,
+                                uint32_t                refresh_hz,
+                                uint32_t                tick_hz,
+                                matrix_timing_t * const timing )
+{
+    uint64_t units;
+    uint64_t base;
+
+    if ( NULL == timing )
+    {
+        LOG( LOG_LEVEL_ERR, "Input parameter is null" );
+        return MATRIX_ERRORPARAMETER;
+    }
+    else if ( 0U == rows || MATRIX_MAX_ROWS < rows ||
+              0U == bits || MATRIX_MAX_BITS < bits ||
+              0U == refresh_hz || 0U == tick_hz )
+    {
+        LOG( LOG_LEVEL_ERR, "LED matrix %u rows, %u bits, %u Hz, clock %u",
+                            (unsigned int)rows, (unsigned int)bits,
+                            (unsigned int)refresh_hz, (unsigned int)tick_hz );
+        return MATRIX_ERRORPARAMETER;
+    }
+
+    /***************** 1. Base ****************************/
+    units = (uint64_t)rows * ( ( 1UL << bits ) - 1U );
+    base  = ( tick_hz + units * refresh_hz / 2U ) / ( units * refresh_hz );
+
+    /***************** 2. Limits **************************/
+    if ( 0U == base ||
+         base * MATRIX_NS_PER_S < (uint64_t)MATRIX_MIN_SLOT_NS * tick_hz ||
+         ( base << ( bits - 1U ) ) > MATRIX_MAX_PERIOD )
+    {
+        LOG( LOG_LEVEL_ERR, "LED matrix clock %u Hz cannot scan at %u Hz",
+                            (unsigned int)tick_hz, (unsigned int)refresh_hz );
+        return MATRIX_ERRORPARAMETER;
+    }
+
+    /***************** 3. Frame ***************************/
+    timing->tick_hz     = tick_hz;
+    timing->base        = (uint32_t)base;
+    timing->frame       = (uint32_t)( units * base );
+    timing->refresh_mhz = (uint32_t)( ( (uint64_t)tick_hz * 1000U +
+                                        timing->frame / 2U ) /
+                                      timing->frame );
+    return MATRIX_OK;
+}
+
+/**
+ * @brief: Bit planes of a row of pixels
+ * @steps:
+ *      1. Planes cleared
+ *      2. A pixel sets its column in the planes of the bits of its level
+ *
+ * @param[in]  pixels: cols brightness, 0 .. 255
+ * @param[in]  cols:   1 .. MATRIX_MAX_COLS
+ * @param[in]  bits:   1 .. MATRIX_MAX_BITS, the top bits of a brightness
+ * @param[out] planes: bits * MATRIX_COL_BYTES, plane b at b *
+ *                     MATRIX_COL_BYTES; column 0 the MSB of the first byte
+ **/
+BSP_RAMFUNC void matrix_encode ( const uint8_t * pixels,
+                                 uint32_t        cols,
+                                 uint32_t        bits,
+                                 uint8_t *       planes )
+{
+    const uint32_t shift = 8U - bits;
+    uint32_t       level;
+    uint8_t        mask;
+    uint8_t        * p;
+
+    /******************** 1. Clear ************************/
+    memset( planes, 0, bits * MATRIX_COL_BYTES );
+
+    /******************** 2. Columns **********************/
+    for ( uint32_t x = 0U; x < cols; ++x )
+    {
+        level = (uint32_t)pixels[x] >> shift;
+        mask  = (uint8_t)( 0x80U >> ( x & 7U ) );
+        // dark pixels cost nothing more than the load
+        for ( p = &planes[x / 8U]; 0U != level; level >>= 1 )
+        {
+            if ( 0U != ( level & 1U ) )
+            {
+                *p |= mask;
+            }
+            p += MATRIX_COL_BYTES;
+        }
+    }
+}
+
+/**
+ * @brief: Instantiate a bsp_matrix_t
+ * @steps:
+ *      1. Adding the hardware and OS interfaces into the instance
+ *      2. Pixels all off, scan stopped
+ *
+ * @param[in]  matrix:      Pointer to a instance of bsp_matrix_t
+ * @param[in]  hw_ops:      Pointer to a instance of matrix_hw_operation_t
+ * @param[in]  os_critical: Pointer to a instance of os_critical_t
+ * @param[in]  rows:        1 .. MATRIX_MAX_ROWS
+ * @param[in]  cols:        1 .. MATRIX_MAX_COLS
+ * @param[in]  bits:        1 .. MATRIX_MAX_BITS, levels of a pixel 2^bits
+ * @param[in]  refresh_hz:  frames a second
+ *
+ * @return matrix_status_t: execute result of this function
+ **/
+matrix_status_t matrix_inst (
+                              bsp_matrix_t          * const matrix,
+                              matrix_hw_operation_t * const hw_ops,
+                              os_critical_t         * const os_critical,
+                              uint32_t                      rows,
+                              uint32_t                      cols,
+                              uint32_t                      bits,
+                              uint32_t                      refresh_hz
+                                                                      )
+{
+    /********** 1. Checking the input parameters **********/
+    if ( NULL == matrix                              ||
+         NULL == hw_ops                              ||
+         NULL == hw_ops->pf_matrix_clock_hz          ||
+         NULL == hw_ops->pf_matrix_latch             ||
+         NULL == hw_ops->pf_matrix_next              ||
+         NULL == hw_ops->pf_matrix_start             ||
+         NULL == hw_ops->pf_matrix_stop              ||
+         NULL == os_critical                         ||
+         NULL == os_critical->pf_os_critical_enter   ||
+         NULL == os_critical->pf_os_critical_exit    ||
+         0U == rows || MATRIX_MAX_ROWS < rows        ||
+         0U == cols || MATRIX_MAX_COLS < cols        ||
+         0U == bits || MATRIX_MAX_BITS < bits        ||
+         0U == refresh_hz )
+    {
+        LOG( LOG_LEVEL_ERR, "Input parameter is null" );
+        return MATRIX_ERRORPARAMETER;
+    }
+
+    /************** 2. Checking the resource **************/
+    if ( MATRIX_INITED == matrix->is_initialized )
+    {
+        LOG( LOG_LEVEL_WARN, "LED matrix already initialized" );
+        return MATRIX_ERRORSOURCE;
+    }
+
+    /************** 3. Adding the interfaces **************/
+    // 3.1 mount external interfaces
+    matrix->p_hw_operation_inst = hw_ops;
+    matrix->p_os_critical       = os_critical;
+
+    /************* 4. Initialize the instance *************/
+    matrix->rows       = rows;
+    matrix->cols       = cols;
+    matrix->bits       = bits;
+    matrix->refresh_hz = refresh_hz;
+    matrix->signal     = NULL;
+    matrix->sig_bits   = 0U;
+    // timing at the first show, from the clock of that moment
+    memset( &matrix->timing, 0, sizeof( matrix->timing ) );
+    memset( matrix->buf_timing, 0, sizeof( matrix->buf_timing ) );
+    memset( matrix->planes, 0, sizeof( matrix->planes ) );
+    memset( matrix->pixels, 0, sizeof( matrix->pixels ) );
+    matrix->front      = 0U;
+    matrix->row        = 0U;
+    matrix->plane      = 0U;
+    matrix->ready      = 0U;
+    matrix->running    = 0U;
+    matrix->scans      = 0U;
+    matrix->frames     = 0U;
+    matrix->skipped    = 0U;
+    matrix->slots      = 0U;
+
+    matrix->is_initialized = MATRIX_INITED;
+    return MATRIX_OK;
+}
+
+/**
+ * @brief: Brightness of one pixel in the pixels, shown by matrix_show
+ *
+ * @param[in]  matrix: Pointer to a instance of bsp_matrix_t
+ * @param[in]  x:      column
+ * @param[in]  y:      row
+ * @param[in]  level:  0 .. 255, the top bits of it shown
+ *
+ * @return matrix_status_t: execute result of this function
+ **/
+matrix_status_t matrix_set_pixel ( bsp_matrix_t * const matrix,
+                                   uint32_t             x,
+                                   uint32_t             y,
+                                   uint8_t              level )
+{
+    if ( NULL == matrix )
+    {
+        LOG( LOG_LEVEL_ERR, "Input parameter is null" );
+        return MATRIX_ERRORPARAMETER;
+    }
+    else if ( MATRIX_INITED != matrix->is_initialized )
+    {
+        LOG( LOG_LEVEL_ERR, "LED matrix not initialized" );
+        return MATRIX_ERRORSOURCE;
+    }
+    else if ( x >= matrix->cols || y >= matrix->rows )
+    {
+        LOG( LOG_LEVEL_ERR, "LED matrix pixel %u,%u out of the matrix",
+                            (unsigned int)x, (unsigned int)y );
+        return MATRIX_ERRORPARAMETER;
+    }
+
+    matrix->pixels[y * matrix->cols + x] = level;
+    return MATRIX_OK;
+}
+
+/**
+ * @brief: Show the pixels, task context, returns at once
+ * @steps:
+ *      1. Timer clock changed: timing again
+ *      2. Back buffer not swapped in yet: taken back, skipped
+ *      3. Pixels encoded into the back buffer, marked ready
+ *      4. Scan stopped: the buffer swapped in, scan started
+ *
+ * @param[in]  matrix: Pointer to a instance of bsp_matrix_t
+ *
+ * @return matrix_status_t: execute result of this function
+ **/
+matrix_status_t matrix_show ( bsp_matrix_t * const matrix )
+{
+    matrix_hw_operation_t * hw;
+    uint32_t                tick_hz;
+    uint32_t                back;
+    matrix_status_t         ret = __ready( matrix );
+
+    if ( MATRIX_OK != ret )
+    {
+        return ret;
+    }
+    hw = matrix->p_hw_operation_inst;
+
+    /***************** 1. Timing **************************/
+    tick_hz = hw->pf_matrix_clock_hz();
+    if ( tick_hz != matrix->timing.tick_hz )
+    {
+        ret = matrix_timing( matrix->rows, matrix->bits, matrix->refresh_hz,
+                             tick_hz, &matrix->timing );
+        if ( MATRIX_OK != ret )
+        {
+            return ret;
+        }
+    }
+
+    /***************** 2. Take the back buffer ************/
+    // the scan reads the front one only, and swaps a ready back one only
+    matrix->p_os_critical->pf_os_critical_enter();
+    if ( 0U != matrix->ready )
+    {
+        matrix->ready = 0U;
+        matrix->skipped++;
+    }
+    back = matrix->front ^ 1U;
+    matrix->p_os_critical->pf_os_critical_exit();
+
+    /***************** 3. Encode **************************/
+    for ( uint32_t y = 0U; y < matrix->rows; ++y )
+    {
+        matrix_encode( &matrix->pixels[y * matrix->cols], matrix->cols,
+                       matrix->bits, &matrix->planes[back][y][0][0] );
+    }
+    matrix->buf_timing[back] = matrix->timing;
+
+    matrix->p_os_critical->pf_os_critical_enter();
+    if ( 0U != matrix->running )
+    {
+        matrix->ready = 1U;
+        matrix->p_os_critical->pf_os_critical_exit();
+        return MATRIX_OK;
+    }
+    matrix->p_os_critical->pf_os_critical_exit();
+
+    /***************** 4. Start ***************************/
+    // no interrupt of the matrix until the start: no critical section
+    matrix->front = back;
+    matrix->row   = 0U;
+    matrix->plane = 0U;
+    matrix->frames++;
+    hw->pf_matrix_next( 0U, matrix->planes[back][0][0],
+                        matrix->buf_timing[back].base );
+    matrix->running = 1U;
+    if ( MATRIX_OK != hw->pf_matrix_start() )
+    {
+        LOG( LOG_LEVEL_ERR, "LED matrix timer start failed" );
+        matrix->running = 0U;
+        hw->pf_matrix_stop();
+        return MATRIX_ERROR;
+    }
+    return MATRIX_OK;
+}
+
+/**
+ * @brief: Stop the scan, outputs blank, task context
+ * @steps:
+ *      1. No slot from the interrupt any more, an image ready dropped
+ *      2. Timer off, outputs blank
+ *
+ * @param[in]  matrix: Pointer to a instance of bsp_matrix_t
+ *
+ * @return matrix_status_t: execute result of this function
+ **/
+matrix_status_t matrix_stop ( bsp_matrix_t * const matrix )
+{
+    matrix_status_t ret = __ready( matrix );
+
+    if ( MATRIX_OK != ret )
+    {
+        return ret;
+    }
+
+    /***************** 1. Scan off ************************/
+    matrix->p_os_critical->pf_os_critical_enter();
+    matrix->running = 0U;
+    matrix->ready   = 0U;
+    matrix->p_os_critical->pf_os_critical_exit();
+
+    /***************** 2. Blank ***************************/
+    return matrix->p_hw_operation_inst->pf_matrix_stop();
+}
+
+/**
+ * @brief: Update of the slot timer, from its interrupt
+ * @steps:
+ *      1. The slot shifted before on the outputs
+ *      2. Next plane, next row; first slot of a frame: a ready buffer in
+ *      3. Its pattern shifted, its length preloaded
+ *
+ * @param[in]  matrix: Pointer to a instance of bsp_matrix_t
+ **/
+BSP_RAMFUNC void matrix_timer_isr ( bsp_matrix_t * const matrix )
+{
+    matrix_hw_operation_t * hw;
+    uint32_t                front;
+
+    // the tasks touch running and ready in a critical section only
+    if ( NULL == matrix || 0U == matrix->running )
+    {
+        return;
+    }
+    hw = matrix->p_hw_operation_inst;
+
+    /***************** 1. Latch ***************************/
+    hw->pf_matrix_latch();
+    matrix->slots++;
+
+    /***************** 2. Next slot ***********************/
+    if ( ++matrix->plane == matrix->bits )
+    {
+        matrix->plane = 0U;
+        if ( ++matrix->row == matrix->rows )
+        {
+            matrix->row = 0U;
+            matrix->scans++;
+            if ( 0U != matrix->ready )
+            {
+                matrix->front ^= 1U;
+                matrix->ready  = 0U;
+                matrix->frames++;
+                if ( NULL != matrix->signal )
+                {
+                    signal_set_isr( matrix->signal, matrix->sig_bits );
+                }
+            }
+        }
+    }
+
+    /***************** 3. Shift ***************************/
+    front = matrix->front;
+    hw->pf_matrix_next( matrix->row,
+                        matrix->planes[front][matrix->row][matrix->plane],
+                        matrix->buf_timing[front].base << matrix->plane );
+}
+
+/**
+ * @brief: One pixel as a LED: level or off, shown at once
+ *
+ * @param[in]  matrix: Pointer to a instance of bsp_matrix_t
+ * @param[in]  x:      column
+ * @param[in]  y:      row
+ * @param[in]  level:  when on
+ * @param[in]  on:     1: level, 0: off
+ *
+ * @return led_inst_status_t: for the pf_led_on/pf_led_off of the core
+ **/
+led_inst_status_t matrix_led_set ( bsp_matrix_t * const matrix,
+                                   uint32_t             x,
+                                   uint32_t             y,
+                                   uint8_t              level,
+                                   uint32_t             on )
+{
+    matrix_status_t ret;
+
+    ret = matrix_set_pixel( matrix, x, y, ( 0U != on ) ? level : 0U );
+    if ( MATRIX_OK == ret )
+    {
+        ret = matrix_show( matrix );
+    }
+    switch ( ret )
+    {
+    case MATRIX_OK:
+        return LED_INST_OK;
+    case MATRIX_ERRORSOURCE:
+        return LED_INST_ERRORSOURCE;
+    case MATRIX_ERRORPARAMETER:
+        return LED_INST_ERRORPARAMETER;
+    case MATRIX_ERRORISR:
+        return LED_INST_ERRORISR;
+    default:
+        return LED_INST_ERROR;
+    }
+}
+
+//******************************** Defines **********************************//
@@ -0,0 +1,286 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_ws2812.h
+ *
+ * @par dependencies
+ * - bsp_osal.h
+ * - bsp_signal.h
+ * - bsp_led_driver.h
+ *
+ * @author Damian
+ *
+ * @brief Addressable RGB LED strip (WS2812B, SK6812): the pixels of a frame
+ *        buffer go out as the duty of a timer PWM channel, one period per
+ *        bit, streamed by a circular DMA from a small ring refilled by its
+ *        half and full transfer interrupts.
+ *
+ * Processing flow:
+ *
+ * ws2812_timing     -> ticks of a bit, of a 0 and of a 1 at the timer clock,
+ *                      slots of the reset; fails when the clock is too slow
+ *                      for the tolerance of the part
+ * ws2812_inst (hardware operations, type, pixels, number of LEDs)
+ * ws2812_set_pixel  -> colour of one LED, in the order of the wire
+ * ws2812_show       -> idle: both halves of the ring encoded, DMA started;
+ *                      a frame streaming: one more after it
+ * ws2812_dma_isr    -> half or full transfer: the half just sent encoded
+ *                      again with the next 8 LEDs, then the reset (line
+ *                      low), then the next frame or stop and notify;
+ *                      transfer error: frame dropped, stop and notify
+ *
+ * A LED takes 24 bits (32 for RGBW), a bit one timer period of 1.25 us, its
+ * duty tells 0 from 1. Expanded up front a strip needs a DMA slot per bit:
+ * 48 KiB for 1000 LEDs. Here the DMA only ever sees the ring, two halves of
+ * WS2812_HALF_SLOTS, whatever the length of the strip: the interrupt of one
+ * half has the time of the other to encode it again, 240 us for 8 LEDs.
+ *
+ * The timer runs PWM mode 1 with the preload of its compare register on,
+ * the DMA request of its update event writes the next duty: the slot
+ * written at an update goes out in the period after it. A slot of 0 keeps
+ * the line low: the reset, and the state the strip is left in.
+ *
+ * The frame buffer is the pixels, the DMA never reads it: a pixel written
+ * while a frame streams shows in it or in the next one. ws2812_show while
+ * busy queues one more frame, started from the interrupt after the reset,
+ * so a pixel set then shown is on the strip at last after two frames.
+ *
+ * The interrupt must be masked by the critical section of the OS (FreeRTOS:
+ * at or below configMAX_SYSCALL_INTERRUPT_PRIORITY) and served within the
+ * time of a half, else the strip gets an old half: late counts the half
+ * interrupts that came out of turn.
+ *
+ * ws2812_led_set lets a pixel stand for a bsp_led_driver_t: its
+ * led_operation_t are two functions of the core calling it, so the LED
+ * handler blinks a pixel the way it blinks the GPIO LED.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+#ifndef __BSP_WS2812_H__
+#define __BSP_WS2812_H__
+
+//******************************** Includes *********************************//
+
+#include "bsp_osal.h"
+#include "bsp_signal.h"
+#include "bsp_led_driver.h"
+#include <stdint.h>
+
+//******************************** Includes *********************************//
+
+typedef struct bsp_ws2812 bsp_ws2812_t;
+
+//******************************** Defines **********************************//
+
+#define WS2812_HALF_SLOTS         192U   /* half ring: 8 RGB, 6 RGBW LEDs    */
+#define WS2812_RING_SLOTS         ( 2U * WS2812_HALF_SLOTS )
+#define WS2812_TOLERANCE_NS       150U   /* of a bit and of its high time    */
+#define WS2812_MAX_PERIOD         0x10000U /* ticks of a bit, 16-bit timer   */
+#define WS2812_DMA_ERROR          2U     /* half of ws2812_dma_isr           */
+
+/* colour of ws2812_set_pixel: 0xWWRRGGBB, white of RGBW parts only         */
+#define WS2812_RGB( r, g, b )     ( ( (uint32_t)( r ) << 16 ) |              \
+                                    ( (uint32_t)( g ) <<  8 ) |              \
+                                      (uint32_t)( b )          )
+#define WS2812_RGBW( r, g, b, w ) ( WS2812_RGB( r, g, b ) |                  \
+                                    ( (uint32_t)( w ) << 24 ) )
+
+typedef enum
+{
+    WS2812_OK                    = 0,  /* WS2812 operate successfully        */
+    WS2812_ERROR                 = 1,  /* WS2812 DMA or timer start failed   */
+    WS2812_ERRORTIMEOUT          = 2,  /* WS2812 operate failed with timeout */
+    WS2812_ERRORSOURCE           = 3,  /* WS2812 strip not initialized       */
+    WS2812_ERRORPARAMETER        = 4,  /* WS2812 parameter error, clock      */
+    WS2812_ERRORNOMEMORY         = 5,  /* WS2812 out of memory               */
+    WS2812_ERRORISR              = 6,  /* WS2812 not allowed in ISR context  */
+    WS2812_RESERVED              = 0xFF,/* WS2812 reserved                   */
+} ws2812_status_t;
+
+typedef enum
+{
+    WS2812_INITED     = 0,  /* ws2812 strip initialized                      */
+    WS2812_NOT_INITED = 1,  /* ws2812 strip not initialized                  */
+} ws2812_init_t;
+
+typedef enum
+{
+    WS2812_TYPE_WS2812B          = 0,  /* GRB, 400/800 ns, reset 280 us      */
+    WS2812_TYPE_SK6812           = 1,  /* GRB, 300/600 ns, reset 80 us       */
+    WS2812_TYPE_SK6812_RGBW      = 2,  /* GRBW, 300/600 ns, reset 80 us      */
+    WS2812_TYPES                 = 3,
+} ws2812_type_t;
+
+typedef struct
+{
+    uint32_t              tim_hz;                     /* timer clock         */
+    uint32_t              period;                     /* ticks of a bit      */
+    uint16_t              t0h;                        /* high ticks of a 0   */
+    uint16_t              t1h;                        /* high ticks of a 1   */
+    uint32_t              reset_slots;                /* low bits, 8 aligned */
+} ws2812_timing_t;
+
+typedef struct
+{
+    /* timer clock of the PWM channel, read at every idle ws2812_show      */
+    uint32_t        ( *pf_ws2812_clock_hz )  ( void );
+    /* circular DMA of slots duties on the update event, period ticks a bit */
+    ws2812_status_t ( *pf_ws2812_dma_start ) ( const uint16_t * const ring,
+                                               uint32_t               slots,
+                                               uint32_t               period );
+    /* DMA and timer stopped, the line low                                 */
+    ws2812_status_t ( *pf_ws2812_dma_stop )  ( void );
+} ws2812_hw_operation_t;
+
+typedef struct bsp_ws2812
+{
+    //************************** Internal status ****************************//
+    ws2812_init_t         is_initialized;             /* record init status  */
+    ws2812_timing_t       timing;                     /* of the last clock   */
+    uint32_t              data_slots;                 /* bits of a frame     */
+    uint32_t              pos;                        /* next slot to encode */
+    uint32_t              drain;                      /* halves left to stop */
+    uint32_t              expect;                     /* half of the next isr*/
+    volatile uint32_t     busy;                       /* 1: DMA streaming    */
+    volatile uint32_t     pending;                    /* 1: one more frame   */
+    uint16_t              ring[WS2812_RING_SLOTS];    /* duties, DMA source  */
+
+    //****************************** Property *******************************//
+    ws2812_type_t         type;                       /* timing, byte order  */
+    uint8_t               * pixels;                   /* leds * bpp, wire    */
+    uint32_t              leds;                       /* on the strip        */
+    uint32_t              bpp;                        /* bytes a LED, 3 or 4 */
+    bsp_signal_t          * signal;                   /* NULL: not notified  */
+    uint32_t              bits;                       /* set when it stops   */
+
+    //***************************** Statistics ******************************//
+    uint32_t              frames;                     /* sent                */
+    uint32_t              refills;                    /* halves encoded      */
+    uint32_t              late;                       /* half interrupt lost */
+    uint32_t              errors;                     /* start, DMA failed   */
+
+    //************************ Interface from core **************************//
+    ws2812_hw_operation_t * p_hw_operation_inst;      /* timer and DMA       */
+
+    //************************ Interface from RTOS **************************//
+    os_critical_t         * p_os_critical;          /* os critical interface */
+
+} bsp_ws2812_t;
+
+//******************************** Defines **********************************//
+
+//******************************* Declaring *********************************//
+
+/**
+ * @brief: Ticks of a bit at a timer clock, nearest to the nominal times
+ * @steps:
+ *      1. Period, high times of a 0 and a 1, rounded to the nearest tick
+ *      2. Each one within WS2812_TOLERANCE_NS, a 0 shorter than a 1
+ *      3. Slots of the reset, one more for the slot in flight, 8 aligned
+ *
+ * @param[in]  type:   part on the strip
+ * @param[in]  tim_hz: timer clock of the PWM channel
+ * @param[out] timing: the ticks
+ *
+ * @return ws2812_status_t: WS2812_ERRORPARAMETER when the clock cannot
+ *                          make the bits within the tolerance
+ **/
+ws2812_status_t ws2812_timing ( ws2812_type_t           type,
+                                uint32_t                tim_hz,
+                                ws2812_timing_t * const timing );
+
+/**
+ * @brief: Duties of bytes, most significant bit first, a slot per bit
+ *
+ * @param[in]  timing: ticks of a 0 and a 1
+ * @param[in]  bytes:  in the order of the wire
+ * @param[in]  num:    bytes
+ * @param[out] slots:  8 * num duties
+ **/
+void ws2812_encode ( const ws2812_timing_t * const timing,
+                     const uint8_t         *       bytes,
+                     uint32_t                      num,
+                     uint16_t              *       slots );
+
+/**
+ * @brief: Instantiate a bsp_ws2812_t
+ * @steps:
+ *      1. Adding the hardware and OS interfaces into the instance
+ *      2. Pixels of the strip all off, idle
+ *
+ * @param[in]  strip:       Pointer to a instance of bsp_ws2812_t
+ * @param[in]  hw_ops:      Pointer to a instance of ws2812_hw_operation_t
+ * @param[in]  os_critical: Pointer to a instance of os_critical_t
+ * @param[in]  type:        part on the strip
+ * @param[in]  pixels:      frame buffer, leds * 3 bytes, * 4 for RGBW
+ * @param[in]  leds:        LEDs on the strip
+ *
+ * @return ws2812_status_t: execute result of this function
+ **/
+ws2812_status_t ws2812_inst (
+                              bsp_ws2812_t          * const strip,
+                              ws2812_hw_operation_t * const hw_ops,
+                              os_critical_t         * const os_critical,
+                              ws2812_type_t                 type,
+                              uint8_t               * const pixels,
+                              uint32_t                      leds
+                                                                      );
+
+/**
+ * @brief: Colour of one LED in the frame buffer, shown by ws2812_show
+ *
+ * @param[in]  strip: Pointer to a instance of bsp_ws2812_t
+ * @param[in]  index: LED, 0 is the nearest to the data input
+ * @param[in]  color: 0xWWRRGGBB, WS2812_RGB or WS2812_RGBW
+ *
+ * @return ws2812_status_t: execute result of this function
+ **/
+ws2812_status_t ws2812_set_pixel ( bsp_ws2812_t * const strip,
+                                   uint32_t             index,
+                                   uint32_t             color );
+
+/**
+ * @brief: Send the frame buffer to the strip, task context, returns at once
+ * @steps:
+ *      1. Streaming already: one more frame after it
+ *      2. Timer clock changed: timing again
+ *      3. Both halves of the ring encoded, DMA started
+ *
+ * @param[in]  strip: Pointer to a instance of bsp_ws2812_t
+ *
+ * @return ws2812_status_t: execute result of this function
+ **/
+ws2812_status_t ws2812_show ( bsp_ws2812_t * const strip );
+
+/**
+ * @brief: Half or full transfer of the ring, from the DMA interrupt
+ *
+ * @param[in]  strip: Pointer to a instance of bsp_ws2812_t
+ * @param[in]  half:  0: first half sent (half transfer), 1: second (full),
+ *                    WS2812_DMA_ERROR: transfer error
+ **/
+void ws2812_dma_isr ( bsp_ws2812_t * const strip, uint32_t half );
+
+/**
+ * @brief: One pixel as a LED: colour or off, shown at once
+ *
+ * @param[in]  strip: Pointer to a instance of bsp_ws2812_t
+ * @param[in]  index: LED
+ * @param[in]  color: when on
+ * @param[in]  on:    1: color, 0: off
+ *
+ * @return led_inst_status_t: for the pf_led_on/pf_led_off of the core
+ **/
+led_inst_status_t ws2812_led_set ( bsp_ws2812_t * const strip,
+                                   uint32_t             index,
+                                   uint32_t             color,
+                                   uint32_t             on );
+
+//******************************* Declaring *********************************//
+#endif // __BSP_WS2812_H__
@@ -0,0 +1,567 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_ws2812.c
+ *
+ * @par dependencies
+ * - bsp_ws2812.h
+ * - bsp_common.h
+ *
+ * @author Damian
+ *
+ * @brief Addressable RGB LED strip (WS2812B, SK6812): the pixels of a frame
+ *        buffer go out as the duty of a timer PWM channel, one period per
+ *        bit, streamed by a circular DMA from a small ring refilled by its
+ *        half and full transfer interrupts.
+ *
+ * Processing flow:
+ *
+ * Call directly.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+//******************************** Includes *********************************//
+
+#include "bsp_ws2812.h"
+#include "bsp_common.h"
+#include <string.h>
+
+#ifndef BENCH_HOST_POSIX
+#include "main.h"
+#endif /* BENCH_HOST_POSIX */
+
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+BSP_STATUS_CHECK( WS2812 );
+
+#define WS2812_NS_PER_S           1000000000ULL
+#define WS2812_HALVES_TO_STOP     2U     /* the one with the end, the other */
+
+typedef struct
+{
+    uint32_t              t0h_ns;                     /* high time of a 0    */
+    uint32_t              t1h_ns;                     /* high time of a 1    */
+    uint32_t              bit_ns;                     /* period of a bit     */
+    uint32_t              reset_ns;                   /* low, latches        */
+    uint32_t              bpp;                        /* bytes a LED         */
+} ws2812_part_t;
+
+/* datasheet times; the WS2812B-V5 latches after 280 us, older ones 50 us */
+static const ws2812_part_t s_parts[WS2812_TYPES] =
+{
+    { 400U, 800U, 1250U, 280000U, 3U },       /* WS2812_TYPE_WS2812B        */
+    { 300U, 600U, 1250U,  80000U, 3U },       /* WS2812_TYPE_SK6812         */
+    { 300U, 600U, 1250U,  80000U, 4U },       /* WS2812_TYPE_SK6812_RGBW    */
+};
+
+/**
+ * @brief: Ticks nearest to a time at a clock
+ *
+ * @param[in]  tim_hz: clock
+ * @param[in]  ns:     time
+ *
+ * @return uint32_t: ticks
+ **/
+static uint32_t __ticks ( uint32_t tim_hz, uint32_t ns )
+{
+    return (uint32_t)( ( (uint64_t)tim_hz * ns + WS2812_NS_PER_S / 2U ) /
+                       WS2812_NS_PER_S );
+}
+
+/**
+ * @brief: Ticks off a time by more than the tolerance
+ *
+ * @param[in]  tim_hz: clock
+ * @param[in]  ticks:  rounded
+ * @param[in]  ns:     nominal time
+ *
+ * @return uint32_t: 1 when out of tolerance
+ **/
+static uint32_t __off ( uint32_t tim_hz, uint32_t ticks, uint32_t ns )
+{
+    uint64_t real = (uint64_t)ticks * WS2812_NS_PER_S;   /* ns * tim_hz     */
+    uint64_t want = (uint64_t)ns * tim_hz;
+    uint64_t diff = ( real > want ) ? real - want : want - real;
+
+    return ( diff > (uint64_t)WS2812_TOLERANCE_NS * tim_hz ) ? 1U : 0U;
+}
+
+/**
+ * @brief: Checking the strip can be used from here
+ *
+ * @param[in]  strip: Pointer to a instance of bsp_ws2812_t
+ *
+ * @return ws2812_status_t: WS2812_OK when it can
+ **/
+static ws2812_status_t __ready ( const bsp_ws2812_t * const strip )
+{
+    if ( NULL == strip )
+    {
+        LOG( LOG_LEVEL_ERR, "Input parameter is null" );
+        return WS2812_ERRORPARAMETER;
+    }
+    else if ( WS2812_INITED != strip->is_initialized )
+    {
+        LOG( LOG_LEVEL_ERR, "WS2812 strip not initialized" );
+        return WS2812_ERRORSOURCE;
+    }
+#ifndef BENCH_HOST_POSIX
+    else if ( 0U != __get_IPSR() )
+    {
+        return WS2812_ERRORISR;
+    }
+#endif /* BENCH_HOST_POSIX */
+    return WS2812_OK;
+}
+
+/**
+ * @brief: Encode the next slots of the stream into one half of the ring
+ * @steps:
+ *      1. Bits of the frame: whole bytes, 8 slots each
+ *      2. Reset: slots of 0
+ *      3. Reset out, one more frame asked: it starts right behind it
+ *      4. Else line low; it stops when this half was sent
+ *
+ * @param[in]  strip: Pointer to a instance of bsp_ws2812_t
+ * @param[in]  half:  0 or 1
+ **/
+BSP_RAMFUNC static void __refill ( bsp_ws2812_t * const strip, uint32_t half )
+{
+    uint16_t * out = &strip->ring[half * WS2812_HALF_SLOTS];
+    uint32_t   end = strip->data_slots + strip->timing.reset_slots;
+    uint32_t   n   = WS2812_HALF_SLOTS;
+    uint32_t   run;
+
+    // the half, the frame and the reset are all multiples of 8 slots
+    while ( 0U != n )
+    {
+        /******************** 1. Bits *************************/
+        if ( strip->pos < strip->data_slots )
+        {
+            run = strip->data_slots - strip->pos;
+            run = ( run < n ) ? run : n;
+            ws2812_encode( &strip->timing, &strip->pixels[strip->pos / 8U],
+                           run / 8U, out );
+            strip->pos += run;
+        }
+        /******************** 2. Reset ************************/
+        else if ( strip->pos < end )
+        {
+            run = end - strip->pos;
+            run = ( run < n ) ? run : n;
+            memset( out, 0, run * sizeof( *out ) );
+            strip->pos += run;
+        }
+        /******************** 3. Next frame *******************/
+        else if ( 0U != strip->pending )
+        {
+            strip->pending = 0U;
+            strip->drain   = 0U;
+            strip->pos     = 0U;
+            strip->frames++;
+            continue;
+        }
+        /******************** 4. Idle *************************/
+        else
+        {
+            run = n;
+            memset( out, 0, run * sizeof( *out ) );
+            if ( 0U == strip->drain )
+            {
+                strip->drain = WS2812_HALVES_TO_STOP;
+            }
+        }
+        out += run;
+        n   -= run;
+    }
+    strip->refills++;
+}
+
+/**
+ * @brief: Ticks of a bit at a timer clock, nearest to the nominal times
+ * @steps:
+ *      1. Period, high times of a 0 and a 1, rounded to the nearest tick
+ *      2. Each one within WS2812_TOLERANCE_NS, a 0 shorter than a 1
+ *      3. Slots of the reset, one more for the slot in flight, 8 aligned
+ *
+ * @param[in]  type:   part on the strip
+ * @param[in]  tim_hz: timer clock of the PWM channel
+ * @param[out] timing: the ticks
+ *
+ * @return ws2812_status_t: WS2812_ERRORPARAMETER when the clock cannot
+ *                          make the bits within the tolerance
+ **/
+ws2812_status_t ws2812_timing ( ws2812_type_t           type,
+                                uint32_t                tim_hz,
+                                ws2812_timing_t * const timing )
+{
+    const ws2812_part_t * part;
+    uint32_t              period;
+    uint32_t              t0h;
+    uint32_t              t1h;
+    uint64_t              reset;
+
+    if ( NULL == timing )
+    {
+        LOG( LOG_LEVEL_ERR, "Input parameter is null" );
+        return WS2812_ERRORPARAMETER;
+    }
+    else if ( (uint32_t)type >= WS2812_TYPES || 0U == tim_hz )
+    {
+        LOG( LOG_LEVEL_ERR, "WS2812 type %u or clock 0",
+                            (unsigned int)type );
+        return WS2812_ERRORPARAMETER;
+    }
+    part = &s_parts[type];
+
+    /***************** 1. Nearest ticks *******************/
+    period = __ticks( tim_hz, part->bit_ns );
+    t0h    = __ticks( tim_hz, part->t0h_ns );
+    t1h    = __ticks( tim_hz, part->t1h_ns );
+
+    /***************** 2. Tolerance ***********************/
+    if ( 0U == t0h || t0h >= t1h || t1h >= period ||
+         period > WS2812_MAX_PERIOD                   ||
+         0U != __off( tim_hz, period, part->bit_ns )  ||
+         0U != __off( tim_hz, t0h,    part->t0h_ns )  ||
+         0U != __off( tim_hz, t1h,    part->t1h_ns ) )
+    {
+        LOG( LOG_LEVEL_ERR, "WS2812 timer clock %u Hz out of tolerance",
+                            (unsigned int)tim_hz );
+        return WS2812_ERRORPARAMETER;
+    }
+
+    /***************** 3. Reset ***************************/
+    // whole bits of the real period, rounded up
+    reset = ( (uint64_t)part->reset_ns * tim_hz +
+              (uint64_t)period * WS2812_NS_PER_S - 1U ) /
+            ( (uint64_t)period * WS2812_NS_PER_S );
+    timing->tim_hz      = tim_hz;
+    timing->period      = period;
+    timing->t0h         = (uint16_t)t0h;
+    timing->t1h         = (uint16_t)t1h;
+    timing->reset_slots = ( (uint32_t)reset + 1U + 7U ) & ~7U;
+    return WS2812_OK;
+}
+
+/**
+ * @brief: Duties of bytes, most significant bit first, a slot per bit
+ *
+ * @param[in]  timing: ticks of a 0 and a 1
+ * @param[in]  bytes:  in the order of the wire
+ * @param[in]  num:    bytes
+ * @param[out] slots:  8 * num duties
+ **/
+BSP_RAMFUNC void ws2812_encode ( const ws2812_timing_t * const timing,
+                                 const uint8_t         *       bytes,
+                                 uint32_t                      num,
+                                 uint16_t              *       slots )
+{
+    const uint16_t t0h = timing->t0h;
+    const uint16_t t1h = timing->t1h;
+    uint32_t       b;
+
+    while ( 0U != num-- )
+    {
+        b = *bytes++;
+        slots[0] = ( 0U != ( b & 0x80U ) ) ? t1h : t0h;
+        slots[1] = ( 0U != ( b & 0x40U ) ) ? t1h : t0h;
+        slots[2] = ( 0U != ( b & 0x20U ) ) ? t1h : t0h;
+        slots[3] = ( 0U != ( b & 0x10U ) ) ? t1h : t0h;
+        slots[4] = ( 0U != ( b & 0x08U ) ) ? t1h : t0h;
+        slots[5] = ( 0U != ( b & 0x04U ) ) ? t1h : t0h;
+        slots[6] = ( 0U != ( b & 0x02U ) ) ? t1h : t0h;
+        slots[7] = ( 0U != ( b & 0x01U ) ) ? t1h : t0h;
+        slots   += 8;
+    }
+}
+
+/**
+ * @brief: Instantiate a bsp_ws2812_t
+ * @steps:
+ *      1. Adding the hardware and OS interfaces into the instance
+ *      2. Pixels of the strip all off, idle
+ *
+ * @param[in]  strip:       Pointer to a instance of bsp_ws2812_t
+ * @param[in]  hw_ops:      Pointer to a instance of ws2812_hw_operation_t
+ * @param[in]  os_critical: Pointer to a instance of os_critical_t
+ * @param[in]  type:        part on the strip
+ * @param[in]  pixels:      frame buffer, leds * 3 bytes, * 4 for RGBW
+ * @param[in]  leds:        LEDs on the strip
+ *
+ * @return ws2812_status_t: execute result of this function
+ **/
+ws2812_status_t ws2812_inst (
+                              bsp_ws2812_t          * const strip,
+                              ws2812_hw_operation_t * const hw_ops,
+                              os_critical_t         * const os_critical,
+                              ws2812_type_t                 type,
+                              uint8_t               * const pixels,
+                              uint32_t                      leds
+                                                                      )
+{
+    /********** 1. Checking the input parameters **********/
+    if ( NULL == strip                               ||
+         NULL == hw_ops                              ||
+         NULL == hw_ops->pf_ws2812_clock_hz          ||
+         NULL == hw_ops->pf_ws2812_dma_start         ||
+         NULL == hw_ops->pf_ws2812_dma_stop          ||
+         NULL == os_critical                         ||
+         NULL == os_critical->pf_os_critical_enter   ||
+         NULL == os_critical->pf_os_critical_exit    ||
+         NULL == pixels                              ||
+         (uint32_t)type >= WS2812_TYPES              ||
+         0U == leds || leds > 0xFFFFFFFFU / 32U )
+    {
+        LOG( LOG_LEVEL_ERR, "Input parameter is null" );
+        return WS2812_ERRORPARAMETER;
+    }
+
+    /************** 2. Checking the resource **************/
+    if ( WS2812_INITED == strip->is_initialized )
+    {
+        LOG( LOG_LEVEL_WARN, "WS2812 strip already initialized" );
+        return WS2812_ERRORSOURCE;
+    }
+
+    /************** 3. Adding the interfaces **************/
+    // 3.1 mount external interfaces
+    strip->p_hw_operation_inst = hw_ops;
+    strip->p_os_critical       = os_critical;
+
+    /************* 4. Initialize the instance *************/
+    strip->type        = type;
+    strip->pixels      = pixels;
+    strip->leds        = leds;
+    strip->bpp         = s_parts[type].bpp;
+    strip->data_slots  = leds * strip->bpp * 8U;
+    strip->signal      = NULL;
+    strip->bits        = 0U;
+    // timing at the first show, from the clock of that moment
+    memset( &strip->timing, 0, sizeof( strip->timing ) );
+    memset( pixels, 0, leds * strip->bpp );
+    strip->pos         = 0U;
+    strip->drain       = 0U;
+    strip->expect      = 0U;
+    strip->busy        = 0U;
+    strip->pending     = 0U;
+    strip->frames      = 0U;
+    strip->refills     = 0U;
+    strip->late        = 0U;
+    strip->errors      = 0U;
+
+    strip->is_initialized = WS2812_INITED;
+    return WS2812_OK;
+}
+
+/**
+ * @brief: Colour of one LED in the frame buffer, shown by ws2812_show
+ * @steps:
+ *      1. Bytes in the order of the wire: green, red, blue, white
+ *
+ * @param[in]  strip: Pointer to a instance of bsp_ws2812_t
+ * @param[in]  index: LED, 0 is the nearest to the data input
+ * @param[in]  color: 0xWWRRGGBB, WS2812_RGB or WS2812_RGBW
+ *
+ * @return ws2812_status_t: execute result of this function
+ **/
+BSP_RAMFUNC ws2812_status_t ws2812_set_pixel ( bsp_ws2812_t * const strip,
+                                               uint32_t             index,
+                                               uint32_t             color )
+{
+    uint8_t * p;
+
+    if ( NULL == strip )
+    {
+        LOG( LOG_LEVEL_ERR, "Input parameter is null" );
+        return WS2812_ERRORPARAMETER;
+    }
+    else if ( WS2812_INITED != strip->is_initialized )
+    {
+        LOG( LOG_LEVEL_ERR, "WS2812 strip not initialized" );
+        return WS2812_ERRORSOURCE;
+    }
+    else if ( index >= strip->leds )
+    {
+        LOG( LOG_LEVEL_ERR, "WS2812 pixel %u out of the strip",
+                            (unsigned int)index );
+        return WS2812_ERRORPARAMETER;
+    }
+
+    /****************** 1. Wire order *********************/
+    p    = &strip->pixels[index * strip->bpp];
+    p[0] = (uint8_t)( color >>  8 );
+    p[1] = (uint8_t)( color >> 16 );
+    p[2] = (uint8_t)( color       );
+    if ( 4U == strip->bpp )
+    {
+        p[3] = (uint8_t)( color >> 24 );
+    }
+    return WS2812_OK;
+}
+
+/**
+ * @brief: Send the frame buffer to the strip, task context, returns at once
+ * @steps:
+ *      1. Streaming already: one more frame after it
+ *      2. Timer clock changed: timing again
+ *      3. Both halves of the ring encoded, DMA started
+ *
+ * @param[in]  strip: Pointer to a instance of bsp_ws2812_t
+ *
+ * @return ws2812_status_t: execute result of this function
+ **/
+ws2812_status_t ws2812_show ( bsp_ws2812_t * const strip )
+{
+    ws2812_hw_operation_t * hw;
+    uint32_t                tim_hz;
+    ws2812_status_t         ret = __ready( strip );
+
+    if ( WS2812_OK != ret )
+    {
+        return ret;
+    }
+    hw = strip->p_hw_operation_inst;
+
+    /***************** 1. Streaming ***********************/
+    strip->p_os_critical->pf_os_critical_enter();
+    if ( 0U != strip->busy )
+    {
+        strip->pending = 1U;
+        strip->p_os_critical->pf_os_critical_exit();
+        return WS2812_OK;
+    }
+    strip->busy = 1U;
+    strip->p_os_critical->pf_os_critical_exit();
+
+    /***************** 2. Timing **************************/
+    tim_hz = hw->pf_ws2812_clock_hz();
+    if ( tim_hz != strip->timing.tim_hz )
+    {
+        ret = ws2812_timing( strip->type, tim_hz, &strip->timing );
+        if ( WS2812_OK != ret )
+        {
+            strip->busy = 0U;
+            return ret;
+        }
+    }
+
+    /***************** 3. Start ***************************/
+    // no interrupt of the strip until the start: no critical section
+    strip->pos     = 0U;
+    strip->drain   = 0U;
+    strip->expect  = 0U;
+    strip->pending = 0U;
+    __refill( strip, 0U );
+    __refill( strip, 1U );
+    if ( WS2812_OK != hw->pf_ws2812_dma_start( strip->ring, WS2812_RING_SLOTS,
+                                               strip->timing.period ) )
+    {
+        LOG( LOG_LEVEL_ERR, "WS2812 DMA start failed" );
+        hw->pf_ws2812_dma_stop();
+        strip->errors++;
+        strip->busy = 0U;
+        return WS2812_ERROR;
+    }
+    return WS2812_OK;
+}
+
+/**
+ * @brief: Half or full transfer of the ring, from the DMA interrupt
+ * @steps:
+ *      1. Out of turn: an interrupt was lost, the strip got an old half
+ *      2. The half with the end of the last frame sent: stop, notify
+ *      3. Else encode the half just sent again
+ *
+ * @param[in]  strip: Pointer to a instance of bsp_ws2812_t
+ * @param[in]  half:  0: first half sent (half transfer), 1: second (full),
+ *                    WS2812_DMA_ERROR: transfer error
+ **/
+BSP_RAMFUNC void ws2812_dma_isr ( bsp_ws2812_t * const strip, uint32_t half )
+{
+    // the tasks touch busy and pending in a critical section only
+    if ( NULL == strip || 0U == strip->busy )
+    {
+        return;
+    }
+
+    /***************** 1. Out of turn *********************/
+    if ( half < WS2812_DMA_ERROR && half != strip->expect )
+    {
+        strip->late++;
+    }
+    strip->expect = ( half + 1U ) & 1U;
+
+    /***************** 2. Stop ****************************/
+    if ( WS2812_DMA_ERROR <= half ||
+         ( 0U != strip->drain && 0U == --strip->drain &&
+           0U == strip->pending ) )
+    {
+        strip->p_hw_operation_inst->pf_ws2812_dma_stop();
+        if ( WS2812_DMA_ERROR <= half )
+        {
+            strip->errors++;
+            strip->pending = 0U;
+        }
+        else
+        {
+            strip->frames++;
+        }
+        strip->busy = 0U;
+        if ( NULL != strip->signal )
+        {
+            signal_set_isr( strip->signal, strip->bits );
+        }
+        return;
+    }
+
+    /***************** 3. Refill **************************/
+    __refill( strip, half );
+}
+
+/**
+ * @brief: One pixel as a LED: colour or off, shown at once
+ *
+ * @param[in]  strip: Pointer to a instance of bsp_ws2812_t
+ * @param[in]  index: LED
+ * @param[in]  color: when on
+ * @param[in]  on:    1: color, 0: off
+ *
+ * @return led_inst_status_t: for the pf_led_on/pf_led_off of the core
+ **/
+led_inst_status_t ws2812_led_set ( bsp_ws2812_t * const strip,
+                                   uint32_t             index,
+                                   uint32_t             color,
+                                   uint32_t             on )
+{
+    ws2812_status_t ret;
+
+    ret = ws2812_set_pixel( strip, index, ( 0U != on ) ? color : 0U );
+    if ( WS2812_OK == ret )
+    {
+        ret = ws2812_show( strip );
+    }
+    switch ( ret )
+    {
+    case WS2812_OK:
+        return LED_INST_OK;
+    case WS2812_ERRORSOURCE:
+        return LED_INST_ERRORSOURCE;
+    case WS2812_ERRORPARAMETER:
+        return LED_INST_ERRORPARAMETER;
+    case WS2812_ERRORISR:
+        return LED_INST_ERRORISR;
+    default:
+        return LED_INST_ERROR;
+    }
+}
+
+//******************************** Defines **********************************//
@@ -0,0 +1,252 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_msgpool.h
+ *
+ * @par dependencies
+ * - stdint.h
+ * - FreeRTOS.h
+ * - queue.h
+ *
+ * @author Damian
+ *
+ * @brief Provide zero-copy message passing: fixed-size buffers taken from a
+ *        pool and handed over through a queue of pointers.
+ *
+ * Processing flow:
+ *
+ * producer: msgpool_alloc -> fill the buffer -> msgq_send
+ * consumer: msgq_receive  -> use the buffer  -> msgpool_free
+ *
+ * Only the pointer goes through the FreeRTOS queue, the payload is never
+ * copied, so the cost of a message does not depend on its size.
+ *
+ * When MSGPOOL_TRACK_OWNER is defined (default unless RELEASE_BUILD, the
+ * define of the homework_06_release target), every block records its state
+ * and owner task and every illegal hand-over (double free, use after send,
+ * foreign pointer...) is logged and rejected.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+#ifndef __BSP_MSGPOOL_H__
+#define __BSP_MSGPOOL_H__
+
+//******************************** Includes *********************************//
+
+#include <stdint.h>
+#include <stddef.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+//******************************** Includes *********************************//
+
+typedef struct bsp_msgpool bsp_msgpool_t;
+typedef struct bsp_msgq    bsp_msgq_t;
+
+//******************************** Defines **********************************//
+
+#ifndef RELEASE_BUILD
+#define MSGPOOL_TRACK_OWNER                 /* track ownership of blocks     */
+#endif /* RELEASE_BUILD */
+
+#define MSGPOOL_ALIGN           8U          /* alignment of every payload    */
+#define MSGPOOL_WAIT_FOREVER    0xFFFFFFFFU /* block until done              */
+
+/* Bytes of storage needed for num blocks of size bytes                     */
+#define MSGPOOL_STORAGE_SIZE( size, num )                                     \
+        ( ( MSGPOOL_HDR_SIZE +                                                \
+            ( ( (size) + MSGPOOL_ALIGN - 1U ) & ~( MSGPOOL_ALIGN - 1U ) ) )   \
+          * (num) )
+
+typedef enum
+{
+    MSGPOOL_INITED     = 0,         /* msgpool initialized                   */
+    MSGPOOL_NOT_INITED = 1,         /* msgpool not initialized               */
+} msgpool_init_t;
+
+typedef enum
+{
+    MSGPOOL_OK              = 0,     /* MSGPOOL operate successfully         */
+    MSGPOOL_ERROR           = 1,     /* MSGPOOL error without case matched   */
+    MSGPOOL_ERRORTIMEOUT    = 2,     /* MSGPOOL operate failed with timeout  */
+    MSGPOOL_ERRORSOURCE     = 3,     /* MSGPOOL resource or ownership error  */
+    MSGPOOL_ERRORPARAMETER  = 4,     /* MSGPOOL parameter error              */
+    MSGPOOL_ERRORNOMEMORY   = 5,     /* MSGPOOL no free block                */
+    MSGPOOL_ERRORISR        = 6,     /* MSGPOOL not allowed in ISR context   */
+    MSGPOOL_RESERVED        = 0xFF,  /* MSGPOOL reserved                     */
+} msgpool_status_t;
+
+typedef enum
+{
+    MSGPOOL_BLOCK_FREE      = 0,     /* block in the free list               */
+    MSGPOOL_BLOCK_ALLOCATED = 1,     /* block owned by the producer          */
+    MSGPOOL_BLOCK_QUEUED    = 2,     /* block in a msgq, owned by nobody     */
+    MSGPOOL_BLOCK_RECEIVED  = 3,     /* block owned by the consumer          */
+} msgpool_block_state_t;
+
+typedef struct msgpool_block
+{
+    struct msgpool_block  * next;                 /* free list link          */
+#ifdef MSGPOOL_TRACK_OWNER
+    bsp_msgpool_t         * pool;                 /* pool of the block       */
+    TaskHandle_t            owner;                /* NULL when owned by ISR  */
+    msgpool_block_state_t   state;                /* hand-over state         */
+#endif /* MSGPOOL_TRACK_OWNER */
+} msgpool_block_t;
+
+#define MSGPOOL_HDR_SIZE                                                      \
+        ( ( sizeof( msgpool_block_t ) + MSGPOOL_ALIGN - 1U )                  \
+          & ~( MSGPOOL_ALIGN - 1U ) )
+
+typedef struct bsp_msgpool
+{
+    //************************** Internal status ****************************//
+    msgpool_init_t      is_initialized;               /* record init status  */
+    msgpool_block_t     * free_list;                  /* free blocks         */
+    uint32_t            free_num;                     /* free block count    */
+    uint32_t            free_min;                     /* low watermark       */
+
+    //****************************** Property *******************************//
+    uint8_t             * storage;                    /* blocks storage      */
+    uint32_t            block_size;                   /* payload bytes       */
+    uint32_t            block_stride;                 /* header + payload    */
+    uint32_t            block_num;                    /* number of blocks    */
+} bsp_msgpool_t;
+
+typedef struct bsp_msgq
+{
+    //************************** Internal status ****************************//
+    msgpool_init_t      is_initialized;               /* record init status  */
+
+    //************************ Interface from RTOS **************************//
+    QueueHandle_t       queue;                        /* queue of pointers   */
+} bsp_msgq_t;
+
+//******************************** Defines **********************************//
+
+//******************************* Declaring *********************************//
+
+/**
+ * @brief: Instantiate a bsp_msgpool_t on a caller provided storage
+ * @steps:
+ *      1. Split the storage into aligned blocks
+ *      2. Chain all the blocks into the free list
+ *
+ * @param[in]  pool:         Pointer to a instance of bsp_msgpool_t
+ * @param[in]  storage:      MSGPOOL_ALIGN aligned storage of the blocks
+ * @param[in]  storage_size: bytes of storage, see MSGPOOL_STORAGE_SIZE
+ * @param[in]  block_size:   payload bytes of every block
+ *
+ * @return msgpool_status_t: execute result of this function
+ **/
+msgpool_status_t msgpool_instantiate (
+                                       bsp_msgpool_t * const pool,
+                                       void          * const storage,
+                                       uint32_t              storage_size,
+                                       uint32_t              block_size
+                                                                        );
+
+/**
+ * @brief: Take a block from the pool, task context
+ *
+ * @param[in]  pool: Pointer to a instance of bsp_msgpool_t
+ * @param[out] buf:  payload of the block, owned by the caller
+ *
+ * @return msgpool_status_t: execute result of this function
+ **/
+msgpool_status_t msgpool_alloc ( bsp_msgpool_t * const pool,
+                                 void **         const buf   );
+
+/**
+ * @brief: Take a block from the pool, ISR context
+ *
+ * @param[in]  pool: Pointer to a instance of bsp_msgpool_t
+ * @param[out] buf:  payload of the block, owned by the caller
+ *
+ * @return msgpool_status_t: execute result of this function
+ **/
+msgpool_status_t msgpool_alloc_isr ( bsp_msgpool_t * const pool,
+                                     void **         const buf   );
+
+/**
+ * @brief: Give a block back to the pool, task context
+ *
+ * @param[in]  pool: Pointer to a instance of bsp_msgpool_t
+ * @param[in]  buf:  payload returned by msgpool_alloc or msgq_receive
+ *
+ * @return msgpool_status_t: execute result of this function
+ **/
+msgpool_status_t msgpool_free ( bsp_msgpool_t * const pool,
+                                void *          const buf   );
+
+/**
+ * @brief: Give a block back to the pool, ISR context
+ *
+ * @param[in]  pool: Pointer to a instance of bsp_msgpool_t
+ * @param[in]  buf:  payload returned by msgpool_alloc or msgq_receive
+ *
+ * @return msgpool_status_t: execute result of this function
+ **/
+msgpool_status_t msgpool_free_isr ( bsp_msgpool_t * const pool,
+                                    void *          const buf   );
+
+/**
+ * @brief: Instantiate a bsp_msgq_t, a queue of pool block pointers
+ *
+ * @param[in]  msgq:  Pointer to a instance of bsp_msgq_t
+ * @param[in]  depth: max number of queued pointers
+ *
+ * @return msgpool_status_t: execute result of this function
+ **/
+msgpool_status_t msgq_instantiate ( bsp_msgq_t * const msgq,
+                                    uint32_t           depth );
+
+/**
+ * @brief: Hand a block over to the queue, task context
+ * @steps:
+ *      1. Mark the block as queued, the caller must not touch it any more
+ *      2. Send its pointer
+ *
+ * @param[in]  msgq:       Pointer to a instance of bsp_msgq_t
+ * @param[in]  buf:        payload owned by the caller
+ * @param[in]  timeout_ms: max wait while the queue is full
+ *
+ * @return msgpool_status_t: execute result of this function
+ **/
+msgpool_status_t msgq_send ( bsp_msgq_t * const msgq,
+                             void *       const buf,
+                             uint32_t           timeout_ms );
+
+/**
+ * @brief: Hand a block over to the queue, ISR context
+ *
+ * @param[in]  msgq: Pointer to a instance of bsp_msgq_t
+ * @param[in]  buf:  payload owned by the caller
+ *
+ * @return msgpool_status_t: execute result of this function
+ **/
+msgpool_status_t msgq_send_isr ( bsp_msgq_t * const msgq,
+                                 void *       const buf   );
+
+/**
+ * @brief: Take a block from the queue, the caller becomes its owner
+ *
+ * @param[in]  msgq:       Pointer to a instance of bsp_msgq_t
+ * @param[out] buf:        received payload
+ * @param[in]  timeout_ms: max wait while the queue is empty
+ *
+ * @return msgpool_status_t: execute result of this function
+ **/
+msgpool_status_t msgq_receive ( bsp_msgq_t * const msgq,
+                                void **      const buf,
+                                uint32_t           timeout_ms );
+
+//******************************* Declaring *********************************//
+#endif // __BSP_MSGPOOL_H__
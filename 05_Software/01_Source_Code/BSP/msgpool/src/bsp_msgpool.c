@@ -0,0 +1,586 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_msgpool.c
+ *
+ * @par dependencies
+ * - bsp_msgpool.h
+ *
+ * @author Damian
+ *
+ * @brief Provide zero-copy message passing: fixed-size buffers taken from a
+ *        pool and handed over through a queue of pointers.
+ *
+ * Processing flow:
+ *
+ * Call directly.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+//******************************** Includes *********************************//
+
+#include "bsp_msgpool.h"
+#include "bsp_common.h"
+
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+BSP_STATUS_CHECK( MSGPOOL );
+
+#define MSGPOOL_HDR( buf )  \
+        ( (msgpool_block_t *)( (uint8_t *)(buf) - MSGPOOL_HDR_SIZE ) )
+#define MSGPOOL_BUF( hdr )  \
+        ( (void *)( (uint8_t *)(hdr) + MSGPOOL_HDR_SIZE ) )
+
+/**
+ * @brief: Convert a millisecond timeout into ticks
+ *
+ * @param[in]  timeout_ms: timeout, MSGPOOL_WAIT_FOREVER to block
+ *
+ * @return TickType_t: timeout in ticks
+ **/
+static TickType_t __ms_to_ticks ( uint32_t timeout_ms )
+{
+    return ( MSGPOOL_WAIT_FOREVER == timeout_ms ) ? portMAX_DELAY
+                                                  : pdMS_TO_TICKS( timeout_ms );
+}
+
+/**
+ * @brief: Check that a payload pointer belongs to the pool
+ *
+ * @param[in]  pool: Pointer to a instance of bsp_msgpool_t
+ * @param[in]  buf:  payload pointer to check
+ *
+ * @return msgpool_status_t: execute result of this function
+ **/
+static msgpool_status_t __buf_check ( bsp_msgpool_t * const pool,
+                                      void *          const buf   )
+{
+    uintptr_t offset;
+
+    if ( (uint8_t *)buf < pool->storage + MSGPOOL_HDR_SIZE )
+    {
+        return MSGPOOL_ERRORPARAMETER;
+    }
+    offset = (uintptr_t)( (uint8_t *)MSGPOOL_HDR( buf ) - pool->storage );
+    if ( offset >= (uintptr_t)pool->block_stride * pool->block_num ||
+         0U     != offset % pool->block_stride
+                                                                    )
+    {
+        return MSGPOOL_ERRORPARAMETER;
+    }
+    return MSGPOOL_OK;
+}
+
+#ifdef MSGPOOL_TRACK_OWNER
+/**
+ * @brief: Move a block to a new state if the hand-over is legal, called
+ *         inside the critical section so it never logs by itself
+ * @steps:
+ *      1. Check the block comes from a pool and is in the expected state
+ *      2. Record the new state and its owner
+ *
+ * @param[in]  hdr:      header of the block
+ * @param[in]  expect:   bit mask of the states allowed before the move
+ * @param[in]  next:     state after the move
+ * @param[in]  from_isr: 1 when called from ISR context
+ *
+ * @return msgpool_status_t: execute result of this function
+ **/
+static msgpool_status_t __owner_move ( msgpool_block_t     * const hdr,
+                                       uint32_t                    expect,
+                                       msgpool_block_state_t       next,
+                                       uint32_t                    from_isr )
+{
+    if ( NULL == hdr->pool ||
+         MSGPOOL_OK != __buf_check( hdr->pool, MSGPOOL_BUF( hdr ) ) )
+    {
+        return MSGPOOL_ERRORPARAMETER;
+    }
+    if ( 0U == ( expect & ( 1UL << hdr->state ) ) )
+    {
+        return MSGPOOL_ERRORSOURCE;
+    }
+    if ( ( MSGPOOL_BLOCK_ALLOCATED == hdr->state ||
+           MSGPOOL_BLOCK_RECEIVED  == hdr->state    ) &&
+         0U == from_isr                                 &&
+         NULL != hdr->owner                             &&
+         hdr->owner != xTaskGetCurrentTaskHandle()
+                                                        )
+    {
+        return MSGPOOL_ERRORSOURCE;
+    }
+    hdr->state = next;
+    hdr->owner = ( 0U == from_isr && MSGPOOL_BLOCK_QUEUED != next &&
+                   MSGPOOL_BLOCK_FREE != next )
+                 ? xTaskGetCurrentTaskHandle() : NULL;
+    return MSGPOOL_OK;
+}
+#endif /* MSGPOOL_TRACK_OWNER */
+
+/**
+ * @brief: Pop a block from the free list, caller holds the critical section
+ *
+ * @param[in]  pool: Pointer to a instance of bsp_msgpool_t
+ *
+ * @return msgpool_block_t *: header of the block, NULL if the pool is empty
+ **/
+static msgpool_block_t * __pool_pop ( bsp_msgpool_t * const pool )
+{
+    msgpool_block_t * hdr = pool->free_list;
+
+    if ( NULL != hdr )
+    {
+        pool->free_list = hdr->next;
+        pool->free_num--;
+        if ( pool->free_num < pool->free_min )
+        {
+            pool->free_min = pool->free_num;
+        }
+    }
+    return hdr;
+}
+
+/**
+ * @brief: Push a block into the free list, caller holds the critical section
+ *
+ * @param[in]  pool: Pointer to a instance of bsp_msgpool_t
+ * @param[in]  hdr:  header of the block
+ **/
+static void __pool_push ( bsp_msgpool_t   * const pool,
+                          msgpool_block_t * const hdr   )
+{
+    hdr->next       = pool->free_list;
+    pool->free_list = hdr;
+    pool->free_num++;
+}
+
+/**
+ * @brief: Instantiate a bsp_msgpool_t on a caller provided storage
+ * @steps:
+ *      1. Split the storage into aligned blocks
+ *      2. Chain all the blocks into the free list
+ *
+ * @param[in]  pool:         Pointer to a instance of bsp_msgpool_t
+ * @param[in]  storage:      MSGPOOL_ALIGN aligned storage of the blocks
+ * @param[in]  storage_size: bytes of storage, see MSGPOOL_STORAGE_SIZE
+ * @param[in]  block_size:   payload bytes of every block
+ *
+ * @return msgpool_status_t: execute result of this function
+ **/
+msgpool_status_t msgpool_instantiate (
+                                       bsp_msgpool_t * const pool,
+                                       void          * const storage,
+                                       uint32_t              storage_size,
+                                       uint32_t              block_size
+                                                                        )
+{
+    msgpool_block_t * hdr;
+
+    /********** 1. Checking the input parameters **********/
+    if ( NULL == pool    ||
+         NULL == storage ||
+         0U   == block_size
+                            )
+    {
+        LOG( LOG_LEVEL_ERR, "Input parameter is null" );
+        return MSGPOOL_ERRORPARAMETER;
+    }
+    if ( 0U != ( (uintptr_t)storage & ( MSGPOOL_ALIGN - 1U ) ) )
+    {
+        LOG( LOG_LEVEL_ERR, "Msg pool storage not aligned" );
+        return MSGPOOL_ERRORPARAMETER;
+    }
+
+    /************* 2. Split the storage *******************/
+    pool->storage      = (uint8_t *)storage;
+    pool->block_size   = ( block_size + MSGPOOL_ALIGN - 1U )
+                         & ~( MSGPOOL_ALIGN - 1U );
+    pool->block_stride = MSGPOOL_HDR_SIZE + pool->block_size;
+    pool->block_num    = storage_size / pool->block_stride;
+    if ( 0U == pool->block_num )
+    {
+        LOG( LOG_LEVEL_ERR, "Msg pool storage too small" );
+        return MSGPOOL_ERRORNOMEMORY;
+    }
+
+    /************* 3. Build the free list *****************/
+    pool->free_list = NULL;
+    pool->free_num  = 0U;
+    for ( uint32_t i = pool->block_num; i > 0U; --i )
+    {
+        hdr = (msgpool_block_t *)( pool->storage +
+                                   ( i - 1U ) * pool->block_stride );
+#ifdef MSGPOOL_TRACK_OWNER
+        hdr->pool  = pool;
+        hdr->owner = NULL;
+        hdr->state = MSGPOOL_BLOCK_FREE;
+#endif /* MSGPOOL_TRACK_OWNER */
+        __pool_push( pool, hdr );
+    }
+    pool->free_min       = pool->free_num;
+    pool->is_initialized = MSGPOOL_INITED;
+    return MSGPOOL_OK;
+}
+
+/**
+ * @brief: Take a block from the pool, shared by the task and ISR variants
+ *
+ * @param[in]  pool:     Pointer to a instance of bsp_msgpool_t
+ * @param[out] buf:      payload of the block
+ * @param[in]  from_isr: 1 when called from ISR context
+ *
+ * @return msgpool_status_t: execute result of this function
+ **/
+static msgpool_status_t __alloc ( bsp_msgpool_t * const pool,
+                                  void **         const buf,
+                                  uint32_t              from_isr )
+{
+    msgpool_block_t * hdr;
+    UBaseType_t       mask = 0U;
+
+    if ( NULL == pool || NULL == buf )
+    {
+        return MSGPOOL_ERRORPARAMETER;
+    }
+    if ( MSGPOOL_INITED != pool->is_initialized )
+    {
+        return MSGPOOL_ERRORSOURCE;
+    }
+
+    if ( 0U == from_isr )
+        taskENTER_CRITICAL();
+    else
+        mask = taskENTER_CRITICAL_FROM_ISR();
+
+    hdr = __pool_pop( pool );
+#ifdef MSGPOOL_TRACK_OWNER
+    if ( NULL != hdr )
+    {
+        (void)__owner_move( hdr, 1UL << MSGPOOL_BLOCK_FREE,
+                            MSGPOOL_BLOCK_ALLOCATED, from_isr );
+    }
+#endif /* MSGPOOL_TRACK_OWNER */
+
+    if ( 0U == from_isr )
+        taskEXIT_CRITICAL();
+    else
+        taskEXIT_CRITICAL_FROM_ISR( mask );
+
+    if ( NULL == hdr )
+    {
+        *buf = NULL;
+        return MSGPOOL_ERRORNOMEMORY;
+    }
+    *buf = MSGPOOL_BUF( hdr );
+    return MSGPOOL_OK;
+}
+
+/**
+ * @brief: Give a block back, shared by the task and ISR variants
+ *
+ * @param[in]  pool:     Pointer to a instance of bsp_msgpool_t
+ * @param[in]  buf:      payload of the block
+ * @param[in]  from_isr: 1 when called from ISR context
+ *
+ * @return msgpool_status_t: execute result of this function
+ **/
+static msgpool_status_t __free ( bsp_msgpool_t * const pool,
+                                 void *          const buf,
+                                 uint32_t              from_isr )
+{
+    msgpool_status_t ret  = MSGPOOL_OK;
+    UBaseType_t      mask = 0U;
+
+    if ( NULL == pool || NULL == buf )
+    {
+        return MSGPOOL_ERRORPARAMETER;
+    }
+    if ( MSGPOOL_OK != __buf_check( pool, buf ) )
+    {
+        LOG( LOG_LEVEL_ERR, "Msg buffer %p not from this pool", buf );
+        return MSGPOOL_ERRORPARAMETER;
+    }
+
+    if ( 0U == from_isr )
+        taskENTER_CRITICAL();
+    else
+        mask = taskENTER_CRITICAL_FROM_ISR();
+
+#ifdef MSGPOOL_TRACK_OWNER
+    ret = __owner_move( MSGPOOL_HDR( buf ),
+                        ( 1UL << MSGPOOL_BLOCK_ALLOCATED ) |
+                        ( 1UL << MSGPOOL_BLOCK_RECEIVED  ),
+                        MSGPOOL_BLOCK_FREE, from_isr        );
+    if ( MSGPOOL_OK == ret )
+#endif /* MSGPOOL_TRACK_OWNER */
+    {
+        __pool_push( pool, MSGPOOL_HDR( buf ) );
+    }
+
+    if ( 0U == from_isr )
+        taskEXIT_CRITICAL();
+    else
+        taskEXIT_CRITICAL_FROM_ISR( mask );
+
+    if ( MSGPOOL_OK != ret && 0U == from_isr )
+    {
+        LOG( LOG_LEVEL_ERR, "Msg buffer %p freed by a non-owner", buf );
+    }
+    return ret;
+}
+
+/**
+ * @brief: Take a block from the pool, task context
+ *
+ * @param[in]  pool: Pointer to a instance of bsp_msgpool_t
+ * @param[out] buf:  payload of the block, owned by the caller
+ *
+ * @return msgpool_status_t: execute result of this function
+ **/
+msgpool_status_t msgpool_alloc ( bsp_msgpool_t * const pool,
+                                 void **         const buf   )
+{
+    return __alloc( pool, buf, 0U );
+}
+
+/**
+ * @brief: Take a block from the pool, ISR context
+ *
+ * @param[in]  pool: Pointer to a instance of bsp_msgpool_t
+ * @param[out] buf:  payload of the block, owned by the caller
+ *
+ * @return msgpool_status_t: execute result of this function
+ **/
+msgpool_status_t msgpool_alloc_isr ( bsp_msgpool_t * const pool,
+                                     void **         const buf   )
+{
+    return __alloc( pool, buf, 1U );
+}
+
+/**
+ * @brief: Give a block back to the pool, task context
+ *
+ * @param[in]  pool: Pointer to a instance of bsp_msgpool_t
+ * @param[in]  buf:  payload returned by msgpool_alloc or msgq_receive
+ *
+ * @return msgpool_status_t: execute result of this function
+ **/
+msgpool_status_t msgpool_free ( bsp_msgpool_t * const pool,
+                                void *          const buf   )
+{
+    return __free( pool, buf, 0U );
+}
+
+/**
+ * @brief: Give a block back to the pool, ISR context
+ *
+ * @param[in]  pool: Pointer to a instance of bsp_msgpool_t
+ * @param[in]  buf:  payload returned by msgpool_alloc or msgq_receive
+ *
+ * @return msgpool_status_t: execute result of this function
+ **/
+msgpool_status_t msgpool_free_isr ( bsp_msgpool_t * const pool,
+                                    void *          const buf   )
+{
+    return __free( pool, buf, 1U );
+}
+
+/**
+ * @brief: Instantiate a bsp_msgq_t, a queue of pool block pointers
+ *
+ * @param[in]  msgq:  Pointer to a instance of bsp_msgq_t
+ * @param[in]  depth: max number of queued pointers
+ *
+ * @return msgpool_status_t: execute result of this function
+ **/
+msgpool_status_t msgq_instantiate ( bsp_msgq_t * const msgq,
+                                    uint32_t           depth )
+{
+    if ( NULL == msgq || 0U == depth )
+    {
+        LOG( LOG_LEVEL_ERR, "Input parameter is null" );
+        return MSGPOOL_ERRORPARAMETER;
+    }
+
+    msgq->queue = xQueueCreate( depth, sizeof( void * ) );
+    if ( NULL == msgq->queue )
+    {
+        LOG( LOG_LEVEL_ERR, "Msg queue create failed" );
+        return MSGPOOL_ERRORNOMEMORY;
+    }
+    msgq->is_initialized = MSGPOOL_INITED;
+    return MSGPOOL_OK;
+}
+
+/**
+ * @brief: Hand a block over to the queue, task context
+ * @steps:
+ *      1. Mark the block as queued, the caller must not touch it any more
+ *      2. Send its pointer
+ *
+ * @param[in]  msgq:       Pointer to a instance of bsp_msgq_t
+ * @param[in]  buf:        payload owned by the caller
+ * @param[in]  timeout_ms: max wait while the queue is full
+ *
+ * @return msgpool_status_t: execute result of this function
+ **/
+msgpool_status_t msgq_send ( bsp_msgq_t * const msgq,
+                             void *       const buf,
+                             uint32_t           timeout_ms )
+{
+#ifdef MSGPOOL_TRACK_OWNER
+    msgpool_block_state_t   state;
+    TaskHandle_t            owner;
+    msgpool_status_t        ret;
+#endif /* MSGPOOL_TRACK_OWNER */
+
+    if ( NULL == msgq || NULL == buf )
+    {
+        return MSGPOOL_ERRORPARAMETER;
+    }
+    if ( MSGPOOL_INITED != msgq->is_initialized )
+    {
+        return MSGPOOL_ERRORSOURCE;
+    }
+
+    /************** 1. Hand the ownership over ***************/
+#ifdef MSGPOOL_TRACK_OWNER
+    taskENTER_CRITICAL();
+    state = MSGPOOL_HDR( buf )->state;
+    owner = MSGPOOL_HDR( buf )->owner;
+    ret   = __owner_move( MSGPOOL_HDR( buf ),
+                          ( 1UL << MSGPOOL_BLOCK_ALLOCATED ) |
+                          ( 1UL << MSGPOOL_BLOCK_RECEIVED  ),
+                          MSGPOOL_BLOCK_QUEUED, 0U            );
+    taskEXIT_CRITICAL();
+    if ( MSGPOOL_OK != ret )
+    {
+        LOG( LOG_LEVEL_ERR, "Msg buffer %p sent by a non-owner", buf );
+        return ret;
+    }
+#endif /* MSGPOOL_TRACK_OWNER */
+
+    /******************* 2. Send the pointer *****************/
+    if ( pdPASS != xQueueSend( msgq->queue, &buf, __ms_to_ticks( timeout_ms ) ) )
+    {
+#ifdef MSGPOOL_TRACK_OWNER
+        // still owned by the caller, as before the send
+        taskENTER_CRITICAL();
+        MSGPOOL_HDR( buf )->state = state;
+        MSGPOOL_HDR( buf )->owner = owner;
+        taskEXIT_CRITICAL();
+#endif /* MSGPOOL_TRACK_OWNER */
+        return MSGPOOL_ERRORTIMEOUT;
+    }
+    return MSGPOOL_OK;
+}
+
+/**
+ * @brief: Hand a block over to the queue, ISR context
+ *
+ * @param[in]  msgq: Pointer to a instance of bsp_msgq_t
+ * @param[in]  buf:  payload owned by the caller
+ *
+ * @return msgpool_status_t: execute result of this function
+ **/
+msgpool_status_t msgq_send_isr ( bsp_msgq_t * const msgq,
+                                 void *       const buf   )
+{
+    BaseType_t              woken = pdFALSE;
+#ifdef MSGPOOL_TRACK_OWNER
+    msgpool_block_state_t   state;
+    TaskHandle_t            owner;
+    UBaseType_t             mask;
+    msgpool_status_t        ret;
+#endif /* MSGPOOL_TRACK_OWNER */
+
+    if ( NULL == msgq || NULL == buf )
+    {
+        return MSGPOOL_ERRORPARAMETER;
+    }
+    if ( MSGPOOL_INITED != msgq->is_initialized )
+    {
+        return MSGPOOL_ERRORSOURCE;
+    }
+
+#ifdef MSGPOOL_TRACK_OWNER
+    mask  = taskENTER_CRITICAL_FROM_ISR();
+    state = MSGPOOL_HDR( buf )->state;
+    owner = MSGPOOL_HDR( buf )->owner;
+    ret   = __owner_move( MSGPOOL_HDR( buf ),
+                          ( 1UL << MSGPOOL_BLOCK_ALLOCATED ) |
+                          ( 1UL << MSGPOOL_BLOCK_RECEIVED  ),
+                          MSGPOOL_BLOCK_QUEUED, 1U            );
+    taskEXIT_CRITICAL_FROM_ISR( mask );
+    if ( MSGPOOL_OK != ret )
+    {
+        return ret;
+    }
+#endif /* MSGPOOL_TRACK_OWNER */
+
+    if ( pdPASS != xQueueSendFromISR( msgq->queue, &buf, &woken ) )
+    {
+#ifdef MSGPOOL_TRACK_OWNER
+        mask = taskENTER_CRITICAL_FROM_ISR();
+        MSGPOOL_HDR( buf )->state = state;
+        MSGPOOL_HDR( buf )->owner = owner;
+        taskEXIT_CRITICAL_FROM_ISR( mask );
+#endif /* MSGPOOL_TRACK_OWNER */
+        return MSGPOOL_ERRORNOMEMORY;
+    }
+    portYIELD_FROM_ISR( woken );
+    return MSGPOOL_OK;
+}
+
+/**
+ * @brief: Take a block from the queue, the caller becomes its owner
+ *
+ * @param[in]  msgq:       Pointer to a instance of bsp_msgq_t
+ * @param[out] buf:        received payload
+ * @param[in]  timeout_ms: max wait while the queue is empty
+ *
+ * @return msgpool_status_t: execute result of this function
+ **/
+msgpool_status_t msgq_receive ( bsp_msgq_t * const msgq,
+                                void **      const buf,
+                                uint32_t           timeout_ms )
+{
+    msgpool_status_t ret = MSGPOOL_OK;
+
+    if ( NULL == msgq || NULL == buf )
+    {
+        return MSGPOOL_ERRORPARAMETER;
+    }
+    if ( MSGPOOL_INITED != msgq->is_initialized )
+    {
+        return MSGPOOL_ERRORSOURCE;
+    }
+
+    if ( pdPASS != xQueueReceive( msgq->queue, buf, __ms_to_ticks( timeout_ms ) ) )
+    {
+        *buf = NULL;
+        return MSGPOOL_ERRORTIMEOUT;
+    }
+
+#ifdef MSGPOOL_TRACK_OWNER
+    taskENTER_CRITICAL();
+    ret = __owner_move( MSGPOOL_HDR( *buf ), 1UL << MSGPOOL_BLOCK_QUEUED,
+                        MSGPOOL_BLOCK_RECEIVED, 0U                       );
+    taskEXIT_CRITICAL();
+    if ( MSGPOOL_OK != ret )
+    {
+        LOG( LOG_LEVEL_ERR, "Msg buffer %p received twice", *buf );
+    }
+#endif /* MSGPOOL_TRACK_OWNER */
+    return ret;
+}
+
+//******************************** Defines **********************************//
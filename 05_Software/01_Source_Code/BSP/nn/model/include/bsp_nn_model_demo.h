@@ -0,0 +1,53 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_nn_model_demo.h
+ *
+ * @par dependencies
+ * - bsp_nn_runtime.h
+ *
+ * @author Damian
+ *
+ * @brief Model "demo" for the nn runtime, its test input and output.
+ *
+ * Processing flow:
+ *
+ * nn_runtime_inst( &rt, &nn_model_demo, ... )
+ *
+ * Generated by 08_Tools/nn_model/nn_model_gen.py --name demo --seed 1,
+ * do not edit.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+#ifndef __BSP_NN_MODEL_DEMO_H__
+#define __BSP_NN_MODEL_DEMO_H__
+
+//******************************** Includes *********************************//
+
+#include "bsp_nn_runtime.h"
+
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+#define NN_MODEL_DEMO_INPUT_LEN     96U   /* bytes of the input      */
+#define NN_MODEL_DEMO_OUTPUT_LEN    4U    /* bytes of the output     */
+#define NN_MODEL_DEMO_ARENA_SIZE    480U  /* planned activations     */
+
+//******************************** Defines **********************************//
+
+//******************************* Declaring *********************************//
+
+extern const nn_model_t nn_model_demo;
+extern const int8_t     nn_model_demo_input[NN_MODEL_DEMO_INPUT_LEN];
+extern const int8_t     nn_model_demo_expected[NN_MODEL_DEMO_OUTPUT_LEN];
+
+//******************************* Declaring *********************************//
+#endif // __BSP_NN_MODEL_DEMO_H__
+
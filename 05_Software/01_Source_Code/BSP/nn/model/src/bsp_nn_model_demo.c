@@ -0,0 +1,316 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_nn_model_demo.c
+ *
+ * @par dependencies
+ * - bsp_nn_runtime.h
+ *
+ * @author Damian
+ *
+ * @brief Model "demo" for the nn runtime, its test input and output.
+ *
+ * Processing flow:
+ *
+ * Call directly.
+ *
+ * Generated by 08_Tools/nn_model/nn_model_gen.py --name demo --seed 1,
+ * do not edit.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+//******************************** Includes *********************************//
+
+#include "bsp_nn_model_demo.h"
+
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+static const int8_t  s_l0_weights[120] =
+{
+    80, -94, 5, 72, 16, -75, -18, 116, -113, -4, 95, -34,
+    18, 14, -76, 113, 2, -22, -3, 81, -36, -21, -39, -127,
+    10, 11, 32, 74, 29, -43, -10, 26, -120, 78, -69, 35,
+    -82, 13, 22, -81, 93, -104, 77, 14, 77, 90, 82, 111,
+    -62, -119, 88, 114, 45, -109, -106, 95, -123, -12, -124, 66,
+    66, -56, -64, -59, -99, 77, 32, -80, -39, -53, -110, -85,
+    -87, -62, 8, 116, -84, 41, -58, 38, 55, -52, -11, 52,
+    -45, 0, -6, -98, -121, -48, -29, -40, -20, 76, -79, -61,
+    -100, -63, 103, 59, 3, 123, -74, 120, 28, -17, 82, 122,
+    -122, -70, -123, -26, -90, -118, 57, 118, -86, -13, 53, 2,
+};
+
+static const int32_t s_l0_bias[8] =
+{
+    290, 73, -454, 773, 484, 27,
+    -450, 241,
+};
+
+static const int32_t s_l0_multiplier[8] =
+{
+    1201595404, 1201595404, 1201595404, 1201595404, 1201595404, 1201595404,
+    1201595404, 1201595404,
+};
+
+static const int32_t s_l0_shift[8] =
+{
+    -6, -6, -6, -6, -6, -6, -6, -6,
+};
+
+static const int8_t  s_l2_weights[24] =
+{
+    -26, 45, 20, 78, -45, 41, 34, -18, -112, 61, -51, -95,
+    120, -73, 97, -115, -49, -109, 92, -108, -48, 107, 113, -51,
+};
+
+static const int32_t s_l2_bias[8] =
+{
+    440, -151, -447, -887, 684, -834,
+    577, 834,
+};
+
+static const int32_t s_l2_multiplier[8] =
+{
+    2020170801, 2020170801, 2020170801, 2020170801, 2020170801, 2020170801,
+    2020170801, 2020170801,
+};
+
+static const int32_t s_l2_shift[8] =
+{
+    -7, -7, -7, -7, -7, -7, -7, -7,
+};
+
+static const int8_t  s_l3_weights[128] =
+{
+    18, -10, -84, 84, 95, 95, 122, 72, 53, 32, 3, -118,
+    -31, -76, -39, -102, -75, 19, 45, 102, -17, 24, -78, -1,
+    -101, 113, 43, -28, -52, 2, 0, -123, -44, 29, 96, -25,
+    103, -55, -123, -87, -76, 92, -44, 80, 125, 17, 73, -93,
+    -41, -18, -73, -59, 45, -103, 87, -30, 111, 13, -39, 107,
+    98, 87, 48, 9, -3, 69, 125, 9, -67, -111, 58, -117,
+    -106, -93, -84, -85, 106, 10, -73, -59, 67, -42, 26, 2,
+    88, -62, -33, -41, -40, -98, -53, -67, 95, 114, 27, 72,
+    117, 56, 100, -2, -93, 21, 14, 70, -101, -45, -117, -23,
+    -109, -30, 94, 126, 74, -90, 85, -95, -40, -98, 30, 23,
+    73, 110, -31, -108, 19, 13, -70, 17,
+};
+
+static const int32_t s_l3_bias[16] =
+{
+    -705, -393, 658, 109, 716, -71,
+    -375, 484, 552, -821, 287, -688,
+    -648, 649, -775, -439,
+};
+
+static const int32_t s_l3_multiplier[16] =
+{
+    1609281529, 1609281529, 1609281529, 1609281529, 1609281529, 1609281529,
+    1609281529, 1609281529, 1609281529, 1609281529, 1609281529, 1609281529,
+    1609281529, 1609281529, 1609281529, 1609281529,
+};
+
+static const int32_t s_l3_shift[16] =
+{
+    -7, -7, -7, -7, -7, -7, -7, -7, -7, -7, -7, -7,
+    -7, -7, -7, -7,
+};
+
+static const int8_t  s_l5_weights[64] =
+{
+    125, 23, -20, -86, -98, -12, -85, 47, -66, -87, 63, 89,
+    -101, -16, 106, 119, -31, 79, 121, 11, 105, 82, -52, 13,
+    -63, 55, -5, -47, -102, -74, 39, -46, -117, -121, -125, 74,
+    124, 109, -52, 58, 25, -46, -12, -27, -47, -25, -111, -111,
+    106, -46, 121, 26, 121, -11, -99, -63, -72, 73, 31, 72,
+    123, 101, 11, 95,
+};
+
+static const int32_t s_l5_bias[4] =
+{
+    236, 203, -302, 52,
+};
+
+static const int32_t s_l5_multiplier[4] =
+{
+    1427674390, 1427674390, 1427674390, 1427674390,
+};
+
+static const int32_t s_l5_shift[4] =
+{
+    -6, -6, -6, -6,
+};
+
+static const int32_t s_l6_multiplier[1] =
+{
+    2112548984,
+};
+
+static const int32_t s_l6_shift[1] =
+{
+    20,
+};
+
+static const nn_tensor_t s_tensors[8] =
+{
+    {   1U,  32U,   3U },
+    {   1U,  32U,   8U },
+    {   1U,  16U,   8U },
+    {   1U,  16U,   8U },
+    {   1U,  16U,  16U },
+    {   1U,   1U,  16U },
+    {   1U,   1U,   4U },
+    {   1U,   1U,   4U },
+};
+
+static const uint32_t s_offsets[8] =
+{
+    0U, 96U, 352U, 0U, 128U, 0U, 16U, 0U,
+};
+
+static const nn_layer_t s_layers[7] =
+{
+    {
+        .type          = NN_LAYER_CONV,
+        .input         = 0U,
+        .output        = 1U,
+        .kernel_h      = 1U,
+        .kernel_w      = 5U,
+        .stride_h      = 1U,
+        .stride_w      = 1U,
+        .pad_h         = 0U,
+        .pad_w         = 2U,
+        .input_offset  = 3,
+        .output_offset = -128,
+        .act_min       = -128,
+        .act_max       = 127,
+        .weights       = s_l0_weights,
+        .bias          = s_l0_bias,
+        .multiplier    = s_l0_multiplier,
+        .shift         = s_l0_shift,
+    },
+    {
+        .type          = NN_LAYER_MAXPOOL,
+        .input         = 1U,
+        .output        = 2U,
+        .kernel_h      = 1U,
+        .kernel_w      = 2U,
+        .stride_h      = 1U,
+        .stride_w      = 2U,
+        .pad_h         = 0U,
+        .pad_w         = 0U,
+        .act_min       = -128,
+        .act_max       = 127,
+    },
+    {
+        .type          = NN_LAYER_DWCONV,
+        .input         = 2U,
+        .output        = 3U,
+        .kernel_h      = 1U,
+        .kernel_w      = 3U,
+        .stride_h      = 1U,
+        .stride_w      = 1U,
+        .pad_h         = 0U,
+        .pad_w         = 1U,
+        .input_offset  = 128,
+        .output_offset = -128,
+        .act_min       = -128,
+        .act_max       = 127,
+        .weights       = s_l2_weights,
+        .bias          = s_l2_bias,
+        .multiplier    = s_l2_multiplier,
+        .shift         = s_l2_shift,
+    },
+    {
+        .type          = NN_LAYER_CONV,
+        .input         = 3U,
+        .output        = 4U,
+        .kernel_h      = 1U,
+        .kernel_w      = 1U,
+        .stride_h      = 1U,
+        .stride_w      = 1U,
+        .pad_h         = 0U,
+        .pad_w         = 0U,
+        .input_offset  = 128,
+        .output_offset = -128,
+        .act_min       = -128,
+        .act_max       = 127,
+        .weights       = s_l3_weights,
+        .bias          = s_l3_bias,
+        .multiplier    = s_l3_multiplier,
+        .shift         = s_l3_shift,
+    },
+    {
+        .type          = NN_LAYER_AVGPOOL,
+        .input         = 4U,
+        .output        = 5U,
+        .kernel_h      = 1U,
+        .kernel_w      = 16U,
+        .stride_h      = 1U,
+        .stride_w      = 16U,
+        .pad_h         = 0U,
+        .pad_w         = 0U,
+        .act_min       = -128,
+        .act_max       = 127,
+    },
+    {
+        .type          = NN_LAYER_FC,
+        .input         = 5U,
+        .output        = 6U,
+        .input_offset  = 128,
+        .output_offset = 0,
+        .act_min       = -128,
+        .act_max       = 127,
+        .weights       = s_l5_weights,
+        .bias          = s_l5_bias,
+        .multiplier    = s_l5_multiplier,
+        .shift         = s_l5_shift,
+    },
+    {
+        .type          = NN_LAYER_SOFTMAX,
+        .input         = 6U,
+        .output        = 7U,
+        .act_min       = -128,
+        .act_max       = 127,
+        .multiplier    = s_l6_multiplier,
+        .shift         = s_l6_shift,
+        .diff_min      = -1984,
+    },
+};
+
+const nn_model_t nn_model_demo =
+{
+    .magic      = NN_MODEL_MAGIC,
+    .name       = "demo",
+    .tensor_num = 8U,
+    .layer_num  = 7U,
+    .input      = 0U,
+    .output     = 7U,
+    .tensors    = s_tensors,
+    .layers     = s_layers,
+    .offsets    = s_offsets,
+    .arena_size = NN_MODEL_DEMO_ARENA_SIZE,
+};
+
+const int8_t nn_model_demo_input[NN_MODEL_DEMO_INPUT_LEN] =
+{
+    -12, 6, 4, 13, 38, 51, 42, 67, 42, 40, 61, -5, 67, 6, -60, 66,
+    -32, -47, 63, -71, -14, 39, -55, 50, 11, -45, 40, -11, -4, -5, -32, 32,
+    -66, -46, 55, -70, -50, 53, 3, -74, 30, 63, -76, -31, 57, -53, -48, -8,
+    -35, -61, -65, -22, -33, -48, -2, 1, -12, 13, 47, 52, 31, 62, 56, 58,
+    48, -8, 60, 24, -60, 57, -28, -68, 40, -55, 14, 39, -68, 46, 17, -29,
+    57, -4, 9, -15, -26, 52, -59, -46, 55, -54, -48, 38, 10, -58, 25, 61,
+};
+
+const int8_t nn_model_demo_expected[NN_MODEL_DEMO_OUTPUT_LEN] =
+{
+    26, -118, -118, -47,
+};
+
+//******************************** Defines **********************************//
@@ -0,0 +1,224 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_nn_runtime.h
+ *
+ * @par dependencies
+ * - arm_nnfunctions.h
+ *
+ * @author Damian
+ *
+ * @brief Run a static int8 graph with the CMSIS-NN s8 kernels, all the
+ *        activations live in one caller provided arena.
+ *
+ * Processing flow:
+ *
+ * nn_runtime_inst (plan the arena once)
+ *      -> write nn_runtime_input -> nn_runtime_invoke -> read nn_runtime_output
+ *
+ *  layer       kernel                            tensors
+ *  CONV        arm_convolve_wrapper_s8           [H, W, C_IN] -> [H, W, C_OUT]
+ *  DWCONV      arm_depthwise_conv_wrapper_s8     channel multiplier 1
+ *  FC          arm_fully_connected_s8            flattened input -> [1, 1, N]
+ *  MAXPOOL     arm_max_pool_s8
+ *  AVGPOOL     arm_avgpool_s8
+ *  SOFTMAX     arm_softmax_s8                    over the channels
+ *
+ * A model is a const nn_model_t generated offline by
+ * 08_Tools/nn_model/nn_model_gen.py, it stays in flash. Tensors are int8 with
+ * a batch of 1, the quantisation of a tensor is only known to the layers
+ * through their offsets, multipliers and shifts (TFLite micro convention).
+ *
+ * Arena: every tensor lives from the layer that writes it to the last layer
+ * that reads it, the input from the start and the output to the end. The
+ * tensors are placed first fit in order of first use, two tensors share
+ * bytes only when their lives do not overlap. The scratch of the kernels
+ * (im2col, sums) follows the activations, sized for the largest layer.
+ *
+ * A model may carry offsets planned offline by 08_Tools/nn_model/
+ * nn_arena_plan.py (the best of first fit and greedy by size), they are
+ * checked against the lifetimes at nn_runtime_inst and used instead of the
+ * first fit above.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+#ifndef __BSP_NN_RUNTIME_H__
+#define __BSP_NN_RUNTIME_H__
+
+//******************************** Includes *********************************//
+
+#include "arm_nnfunctions.h"
+#include <stdint.h>
+#include <stddef.h>
+
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+#define NN_MODEL_MAGIC          0x314D4E4EU /* "NNM1"                        */
+#define MAX_NN_TENSOR_NUM       16U         /* Max tensors of a model        */
+#define MAX_NN_LAYER_NUM        16U         /* Max layers of a model         */
+#define NN_ARENA_ALIGN          4U          /* alignment of every tensor     */
+
+typedef enum
+{
+    NN_RUNTIME_INITED     = 0,      /* NN runtime initialized                */
+    NN_RUNTIME_NOT_INITED = 1,      /* NN runtime not initialized            */
+} nn_runtime_init_t;
+
+typedef enum
+{
+    NN_OK               = 0,         /* NN operate successfully              */
+    NN_ERROR            = 1,         /* NN kernel refused the layer          */
+    NN_ERRORTIMEOUT     = 2,         /* NN operate timeout                   */
+    NN_ERRORSOURCE      = 3,         /* NN runtime not ready                 */
+    NN_ERRORPARAMETER   = 4,         /* NN parameter or model error          */
+    NN_ERRORNOMEMORY    = 5,         /* NN arena too small                   */
+    NN_ERRORISR         = 6,         /* NN not allowed in ISR context        */
+    NN_RESERVED         = 0xFF,      /* NN reserved                          */
+} nn_status_t;
+
+typedef enum
+{
+    NN_LAYER_CONV       = 0,         /* arm_convolve_wrapper_s8              */
+    NN_LAYER_DWCONV     = 1,         /* arm_depthwise_conv_wrapper_s8        */
+    NN_LAYER_FC         = 2,         /* arm_fully_connected_s8               */
+    NN_LAYER_MAXPOOL    = 3,         /* arm_max_pool_s8                      */
+    NN_LAYER_AVGPOOL    = 4,         /* arm_avgpool_s8                       */
+    NN_LAYER_SOFTMAX    = 5,         /* arm_softmax_s8                       */
+} nn_layer_type_t;
+
+typedef struct
+{
+    uint16_t              h;                          /* height              */
+    uint16_t              w;                          /* width               */
+    uint16_t              c;                          /* channels            */
+} nn_tensor_t;
+
+typedef struct
+{
+    uint8_t               type;           /* nn_layer_type_t                 */
+    uint8_t               input;          /* index of the input tensor       */
+    uint8_t               output;         /* index of the output tensor      */
+    uint8_t               kernel_h;       /* conv / pool window              */
+    uint8_t               kernel_w;
+    uint8_t               stride_h;
+    uint8_t               stride_w;
+    uint8_t               pad_h;
+    uint8_t               pad_w;
+    int8_t                output_offset;  /* zero point of the output        */
+    int16_t               input_offset;   /* minus zero point of the input   */
+    int8_t                act_min;        /* clamp of the output             */
+    int8_t                act_max;
+    const int8_t          * weights;      /* conv [C_OUT, KH, KW, C_IN],
+                                             dwconv [KH, KW, C],
+                                             fc [C_OUT, H * W * C_IN]        */
+    const int32_t         * bias;         /* one per output channel          */
+    const int32_t         * multiplier;   /* per channel, one for fc/softmax */
+    const int32_t         * shift;        /* per channel, one for fc/softmax */
+    int32_t               diff_min;       /* softmax only                    */
+} nn_layer_t;
+
+typedef struct
+{
+    uint32_t              magic;                      /* NN_MODEL_MAGIC      */
+    const char            * name;                     /* printable name      */
+    uint8_t               tensor_num;                 /* num of tensors      */
+    uint8_t               layer_num;                  /* num of layers       */
+    uint8_t               input;                      /* input tensor        */
+    uint8_t               output;                     /* output tensor       */
+    const nn_tensor_t     * tensors;                  /* shapes              */
+    const nn_layer_t      * layers;                   /* in execution order  */
+    const uint32_t        * offsets;                  /* planned, or NULL    */
+    uint32_t              arena_size;                 /* planned activations */
+} nn_model_t;
+
+typedef struct
+{
+    //************************** Internal status ****************************//
+    nn_runtime_init_t     is_initialized;             /* record init status  */
+    uint32_t              invokes;                    /* invokes finished    */
+
+    //****************************** Property *******************************//
+    const nn_model_t      * p_model;                  /* model in flash      */
+    int8_t                * arena;                    /* caller buffer       */
+    uint32_t              arena_size;                 /* bytes of the arena  */
+    uint32_t              offset[MAX_NN_TENSOR_NUM];  /* tensor offsets      */
+    uint32_t              act_size;                   /* activation bytes    */
+    uint32_t              scratch_size;               /* kernel scratch      */
+} nn_runtime_t;
+
+//******************************** Defines **********************************//
+
+//******************************* Declaring *********************************//
+
+/**
+ * @brief: Instantiate a nn_runtime_t and plan the arena
+ * @steps:
+ *      1. Check the model, every index and every weight pointer
+ *      2. Take the offsets planned offline when the model has them
+ *      3. Otherwise place the tensors first fit in order of first use
+ *      4. Scratch of the largest layer after the activations
+ *
+ * @param[in]  rt:         Pointer to a instance of nn_runtime_t
+ * @param[in]  model:      model, kept by pointer
+ * @param[in]  arena:      4 byte aligned buffer, kept by pointer
+ * @param[in]  arena_size: bytes of the arena
+ *
+ * @return nn_status_t: NN_ERRORNOMEMORY when the plan does not fit, the
+ *                      needed size is in rt->act_size + rt->scratch_size,
+ *                      NN_ERRORPARAMETER when the offline plan is wrong
+ **/
+nn_status_t nn_runtime_inst (
+                              nn_runtime_t     * const rt,
+                              const nn_model_t * const model,
+                              int8_t           * const arena,
+                              uint32_t                 arena_size
+                                                                   );
+
+/**
+ * @brief: Bytes of the arena the plan needs, scratch included
+ *
+ * @param[in]  rt: Pointer to a instance of nn_runtime_t
+ *
+ * @return uint32_t: 0 when the runtime is not initialized
+ **/
+uint32_t nn_runtime_arena_used ( const nn_runtime_t * const rt );
+
+/**
+ * @brief: Input tensor in the arena, write it before every invoke
+ *
+ * @param[in]  rt: Pointer to a instance of nn_runtime_t
+ *
+ * @return int8_t *: NULL when the runtime is not initialized
+ **/
+int8_t * nn_runtime_input ( nn_runtime_t * const rt );
+
+/**
+ * @brief: Output tensor in the arena, valid until the next invoke
+ *
+ * @param[in]  rt: Pointer to a instance of nn_runtime_t
+ *
+ * @return const int8_t *: NULL when the runtime is not initialized
+ **/
+const int8_t * nn_runtime_output ( const nn_runtime_t * const rt );
+
+/**
+ * @brief: Run every layer of the model once
+ *
+ * The input tensor may be overwritten once its last reader ran.
+ *
+ * @param[in]  rt: Pointer to a instance of nn_runtime_t
+ *
+ * @return nn_status_t: execute result of this function
+ **/
+nn_status_t nn_runtime_invoke ( nn_runtime_t * const rt );
+
+//******************************* Declaring *********************************//
+#endif // __BSP_NN_RUNTIME_H__
@@ -0,0 +1,650 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_nn_runtime.c
+ *
+ * @par dependencies
+ * - bsp_nn_runtime.h
+ * - bsp_common.h
+ *
+ * @author Damian
+ *
+ * @brief Run a static int8 graph with the CMSIS-NN s8 kernels, all the
+ *        activations live in one caller provided arena.
+ *
+ * Processing flow:
+ *
+ * Call directly.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+//******************************** Includes *********************************//
+
+#include "bsp_nn_runtime.h"
+#include "bsp_common.h"
+#include <string.h>
+
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+BSP_STATUS_CHECK( NN );
+
+#define NN_ALIGN_UP(x)      ( ( (x) + NN_ARENA_ALIGN - 1U ) &                 \
+                              ~( NN_ARENA_ALIGN - 1U ) )
+
+typedef struct
+{
+    cmsis_nn_dims         input;                      /* [1, H, W, C_IN]     */
+    cmsis_nn_dims         filter;                     /* per layer type      */
+    cmsis_nn_dims         bias;                       /* [C_OUT]             */
+    cmsis_nn_dims         output;                     /* [1, H, W, C_OUT]    */
+} nn_layer_dims_t;
+
+/**
+ * @brief: Bytes of a tensor
+ **/
+static uint32_t __tensor_size ( const nn_tensor_t * const tensor )
+{
+    return (uint32_t)tensor->h * tensor->w * tensor->c;
+}
+
+/**
+ * @brief: CMSIS-NN dimensions of a layer
+ *
+ * @param[in]  model: model of the layer
+ * @param[in]  layer: the layer
+ * @param[out] dims:  input, filter, bias and output dimensions
+ **/
+static void __layer_dims (
+                           const nn_model_t * const model,
+                           const nn_layer_t * const layer,
+                           nn_layer_dims_t  * const dims
+                                                        )
+{
+    const nn_tensor_t * in  = &model->tensors[layer->input];
+    const nn_tensor_t * out = &model->tensors[layer->output];
+
+    dims->input.n  = 1;
+    dims->input.h  = in->h;
+    dims->input.w  = in->w;
+    dims->input.c  = in->c;
+    dims->output.n = 1;
+    dims->output.h = out->h;
+    dims->output.w = out->w;
+    dims->output.c = out->c;
+    dims->bias.n   = 1;
+    dims->bias.h   = 1;
+    dims->bias.w   = 1;
+    dims->bias.c   = out->c;
+
+    switch ( layer->type )
+    {
+    case NN_LAYER_CONV:
+        dims->filter.n = out->c;
+        dims->filter.c = in->c;
+        break;
+    case NN_LAYER_FC:
+        // accumulation depth in n, output depth in c
+        dims->filter.n = (int32_t)__tensor_size( in );
+        dims->filter.c = out->c;
+        break;
+    default:
+        dims->filter.n = 1;
+        dims->filter.c = out->c;
+        break;
+    }
+    dims->filter.h = layer->kernel_h;
+    dims->filter.w = layer->kernel_w;
+}
+
+/**
+ * @brief: Convolution parameters of a layer
+ **/
+static void __conv_params (
+                            const nn_layer_t     * const layer,
+                            cmsis_nn_conv_params * const params
+                                                                )
+{
+    params->input_offset    = layer->input_offset;
+    params->output_offset   = layer->output_offset;
+    params->stride.h        = layer->stride_h;
+    params->stride.w        = layer->stride_w;
+    params->padding.h       = layer->pad_h;
+    params->padding.w       = layer->pad_w;
+    params->dilation.h      = 1;
+    params->dilation.w      = 1;
+    params->activation.min  = layer->act_min;
+    params->activation.max  = layer->act_max;
+}
+
+/**
+ * @brief: Depthwise convolution parameters of a layer
+ **/
+static void __dw_conv_params (
+                               const nn_layer_t        * const layer,
+                               cmsis_nn_dw_conv_params * const params
+                                                                      )
+{
+    params->input_offset    = layer->input_offset;
+    params->output_offset   = layer->output_offset;
+    params->ch_mult         = 1;
+    params->stride.h        = layer->stride_h;
+    params->stride.w        = layer->stride_w;
+    params->padding.h       = layer->pad_h;
+    params->padding.w       = layer->pad_w;
+    params->dilation.h      = 1;
+    params->dilation.w      = 1;
+    params->activation.min  = layer->act_min;
+    params->activation.max  = layer->act_max;
+}
+
+/**
+ * @brief: Pooling parameters of a layer
+ **/
+static void __pool_params (
+                            const nn_layer_t     * const layer,
+                            cmsis_nn_pool_params * const params
+                                                                )
+{
+    params->stride.h        = layer->stride_h;
+    params->stride.w        = layer->stride_w;
+    params->padding.h       = layer->pad_h;
+    params->padding.w       = layer->pad_w;
+    params->activation.min  = layer->act_min;
+    params->activation.max  = layer->act_max;
+}
+
+/**
+ * @brief: Scratch bytes a layer asks from the kernels
+ *
+ * @param[in]  model: model of the layer
+ * @param[in]  layer: the layer
+ *
+ * @return uint32_t: bytes, 0 when the kernel needs none
+ **/
+static uint32_t __layer_scratch (
+                                  const nn_model_t * const model,
+                                  const nn_layer_t * const layer
+                                                                 )
+{
+    nn_layer_dims_t         dims;
+    cmsis_nn_conv_params    conv;
+    cmsis_nn_dw_conv_params dw_conv;
+    int32_t                 size = 0;
+
+    __layer_dims( model, layer, &dims );
+    switch ( layer->type )
+    {
+    case NN_LAYER_CONV:
+        __conv_params( layer, &conv );
+        size = arm_convolve_wrapper_s8_get_buffer_size( &conv, &dims.input,
+                                                        &dims.filter,
+                                                        &dims.output );
+        break;
+    case NN_LAYER_DWCONV:
+        __dw_conv_params( layer, &dw_conv );
+        size = arm_depthwise_conv_wrapper_s8_get_buffer_size( &dw_conv,
+                                                              &dims.input,
+                                                              &dims.filter,
+                                                              &dims.output );
+        break;
+    case NN_LAYER_FC:
+        size = arm_fully_connected_s8_get_buffer_size( &dims.filter );
+        break;
+    case NN_LAYER_AVGPOOL:
+        size = arm_avgpool_s8_get_buffer_size( dims.output.w, dims.input.c );
+        break;
+    default:
+        break;
+    }
+    return ( 0 < size ) ? (uint32_t)size : 0U;
+}
+
+/**
+ * @brief: Check the indices, the kinds and the weights of a model
+ *
+ * @param[in]  model: the model
+ *
+ * @return nn_status_t: execute result of this function
+ **/
+static nn_status_t __model_check ( const nn_model_t * const model )
+{
+    const nn_layer_t * layer;
+
+    if ( NN_MODEL_MAGIC != model->magic                  ||
+         NULL == model->tensors || NULL == model->layers ||
+         0U == model->layer_num                          ||
+         MAX_NN_TENSOR_NUM < model->tensor_num           ||
+         MAX_NN_LAYER_NUM  < model->layer_num            ||
+         model->tensor_num <= model->input               ||
+         model->tensor_num <= model->output
+                                                           )
+    {
+        return NN_ERRORPARAMETER;
+    }
+    for ( uint32_t i = 0; i < model->layer_num; ++i )
+    {
+        layer = &model->layers[i];
+        if ( model->tensor_num <= layer->input  ||
+             model->tensor_num <= layer->output ||
+             layer->input == layer->output      ||
+             NN_LAYER_SOFTMAX < layer->type
+                                                  )
+        {
+            return NN_ERRORPARAMETER;
+        }
+        if ( ( NN_LAYER_CONV   == layer->type ||
+               NN_LAYER_DWCONV == layer->type ||
+               NN_LAYER_FC     == layer->type    ) &&
+             ( NULL == layer->weights    || NULL == layer->bias  ||
+               NULL == layer->multiplier || NULL == layer->shift    ) )
+        {
+            return NN_ERRORPARAMETER;
+        }
+        if ( NN_LAYER_SOFTMAX == layer->type &&
+             ( NULL == layer->multiplier || NULL == layer->shift ) )
+        {
+            return NN_ERRORPARAMETER;
+        }
+    }
+    return NN_OK;
+}
+
+/**
+ * @brief: First and last layer of every tensor
+ *
+ * The input lives from the start, the output to the end.
+ *
+ * @param[in]  model: the model
+ * @param[out] first: layer writing each tensor
+ * @param[out] last:  last layer reading each tensor
+ **/
+static void __lifetimes (
+                          const nn_model_t * const model,
+                          uint8_t          * const first,
+                          uint8_t          * const last
+                                                          )
+{
+    memset( first, 0, MAX_NN_TENSOR_NUM );
+    memset( last, 0, MAX_NN_TENSOR_NUM );
+    for ( uint32_t i = 0; i < model->layer_num; ++i )
+    {
+        first[model->layers[i].output] = (uint8_t)i;
+        last[model->layers[i].input]   = (uint8_t)i;
+    }
+    first[model->input]  = 0U;
+    last[model->output]  = model->layer_num;
+}
+
+/**
+ * @brief: Place the tensors first fit in order of first use
+ * @steps:
+ *      1. First and last layer of every tensor
+ *      2. Lowest aligned offset not overlapping a placed tensor whose life
+ *         overlaps, taken in order of first use
+ *
+ * @param[in]  rt: Pointer to a instance of nn_runtime_t
+ *
+ * @return uint32_t: bytes of the activations
+ **/
+static uint32_t __arena_plan ( nn_runtime_t * const rt )
+{
+    const nn_model_t * model = rt->p_model;
+    uint8_t            first[MAX_NN_TENSOR_NUM];
+    uint8_t            last[MAX_NN_TENSOR_NUM];
+    uint8_t            placed[MAX_NN_TENSOR_NUM];
+    uint32_t           placed_num = 0U;
+    uint32_t           size;
+    uint32_t           end;
+    uint32_t           peak = 0U;
+    uint32_t           t;
+    uint8_t            moved;
+
+    /*************** 1. Lifetimes in layers ***************/
+    __lifetimes( model, first, last );
+
+    /*************** 2. First fit *************************/
+    for ( uint32_t order = 0; order <= model->layer_num; ++order )
+    {
+        for ( t = 0; t < model->tensor_num; ++t )
+        {
+            if ( first[t] != order )
+            {
+                continue;
+            }
+            size           = __tensor_size( &model->tensors[t] );
+            rt->offset[t]  = 0U;
+            // move past every live neighbour in the way until none is left
+            do
+            {
+                moved = 0U;
+                for ( uint32_t p = 0; p < placed_num; ++p )
+                {
+                    uint32_t o = placed[p];
+                    end = rt->offset[o] + __tensor_size( &model->tensors[o] );
+                    if ( first[o] <= last[t] && first[t] <= last[o] &&
+                         rt->offset[t] < end &&
+                         rt->offset[o] < rt->offset[t] + size          )
+                    {
+                        rt->offset[t] = NN_ALIGN_UP( end );
+                        moved = 1U;
+                    }
+                }
+            } while ( 0U != moved );
+            placed[placed_num++] = (uint8_t)t;
+            if ( rt->offset[t] + size > peak )
+            {
+                peak = rt->offset[t] + size;
+            }
+        }
+    }
+    return peak;
+}
+
+/**
+ * @brief: Take the offsets planned offline by the model
+ * @steps:
+ *      1. First and last layer of every tensor
+ *      2. Every offset aligned and inside the planned size
+ *      3. No two tensors with overlapping lives share a byte
+ *
+ * A wrong plan would let a layer overwrite a tensor still to be read, so
+ * the plan is checked once here instead of trusted.
+ *
+ * @param[in]  rt: Pointer to a instance of nn_runtime_t
+ *
+ * @return nn_status_t: NN_ERRORPARAMETER when the plan is wrong
+ **/
+static nn_status_t __arena_check ( nn_runtime_t * const rt )
+{
+    const nn_model_t * model = rt->p_model;
+    uint8_t            first[MAX_NN_TENSOR_NUM];
+    uint8_t            last[MAX_NN_TENSOR_NUM];
+    uint32_t           end[MAX_NN_TENSOR_NUM];
+
+    /*************** 1. Lifetimes in layers ***************/
+    __lifetimes( model, first, last );
+
+    /*************** 2. Bounds and alignment **************/
+    for ( uint32_t t = 0; t < model->tensor_num; ++t )
+    {
+        rt->offset[t] = model->offsets[t];
+        end[t]        = rt->offset[t] + __tensor_size( &model->tensors[t] );
+        if ( 0U != ( rt->offset[t] & ( NN_ARENA_ALIGN - 1U ) ) ||
+             end[t] > model->arena_size                            )
+        {
+            return NN_ERRORPARAMETER;
+        }
+    }
+
+    /*************** 3. Overlaps **************************/
+    for ( uint32_t t = 0; t < model->tensor_num; ++t )
+    {
+        for ( uint32_t o = t + 1U; o < model->tensor_num; ++o )
+        {
+            if ( first[o] <= last[t] && first[t] <= last[o] &&
+                 rt->offset[t] < end[o] && rt->offset[o] < end[t] )
+            {
+                return NN_ERRORPARAMETER;
+            }
+        }
+    }
+    return NN_OK;
+}
+
+/**
+ * @brief: Instantiate a nn_runtime_t and plan the arena
+ * @steps:
+ *      1. Check the model, every index and every weight pointer
+ *      2. Take the offsets planned offline when the model has them
+ *      3. Otherwise place the tensors first fit in order of first use
+ *      4. Scratch of the largest layer after the activations
+ *
+ * @param[in]  rt:         Pointer to a instance of nn_runtime_t
+ * @param[in]  model:      model, kept by pointer
+ * @param[in]  arena:      4 byte aligned buffer, kept by pointer
+ * @param[in]  arena_size: bytes of the arena
+ *
+ * @return nn_status_t: NN_ERRORNOMEMORY when the plan does not fit, the
+ *                      needed size is in rt->act_size + rt->scratch_size
+ **/
+nn_status_t nn_runtime_inst (
+                              nn_runtime_t     * const rt,
+                              const nn_model_t * const model,
+                              int8_t           * const arena,
+                              uint32_t                 arena_size
+                                                                   )
+{
+    uint32_t scratch;
+
+    /********** 1. Checking the input parameters **********/
+    if ( NULL == rt || NULL == model || NULL == arena ||
+         0U != ( (uintptr_t)arena & ( NN_ARENA_ALIGN - 1U ) )
+                                                             )
+    {
+        LOG( LOG_LEVEL_ERR, "Input parameter error" );
+        return NN_ERRORPARAMETER;
+    }
+    rt->is_initialized = NN_RUNTIME_NOT_INITED;
+    if ( NN_OK != __model_check( model ) )
+    {
+        LOG( LOG_LEVEL_ERR, "NN model is malformed" );
+        return NN_ERRORPARAMETER;
+    }
+
+    rt->p_model      = model;
+    rt->arena        = arena;
+    rt->arena_size   = arena_size;
+    rt->invokes      = 0U;
+
+    /*************** 2. Offline plan **********************/
+    if ( NULL != model->offsets )
+    {
+        if ( NN_OK != __arena_check( rt ) )
+        {
+            LOG( LOG_LEVEL_ERR, "NN model %s has a wrong arena plan",
+                                model->name );
+            return NN_ERRORPARAMETER;
+        }
+        rt->act_size = model->arena_size;
+    }
+    /*************** 3. Plan the activations here *********/
+    else
+    {
+        rt->act_size = __arena_plan( rt );
+    }
+
+    /*************** 4. Scratch of the kernels ************/
+    rt->scratch_size = 0U;
+    for ( uint32_t i = 0; i < model->layer_num; ++i )
+    {
+        scratch = __layer_scratch( model, &model->layers[i] );
+        if ( scratch > rt->scratch_size )
+        {
+            rt->scratch_size = scratch;
+        }
+    }
+    if ( NN_ALIGN_UP( rt->act_size ) + rt->scratch_size > arena_size )
+    {
+        LOG( LOG_LEVEL_ERR, "NN model %s needs %u bytes of arena, has %u",
+                            model->name,
+                            (unsigned int)( NN_ALIGN_UP( rt->act_size ) +
+                                            rt->scratch_size ),
+                            (unsigned int)arena_size );
+        return NN_ERRORNOMEMORY;
+    }
+
+    rt->is_initialized = NN_RUNTIME_INITED;
+    return NN_OK;
+}
+
+/**
+ * @brief: Bytes of the arena the plan needs, scratch included
+ *
+ * @param[in]  rt: Pointer to a instance of nn_runtime_t
+ *
+ * @return uint32_t: 0 when the runtime is not initialized
+ **/
+uint32_t nn_runtime_arena_used ( const nn_runtime_t * const rt )
+{
+    if ( NULL == rt || NN_RUNTIME_INITED != rt->is_initialized )
+    {
+        return 0U;
+    }
+    return NN_ALIGN_UP( rt->act_size ) + rt->scratch_size;
+}
+
+/**
+ * @brief: Input tensor in the arena, write it before every invoke
+ *
+ * @param[in]  rt: Pointer to a instance of nn_runtime_t
+ *
+ * @return int8_t *: NULL when the runtime is not initialized
+ **/
+int8_t * nn_runtime_input ( nn_runtime_t * const rt )
+{
+    if ( NULL == rt || NN_RUNTIME_INITED != rt->is_initialized )
+    {
+        return NULL;
+    }
+    return &rt->arena[rt->offset[rt->p_model->input]];
+}
+
+/**
+ * @brief: Output tensor in the arena, valid until the next invoke
+ *
+ * @param[in]  rt: Pointer to a instance of nn_runtime_t
+ *
+ * @return const int8_t *: NULL when the runtime is not initialized
+ **/
+const int8_t * nn_runtime_output ( const nn_runtime_t * const rt )
+{
+    if ( NULL == rt || NN_RUNTIME_INITED != rt->is_initialized )
+    {
+        return NULL;
+    }
+    return &rt->arena[rt->offset[rt->p_model->output]];
+}
+
+/**
+ * @brief: Run every layer of the model once
+ * @steps:
+ *      1. Point the kernel context at the scratch after the activations
+ *      2. Dispatch every layer in order to its CMSIS-NN kernel
+ *
+ * @param[in]  rt: Pointer to a instance of nn_runtime_t
+ *
+ * @return nn_status_t: execute result of this function
+ **/
+nn_status_t nn_runtime_invoke ( nn_runtime_t * const rt )
+{
+    const nn_model_t                  * model;
+    const nn_layer_t                  * layer;
+    const int8_t                      * in;
+    int8_t                            * out;
+    nn_layer_dims_t                     dims;
+    cmsis_nn_context                    ctx;
+    cmsis_nn_conv_params                conv;
+    cmsis_nn_dw_conv_params             dw_conv;
+    cmsis_nn_fc_params                  fc;
+    cmsis_nn_pool_params                pool;
+    cmsis_nn_per_channel_quant_params   quant;
+    cmsis_nn_per_tensor_quant_params    quant_tensor;
+    arm_status                          ret = ARM_MATH_SUCCESS;
+
+    if ( NULL == rt )
+    {
+        LOG( LOG_LEVEL_ERR, "Input parameter is null" );
+        return NN_ERRORPARAMETER;
+    }
+    else if ( NN_RUNTIME_INITED != rt->is_initialized )
+    {
+        LOG( LOG_LEVEL_ERR, "NN runtime not initialized" );
+        return NN_ERRORSOURCE;
+    }
+
+    /*************** 1. Scratch context *******************/
+    model    = rt->p_model;
+    ctx.buf  = ( 0U != rt->scratch_size ) ?
+               &rt->arena[NN_ALIGN_UP( rt->act_size )] : NULL;
+    ctx.size = (int32_t)rt->scratch_size;
+
+    /*************** 2. Dispatch the layers ***************/
+    for ( uint32_t i = 0; i < model->layer_num && ARM_MATH_SUCCESS == ret; ++i )
+    {
+        layer = &model->layers[i];
+        in    = &rt->arena[rt->offset[layer->input]];
+        out   = &rt->arena[rt->offset[layer->output]];
+        __layer_dims( model, layer, &dims );
+        // the kernels take the quantisation tables as non const
+        quant.multiplier = (int32_t *)layer->multiplier;
+        quant.shift      = (int32_t *)layer->shift;
+
+        switch ( layer->type )
+        {
+        case NN_LAYER_CONV:
+            __conv_params( layer, &conv );
+            ret = arm_convolve_wrapper_s8( &ctx, &conv, &quant,
+                                           &dims.input, in,
+                                           &dims.filter, layer->weights,
+                                           &dims.bias, layer->bias,
+                                           &dims.output, out );
+            break;
+        case NN_LAYER_DWCONV:
+            __dw_conv_params( layer, &dw_conv );
+            ret = arm_depthwise_conv_wrapper_s8( &ctx, &dw_conv, &quant,
+                                                 &dims.input, in,
+                                                 &dims.filter, layer->weights,
+                                                 &dims.bias, layer->bias,
+                                                 &dims.output, out );
+            break;
+        case NN_LAYER_FC:
+            fc.input_offset            = layer->input_offset;
+            fc.filter_offset           = 0;
+            fc.output_offset           = layer->output_offset;
+            fc.activation.min          = layer->act_min;
+            fc.activation.max          = layer->act_max;
+            quant_tensor.multiplier    = layer->multiplier[0];
+            quant_tensor.shift         = layer->shift[0];
+            ret = arm_fully_connected_s8( &ctx, &fc, &quant_tensor,
+                                          &dims.input, in,
+                                          &dims.filter, layer->weights,
+                                          &dims.bias, layer->bias,
+                                          &dims.output, out );
+            break;
+        case NN_LAYER_MAXPOOL:
+            __pool_params( layer, &pool );
+            ret = arm_max_pool_s8( &ctx, &pool, &dims.input, in,
+                                   &dims.filter, &dims.output, out );
+            break;
+        case NN_LAYER_AVGPOOL:
+            __pool_params( layer, &pool );
+            ret = arm_avgpool_s8( &ctx, &pool, &dims.input, in,
+                                  &dims.filter, &dims.output, out );
+            break;
+        default:
+            arm_softmax_s8( in, dims.input.h * dims.input.w, dims.input.c,
+                            layer->multiplier[0], layer->shift[0],
+                            layer->diff_min, out );
+            break;
+        }
+    }
+    if ( ARM_MATH_SUCCESS != ret )
+    {
+        LOG( LOG_LEVEL_ERR, "NN model %s layer failed %d", model->name,
+                            (int)ret );
+        return NN_ERROR;
+    }
+
+    rt->invokes++;
+    return NN_OK;
+}
+
+//******************************** Defines **********************************//
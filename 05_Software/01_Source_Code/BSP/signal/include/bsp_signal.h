@@ -0,0 +1,157 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_signal.h
+ *
+ * @par dependencies
+ * - stdint.h
+ * - FreeRTOS.h
+ * - task.h
+ *
+ * @author Damian
+ *
+ * @brief Provide a lightweight event signal for BSP drivers, mapped onto the
+ *        direct-to-task notification of the owner task.
+ *
+ * Processing flow:
+ *
+ * signal_instantiate -> signal_set / signal_set_isr (any context)
+ *                    -> signal_wait (owner task only)
+ *
+ * Compared to osEventFlagsSet/osMessageQueuePut the signal needs no kernel
+ * object, and setting it from an ISR wakes the owner directly instead of
+ * going through the timer daemon (xTimerPendFunctionCall).
+ *
+ * The notification value of the owner is used as 32 event bits, so the
+ * owner must not also use osThreadFlags* or xTaskNotify* for other purposes.
+ *
+ * A task owns one signal at most: a wait collects every bit of the
+ * notification, the bits of a second signal of the task would be lost.
+ * The drivers a task uses share its signal, each with bits of its own
+ * (spi_xfer_t, i2c_xfer_t, the ws2812 strip and the LED handler take a
+ * signal and bits). signal_instantiate with an owner and the first wait of
+ * a signal bound to nobody refuse a task owning another signal still bound
+ * to it; the signal of a task is kept in its thread local storage slot
+ * SIGNAL_TLS_INDEX.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+#ifndef __BSP_SIGNAL_H__
+#define __BSP_SIGNAL_H__
+
+//******************************** Includes *********************************//
+
+#include <stdint.h>
+#include <stddef.h>
+#include "FreeRTOS.h"
+#include "task.h"
+
+//******************************** Includes *********************************//
+
+typedef struct bsp_signal bsp_signal_t;
+
+//******************************** Defines **********************************//
+
+#define SIGNAL_WAIT_FOREVER  0xFFFFFFFFU     /* block until a bit is set     */
+#define SIGNAL_TLS_INDEX     0               /* slot of the owned signal     */
+
+#if ( configNUM_THREAD_LOCAL_STORAGE_POINTERS <= SIGNAL_TLS_INDEX )
+#error "bsp_signal needs configNUM_THREAD_LOCAL_STORAGE_POINTERS above 0"
+#endif
+
+typedef enum
+{
+    SIGNAL_INITED     = 0,          /* signal initialized                    */
+    SIGNAL_NOT_INITED = 1,          /* signal not initialized                */
+} signal_init_t;
+
+typedef enum
+{
+    SIGNAL_OK              = 0,      /* SIGNAL operate successfully          */
+    SIGNAL_ERROR           = 1,      /* SIGNAL error without case matched    */
+    SIGNAL_ERRORTIMEOUT    = 2,      /* SIGNAL no bit set before timeout     */
+    SIGNAL_ERRORSOURCE     = 3,      /* SIGNAL unbound, or owner has another */
+    SIGNAL_ERRORPARAMETER  = 4,      /* SIGNAL parameter error               */
+    SIGNAL_ERRORNOMEMORY   = 5,      /* SIGNAL out of memory                 */
+    SIGNAL_ERRORISR        = 6,      /* SIGNAL not allowed in ISR context    */
+    SIGNAL_RESERVED        = 0xFF,   /* SIGNAL reserved                      */
+} signal_status_t;
+
+typedef struct bsp_signal
+{
+    //************************** Internal status ****************************//
+    signal_init_t       is_initialized;               /* record init status  */
+    uint32_t            pending;                      /* bits not consumed   */
+
+    //****************************** Property *******************************//
+    TaskHandle_t        owner;                        /* notified task       */
+} bsp_signal_t;
+
+//******************************** Defines **********************************//
+
+//******************************* Declaring *********************************//
+
+/**
+ * @brief: Instantiate a bsp_signal_t
+ * @steps:
+ *      1. Bind the signal to its owner task, unless it owns another one
+ *
+ * @param[in]  signal: Pointer to a instance of bsp_signal_t
+ * @param[in]  owner:  task to notify, NULL binds the first task that waits
+ *
+ * @return signal_status_t: SIGNAL_ERRORSOURCE when owner has a signal
+ **/
+signal_status_t signal_instantiate (
+                                     bsp_signal_t * const signal,
+                                     TaskHandle_t         owner
+                                                                );
+
+/**
+ * @brief: Set event bits from task context
+ *
+ * @param[in]  signal: Pointer to a instance of bsp_signal_t
+ * @param[in]  bits:   event bits to set, must not be 0
+ *
+ * @return signal_status_t: execute result of this function
+ **/
+signal_status_t signal_set ( bsp_signal_t * const signal, uint32_t bits );
+
+/**
+ * @brief: Set event bits from ISR context, yields on exit if required
+ *
+ * @param[in]  signal: Pointer to a instance of bsp_signal_t
+ * @param[in]  bits:   event bits to set, must not be 0
+ *
+ * @return signal_status_t: execute result of this function
+ **/
+signal_status_t signal_set_isr ( bsp_signal_t * const signal, uint32_t bits );
+
+/**
+ * @brief: Wait for any of the event bits, only callable by the owner; the
+ *         first wait of a signal bound to nobody binds the caller
+ * @steps:
+ *      1. Return the matching bits already collected
+ *      2. Block on the notification and collect the new bits
+ *
+ * @param[in]  signal:     Pointer to a instance of bsp_signal_t
+ * @param[in]  mask:       event bits to wait for
+ * @param[in]  timeout_ms: max wait, SIGNAL_WAIT_FOREVER to block
+ * @param[out] bits:       matching bits, cleared from the signal
+ *
+ * @return signal_status_t: execute result of this function
+ **/
+signal_status_t signal_wait (
+                              bsp_signal_t * const signal,
+                              uint32_t             mask,
+                              uint32_t             timeout_ms,
+                              uint32_t     * const bits
+                                                              );
+
+//******************************* Declaring *********************************//
+#endif // __BSP_SIGNAL_H__
@@ -0,0 +1,242 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_signal.c
+ *
+ * @par dependencies
+ * - bsp_signal.h
+ *
+ * @author Damian
+ *
+ * @brief Provide a lightweight event signal for BSP drivers, mapped onto the
+ *        direct-to-task notification of the owner task.
+ *
+ * Processing flow:
+ *
+ * Call directly.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+//******************************** Includes *********************************//
+
+#include "bsp_signal.h"
+#include "bsp_common.h"
+
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+BSP_STATUS_CHECK( SIGNAL );
+
+/**
+ * @brief: Bind a signal to its owner task, one signal per task
+ * @steps:
+ *      1. The task owns another signal still bound to it: refuse
+ *      2. Record the signal in the slot of the task, the task in the signal
+ *
+ * @param[in]  signal: Pointer to a instance of bsp_signal_t
+ * @param[in]  owner:  the task, alive
+ *
+ * @return signal_status_t: SIGNAL_ERRORSOURCE when it owns another signal
+ **/
+static signal_status_t __bind ( bsp_signal_t * const signal,
+                                TaskHandle_t         owner  )
+{
+    bsp_signal_t    * held;
+    signal_status_t   ret = SIGNAL_OK;
+
+    // a signal bound again to another task leaves a stale slot behind,
+    // its owner tells: only the slot of the task is touched, never the
+    // slot of a former owner, which may be deleted
+    taskENTER_CRITICAL();
+    held = (bsp_signal_t *)pvTaskGetThreadLocalStoragePointer(
+                                            owner, SIGNAL_TLS_INDEX );
+    if ( NULL != held && signal != held && owner == held->owner )
+    {
+        ret = SIGNAL_ERRORSOURCE;
+    }
+    else
+    {
+        vTaskSetThreadLocalStoragePointer( owner, SIGNAL_TLS_INDEX, signal );
+        signal->owner = owner;
+    }
+    taskEXIT_CRITICAL();
+    return ret;
+}
+
+/**
+ * @brief: Instantiate a bsp_signal_t
+ * @steps:
+ *      1. Bind the signal to its owner task, unless it owns another one
+ *
+ * @param[in]  signal: Pointer to a instance of bsp_signal_t
+ * @param[in]  owner:  task to notify, NULL binds the first task that waits
+ *
+ * @return signal_status_t: SIGNAL_ERRORSOURCE when owner has a signal
+ **/
+signal_status_t signal_instantiate (
+                                     bsp_signal_t * const signal,
+                                     TaskHandle_t         owner
+                                                                )
+{
+    /********** 1. Checking the input parameters **********/
+    if ( NULL == signal )
+    {
+        LOG( LOG_LEVEL_ERR, "Input parameter is null" );
+        return SIGNAL_ERRORPARAMETER;
+    }
+
+    /************* 2. Initialize the instance *************/
+    signal->owner          = NULL;
+    signal->pending        = 0U;
+    signal->is_initialized = SIGNAL_NOT_INITED;
+    if ( NULL != owner && SIGNAL_OK != __bind( signal, owner ) )
+    {
+        LOG( LOG_LEVEL_ERR, "Task already owns a signal" );
+        return SIGNAL_ERRORSOURCE;
+    }
+    signal->is_initialized = SIGNAL_INITED;
+    return SIGNAL_OK;
+}
+
+/**
+ * @brief: Set event bits from task context
+ *
+ * @param[in]  signal: Pointer to a instance of bsp_signal_t
+ * @param[in]  bits:   event bits to set, must not be 0
+ *
+ * @return signal_status_t: execute result of this function
+ **/
+signal_status_t signal_set ( bsp_signal_t * const signal, uint32_t bits )
+{
+    TaskHandle_t owner;
+
+    if ( NULL == signal || 0U == bits )
+    {
+        return SIGNAL_ERRORPARAMETER;
+    }
+    owner = signal->owner;
+    if ( NULL == owner )
+    {
+        return SIGNAL_ERRORSOURCE;
+    }
+
+    xTaskNotify( owner, bits, eSetBits );
+    return SIGNAL_OK;
+}
+
+/**
+ * @brief: Set event bits from ISR context, yields on exit if required
+ *
+ * @param[in]  signal: Pointer to a instance of bsp_signal_t
+ * @param[in]  bits:   event bits to set, must not be 0
+ *
+ * @return signal_status_t: execute result of this function
+ **/
+signal_status_t signal_set_isr ( bsp_signal_t * const signal, uint32_t bits )
+{
+    BaseType_t   woken = pdFALSE;
+    TaskHandle_t owner;
+
+    if ( NULL == signal || 0U == bits )
+    {
+        return SIGNAL_ERRORPARAMETER;
+    }
+    owner = signal->owner;
+    if ( NULL == owner )
+    {
+        return SIGNAL_ERRORSOURCE;
+    }
+
+    xTaskNotifyFromISR( owner, bits, eSetBits, &woken );
+    portYIELD_FROM_ISR( woken );
+    return SIGNAL_OK;
+}
+
+/**
+ * @brief: Wait for any of the event bits, only callable by the owner; the
+ *         first wait of a signal bound to nobody binds the caller
+ * @steps:
+ *      1. Return the matching bits already collected
+ *      2. Block on the notification and collect the new bits
+ *
+ * @param[in]  signal:     Pointer to a instance of bsp_signal_t
+ * @param[in]  mask:       event bits to wait for
+ * @param[in]  timeout_ms: max wait, SIGNAL_WAIT_FOREVER to block
+ * @param[out] bits:       matching bits, cleared from the signal
+ *
+ * @return signal_status_t: execute result of this function
+ **/
+signal_status_t signal_wait (
+                              bsp_signal_t * const signal,
+                              uint32_t             mask,
+                              uint32_t             timeout_ms,
+                              uint32_t     * const bits
+                                                              )
+{
+    uint32_t     value;
+    TickType_t   ticks;
+    TimeOut_t    time_out;
+    TaskHandle_t self = xTaskGetCurrentTaskHandle();
+
+    /********** 1. Checking the input parameters **********/
+    if ( NULL == signal || NULL == bits || 0U == mask )
+    {
+        LOG( LOG_LEVEL_ERR, "Input parameter is null" );
+        return SIGNAL_ERRORPARAMETER;
+    }
+    if ( SIGNAL_NOT_INITED == signal->is_initialized )
+    {
+        LOG( LOG_LEVEL_ERR, "Signal not initialized" );
+        return SIGNAL_ERRORSOURCE;
+    }
+    if ( NULL == signal->owner )
+    {
+        if ( SIGNAL_OK != __bind( signal, self ) )
+        {
+            LOG( LOG_LEVEL_ERR, "Task already owns a signal" );
+            return SIGNAL_ERRORSOURCE;
+        }
+    }
+    else if ( self != signal->owner )
+    {
+        LOG( LOG_LEVEL_ERR, "Signal waited by a non-owner task" );
+        return SIGNAL_ERRORSOURCE;
+    }
+
+    ticks = ( SIGNAL_WAIT_FOREVER == timeout_ms ) ? portMAX_DELAY
+                                                  : pdMS_TO_TICKS( timeout_ms );
+
+    /*********** 2. Collect bits until one matches *********/
+    // pending is only touched by the owner, no lock needed
+    vTaskSetTimeOutState( &time_out );
+    while ( 0U == ( signal->pending & mask ) )
+    {
+        if ( pdFALSE == xTaskNotifyWait( 0U, 0xFFFFFFFFU, &value, ticks ) )
+        {
+            *bits = 0U;
+            return SIGNAL_ERRORTIMEOUT;
+        }
+        signal->pending |= value;
+
+        // 2.1 unrelated bits only, keep waiting for the remaining time
+        if ( 0U == ( signal->pending & mask ) &&
+             pdTRUE == xTaskCheckForTimeOut( &time_out, &ticks ) )
+        {
+            *bits = 0U;
+            return SIGNAL_ERRORTIMEOUT;
+        }
+    }
+
+    *bits            = signal->pending & mask;
+    signal->pending &= ~mask;
+    return SIGNAL_OK;
+}
+
+//******************************** Defines **********************************//
@@ -0,0 +1,251 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_spi.h
+ *
+ * @par dependencies
+ * - bsp_osal.h
+ * - bsp_signal.h
+ *
+ * @author Damian
+ *
+ * @brief SPI bus manager: the tasks queue transfers to the devices of one
+ *        bus, the DMA runs them one after the other, a task notification
+ *        tells the end of each.
+ *
+ * Processing flow:
+ *
+ * spi_bus_inst (hardware operations of the bus)
+ * spi_submit        -> a transfer, or a chain of them, at the end of the
+ *                      queue; starts it when the bus is idle, returns
+ * spi_dma_done_isr  -> DMA complete or error interrupt: chip-select of the
+ *                      transfer released, the next one in the queue
+ *                      started from here, then the submitter notified
+ * spi_transfer      -> spi_submit and wait for the notification, a chain
+ *                      still queued or running at the timeout is cancelled
+ * spi_cancel        -> a running chain: DMA switched off in the critical
+ *                      section, the queue held while the streams settle
+ *                      outside it, then the next chain started
+ *
+ * No task owns the bus, there is no bus mutex: a submit links the transfers
+ * into the queue inside a short critical section and the DMA interrupt
+ * takes them out. A task never waits for another one to release the bus,
+ * only for its own transfers, and a transfer following another one starts
+ * from the interrupt of the one before, without the scheduler in between.
+ *
+ * A transfer names its device: chip-select line, SPI mode, clock. The bus
+ * is set up again (SPI disabled, every chip-select high) only when the
+ * device differs from the one before in mode or clock.
+ *
+ * A chain (transfers linked by next, the last one NULL) is queued at once,
+ * nothing of another task runs in between. With SPI_XFER_KEEP_CS the
+ * chip-select stays low into the next transfer of the chain: a command and
+ * its data to a SPI flash, a frame to a shift-register chain in pieces. A
+ * failed transfer fails the rest of its chain, the chip-select goes high.
+ *
+ * The transfers and their buffers belong to the bus from spi_submit until
+ * done is set: static, or on the stack of a task that waits for them.
+ *
+ * The completion interrupt must be masked by the critical section of the
+ * OS (FreeRTOS: at or below configMAX_SYSCALL_INTERRUPT_PRIORITY).
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+#ifndef __BSP_SPI_H__
+#define __BSP_SPI_H__
+
+//******************************** Includes *********************************//
+
+#include "bsp_osal.h"
+#include "bsp_signal.h"
+#include <stdint.h>
+
+//******************************** Includes *********************************//
+
+typedef struct bsp_spi  bsp_spi_t;
+typedef struct spi_xfer spi_xfer_t;
+
+//******************************** Defines **********************************//
+
+#define SPI_XFER_MAX_BYTES        0xFFFFU    /* of one DMA transfer (NDTR)  */
+#define SPI_XFER_KEEP_CS          ( 1UL << 0 ) /* CS low into the next one  */
+#define SPI_TIMEOUT_MS            100U       /* spi_transfer default        */
+
+typedef enum
+{
+    SPI_OK                       = 0,  /* SPI operate successfully           */
+    SPI_ERROR                    = 1,  /* SPI DMA error, or chain failed     */
+    SPI_ERRORTIMEOUT             = 2,  /* SPI not done in time, cancelled    */
+    SPI_ERRORSOURCE              = 3,  /* SPI bus not initialized            */
+    SPI_ERRORPARAMETER           = 4,  /* SPI parameter error                */
+    SPI_ERRORNOMEMORY            = 5,  /* SPI transfer already queued        */
+    SPI_ERRORISR                 = 6,  /* SPI not allowed in ISR context     */
+    SPI_RESERVED                 = 0xFF,/* SPI reserved                      */
+} spi_status_t;
+
+typedef enum
+{
+    SPI_INITED     = 0,  /* spi bus initialized                              */
+    SPI_NOT_INITED = 1,  /* spi bus not initialized                          */
+} spi_init_t;
+
+typedef enum
+{
+    SPI_MODE_0                   = 0,  /* CPOL 0, CPHA 0                     */
+    SPI_MODE_1                   = 1,  /* CPOL 0, CPHA 1                     */
+    SPI_MODE_2                   = 2,  /* CPOL 1, CPHA 0                     */
+    SPI_MODE_3                   = 3,  /* CPOL 1, CPHA 1                     */
+} spi_mode_t;
+
+typedef struct
+{
+    uint32_t              cs;                         /* line, to pf_spi_cs  */
+    spi_mode_t            mode;                       /* clock polarity/phase*/
+    uint32_t              max_hz;                     /* clock at most       */
+} spi_device_t;
+
+typedef struct spi_xfer
+{
+    //****************************** Property *******************************//
+    spi_xfer_t            * next;                     /* chain, NULL: last   */
+    const spi_device_t    * device;                   /* CS, mode, clock     */
+    const uint8_t         * tx;                       /* NULL: receive only  */
+    uint8_t               * rx;                       /* NULL: discarded     */
+    uint32_t              len;                        /* bytes, 1 .. MAX     */
+    uint32_t              flags;                      /* SPI_XFER_KEEP_CS    */
+    bsp_signal_t          * signal;                   /* NULL: not notified  */
+    uint32_t              bits;                       /* set on the signal   */
+
+    //************************** Internal status ****************************//
+    spi_xfer_t            * link;                     /* queue of the bus    */
+    uint32_t              chain_end;                  /* last of its chain   */
+    uint32_t              queued;                     /* 1: the bus owns it  */
+    volatile uint32_t     done;                       /* 1: status is final  */
+    volatile spi_status_t status;                     /* SPI_OK, SPI_ERROR   */
+} spi_xfer_t;
+
+typedef struct
+{
+    /* SPI disabled, mode and clock of the next device                     */
+    spi_status_t ( *pf_spi_configure ) ( spi_mode_t mode, uint32_t max_hz );
+    /* chip-select line low (active 1) or high (active 0)                  */
+    spi_status_t ( *pf_spi_cs )        ( uint32_t cs, uint32_t active );
+    /* start a DMA transfer, its end calls spi_dma_done_isr                */
+    spi_status_t ( *pf_spi_dma_start ) ( const uint8_t * const tx,
+                                         uint8_t       * const rx,
+                                         uint32_t              len );
+    /* switch the DMA transfer running off, no spi_dma_done_isr after it;
+       inside the critical section, the tick masked: never waits         */
+    spi_status_t ( *pf_spi_dma_stop )  ( void );
+    /* wait for the streams pf_spi_dma_stop switched off, ready for the
+       next start; task context, outside the critical section            */
+    spi_status_t ( *pf_spi_dma_reset ) ( void );
+} spi_hw_operation_t;
+
+typedef struct bsp_spi
+{
+    //************************** Internal status ****************************//
+    spi_init_t            is_initialized;             /* record init status  */
+    spi_xfer_t            * volatile head;            /* running, or NULL    */
+    spi_xfer_t            * tail;                     /* last queued         */
+    uint32_t              mode;                       /* set up, spi_mode_t  */
+    uint32_t              max_hz;                     /* set up, 0: none yet */
+    const spi_device_t    * selected;                 /* CS low, or NULL     */
+    uint32_t              stopping;                   /* 1: abort settling   */
+
+    //***************************** Statistics ******************************//
+    uint32_t              xfers;                      /* completed           */
+    uint32_t              bytes;                      /* of the completed    */
+    uint32_t              chained;                    /* started from the ISR*/
+    uint32_t              reconfigs;                  /* mode or clock set   */
+    uint32_t              errors;                     /* failed, cancelled   */
+
+    //************************ Interface from core **************************//
+    spi_hw_operation_t    * p_hw_operation_inst;      /* the bus             */
+
+    //************************ Interface from RTOS **************************//
+    os_critical_t         * p_os_critical;          /* os critical interface */
+
+} bsp_spi_t;
+
+//******************************** Defines **********************************//
+
+//******************************* Declaring *********************************//
+
+/**
+ * @brief: Instantiate a bsp_spi_t
+ * @steps:
+ *      1. Adding the hardware and OS interfaces into the instance
+ *      2. Empty queue, no device set up, no chip-select low
+ *
+ * @param[in]  spi:         Pointer to a instance of bsp_spi_t
+ * @param[in]  hw_ops:      Pointer to a instance of spi_hw_operation_t
+ * @param[in]  os_critical: Pointer to a instance of os_critical_t
+ *
+ * @return spi_status_t: execute result of this function
+ **/
+spi_status_t spi_bus_inst (
+                            bsp_spi_t          * const spi,
+                            spi_hw_operation_t * const hw_ops,
+                            os_critical_t      * const os_critical
+                                                                   );
+
+/**
+ * @brief: Queue a transfer or a chain of them, task context, returns at once
+ * @steps:
+ *      1. Check the chain: device, length, not queued already
+ *      2. Link it behind the last queued transfer, or start it when idle
+ *
+ * @param[in]  spi:  Pointer to a instance of bsp_spi_t
+ * @param[in]  xfer: first transfer of the chain
+ *
+ * @return spi_status_t: execute result of this function
+ **/
+spi_status_t spi_submit ( bsp_spi_t * const spi, spi_xfer_t * const xfer );
+
+/**
+ * @brief: Queue a chain and wait for its last transfer, task context
+ * @steps:
+ *      1. spi_submit
+ *      2. Wait for the signal of the last transfer
+ *      3. Timeout: cancel the chain, or take it when it just ended
+ *
+ * @param[in]  spi:        Pointer to a instance of bsp_spi_t
+ * @param[in]  xfer:       first transfer of the chain, the last one with
+ *                         a signal owned by the calling task
+ * @param[in]  timeout_ms: max wait for the whole chain
+ *
+ * @return spi_status_t: status of the chain
+ **/
+spi_status_t spi_transfer ( bsp_spi_t  * const spi,
+                            spi_xfer_t * const xfer,
+                            uint32_t           timeout_ms );
+
+/**
+ * @brief: Take a queued chain back before it ran, or abort it running;
+ *         an abort returns once the streams stopped, task context
+ *
+ * @param[in]  spi:  Pointer to a instance of bsp_spi_t
+ * @param[in]  xfer: first transfer of the chain
+ *
+ * @return spi_status_t: SPI_OK when cancelled, SPI_ERRORSOURCE when it had
+ *                       ended already, its status is final
+ **/
+spi_status_t spi_cancel ( bsp_spi_t * const spi, spi_xfer_t * const xfer );
+
+/**
+ * @brief: End of a DMA transfer, from its complete or error callback
+ *
+ * @param[in]  spi: Pointer to a instance of bsp_spi_t
+ * @param[in]  ok:  1 on transfer complete, 0 on transfer error
+ **/
+void spi_dma_done_isr ( bsp_spi_t * const spi, uint32_t ok );
+
+//******************************* Declaring *********************************//
+#endif // __BSP_SPI_H__
@@ -0,0 +1,565 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_spi.c
+ *
+ * @par dependencies
+ * - bsp_spi.h
+ * - bsp_common.h
+ *
+ * @author Damian
+ *
+ * @brief SPI bus manager: the tasks queue transfers to the devices of one
+ *        bus, the DMA runs them one after the other, a task notification
+ *        tells the end of each.
+ *
+ * Processing flow:
+ *
+ * Call directly.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+//******************************** Includes *********************************//
+
+#include "bsp_spi.h"
+#include "bsp_common.h"
+
+#ifndef BENCH_HOST_POSIX
+#include "main.h"
+#endif /* BENCH_HOST_POSIX */
+
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+BSP_STATUS_CHECK( SPI );
+
+typedef enum
+{
+    SPI_NOTIFY_NONE = 0,                /* cancelled, the caller knows       */
+    SPI_NOTIFY_TASK = 1,                /* from spi_submit                   */
+    SPI_NOTIFY_ISR  = 2,                /* from spi_dma_done_isr             */
+} spi_notify_t;
+
+/**
+ * @brief: Checking the bus can be used from here
+ *
+ * @param[in]  spi:  Pointer to a instance of bsp_spi_t
+ * @param[in]  xfer: the transfer
+ *
+ * @return spi_status_t: SPI_OK when it can
+ **/
+static spi_status_t __ready ( const bsp_spi_t  * const spi,
+                              const spi_xfer_t * const xfer )
+{
+    if ( NULL == spi || NULL == xfer )
+    {
+        LOG( LOG_LEVEL_ERR, "Input parameter is null" );
+        return SPI_ERRORPARAMETER;
+    }
+    else if ( SPI_INITED != spi->is_initialized )
+    {
+        LOG( LOG_LEVEL_ERR, "SPI bus not initialized" );
+        return SPI_ERRORSOURCE;
+    }
+#ifndef BENCH_HOST_POSIX
+    else if ( 0U != __get_IPSR() )
+    {
+        return SPI_ERRORISR;
+    }
+#endif /* BENCH_HOST_POSIX */
+    return SPI_OK;
+}
+
+/**
+ * @brief: Chip-select of the selected device high
+ *
+ * @param[in]  spi: Pointer to a instance of bsp_spi_t
+ **/
+static void __release ( bsp_spi_t * const spi )
+{
+    if ( NULL != spi->selected )
+    {
+        spi->p_hw_operation_inst->pf_spi_cs( spi->selected->cs, 0U );
+        spi->selected = NULL;
+    }
+}
+
+/**
+ * @brief: Take transfers off the head of the queue, up to the end of the
+ *         chain of the first one, or that first one only
+ *
+ * @param[in]  spi:   Pointer to a instance of bsp_spi_t
+ * @param[in]  chain: 1: the whole chain, 0: one transfer
+ *
+ * @return spi_xfer_t *: the first one taken, linked to the others by link
+ **/
+static spi_xfer_t * __detach ( bsp_spi_t * const spi, uint32_t chain )
+{
+    spi_xfer_t * first = spi->head;
+    spi_xfer_t * last  = first;
+
+    while ( 0U != chain && 0U == last->chain_end && NULL != last->link )
+    {
+        last = last->link;
+    }
+    spi->head  = last->link;
+    last->link = NULL;
+    if ( NULL == spi->head )
+    {
+        spi->tail = NULL;
+    }
+    return first;
+}
+
+/**
+ * @brief: Final status of detached transfers, the submitters notified
+ *
+ * @param[in]  spi:    Pointer to a instance of bsp_spi_t
+ * @param[in]  xfer:   the first one, linked to the others by link
+ * @param[in]  ok:     1: done, 0: failed or cancelled
+ * @param[in]  notify: context of the notification, or none
+ **/
+static void __finish ( bsp_spi_t    * const spi,
+                       spi_xfer_t   *       xfer,
+                       uint32_t             ok,
+                       spi_notify_t         notify )
+{
+    spi_xfer_t   * next;
+    bsp_signal_t * signal;
+    uint32_t       bits;
+
+    for ( ; NULL != xfer; xfer = next )
+    {
+        // the submitter may reuse it once done is set: read it all before
+        next         = xfer->link;
+        signal       = xfer->signal;
+        bits         = xfer->bits;
+        xfer->link   = NULL;
+        xfer->queued = 0U;
+        if ( 0U != ok )
+        {
+            spi->xfers++;
+            spi->bytes  += xfer->len;
+            xfer->status = SPI_OK;
+        }
+        else
+        {
+            spi->errors++;
+            xfer->status = SPI_ERROR;
+        }
+        xfer->done = 1U;
+
+        if ( NULL == signal || SPI_NOTIFY_NONE == notify )
+        {
+            continue;
+        }
+        if ( SPI_NOTIFY_ISR == notify )
+        {
+            signal_set_isr( signal, bits );
+        }
+        else
+        {
+            signal_set( signal, bits );
+        }
+    }
+}
+
+/**
+ * @brief: Start the transfer at the head of the queue, none while an abort
+ *         settles: the cancel starts it after
+ * @steps:
+ *      1. Another device still selected (its chain cut short): release it
+ *      2. Mode or clock of the device not set up: set it up, CS high
+ *      3. Chip-select low, start the DMA
+ *      4. Failed to start: fail its chain, go on with the next one
+ *
+ * @param[in]  spi:    Pointer to a instance of bsp_spi_t
+ * @param[in]  notify: context, for the chains failing here
+ **/
+static void __run ( bsp_spi_t * const spi, spi_notify_t notify )
+{
+    spi_hw_operation_t * hw = spi->p_hw_operation_inst;
+    const spi_device_t * dev;
+    spi_xfer_t         * xfer;
+
+    if ( 0U != spi->stopping )
+    {
+        return;
+    }
+    while ( NULL != ( xfer = spi->head ) )
+    {
+        dev = xfer->device;
+
+        /******************** 1. Other device *****************/
+        if ( NULL != spi->selected && dev != spi->selected )
+        {
+            __release( spi );
+        }
+
+        /******************** 2. Set up ***********************/
+        if ( NULL == spi->selected &&
+             ( (uint32_t)dev->mode != spi->mode ||
+               dev->max_hz         != spi->max_hz ) )
+        {
+            if ( SPI_OK != hw->pf_spi_configure( dev->mode, dev->max_hz ) )
+            {
+                spi->max_hz = 0U;
+                __finish( spi, __detach( spi, 1U ), 0U, notify );
+                continue;
+            }
+            spi->mode   = (uint32_t)dev->mode;
+            spi->max_hz = dev->max_hz;
+            spi->reconfigs++;
+        }
+
+        /******************** 3. Select, start ****************/
+        if ( NULL == spi->selected )
+        {
+            hw->pf_spi_cs( dev->cs, 1U );
+            spi->selected = dev;
+        }
+        if ( SPI_OK == hw->pf_spi_dma_start( xfer->tx, xfer->rx, xfer->len ) )
+        {
+            return;
+        }
+
+        /******************** 4. Failed ***********************/
+        __release( spi );
+        __finish( spi, __detach( spi, 1U ), 0U, notify );
+    }
+}
+
+/**
+ * @brief: Instantiate a bsp_spi_t
+ * @steps:
+ *      1. Adding the hardware and OS interfaces into the instance
+ *      2. Empty queue, no device set up, no chip-select low
+ *
+ * @param[in]  spi:         Pointer to a instance of bsp_spi_t
+ * @param[in]  hw_ops:      Pointer to a instance of spi_hw_operation_t
+ * @param[in]  os_critical: Pointer to a instance of os_critical_t
+ *
+ * @return spi_status_t: execute result of this function
+ **/
+spi_status_t spi_bus_inst (
+                            bsp_spi_t          * const spi,
+                            spi_hw_operation_t * const hw_ops,
+                            os_critical_t      * const os_critical
+                                                                   )
+{
+    /********** 1. Checking the input parameters **********/
+    if ( NULL == spi                                 ||
+         NULL == hw_ops                              ||
+         NULL == hw_ops->pf_spi_configure            ||
+         NULL == hw_ops->pf_spi_cs                   ||
+         NULL == hw_ops->pf_spi_dma_start            ||
+         NULL == hw_ops->pf_spi_dma_stop             ||
+         NULL == hw_ops->pf_spi_dma_reset            ||
+         NULL == os_critical                         ||
+         NULL == os_critical->pf_os_critical_enter   ||
+         NULL == os_critical->pf_os_critical_exit )
+    {
+        LOG( LOG_LEVEL_ERR, "Input parameter is null" );
+        return SPI_ERRORPARAMETER;
+    }
+
+    /************** 2. Checking the resource **************/
+    if ( SPI_INITED == spi->is_initialized )
+    {
+        LOG( LOG_LEVEL_WARN, "SPI bus already initialized" );
+        return SPI_ERRORSOURCE;
+    }
+
+    /************** 3. Adding the interfaces **************/
+    // 3.1 mount external interfaces
+    spi->p_hw_operation_inst = hw_ops;
+    spi->p_os_critical       = os_critical;
+
+    /************* 4. Initialize the instance *************/
+    spi->head      = NULL;
+    spi->tail      = NULL;
+    spi->mode      = (uint32_t)SPI_MODE_0;
+    spi->max_hz    = 0U;
+    spi->selected  = NULL;
+    spi->stopping  = 0U;
+    spi->xfers     = 0U;
+    spi->bytes     = 0U;
+    spi->chained   = 0U;
+    spi->reconfigs = 0U;
+    spi->errors    = 0U;
+
+    spi->is_initialized = SPI_INITED;
+    return SPI_OK;
+}
+
+/**
+ * @brief: Queue a transfer or a chain of them, task context, returns at once
+ * @steps:
+ *      1. Check the chain: device, length, not queued already
+ *      2. Link it behind the last queued transfer, or start it when idle
+ *
+ * @param[in]  spi:  Pointer to a instance of bsp_spi_t
+ * @param[in]  xfer: first transfer of the chain
+ *
+ * @return spi_status_t: execute result of this function
+ **/
+spi_status_t spi_submit ( bsp_spi_t * const spi, spi_xfer_t * const xfer )
+{
+    spi_xfer_t   * last = NULL;
+    spi_status_t   ret  = __ready( spi, xfer );
+
+    if ( SPI_OK != ret )
+    {
+        return ret;
+    }
+
+    /********** 1. Checking the input parameters **********/
+    for ( spi_xfer_t * x = xfer; NULL != x; x = x->next )
+    {
+        if ( NULL == x->device || ( NULL == x->tx && NULL == x->rx ) ||
+             0U == x->len || SPI_XFER_MAX_BYTES < x->len )
+        {
+            LOG( LOG_LEVEL_ERR, "SPI transfer invalid" );
+            return SPI_ERRORPARAMETER;
+        }
+    }
+
+    /******************* 2. Queue it **********************/
+    spi->p_os_critical->pf_os_critical_enter();
+    for ( spi_xfer_t * x = xfer; NULL != x; x = x->next )
+    {
+        if ( 0U != x->queued )
+        {
+            spi->p_os_critical->pf_os_critical_exit();
+            LOG( LOG_LEVEL_ERR, "SPI transfer already queued" );
+            return SPI_ERRORNOMEMORY;
+        }
+    }
+    for ( spi_xfer_t * x = xfer; NULL != x; x = x->next )
+    {
+        x->link      = x->next;
+        x->chain_end = ( NULL == x->next ) ? 1U : 0U;
+        x->queued    = 1U;
+        x->done      = 0U;
+        x->status    = SPI_RESERVED;
+        last         = x;
+    }
+    if ( NULL != spi->tail )
+    {
+        // running: the interrupt of the one before starts it
+        spi->tail->link = xfer;
+        spi->tail       = last;
+    }
+    else
+    {
+        spi->head = xfer;
+        spi->tail = last;
+        __run( spi, SPI_NOTIFY_TASK );
+    }
+    spi->p_os_critical->pf_os_critical_exit();
+    return SPI_OK;
+}
+
+/**
+ * @brief: Queue a chain and wait for its last transfer, task context
+ * @steps:
+ *      1. spi_submit
+ *      2. Wait for the signal of the last transfer
+ *      3. Timeout: cancel the chain, or take it when it just ended
+ *
+ * @param[in]  spi:        Pointer to a instance of bsp_spi_t
+ * @param[in]  xfer:       first transfer of the chain, the last one with
+ *                         a signal owned by the calling task
+ * @param[in]  timeout_ms: max wait for the whole chain
+ *
+ * @return spi_status_t: status of the chain
+ **/
+spi_status_t spi_transfer ( bsp_spi_t  * const spi,
+                            spi_xfer_t * const xfer,
+                            uint32_t           timeout_ms )
+{
+    spi_xfer_t   * last = xfer;
+    uint32_t       bits = 0U;
+    spi_status_t   ret;
+
+    if ( NULL == xfer )
+    {
+        LOG( LOG_LEVEL_ERR, "Input parameter is null" );
+        return SPI_ERRORPARAMETER;
+    }
+    while ( NULL != last->next )
+    {
+        last = last->next;
+    }
+    if ( NULL == last->signal || 0U == last->bits )
+    {
+        LOG( LOG_LEVEL_ERR, "SPI chain without a signal" );
+        return SPI_ERRORPARAMETER;
+    }
+
+    /********************* 1. Submit **********************/
+    ret = spi_submit( spi, xfer );
+    if ( SPI_OK != ret )
+    {
+        return ret;
+    }
+
+    /********************* 2. Wait ************************/
+    // a failed transfer fails the rest: the last one carries the result
+    if ( SIGNAL_OK == signal_wait( last->signal, last->bits, timeout_ms,
+                                   &bits ) )
+    {
+        return last->status;
+    }
+
+    /********************* 3. Timeout *********************/
+    if ( SPI_OK == spi_cancel( spi, xfer ) )
+    {
+        LOG( LOG_LEVEL_ERR, "SPI transfer timeout" );
+        return SPI_ERRORTIMEOUT;
+    }
+    // ended right at the timeout: its bit is set, take it
+    signal_wait( last->signal, last->bits, 0U, &bits );
+    return last->status;
+}
+
+/**
+ * @brief: Take a queued chain back before it ran, or abort it running
+ * @steps:
+ *      1. First transfer of the chain still queued, none: it ended
+ *      2. Running: DMA off, CS high, queue held; the streams settle
+ *         outside the critical section, then the next chain starts
+ *      3. Waiting: unlink it from the queue
+ *
+ * @param[in]  spi:  Pointer to a instance of bsp_spi_t
+ * @param[in]  xfer: first transfer of the chain
+ *
+ * @return spi_status_t: SPI_OK when cancelled, SPI_ERRORSOURCE when it had
+ *                       ended already, its status is final
+ **/
+spi_status_t spi_cancel ( bsp_spi_t * const spi, spi_xfer_t * const xfer )
+{
+    spi_hw_operation_t * hw;
+    spi_xfer_t         * first = xfer;
+    spi_xfer_t         * last;
+    spi_xfer_t         * prev;
+    spi_status_t         ret   = __ready( spi, xfer );
+
+    if ( SPI_OK != ret )
+    {
+        return ret;
+    }
+
+    spi->p_os_critical->pf_os_critical_enter();
+
+    /***************** 1. Still queued ********************/
+    while ( NULL != first && 0U == first->queued )
+    {
+        first = first->next;
+    }
+    if ( NULL == first )
+    {
+        spi->p_os_critical->pf_os_critical_exit();
+        return SPI_ERRORSOURCE;
+    }
+
+    /***************** 2. Running *************************/
+    if ( spi->head == first && 0U == spi->stopping )
+    {
+        hw = spi->p_hw_operation_inst;
+        hw->pf_spi_dma_stop();
+        __release( spi );
+        first          = __detach( spi, 1U );
+        spi->stopping  = 1U;
+        spi->p_os_critical->pf_os_critical_exit();
+
+        // the tick runs here: the wait for the streams is bounded, the
+        // submits meanwhile queue up behind the hold
+        hw->pf_spi_dma_reset();
+
+        spi->p_os_critical->pf_os_critical_enter();
+        spi->stopping = 0U;
+        __run( spi, SPI_NOTIFY_TASK );
+        // the streams stopped: its buffers are the submitter's again
+        __finish( spi, first, 0U, SPI_NOTIFY_NONE );
+        spi->p_os_critical->pf_os_critical_exit();
+        return SPI_OK;
+    }
+
+    /***************** 3. Waiting *************************/
+    // a chain runs from its head to its end: none of it ran yet; at the
+    // head only behind an abort settling
+    if ( spi->head == first )
+    {
+        __finish( spi, __detach( spi, 1U ), 0U, SPI_NOTIFY_NONE );
+        spi->p_os_critical->pf_os_critical_exit();
+        return SPI_OK;
+    }
+    for ( prev = spi->head; NULL != prev && prev->link != first;
+          prev = prev->link )
+    {
+    }
+    for ( last = first; 0U == last->chain_end && NULL != last->link;
+          last = last->link )
+    {
+    }
+    if ( NULL != prev )
+    {
+        prev->link = last->link;
+        if ( spi->tail == last )
+        {
+            spi->tail = prev;
+        }
+        last->link = NULL;
+        __finish( spi, first, 0U, SPI_NOTIFY_NONE );
+    }
+    spi->p_os_critical->pf_os_critical_exit();
+    return SPI_OK;
+}
+
+/**
+ * @brief: End of a DMA transfer, from its complete or error callback
+ * @steps:
+ *      1. Error: the rest of the chain fails with it, CS high
+ *      2. Done: CS high unless kept for the next one of the chain
+ *      3. Start the next transfer, then notify
+ *
+ * @param[in]  spi: Pointer to a instance of bsp_spi_t
+ * @param[in]  ok:  1 on transfer complete, 0 on transfer error
+ **/
+void spi_dma_done_isr ( bsp_spi_t * const spi, uint32_t ok )
+{
+    spi_xfer_t * done;
+
+    // the tasks touch the queue in a critical section only: no lock here
+    if ( NULL == spi || NULL == spi->head || 0U != spi->stopping )
+    {
+        return;
+    }
+
+    /************ 1. Error, or 2. CS of the done one ******/
+    done = spi->head;
+    if ( 0U == ok || 0U != done->chain_end ||
+         0U == ( done->flags & SPI_XFER_KEEP_CS ) )
+    {
+        __release( spi );
+    }
+    done = __detach( spi, ( 0U == ok ) ? 1U : 0U );
+
+    /************ 3. Next one, then notify ****************/
+    if ( NULL != spi->head )
+    {
+        spi->chained++;
+        __run( spi, SPI_NOTIFY_ISR );
+    }
+    __finish( spi, done, ok, SPI_NOTIFY_ISR );
+}
+
+//******************************** Defines **********************************//
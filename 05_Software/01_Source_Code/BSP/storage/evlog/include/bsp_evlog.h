@@ -0,0 +1,283 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_evlog.h
+ *
+ * @par dependencies
+ * - bsp_osal.h
+ * - bsp_signal.h
+ *
+ * @author Damian
+ *
+ * @brief Event journal in a ring of flash sectors: binary records batched
+ *        in RAM pages, written one page at a time by a low priority task
+ *        within a flash time budget.
+ *
+ * Processing flow:
+ *
+ * evlog_inst -> evlog_mount (find the newest page, continue its sequence)
+ *            -> evlog_start (writer task)
+ * any task   -> evlog_write -> record into the RAM page being filled
+ *                           -> page full: close it, wake the writer
+ * writer     -> every EVLOG_SERVICE_MS or woken: evlog_service
+ *                 -> close the page being filled after EVLOG_FLUSH_MS
+ *                 -> while the budget allows: program the closed pages,
+ *                    erase the sector the head enters when still written
+ *                 -> bucket full, head EVLOG_AHEAD_PAGES from the end of
+ *                    its sector: erase the next sector ahead
+ *            -> a bit of dump_mask: evlog_dump
+ *
+ * Page, EVLOG_PAGE_WORDS words:
+ *
+ *  [EVLOG_PAGE_MAGIC][seq of the first record][count | used bytes << 16]
+ *  [record]...[0xFF padding][CRC-32 of the words before]
+ *  record: [time ms][EVLOG_RECORD_TAG | len << 16 | id][payload, padded]
+ *
+ * The sequence number of a record is the one of its page plus its place in
+ * the page, so it costs no flash. The CRC word goes last: a page torn by a
+ * reset fails it and is skipped by the mount and the dump.
+ *
+ * Write amplification is the padding of a page closed by EVLOG_FLUSH_MS
+ * before it was full. Erases: one sector every sector size of pages.
+ *
+ * Budget: the writer measures how long every erase and page program kept
+ * the flash busy and takes it out of a bucket filled at budget_rate_us per
+ * second, up to EVLOG_BUDGET_BURST_US. It does not start an operation
+ * while the bucket is empty, the records wait in the RAM pages and the
+ * ones that find no free page are counted in dropped. On the F411 an
+ * erase stalls every code fetch from the flash, ISRs included (typ. 250 ms
+ * for 16 KiB, 550 ms for 64 KiB, a page 1 ms). The next sector is erased
+ * ahead with a full bucket while the head still has EVLOG_AHEAD_PAGES to
+ * go, so the pages keep flowing after it; without a full bucket in time
+ * the head erases it on entry and the pages wait for the refill.
+ *
+ * Records still in RAM are lost on a reset.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+#ifndef __BSP_EVLOG_H__
+#define __BSP_EVLOG_H__
+
+//******************************** Includes *********************************//
+
+#include "bsp_osal.h"
+#include "bsp_signal.h"
+#include <stdint.h>
+
+//******************************** Includes *********************************//
+
+typedef struct bsp_evlog bsp_evlog_t;
+
+//******************************** Defines **********************************//
+
+#define EVLOG_PAGE_BYTES          256U       /* unit of a flash write       */
+#define EVLOG_PAGE_WORDS          ( EVLOG_PAGE_BYTES / 4U )
+#define EVLOG_PAGE_HEADER_WORDS   3U         /* magic, seq, count / used    */
+#define EVLOG_PAGE_DATA_BYTES     ( EVLOG_PAGE_BYTES - 16U )
+#define EVLOG_PAGE_MAGIC          0x45564C31U /* "EVL1"                     */
+#define EVLOG_RECORD_TAG          0xA5000000U /* top byte of a record word  */
+#define EVLOG_MAX_PAYLOAD         16U        /* bytes of one record         */
+#define EVLOG_MAX_SECTORS         4U         /* sectors of the ring         */
+#define EVLOG_RAM_PAGES           4U         /* pages buffered in the SRAM  */
+#define EVLOG_FLUSH_MS            5000U      /* a partial page waits at most*/
+#define EVLOG_SERVICE_MS          100U       /* writer period               */
+#define EVLOG_BUDGET_US           20000U     /* flash busy time per second  */
+#define EVLOG_BUDGET_BURST_US     600000U    /* bucket, one 64 KiB erase    */
+#define EVLOG_AHEAD_PAGES         16U        /* erase the next sector ahead */
+#define EVLOG_STACK_WORDS         256U       /* stack of the writer         */
+#define EVLOG_SIG_FLUSH           ( 1UL << 31 ) /* a page was closed        */
+#define EVLOG_SIG_DUMP            ( 1UL << 30 ) /* evlog_dump_request       */
+
+typedef enum
+{
+    EVLOG_OK                     = 0,  /* EVLOG operate successfully         */
+    EVLOG_ERROR                  = 1,  /* EVLOG flash program or erase error */
+    EVLOG_ERRORTIMEOUT           = 2,  /* EVLOG budget used up, try later    */
+    EVLOG_ERRORSOURCE            = 3,  /* EVLOG not mounted                  */
+    EVLOG_ERRORPARAMETER         = 4,  /* EVLOG parameter error              */
+    EVLOG_ERRORNOMEMORY          = 5,  /* EVLOG RAM pages full, dropped      */
+    EVLOG_ERRORISR               = 6,  /* EVLOG not allowed in ISR context   */
+    EVLOG_RESERVED               = 0xFF,/* EVLOG reserved                    */
+} evlog_status_t;
+
+typedef enum
+{
+    EVLOG_INITED     = 0,  /* event log initialized                          */
+    EVLOG_NOT_INITED = 1,  /* event log not initialized                      */
+} evlog_init_t;
+
+typedef struct
+{
+    /* erase one sector of the ring, 0 .. sector_num - 1                   */
+    evlog_status_t ( *pf_flash_erase )   ( uint32_t sector );
+    /* program words, dst inside a sector and erased                       */
+    evlog_status_t ( *pf_flash_program ) ( uint32_t       * const dst,
+                                           const uint32_t * const src,
+                                           uint32_t               words );
+} evlog_flash_operation_t;
+
+typedef struct
+{
+    uint32_t              * base;                     /* memory mapped       */
+    uint32_t              bytes;                      /* multiple of a page  */
+} evlog_sector_t;
+
+typedef struct bsp_evlog
+{
+    //************************* Internal property ***************************//
+    evlog_init_t          is_initialized;             /* record init status  */
+    evlog_sector_t        sector[EVLOG_MAX_SECTORS];  /* ring, in order      */
+    uint32_t              sector_num;                 /* sectors in the ring */
+    uint32_t              mounted;                    /* 1 after the mount   */
+    uint32_t              head_sector;                /* next page to write  */
+    uint32_t              head_page;                  /*   in that sector    */
+    uint32_t              ahead;                      /* next one erased     */
+    uint32_t              seq_next;                   /* of the next record  */
+    uint32_t              ram[EVLOG_RAM_PAGES][EVLOG_PAGE_WORDS];
+    uint32_t              ram_fill;                   /* page being filled   */
+    uint32_t              ram_ready;                  /* closed, not written */
+    uint32_t              fill_count;                 /* records in the page */
+    uint32_t              fill_used;                  /* bytes used in it    */
+    uint32_t              fill_ms;                    /* first record in it  */
+    int32_t               budget_us;                  /* bucket level        */
+    uint32_t              budget_rate_us;             /* refill per second   */
+    uint64_t              budget_last_us;             /* last refill         */
+    uint32_t              dump_mask;                  /* signal bits to dump */
+    bsp_signal_t          signal;                     /* wakes the writer    */
+
+    //***************************** Statistics ******************************//
+    uint32_t              records;                    /* written by the app  */
+    uint32_t              dropped;                    /* no RAM page free    */
+    uint32_t              pages;                      /* pages programmed    */
+    uint32_t              pad_bytes;                  /* padding programmed  */
+    uint32_t              erases;                     /* sectors erased      */
+    uint32_t              torn;                       /* pages skipped       */
+    uint32_t              busy_us;                    /* flash busy in total */
+    uint32_t              max_stall_us;               /* longest operation   */
+
+    //************************ Interface from core **************************//
+    evlog_flash_operation_t * p_flash_operation_inst; /* flash interface     */
+    time_operation_t      * p_time_operation_inst;    /* time ops interface  */
+
+    //************************ Interface from RTOS **************************//
+    os_critical_t         * p_os_critical;          /* os critical interface */
+
+} bsp_evlog_t;
+
+//******************************** Defines **********************************//
+
+//******************************* Declaring *********************************//
+
+/**
+ * @brief: Instantiate a bsp_evlog_t
+ * @steps:
+ *      1. Adding the flash, time and OS interfaces into the instance
+ *      2. Take the sectors of the ring, clear the RAM pages
+ *
+ * @param[in]  log:        Pointer to a instance of bsp_evlog_t
+ * @param[in]  flash_ops:  Pointer to a instance of evlog_flash_operation_t
+ * @param[in]  time_ops:   Pointer to a instance of time_operation_t
+ * @param[in]  critical:   Pointer to a instance of os_critical_t
+ * @param[in]  sectors:    the ring in order, copied
+ * @param[in]  sector_num: 2 .. EVLOG_MAX_SECTORS
+ *
+ * @return evlog_status_t: execute result of this function
+ **/
+evlog_status_t evlog_inst (
+                            bsp_evlog_t             * const log,
+                            evlog_flash_operation_t * const flash_ops,
+                            time_operation_t        * const time_ops,
+                            os_critical_t           * const critical,
+                            const evlog_sector_t    * const sectors,
+                            uint32_t                        sector_num
+                                                                          );
+
+/**
+ * @brief: Find the newest page, the next record continues its sequence
+ * @steps:
+ *      1. Per sector: find the last page not erased
+ *      2. The newest valid page of all gives the head and the sequence
+ *
+ * @param[in]  log: Pointer to a instance of bsp_evlog_t
+ *
+ * @return evlog_status_t: execute result of this function
+ **/
+evlog_status_t evlog_mount ( bsp_evlog_t * const log );
+
+/**
+ * @brief: Create the writer task, priority tskIDLE_PRIORITY + 1
+ *
+ * @param[in]  log: Pointer to a instance of bsp_evlog_t
+ *
+ * @return evlog_status_t: execute result of this function
+ **/
+evlog_status_t evlog_start ( bsp_evlog_t * const log );
+
+/**
+ * @brief: Add a record, task context, never touches the flash
+ *
+ * @param[in]  log:     Pointer to a instance of bsp_evlog_t
+ * @param[in]  id:      event id of the application
+ * @param[in]  payload: may be NULL when len is 0
+ * @param[in]  len:     0 .. EVLOG_MAX_PAYLOAD
+ *
+ * @return evlog_status_t: EVLOG_ERRORNOMEMORY when dropped
+ **/
+evlog_status_t evlog_write ( bsp_evlog_t * const log,
+                             uint16_t            id,
+                             const void  * const payload,
+                             uint32_t            len      );
+
+/**
+ * @brief: One pass of the writer, the task calls it every period
+ * @steps:
+ *      1. Refill the budget, close the page being filled once it is old
+ *      2. While the budget lasts: program the oldest closed page, or
+ *         erase the next sector ahead
+ *
+ * @param[in]  log: Pointer to a instance of bsp_evlog_t
+ *
+ * @return evlog_status_t: EVLOG_ERRORTIMEOUT when pages wait for budget
+ **/
+evlog_status_t evlog_service ( bsp_evlog_t * const log );
+
+/**
+ * @brief: Write every record in RAM now, whatever the budget
+ *
+ * @param[in]  log: Pointer to a instance of bsp_evlog_t
+ *
+ * @return evlog_status_t: execute result of this function
+ **/
+evlog_status_t evlog_flush ( bsp_evlog_t * const log );
+
+/**
+ * @brief: Flush, then print the journal oldest first
+ *
+ *  "# evlog"
+ *  "evlog,<seq>,<time ms>,<id>,<payload hex>"
+ *  "# evlog end,<printed>,<dropped>,<erases>"
+ *
+ * @param[in]  log:      Pointer to a instance of bsp_evlog_t
+ * @param[in]  from_seq: first sequence number printed
+ *
+ * @return evlog_status_t: execute result of this function
+ **/
+evlog_status_t evlog_dump ( bsp_evlog_t * const log, uint32_t from_seq );
+
+/**
+ * @brief: Ask the writer for a dump, from any task
+ *
+ * @param[in]  log: Pointer to a instance of bsp_evlog_t
+ *
+ * @return evlog_status_t: execute result of this function
+ **/
+evlog_status_t evlog_dump_request ( bsp_evlog_t * const log );
+
+//******************************* Declaring *********************************//
+#endif // __BSP_EVLOG_H__
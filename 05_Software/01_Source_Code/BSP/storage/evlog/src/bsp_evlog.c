@@ -0,0 +1,804 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_evlog.c
+ *
+ * @par dependencies
+ * - bsp_evlog.h
+ * - bsp_common.h
+ *
+ * @author Damian
+ *
+ * @brief Event journal in a ring of flash sectors: binary records batched
+ *        in RAM pages, written one page at a time by a low priority task
+ *        within a flash time budget.
+ *
+ * Processing flow:
+ *
+ * Call directly.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+//******************************** Includes *********************************//
+
+#include "bsp_evlog.h"
+#include "bsp_common.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include <string.h>
+
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+BSP_STATUS_CHECK( EVLOG );
+
+#define EVLOG_ERASED              0xFFFFFFFFU
+#define EVLOG_CRC_WORD            ( EVLOG_PAGE_WORDS - 1U )
+
+/* CRC-32 (IEEE 802.3, reflected), 4 bits per step */
+static const uint32_t s_crc_nibble[16] =
+{
+    0x00000000U, 0x1DB71064U, 0x3B6E20C8U, 0x26D930ACU,
+    0x76DC4190U, 0x6B6B51F4U, 0x4DB26158U, 0x5005713CU,
+    0xEDB88320U, 0xF00F9344U, 0xD6D6A3E8U, 0xCB61B38CU,
+    0x9B64C2B0U, 0x86D3D2D4U, 0xA00AE278U, 0xBDBDF21CU,
+};
+
+/**
+ * @brief: CRC-32 of a page up to its CRC word
+ *
+ * @param[in]  page: the page
+ *
+ * @return uint32_t: the CRC
+ **/
+static uint32_t __page_crc ( const uint32_t * const page )
+{
+    const uint8_t * p   = (const uint8_t *)page;
+    uint32_t        crc = 0xFFFFFFFFU;
+
+    for ( uint32_t i = 0; i < EVLOG_CRC_WORD * 4U; ++i )
+    {
+        crc ^= p[i];
+        crc  = ( crc >> 4 ) ^ s_crc_nibble[crc & 0xFU];
+        crc  = ( crc >> 4 ) ^ s_crc_nibble[crc & 0xFU];
+    }
+    return ~crc;
+}
+
+/**
+ * @brief: Checking a page read from the flash
+ *
+ * @param[in]  page: the page
+ *
+ * @return uint32_t: 1 when the magic and the CRC match
+ **/
+static uint32_t __page_valid ( const uint32_t * const page )
+{
+    return ( EVLOG_PAGE_MAGIC == page[0] &&
+             page[EVLOG_CRC_WORD] == __page_crc( page ) ) ? 1U : 0U;
+}
+
+/**
+ * @brief: Checking the words are still erased
+ *
+ * @param[in]  p:     first word
+ * @param[in]  words: number of words
+ *
+ * @return uint32_t: 1 when all of them read 0xFFFFFFFF
+ **/
+static uint32_t __blank ( const uint32_t * const p, uint32_t words )
+{
+    for ( uint32_t i = 0; i < words; ++i )
+    {
+        if ( EVLOG_ERASED != p[i] )
+        {
+            return 0U;
+        }
+    }
+    return 1U;
+}
+
+/**
+ * @brief: Pages of a sector of the ring
+ *
+ * @param[in]  log:    Pointer to a instance of bsp_evlog_t
+ * @param[in]  sector: the sector
+ *
+ * @return uint32_t: the pages
+ **/
+static uint32_t __sector_pages ( const bsp_evlog_t * const log,
+                                 uint32_t                  sector )
+{
+    return log->sector[sector].bytes / EVLOG_PAGE_BYTES;
+}
+
+/**
+ * @brief: Microseconds of the time service
+ *
+ * @param[in]  log: Pointer to a instance of bsp_evlog_t
+ *
+ * @return uint64_t: now
+ **/
+static uint64_t __now_us ( const bsp_evlog_t * const log )
+{
+    uint64_t now_us = 0U;
+
+    log->p_time_operation_inst->pf_get_time_us( &now_us );
+    return now_us;
+}
+
+/**
+ * @brief: Charge a flash operation to the budget and the statistics
+ *
+ * @param[in]  log:   Pointer to a instance of bsp_evlog_t
+ * @param[in]  t0_us: start of the operation
+ **/
+static void __charge ( bsp_evlog_t * const log, uint64_t t0_us )
+{
+    uint32_t busy_us = (uint32_t)( __now_us( log ) - t0_us );
+
+    log->busy_us      += busy_us;
+    log->budget_us    -= (int32_t)busy_us;
+    log->max_stall_us  = ( busy_us > log->max_stall_us ) ? busy_us :
+                                                           log->max_stall_us;
+}
+
+/**
+ * @brief: Refill the bucket for the time gone since the last refill
+ *
+ * @param[in]  log: Pointer to a instance of bsp_evlog_t
+ **/
+static void __budget_refill ( bsp_evlog_t * const log )
+{
+    uint64_t now_us = __now_us( log );
+    uint64_t add    = ( now_us - log->budget_last_us ) *
+                      log->budget_rate_us / 1000000U;
+
+    // keep the remainder of a short period for the next call
+    if ( 0U == add )
+    {
+        return;
+    }
+    log->budget_last_us = now_us;
+    log->budget_us      = ( (int64_t)log->budget_us + (int64_t)add >
+                            (int64_t)EVLOG_BUDGET_BURST_US ) ?
+                          (int32_t)EVLOG_BUDGET_BURST_US :
+                          log->budget_us + (int32_t)add;
+}
+
+/**
+ * @brief: Close the page being filled, with the critical section held
+ *
+ * @param[in]  log: Pointer to a instance of bsp_evlog_t
+ **/
+static void __page_close ( bsp_evlog_t * const log )
+{
+    uint32_t * page = log->ram[log->ram_fill];
+
+    page[0]         = EVLOG_PAGE_MAGIC;
+    page[2]         = log->fill_count | ( log->fill_used << 16 );
+    log->ram_fill   = ( log->ram_fill + 1U ) % EVLOG_RAM_PAGES;
+    log->ram_ready++;
+    log->fill_count = 0U;
+    log->fill_used  = 0U;
+}
+
+/**
+ * @brief: Erase a sector of the ring, timed
+ *
+ * @param[in]  log:    Pointer to a instance of bsp_evlog_t
+ * @param[in]  sector: the sector
+ *
+ * @return evlog_status_t: execute result of this function
+ **/
+static evlog_status_t __erase ( bsp_evlog_t * const log, uint32_t sector )
+{
+    uint64_t       t0_us = __now_us( log );
+    evlog_status_t ret   = log->p_flash_operation_inst->pf_flash_erase(
+                                                                   sector );
+
+    __charge( log, t0_us );
+    log->erases++;
+    if ( EVLOG_OK != ret )
+    {
+        LOG( LOG_LEVEL_ERR, "Event log erase failed" );
+        return EVLOG_ERROR;
+    }
+    return EVLOG_OK;
+}
+
+/**
+ * @brief: One flash operation towards writing the oldest closed page
+ * @steps:
+ *      1. Head past its sector: move on to the next one
+ *      2. Head at the start of a sector not all erased: erase it
+ *      3. Otherwise program the page, the CRC word last
+ *
+ * @param[in]  log: Pointer to a instance of bsp_evlog_t
+ *
+ * @return evlog_status_t: execute result of this function
+ **/
+static evlog_status_t __write_step ( bsp_evlog_t * const log )
+{
+    const evlog_sector_t * sector;
+    uint32_t             * src;
+    uint32_t             * dst;
+    uint64_t               t0_us;
+    evlog_status_t         ret;
+
+    /***************** 1. Next sector *********************/
+    if ( log->head_page >= __sector_pages( log, log->head_sector ) )
+    {
+        log->head_sector = ( log->head_sector + 1U ) % log->sector_num;
+        log->head_page   = 0U;
+        log->ahead       = 0U;
+    }
+    sector = &log->sector[log->head_sector];
+
+    /***************** 2. Erase on entry ******************/
+    // not erased ahead, or erased partly before a reset
+    if ( 0U == log->head_page &&
+         0U == __blank( sector->base, sector->bytes / 4U ) )
+    {
+        return __erase( log, log->head_sector );
+    }
+
+    /***************** 3. Program the page ****************/
+    dst = &sector->base[log->head_page * EVLOG_PAGE_WORDS];
+    log->head_page++;
+    if ( 0U == __blank( dst, EVLOG_PAGE_WORDS ) )
+    {
+        log->torn++;                              /* left by a reset */
+        return EVLOG_OK;
+    }
+    src = log->ram[( log->ram_fill + EVLOG_RAM_PAGES - log->ram_ready ) %
+                   EVLOG_RAM_PAGES];
+    src[EVLOG_CRC_WORD] = __page_crc( src );
+    t0_us = __now_us( log );
+    ret   = log->p_flash_operation_inst->pf_flash_program( dst, src,
+                                                           EVLOG_CRC_WORD );
+    if ( EVLOG_OK == ret )
+    {
+        ret = log->p_flash_operation_inst->pf_flash_program(
+                            &dst[EVLOG_CRC_WORD], &src[EVLOG_CRC_WORD], 1U );
+    }
+    __charge( log, t0_us );
+    if ( EVLOG_OK != ret )
+    {
+        // the page stays in RAM, it goes to the next one
+        LOG( LOG_LEVEL_ERR, "Event log program failed" );
+        return EVLOG_ERROR;
+    }
+    log->pages++;
+    log->pad_bytes += EVLOG_PAGE_DATA_BYTES - ( src[2] >> 16 );
+    log->p_os_critical->pf_os_critical_enter();
+    log->ram_ready--;
+    log->p_os_critical->pf_os_critical_exit();
+    return EVLOG_OK;
+}
+
+/**
+ * @brief: Checking the log can be used
+ *
+ * @param[in]  log: Pointer to a instance of bsp_evlog_t
+ *
+ * @return evlog_status_t: EVLOG_OK when mounted
+ **/
+static evlog_status_t __ready ( const bsp_evlog_t * const log )
+{
+    if ( NULL == log )
+    {
+        LOG( LOG_LEVEL_ERR, "Input parameter is null" );
+        return EVLOG_ERRORPARAMETER;
+    }
+    else if ( EVLOG_INITED != log->is_initialized || 0U == log->mounted )
+    {
+        return EVLOG_ERRORSOURCE;
+    }
+    return EVLOG_OK;
+}
+
+/**
+ * @brief: Writer task: service every period, dump on request
+ *
+ * @param[in]  argument: Pointer to a instance of bsp_evlog_t
+ **/
+static void evlog_task ( void * argument )
+{
+    bsp_evlog_t * log = (bsp_evlog_t *)argument;
+    uint32_t      bits;
+
+    for ( ;; )
+    {
+        bits = 0U;
+        signal_wait( &log->signal, EVLOG_SIG_FLUSH | log->dump_mask,
+                     EVLOG_SERVICE_MS, &bits                          );
+        if ( 0U != ( bits & log->dump_mask ) )
+        {
+            evlog_dump( log, 0U );
+        }
+        evlog_service( log );
+    }
+}
+
+/**
+ * @brief: Instantiate a bsp_evlog_t
+ * @steps:
+ *      1. Adding the flash, time and OS interfaces into the instance
+ *      2. Take the sectors of the ring, clear the RAM pages
+ *
+ * @param[in]  log:        Pointer to a instance of bsp_evlog_t
+ * @param[in]  flash_ops:  Pointer to a instance of evlog_flash_operation_t
+ * @param[in]  time_ops:   Pointer to a instance of time_operation_t
+ * @param[in]  critical:   Pointer to a instance of os_critical_t
+ * @param[in]  sectors:    the ring in order, copied
+ * @param[in]  sector_num: 2 .. EVLOG_MAX_SECTORS
+ *
+ * @return evlog_status_t: execute result of this function
+ **/
+evlog_status_t evlog_inst (
+                            bsp_evlog_t             * const log,
+                            evlog_flash_operation_t * const flash_ops,
+                            time_operation_t        * const time_ops,
+                            os_critical_t           * const critical,
+                            const evlog_sector_t    * const sectors,
+                            uint32_t                        sector_num
+                                                                          )
+{
+    /********** 1. Checking the input parameters **********/
+    if ( NULL == log                             ||
+         NULL == flash_ops                       ||
+         NULL == flash_ops->pf_flash_erase       ||
+         NULL == flash_ops->pf_flash_program     ||
+         NULL == time_ops                        ||
+         NULL == time_ops->pf_get_time_ms        ||
+         NULL == time_ops->pf_get_time_us        ||
+         NULL == critical                        ||
+         NULL == critical->pf_os_critical_enter  ||
+         NULL == critical->pf_os_critical_exit   ||
+         NULL == sectors
+                                                   )
+    {
+        LOG( LOG_LEVEL_ERR, "Input parameter is null" );
+        return EVLOG_ERRORPARAMETER;
+    }
+    // one sector is erased while the others keep the journal
+    if ( 2U > sector_num || EVLOG_MAX_SECTORS < sector_num )
+    {
+        LOG( LOG_LEVEL_ERR, "Event log needs 2 to %u sectors",
+                            (unsigned int)EVLOG_MAX_SECTORS );
+        return EVLOG_ERRORPARAMETER;
+    }
+    for ( uint32_t i = 0; i < sector_num; ++i )
+    {
+        if ( NULL == sectors[i].base                       ||
+             0U   == sectors[i].bytes                      ||
+             0U   != sectors[i].bytes % EVLOG_PAGE_BYTES )
+        {
+            LOG( LOG_LEVEL_ERR, "Event log sector %u not usable",
+                                (unsigned int)i );
+            return EVLOG_ERRORPARAMETER;
+        }
+    }
+
+    /************** 2. Checking the resource **************/
+    if ( EVLOG_INITED == log->is_initialized )
+    {
+        LOG( LOG_LEVEL_WARN, "Event log already initialized" );
+        return EVLOG_ERRORSOURCE;
+    }
+
+    /************** 3. Adding the interfaces **************/
+    // 3.1 mount external interfaces
+    log->p_flash_operation_inst = flash_ops;
+    log->p_time_operation_inst  = time_ops;
+    log->p_os_critical          = critical;
+
+    /************* 4. Initialize the instance *************/
+    memcpy( log->sector, sectors, sector_num * sizeof( evlog_sector_t ) );
+    log->sector_num     = sector_num;
+    log->mounted        = 0U;
+    log->head_sector    = 0U;
+    log->head_page      = 0U;
+    log->ahead          = 0U;
+    log->seq_next       = 0U;
+    log->ram_fill       = 0U;
+    log->ram_ready      = 0U;
+    log->fill_count     = 0U;
+    log->fill_used      = 0U;
+    log->fill_ms        = 0U;
+    log->budget_us      = (int32_t)EVLOG_BUDGET_BURST_US;
+    log->budget_rate_us = EVLOG_BUDGET_US;
+    log->budget_last_us = __now_us( log );
+    log->dump_mask      = EVLOG_SIG_DUMP;
+    log->records        = 0U;
+    log->dropped        = 0U;
+    log->pages          = 0U;
+    log->pad_bytes      = 0U;
+    log->erases         = 0U;
+    log->torn           = 0U;
+    log->busy_us        = 0U;
+    log->max_stall_us   = 0U;
+    log->signal.is_initialized = SIGNAL_NOT_INITED;
+    signal_instantiate( &log->signal, NULL );
+
+    log->is_initialized = EVLOG_INITED;
+    return EVLOG_OK;
+}
+
+/**
+ * @brief: Find the newest page, the next record continues its sequence
+ * @steps:
+ *      1. Per sector: find the last page not erased
+ *      2. The newest valid page of all gives the head and the sequence
+ *
+ * @param[in]  log: Pointer to a instance of bsp_evlog_t
+ *
+ * @return evlog_status_t: execute result of this function
+ **/
+evlog_status_t evlog_mount ( bsp_evlog_t * const log )
+{
+    const uint32_t       * page;
+    const evlog_sector_t * next;
+    uint32_t               written;
+    uint32_t               seq;
+    uint32_t               found = 0U;
+
+    if ( NULL == log )
+    {
+        LOG( LOG_LEVEL_ERR, "Input parameter is null" );
+        return EVLOG_ERRORPARAMETER;
+    }
+    else if ( EVLOG_INITED != log->is_initialized )
+    {
+        LOG( LOG_LEVEL_ERR, "Event log not initialized" );
+        return EVLOG_ERRORSOURCE;
+    }
+
+    log->head_sector = 0U;
+    log->head_page   = 0U;
+    log->seq_next    = 0U;
+    log->torn        = 0U;
+    for ( uint32_t s = 0; s < log->sector_num; ++s )
+    {
+        /************* 1. Last page not erased ************/
+        // a torn page may read erased at its first word
+        written = 0U;
+        for ( uint32_t p = __sector_pages( log, s ); p > 0U; --p )
+        {
+            if ( 0U == __blank( &log->sector[s].base[( p - 1U ) *
+                                                     EVLOG_PAGE_WORDS],
+                                EVLOG_PAGE_WORDS                    ) )
+            {
+                written = p;
+                break;
+            }
+        }
+
+        /************* 2. Newest valid page ***************/
+        for ( uint32_t p = written; p > 0U; --p )
+        {
+            page = &log->sector[s].base[( p - 1U ) * EVLOG_PAGE_WORDS];
+            if ( 0U == __page_valid( page ) )
+            {
+                log->torn++;
+                continue;
+            }
+            seq = page[1] + ( page[2] & 0xFFFFU );
+            if ( 0U == found || 0 < (int32_t)( seq - log->seq_next ) )
+            {
+                log->head_sector = s;
+                log->head_page   = written;
+                log->seq_next    = seq;
+            }
+            found = 1U;
+            break;
+        }
+    }
+    next         = &log->sector[( log->head_sector + 1U ) % log->sector_num];
+    log->ahead   = __blank( next->base, next->bytes / 4U );
+    log->mounted = 1U;
+    return EVLOG_OK;
+}
+
+/**
+ * @brief: Create the writer task, priority tskIDLE_PRIORITY + 1
+ *
+ * @param[in]  log: Pointer to a instance of bsp_evlog_t
+ *
+ * @return evlog_status_t: execute result of this function
+ **/
+evlog_status_t evlog_start ( bsp_evlog_t * const log )
+{
+    evlog_status_t ret = __ready( log );
+
+    if ( EVLOG_OK != ret )
+    {
+        LOG( LOG_LEVEL_ERR, "Event log not mounted" );
+        return ret;
+    }
+    if ( pdPASS != xTaskCreate( evlog_task,
+                                "evlog",
+                                EVLOG_STACK_WORDS,
+                                log,
+                                tskIDLE_PRIORITY + 1,
+                                NULL                  ) )
+    {
+        LOG( LOG_LEVEL_ERR, "Event log task create failed" );
+        return EVLOG_ERRORNOMEMORY;
+    }
+    return EVLOG_OK;
+}
+
+/**
+ * @brief: Add a record, task context, never touches the flash
+ *
+ * @param[in]  log:     Pointer to a instance of bsp_evlog_t
+ * @param[in]  id:      event id of the application
+ * @param[in]  payload: may be NULL when len is 0
+ * @param[in]  len:     0 .. EVLOG_MAX_PAYLOAD
+ *
+ * @return evlog_status_t: EVLOG_ERRORNOMEMORY when dropped
+ **/
+evlog_status_t evlog_write ( bsp_evlog_t * const log,
+                             uint16_t            id,
+                             const void  * const payload,
+                             uint32_t            len      )
+{
+    uint32_t       need   = 8U + ( ( len + 3U ) & ~3U );
+    uint32_t       closed = 0U;
+    uint32_t       now_ms = 0U;
+    uint32_t     * page;
+    uint32_t     * record;
+    evlog_status_t ret    = __ready( log );
+
+    if ( EVLOG_OK != ret )
+    {
+        return ret;
+    }
+    if ( EVLOG_MAX_PAYLOAD < len || ( 0U != len && NULL == payload ) )
+    {
+        LOG( LOG_LEVEL_ERR, "Input parameter is null" );
+        return EVLOG_ERRORPARAMETER;
+    }
+    log->p_time_operation_inst->pf_get_time_ms( &now_ms );
+
+    log->p_os_critical->pf_os_critical_enter();
+    /***************** 1. Find room **********************/
+    if ( EVLOG_RAM_PAGES > log->ram_ready &&
+         log->fill_used + need > EVLOG_PAGE_DATA_BYTES )
+    {
+        __page_close( log );
+        closed = 1U;
+    }
+    if ( EVLOG_RAM_PAGES == log->ram_ready )
+    {
+        log->dropped++;
+        log->p_os_critical->pf_os_critical_exit();
+        if ( 0U != closed )
+        {
+            signal_set( &log->signal, EVLOG_SIG_FLUSH );
+        }
+        return EVLOG_ERRORNOMEMORY;
+    }
+
+    /***************** 2. Add the record ******************/
+    page = log->ram[log->ram_fill];
+    if ( 0U == log->fill_count )
+    {
+        memset( page, 0xFF, EVLOG_PAGE_BYTES );
+        page[1]      = log->seq_next;
+        log->fill_ms = now_ms;
+    }
+    record    = &page[EVLOG_PAGE_HEADER_WORDS + log->fill_used / 4U];
+    record[0] = now_ms;
+    record[1] = EVLOG_RECORD_TAG | ( len << 16 ) | id;
+    if ( 0U != len )
+    {
+        memcpy( &record[2], payload, len );
+    }
+    log->fill_used += need;
+    log->fill_count++;
+    log->seq_next++;
+    log->records++;
+    log->p_os_critical->pf_os_critical_exit();
+
+    if ( 0U != closed )
+    {
+        signal_set( &log->signal, EVLOG_SIG_FLUSH );
+    }
+    return EVLOG_OK;
+}
+
+/**
+ * @brief: One pass of the writer, the task calls it every period
+ * @steps:
+ *      1. Refill the budget, close the page being filled once it is old
+ *      2. While the budget lasts: program the oldest closed page, or
+ *         erase the next sector ahead
+ *
+ * @param[in]  log: Pointer to a instance of bsp_evlog_t
+ *
+ * @return evlog_status_t: EVLOG_ERRORTIMEOUT when pages wait for budget
+ **/
+evlog_status_t evlog_service ( bsp_evlog_t * const log )
+{
+    uint32_t       now_ms = 0U;
+    evlog_status_t ret    = __ready( log );
+
+    if ( EVLOG_OK != ret )
+    {
+        return ret;
+    }
+
+    /***************** 1. Budget, old page ****************/
+    __budget_refill( log );
+    log->p_time_operation_inst->pf_get_time_ms( &now_ms );
+    log->p_os_critical->pf_os_critical_enter();
+    if ( 0U != log->fill_count                     &&
+         EVLOG_RAM_PAGES > log->ram_ready          &&
+         now_ms - log->fill_ms >= EVLOG_FLUSH_MS )
+    {
+        __page_close( log );
+    }
+    log->p_os_critical->pf_os_critical_exit();
+
+    /***************** 2. Write within the budget *********/
+    while ( 0 < log->budget_us )
+    {
+        if ( 0U != log->ram_ready )
+        {
+            ret = __write_step( log );
+        }
+        else if ( 0U == log->ahead                                      &&
+                  (int32_t)EVLOG_BUDGET_BURST_US <= log->budget_us      &&
+                  log->head_page + EVLOG_AHEAD_PAGES >=
+                  __sector_pages( log, log->head_sector )                  )
+        {
+            log->ahead = 1U;
+            ret        = __erase( log, ( log->head_sector + 1U ) %
+                                       log->sector_num             );
+        }
+        else
+        {
+            break;
+        }
+        if ( EVLOG_OK != ret )
+        {
+            return ret;
+        }
+    }
+    return ( 0U != log->ram_ready ) ? EVLOG_ERRORTIMEOUT : EVLOG_OK;
+}
+
+/**
+ * @brief: Write every record in RAM now, whatever the budget
+ *
+ * @param[in]  log: Pointer to a instance of bsp_evlog_t
+ *
+ * @return evlog_status_t: execute result of this function
+ **/
+evlog_status_t evlog_flush ( bsp_evlog_t * const log )
+{
+    evlog_status_t ret = __ready( log );
+
+    if ( EVLOG_OK != ret )
+    {
+        return ret;
+    }
+    log->p_os_critical->pf_os_critical_enter();
+    if ( 0U != log->fill_count && EVLOG_RAM_PAGES > log->ram_ready )
+    {
+        __page_close( log );
+    }
+    log->p_os_critical->pf_os_critical_exit();
+    while ( 0U != log->ram_ready )
+    {
+        ret = __write_step( log );
+        if ( EVLOG_OK != ret )
+        {
+            return ret;
+        }
+    }
+    return EVLOG_OK;
+}
+
+/**
+ * @brief: Flush, then print the journal oldest first
+ * @steps:
+ *      1. Flush the RAM pages
+ *      2. From the sector after the head round to the head, print the
+ *         records of every valid page
+ *
+ * @param[in]  log:      Pointer to a instance of bsp_evlog_t
+ * @param[in]  from_seq: first sequence number printed
+ *
+ * @return evlog_status_t: execute result of this function
+ **/
+evlog_status_t evlog_dump ( bsp_evlog_t * const log, uint32_t from_seq )
+{
+    const uint32_t * page;
+    const uint32_t * record;
+    const uint8_t  * payload;
+    uint32_t         s;
+    uint32_t         pages;
+    uint32_t         offset;
+    uint32_t         len;
+    uint32_t         printed = 0U;
+    evlog_status_t   ret     = evlog_flush( log );
+
+    /***************** 1. Flush ***************************/
+    if ( EVLOG_OK != ret && EVLOG_ERROR != ret )
+    {
+        return ret;
+    }
+
+    /***************** 2. Print oldest first **************/
+    printf( "# evlog\r\n" );
+    for ( uint32_t k = 1; k <= log->sector_num; ++k )
+    {
+        s     = ( log->head_sector + k ) % log->sector_num;
+        pages = ( s == log->head_sector ) ? log->head_page :
+                                            __sector_pages( log, s );
+        for ( uint32_t p = 0; p < pages; ++p )
+        {
+            page = &log->sector[s].base[p * EVLOG_PAGE_WORDS];
+            if ( 0U == __page_valid( page ) )
+            {
+                continue;
+            }
+            offset = 0U;
+            for ( uint32_t i = 0; i < ( page[2] & 0xFFFFU ); ++i )
+            {
+                record = &page[EVLOG_PAGE_HEADER_WORDS + offset / 4U];
+                len    = ( record[1] >> 16 ) & 0xFFU;
+                offset += 8U + ( ( len + 3U ) & ~3U );
+                if ( 0 > (int32_t)( page[1] + i - from_seq ) )
+                {
+                    continue;
+                }
+                printf( "evlog,%u,%u,%u,", (unsigned int)( page[1] + i ),
+                        (unsigned int)record[0],
+                        (unsigned int)( record[1] & 0xFFFFU ) );
+                payload = (const uint8_t *)&record[2];
+                for ( uint32_t b = 0; b < len; ++b )
+                {
+                    printf( "%02X", payload[b] );
+                }
+                printf( "\r\n" );
+                printed++;
+            }
+        }
+    }
+    printf( "# evlog end,%u,%u,%u\r\n", (unsigned int)printed,
+            (unsigned int)log->dropped, (unsigned int)log->erases );
+    return ret;
+}
+
+/**
+ * @brief: Ask the writer for a dump, from any task
+ *
+ * @param[in]  log: Pointer to a instance of bsp_evlog_t
+ *
+ * @return evlog_status_t: execute result of this function
+ **/
+evlog_status_t evlog_dump_request ( bsp_evlog_t * const log )
+{
+    evlog_status_t ret = __ready( log );
+
+    if ( EVLOG_OK != ret )
+    {
+        return ret;
+    }
+    return ( SIGNAL_OK == signal_set( &log->signal, EVLOG_SIG_DUMP ) ) ?
+           EVLOG_OK : EVLOG_ERRORSOURCE;
+}
+
+//******************************** Defines **********************************//
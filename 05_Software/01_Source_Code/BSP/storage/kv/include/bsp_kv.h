@@ -0,0 +1,233 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_kv.h
+ *
+ * @par dependencies
+ * - bsp_osal.h
+ *
+ * @author Damian
+ *
+ * @brief Key/value store in two internal flash sectors: append-only
+ *        records with a CRC each, garbage collection by sector swap and a
+ *        RAM index rebuilt at mount.
+ *
+ * Processing flow:
+ *
+ * kv_store_inst  -> kv_store_mount (scan the active sector, build the index)
+ * kv_get         -> index[key] -> copy the value out of the flash, O(1)
+ * kv_set         -> same value: nothing written
+ *                -> no room left: kv_store_compact
+ *                -> program header + value, then the CRC word as the commit
+ * kv_delete      -> kv_set of an empty value, a tombstone
+ * kv_store_compact
+ *                -> erase the other sector, copy the live records, write
+ *                   the sector header as the commit, switch
+ *
+ * Layout of a sector, all words:
+ *
+ *  [generation][KV_SECTOR_MAGIC][record][record]...[erased]
+ *  record: [KV_RECORD_TAG | len << 8 | key][value, padded 0xFF][CRC-32]
+ *
+ * Power loss:
+ *  - inside a record: the CRC word is written last, the mount skips the
+ *    record and the key keeps its previous value. A torn header stops the
+ *    scan, the next kv_set compacts first.
+ *  - inside a compaction: the new sector gets its magic last, without it
+ *    the mount keeps the old one. With both valid the higher generation
+ *    wins, the older one is erased by the next compaction.
+ *
+ * Wear: every compaction erases the sector it switches to, so both sectors
+ * see the same number of erases. An unchanged value is never written.
+ *
+ * Mount time is bounded by the sector size: one pass over the headers and
+ * a CRC over at most one sector, see bsp_bench_kv.
+ *
+ * Erasing a sector stalls every code fetch from the flash (single bank)
+ * for a few hundred ms, ISRs included: compact from a task which can wait
+ * and before the time critical parts run.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+#ifndef __BSP_KV_H__
+#define __BSP_KV_H__
+
+//******************************** Includes *********************************//
+
+#include "bsp_osal.h"
+#include <stdint.h>
+
+//******************************** Includes *********************************//
+
+typedef struct bsp_kv_store bsp_kv_store_t;
+
+//******************************** Defines **********************************//
+
+#define KV_SECTOR_NUM             2U         /* sectors swapped by the GC   */
+#define KV_MAX_KEYS               64U        /* keys 0 .. KV_MAX_KEYS - 1   */
+#define KV_MAX_VALUE_LEN          256U       /* bytes of one value          */
+#define KV_SECTOR_MAGIC           0x4B565331U /* "KVS1", header committed   */
+#define KV_RECORD_TAG             0xA5000000U /* top byte of a header word  */
+#define KV_HEADER_WORDS           2U         /* generation, magic           */
+#define KV_RECORD_MAX_WORDS       ( 2U + KV_MAX_VALUE_LEN / 4U )
+
+typedef enum
+{
+    KV_OK                        = 0,  /* KV operate successfully            */
+    KV_ERROR                     = 1,  /* KV flash program or verify failed  */
+    KV_ERRORTIMEOUT              = 2,  /* KV lock not taken in time          */
+    KV_ERRORSOURCE               = 3,  /* KV key not found or not mounted    */
+    KV_ERRORPARAMETER            = 4,  /* KV parameter error                 */
+    KV_ERRORNOMEMORY             = 5,  /* KV sector full of live values      */
+    KV_ERRORISR                  = 6,  /* KV not allowed in ISR context      */
+    KV_RESERVED                  = 0xFF,/* KV reserved                       */
+} kv_status_t;
+
+typedef enum
+{
+    KV_STORE_INITED     = 0,  /* kv store initialized                        */
+    KV_STORE_NOT_INITED = 1,  /* kv store not initialized                    */
+} kv_store_init_t;
+
+typedef struct
+{
+    /* erase one sector of the store, 0 .. KV_SECTOR_NUM - 1               */
+    kv_status_t ( *pf_flash_erase )   ( uint32_t sector );
+    /* program words, dst inside a sector and erased                       */
+    kv_status_t ( *pf_flash_program ) ( uint32_t       * const dst,
+                                        const uint32_t * const src,
+                                        uint32_t               words );
+} kv_flash_operation_t;
+
+typedef struct bsp_kv_store
+{
+    //************************* Internal property ***************************//
+    kv_store_init_t       is_initialized;             /* record init status  */
+    uint32_t              * sector[KV_SECTOR_NUM];    /* memory mapped bases */
+    uint32_t              sector_words;               /* size of a sector    */
+    uint32_t              mounted;                    /* 1 after the mount   */
+    uint32_t              active;                     /* sector in use       */
+    uint32_t              generation;                 /* of the active one   */
+    uint32_t              tail;                       /* next record, words  */
+    uint32_t              index[KV_MAX_KEYS];         /* record, 0: absent   */
+    uint32_t              live_words;                 /* words of the index  */
+    uint32_t              record[KV_RECORD_MAX_WORDS];/* record being built  */
+    void                  * mutex;                    /* serializes callers  */
+
+    //***************************** Statistics ******************************//
+    uint32_t              scan_records;               /* seen by the mount   */
+    uint32_t              torn;                       /* skipped by the mount*/
+    uint32_t              writes;                     /* records written     */
+    uint32_t              compactions;                /* sector swaps        */
+
+    //************************ Interface from core **************************//
+    kv_flash_operation_t  * p_flash_operation_inst;   /* flash interface     */
+
+    //************************ Interface from RTOS **************************//
+    os_mutex_t            * p_os_mutex;               /* os mutex interface  */
+
+} bsp_kv_store_t;
+
+//******************************** Defines **********************************//
+
+//******************************* Declaring *********************************//
+
+/**
+ * @brief: Instantiate a bsp_kv_store_t
+ * @steps:
+ *      1. Adding the flash and OS interfaces into the instance
+ *      2. Create the mutex, clear the index
+ *
+ * @param[in]  store:        Pointer to a instance of bsp_kv_store_t
+ * @param[in]  flash_ops:    Pointer to a instance of kv_flash_operation_t
+ * @param[in]  os_mutex:     Pointer to a instance of os_mutex_t
+ * @param[in]  sector0:      memory mapped base of sector 0, word aligned
+ * @param[in]  sector1:      memory mapped base of sector 1, word aligned
+ * @param[in]  sector_bytes: size of one sector
+ *
+ * @return kv_status_t: execute result of this function
+ **/
+kv_status_t kv_store_inst (
+                            bsp_kv_store_t        * const store,
+                            kv_flash_operation_t  * const flash_ops,
+                            os_mutex_t            * const os_mutex,
+                            uint32_t              * const sector0,
+                            uint32_t              * const sector1,
+                            uint32_t                      sector_bytes
+                                                                          );
+
+/**
+ * @brief: Find the active sector and rebuild the index from its records
+ * @steps:
+ *      1. Pick the valid sector with the higher generation, format if none
+ *      2. Walk the records, the last one with a good CRC wins per key
+ *
+ * @param[in]  store: Pointer to a instance of bsp_kv_store_t
+ *
+ * @return kv_status_t: execute result of this function
+ **/
+kv_status_t kv_store_mount ( bsp_kv_store_t * const store );
+
+/**
+ * @brief: Read the value of a key
+ *
+ * @param[in]  store: Pointer to a instance of bsp_kv_store_t
+ * @param[in]  key:   0 .. KV_MAX_KEYS - 1
+ * @param[out] buf:   the value
+ * @param[in]  size:  size of buf, a longer value is cut
+ * @param[out] len:   length of the stored value, may be NULL
+ *
+ * @return kv_status_t: KV_ERRORSOURCE when the key is not set
+ **/
+kv_status_t kv_get ( bsp_kv_store_t * const store,
+                     uint32_t               key,
+                     void           * const buf,
+                     uint32_t               size,
+                     uint32_t       * const len    );
+
+/**
+ * @brief: Write the value of a key, it is kept over a reset
+ *
+ * @param[in]  store: Pointer to a instance of bsp_kv_store_t
+ * @param[in]  key:   0 .. KV_MAX_KEYS - 1
+ * @param[in]  data:  the value
+ * @param[in]  len:   1 .. KV_MAX_VALUE_LEN
+ *
+ * @return kv_status_t: execute result of this function
+ **/
+kv_status_t kv_set ( bsp_kv_store_t * const store,
+                     uint32_t               key,
+                     const void     * const data,
+                     uint32_t               len    );
+
+/**
+ * @brief: Remove a key
+ *
+ * @param[in]  store: Pointer to a instance of bsp_kv_store_t
+ * @param[in]  key:   0 .. KV_MAX_KEYS - 1
+ *
+ * @return kv_status_t: execute result of this function
+ **/
+kv_status_t kv_delete ( bsp_kv_store_t * const store, uint32_t key );
+
+/**
+ * @brief: Copy the live records into the other sector and switch to it
+ * @steps:
+ *      1. Erase the other sector
+ *      2. Copy the record of every key in the index
+ *      3. Write the generation, then the magic as the commit
+ *
+ * @param[in]  store: Pointer to a instance of bsp_kv_store_t
+ *
+ * @return kv_status_t: execute result of this function
+ **/
+kv_status_t kv_store_compact ( bsp_kv_store_t * const store );
+
+//******************************* Declaring *********************************//
+#endif // __BSP_KV_H__
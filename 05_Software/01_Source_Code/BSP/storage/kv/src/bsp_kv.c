@@ -0,0 +1,709 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_kv.c
+ *
+ * @par dependencies
+ * - bsp_kv.h
+ * - bsp_common.h
+ *
+ * @author Damian
+ *
+ * @brief Key/value store in two internal flash sectors: append-only
+ *        records with a CRC each, garbage collection by sector swap and a
+ *        RAM index rebuilt at mount.
+ *
+ * Processing flow:
+ *
+ * Call directly.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+//******************************** Includes *********************************//
+
+#include "bsp_kv.h"
+#include "bsp_common.h"
+#include <string.h>
+
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+BSP_STATUS_CHECK( KV );
+
+#define KV_ERASED                 0xFFFFFFFFU
+#define KV_TAG_MASK               0xFF000000U
+
+/* CRC-32 (IEEE 802.3, reflected), 4 bits per step */
+static const uint32_t s_crc_nibble[16] =
+{
+    0x00000000U, 0x1DB71064U, 0x3B6E20C8U, 0x26D930ACU,
+    0x76DC4190U, 0x6B6B51F4U, 0x4DB26158U, 0x5005713CU,
+    0xEDB88320U, 0xF00F9344U, 0xD6D6A3E8U, 0xCB61B38CU,
+    0x9B64C2B0U, 0x86D3D2D4U, 0xA00AE278U, 0xBDBDF21CU,
+};
+
+/**
+ * @brief: CRC-32 of a record, a 16 entry table keeps it out of the RAM
+ *
+ * @param[in]  data: the bytes
+ * @param[in]  len:  number of bytes
+ *
+ * @return uint32_t: the CRC
+ **/
+static uint32_t __crc32 ( const void * const data, uint32_t len )
+{
+    const uint8_t * p   = (const uint8_t *)data;
+    uint32_t        crc = 0xFFFFFFFFU;
+
+    for ( uint32_t i = 0; i < len; ++i )
+    {
+        crc ^= p[i];
+        crc  = ( crc >> 4 ) ^ s_crc_nibble[crc & 0xFU];
+        crc  = ( crc >> 4 ) ^ s_crc_nibble[crc & 0xFU];
+    }
+    return ~crc;
+}
+
+/**
+ * @brief: Words of a record holding len bytes: header, value, CRC
+ *
+ * @param[in]  len: bytes of the value
+ *
+ * @return uint32_t: the words
+ **/
+static uint32_t __record_words ( uint32_t len )
+{
+    return 2U + ( len + 3U ) / 4U;
+}
+
+/**
+ * @brief: Checking a record header read from the flash
+ *
+ * @param[in]  store:  Pointer to a instance of bsp_kv_store_t
+ * @param[in]  offset: word offset of the header in the active sector
+ * @param[out] words:  words of the record
+ *
+ * @return uint32_t: 1 when the header is sane and the record fits
+ **/
+static uint32_t __header_valid ( const bsp_kv_store_t * const store,
+                                 uint32_t                     offset,
+                                 uint32_t             * const words  )
+{
+    uint32_t header = store->sector[store->active][offset];
+    uint32_t len    = ( header >> 8 ) & 0xFFFFU;
+
+    *words = __record_words( len );
+    return ( KV_RECORD_TAG    == ( header & KV_TAG_MASK ) &&
+             KV_MAX_KEYS      >  ( header & 0xFFU )        &&
+             KV_MAX_VALUE_LEN >= len                       &&
+             offset + *words  <= store->sector_words ) ? 1U : 0U;
+}
+
+/**
+ * @brief: Checking the words are still erased
+ *
+ * @param[in]  p:     first word
+ * @param[in]  words: number of words
+ *
+ * @return uint32_t: 1 when all of them read 0xFFFFFFFF
+ **/
+static uint32_t __blank ( const uint32_t * const p, uint32_t words )
+{
+    for ( uint32_t i = 0; i < words; ++i )
+    {
+        if ( KV_ERASED != p[i] )
+        {
+            return 0U;
+        }
+    }
+    return 1U;
+}
+
+/**
+ * @brief: Program words and read them back
+ *
+ * @param[in]  store: Pointer to a instance of bsp_kv_store_t
+ * @param[in]  dst:   inside a sector of the store
+ * @param[in]  src:   the words
+ * @param[in]  words: number of words
+ *
+ * @return kv_status_t: KV_ERROR when the flash does not hold them after
+ **/
+static kv_status_t __program ( bsp_kv_store_t * const store,
+                               uint32_t       * const dst,
+                               const uint32_t * const src,
+                               uint32_t               words )
+{
+    if ( KV_OK != store->p_flash_operation_inst->pf_flash_program( dst, src,
+                                                                   words ) ||
+         0 != memcmp( dst, src, words * 4U ) )
+    {
+        LOG( LOG_LEVEL_ERR, "KV flash program failed" );
+        return KV_ERROR;
+    }
+    return KV_OK;
+}
+
+/**
+ * @brief: Erase a sector and give it a header, the magic written last
+ *
+ * @param[in]  store:      Pointer to a instance of bsp_kv_store_t
+ * @param[in]  sector:     sector to write
+ * @param[in]  generation: of the sector
+ * @param[in]  erase:      0 when the caller erased it already
+ *
+ * @return kv_status_t: execute result of this function
+ **/
+static kv_status_t __sector_header ( bsp_kv_store_t * const store,
+                                     uint32_t               sector,
+                                     uint32_t               generation,
+                                     uint32_t               erase       )
+{
+    const uint32_t magic = KV_SECTOR_MAGIC;
+
+    if ( 0U != erase &&
+         KV_OK != store->p_flash_operation_inst->pf_flash_erase( sector ) )
+    {
+        LOG( LOG_LEVEL_ERR, "KV flash erase failed" );
+        return KV_ERROR;
+    }
+    if ( KV_OK != __program( store, &store->sector[sector][0],
+                             &generation, 1U )                   ||
+         KV_OK != __program( store, &store->sector[sector][1], &magic, 1U ) )
+    {
+        return KV_ERROR;
+    }
+    return KV_OK;
+}
+
+/**
+ * @brief: Point the index of a key at a record, keep live_words in step
+ *
+ * @param[in]  store:  Pointer to a instance of bsp_kv_store_t
+ * @param[in]  key:    the key
+ * @param[in]  len:    bytes of the value, 0 for a tombstone
+ * @param[in]  offset: word offset of the record
+ **/
+static void __index_update ( bsp_kv_store_t * const store,
+                             uint32_t               key,
+                             uint32_t               len,
+                             uint32_t               offset )
+{
+    uint32_t old = store->index[key];
+
+    if ( 0U != old )
+    {
+        store->live_words -= __record_words(
+                    ( store->sector[store->active][old] >> 8 ) & 0xFFFFU );
+    }
+    store->index[key] = ( 0U == len ) ? 0U : offset;
+    if ( 0U != len )
+    {
+        store->live_words += __record_words( len );
+    }
+}
+
+/**
+ * @brief: Checking the store can be used, then take its mutex
+ *
+ * @param[in]  store: Pointer to a instance of bsp_kv_store_t
+ * @param[in]  key:   key of the call, KV_MAX_KEYS when there is none
+ *
+ * @return kv_status_t: KV_OK with the mutex held
+ **/
+static kv_status_t __enter ( bsp_kv_store_t * const store, uint32_t key )
+{
+    if ( NULL == store || KV_MAX_KEYS < key )
+    {
+        LOG( LOG_LEVEL_ERR, "Input parameter is null" );
+        return KV_ERRORPARAMETER;
+    }
+    else if ( KV_STORE_INITED != store->is_initialized || 0U == store->mounted )
+    {
+        LOG( LOG_LEVEL_ERR, "KV store not mounted" );
+        return KV_ERRORSOURCE;
+    }
+    if ( BSP_OK != store->p_os_mutex->pf_os_mutex_lock( store->mutex,
+                                                        BSP_WAIT_FOREVER ) )
+    {
+        return KV_ERRORTIMEOUT;
+    }
+    return KV_OK;
+}
+
+/**
+ * @brief: Release the mutex taken by __enter
+ *
+ * @param[in]  store: Pointer to a instance of bsp_kv_store_t
+ * @param[in]  ret:   status handed back
+ *
+ * @return kv_status_t: ret
+ **/
+static kv_status_t __leave ( bsp_kv_store_t * const store, kv_status_t ret )
+{
+    store->p_os_mutex->pf_os_mutex_unlock( store->mutex );
+    return ret;
+}
+
+/**
+ * @brief: Compaction with the mutex held
+ * @steps:
+ *      1. Erase the other sector
+ *      2. Copy the record of every key in the index
+ *      3. Write the generation, then the magic as the commit
+ *      4. Switch, the index follows the copies
+ *
+ * @param[in]  store: Pointer to a instance of bsp_kv_store_t
+ *
+ * @return kv_status_t: execute result of this function
+ **/
+static kv_status_t __compact ( bsp_kv_store_t * const store )
+{
+    uint32_t   target = ( store->active + 1U ) % KV_SECTOR_NUM;
+    uint32_t * src    = store->sector[store->active];
+    uint32_t * dst    = store->sector[target];
+    uint32_t   offset = KV_HEADER_WORDS;
+    uint32_t   words;
+
+    /***************** 1. Erase the target ****************/
+    if ( KV_OK != store->p_flash_operation_inst->pf_flash_erase( target ) )
+    {
+        LOG( LOG_LEVEL_ERR, "KV flash erase failed" );
+        return KV_ERROR;
+    }
+
+    /***************** 2. Copy the live records ***********/
+    // records were checked when written or mounted, their CRC goes along
+    for ( uint32_t key = 0; key < KV_MAX_KEYS; ++key )
+    {
+        if ( 0U == store->index[key] )
+        {
+            continue;
+        }
+        words = __record_words( ( src[store->index[key]] >> 8 ) & 0xFFFFU );
+        if ( KV_OK != __program( store, &dst[offset],
+                                 &src[store->index[key]], words ) )
+        {
+            return KV_ERROR;
+        }
+        offset += words;
+    }
+
+    /***************** 3. Commit the sector ***************/
+    if ( KV_OK != __sector_header( store, target,
+                                   store->generation + 1U, 0U ) )
+    {
+        return KV_ERROR;
+    }
+
+    /***************** 4. Switch **************************/
+    offset = KV_HEADER_WORDS;
+    for ( uint32_t key = 0; key < KV_MAX_KEYS; ++key )
+    {
+        if ( 0U == store->index[key] )
+        {
+            continue;
+        }
+        words             = __record_words(
+                            ( src[store->index[key]] >> 8 ) & 0xFFFFU );
+        store->index[key] = offset;
+        offset           += words;
+    }
+    store->active = target;
+    store->generation++;
+    store->tail = offset;
+    store->compactions++;
+    return KV_OK;
+}
+
+/**
+ * @brief: Append a record with the mutex held
+ * @steps:
+ *      1. Make room, compact when the tail is full or not erased
+ *      2. Build the record, the CRC over header and padded value
+ *      3. Program header and value, then the CRC as the commit
+ *
+ * @param[in]  store: Pointer to a instance of bsp_kv_store_t
+ * @param[in]  key:   the key
+ * @param[in]  data:  the value, NULL for a tombstone
+ * @param[in]  len:   bytes of the value, 0 for a tombstone
+ *
+ * @return kv_status_t: execute result of this function
+ **/
+static kv_status_t __append ( bsp_kv_store_t * const store,
+                              uint32_t               key,
+                              const void     * const data,
+                              uint32_t               len    )
+{
+    uint32_t   words = __record_words( len );
+    uint32_t   live  = store->live_words;
+    uint32_t * dst;
+
+    /***************** 1. Make room ***********************/
+    if ( 0U != store->index[key] )
+    {
+        live -= __record_words(
+            ( store->sector[store->active][store->index[key]] >> 8 ) &
+            0xFFFFU );
+    }
+    if ( store->tail + words > store->sector_words ||
+         0U == __blank( &store->sector[store->active][store->tail], words ) )
+    {
+        if ( KV_HEADER_WORDS + live + words > store->sector_words )
+        {
+            LOG( LOG_LEVEL_ERR, "KV store full" );
+            return KV_ERRORNOMEMORY;
+        }
+        if ( KV_OK != __compact( store ) )
+        {
+            return KV_ERROR;
+        }
+    }
+    dst = &store->sector[store->active][store->tail];
+
+    /***************** 2. Build the record ****************/
+    store->record[0] = KV_RECORD_TAG | ( len << 8 ) | key;
+    memset( &store->record[1], 0xFF, ( words - 2U ) * 4U );
+    if ( 0U != len )
+    {
+        memcpy( &store->record[1], data, len );
+    }
+    store->record[words - 1U] = __crc32( store->record, ( words - 1U ) * 4U );
+
+    /***************** 3. Program, CRC last ***************/
+    // the words are used from here on, a failed record is skipped
+    store->tail += words;
+    store->writes++;
+    if ( KV_OK != __program( store, dst, store->record, words - 1U ) ||
+         KV_OK != __program( store, &dst[words - 1U],
+                             &store->record[words - 1U], 1U ) )
+    {
+        return KV_ERROR;
+    }
+    __index_update( store, key, len,
+                    (uint32_t)( dst - store->sector[store->active] ) );
+    return KV_OK;
+}
+
+/**
+ * @brief: Instantiate a bsp_kv_store_t
+ * @steps:
+ *      1. Adding the flash and OS interfaces into the instance
+ *      2. Create the mutex, clear the index
+ *
+ * @param[in]  store:        Pointer to a instance of bsp_kv_store_t
+ * @param[in]  flash_ops:    Pointer to a instance of kv_flash_operation_t
+ * @param[in]  os_mutex:     Pointer to a instance of os_mutex_t
+ * @param[in]  sector0:      memory mapped base of sector 0, word aligned
+ * @param[in]  sector1:      memory mapped base of sector 1, word aligned
+ * @param[in]  sector_bytes: size of one sector
+ *
+ * @return kv_status_t: execute result of this function
+ **/
+kv_status_t kv_store_inst (
+                            bsp_kv_store_t        * const store,
+                            kv_flash_operation_t  * const flash_ops,
+                            os_mutex_t            * const os_mutex,
+                            uint32_t              * const sector0,
+                            uint32_t              * const sector1,
+                            uint32_t                      sector_bytes
+                                                                          )
+{
+    /********** 1. Checking the input parameters **********/
+    if ( NULL == store                         ||
+         NULL == flash_ops                     ||
+         NULL == flash_ops->pf_flash_erase     ||
+         NULL == flash_ops->pf_flash_program   ||
+         NULL == os_mutex                      ||
+         NULL == os_mutex->pf_os_mutex_create  ||
+         NULL == os_mutex->pf_os_mutex_lock    ||
+         NULL == os_mutex->pf_os_mutex_unlock  ||
+         NULL == sector0                       ||
+         NULL == sector1
+                                                 )
+    {
+        LOG( LOG_LEVEL_ERR, "Input parameter is null" );
+        return KV_ERRORPARAMETER;
+    }
+    // a 16 bit record length and the largest record have to fit
+    if ( 0U != sector_bytes % 4U                                       ||
+         ( KV_HEADER_WORDS + KV_RECORD_MAX_WORDS ) * 4U > sector_bytes )
+    {
+        LOG( LOG_LEVEL_ERR, "KV sector size %u not usable",
+                            (unsigned int)sector_bytes );
+        return KV_ERRORPARAMETER;
+    }
+
+    /************** 2. Checking the resource **************/
+    if ( KV_STORE_INITED == store->is_initialized )
+    {
+        LOG( LOG_LEVEL_WARN, "KV store already initialized" );
+        return KV_ERRORSOURCE;
+    }
+
+    /************** 3. Adding the interfaces **************/
+    // 3.1 mount external interfaces
+    store->p_flash_operation_inst = flash_ops;
+    store->p_os_mutex             = os_mutex;
+
+    /************* 4. Initialize the instance *************/
+    if ( BSP_OK != os_mutex->pf_os_mutex_create( &store->mutex ) )
+    {
+        LOG( LOG_LEVEL_ERR, "KV mutex create failed" );
+        return KV_ERRORNOMEMORY;
+    }
+    store->sector[0]    = sector0;
+    store->sector[1]    = sector1;
+    store->sector_words = sector_bytes / 4U;
+    store->mounted      = 0U;
+    store->active       = 0U;
+    store->generation   = 0U;
+    store->tail         = KV_HEADER_WORDS;
+    store->live_words   = 0U;
+    store->scan_records = 0U;
+    store->torn         = 0U;
+    store->writes       = 0U;
+    store->compactions  = 0U;
+    memset( store->index, 0, sizeof( store->index ) );
+
+    store->is_initialized = KV_STORE_INITED;
+    return KV_OK;
+}
+
+/**
+ * @brief: Find the active sector and rebuild the index from its records
+ * @steps:
+ *      1. Pick the valid sector with the higher generation, format if none
+ *      2. Walk the records, the last one with a good CRC wins per key
+ *
+ * @param[in]  store: Pointer to a instance of bsp_kv_store_t
+ *
+ * @return kv_status_t: execute result of this function
+ **/
+kv_status_t kv_store_mount ( bsp_kv_store_t * const store )
+{
+    const uint32_t * s;
+    uint32_t         valid = 0U;
+    uint32_t         offset;
+    uint32_t         words;
+    uint32_t         header;
+
+    if ( NULL == store )
+    {
+        LOG( LOG_LEVEL_ERR, "Input parameter is null" );
+        return KV_ERRORPARAMETER;
+    }
+    else if ( KV_STORE_INITED != store->is_initialized )
+    {
+        LOG( LOG_LEVEL_ERR, "KV store not initialized" );
+        return KV_ERRORSOURCE;
+    }
+
+    /************* 1. Pick the active sector **************/
+    for ( uint32_t i = 0; i < KV_SECTOR_NUM; ++i )
+    {
+        s = store->sector[i];
+        if ( KV_SECTOR_MAGIC != s[1] || KV_ERASED == s[0] )
+        {
+            continue;
+        }
+        // both valid: power lost after a commit, the newer one wins
+        if ( 0U == valid || 0 < (int32_t)( s[0] - store->generation ) )
+        {
+            store->active     = i;
+            store->generation = s[0];
+        }
+        valid++;
+    }
+    if ( 0U == valid )
+    {
+        LOG( LOG_LEVEL_WARN, "KV store blank, formatting" );
+        store->active     = 0U;
+        store->generation = 1U;
+        if ( KV_OK != __sector_header( store, 0U, 1U, 1U ) )
+        {
+            return KV_ERROR;
+        }
+    }
+
+    /************* 2. Walk the records ********************/
+    s                   = store->sector[store->active];
+    offset              = KV_HEADER_WORDS;
+    store->live_words   = 0U;
+    store->scan_records = 0U;
+    store->torn         = 0U;
+    memset( store->index, 0, sizeof( store->index ) );
+    while ( offset < store->sector_words && KV_ERASED != s[offset] )
+    {
+        // a torn header: nothing was written after it, kv_set compacts
+        if ( 0U == __header_valid( store, offset, &words ) )
+        {
+            store->torn++;
+            offset = store->sector_words;
+            break;
+        }
+        store->scan_records++;
+        header = s[offset];
+        if ( s[offset + words - 1U] == __crc32( &s[offset],
+                                                ( words - 1U ) * 4U ) )
+        {
+            __index_update( store, header & 0xFFU,
+                            ( header >> 8 ) & 0xFFFFU, offset );
+        }
+        else
+        {
+            store->torn++;
+        }
+        offset += words;
+    }
+    store->tail    = offset;
+    store->mounted = 1U;
+    return KV_OK;
+}
+
+/**
+ * @brief: Read the value of a key
+ *
+ * @param[in]  store: Pointer to a instance of bsp_kv_store_t
+ * @param[in]  key:   0 .. KV_MAX_KEYS - 1
+ * @param[out] buf:   the value
+ * @param[in]  size:  size of buf, a longer value is cut
+ * @param[out] len:   length of the stored value, may be NULL
+ *
+ * @return kv_status_t: KV_ERRORSOURCE when the key is not set
+ **/
+kv_status_t kv_get ( bsp_kv_store_t * const store,
+                     uint32_t               key,
+                     void           * const buf,
+                     uint32_t               size,
+                     uint32_t       * const len    )
+{
+    const uint32_t * record;
+    uint32_t         value_len;
+    kv_status_t      ret;
+
+    if ( NULL == buf || KV_MAX_KEYS <= key )
+    {
+        LOG( LOG_LEVEL_ERR, "Input parameter is null" );
+        return KV_ERRORPARAMETER;
+    }
+    ret = __enter( store, key );
+    if ( KV_OK != ret )
+    {
+        return ret;
+    }
+    if ( 0U == store->index[key] )
+    {
+        return __leave( store, KV_ERRORSOURCE );
+    }
+    record    = &store->sector[store->active][store->index[key]];
+    value_len = ( record[0] >> 8 ) & 0xFFFFU;
+    memcpy( buf, &record[1], ( value_len < size ) ? value_len : size );
+    if ( NULL != len )
+    {
+        *len = value_len;
+    }
+    return __leave( store, KV_OK );
+}
+
+/**
+ * @brief: Write the value of a key, it is kept over a reset
+ *
+ * @param[in]  store: Pointer to a instance of bsp_kv_store_t
+ * @param[in]  key:   0 .. KV_MAX_KEYS - 1
+ * @param[in]  data:  the value
+ * @param[in]  len:   1 .. KV_MAX_VALUE_LEN
+ *
+ * @return kv_status_t: execute result of this function
+ **/
+kv_status_t kv_set ( bsp_kv_store_t * const store,
+                     uint32_t               key,
+                     const void     * const data,
+                     uint32_t               len    )
+{
+    const uint32_t * record;
+    kv_status_t      ret;
+
+    if ( NULL == data || KV_MAX_KEYS <= key ||
+         0U == len    || KV_MAX_VALUE_LEN < len )
+    {
+        LOG( LOG_LEVEL_ERR, "Input parameter is null" );
+        return KV_ERRORPARAMETER;
+    }
+    ret = __enter( store, key );
+    if ( KV_OK != ret )
+    {
+        return ret;
+    }
+    // the same value again costs no flash
+    if ( 0U != store->index[key] )
+    {
+        record = &store->sector[store->active][store->index[key]];
+        if ( len == ( ( record[0] >> 8 ) & 0xFFFFU ) &&
+             0   == memcmp( &record[1], data, len ) )
+        {
+            return __leave( store, KV_OK );
+        }
+    }
+    return __leave( store, __append( store, key, data, len ) );
+}
+
+/**
+ * @brief: Remove a key
+ *
+ * @param[in]  store: Pointer to a instance of bsp_kv_store_t
+ * @param[in]  key:   0 .. KV_MAX_KEYS - 1
+ *
+ * @return kv_status_t: execute result of this function
+ **/
+kv_status_t kv_delete ( bsp_kv_store_t * const store, uint32_t key )
+{
+    kv_status_t ret;
+
+    if ( KV_MAX_KEYS <= key )
+    {
+        LOG( LOG_LEVEL_ERR, "Input parameter is null" );
+        return KV_ERRORPARAMETER;
+    }
+    ret = __enter( store, key );
+    if ( KV_OK != ret )
+    {
+        return ret;
+    }
+    if ( 0U == store->index[key] )
+    {
+        return __leave( store, KV_OK );
+    }
+    return __leave( store, __append( store, key, NULL, 0U ) );
+}
+
+/**
+ * @brief: Copy the live records into the other sector and switch to it
+ * @steps:
+ *      1. Erase the other sector
+ *      2. Copy the record of every key in the index
+ *      3. Write the generation, then the magic as the commit
+ *
+ * @param[in]  store: Pointer to a instance of bsp_kv_store_t
+ *
+ * @return kv_status_t: execute result of this function
+ **/
+kv_status_t kv_store_compact ( bsp_kv_store_t * const store )
+{
+    kv_status_t ret = __enter( store, KV_MAX_KEYS );
+
+    if ( KV_OK != ret )
+    {
+        return ret;
+    }
+    return __leave( store, __compact( store ) );
+}
+
+//******************************** Defines **********************************//
@@ -0,0 +1,117 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_time.h
+ *
+ * @par dependencies
+ * - stdint.h
+ *
+ * @author Damian
+ *
+ * @brief Provide 64-bit monotonic timestamps in CPU cycles, microseconds and
+ *        milliseconds, lock-free and callable from tasks and ISRs.
+ *
+ * Processing flow:
+ *
+ * time_init -> time_tick_isr (every 1 ms from the TIM1 timebase callback)
+ *           -> time_get_cycles / time_get_us / time_get_ms (any context)
+ *
+ * The cycle count is the 32-bit DWT CYCCNT extended to 64 bits. The upper
+ * half lives in one 32-bit word together with the MSB of CYCCNT seen at the
+ * last refresh, so a reader needs two plain loads and no lock: when the MSB
+ * went from 1 to 0 since the last refresh the counter wrapped. This stays
+ * correct as long as the refresh runs at least once per half wrap (21 s at
+ * 100 MHz), TIM1 refreshes it every millisecond.
+ *
+ * Microseconds are derived from the cycles. time_set_core_clock must be
+ * called after every change of SystemCoreClock so the microsecond time keeps
+ * running without a jump.
+ *
+ * Built with BENCH_HOST_POSIX the counter is bench_time_cyccnt of the time
+ * suite, which drives its wraps and preempts its readers.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+#ifndef __BSP_TIME_H__
+#define __BSP_TIME_H__
+
+//******************************** Includes *********************************//
+
+#include <stdint.h>
+#include <stddef.h>
+
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+typedef enum
+{
+    TIME_OK              = 0,        /* TIME operate successfully            */
+    TIME_ERROR           = 1,        /* TIME error without case matched      */
+    TIME_ERRORTIMEOUT    = 2,        /* TIME operate failed with timeout     */
+    TIME_ERRORSOURCE     = 3,        /* TIME cycle counter not available     */
+    TIME_ERRORPARAMETER  = 4,        /* TIME parameter error                 */
+    TIME_ERRORNOMEMORY   = 5,        /* TIME out of memory                   */
+    TIME_ERRORISR        = 6,        /* TIME not allowed in ISR context      */
+    TIME_RESERVED        = 0xFF,     /* TIME reserved                        */
+} time_status_t;
+
+//******************************** Defines **********************************//
+
+//******************************* Declaring *********************************//
+
+/**
+ * @brief: Start the time service
+ * @steps:
+ *      1. Enable the DWT cycle counter if nobody did it yet
+ *      2. Take SystemCoreClock as the cycle to microsecond ratio
+ *
+ * @return time_status_t: execute result of this function
+ **/
+time_status_t time_init ( void );
+
+/**
+ * @brief: Refresh the upper half of the cycle count, call it from the 1 ms
+ *         timebase interrupt (or at least every few seconds)
+ **/
+void time_tick_isr ( void );
+
+/**
+ * @brief: Rebase the microsecond time after a core clock change, must be
+ *         called with the new frequency right after SystemCoreClock changed
+ *
+ * @param[in]  core_clock_hz: new core clock, multiple of 1 MHz
+ *
+ * @return time_status_t: execute result of this function
+ **/
+time_status_t time_set_core_clock ( uint32_t core_clock_hz );
+
+/**
+ * @brief: CPU cycles since the cycle counter started, any context
+ *
+ * @return uint64_t: monotonic cycle count
+ **/
+uint64_t time_get_cycles ( void );
+
+/**
+ * @brief: Microseconds since the cycle counter started, any context
+ *
+ * @return uint64_t: monotonic microseconds
+ **/
+uint64_t time_get_us ( void );
+
+/**
+ * @brief: Milliseconds since the cycle counter started, any context
+ *
+ * @return uint64_t: monotonic milliseconds
+ **/
+uint64_t time_get_ms ( void );
+
+//******************************* Declaring *********************************//
+#endif // __BSP_TIME_H__
@@ -0,0 +1,215 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_time.c
+ *
+ * @par dependencies
+ * - bsp_time.h
+ *
+ * @author Damian
+ *
+ * @brief Provide 64-bit monotonic timestamps in CPU cycles, microseconds and
+ *        milliseconds, lock-free and callable from tasks and ISRs.
+ *
+ * Processing flow:
+ *
+ * Call directly.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+//******************************** Includes *********************************//
+
+#include "bsp_time.h"
+#include "bsp_common.h"
+
+#ifndef BENCH_HOST_POSIX
+#include "main.h"
+#endif /* BENCH_HOST_POSIX */
+
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+BSP_STATUS_CHECK( TIME );
+
+#define TIME_MSB              0x80000000U     /* MSB of the 32-bit counter   */
+#define TIME_HZ_PER_MHZ       1000000U
+
+#ifdef BENCH_HOST_POSIX
+/* the bench plays the cycle counter and the core clock, see bench_time   */
+extern uint32_t SystemCoreClock;
+uint32_t bench_time_cyccnt ( void );
+#define TIME_CYCCNT()         bench_time_cyccnt()
+#else
+#define TIME_CYCCNT()         ( DWT->CYCCNT )
+#endif /* BENCH_HOST_POSIX */
+
+/* bits[31:1]: upper half of the cycle count, bit0: CYCCNT MSB at refresh    */
+static volatile uint32_t s_ext         = 0U;
+
+/* microsecond base, only written with interrupts disabled, guarded by gen;
+   volatile: the reads stay between the two reads of gen                   */
+static volatile uint32_t s_gen         = 0U;
+static volatile uint64_t s_cyc_base    = 0U;
+static volatile uint64_t s_us_base     = 0U;
+static volatile uint32_t s_cyc_per_us  = 1U;
+
+/**
+ * @brief: Extend a 32-bit counter value with the last refreshed upper half
+ *
+ * @param[in]  ext: snapshot of s_ext taken before reading lo
+ * @param[in]  lo:  current CYCCNT
+ *
+ * @return uint64_t: 64-bit cycle count
+ **/
+static uint64_t __extend ( uint32_t ext, uint32_t lo )
+{
+    uint32_t hi = ext >> 1;
+
+    // MSB went from 1 to 0 since the refresh: the counter wrapped once
+    if ( ( 0U != ( ext & 1U ) ) && ( 0U == ( lo & TIME_MSB ) ) )
+    {
+        hi++;
+    }
+    return ( (uint64_t)hi << 32 ) | lo;
+}
+
+/**
+ * @brief: Start the time service
+ * @steps:
+ *      1. Enable the DWT cycle counter if nobody did it yet
+ *      2. Take SystemCoreClock as the cycle to microsecond ratio
+ *
+ * @return time_status_t: execute result of this function
+ **/
+time_status_t time_init ( void )
+{
+    /*********** 1. Enable the cycle counter ***********/
+#ifndef BENCH_HOST_POSIX
+    if ( 0U == ( DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk ) )
+    {
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CYCCNT       = 0U;
+        DWT->CTRL        |= DWT_CTRL_CYCCNTENA_Msk;
+        if ( 0U == ( DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk ) )
+        {
+            LOG( LOG_LEVEL_ERR, "DWT cycle counter not available" );
+            return TIME_ERRORSOURCE;
+        }
+        s_ext = 0U;
+    }
+#endif /* BENCH_HOST_POSIX */
+    time_tick_isr();
+
+    /*********** 2. Set the microsecond ratio **********/
+    return time_set_core_clock( SystemCoreClock );
+}
+
+/**
+ * @brief: Refresh the upper half of the cycle count, call it from the 1 ms
+ *         timebase interrupt (or at least every few seconds)
+ **/
+BSP_RAMFUNC void time_tick_isr ( void )
+{
+    uint32_t lo  = TIME_CYCCNT();
+    uint64_t now = __extend( s_ext, lo );
+
+    // single writer, one aligned 32-bit store: readers see old or new
+    s_ext = ( (uint32_t)( now >> 32 ) << 1 ) | ( lo >> 31 );
+}
+
+/**
+ * @brief: Rebase the microsecond time after a core clock change, must be
+ *         called with the new frequency right after SystemCoreClock changed
+ *
+ * @param[in]  core_clock_hz: new core clock, multiple of 1 MHz
+ *
+ * @return time_status_t: execute result of this function
+ **/
+time_status_t time_set_core_clock ( uint32_t core_clock_hz )
+{
+#ifndef BENCH_HOST_POSIX
+    uint32_t primask;
+#endif /* BENCH_HOST_POSIX */
+    uint64_t cyc;
+
+    if ( core_clock_hz < TIME_HZ_PER_MHZ          ||
+         0U != ( core_clock_hz % TIME_HZ_PER_MHZ )
+                                                     )
+    {
+        LOG( LOG_LEVEL_ERR, "Core clock %u not a multiple of 1 MHz",
+                            (unsigned int)core_clock_hz );
+        return TIME_ERRORPARAMETER;
+    }
+
+    // readers can not run while the base is being rewritten, they only
+    // have to detect that it changed under them, see time_get_us
+#ifndef BENCH_HOST_POSIX
+    primask = __get_PRIMASK();
+    __disable_irq();
+#endif /* BENCH_HOST_POSIX */
+    cyc          = time_get_cycles();
+    s_us_base    = s_us_base + ( cyc - s_cyc_base ) / s_cyc_per_us;
+    s_cyc_base   = cyc;
+    s_cyc_per_us = core_clock_hz / TIME_HZ_PER_MHZ;
+    s_gen++;
+#ifndef BENCH_HOST_POSIX
+    __set_PRIMASK( primask );
+#endif /* BENCH_HOST_POSIX */
+    return TIME_OK;
+}
+
+/**
+ * @brief: CPU cycles since the cycle counter started, any context
+ *
+ * @return uint64_t: monotonic cycle count
+ **/
+uint64_t time_get_cycles ( void )
+{
+    uint32_t ext = s_ext;             // upper half first, then the counter
+
+    return __extend( ext, TIME_CYCCNT() );
+}
+
+/**
+ * @brief: Microseconds since the cycle counter started, any context
+ *
+ * @return uint64_t: monotonic microseconds
+ **/
+uint64_t time_get_us ( void )
+{
+    uint32_t gen;
+    uint64_t cyc_base;
+    uint64_t us_base;
+    uint32_t cyc_per_us;
+    uint64_t cyc;
+
+    do
+    {
+        gen        = s_gen;
+        cyc_base   = s_cyc_base;
+        us_base    = s_us_base;
+        cyc_per_us = s_cyc_per_us;
+        cyc        = time_get_cycles();
+    } while ( gen != s_gen );
+
+    return us_base + ( cyc - cyc_base ) / cyc_per_us;
+}
+
+/**
+ * @brief: Milliseconds since the cycle counter started, any context
+ *
+ * @return uint64_t: monotonic milliseconds
+ **/
+uint64_t time_get_ms ( void )
+{
+    return time_get_us() / 1000U;
+}
+
+//******************************** Defines **********************************//
@@ -0,0 +1,196 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_watchdog.h
+ *
+ * @par dependencies
+ * - bsp_osal.h
+ *
+ * @author Damian
+ *
+ * @brief Watchdog supervisor: the hardware watchdog is kicked only while
+ *        every registered task checks in within its deadline.
+ *
+ * Processing flow:
+ *
+ * wdg_supervisor_inst -> pf_client_register (every task)
+ *                     -> wdg_supervisor_start
+ * client task         -> wdg_checkin (lock free, one bit per client)
+ * supervisor task     -> every period: wdg_supervisor_poll
+ *                          -> take the check-in bitmap, stamp the live ones
+ *                          -> all within deadline: pf_wdg_kick
+ *                          -> one starved: log it, never kick again
+ *
+ * A check-in only sets the bit of the client with an atomic OR (LDREX /
+ * STREX), no lock, no time read, fine from a task or an ISR. The supervisor
+ * swaps the bitmap with 0 and stamps the clients it found with its own
+ * clock, so a deadline is checked with the resolution of the period.
+ *
+ * Once a client starved the supervisor latches: it logs the client name
+ * and the time since its last check-in and stops kicking, the hardware
+ * watchdog resets the MCU after its timeout. A check-in arriving late does
+ * not undo that. Pick the timeout above the longest deadline plus one
+ * period, else the hardware resets first and the log is lost.
+ *
+ * Only tasks which wake up on their own belong here: a task blocking
+ * forever on an event has no deadline to miss.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+#ifndef __BSP_WATCHDOG_H__
+#define __BSP_WATCHDOG_H__
+
+//******************************** Includes *********************************//
+
+#include "bsp_osal.h"
+#include <stdint.h>
+
+//******************************** Includes *********************************//
+
+typedef struct bsp_wdg_supervisor bsp_wdg_supervisor_t;
+
+//******************************** Defines **********************************//
+
+#define MAX_WDG_CLIENT_NUM        32U        /* one bit each in the bitmap  */
+#define WDG_PERIOD_MS             100U       /* default supervisor period   */
+#define WDG_TIMEOUT_MS            4000U      /* default hardware timeout    */
+#define WDG_SUPERVISOR_STACK_WORDS 192U      /* stack of the supervisor     */
+#define WDG_SUPERVISOR_PRIORITY   ( configMAX_PRIORITIES - 2 )
+
+typedef enum
+{
+    WDG_OK                       = 0,  /* WDG operate successfully           */
+    WDG_ERROR                    = 1,  /* WDG error without case matched     */
+    WDG_ERRORTIMEOUT             = 2,  /* WDG a client missed its deadline   */
+    WDG_ERRORSOURCE              = 3,  /* WDG resource not available         */
+    WDG_ERRORPARAMETER           = 4,  /* WDG parameter error                */
+    WDG_ERRORNOMEMORY            = 5,  /* WDG out of memory                  */
+    WDG_ERRORISR                 = 6,  /* WDG not allowed in ISR context     */
+    WDG_RESERVED                 = 0xFF,/* WDG reserved                      */
+} wdg_status_t;
+
+typedef enum
+{
+    WDG_SUPERVISOR_INITED     = 0,  /* watchdog supervisor initialized       */
+    WDG_SUPERVISOR_NOT_INITED = 1,  /* watchdog supervisor not initialized   */
+} wdg_supervisor_init_t;
+
+typedef struct
+{
+    /* start the hardware watchdog, it can not be stopped any more          */
+    wdg_status_t ( *pf_wdg_start ) ( uint32_t timeout_ms );
+    /* reload the hardware watchdog                                         */
+    wdg_status_t ( *pf_wdg_kick )  ( void );
+} wdg_operation_t;
+
+typedef struct
+{
+    const char            * name;                     /* for the log         */
+    uint32_t              deadline_ms;                /* max check-in gap    */
+    uint32_t              last_ms;                    /* last check-in seen  */
+    uint32_t              max_gap_ms;                 /* worst gap seen      */
+} wdg_client_t;
+
+typedef wdg_status_t ( *pf_wdg_client_register_t ) (
+                                    bsp_wdg_supervisor_t * const supervisor,
+                                    const char           * const name,
+                                    uint32_t                     deadline_ms,
+                                    uint32_t             * const client_id
+                                                                            );
+
+typedef struct bsp_wdg_supervisor
+{
+    //************************* Internal property ***************************//
+    wdg_supervisor_init_t is_initialized;             /* record init status  */
+    wdg_client_t          client[MAX_WDG_CLIENT_NUM]; /* registered clients  */
+    uint32_t              client_num;                 /* num of clients      */
+    volatile uint32_t     alive;                      /* check-in bitmap     */
+    uint32_t              starved;                    /* latched, no kicks   */
+    uint32_t              period_ms;                  /* supervisor period   */
+    uint32_t              timeout_ms;                 /* hardware timeout    */
+    uint32_t              rounds;                     /* polls so far        */
+    uint32_t              kicks;                      /* kicks so far        */
+
+    //************************ Interface from core **************************//
+    wdg_operation_t       * p_wdg_operation_inst;     /* watchdog interface  */
+    time_operation_t      * p_time_operation_inst;    /* time ops interface  */
+
+    //************************ Interface from RTOS **************************//
+    os_delay_t            * p_os_delay;               /* os delay interface  */
+    os_thread_t           * p_os_thread;              /* os thread interface */
+
+    //******************** Interface for iternal driver *********************//
+    pf_wdg_client_register_t pf_client_register;      /* register a client   */
+
+} bsp_wdg_supervisor_t;
+
+//******************************** Defines **********************************//
+
+//******************************* Declaring *********************************//
+
+/**
+ * @brief: Instantiate a bsp_wdg_supervisor_t
+ * @steps:
+ *      1. Adding the watchdog, time and OS interfaces into the instance
+ *      2. Clear the clients and the counters
+ *
+ * @param[in]  supervisor: Pointer to a instance of bsp_wdg_supervisor_t
+ * @param[in]  wdg_ops:    Pointer to a instance of wdg_operation_t
+ * @param[in]  time_ops:   Pointer to a instance of time_operation_t
+ * @param[in]  os_delay:   Pointer to a instance of os_delay_t
+ * @param[in]  os_thread:  Pointer to a instance of os_thread_t
+ * @param[in]  period_ms:  supervisor period, 0 means WDG_PERIOD_MS
+ * @param[in]  timeout_ms: hardware timeout, 0 means WDG_TIMEOUT_MS
+ *
+ * @return wdg_status_t: execute result of this function
+ **/
+wdg_status_t wdg_supervisor_inst (
+                                   bsp_wdg_supervisor_t * const supervisor,
+                                   wdg_operation_t      * const wdg_ops,
+                                   time_operation_t     * const time_ops,
+                                   os_delay_t           * const os_delay,
+                                   os_thread_t          * const os_thread,
+                                   uint32_t                     period_ms,
+                                   uint32_t                     timeout_ms
+                                                                          );
+
+/**
+ * @brief: Start the hardware watchdog and create the supervisor task
+ *
+ * @param[in]  supervisor: Pointer to a instance of bsp_wdg_supervisor_t
+ *
+ * @return wdg_status_t: execute result of this function
+ **/
+wdg_status_t wdg_supervisor_start ( bsp_wdg_supervisor_t * const supervisor );
+
+/**
+ * @brief: One supervisor round, the task calls it every period
+ * @steps:
+ *      1. Take the check-in bitmap, stamp the clients found in it
+ *      2. Check every deadline, log a client starving for the first time
+ *      3. Kick the hardware watchdog while nobody starved
+ *
+ * @param[in]  supervisor: Pointer to a instance of bsp_wdg_supervisor_t
+ *
+ * @return wdg_status_t: WDG_ERRORTIMEOUT once a client starved, the
+ *                       watchdog is not kicked any more
+ **/
+wdg_status_t wdg_supervisor_poll ( bsp_wdg_supervisor_t * const supervisor );
+
+/**
+ * @brief: Tell the supervisor the client is alive, lock free, task or ISR
+ *
+ * @param[in]  supervisor: Pointer to a instance of bsp_wdg_supervisor_t
+ * @param[in]  client_id:  id from pf_client_register
+ **/
+void wdg_checkin ( bsp_wdg_supervisor_t * const supervisor,
+                   uint32_t                     client_id  );
+
+//******************************* Declaring *********************************//
+#endif // __BSP_WATCHDOG_H__
@@ -0,0 +1,353 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file bsp_watchdog.c
+ *
+ * @par dependencies
+ * - bsp_watchdog.h
+ * - FreeRTOS.h
+ *
+ * @author Damian
+ *
+ * @brief Watchdog supervisor: the hardware watchdog is kicked only while
+ *        every registered task checks in within its deadline.
+ *
+ * Processing flow:
+ *
+ * Call directly.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+//******************************** Includes *********************************//
+
+#include "bsp_watchdog.h"
+#include "bsp_common.h"
+#include "FreeRTOS.h"
+
+#ifndef BENCH_HOST_POSIX
+#include "main.h"
+#endif /* BENCH_HOST_POSIX */
+
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+BSP_STATUS_CHECK( WDG );
+
+/**
+ * @brief: Set bits of the check-in bitmap, atomic against the other
+ *         clients and the supervisor
+ *
+ * @param[in]  alive: the bitmap
+ * @param[in]  bits:  bits to set
+ **/
+static void __alive_set ( volatile uint32_t * const alive, uint32_t bits )
+{
+#ifdef BENCH_HOST_POSIX
+    __atomic_fetch_or( alive, bits, __ATOMIC_RELAXED );
+#else
+    uint32_t value;
+
+    // retried when anything touched the bitmap between LDREX and STREX
+    do
+    {
+        value = __LDREXW( alive ) | bits;
+    } while ( 0U != __STREXW( value, alive ) );
+#endif /* BENCH_HOST_POSIX */
+}
+
+/**
+ * @brief: Take the check-in bitmap and leave 0 behind, atomic
+ *
+ * @param[in]  alive: the bitmap
+ *
+ * @return uint32_t: the bits set since the last take
+ **/
+static uint32_t __alive_take ( volatile uint32_t * const alive )
+{
+#ifdef BENCH_HOST_POSIX
+    return __atomic_exchange_n( alive, 0U, __ATOMIC_RELAXED );
+#else
+    uint32_t bits;
+
+    do
+    {
+        bits = __LDREXW( alive );
+    } while ( 0U != __STREXW( 0U, alive ) );
+    return bits;
+#endif /* BENCH_HOST_POSIX */
+}
+
+/**
+ * @brief: Register a task with its deadline, before wdg_supervisor_start
+ * @steps:
+ *      1. Check the deadline fits under the hardware timeout
+ *      2. Adding the client, the supervisor counts from its first round
+ *
+ * @param[in]  supervisor:  Pointer to a instance of bsp_wdg_supervisor_t
+ * @param[in]  name:        for the log, kept as pointer
+ * @param[in]  deadline_ms: max gap between two check-ins
+ * @param[out] client_id:   id for wdg_checkin
+ *
+ * @return wdg_status_t: execute result of this function
+ **/
+static wdg_status_t wdg_client_register (
+                                    bsp_wdg_supervisor_t * const supervisor,
+                                    const char           * const name,
+                                    uint32_t                     deadline_ms,
+                                    uint32_t             * const client_id
+                                                                            )
+{
+    wdg_client_t * client;
+
+    /************* 1. Checking the parameters *************/
+    if ( NULL == supervisor ||
+         NULL == name       ||
+         NULL == client_id
+                              )
+    {
+        LOG( LOG_LEVEL_ERR, "Input parameter is null" );
+        return WDG_ERRORPARAMETER;
+    }
+    else if ( WDG_SUPERVISOR_INITED != supervisor->is_initialized )
+    {
+        LOG( LOG_LEVEL_ERR, "Watchdog supervisor not initialized" );
+        return WDG_ERRORSOURCE;
+    }
+    else if ( MAX_WDG_CLIENT_NUM <= supervisor->client_num )
+    {
+        LOG( LOG_LEVEL_ERR, "Watchdog client array full" );
+        return WDG_ERRORNOMEMORY;
+    }
+    // the hardware has to wait for the log of a starved client
+    if ( deadline_ms < supervisor->period_ms ||
+         deadline_ms + supervisor->period_ms >= supervisor->timeout_ms )
+    {
+        LOG( LOG_LEVEL_ERR, "Watchdog deadline %u ms of %s out of range",
+                            (unsigned int)deadline_ms, name );
+        return WDG_ERRORPARAMETER;
+    }
+
+    /************* 2. Adding the client *******************/
+    client              = &supervisor->client[supervisor->client_num];
+    client->name        = name;
+    client->deadline_ms = deadline_ms;
+    client->last_ms     = 0U;
+    client->max_gap_ms  = 0U;
+    *client_id          = supervisor->client_num;
+    supervisor->client_num++;
+    return WDG_OK;
+}
+
+/**
+ * @brief: Supervisor task, one round every period
+ *
+ * @param[in]  argument: Pointer to a instance of bsp_wdg_supervisor_t
+ **/
+static void wdg_supervisor_task ( void * argument )
+{
+    bsp_wdg_supervisor_t * supervisor = (bsp_wdg_supervisor_t *)argument;
+
+    for ( ;; )
+    {
+        wdg_supervisor_poll( supervisor );
+        supervisor->p_os_delay->pf_os_delay_ms( supervisor->period_ms );
+    }
+}
+
+/**
+ * @brief: Instantiate a bsp_wdg_supervisor_t
+ * @steps:
+ *      1. Adding the watchdog, time and OS interfaces into the instance
+ *      2. Clear the clients and the counters
+ *
+ * @param[in]  supervisor: Pointer to a instance of bsp_wdg_supervisor_t
+ * @param[in]  wdg_ops:    Pointer to a instance of wdg_operation_t
+ * @param[in]  time_ops:   Pointer to a instance of time_operation_t
+ * @param[in]  os_delay:   Pointer to a instance of os_delay_t
+ * @param[in]  os_thread:  Pointer to a instance of os_thread_t
+ * @param[in]  period_ms:  supervisor period, 0 means WDG_PERIOD_MS
+ * @param[in]  timeout_ms: hardware timeout, 0 means WDG_TIMEOUT_MS
+ *
+ * @return wdg_status_t: execute result of this function
+ **/
+wdg_status_t wdg_supervisor_inst (
+                                   bsp_wdg_supervisor_t * const supervisor,
+                                   wdg_operation_t      * const wdg_ops,
+                                   time_operation_t     * const time_ops,
+                                   os_delay_t           * const os_delay,
+                                   os_thread_t          * const os_thread,
+                                   uint32_t                     period_ms,
+                                   uint32_t                     timeout_ms
+                                                                          )
+{
+    /********** 1. Checking the input parameters **********/
+    if ( NULL == supervisor               ||
+         NULL == wdg_ops                  ||
+         NULL == wdg_ops->pf_wdg_start    ||
+         NULL == wdg_ops->pf_wdg_kick     ||
+         NULL == time_ops                 ||
+         NULL == time_ops->pf_get_time_ms ||
+         NULL == os_delay                 ||
+         NULL == os_delay->pf_os_delay_ms ||
+         NULL == os_thread                ||
+         NULL == os_thread->pf_os_thread_create
+                                            )
+    {
+        LOG( LOG_LEVEL_ERR, "Input parameter is null" );
+        return WDG_ERRORPARAMETER;
+    }
+
+    /************** 2. Checking the resource **************/
+    if ( WDG_SUPERVISOR_INITED == supervisor->is_initialized )
+    {
+        LOG( LOG_LEVEL_WARN, "Watchdog supervisor already initialized" );
+        return WDG_ERRORSOURCE;
+    }
+
+    /************** 3. Adding the interfaces **************/
+    // 3.1 mount external interfaces
+    supervisor->p_wdg_operation_inst  = wdg_ops;
+    supervisor->p_time_operation_inst = time_ops;
+    supervisor->p_os_delay            = os_delay;
+    supervisor->p_os_thread           = os_thread;
+    // 3.2 mount internal interfaces
+    supervisor->pf_client_register    = wdg_client_register;
+
+    /************* 4. Initialize the instance *************/
+    supervisor->client_num = 0U;
+    supervisor->alive      = 0U;
+    supervisor->starved    = 0U;
+    supervisor->rounds     = 0U;
+    supervisor->kicks      = 0U;
+    supervisor->period_ms  = ( 0U == period_ms )  ? WDG_PERIOD_MS  :
+                                                    period_ms;
+    supervisor->timeout_ms = ( 0U == timeout_ms ) ? WDG_TIMEOUT_MS :
+                                                    timeout_ms;
+
+    supervisor->is_initialized = WDG_SUPERVISOR_INITED;
+    return WDG_OK;
+}
+
+/**
+ * @brief: Start the hardware watchdog and create the supervisor task
+ *
+ * @param[in]  supervisor: Pointer to a instance of bsp_wdg_supervisor_t
+ *
+ * @return wdg_status_t: execute result of this function
+ **/
+wdg_status_t wdg_supervisor_start ( bsp_wdg_supervisor_t * const supervisor )
+{
+    if ( NULL == supervisor )
+    {
+        LOG( LOG_LEVEL_ERR, "Input parameter is null" );
+        return WDG_ERRORPARAMETER;
+    }
+    else if ( WDG_SUPERVISOR_INITED != supervisor->is_initialized )
+    {
+        LOG( LOG_LEVEL_ERR, "Watchdog supervisor not initialized" );
+        return WDG_ERRORSOURCE;
+    }
+
+    if ( WDG_OK != supervisor->p_wdg_operation_inst->pf_wdg_start(
+                                                supervisor->timeout_ms ) )
+    {
+        LOG( LOG_LEVEL_ERR, "Watchdog start failed" );
+        return WDG_ERRORSOURCE;
+    }
+    if ( BSP_OK != supervisor->p_os_thread->pf_os_thread_create(
+                                            wdg_supervisor_task,
+                                            "wdg_supervisor",
+                                            WDG_SUPERVISOR_STACK_WORDS,
+                                            supervisor,
+                                            WDG_SUPERVISOR_PRIORITY ) )
+    {
+        LOG( LOG_LEVEL_ERR, "Watchdog supervisor task create failed" );
+        return WDG_ERRORNOMEMORY;
+    }
+    return WDG_OK;
+}
+
+/**
+ * @brief: One supervisor round, the task calls it every period
+ * @steps:
+ *      1. Take the check-in bitmap, stamp the clients found in it
+ *      2. Check every deadline, log a client starving for the first time
+ *      3. Kick the hardware watchdog while nobody starved
+ *
+ * @param[in]  supervisor: Pointer to a instance of bsp_wdg_supervisor_t
+ *
+ * @return wdg_status_t: WDG_ERRORTIMEOUT once a client starved, the
+ *                       watchdog is not kicked any more
+ **/
+wdg_status_t wdg_supervisor_poll ( bsp_wdg_supervisor_t * const supervisor )
+{
+    wdg_client_t * client;
+    uint32_t       now_ms = 0U;
+    uint32_t       alive;
+    uint32_t       gap_ms;
+
+    /************* 1. Take the check-ins ******************/
+    supervisor->p_time_operation_inst->pf_get_time_ms( &now_ms );
+    alive = __alive_take( &supervisor->alive );
+    for ( uint32_t i = 0; i < supervisor->client_num; ++i )
+    {
+        client = &supervisor->client[i];
+        // the first round starts every deadline
+        if ( 0U == supervisor->rounds || 0U != ( alive & ( 1UL << i ) ) )
+        {
+            client->last_ms = now_ms;
+            continue;
+        }
+
+        /********* 2. Check the deadline **************/
+        gap_ms = now_ms - client->last_ms;
+        if ( gap_ms > client->max_gap_ms )
+        {
+            client->max_gap_ms = gap_ms;
+        }
+        if ( gap_ms > client->deadline_ms                 &&
+             0U == ( supervisor->starved & ( 1UL << i ) ) )
+        {
+            supervisor->starved |= 1UL << i;
+            LOG( LOG_LEVEL_ERR, "Watchdog: %s starved, %u ms since check-in, "
+                                "reset in %u ms",
+                                client->name, (unsigned int)gap_ms,
+                                (unsigned int)supervisor->timeout_ms );
+        }
+    }
+    supervisor->rounds++;
+
+    /************* 3. Kick while all live *****************/
+    if ( 0U != supervisor->starved )
+    {
+        return WDG_ERRORTIMEOUT;
+    }
+    supervisor->p_wdg_operation_inst->pf_wdg_kick();
+    supervisor->kicks++;
+    return WDG_OK;
+}
+
+/**
+ * @brief: Tell the supervisor the client is alive, lock free, task or ISR
+ *
+ * @param[in]  supervisor: Pointer to a instance of bsp_wdg_supervisor_t
+ * @param[in]  client_id:  id from pf_client_register
+ **/
+void wdg_checkin ( bsp_wdg_supervisor_t * const supervisor,
+                   uint32_t                     client_id  )
+{
+    if ( MAX_WDG_CLIENT_NUM <= client_id )
+    {
+        return;
+    }
+    __alive_set( &supervisor->alive, 1UL << client_id );
+}
+
+//******************************** Defines **********************************//
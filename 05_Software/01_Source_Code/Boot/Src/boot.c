@@ -0,0 +1,233 @@
+/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file boot.c
+ *
+ * @par dependencies
+ * - stm32f4xx.h
+ * - bsp_fw_image.h
+ *
+ * @author Damian
+ *
+ * @brief Boot loader in sector 0: starts the image of slot A or B.
+ *
+ * Processing flow:
+ *
+ * Reset_Handler -> SystemInit -> __main -> main -> fw_select
+ *               -> vectors of the slot checked -> VTOR, MSP -> its reset
+ *
+ * Built by MDK-ARM/boot.uvprojx into 0x08000000 - 0x08003FFF, registers
+ * only: no HAL, no RTOS. It runs on the HSI, the image sets its own clock.
+ * fw_select spends a trial of an image not confirmed, so the boot loader
+ * programs the flash, one word at a time; it never erases.
+ *
+ * Without an image to start the LED (PC13) blinks fast: download one with
+ * the probe (08_Tools/fwupdate/fw_send.py --pack) and reset.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+
+//******************************** Includes *********************************//
+
+#include "stm32f4xx.h"
+#include "bsp_fw_image.h"
+#include <stddef.h>
+
+//******************************** Includes *********************************//
+
+//******************************** Defines **********************************//
+
+#define BOOT_FLASH_KEY1           0x45670123U
+#define BOOT_FLASH_KEY2           0xCDEF89ABU
+#define BOOT_FLASH_ERRORS         ( FLASH_SR_WRPERR | FLASH_SR_PGAERR |    \
+                                    FLASH_SR_PGPERR | FLASH_SR_PGSERR )
+#define BOOT_SRAM_END             ( SRAM1_BASE + 0x00020000U )
+#define BOOT_BLINK_LOOPS          400000U /* about 50 ms on the HSI          */
+
+static fw_status_t __flash_program ( uint32_t       * const dst,
+                                     const uint32_t * const src,
+                                     uint32_t               words );
+static uint32_t    __crc_words     ( const uint32_t * const words,
+                                     uint32_t               num   );
+
+static const fw_slot_t      s_slots[FW_SLOT_NUM] =
+{
+    { (uint32_t *)FW_SLOT_A_ADDR, FW_SLOT_BYTES },
+    { (uint32_t *)FW_SLOT_B_ADDR, FW_SLOT_BYTES },
+};
+static const fw_operation_t s_ops =
+{
+    .pf_flash_erase   = NULL,             /* the boot loader never erases    */
+    .pf_flash_program = __flash_program,
+    .pf_crc_words     = __crc_words,
+};
+
+/**
+ * @brief: Program words, 32 bits at a time (2.7 V - 3.6 V)
+ * @steps:
+ *      1. Unlock, clear the errors of before
+ *      2. Per word: PG, the word, wait while busy, check the errors
+ *      3. Lock
+ *
+ * @param[in]  dst:   in a slot
+ * @param[in]  src:   the words
+ * @param[in]  words: number of words
+ *
+ * @return fw_status_t: execute result of this function
+ **/
+static fw_status_t __flash_program ( uint32_t       * const dst,
+                                     const uint32_t * const src,
+                                     uint32_t               words )
+{
+    fw_status_t ret = FW_OK;
+
+    /********************** 1. Unlock *************************/
+    if ( 0U != ( FLASH->CR & FLASH_CR_LOCK ) )
+    {
+        FLASH->KEYR = BOOT_FLASH_KEY1;
+        FLASH->KEYR = BOOT_FLASH_KEY2;
+    }
+    FLASH->SR = BOOT_FLASH_ERRORS | FLASH_SR_EOP;
+
+    /********************** 2. Program ************************/
+    for ( uint32_t i = 0; i < words && FW_OK == ret; ++i )
+    {
+        FLASH->CR = FLASH_CR_PSIZE_1 | FLASH_CR_PG;
+        dst[i]    = src[i];
+        __DSB();
+        while ( 0U != ( FLASH->SR & FLASH_SR_BSY ) )
+        {
+        }
+        if ( 0U != ( FLASH->SR & BOOT_FLASH_ERRORS ) )
+        {
+            FLASH->SR = BOOT_FLASH_ERRORS;
+            ret       = FW_ERROR;
+        }
+    }
+
+    /*********************** 3. Lock **************************/
+    FLASH->CR = FLASH_CR_LOCK;
+    return ret;
+}
+
+/**
+ * @brief: CRC-32/MPEG-2 of words on the CRC unit
+ *
+ * @param[in]  words: the words
+ * @param[in]  num:   number of words
+ *
+ * @return uint32_t: the CRC
+ **/
+static uint32_t __crc_words ( const uint32_t * const words, uint32_t num )
+{
+    RCC->AHB1ENR |= RCC_AHB1ENR_CRCEN;
+    __DSB();
+    CRC->CR = CRC_CR_RESET;
+    for ( uint32_t i = 0; i < num; ++i )
+    {
+        CRC->DR = words[i];
+    }
+    return CRC->DR;
+}
+
+/**
+ * @brief: Vectors of a slot fit to start: stack in the SRAM, reset handler
+ *         a Thumb address in the slot
+ *
+ * @param[in]  slot: the slot
+ *
+ * @return uint32_t: 1 when fit
+ **/
+static uint32_t __vectors_ok ( const fw_slot_t * const slot )
+{
+    const uint32_t * vec   = &slot->base[FW_HEADER_BYTES / 4U];
+    uint32_t         start = (uint32_t)vec;
+
+    return ( vec[0] > SRAM1_BASE && vec[0] <= BOOT_SRAM_END &&
+             0U == ( vec[0] & 3U ) &&
+             0U != ( vec[1] & 1U ) &&
+             vec[1] > start && vec[1] < (uint32_t)slot->base + slot->bytes ) ?
+           1U : 0U;
+}
+
+/**
+ * @brief: Start the image of a slot, does not return
+ *
+ * @param[in]  slot: the slot
+ **/
+static void __jump ( const fw_slot_t * const slot )
+{
+    const uint32_t * vec   = &slot->base[FW_HEADER_BYTES / 4U];
+    uint32_t         entry = vec[1];
+
+    __disable_irq();
+    SysTick->CTRL = 0U;
+    RCC->AHB1ENR &= ~RCC_AHB1ENR_CRCEN;
+    SCB->VTOR     = (uint32_t)vec;
+    __set_MSP( vec[0] );
+    __DSB();
+    __ISB();
+    // the image enables the interrupts it needs, PRIMASK is cleared first
+    __enable_irq();
+    ( (void ( * )( void ))entry )();
+}
+
+/**
+ * @brief: Nothing to start, blink the LED until the next reset
+ **/
+static void __no_image ( void )
+{
+    RCC->AHB1ENR |= RCC_AHB1ENR_GPIOCEN;
+    __DSB();
+    GPIOC->MODER = ( GPIOC->MODER & ~GPIO_MODER_MODER13 ) |
+                   GPIO_MODER_MODER13_0;
+    for ( ;; )
+    {
+        GPIOC->ODR ^= GPIO_ODR_OD13;
+        for ( volatile uint32_t i = 0; i < BOOT_BLINK_LOOPS; ++i )
+        {
+        }
+    }
+}
+
+/**
+ * @brief: Boot loader
+ * @steps:
+ *      1. Choose the slot, a trial spent on an image not confirmed
+ *      2. Its vectors not fit: reject it, choose again
+ *      3. Start it, or blink without an image
+ *
+ * @return int: does not return
+ **/
+int main ( void )
+{
+    uint32_t slot = FW_SLOT_NONE;
+
+    /******************* 1. Choose the slot *******************/
+    while ( FW_OK == fw_select( s_slots, &s_ops, &slot ) )
+    {
+        /************** 2. Check its vectors ******************/
+        if ( 0U == __vectors_ok( &s_slots[slot] ) )
+        {
+            // linked for the other slot, or not an image of this board
+            if ( FW_OK != fw_mark( &( (fw_header_t *)s_slots[slot].base )->
+                                   rejected, FW_MARK, &s_ops ) )
+            {
+                break;
+            }
+            continue;
+        }
+
+        /********************* 3. Start it ********************/
+        __jump( &s_slots[slot] );
+    }
+    __no_image();
+    return 0;
+}
+
+//******************************** Defines **********************************//
@@ -56,7 +56,7 @@
 #define CMSIS_device_header "stm32f4xx.h"
 #endif /* CMSIS_device_header */
 
-#define configENABLE_FPU                         0
+#define configENABLE_FPU                         1
 #define configENABLE_MPU                         0
 
 #define configUSE_PREEMPTION                     1
@@ -165,6 +165,15 @@ standard names. */
 
 /* USER CODE BEGIN Defines */
 /* Section where parameter definitions can be added (for instance, to override default ones in FreeRTOS.h) */
+/* Check the stack pointer and the stack tail pattern on every switch out */
+#define configCHECK_FOR_STACK_OVERFLOW           2
+/* Slot 0: the bsp_signal_t a task owns (SIGNAL_TLS_INDEX, bsp_signal.h) */
+#define configNUM_THREAD_LOCAL_STORAGE_POINTERS  1
+/* The ARM_CM4F port always saves the FPU context of the tasks which used it,
+   lazily (FPCCR.ASPEN/LSPEN). It needs the compiler to target the FPU. */
+#if (configENABLE_FPU == 1) && defined(__CC_ARM) && !defined(__TARGET_FPU_VFP)
+#error "configENABLE_FPU needs Floating Point Hardware: Single Precision"
+#endif
 /* USER CODE END Defines */
 
 #endif /* FREERTOS_CONFIG_H */
@@ -41,6 +41,7 @@ extern UART_HandleTypeDef huart1;
 void MX_USART1_UART_Init(void);
 
 /* USER CODE BEGIN Prototypes */
+void MX_USART1_ClockChanged(uint32_t core_clock_hz);
 
 /* USER CODE END Prototypes */
 
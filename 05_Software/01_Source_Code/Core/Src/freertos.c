@@ -26,6 +26,48 @@
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
 #include "bsp_led_driver.h"
+#include "bsp_bench_latency.h"
+#include "bsp_bench_zerocopy.h"
+#include "bsp_bench_fpu.h"
+#include "bsp_bench_build.h"
+#include "bsp_bench_clock.h"
+#include "bsp_bench_dsp.h"
+#include "bsp_bench_dsp_kernel.h"
+#include "bsp_bench_dsp_feature.h"
+#include "bsp_bench_nn.h"
+#include "bsp_bench_watchdog.h"
+#include "bsp_bench_kv.h"
+#include "bsp_bench_evlog.h"
+#include "bsp_bench_crc.h"
+#include "bsp_bench_fwupdate.h"
+#include "bsp_bench_spi.h"
+#include "bsp_bench_ws2812.h"
+#include "bsp_bench_matrix.h"
+#include "bsp_bench_i2c.h"
+#include "bsp_bench_time.h"
+#include "bsp_bench_key.h"
+#include "bsp_bench_pll.h"
+#include "bsp_bench_device.h"
+#include "bsp_stack_report.h"
+#include "bsp_crash.h"
+#include "bsp_led_handler.h"
+#include "bsp_time.h"
+#include "bsp_key_handler.h"
+#include "bsp_device.h"
+#include "bsp_dsp_pipeline.h"
+#include "bsp_watchdog.h"
+#include "bsp_kv.h"
+#include "bsp_evlog.h"
+#include "bsp_crc.h"
+#include "bsp_fw_update.h"
+#include "bsp_spi.h"
+#include "bsp_ws2812.h"
+#include "bsp_matrix.h"
+#include "bsp_i2c.h"
+#include "bsp_signal.h"
+#include "adc.h"
+#include "tim.h"
+#include "usart.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -35,6 +77,72 @@
 
 /* Private define ------------------------------------------------------------*/
 /* USER CODE BEGIN PD */
+#if defined(KV_STORE_ENABLE) || defined(EVLOG_ENABLE) || \
+    defined(FW_UPDATE_ENABLE)
+/* the KV store, the journal and the update write the flash through one
+   backend, core_flash_erase / core_flash_program */
+#define CORE_FLASH_ENABLE
+#endif /* KV_STORE_ENABLE || EVLOG_ENABLE || FW_UPDATE_ENABLE */
+#ifdef KV_STORE_ENABLE
+/* sectors 1 and 2, left out of the image by the scatter files */
+#define KV_SECTOR_0_ADDR    0x08004000U
+#define KV_SECTOR_1_ADDR    0x08008000U
+#define KV_SECTOR_BYTES     0x4000U
+
+/* keys of the settings kept in the store */
+#define CORE_KV_LED_PERIOD  0U    /* uint32_t, blink period in ms */
+#define CORE_KV_LED_DUTY    1U    /* uint32_t, led_duty_t */
+#define CORE_KV_LOG_LEVEL   2U    /* uint32_t, log_level_t */
+#endif /* KV_STORE_ENABLE */
+#ifdef EVLOG_ENABLE
+/* sectors 3 and 4, left out of the image by the scatter files */
+#define EVLOG_SECTOR_0_ADDR  0x0800C000U
+#define EVLOG_SECTOR_0_BYTES 0x4000U
+#define EVLOG_SECTOR_1_ADDR  0x08010000U
+#define EVLOG_SECTOR_1_BYTES 0x10000U
+
+/* event ids of the journal, named by 08_Tools/evlog/evlog_decode.py */
+#define CORE_EVLOG_BOOT      1U   /* uint32_t, RCC->CSR reset flags */
+#endif /* EVLOG_ENABLE */
+#ifdef FW_UPDATE_ENABLE
+/* USART1 receive ring: two DATA frames in flight while a block is written */
+#define FW_LINK_RING_BYTES   2048U
+#define FW_LINK_EVENT        (1UL << 0)
+#define FW_LINK_TX_RETRIES   10U  /* console busy: 1 ms each */
+#endif /* FW_UPDATE_ENABLE */
+#ifdef SPI_ENABLE
+/* chip-select lines of SPI2, spi_device_t.cs indexes core_spi_cs_pins */
+#define CORE_SPI_CS_FLASH    0U   /* PB12, SPI flash */
+#define CORE_SPI_CS_SHIFT    1U   /* PB1, latch of the shift-register chain */
+#define CORE_SPI_CS_NUM      2U
+#endif /* SPI_ENABLE */
+#ifdef WS2812_ENABLE
+/* strip of WS2812B on PA6, its first pixel a status LED */
+#define CORE_WS2812_LEDS     60U
+#define CORE_WS2812_STATUS   0U   /* pixel of core_ws2812_led */
+#define CORE_WS2812_COLOR    WS2812_RGB(0U, 32U, 0U)
+/* the twinkles of the LED handler run in a worker, not in the caller */
+#define CORE_LED_WORKER_DEPTH        4U
+#define CORE_LED_WORKER_STACK_WORDS  256U
+#define CORE_LED_WORKER_PRIORITY     (tskIDLE_PRIORITY + 2)
+#endif /* WS2812_ENABLE */
+#ifdef MATRIX_ENABLE
+/* 16x16 LED matrix behind a chain of four 74HC595 on SPI1 */
+#define CORE_MATRIX_ROWS     16U
+#define CORE_MATRIX_COLS     16U
+#define CORE_MATRIX_BITS     5U          /* 32 levels */
+#define CORE_MATRIX_HZ       100U
+#define CORE_MATRIX_TICK_HZ  10000000U   /* TIM4 after its prescaler */
+#define CORE_MATRIX_CHAIN    4U          /* bytes: 2 rows, 2 columns */
+#endif /* MATRIX_ENABLE */
+#ifdef I2C_ENABLE
+/* I2C1 at 400 kHz; one task serves the bus: watch, recovery, samplers */
+#define CORE_I2C_HZ          400000U
+#define CORE_I2C_EVENT       (1UL << 0)  /* sig_bits of core_i2c */
+#define CORE_I2C_STACK_WORDS 384U
+#define CORE_I2C_PRIORITY    (configMAX_PRIORITIES - 3)
+#define CORE_I2C_RECOVER_US  5U          /* half a clock at 100 kHz */
+#endif /* I2C_ENABLE */
 
 /* USER CODE END PD */
 
@@ -45,18 +153,401 @@
 
 /* Private variables ---------------------------------------------------------*/
 /* USER CODE BEGIN Variables */
+static bsp_status_t core_get_time_ms(uint32_t * const time_ms);
+static bsp_status_t core_get_time_us(uint64_t * const time_us);
+static bsp_status_t core_os_delay_ms(const uint32_t delay_ms);
+static bsp_status_t core_os_thread_create(void (*entry)(void *),
+                                          const char * const name,
+                                          uint32_t const stack_words,
+                                          void * const argument,
+                                          uint32_t const priority);
+static bsp_status_t core_os_critical_enter(void);
+static bsp_status_t core_os_critical_exit(void);
+static bsp_status_t core_os_mutex_create(void ** const mutex_handler);
+static bsp_status_t core_os_mutex_lock(void * const mutex_handler,
+                                      uint32_t timeout);
+static bsp_status_t core_os_mutex_unlock(void * const mutex_handler);
+static bsp_status_t core_os_queue_create(uint32_t const num,
+                                         uint32_t const size,
+                                         void ** const queue_handler);
+static bsp_status_t core_os_queue_put(void * const queue_handler,
+                                      void * const item,
+                                      uint32_t timeout);
+static bsp_status_t core_os_queue_get(void * const queue_handler,
+                                      void * const msg,
+                                      uint32_t timeout);
+static bsp_status_t core_os_queue_delete(void * const queue_handler);
+static key_inst_status_t core_key_read(uint8_t * const pressed);
+static key_inst_status_t core_key_irq_enable(void);
+static key_inst_status_t core_key_irq_disable(void);
+#ifdef DSP_PIPELINE_ENABLE
+static dsp_status_t core_adc_start(uint16_t * const buf, uint32_t len);
+static dsp_status_t core_adc_stop(void);
+static void core_dsp_spectrum_done(dsp_chain_t * const chain,
+                                   const float32_t * const out,
+                                   uint32_t len,
+                                   void * const context);
+#endif /* DSP_PIPELINE_ENABLE */
+#ifdef WDG_SUPERVISOR_ENABLE
+static wdg_status_t core_wdg_start(uint32_t timeout_ms);
+static wdg_status_t core_wdg_kick(void);
+#endif /* WDG_SUPERVISOR_ENABLE */
+#ifdef CORE_FLASH_ENABLE
+static bsp_status_t core_flash_erase(uint32_t sector);
+static bsp_status_t core_flash_program(uint32_t * const dst,
+                                       const uint32_t * const src,
+                                       uint32_t words);
+#endif /* CORE_FLASH_ENABLE */
+#ifdef KV_STORE_ENABLE
+static kv_status_t core_kv_erase(uint32_t sector);
+static kv_status_t core_kv_program(uint32_t * const dst,
+                                   const uint32_t * const src,
+                                   uint32_t words);
+#endif /* KV_STORE_ENABLE */
+#ifdef EVLOG_ENABLE
+static evlog_status_t core_evlog_erase(uint32_t sector);
+static evlog_status_t core_evlog_program(uint32_t * const dst,
+                                         const uint32_t * const src,
+                                         uint32_t words);
+#endif /* EVLOG_ENABLE */
+#ifdef CRC_ENABLE
+static void core_crc_hw_init(void);
+static crc_status_t core_crc_reset(void);
+static crc_status_t core_crc_feed(const void * const data, uint32_t words,
+                                  uint32_t reverse);
+static crc_status_t core_crc_dma_start(const uint32_t * const words,
+                                       uint32_t num);
+static crc_status_t core_crc_dma_stop(void);
+static uint32_t core_crc_read(void);
+static void core_crc_dma_cplt(DMA_HandleTypeDef *hdma);
+static void core_crc_dma_error(DMA_HandleTypeDef *hdma);
+#endif /* CRC_ENABLE */
+#ifdef FW_UPDATE_ENABLE
+static void core_fw_link_init(void);
+static void core_fw_link_restart(void);
+static fw_status_t core_fw_erase(uint32_t slot);
+static fw_status_t core_fw_program(uint32_t * const dst,
+                                   const uint32_t * const src,
+                                   uint32_t words);
+static uint32_t core_fw_crc_words(const uint32_t * const words, uint32_t num);
+static fw_status_t core_fw_link_read(uint8_t * const buf, uint32_t max,
+                                     uint32_t timeout_ms,
+                                     uint32_t * const got);
+static fw_status_t core_fw_link_send(const uint8_t * const data,
+                                     uint32_t len);
+static void core_fw_reboot(void);
+#endif /* FW_UPDATE_ENABLE */
+#ifdef SPI_ENABLE
+static void core_spi_hw_init(void);
+static spi_status_t core_spi_configure(spi_mode_t mode, uint32_t max_hz);
+static spi_status_t core_spi_cs(uint32_t cs, uint32_t active);
+static spi_status_t core_spi_dma_start(const uint8_t * const tx,
+                                       uint8_t * const rx, uint32_t len);
+static spi_status_t core_spi_dma_stop(void);
+static spi_status_t core_spi_dma_reset(void);
+#endif /* SPI_ENABLE */
+#ifdef WS2812_ENABLE
+static void core_ws2812_hw_init(void);
+static uint32_t core_ws2812_clock_hz(void);
+static ws2812_status_t core_ws2812_dma_start(const uint16_t * const ring,
+                                             uint32_t slots,
+                                             uint32_t period);
+static ws2812_status_t core_ws2812_dma_stop(void);
+static void core_ws2812_dma_half(DMA_HandleTypeDef *hdma);
+static void core_ws2812_dma_full(DMA_HandleTypeDef *hdma);
+static void core_ws2812_dma_error(DMA_HandleTypeDef *hdma);
+static led_inst_status_t core_ws2812_led_on(void);
+static led_inst_status_t core_ws2812_led_off(void);
+#endif /* WS2812_ENABLE */
+#ifdef MATRIX_ENABLE
+static void core_matrix_hw_init(void);
+static uint32_t core_matrix_tim_clock(void);
+static uint32_t core_matrix_clock_hz(void);
+static void core_matrix_shift(const uint8_t * const bytes);
+static void core_matrix_latch(void);
+static void core_matrix_next(uint32_t row, const uint8_t * const cols,
+                             uint32_t ticks);
+static matrix_status_t core_matrix_start(void);
+static matrix_status_t core_matrix_stop(void);
+#endif /* MATRIX_ENABLE */
+#ifdef I2C_ENABLE
+static void core_i2c_hw_init(void);
+static void core_i2c_task(void *argument);
+static void core_i2c_half_bit(void);
+static i2c_status_t core_i2c_start(uint8_t addr, uint16_t reg,
+                                   uint32_t reg_len, i2c_dir_t dir,
+                                   uint8_t * const data, uint32_t len);
+static i2c_status_t core_i2c_abort(void);
+static i2c_status_t core_i2c_recover(void);
+#endif /* I2C_ENABLE */
+/* Time interface handed to the BSP handlers, backed by bsp_time */
+time_operation_t core_time_operation = {
+  .pf_get_time_ms = core_get_time_ms,
+  .pf_get_time_us = core_get_time_us,
+};
+
+/* OS interfaces handed to the BSP handlers */
+os_delay_t core_os_delay = {
+  .pf_os_delay_ms = core_os_delay_ms,
+};
+
+os_thread_t core_os_thread = {
+  .pf_os_thread_create = core_os_thread_create,
+};
+
+os_critical_t core_os_critical = {
+  .pf_os_critical_enter = core_os_critical_enter,
+  .pf_os_critical_exit  = core_os_critical_exit,
+};
+
+os_mutex_t core_os_mutex = {
+  .pf_os_mutex_create = core_os_mutex_create,
+  .pf_os_mutex_lock   = core_os_mutex_lock,
+  .pf_os_mutex_unlock = core_os_mutex_unlock,
+};
+
+os_queue_t core_os_queue = {
+  .pf_os_queue_create = core_os_queue_create,
+  .pf_os_queue_put    = core_os_queue_put,
+  .pf_os_queue_get    = core_os_queue_get,
+  .pf_os_queue_delete = core_os_queue_delete,
+};
+
+bsp_osal_t core_osal = {
+  .p_os_delay            = &core_os_delay,
+  .p_os_queue            = &core_os_queue,
+  .p_os_critical         = &core_os_critical,
+  .p_os_mutex            = &core_os_mutex,
+  .p_os_thread           = &core_os_thread,
+  .p_time_operation_inst = &core_time_operation,
+};
+
+/* KEY on PA0, active low, EXTI0 on both edges */
+key_operation_t core_key_operation = {
+  .pf_key_read        = core_key_read,
+  .pf_key_irq_enable  = core_key_irq_enable,
+  .pf_key_irq_disable = core_key_irq_disable,
+};
+
+bsp_key_driver_t  core_key         = { .is_initialized = KEY_INST_NOT_INITED };
+bsp_key_handler_t core_key_handler = { .is_initialized = KEY_HANDLER_NOT_INITED };
+
+#ifdef DSP_PIPELINE_ENABLE
+/* ADC1 on PA1, TIM2_TRGO paced, DMA2 stream 0 circular */
+dsp_adc_operation_t core_adc_operation = {
+  .pf_adc_start = core_adc_start,
+  .pf_adc_stop  = core_adc_stop,
+};
+
+bsp_dsp_pipeline_t core_dsp_pipeline = { .is_initialized = DSP_PIPELINE_NOT_INITED };
+
+/* level: statistics of the raw block */
+static dsp_chain_t    core_dsp_level;
+static dsp_stats_t    core_dsp_level_stats;
+
+/* spectrum: low pass, decimate by 2, 128 point RFFT, magnitude, peak bin */
+static dsp_chain_t    core_dsp_spectrum;
+static dsp_fir_t      core_dsp_fir;
+static dsp_decimate_t core_dsp_dec;
+static dsp_rfft_t     core_dsp_rfft;
+static dsp_stats_t    core_dsp_spectrum_stats;
+static float32_t      core_dsp_lowpass[31];
+#endif /* DSP_PIPELINE_ENABLE */
+
+#ifdef WDG_SUPERVISOR_ENABLE
+/* IWDG on the LSI, kicked by the supervisor only */
+wdg_operation_t core_wdg_operation = {
+  .pf_wdg_start = core_wdg_start,
+  .pf_wdg_kick  = core_wdg_kick,
+};
+
+bsp_wdg_supervisor_t core_wdg = { .is_initialized = WDG_SUPERVISOR_NOT_INITED };
+
+static IWDG_HandleTypeDef core_hiwdg;
+static uint32_t           core_wdg_default_id;
+#endif /* WDG_SUPERVISOR_ENABLE */
+
+#ifdef CORE_FLASH_ENABLE
+/* held from HAL_FLASH_Unlock to HAL_FLASH_Lock: the erase and program
+   sequences of the KV store, the journal and the update never interleave */
+static void *core_flash_mutex;
+#endif /* CORE_FLASH_ENABLE */
+
+#ifdef KV_STORE_ENABLE
+/* settings in flash sectors 1 and 2 */
+kv_flash_operation_t core_kv_flash_operation = {
+  .pf_flash_erase   = core_kv_erase,
+  .pf_flash_program = core_kv_program,
+};
+
+bsp_kv_store_t core_kv = { .is_initialized = KV_STORE_NOT_INITED };
+#endif /* KV_STORE_ENABLE */
+
+#ifdef EVLOG_ENABLE
+/* event journal in flash sectors 3 and 4 */
+evlog_flash_operation_t core_evlog_flash_operation = {
+  .pf_flash_erase   = core_evlog_erase,
+  .pf_flash_program = core_evlog_program,
+};
+
+static const evlog_sector_t core_evlog_sectors[] = {
+  { (uint32_t *)EVLOG_SECTOR_0_ADDR, EVLOG_SECTOR_0_BYTES },
+  { (uint32_t *)EVLOG_SECTOR_1_ADDR, EVLOG_SECTOR_1_BYTES },
+};
+
+bsp_evlog_t core_evlog = { .is_initialized = EVLOG_NOT_INITED };
+#endif /* EVLOG_ENABLE */
+
+#ifdef CRC_ENABLE
+/* CRC unit, fed by DMA2 stream 4 (memory to memory) from CRC_DMA_MIN_WORDS */
+crc_hw_operation_t core_crc_operation = {
+  .pf_crc_reset     = core_crc_reset,
+  .pf_crc_feed      = core_crc_feed,
+  .pf_crc_dma_start = core_crc_dma_start,
+  .pf_crc_dma_stop  = core_crc_dma_stop,
+  .pf_crc_read      = core_crc_read,
+};
+
+bsp_crc_t core_crc = { .is_initialized = CRC_NOT_INITED };
+
+static CRC_HandleTypeDef core_hcrc;
+DMA_HandleTypeDef        core_hdma_crc;
+#endif /* CRC_ENABLE */
+
+#ifdef FW_UPDATE_ENABLE
+/* A/B slots in sectors 5 and 6, the image over USART1 (bsp_fw_image.h) */
+fw_operation_t core_fw_operation = {
+  .pf_flash_erase   = core_fw_erase,
+  .pf_flash_program = core_fw_program,
+  .pf_crc_words     = core_fw_crc_words,
+};
+
+fw_link_operation_t core_fw_link_operation = {
+  .pf_link_read = core_fw_link_read,
+  .pf_link_send = core_fw_link_send,
+  .pf_reboot    = core_fw_reboot,
+};
+
+static const fw_slot_t core_fw_slots[FW_SLOT_NUM] = {
+  { (uint32_t *)FW_SLOT_A_ADDR, FW_SLOT_BYTES },
+  { (uint32_t *)FW_SLOT_B_ADDR, FW_SLOT_BYTES },
+};
+
+bsp_fw_update_t core_fw_update = { .is_initialized = FW_UPDATE_NOT_INITED };
+
+/* DMA2 stream 2 channel 4 fills the ring, circular, read behind NDTR */
+DMA_HandleTypeDef   core_hdma_usart1_rx;
+static uint8_t      core_fw_ring[FW_LINK_RING_BYTES];
+static uint32_t     core_fw_ring_tail;
+static bsp_signal_t core_fw_link_signal = { .is_initialized = SIGNAL_NOT_INITED };
+#endif /* FW_UPDATE_ENABLE */
+
+#ifdef SPI_ENABLE
+/* SPI2 on PB13 SCK, PB14 MISO, PB15 MOSI; DMA1 stream 4 (TX) and stream 3
+   (RX), channel 0; the tasks share it through the queue of core_spi */
+spi_hw_operation_t core_spi_operation = {
+  .pf_spi_configure = core_spi_configure,
+  .pf_spi_cs        = core_spi_cs,
+  .pf_spi_dma_start = core_spi_dma_start,
+  .pf_spi_dma_stop  = core_spi_dma_stop,
+  .pf_spi_dma_reset = core_spi_dma_reset,
+};
+
+bsp_spi_t core_spi = { .is_initialized = SPI_NOT_INITED };
+
+/* devices on the bus, for spi_xfer_t.device */
+const spi_device_t core_spi_flash = { CORE_SPI_CS_FLASH, SPI_MODE_0,
+                                      25000000U };
+const spi_device_t core_spi_shift = { CORE_SPI_CS_SHIFT, SPI_MODE_0,
+                                      12500000U };
+
+SPI_HandleTypeDef core_hspi2;
+DMA_HandleTypeDef core_hdma_spi2_tx;
+DMA_HandleTypeDef core_hdma_spi2_rx;
+static const uint16_t core_spi_cs_pins[CORE_SPI_CS_NUM] = {
+  GPIO_PIN_12, GPIO_PIN_1,
+};
+#endif /* SPI_ENABLE */
+
+#ifdef WS2812_ENABLE
+/* PA6 TIM3 channel 1 PWM; its update event has DMA1 stream 2 channel 5
+   write CCR1, circular over the ring of core_ws2812 */
+ws2812_hw_operation_t core_ws2812_operation = {
+  .pf_ws2812_clock_hz  = core_ws2812_clock_hz,
+  .pf_ws2812_dma_start = core_ws2812_dma_start,
+  .pf_ws2812_dma_stop  = core_ws2812_dma_stop,
+};
+
+bsp_ws2812_t core_ws2812 = { .is_initialized = WS2812_NOT_INITED };
+static uint8_t core_ws2812_pixels[CORE_WS2812_LEDS * 3U];
+
+/* the status pixel as a LED of the LED handler */
+led_operation_t core_ws2812_led_operation = {
+  .pf_led_on  = core_ws2812_led_on,
+  .pf_led_off = core_ws2812_led_off,
+};
+
+bsp_led_driver_t  core_ws2812_led  = { .is_initialized = LED_INST_NOT_INITED };
+bsp_device_t      core_ws2812_led_dev;
+static led_inst_group_t core_led_group;
+bsp_led_handler_t core_led_handler = {
+  .is_initialized = LED_HANDLER_NOT_INITED,
+  .led_inst_group = &core_led_group,
+};
+static bsp_worker_t core_led_worker = { .is_initialized = BSP_NOT_INITED };
+
+static TIM_HandleTypeDef core_htim3;
+DMA_HandleTypeDef        core_hdma_tim3_up;
+#endif /* WS2812_ENABLE */
+
+#ifdef MATRIX_ENABLE
+/* SPI1 on PA5 SCK, PA7 MOSI into the 74HC595 chain, PB0 its latch; TIM4
+   ends the slots, its interrupt latches and shifts the next one. Not a
+   device of core_spi: the slots are shifted from the interrupt */
+matrix_hw_operation_t core_matrix_operation = {
+  .pf_matrix_clock_hz = core_matrix_clock_hz,
+  .pf_matrix_latch    = core_matrix_latch,
+  .pf_matrix_next     = core_matrix_next,
+  .pf_matrix_start    = core_matrix_start,
+  .pf_matrix_stop     = core_matrix_stop,
+};
+
+bsp_matrix_t core_matrix = { .is_initialized = MATRIX_NOT_INITED };
+
+static SPI_HandleTypeDef core_hspi1;
+static TIM_HandleTypeDef core_htim4;
+#endif /* MATRIX_ENABLE */
+
+#ifdef I2C_ENABLE
+/* I2C1 on PB6 SCL, PB7 SDA, open-drain; DMA1 stream 0 (RX) and stream 6
+   (TX), channel 1; the sensors share it through the queue of core_i2c,
+   sampled by i2c_sampler_add from core_i2c_task */
+i2c_hw_operation_t core_i2c_operation = {
+  .pf_i2c_start   = core_i2c_start,
+  .pf_i2c_abort   = core_i2c_abort,
+  .pf_i2c_recover = core_i2c_recover,
+};
+
+bsp_i2c_t core_i2c = { .is_initialized = I2C_NOT_INITED };
+
+I2C_HandleTypeDef   core_hi2c1;
+DMA_HandleTypeDef   core_hdma_i2c1_rx;
+DMA_HandleTypeDef   core_hdma_i2c1_tx;
+static bsp_signal_t core_i2c_signal = { .is_initialized = SIGNAL_NOT_INITED };
+#endif /* I2C_ENABLE */
 
 /* USER CODE END Variables */
 /* Definitions for defaultTask */
 osThreadId_t defaultTaskHandle;
 const osThreadAttr_t defaultTask_attributes = {
   .name = "defaultTask",
-  .stack_size = 128 * 4,
+  .stack_size = 512 * 4,
   .priority = (osPriority_t) osPriorityNormal,
 };
 
 /* Private function prototypes -----------------------------------------------*/
 /* USER CODE BEGIN FunctionPrototypes */
+void vApplicationStackOverflowHook(TaskHandle_t xTask, char *pcTaskName);
 
 /* USER CODE END FunctionPrototypes */
 
@@ -71,11 +562,16 @@ void MX_FREERTOS_Init(void); /* (MISRA C 2004 rule 8.1) */
   */
 void MX_FREERTOS_Init(void) {
   /* USER CODE BEGIN Init */
+  bsp_core_init(&core_osal);
 
   /* USER CODE END Init */
 
   /* USER CODE BEGIN RTOS_MUTEX */
   /* add mutexes, ... */
+#ifdef CORE_FLASH_ENABLE
+  /* before evlog_mount, the first writer */
+  core_os_mutex_create(&core_flash_mutex);
+#endif /* CORE_FLASH_ENABLE */
   /* USER CODE END RTOS_MUTEX */
 
   /* USER CODE BEGIN RTOS_SEMAPHORES */
@@ -96,6 +592,188 @@ void MX_FREERTOS_Init(void) {
 
   /* USER CODE BEGIN RTOS_THREADS */
   /* add threads, ... */
+  key_handler_inst(&core_key_handler, &core_os_queue, &core_os_critical,
+                   &core_time_operation);
+  key_instantiate(&core_key, &core_key_operation, 0U, NULL);
+  core_key_handler.pf_key_register(&core_key_handler, &core_key);
+  key_handler_start(&core_key_handler);
+#ifdef CRC_ENABLE
+  core_crc_hw_init();
+  crc_inst(&core_crc, &core_crc_operation, &core_os_mutex, &core_os_queue);
+#endif /* CRC_ENABLE */
+#ifdef FW_UPDATE_ENABLE
+  {
+    /* the boot loader pointed VTOR to the vectors of the slot it started */
+    uint32_t running = FW_SLOT_NONE;
+
+    for (uint32_t i = 0; i < FW_SLOT_NUM; ++i)
+    {
+      if (SCB->VTOR == (uint32_t)core_fw_slots[i].base + FW_HEADER_BYTES)
+      {
+        running = i;
+      }
+    }
+    core_fw_link_init();
+    fw_update_inst(&core_fw_update, &core_fw_operation,
+                   &core_fw_link_operation, &core_time_operation,
+                   core_fw_slots, running);
+    fw_update_start(&core_fw_update);
+  }
+#endif /* FW_UPDATE_ENABLE */
+#ifdef SPI_ENABLE
+  core_spi_hw_init();
+  spi_bus_inst(&core_spi, &core_spi_operation, &core_os_critical);
+#endif /* SPI_ENABLE */
+#ifdef WS2812_ENABLE
+  core_ws2812_hw_init();
+  ws2812_inst(&core_ws2812, &core_ws2812_operation, &core_os_critical,
+              WS2812_TYPE_WS2812B, core_ws2812_pixels, CORE_WS2812_LEDS);
+  led_handler_inst(&core_led_handler, &core_os_delay, &core_os_critical,
+                   &core_time_operation);
+  if (BSP_OK == bsp_worker_inst(&core_led_worker, "led_worker",
+                                CORE_LED_WORKER_DEPTH,
+                                CORE_LED_WORKER_STACK_WORDS,
+                                CORE_LED_WORKER_PRIORITY))
+  {
+    core_led_handler.p_worker = &core_led_worker;
+  }
+#endif /* WS2812_ENABLE */
+#ifdef MATRIX_ENABLE
+  core_matrix_hw_init();
+  matrix_inst(&core_matrix, &core_matrix_operation, &core_os_critical,
+              CORE_MATRIX_ROWS, CORE_MATRIX_COLS, CORE_MATRIX_BITS,
+              CORE_MATRIX_HZ);
+#endif /* MATRIX_ENABLE */
+#ifdef I2C_ENABLE
+  core_i2c_hw_init();
+  i2c_bus_inst(&core_i2c, &core_i2c_operation, &core_os_critical);
+  signal_instantiate(&core_i2c_signal, NULL);
+  core_i2c.signal   = &core_i2c_signal;
+  core_i2c.sig_bits = CORE_I2C_EVENT;
+  core_os_thread_create(core_i2c_task, "i2c", CORE_I2C_STACK_WORDS, NULL,
+                        CORE_I2C_PRIORITY);
+#endif /* I2C_ENABLE */
+#ifdef EVLOG_ENABLE
+  {
+    /* a long press of the key prints the journal */
+    key_subscriber_t dump_key = {
+      .type       = KEY_SUB_SIGNAL,
+      .key_mask   = 1UL << 0,
+      .event_mask = KEY_EVT_BIT(KEY_EVT_LONG_PRESS),
+      .target     = &core_evlog.signal,
+    };
+    uint32_t reset_flags = RCC->CSR;
+
+    evlog_inst(&core_evlog, &core_evlog_flash_operation, &core_time_operation,
+               &core_os_critical, core_evlog_sectors, 2U);
+    evlog_mount(&core_evlog);
+    core_evlog.dump_mask |= KEY_EVT_BIT(KEY_EVT_LONG_PRESS);
+    core_key_handler.pf_key_subscribe(&core_key_handler, &dump_key);
+    evlog_start(&core_evlog);
+    evlog_write(&core_evlog, CORE_EVLOG_BOOT, &reset_flags,
+                sizeof(reset_flags));
+    __HAL_RCC_CLEAR_RESET_FLAGS();
+  }
+#endif /* EVLOG_ENABLE */
+#ifdef DSP_PIPELINE_ENABLE
+  dsp_fir_lowpass_design(core_dsp_lowpass, 31U, 0.2f);
+  dsp_chain_inst(&core_dsp_level, "level", DSP_ADC_BLOCK, NULL, NULL);
+  dsp_chain_add_stats(&core_dsp_level, &core_dsp_level_stats);
+  dsp_chain_inst(&core_dsp_spectrum, "spectrum", DSP_ADC_BLOCK,
+                 core_dsp_spectrum_done, NULL);
+  dsp_chain_add_fir(&core_dsp_spectrum, &core_dsp_fir, core_dsp_lowpass, 31U);
+  dsp_chain_add_decimate(&core_dsp_spectrum, &core_dsp_dec, core_dsp_lowpass,
+                         31U, 2U);
+  dsp_chain_add_rfft(&core_dsp_spectrum, &core_dsp_rfft);
+  dsp_chain_add_magnitude(&core_dsp_spectrum);
+  dsp_chain_add_stats(&core_dsp_spectrum, &core_dsp_spectrum_stats);
+  dsp_pipeline_inst(&core_dsp_pipeline, &core_adc_operation, &core_os_critical,
+                    &core_time_operation);
+  core_dsp_pipeline.pf_chain_register(&core_dsp_pipeline, &core_dsp_level);
+  core_dsp_pipeline.pf_chain_register(&core_dsp_pipeline, &core_dsp_spectrum);
+  dsp_pipeline_start(&core_dsp_pipeline);
+#endif /* DSP_PIPELINE_ENABLE */
+#ifdef WDG_SUPERVISOR_ENABLE
+  wdg_supervisor_inst(&core_wdg, &core_wdg_operation, &core_time_operation,
+                      &core_os_delay, &core_os_thread, WDG_PERIOD_MS,
+                      WDG_TIMEOUT_MS);
+  core_wdg.pf_client_register(&core_wdg, "defaultTask", 3000U,
+                              &core_wdg_default_id);
+  wdg_supervisor_start(&core_wdg);
+#endif /* WDG_SUPERVISOR_ENABLE */
+#ifdef BENCH_LATENCY_ENABLE
+  bench_latency_start(0U);
+#endif /* BENCH_LATENCY_ENABLE */
+#ifdef BENCH_ZEROCOPY_ENABLE
+  bench_zerocopy_start(0U);
+#endif /* BENCH_ZEROCOPY_ENABLE */
+#ifdef BENCH_FPU_ENABLE
+  bench_fpu_start(0U);
+#endif /* BENCH_FPU_ENABLE */
+#ifdef BENCH_BUILD_ENABLE
+  bench_build_start(0U);
+#endif /* BENCH_BUILD_ENABLE */
+#ifdef BENCH_CLOCK_ENABLE
+  bench_clock_start(0U);
+#endif /* BENCH_CLOCK_ENABLE */
+#ifdef BENCH_DSP_ENABLE
+  bench_dsp_start(0U);
+#endif /* BENCH_DSP_ENABLE */
+#ifdef BENCH_DSP_KERNEL_ENABLE
+  bench_dsp_kernel_start(0U);
+#endif /* BENCH_DSP_KERNEL_ENABLE */
+#ifdef BENCH_DSP_FEATURE_ENABLE
+  bench_dsp_feature_start(0U);
+#endif /* BENCH_DSP_FEATURE_ENABLE */
+#ifdef BENCH_NN_ENABLE
+  bench_nn_start(0U);
+#endif /* BENCH_NN_ENABLE */
+#ifdef BENCH_WATCHDOG_ENABLE
+  bench_watchdog_start(0U);
+#endif /* BENCH_WATCHDOG_ENABLE */
+#ifdef BENCH_KV_ENABLE
+  bench_kv_start(0U);
+#endif /* BENCH_KV_ENABLE */
+#ifdef BENCH_EVLOG_ENABLE
+  bench_evlog_start(0U);
+#endif /* BENCH_EVLOG_ENABLE */
+#ifdef BENCH_CRC_ENABLE
+#ifdef CRC_ENABLE
+  bench_crc_start(0U, &core_crc);
+#else
+  bench_crc_start(0U, NULL);
+#endif /* CRC_ENABLE */
+#endif /* BENCH_CRC_ENABLE */
+#ifdef BENCH_FWUPDATE_ENABLE
+  bench_fwupdate_start(0U);
+#endif /* BENCH_FWUPDATE_ENABLE */
+#ifdef BENCH_SPI_ENABLE
+  bench_spi_start(0U);
+#endif /* BENCH_SPI_ENABLE */
+#ifdef BENCH_WS2812_ENABLE
+  bench_ws2812_start(0U);
+#endif /* BENCH_WS2812_ENABLE */
+#ifdef BENCH_MATRIX_ENABLE
+  bench_matrix_start(0U);
+#endif /* BENCH_MATRIX_ENABLE */
+#ifdef BENCH_I2C_ENABLE
+  bench_i2c_start(0U);
+#endif /* BENCH_I2C_ENABLE */
+#ifdef BENCH_TIME_ENABLE
+  bench_time_start(0U);
+#endif /* BENCH_TIME_ENABLE */
+#ifdef BENCH_KEY_ENABLE
+  bench_key_start(0U);
+#endif /* BENCH_KEY_ENABLE */
+#ifdef BENCH_PLL_ENABLE
+  bench_pll_start(0U);
+#endif /* BENCH_PLL_ENABLE */
+#ifdef BENCH_DEVICE_ENABLE
+  bench_device_start(0U);
+#endif /* BENCH_DEVICE_ENABLE */
+#ifdef STACK_REPORT_ENABLE
+  stack_report_start(STACK_REPORT_PERIOD_MS);
+#endif /* STACK_REPORT_ENABLE */
   /* USER CODE END RTOS_THREADS */
 
   /* USER CODE BEGIN RTOS_EVENTS */
@@ -115,13 +793,66 @@ void StartDefaultTask(void *argument)
 {
   /* USER CODE BEGIN StartDefaultTask */
   /* Infinite loop */
+  /* blink of the status LED, overridden by the stored settings */
+  uint32_t led_period_ms = 200U;
+  led_duty_t led_duty = DUTY_50_PERCENT;
+#ifdef KV_STORE_ENABLE
+  uint32_t setting;
+
+  kv_store_inst(&core_kv, &core_kv_flash_operation, &core_os_mutex,
+                (uint32_t *)KV_SECTOR_0_ADDR, (uint32_t *)KV_SECTOR_1_ADDR,
+                KV_SECTOR_BYTES);
+  kv_store_mount(&core_kv);
+  if ((KV_OK == kv_get(&core_kv, CORE_KV_LOG_LEVEL, &setting,
+                       sizeof(setting), NULL)) &&
+      (LOG_LEVEL_OFF >= setting))
+  {
+    bsp_log_level = (log_level_t)setting;
+  }
+  if ((KV_OK == kv_get(&core_kv, CORE_KV_LED_PERIOD, &setting,
+                       sizeof(setting), NULL)) &&
+      (0U != setting))
+  {
+    led_period_ms = setting;
+  }
+  if ((KV_OK == kv_get(&core_kv, CORE_KV_LED_DUTY, &setting,
+                       sizeof(setting), NULL)) &&
+      (DUTY_MAX_PERCENT >= setting))
+  {
+    led_duty = (led_duty_t)setting;
+  }
+#endif /* KV_STORE_ENABLE */
   LOG(LOG_LEVEL_WARN, "Before");
-  bsp_led_driver_t led_1;
-  led_instantiate(&led_1, NULL);
+#ifdef WS2812_ENABLE
+  /* a frame needs the scheduler running: its interrupts refill the ring */
+  led_instantiate(&core_ws2812_led, &core_ws2812_led_operation);
+  bsp_device_inst(&core_ws2812_led_dev, "led0", &led_ops, &core_ws2812_led);
+  bsp_device_register(&core_ws2812_led_dev);
+  core_led_handler.pf_led_register(&core_led_handler, &core_ws2812_led_dev);
+  core_led_handler.pf_led_ctrl(&core_led_handler, &core_ws2812_led_dev,
+                               led_period_ms, 3U, led_duty);
+#else
+  (void)led_period_ms;
+  (void)led_duty;
+#endif /* WS2812_ENABLE */
+#ifdef MATRIX_ENABLE
+  /* every level once: a ramp along the diagonals, the scan needs the
+     scheduler running as the strip does */
+  for (uint32_t y = 0; y < CORE_MATRIX_ROWS; ++y)
+  {
+    for (uint32_t x = 0; x < CORE_MATRIX_COLS; ++x)
+    {
+      matrix_set_pixel(&core_matrix, x, y, (uint8_t)((x + y) * 8U));
+    }
+  }
+  matrix_show(&core_matrix);
+#endif /* MATRIX_ENABLE */
   LOG(LOG_LEVEL_WARN, "After");
   for(;;)
   {
-    
+#ifdef WDG_SUPERVISOR_ENABLE
+    wdg_checkin(&core_wdg, core_wdg_default_id);
+#endif /* WDG_SUPERVISOR_ENABLE */
     osDelay(1000);
   }
   /* USER CODE END StartDefaultTask */
@@ -129,6 +860,1771 @@ void StartDefaultTask(void *argument)
 
 /* Private application code --------------------------------------------------*/
 /* USER CODE BEGIN Application */
+/**
+  * @brief  Milliseconds of the time service, wraps after 49 days
+  * @param  time_ms: output time
+  * @retval bsp_status_t
+  */
+static bsp_status_t core_get_time_ms(uint32_t * const time_ms)
+{
+  if (NULL == time_ms)
+  {
+    return BSP_ERRORPARAMETER;
+  }
+  *time_ms = (uint32_t)time_get_ms();
+  return BSP_OK;
+}
+
+/**
+  * @brief  Microseconds of the time service, never wraps
+  * @param  time_us: output time
+  * @retval bsp_status_t
+  */
+static bsp_status_t core_get_time_us(uint64_t * const time_us)
+{
+  if (NULL == time_us)
+  {
+    return BSP_ERRORPARAMETER;
+  }
+  *time_us = time_get_us();
+  return BSP_OK;
+}
+
+/**
+  * @brief  Block the calling task
+  * @param  delay_ms: delay in milliseconds
+  * @retval bsp_status_t
+  */
+static bsp_status_t core_os_delay_ms(const uint32_t delay_ms)
+{
+  vTaskDelay(pdMS_TO_TICKS(delay_ms));
+  return BSP_OK;
+}
+
+/**
+  * @brief  Create a task
+  * @param  entry: task function
+  * @param  name: task name
+  * @param  stack_words: stack depth in words
+  * @param  argument: task argument
+  * @param  priority: FreeRTOS priority, 0 is the idle priority
+  * @retval bsp_status_t
+  */
+static bsp_status_t core_os_thread_create(void (*entry)(void *),
+                                          const char * const name,
+                                          uint32_t const stack_words,
+                                          void * const argument,
+                                          uint32_t const priority)
+{
+  if (NULL == entry || priority >= configMAX_PRIORITIES)
+  {
+    return BSP_ERRORPARAMETER;
+  }
+  if (pdPASS != xTaskCreate(entry, name, (configSTACK_DEPTH_TYPE)stack_words,
+                            argument, (UBaseType_t)priority, NULL))
+  {
+    return BSP_ERRORNOMEMORY;
+  }
+  return BSP_OK;
+}
+
+/**
+  * @brief  Enter a critical section, task context only
+  * @retval bsp_status_t
+  */
+static bsp_status_t core_os_critical_enter(void)
+{
+  taskENTER_CRITICAL();
+  return BSP_OK;
+}
+
+/**
+  * @brief  Exit a critical section, task context only
+  * @retval bsp_status_t
+  */
+static bsp_status_t core_os_critical_exit(void)
+{
+  taskEXIT_CRITICAL();
+  return BSP_OK;
+}
+
+/**
+  * @brief  Create a mutex with priority inheritance
+  * @param  mutex_handler: output handle
+  * @retval bsp_status_t
+  */
+static bsp_status_t core_os_mutex_create(void ** const mutex_handler)
+{
+  const osMutexAttr_t attr = { .attr_bits = osMutexPrioInherit };
+
+  if (NULL == mutex_handler)
+  {
+    return BSP_ERRORPARAMETER;
+  }
+  *mutex_handler = osMutexNew(&attr);
+  return (NULL == *mutex_handler) ? BSP_ERRORNOMEMORY : BSP_OK;
+}
+
+/**
+  * @brief  Lock a mutex, task context only
+  * @param  mutex_handler: mutex handle
+  * @param  timeout: max wait in ticks
+  * @retval bsp_status_t
+  */
+static bsp_status_t core_os_mutex_lock(void * const mutex_handler,
+                                      uint32_t timeout)
+{
+  osStatus_t status = osMutexAcquire((osMutexId_t)mutex_handler, timeout);
+
+  if (osOK == status)
+  {
+    return BSP_OK;
+  }
+  return (osErrorTimeout == status || osErrorResource == status) ?
+         BSP_ERRORTIMEOUT : BSP_ERRORPARAMETER;
+}
+
+/**
+  * @brief  Unlock a mutex held by the calling task
+  * @param  mutex_handler: mutex handle
+  * @retval bsp_status_t
+  */
+static bsp_status_t core_os_mutex_unlock(void * const mutex_handler)
+{
+  if (osOK != osMutexRelease((osMutexId_t)mutex_handler))
+  {
+    return BSP_ERRORPARAMETER;
+  }
+  return BSP_OK;
+}
+
+/**
+  * @brief  Create a message queue
+  * @param  num: number of items
+  * @param  size: size of one item in bytes
+  * @param  queue_handler: output handle
+  * @retval bsp_status_t
+  */
+static bsp_status_t core_os_queue_create(uint32_t const num,
+                                         uint32_t const size,
+                                         void ** const queue_handler)
+{
+  if (NULL == queue_handler)
+  {
+    return BSP_ERRORPARAMETER;
+  }
+  *queue_handler = osMessageQueueNew(num, size, NULL);
+  return (NULL == *queue_handler) ? BSP_ERRORNOMEMORY : BSP_OK;
+}
+
+/**
+  * @brief  Put an item into a message queue, callable from ISR with timeout 0
+  * @param  queue_handler: queue handle
+  * @param  item: item to copy into the queue
+  * @param  timeout: max wait in ticks
+  * @retval bsp_status_t
+  */
+static bsp_status_t core_os_queue_put(void * const queue_handler,
+                                      void * const item,
+                                      uint32_t timeout)
+{
+  osStatus_t status = osMessageQueuePut((osMessageQueueId_t)queue_handler,
+                                        item, 0U, timeout);
+
+  if (osOK == status)
+  {
+    return BSP_OK;
+  }
+  return (osErrorTimeout == status || osErrorResource == status) ?
+         BSP_ERRORTIMEOUT : BSP_ERRORPARAMETER;
+}
+
+/**
+  * @brief  Get an item from a message queue
+  * @param  queue_handler: queue handle
+  * @param  msg: output item
+  * @param  timeout: max wait in ticks
+  * @retval bsp_status_t
+  */
+static bsp_status_t core_os_queue_get(void * const queue_handler,
+                                      void * const msg,
+                                      uint32_t timeout)
+{
+  osStatus_t status = osMessageQueueGet((osMessageQueueId_t)queue_handler,
+                                        msg, NULL, timeout);
+
+  if (osOK == status)
+  {
+    return BSP_OK;
+  }
+  return (osErrorTimeout == status || osErrorResource == status) ?
+         BSP_ERRORTIMEOUT : BSP_ERRORPARAMETER;
+}
+
+/**
+  * @brief  Delete a message queue
+  * @param  queue_handler: queue handle
+  * @retval bsp_status_t
+  */
+static bsp_status_t core_os_queue_delete(void * const queue_handler)
+{
+  if (osOK != osMessageQueueDelete((osMessageQueueId_t)queue_handler))
+  {
+    return BSP_ERRORPARAMETER;
+  }
+  return BSP_OK;
+}
+
+/**
+  * @brief  Read the KEY level, the key pulls PA0 low when pressed
+  * @param  pressed: 1 when pressed
+  * @retval key_inst_status_t
+  */
+static key_inst_status_t core_key_read(uint8_t * const pressed)
+{
+  *pressed = (GPIO_PIN_RESET == HAL_GPIO_ReadPin(KEY_GPIO_Port, KEY_Pin)) ?
+             1U : 0U;
+  return KEY_INST_OK;
+}
+
+/**
+  * @brief  Unmask the KEY edge interrupt, an edge seen while masked is dropped
+  * @retval key_inst_status_t
+  */
+static key_inst_status_t core_key_irq_enable(void)
+{
+  UBaseType_t mask = taskENTER_CRITICAL_FROM_ISR();
+
+  __HAL_GPIO_EXTI_CLEAR_IT(KEY_Pin);
+  SET_BIT(EXTI->IMR, KEY_Pin);
+  taskEXIT_CRITICAL_FROM_ISR(mask);
+  return KEY_INST_OK;
+}
+
+/**
+  * @brief  Mask the KEY edge interrupt, task and ISR context
+  * @retval key_inst_status_t
+  */
+static key_inst_status_t core_key_irq_disable(void)
+{
+  UBaseType_t mask = taskENTER_CRITICAL_FROM_ISR();
+
+  CLEAR_BIT(EXTI->IMR, KEY_Pin);
+  taskEXIT_CRITICAL_FROM_ISR(mask);
+  return KEY_INST_OK;
+}
+
+/**
+  * @brief  EXTI line detection callback
+  * @param  GPIO_Pin: pin of the EXTI line
+  * @retval None
+  */
+void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin)
+{
+  if (KEY_Pin == GPIO_Pin)
+  {
+    key_handler_irq(&core_key_handler, 0U);
+  }
+}
+
+#ifdef DSP_PIPELINE_ENABLE
+/**
+  * @brief  Start TIM2 paced ADC1 conversions into a circular DMA ring
+  * @param  buf: ring of len halfwords
+  * @param  len: samples of the whole ring
+  * @retval dsp_status_t
+  */
+static dsp_status_t core_adc_start(uint16_t * const buf, uint32_t len)
+{
+  if (HAL_OK != HAL_ADC_Start_DMA(&hadc1, (uint32_t *)buf, len))
+  {
+    return DSP_ERROR;
+  }
+  if (HAL_OK != HAL_TIM_Base_Start(&htim2))
+  {
+    HAL_ADC_Stop_DMA(&hadc1);
+    return DSP_ERROR;
+  }
+  return DSP_OK;
+}
+
+/**
+  * @brief  Stop the trigger, then the ADC and its DMA
+  * @retval dsp_status_t
+  */
+static dsp_status_t core_adc_stop(void)
+{
+  HAL_TIM_Base_Stop(&htim2);
+  HAL_ADC_Stop_DMA(&hadc1);
+  return DSP_OK;
+}
+
+/**
+  * @brief  Report the strongest bin of the spectrum about once a second
+  * @param  chain: the spectrum chain
+  * @param  out: magnitude of the bins
+  * @param  len: number of bins
+  * @param  context: not used
+  * @retval None
+  */
+static void core_dsp_spectrum_done(dsp_chain_t * const chain,
+                                   const float32_t * const out,
+                                   uint32_t len,
+                                   void * const context)
+{
+  /* bin width: TIM2_TRGO_HZ / 2 (decimation) / (2 * len) */
+  uint32_t peak_hz = core_dsp_spectrum_stats.max_index * TIM2_TRGO_HZ /
+                     (4U * len);
+
+  (void)out;
+  (void)context;
+  if (0U != (chain->blocks % (TIM2_TRGO_HZ / DSP_ADC_BLOCK)))
+  {
+    return;
+  }
+  LOG(LOG_LEVEL_INFO, "DSP peak %u Hz, level rms %d mV, overruns %u",
+      (unsigned int)peak_hz,
+      (int)(core_dsp_level_stats.rms * 1650.0f),
+      (unsigned int)core_dsp_pipeline.overruns);
+}
+
+/**
+  * @brief  First half of the ADC ring filled
+  * @param  hadc: ADC handle
+  * @retval None
+  */
+void HAL_ADC_ConvHalfCpltCallback(ADC_HandleTypeDef *hadc)
+{
+  if (ADC1 == hadc->Instance)
+  {
+    dsp_pipeline_irq(&core_dsp_pipeline, 0U);
+  }
+}
+
+/**
+  * @brief  Second half of the ADC ring filled
+  * @param  hadc: ADC handle
+  * @retval None
+  */
+void HAL_ADC_ConvCpltCallback(ADC_HandleTypeDef *hadc)
+{
+  if (ADC1 == hadc->Instance)
+  {
+    dsp_pipeline_irq(&core_dsp_pipeline, 1U);
+  }
+}
+#endif /* DSP_PIPELINE_ENABLE */
+
+#ifdef WDG_SUPERVISOR_ENABLE
+/**
+  * @brief  Start the IWDG, prescaler 64 on the LSI, frozen while the core
+  *         is halted by the debugger
+  * @param  timeout_ms: time from the last reload to the reset
+  * @retval wdg_status_t
+  */
+static wdg_status_t core_wdg_start(uint32_t timeout_ms)
+{
+  uint32_t reload = timeout_ms * (LSI_VALUE / 64U) / 1000U;
+
+  if ((0U == reload) || (reload > 0xFFFU))
+  {
+    return WDG_ERRORPARAMETER;
+  }
+  __HAL_DBGMCU_FREEZE_IWDG();
+  core_hiwdg.Instance       = IWDG;
+  core_hiwdg.Init.Prescaler = IWDG_PRESCALER_64;
+  core_hiwdg.Init.Reload    = reload;
+  if (HAL_OK != HAL_IWDG_Init(&core_hiwdg))
+  {
+    return WDG_ERROR;
+  }
+  return WDG_OK;
+}
+
+/**
+  * @brief  Reload the IWDG counter
+  * @retval wdg_status_t
+  */
+static wdg_status_t core_wdg_kick(void)
+{
+  HAL_IWDG_Refresh(&core_hiwdg);
+  return WDG_OK;
+}
+#endif /* WDG_SUPERVISOR_ENABLE */
+
+#ifdef CORE_FLASH_ENABLE
+/**
+  * @brief  Erase a flash sector, code fetches stall meanwhile; one writer
+  *         at a time, the others wait on core_flash_mutex
+  * @param  sector: FLASH_SECTOR_x
+  * @retval bsp_status_t: BSP_ERRORPARAMETER without the mutex
+  */
+static bsp_status_t core_flash_erase(uint32_t sector)
+{
+  FLASH_EraseInitTypeDef erase = {
+    .TypeErase    = FLASH_TYPEERASE_SECTORS,
+    .Sector       = sector,
+    .NbSectors    = 1U,
+    .VoltageRange = FLASH_VOLTAGE_RANGE_3,
+  };
+  uint32_t          bad_sector = 0U;
+  HAL_StatusTypeDef status;
+  bsp_status_t      ret;
+
+  ret = core_os_mutex_lock(core_flash_mutex, BSP_WAIT_FOREVER);
+  if (BSP_OK != ret)
+  {
+    return ret;
+  }
+  HAL_FLASH_Unlock();
+  __HAL_FLASH_CLEAR_FLAG(FLASH_FLAG_EOP | FLASH_FLAG_OPERR |
+                         FLASH_FLAG_WRPERR | FLASH_FLAG_PGAERR |
+                         FLASH_FLAG_PGPERR | FLASH_FLAG_PGSERR);
+  status = HAL_FLASHEx_Erase(&erase, &bad_sector);
+  HAL_FLASH_Lock();
+  (void)core_os_mutex_unlock(core_flash_mutex);
+  return (HAL_OK == status) ? BSP_OK : BSP_ERROR;
+}
+
+/**
+  * @brief  Program words, 32 bit parallelism; one writer at a time, the
+  *         others wait on core_flash_mutex
+  * @param  dst: first word, erased
+  * @param  src: the words
+  * @param  words: number of words
+  * @retval bsp_status_t: BSP_ERRORPARAMETER without the mutex
+  */
+static bsp_status_t core_flash_program(uint32_t * const dst,
+                                       const uint32_t * const src,
+                                       uint32_t words)
+{
+  bsp_status_t ret;
+
+  ret = core_os_mutex_lock(core_flash_mutex, BSP_WAIT_FOREVER);
+  if (BSP_OK != ret)
+  {
+    return ret;
+  }
+  HAL_FLASH_Unlock();
+  __HAL_FLASH_CLEAR_FLAG(FLASH_FLAG_EOP | FLASH_FLAG_OPERR |
+                         FLASH_FLAG_WRPERR | FLASH_FLAG_PGAERR |
+                         FLASH_FLAG_PGPERR | FLASH_FLAG_PGSERR);
+  for (uint32_t i = 0; i < words; ++i)
+  {
+    if (HAL_OK != HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD,
+                                    (uint32_t)&dst[i], src[i]))
+    {
+      ret = BSP_ERROR;
+      break;
+    }
+  }
+  HAL_FLASH_Lock();
+  (void)core_os_mutex_unlock(core_flash_mutex);
+  return ret;
+}
+#endif /* CORE_FLASH_ENABLE */
+
+#ifdef KV_STORE_ENABLE
+/**
+  * @brief  Erase a sector of the KV store
+  * @param  sector: 0 for sector 1, 1 for sector 2
+  * @retval kv_status_t: the codes of bsp_status_t (BSP_STATUS_CHECK)
+  */
+static kv_status_t core_kv_erase(uint32_t sector)
+{
+  if (sector > 1U)
+  {
+    return KV_ERRORPARAMETER;
+  }
+  return (kv_status_t)core_flash_erase(FLASH_SECTOR_1 + sector);
+}
+
+/**
+  * @brief  Program words into a sector of the KV store
+  * @param  dst: first word, erased
+  * @param  src: the words
+  * @param  words: number of words
+  * @retval kv_status_t
+  */
+static kv_status_t core_kv_program(uint32_t * const dst,
+                                   const uint32_t * const src,
+                                   uint32_t words)
+{
+  return (kv_status_t)core_flash_program(dst, src, words);
+}
+#endif /* KV_STORE_ENABLE */
+
+#ifdef EVLOG_ENABLE
+/**
+  * @brief  Erase a sector of the event journal
+  * @param  sector: 0 for sector 3, 1 for sector 4
+  * @retval evlog_status_t: the codes of bsp_status_t (BSP_STATUS_CHECK)
+  */
+static evlog_status_t core_evlog_erase(uint32_t sector)
+{
+  if (sector > 1U)
+  {
+    return EVLOG_ERRORPARAMETER;
+  }
+  return (evlog_status_t)core_flash_erase(FLASH_SECTOR_3 + sector);
+}
+
+/**
+  * @brief  Program words of a journal page
+  * @param  dst: first word, erased
+  * @param  src: the words
+  * @param  words: number of words
+  * @retval evlog_status_t
+  */
+static evlog_status_t core_evlog_program(uint32_t * const dst,
+                                         const uint32_t * const src,
+                                         uint32_t words)
+{
+  return (evlog_status_t)core_flash_program(dst, src, words);
+}
+#endif /* EVLOG_ENABLE */
+
+#ifdef CRC_ENABLE
+/**
+  * @brief  Clock the CRC unit, set DMA2 stream 4 up to feed its data
+  *         register: memory to memory, the source increments, the data
+  *         register stays, words, FIFO on as memory to memory needs it
+  * @retval None
+  */
+static void core_crc_hw_init(void)
+{
+  __HAL_RCC_CRC_CLK_ENABLE();
+  __HAL_RCC_DMA2_CLK_ENABLE();
+  core_hcrc.Instance = CRC;
+  HAL_CRC_Init(&core_hcrc);
+
+  core_hdma_crc.Instance                 = DMA2_Stream4;
+  core_hdma_crc.Init.Channel             = DMA_CHANNEL_0;
+  core_hdma_crc.Init.Direction           = DMA_MEMORY_TO_MEMORY;
+  core_hdma_crc.Init.PeriphInc           = DMA_PINC_ENABLE;
+  core_hdma_crc.Init.MemInc              = DMA_MINC_DISABLE;
+  core_hdma_crc.Init.PeriphDataAlignment = DMA_PDATAALIGN_WORD;
+  core_hdma_crc.Init.MemDataAlignment    = DMA_MDATAALIGN_WORD;
+  core_hdma_crc.Init.Mode                = DMA_NORMAL;
+  core_hdma_crc.Init.Priority            = DMA_PRIORITY_LOW;
+  core_hdma_crc.Init.FIFOMode            = DMA_FIFOMODE_ENABLE;
+  core_hdma_crc.Init.FIFOThreshold       = DMA_FIFO_THRESHOLD_FULL;
+  core_hdma_crc.Init.MemBurst            = DMA_MBURST_SINGLE;
+  core_hdma_crc.Init.PeriphBurst         = DMA_PBURST_SINGLE;
+  if (HAL_OK != HAL_DMA_Init(&core_hdma_crc))
+  {
+    /* the CPU feeds every buffer */
+    core_crc_operation.pf_crc_dma_start = NULL;
+    return;
+  }
+  core_hdma_crc.XferCpltCallback  = core_crc_dma_cplt;
+  core_hdma_crc.XferErrorCallback = core_crc_dma_error;
+
+  /* calls the RTOS from the interrupt, same priority as the ADC stream */
+  HAL_NVIC_SetPriority(DMA2_Stream4_IRQn, 5, 0);
+  HAL_NVIC_EnableIRQ(DMA2_Stream4_IRQn);
+}
+
+/**
+  * @brief  Data register back to 0xFFFFFFFF
+  * @retval crc_status_t
+  */
+static crc_status_t core_crc_reset(void)
+{
+  __HAL_CRC_DR_RESET(&core_hcrc);
+  return CRC_OK;
+}
+
+/**
+  * @brief  CPU writes of words into the data register
+  * @param  data: the words, any alignment
+  * @param  words: number of words
+  * @param  reverse: 1 to write the bytes of each word in memory order
+  * @retval crc_status_t
+  */
+static crc_status_t core_crc_feed(const void * const data, uint32_t words,
+                                  uint32_t reverse)
+{
+  const uint8_t *p = (const uint8_t *)data;
+
+  if (0U != reverse)
+  {
+    for (uint32_t i = 0; i < words; ++i, p += 4)
+    {
+      CRC->DR = __REV(__UNALIGNED_UINT32_READ(p));
+    }
+  }
+  else
+  {
+    for (uint32_t i = 0; i < words; ++i, p += 4)
+    {
+      CRC->DR = __UNALIGNED_UINT32_READ(p);
+    }
+  }
+  return CRC_OK;
+}
+
+/**
+  * @brief  Start a DMA transfer of words into the data register
+  * @param  words: the words, aligned
+  * @param  num: number of words, 1 to CRC_DMA_MAX_WORDS
+  * @retval crc_status_t
+  */
+static crc_status_t core_crc_dma_start(const uint32_t * const words,
+                                       uint32_t num)
+{
+  if (HAL_OK != HAL_DMA_Start_IT(&core_hdma_crc, (uint32_t)words,
+                                 (uint32_t)&CRC->DR, num))
+  {
+    return CRC_ERROR;
+  }
+  return CRC_OK;
+}
+
+/**
+  * @brief  Abort the DMA transfer after a timeout
+  * @retval crc_status_t
+  */
+static crc_status_t core_crc_dma_stop(void)
+{
+  return (HAL_OK == HAL_DMA_Abort(&core_hdma_crc)) ? CRC_OK : CRC_ERROR;
+}
+
+/**
+  * @brief  Data register
+  * @retval uint32_t
+  */
+static uint32_t core_crc_read(void)
+{
+  return CRC->DR;
+}
+
+/**
+  * @brief  DMA transfer of the CRC service complete
+  * @param  hdma: core_hdma_crc
+  * @retval None
+  */
+static void core_crc_dma_cplt(DMA_HandleTypeDef *hdma)
+{
+  (void)hdma;
+  crc_dma_done_isr(&core_crc, 1U);
+}
+
+/**
+  * @brief  DMA transfer of the CRC service failed
+  * @param  hdma: core_hdma_crc
+  * @retval None
+  */
+static void core_crc_dma_error(DMA_HandleTypeDef *hdma)
+{
+  (void)hdma;
+  crc_dma_done_isr(&core_crc, 0U);
+}
+#endif /* CRC_ENABLE */
+
+#ifdef FW_UPDATE_ENABLE
+/**
+  * @brief  Receive USART1 into the ring by DMA, the idle line, half and
+  *         full ring events wake the firmware receiver
+  * @retval None
+  */
+static void core_fw_link_init(void)
+{
+  __HAL_RCC_DMA2_CLK_ENABLE();
+  core_hdma_usart1_rx.Instance                 = DMA2_Stream2;
+  core_hdma_usart1_rx.Init.Channel             = DMA_CHANNEL_4;
+  core_hdma_usart1_rx.Init.Direction           = DMA_PERIPH_TO_MEMORY;
+  core_hdma_usart1_rx.Init.PeriphInc           = DMA_PINC_DISABLE;
+  core_hdma_usart1_rx.Init.MemInc              = DMA_MINC_ENABLE;
+  core_hdma_usart1_rx.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+  core_hdma_usart1_rx.Init.MemDataAlignment    = DMA_MDATAALIGN_BYTE;
+  core_hdma_usart1_rx.Init.Mode                = DMA_CIRCULAR;
+  core_hdma_usart1_rx.Init.Priority            = DMA_PRIORITY_MEDIUM;
+  core_hdma_usart1_rx.Init.FIFOMode            = DMA_FIFOMODE_DISABLE;
+  if (HAL_OK != HAL_DMA_Init(&core_hdma_usart1_rx))
+  {
+    LOG(LOG_LEVEL_ERR, "Firmware link DMA init failed");
+    return;
+  }
+  __HAL_LINKDMA(&huart1, hdmarx, core_hdma_usart1_rx);
+  signal_instantiate(&core_fw_link_signal, NULL);
+
+  /* call the RTOS from the interrupts, same priority as the ADC stream */
+  HAL_NVIC_SetPriority(DMA2_Stream2_IRQn, 5, 0);
+  HAL_NVIC_EnableIRQ(DMA2_Stream2_IRQn);
+  HAL_NVIC_SetPriority(USART1_IRQn, 5, 0);
+  HAL_NVIC_EnableIRQ(USART1_IRQn);
+  core_fw_link_restart();
+}
+
+/**
+  * @brief  Start the reception again at the head of the ring
+  * @retval None
+  */
+static void core_fw_link_restart(void)
+{
+  core_fw_ring_tail = 0U;
+  HAL_UARTEx_ReceiveToIdle_DMA(&huart1, core_fw_ring, FW_LINK_RING_BYTES);
+}
+
+/**
+  * @brief  Erase a slot, 128 KiB: code fetches stall up to 2 s, below the
+  *         4 s of the watchdog
+  * @param  slot: 0 for sector 5, 1 for sector 6
+  * @retval fw_status_t: the codes of bsp_status_t (BSP_STATUS_CHECK)
+  */
+static fw_status_t core_fw_erase(uint32_t slot)
+{
+  if (slot >= FW_SLOT_NUM)
+  {
+    return FW_ERRORPARAMETER;
+  }
+  return (fw_status_t)core_flash_erase(FLASH_SECTOR_5 + slot);
+}
+
+/**
+  * @brief  Program words of a slot
+  * @param  dst: first word
+  * @param  src: the words
+  * @param  words: number of words
+  * @retval fw_status_t
+  */
+static fw_status_t core_fw_program(uint32_t * const dst,
+                                   const uint32_t * const src,
+                                   uint32_t words)
+{
+  return (fw_status_t)core_flash_program(dst, src, words);
+}
+
+/**
+  * @brief  CRC-32/MPEG-2 of the image words, on the CRC unit when it is
+  *         enabled
+  * @param  words: the words
+  * @param  num: number of words
+  * @retval uint32_t
+  */
+static uint32_t core_fw_crc_words(const uint32_t * const words, uint32_t num)
+{
+#ifdef CRC_ENABLE
+  uint32_t crc = 0U;
+
+  if (CRC_OK == crc_calc_words(&core_crc, words, num, &crc))
+  {
+    return crc;
+  }
+#endif /* CRC_ENABLE */
+  return crc32_mpeg2_sw_words(CRC32_MPEG2_INIT, words, num);
+}
+
+/**
+  * @brief  Bytes of the ring behind the DMA, waits for an event when empty
+  * @param  buf: output bytes
+  * @param  max: size of buf
+  * @param  timeout_ms: max wait when the ring is empty
+  * @param  got: bytes copied
+  * @retval fw_status_t
+  */
+static fw_status_t core_fw_link_read(uint8_t * const buf, uint32_t max,
+                                     uint32_t timeout_ms,
+                                     uint32_t * const got)
+{
+  uint32_t head;
+  uint32_t bits = 0U;
+  uint32_t n    = 0U;
+
+  if (HAL_UART_STATE_BUSY_RX != huart1.RxState)
+  {
+    /* stopped by a line error or by MX_USART1_ClockChanged */
+    HAL_UART_AbortReceive(&huart1);
+    core_fw_link_restart();
+  }
+  head = FW_LINK_RING_BYTES - __HAL_DMA_GET_COUNTER(&core_hdma_usart1_rx);
+  if (head == core_fw_ring_tail && 0U != timeout_ms)
+  {
+    signal_wait(&core_fw_link_signal, FW_LINK_EVENT, timeout_ms, &bits);
+    head = FW_LINK_RING_BYTES - __HAL_DMA_GET_COUNTER(&core_hdma_usart1_rx);
+  }
+  head %= FW_LINK_RING_BYTES;
+  while (core_fw_ring_tail != head && n < max)
+  {
+    buf[n++]          = core_fw_ring[core_fw_ring_tail];
+    core_fw_ring_tail = (core_fw_ring_tail + 1U) % FW_LINK_RING_BYTES;
+  }
+  *got = n;
+  return FW_OK;
+}
+
+/**
+  * @brief  Send a reply frame in one piece: the console (fputc) shares the
+  *         USART, no task runs in between
+  * @param  data: the frame
+  * @param  len: bytes of the frame
+  * @retval fw_status_t
+  */
+static fw_status_t core_fw_link_send(const uint8_t * const data,
+                                     uint32_t len)
+{
+  HAL_StatusTypeDef status = HAL_BUSY;
+
+  for (uint32_t i = 0; i < FW_LINK_TX_RETRIES && HAL_BUSY == status; ++i)
+  {
+    vTaskSuspendAll();
+    if (HAL_UART_STATE_READY == huart1.gState)
+    {
+      status = HAL_UART_Transmit(&huart1, (uint8_t *)data, (uint16_t)len,
+                                 100U);
+    }
+    (void)xTaskResumeAll();
+    if (HAL_BUSY == status)
+    {
+      /* a task stopped in the middle of a console byte */
+      vTaskDelay(pdMS_TO_TICKS(1U));
+    }
+  }
+  return (HAL_OK == status) ? FW_OK : FW_ERROR;
+}
+
+/**
+  * @brief  Reset into the boot loader, the reply is out already
+  * @retval None
+  */
+static void core_fw_reboot(void)
+{
+  NVIC_SystemReset();
+}
+
+/**
+  * @brief  Idle line, half or full ring: bytes for the firmware receiver
+  * @param  huart: UART handle
+  * @param  Size: position in the ring, read from NDTR instead
+  * @retval None
+  */
+void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef *huart, uint16_t Size)
+{
+  (void)Size;
+  if (USART1 == huart->Instance)
+  {
+    signal_set_isr(&core_fw_link_signal, FW_LINK_EVENT);
+  }
+}
+
+/**
+  * @brief  Line error, the reception stopped: the receiver restarts it
+  * @param  huart: UART handle
+  * @retval None
+  */
+void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart)
+{
+  if (USART1 == huart->Instance)
+  {
+    signal_set_isr(&core_fw_link_signal, FW_LINK_EVENT);
+  }
+}
+#endif /* FW_UPDATE_ENABLE */
+
+#ifdef SPI_ENABLE
+/**
+  * @brief  Clock SPI2 and its pins, master, 8 bits, software chip-selects
+  *         all high; DMA1 stream 4 to its data register, stream 3 from it
+  * @retval None
+  */
+static void core_spi_hw_init(void)
+{
+  GPIO_InitTypeDef gpio = {0};
+
+  __HAL_RCC_SPI2_CLK_ENABLE();
+  __HAL_RCC_GPIOB_CLK_ENABLE();
+  __HAL_RCC_DMA1_CLK_ENABLE();
+
+  /* chip-selects high before the pins drive */
+  for (uint32_t i = 0; i < CORE_SPI_CS_NUM; ++i)
+  {
+    HAL_GPIO_WritePin(GPIOB, core_spi_cs_pins[i], GPIO_PIN_SET);
+    gpio.Pin |= core_spi_cs_pins[i];
+  }
+  gpio.Mode  = GPIO_MODE_OUTPUT_PP;
+  gpio.Pull  = GPIO_NOPULL;
+  gpio.Speed = GPIO_SPEED_FREQ_HIGH;
+  HAL_GPIO_Init(GPIOB, &gpio);
+
+  gpio.Pin       = GPIO_PIN_13 | GPIO_PIN_14 | GPIO_PIN_15;
+  gpio.Mode      = GPIO_MODE_AF_PP;
+  gpio.Speed     = GPIO_SPEED_FREQ_VERY_HIGH;
+  gpio.Alternate = GPIO_AF5_SPI2;
+  HAL_GPIO_Init(GPIOB, &gpio);
+
+  core_hspi2.Instance               = SPI2;
+  core_hspi2.Init.Mode              = SPI_MODE_MASTER;
+  core_hspi2.Init.Direction         = SPI_DIRECTION_2LINES;
+  core_hspi2.Init.DataSize          = SPI_DATASIZE_8BIT;
+  core_hspi2.Init.CLKPolarity       = SPI_POLARITY_LOW;
+  core_hspi2.Init.CLKPhase          = SPI_PHASE_1EDGE;
+  core_hspi2.Init.NSS               = SPI_NSS_SOFT;
+  core_hspi2.Init.BaudRatePrescaler = SPI_BAUDRATEPRESCALER_256;
+  core_hspi2.Init.FirstBit          = SPI_FIRSTBIT_MSB;
+  core_hspi2.Init.TIMode            = SPI_TIMODE_DISABLE;
+  core_hspi2.Init.CRCCalculation    = SPI_CRCCALCULATION_DISABLE;
+  core_hspi2.Init.CRCPolynomial     = 10;
+  if (HAL_OK != HAL_SPI_Init(&core_hspi2))
+  {
+    LOG(LOG_LEVEL_ERR, "SPI2 init failed");
+    return;
+  }
+
+  core_hdma_spi2_tx.Instance                 = DMA1_Stream4;
+  core_hdma_spi2_tx.Init.Channel             = DMA_CHANNEL_0;
+  core_hdma_spi2_tx.Init.Direction           = DMA_MEMORY_TO_PERIPH;
+  core_hdma_spi2_tx.Init.PeriphInc           = DMA_PINC_DISABLE;
+  core_hdma_spi2_tx.Init.MemInc              = DMA_MINC_ENABLE;
+  core_hdma_spi2_tx.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+  core_hdma_spi2_tx.Init.MemDataAlignment    = DMA_MDATAALIGN_BYTE;
+  core_hdma_spi2_tx.Init.Mode                = DMA_NORMAL;
+  core_hdma_spi2_tx.Init.Priority            = DMA_PRIORITY_MEDIUM;
+  core_hdma_spi2_tx.Init.FIFOMode            = DMA_FIFOMODE_DISABLE;
+  core_hdma_spi2_rx.Instance                 = DMA1_Stream3;
+  core_hdma_spi2_rx.Init                     = core_hdma_spi2_tx.Init;
+  core_hdma_spi2_rx.Init.Direction           = DMA_PERIPH_TO_MEMORY;
+  /* above the TX stream: a byte read late is an overrun */
+  core_hdma_spi2_rx.Init.Priority            = DMA_PRIORITY_HIGH;
+  if (HAL_OK != HAL_DMA_Init(&core_hdma_spi2_tx) ||
+      HAL_OK != HAL_DMA_Init(&core_hdma_spi2_rx))
+  {
+    LOG(LOG_LEVEL_ERR, "SPI2 DMA init failed");
+    return;
+  }
+  __HAL_LINKDMA(&core_hspi2, hdmatx, core_hdma_spi2_tx);
+  __HAL_LINKDMA(&core_hspi2, hdmarx, core_hdma_spi2_rx);
+
+  /* the end of a transfer starts the next one and notifies its task: same
+     priority as the other streams, masked by the critical sections */
+  HAL_NVIC_SetPriority(DMA1_Stream3_IRQn, 5, 0);
+  HAL_NVIC_EnableIRQ(DMA1_Stream3_IRQn);
+  HAL_NVIC_SetPriority(DMA1_Stream4_IRQn, 5, 0);
+  HAL_NVIC_EnableIRQ(DMA1_Stream4_IRQn);
+  HAL_NVIC_SetPriority(SPI2_IRQn, 5, 0);
+  HAL_NVIC_EnableIRQ(SPI2_IRQn);
+}
+
+/**
+  * @brief  SPI2 disabled, mode and the fastest clock up to max_hz, from
+  *         PCLK1 / 2 to PCLK1 / 256
+  * @param  mode: clock polarity and phase
+  * @param  max_hz: clock at most
+  * @retval spi_status_t
+  */
+static spi_status_t core_spi_configure(spi_mode_t mode, uint32_t max_hz)
+{
+  uint32_t pclk = HAL_RCC_GetPCLK1Freq();
+  uint32_t br   = 0U;                  /* PCLK1 / 2^(br + 1) */
+
+  while (br < 7U && (pclk >> (br + 1U)) > max_hz)
+  {
+    ++br;
+  }
+  core_hspi2.Init.CLKPolarity       = (0U != ((uint32_t)mode & 2U)) ?
+                                      SPI_POLARITY_HIGH : SPI_POLARITY_LOW;
+  core_hspi2.Init.CLKPhase          = (0U != ((uint32_t)mode & 1U)) ?
+                                      SPI_PHASE_2EDGE : SPI_PHASE_1EDGE;
+  core_hspi2.Init.BaudRatePrescaler = br << SPI_CR1_BR_Pos;
+
+  /* the HAL sets SPE again at the next start */
+  __HAL_SPI_DISABLE(&core_hspi2);
+  MODIFY_REG(SPI2->CR1, SPI_CR1_CPOL | SPI_CR1_CPHA | SPI_CR1_BR,
+             core_hspi2.Init.CLKPolarity | core_hspi2.Init.CLKPhase |
+             core_hspi2.Init.BaudRatePrescaler);
+  return SPI_OK;
+}
+
+/**
+  * @brief  Chip-select line low or high
+  * @param  cs: CORE_SPI_CS_*
+  * @param  active: 1 low, 0 high
+  * @retval spi_status_t
+  */
+static spi_status_t core_spi_cs(uint32_t cs, uint32_t active)
+{
+  if (CORE_SPI_CS_NUM <= cs)
+  {
+    return SPI_ERRORPARAMETER;
+  }
+  HAL_GPIO_WritePin(GPIOB, core_spi_cs_pins[cs],
+                    (0U != active) ? GPIO_PIN_RESET : GPIO_PIN_SET);
+  return SPI_OK;
+}
+
+/**
+  * @brief  Start a DMA transfer: both ways, transmit only, or receive only
+  *         (the HAL clocks the rx buffer out)
+  * @param  tx: bytes out, NULL: receive only
+  * @param  rx: bytes in, NULL: transmit only
+  * @param  len: number of bytes, 1 to SPI_XFER_MAX_BYTES
+  * @retval spi_status_t
+  */
+static spi_status_t core_spi_dma_start(const uint8_t * const tx,
+                                       uint8_t * const rx, uint32_t len)
+{
+  HAL_StatusTypeDef ret;
+
+  if (NULL == rx)
+  {
+    ret = HAL_SPI_Transmit_DMA(&core_hspi2, (uint8_t *)tx, (uint16_t)len);
+  }
+  else if (NULL == tx)
+  {
+    ret = HAL_SPI_Receive_DMA(&core_hspi2, rx, (uint16_t)len);
+  }
+  else
+  {
+    ret = HAL_SPI_TransmitReceive_DMA(&core_hspi2, (uint8_t *)tx, rx,
+                                      (uint16_t)len);
+  }
+  return (HAL_OK == ret) ? SPI_OK : SPI_ERROR;
+}
+
+/**
+  * @brief  Switch the DMA transfer off after a timeout or a cancel: the
+  *         interrupts off first, no callback after it; inside the critical
+  *         section, the tick masked, so the streams are only switched off,
+  *         core_spi_dma_reset waits for them
+  * @retval spi_status_t
+  */
+static spi_status_t core_spi_dma_stop(void)
+{
+  CLEAR_BIT(SPI2->CR2, SPI_CR2_ERRIE);
+  __HAL_DMA_DISABLE_IT(&core_hdma_spi2_tx, DMA_IT_TC | DMA_IT_TE |
+                                           DMA_IT_DME | DMA_IT_HT);
+  __HAL_DMA_DISABLE_IT(&core_hdma_spi2_rx, DMA_IT_TC | DMA_IT_TE |
+                                           DMA_IT_DME | DMA_IT_HT);
+  __HAL_DMA_DISABLE(&core_hdma_spi2_tx);
+  __HAL_DMA_DISABLE(&core_hdma_spi2_rx);
+  return SPI_OK;
+}
+
+/**
+  * @brief  Finish the abort core_spi_dma_stop began, task context: the
+  *         HAL waits for the streams, the DMA requests and SPI2 off, the
+  *         handles ready for the next start
+  * @retval spi_status_t
+  */
+static spi_status_t core_spi_dma_reset(void)
+{
+  return (HAL_OK == HAL_SPI_Abort(&core_hspi2)) ? SPI_OK : SPI_ERROR;
+}
+
+/**
+  * @brief  SPI2 transfers complete: the bus manager starts the next one
+  * @param  hspi: SPI handle
+  * @retval None
+  */
+void HAL_SPI_TxRxCpltCallback(SPI_HandleTypeDef *hspi)
+{
+  if (SPI2 == hspi->Instance)
+  {
+    spi_dma_done_isr(&core_spi, 1U);
+  }
+}
+
+void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef *hspi)
+{
+  HAL_SPI_TxRxCpltCallback(hspi);
+}
+
+void HAL_SPI_RxCpltCallback(SPI_HandleTypeDef *hspi)
+{
+  HAL_SPI_TxRxCpltCallback(hspi);
+}
+
+/**
+  * @brief  SPI2 DMA or overrun error, the transfer and its chain fail
+  * @param  hspi: SPI handle
+  * @retval None
+  */
+void HAL_SPI_ErrorCallback(SPI_HandleTypeDef *hspi)
+{
+  if (SPI2 == hspi->Instance)
+  {
+    spi_dma_done_isr(&core_spi, 0U);
+  }
+}
+#endif /* SPI_ENABLE */
+
+#ifdef WS2812_ENABLE
+/**
+  * @brief  Clock TIM3 and PA6, PWM mode 1 on channel 1 with the compare
+  *         preload on; DMA1 stream 2 from the ring to CCR1, circular
+  * @retval None
+  */
+static void core_ws2812_hw_init(void)
+{
+  GPIO_InitTypeDef   gpio = {0};
+  TIM_OC_InitTypeDef oc   = {0};
+
+  __HAL_RCC_TIM3_CLK_ENABLE();
+  __HAL_RCC_GPIOA_CLK_ENABLE();
+  __HAL_RCC_DMA1_CLK_ENABLE();
+
+  /* pulled low: the strip sees a reset while the channel is off */
+  gpio.Pin       = GPIO_PIN_6;
+  gpio.Mode      = GPIO_MODE_AF_PP;
+  gpio.Pull      = GPIO_PULLDOWN;
+  gpio.Speed     = GPIO_SPEED_FREQ_HIGH;
+  gpio.Alternate = GPIO_AF2_TIM3;
+  HAL_GPIO_Init(GPIOA, &gpio);
+
+  core_htim3.Instance               = TIM3;
+  core_htim3.Init.Prescaler         = 0;
+  core_htim3.Init.CounterMode       = TIM_COUNTERMODE_UP;
+  core_htim3.Init.Period            = 0xFFFF;   /* set at every start */
+  core_htim3.Init.ClockDivision     = TIM_CLOCKDIVISION_DIV1;
+  core_htim3.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_ENABLE;
+  oc.OCMode                         = TIM_OCMODE_PWM1;
+  oc.Pulse                          = 0;
+  oc.OCPolarity                     = TIM_OCPOLARITY_HIGH;
+  oc.OCFastMode                     = TIM_OCFAST_DISABLE;
+  if (HAL_OK != HAL_TIM_PWM_Init(&core_htim3) ||
+      HAL_OK != HAL_TIM_PWM_ConfigChannel(&core_htim3, &oc, TIM_CHANNEL_1))
+  {
+    LOG(LOG_LEVEL_ERR, "TIM3 PWM init failed");
+    return;
+  }
+
+  core_hdma_tim3_up.Instance                 = DMA1_Stream2;
+  core_hdma_tim3_up.Init.Channel             = DMA_CHANNEL_5;
+  core_hdma_tim3_up.Init.Direction           = DMA_MEMORY_TO_PERIPH;
+  core_hdma_tim3_up.Init.PeriphInc           = DMA_PINC_DISABLE;
+  core_hdma_tim3_up.Init.MemInc              = DMA_MINC_ENABLE;
+  core_hdma_tim3_up.Init.PeriphDataAlignment = DMA_PDATAALIGN_HALFWORD;
+  core_hdma_tim3_up.Init.MemDataAlignment    = DMA_MDATAALIGN_HALFWORD;
+  core_hdma_tim3_up.Init.Mode                = DMA_CIRCULAR;
+  /* a duty written after its update is a wrong bit on the strip */
+  core_hdma_tim3_up.Init.Priority            = DMA_PRIORITY_VERY_HIGH;
+  core_hdma_tim3_up.Init.FIFOMode            = DMA_FIFOMODE_DISABLE;
+  if (HAL_OK != HAL_DMA_Init(&core_hdma_tim3_up))
+  {
+    LOG(LOG_LEVEL_ERR, "TIM3 DMA init failed");
+    return;
+  }
+  __HAL_LINKDMA(&core_htim3, hdma[TIM_DMA_ID_UPDATE], core_hdma_tim3_up);
+
+  /* a half refilled in the time of the other one, 240 us for 8 LEDs: same
+     priority as the other streams, masked by the critical sections */
+  HAL_NVIC_SetPriority(DMA1_Stream2_IRQn, 5, 0);
+  HAL_NVIC_EnableIRQ(DMA1_Stream2_IRQn);
+}
+
+/**
+  * @brief  Clock of TIM3, APB1 timers run at twice PCLK1 when APB1 is
+  *         divided
+  * @retval uint32_t: Hz
+  */
+static uint32_t core_ws2812_clock_hz(void)
+{
+  uint32_t tim_clk = HAL_RCC_GetPCLK1Freq();
+
+  if (RCC_HCLK_DIV1 != (RCC->CFGR & RCC_CFGR_PPRE1))
+  {
+    tim_clk *= 2U;
+  }
+  return tim_clk;
+}
+
+/**
+  * @brief  A bit of period ticks, CCR1 low until the first update, then the
+  *         ring circular into CCR1 at every update
+  * @param  ring: duties
+  * @param  slots: in the ring
+  * @param  period: ticks of a bit
+  * @retval ws2812_status_t
+  */
+static ws2812_status_t core_ws2812_dma_start(const uint16_t * const ring,
+                                             uint32_t slots,
+                                             uint32_t period)
+{
+  __HAL_TIM_SET_AUTORELOAD(&core_htim3, period - 1U);
+  __HAL_TIM_SET_COMPARE(&core_htim3, TIM_CHANNEL_1, 0U);
+  __HAL_TIM_SET_COUNTER(&core_htim3, 0U);
+  /* load ARR and CCR1 now, before the update requests the DMA */
+  core_htim3.Instance->EGR = TIM_EGR_UG;
+
+  core_hdma_tim3_up.XferHalfCpltCallback = core_ws2812_dma_half;
+  core_hdma_tim3_up.XferCpltCallback     = core_ws2812_dma_full;
+  core_hdma_tim3_up.XferErrorCallback    = core_ws2812_dma_error;
+  if (HAL_OK != HAL_DMA_Start_IT(&core_hdma_tim3_up, (uint32_t)ring,
+                                 (uint32_t)&TIM3->CCR1, slots))
+  {
+    return WS2812_ERROR;
+  }
+  __HAL_TIM_ENABLE_DMA(&core_htim3, TIM_DMA_UPDATE);
+  return (HAL_OK == HAL_TIM_PWM_Start(&core_htim3, TIM_CHANNEL_1)) ?
+         WS2812_OK : WS2812_ERROR;
+}
+
+/**
+  * @brief  Timer and DMA stopped, the line low; from the DMA interrupt at
+  *         the end of the last frame
+  * @retval ws2812_status_t
+  */
+static ws2812_status_t core_ws2812_dma_stop(void)
+{
+  __HAL_TIM_DISABLE_DMA(&core_htim3, TIM_DMA_UPDATE);
+  (void)HAL_TIM_PWM_Stop(&core_htim3, TIM_CHANNEL_1);
+  __HAL_TIM_SET_COMPARE(&core_htim3, TIM_CHANNEL_1, 0U);
+  /* not busy after a transfer error: nothing to abort */
+  (void)HAL_DMA_Abort(&core_hdma_tim3_up);
+  return WS2812_OK;
+}
+
+/**
+  * @brief  First half of the ring sent, the strip refills it
+  * @param  hdma: DMA handle
+  * @retval None
+  */
+static void core_ws2812_dma_half(DMA_HandleTypeDef *hdma)
+{
+  (void)hdma;
+  ws2812_dma_isr(&core_ws2812, 0U);
+}
+
+/**
+  * @brief  Second half of the ring sent, the strip refills it
+  * @param  hdma: DMA handle
+  * @retval None
+  */
+static void core_ws2812_dma_full(DMA_HandleTypeDef *hdma)
+{
+  (void)hdma;
+  ws2812_dma_isr(&core_ws2812, 1U);
+}
+
+/**
+  * @brief  DMA transfer of the strip failed, the frame is dropped
+  * @param  hdma: DMA handle
+  * @retval None
+  */
+static void core_ws2812_dma_error(DMA_HandleTypeDef *hdma)
+{
+  (void)hdma;
+  ws2812_dma_isr(&core_ws2812, WS2812_DMA_ERROR);
+}
+
+/**
+  * @brief  Status pixel on, for the LED handler
+  * @retval led_inst_status_t
+  */
+static led_inst_status_t core_ws2812_led_on(void)
+{
+  return ws2812_led_set(&core_ws2812, CORE_WS2812_STATUS, CORE_WS2812_COLOR,
+                        1U);
+}
+
+/**
+  * @brief  Status pixel off, for the LED handler
+  * @retval led_inst_status_t
+  */
+static led_inst_status_t core_ws2812_led_off(void)
+{
+  return ws2812_led_set(&core_ws2812, CORE_WS2812_STATUS, CORE_WS2812_COLOR,
+                        0U);
+}
+#endif /* WS2812_ENABLE */
+
+#ifdef MATRIX_ENABLE
+/**
+  * @brief  Clock SPI1, TIM4 and the pins: SPI1 transmit only at PCLK2 / 4,
+  *         the latch low; TIM4 ticking at CORE_MATRIX_TICK_HZ with its
+  *         period preloaded, the outputs blank
+  * @retval None
+  */
+static void core_matrix_hw_init(void)
+{
+  GPIO_InitTypeDef gpio = {0};
+
+  __HAL_RCC_SPI1_CLK_ENABLE();
+  __HAL_RCC_TIM4_CLK_ENABLE();
+  __HAL_RCC_GPIOA_CLK_ENABLE();
+  __HAL_RCC_GPIOB_CLK_ENABLE();
+
+  HAL_GPIO_WritePin(GPIOB, GPIO_PIN_0, GPIO_PIN_RESET);
+  gpio.Pin   = GPIO_PIN_0;
+  gpio.Mode  = GPIO_MODE_OUTPUT_PP;
+  gpio.Pull  = GPIO_NOPULL;
+  gpio.Speed = GPIO_SPEED_FREQ_HIGH;
+  HAL_GPIO_Init(GPIOB, &gpio);
+
+  /* no MISO: PA6 is the WS2812 channel */
+  gpio.Pin       = GPIO_PIN_5 | GPIO_PIN_7;
+  gpio.Mode      = GPIO_MODE_AF_PP;
+  gpio.Speed     = GPIO_SPEED_FREQ_VERY_HIGH;
+  gpio.Alternate = GPIO_AF5_SPI1;
+  HAL_GPIO_Init(GPIOA, &gpio);
+
+  core_hspi1.Instance               = SPI1;
+  core_hspi1.Init.Mode              = SPI_MODE_MASTER;
+  core_hspi1.Init.Direction         = SPI_DIRECTION_1LINE;
+  core_hspi1.Init.DataSize          = SPI_DATASIZE_8BIT;
+  core_hspi1.Init.CLKPolarity       = SPI_POLARITY_LOW;
+  core_hspi1.Init.CLKPhase          = SPI_PHASE_1EDGE;
+  core_hspi1.Init.NSS               = SPI_NSS_SOFT;
+  /* 25 MHz at 100 MHz, the 74HC595 shifts up to 25 MHz at 3.3 V */
+  core_hspi1.Init.BaudRatePrescaler = SPI_BAUDRATEPRESCALER_4;
+  core_hspi1.Init.FirstBit          = SPI_FIRSTBIT_MSB;
+  core_hspi1.Init.TIMode            = SPI_TIMODE_DISABLE;
+  core_hspi1.Init.CRCCalculation    = SPI_CRCCALCULATION_DISABLE;
+  core_hspi1.Init.CRCPolynomial     = 10;
+  if (HAL_OK != HAL_SPI_Init(&core_hspi1))
+  {
+    LOG(LOG_LEVEL_ERR, "SPI1 init failed");
+    return;
+  }
+  /* the interrupt writes the data register itself: output, enabled */
+  SET_BIT(SPI1->CR1, SPI_CR1_BIDIOE);
+  __HAL_SPI_ENABLE(&core_hspi1);
+
+  /* the prescaler of the clock of now, a profile change moves the tick:
+     core_matrix_clock_hz reads it back at every show */
+  core_htim4.Instance               = TIM4;
+  core_htim4.Init.Prescaler         = (core_matrix_tim_clock() +
+                                       CORE_MATRIX_TICK_HZ / 2U) /
+                                      CORE_MATRIX_TICK_HZ - 1U;
+  core_htim4.Init.CounterMode       = TIM_COUNTERMODE_UP;
+  core_htim4.Init.Period            = 0xFFFF;   /* preloaded every slot */
+  core_htim4.Init.ClockDivision     = TIM_CLOCKDIVISION_DIV1;
+  core_htim4.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_ENABLE;
+  if (HAL_OK != HAL_TIM_Base_Init(&core_htim4))
+  {
+    LOG(LOG_LEVEL_ERR, "TIM4 init failed");
+    return;
+  }
+  core_matrix_stop();
+
+  /* a slot of 20 us at least: same priority as the other streams, masked
+     by the critical sections */
+  HAL_NVIC_SetPriority(TIM4_IRQn, 5, 0);
+  HAL_NVIC_EnableIRQ(TIM4_IRQn);
+}
+
+/**
+  * @brief  Clock of TIM4, APB1 timers run at twice PCLK1 when APB1 is
+  *         divided
+  * @retval uint32_t: Hz
+  */
+static uint32_t core_matrix_tim_clock(void)
+{
+  uint32_t tim_clk = HAL_RCC_GetPCLK1Freq();
+
+  if (RCC_HCLK_DIV1 != (RCC->CFGR & RCC_CFGR_PPRE1))
+  {
+    tim_clk *= 2U;
+  }
+  return tim_clk;
+}
+
+/**
+  * @brief  Ticks of TIM4 a second, after its prescaler
+  * @retval uint32_t: Hz
+  */
+static uint32_t core_matrix_clock_hz(void)
+{
+  return core_matrix_tim_clock() / (TIM4->PSC + 1U);
+}
+
+/**
+  * @brief  Bytes out of SPI1 into the chain, from the interrupt: waits for
+  *         room in the data register only, the last byte shifts out while
+  *         the slot runs
+  * @param  bytes: the first one ends at the far end of the chain
+  * @retval None
+  */
+static void core_matrix_shift(const uint8_t * const bytes)
+{
+  for (uint32_t i = 0; i < CORE_MATRIX_CHAIN; ++i)
+  {
+    while (0U == (SPI1->SR & SPI_SR_TXE))
+    {
+    }
+    *(volatile uint8_t *)&SPI1->DR = bytes[i];
+  }
+}
+
+/**
+  * @brief  The chain to its outputs: a pulse on PB0 once the last byte is
+  *         out
+  * @retval None
+  */
+static void core_matrix_latch(void)
+{
+  while (0U != (SPI1->SR & SPI_SR_BSY))
+  {
+  }
+  GPIOB->BSRR = GPIO_PIN_0;
+  GPIOB->BSRR = (uint32_t)GPIO_PIN_0 << 16U;
+}
+
+/**
+  * @brief  The pattern of a row into the chain, the length of its slot
+  *         preloaded: TIM4 loads it at the update that latches the pattern
+  * @param  row: 0 .. CORE_MATRIX_ROWS - 1, its driver on
+  * @param  cols: column bits, column 0 the MSB of the first byte
+  * @param  ticks: of the slot
+  * @retval None
+  */
+static void core_matrix_next(uint32_t row, const uint8_t * const cols,
+                             uint32_t ticks)
+{
+  uint8_t  chain[CORE_MATRIX_CHAIN];
+  uint32_t sel = 1UL << row;
+
+  TIM4->ARR = ticks - 1U;
+  /* rows 15 .. 8, rows 7 .. 0 to the far end, then the columns */
+  chain[0] = (uint8_t)(sel >> 8);
+  chain[1] = (uint8_t)sel;
+  chain[2] = cols[0];
+  chain[3] = cols[1];
+  core_matrix_shift(chain);
+}
+
+/**
+  * @brief  TIM4 from 0 with the preloaded period, its first update latches
+  *         the pattern shifted
+  * @retval matrix_status_t
+  */
+static matrix_status_t core_matrix_start(void)
+{
+  __HAL_TIM_SET_COUNTER(&core_htim4, 0U);
+  /* load ARR now; the update flag it sets is no slot */
+  core_htim4.Instance->EGR = TIM_EGR_UG;
+  __HAL_TIM_CLEAR_FLAG(&core_htim4, TIM_FLAG_UPDATE);
+  return (HAL_OK == HAL_TIM_Base_Start_IT(&core_htim4)) ?
+         MATRIX_OK : MATRIX_ERROR;
+}
+
+/**
+  * @brief  TIM4 stopped, every row and column off
+  * @retval matrix_status_t
+  */
+static matrix_status_t core_matrix_stop(void)
+{
+  static const uint8_t blank[CORE_MATRIX_CHAIN] = {0};
+
+  (void)HAL_TIM_Base_Stop_IT(&core_htim4);
+  core_matrix_shift(blank);
+  core_matrix_latch();
+  return MATRIX_OK;
+}
+
+/**
+  * @brief  TIM4 update, from TIM4_IRQHandler: straight to the scan, not
+  *         through HAL_TIM_IRQHandler, 8000 times a second
+  * @retval None
+  */
+void core_matrix_tim_isr(void)
+{
+  if (0U != (TIM4->SR & TIM_SR_UIF))
+  {
+    TIM4->SR = ~TIM_SR_UIF;
+    matrix_timer_isr(&core_matrix);
+  }
+}
+#endif /* MATRIX_ENABLE */
+
+#ifdef I2C_ENABLE
+/**
+  * @brief  Clock I2C1 and PB6, PB7 as open-drain with pull-ups, master at
+  *         CORE_I2C_HZ; DMA1 stream 0 from its data register, stream 6 to
+  *         it
+  * @retval None
+  */
+static void core_i2c_hw_init(void)
+{
+  GPIO_InitTypeDef gpio = {0};
+
+  __HAL_RCC_I2C1_CLK_ENABLE();
+  __HAL_RCC_GPIOB_CLK_ENABLE();
+  __HAL_RCC_DMA1_CLK_ENABLE();
+
+  gpio.Pin       = GPIO_PIN_6 | GPIO_PIN_7;
+  gpio.Mode      = GPIO_MODE_AF_OD;
+  gpio.Pull      = GPIO_PULLUP;
+  gpio.Speed     = GPIO_SPEED_FREQ_VERY_HIGH;
+  gpio.Alternate = GPIO_AF4_I2C1;
+  HAL_GPIO_Init(GPIOB, &gpio);
+
+  core_hi2c1.Instance             = I2C1;
+  core_hi2c1.Init.ClockSpeed      = CORE_I2C_HZ;
+  core_hi2c1.Init.DutyCycle       = I2C_DUTYCYCLE_2;
+  core_hi2c1.Init.OwnAddress1     = 0U;
+  core_hi2c1.Init.AddressingMode  = I2C_ADDRESSINGMODE_7BIT;
+  core_hi2c1.Init.DualAddressMode = I2C_DUALADDRESS_DISABLE;
+  core_hi2c1.Init.OwnAddress2     = 0U;
+  core_hi2c1.Init.GeneralCallMode = I2C_GENERALCALL_DISABLE;
+  core_hi2c1.Init.NoStretchMode   = I2C_NOSTRETCH_DISABLE;
+  if (HAL_OK != HAL_I2C_Init(&core_hi2c1))
+  {
+    LOG(LOG_LEVEL_ERR, "I2C1 init failed");
+    return;
+  }
+
+  core_hdma_i2c1_rx.Instance                 = DMA1_Stream0;
+  core_hdma_i2c1_rx.Init.Channel             = DMA_CHANNEL_1;
+  core_hdma_i2c1_rx.Init.Direction           = DMA_PERIPH_TO_MEMORY;
+  core_hdma_i2c1_rx.Init.PeriphInc           = DMA_PINC_DISABLE;
+  core_hdma_i2c1_rx.Init.MemInc              = DMA_MINC_ENABLE;
+  core_hdma_i2c1_rx.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+  core_hdma_i2c1_rx.Init.MemDataAlignment    = DMA_MDATAALIGN_BYTE;
+  core_hdma_i2c1_rx.Init.Mode                = DMA_NORMAL;
+  core_hdma_i2c1_rx.Init.Priority            = DMA_PRIORITY_MEDIUM;
+  core_hdma_i2c1_rx.Init.FIFOMode            = DMA_FIFOMODE_DISABLE;
+  core_hdma_i2c1_tx.Instance                 = DMA1_Stream6;
+  core_hdma_i2c1_tx.Init                     = core_hdma_i2c1_rx.Init;
+  core_hdma_i2c1_tx.Init.Direction           = DMA_MEMORY_TO_PERIPH;
+  if (HAL_OK != HAL_DMA_Init(&core_hdma_i2c1_rx) ||
+      HAL_OK != HAL_DMA_Init(&core_hdma_i2c1_tx))
+  {
+    LOG(LOG_LEVEL_ERR, "I2C1 DMA init failed");
+    return;
+  }
+  __HAL_LINKDMA(&core_hi2c1, hdmarx, core_hdma_i2c1_rx);
+  __HAL_LINKDMA(&core_hi2c1, hdmatx, core_hdma_i2c1_tx);
+
+  /* the end of a transaction starts the next one and notifies its task:
+     same priority as the other streams, masked by the critical sections */
+  HAL_NVIC_SetPriority(DMA1_Stream0_IRQn, 5, 0);
+  HAL_NVIC_EnableIRQ(DMA1_Stream0_IRQn);
+  HAL_NVIC_SetPriority(DMA1_Stream6_IRQn, 5, 0);
+  HAL_NVIC_EnableIRQ(DMA1_Stream6_IRQn);
+  HAL_NVIC_SetPriority(I2C1_EV_IRQn, 5, 0);
+  HAL_NVIC_EnableIRQ(I2C1_EV_IRQn);
+  HAL_NVIC_SetPriority(I2C1_ER_IRQn, 5, 0);
+  HAL_NVIC_EnableIRQ(I2C1_ER_IRQn);
+}
+
+/**
+  * @brief  Service of core_i2c: i2c_poll when the bus signals it and when
+  *         the time it returned has passed, I2C_POLL_IDLE blocks
+  * @param  argument: Not used
+  * @retval None
+  */
+static void core_i2c_task(void *argument)
+{
+  uint32_t wait;
+  uint32_t bits;
+
+  (void)argument;
+  for (;;)
+  {
+    wait = i2c_poll(&core_i2c, (uint32_t)time_get_ms());
+    signal_wait(&core_i2c_signal, CORE_I2C_EVENT, wait, &bits);
+  }
+}
+
+/**
+  * @brief  Busy wait of CORE_I2C_RECOVER_US, the pulses of the recovery
+  * @retval None
+  */
+static void core_i2c_half_bit(void)
+{
+  uint64_t start = time_get_us();
+
+  while (time_get_us() - start < CORE_I2C_RECOVER_US)
+  {
+  }
+}
+
+/**
+  * @brief  Start a transaction: with a register, the memory read or write
+  *         of the HAL, sequenced by I2C1_EV byte by byte; without, a plain
+  *         receive or transmit by DMA. Runs from i2c_done_isr and inside
+  *         the critical section, the tick masked: nothing here waits, a
+  *         bus seen busy refuses the start before the HAL spins on it, and
+  *         a NACK comes back through I2C1_ER
+  * @param  addr: 7-bit address
+  * @param  reg: register, reg_len bytes, MSB first
+  * @param  reg_len: 0 to I2C_REG_MAX_BYTES
+  * @param  dir: I2C_DIR_READ or I2C_DIR_WRITE
+  * @param  data: bytes read or written
+  * @param  len: number of bytes, 1 to I2C_XFER_MAX_BYTES
+  * @retval i2c_status_t
+  */
+static i2c_status_t core_i2c_start(uint8_t addr, uint16_t reg,
+                                   uint32_t reg_len, i2c_dir_t dir,
+                                   uint8_t * const data, uint32_t len)
+{
+  uint16_t          dev  = (uint16_t)((uint16_t)addr << 1);
+  uint16_t          size = (1U == reg_len) ? I2C_MEMADD_SIZE_8BIT :
+                                             I2C_MEMADD_SIZE_16BIT;
+  HAL_StatusTypeDef ret;
+
+  if (RESET != __HAL_I2C_GET_FLAG(&core_hi2c1, I2C_FLAG_BUSY))
+  {
+    return I2C_ERROR;
+  }
+  if (0U == reg_len)
+  {
+    ret = (I2C_DIR_READ == dir) ?
+          HAL_I2C_Master_Receive_DMA(&core_hi2c1, dev, data, (uint16_t)len) :
+          HAL_I2C_Master_Transmit_DMA(&core_hi2c1, dev, data, (uint16_t)len);
+  }
+  else
+  {
+    ret = (I2C_DIR_READ == dir) ?
+          HAL_I2C_Mem_Read_IT(&core_hi2c1, dev, reg, size, data,
+                              (uint16_t)len) :
+          HAL_I2C_Mem_Write_IT(&core_hi2c1, dev, reg, size, data,
+                               (uint16_t)len);
+  }
+  return (HAL_OK == ret) ? I2C_OK : I2C_ERROR;
+}
+
+/**
+  * @brief  Abort the transaction running after a timeout or a cancel: the
+  *         interrupts off first, no callback after it; inside the critical
+  *         section, so the streams are only switched off, the recovery that
+  *         follows waits for them and sets I2C1 up again
+  * @retval i2c_status_t
+  */
+static i2c_status_t core_i2c_abort(void)
+{
+  __HAL_I2C_DISABLE_IT(&core_hi2c1, I2C_IT_EVT | I2C_IT_BUF | I2C_IT_ERR);
+  CLEAR_BIT(I2C1->CR2, I2C_CR2_DMAEN | I2C_CR2_LAST);
+  __HAL_DMA_DISABLE_IT(&core_hdma_i2c1_rx, DMA_IT_TC | DMA_IT_TE |
+                                           DMA_IT_DME | DMA_IT_HT);
+  __HAL_DMA_DISABLE_IT(&core_hdma_i2c1_tx, DMA_IT_TC | DMA_IT_TE |
+                                           DMA_IT_DME | DMA_IT_HT);
+  __HAL_DMA_DISABLE(&core_hdma_i2c1_rx);
+  __HAL_DMA_DISABLE(&core_hdma_i2c1_tx);
+  SET_BIT(I2C1->CR1, I2C_CR1_STOP);
+  HAL_NVIC_ClearPendingIRQ(I2C1_ER_IRQn);
+  core_hi2c1.State = HAL_I2C_STATE_READY;
+  core_hi2c1.Mode  = HAL_I2C_MODE_NONE;
+  return I2C_OK;
+}
+
+/**
+  * @brief  Free the bus: the streams of an abort stopped, SCL pulsed by
+  *         hand until the device holding SDA low lets it go, 9 clocks at
+  *         most, a STOP; then I2C1 reset, its BUSY flag stuck from the
+  *         pins, and set up again
+  * @retval i2c_status_t: I2C_ERROR when SDA or SCL is still low
+  */
+static i2c_status_t core_i2c_recover(void)
+{
+  GPIO_InitTypeDef gpio = {0};
+  uint32_t         free;
+
+  (void)HAL_DMA_Abort(&core_hdma_i2c1_rx);
+  (void)HAL_DMA_Abort(&core_hdma_i2c1_tx);
+  (void)HAL_I2C_DeInit(&core_hi2c1);
+  HAL_GPIO_WritePin(GPIOB, GPIO_PIN_6 | GPIO_PIN_7, GPIO_PIN_SET);
+  gpio.Pin   = GPIO_PIN_6 | GPIO_PIN_7;
+  gpio.Mode  = GPIO_MODE_OUTPUT_OD;
+  gpio.Pull  = GPIO_PULLUP;
+  gpio.Speed = GPIO_SPEED_FREQ_LOW;
+  HAL_GPIO_Init(GPIOB, &gpio);
+  core_i2c_half_bit();
+
+  for (uint32_t i = 0; i < 9U &&
+       GPIO_PIN_RESET == HAL_GPIO_ReadPin(GPIOB, GPIO_PIN_7); ++i)
+  {
+    HAL_GPIO_WritePin(GPIOB, GPIO_PIN_6, GPIO_PIN_RESET);
+    core_i2c_half_bit();
+    HAL_GPIO_WritePin(GPIOB, GPIO_PIN_6, GPIO_PIN_SET);
+    core_i2c_half_bit();
+  }
+
+  /* STOP: SDA rises while SCL is high */
+  HAL_GPIO_WritePin(GPIOB, GPIO_PIN_6, GPIO_PIN_RESET);
+  core_i2c_half_bit();
+  HAL_GPIO_WritePin(GPIOB, GPIO_PIN_7, GPIO_PIN_RESET);
+  core_i2c_half_bit();
+  HAL_GPIO_WritePin(GPIOB, GPIO_PIN_6, GPIO_PIN_SET);
+  core_i2c_half_bit();
+  HAL_GPIO_WritePin(GPIOB, GPIO_PIN_7, GPIO_PIN_SET);
+  core_i2c_half_bit();
+  free = (GPIO_PIN_SET == HAL_GPIO_ReadPin(GPIOB, GPIO_PIN_6) &&
+          GPIO_PIN_SET == HAL_GPIO_ReadPin(GPIOB, GPIO_PIN_7)) ? 1U : 0U;
+
+  gpio.Mode      = GPIO_MODE_AF_OD;
+  gpio.Speed     = GPIO_SPEED_FREQ_VERY_HIGH;
+  gpio.Alternate = GPIO_AF4_I2C1;
+  HAL_GPIO_Init(GPIOB, &gpio);
+  __HAL_RCC_I2C1_FORCE_RESET();
+  __HAL_RCC_I2C1_RELEASE_RESET();
+  if (HAL_OK != HAL_I2C_Init(&core_hi2c1) || 0U == free)
+  {
+    return I2C_ERROR;
+  }
+  return I2C_OK;
+}
+
+/**
+  * @brief  I2C1 error, from I2C1_ER_IRQHandler: NACK of any phase and bus
+  *         errors, through HAL_I2C_ErrorCallback
+  * @retval None
+  */
+void core_i2c_er_isr(void)
+{
+  HAL_I2C_ER_IRQHandler(&core_hi2c1);
+}
+
+/**
+  * @brief  I2C1 transactions complete, STOP sent: the bus manager starts
+  *         the next one
+  * @param  hi2c: I2C handle
+  * @retval None
+  */
+void HAL_I2C_MemRxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+  if (I2C1 == hi2c->Instance)
+  {
+    i2c_done_isr(&core_i2c, I2C_EVENT_DONE);
+  }
+}
+
+void HAL_I2C_MemTxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+  HAL_I2C_MemRxCpltCallback(hi2c);
+}
+
+void HAL_I2C_MasterRxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+  HAL_I2C_MemRxCpltCallback(hi2c);
+}
+
+void HAL_I2C_MasterTxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+  HAL_I2C_MemRxCpltCallback(hi2c);
+}
+
+/**
+  * @brief  I2C1 NACK, the HAL sent the STOP; anything else, bus error,
+  *         arbitration lost, DMA, leaves the bus to be freed
+  * @param  hi2c: I2C handle
+  * @retval None
+  */
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c)
+{
+  if (I2C1 == hi2c->Instance)
+  {
+    i2c_done_isr(&core_i2c, (HAL_I2C_ERROR_AF == hi2c->ErrorCode) ?
+                            I2C_EVENT_NACK : I2C_EVENT_BUS);
+  }
+}
+#endif /* I2C_ENABLE */
+
+/**
+  * @brief  Called by the kernel when a task overflowed its stack
+  *         (configCHECK_FOR_STACK_OVERFLOW).
+  * @param  xTask: handle of the faulty task
+  * @param  pcTaskName: name of the faulty task
+  * @retval None
+  */
+void vApplicationStackOverflowHook(TaskHandle_t xTask, char *pcTaskName)
+{
+  (void)xTask;
+  LOG(LOG_LEVEL_ERR, "Stack overflow in %s", pcTaskName);
+  /* pcTaskName is still the running task, the record names it */
+  crash_capture(CRASH_STACK_OVERFLOW, CRASH_CALLER());
+}
 
 /* USER CODE END Application */
 
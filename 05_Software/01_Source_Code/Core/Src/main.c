@@ -19,12 +19,18 @@
 /* Includes ------------------------------------------------------------------*/
 #include "main.h"
 #include "cmsis_os.h"
+#include "adc.h"
+#include "dma.h"
+#include "tim.h"
 #include "usart.h"
 #include "gpio.h"
 
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
 #include "stdio.h"
+#include "bsp_time.h"
+#include "bsp_clock.h"
+#include "bsp_crash.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -84,6 +90,10 @@ int main(void)
   SystemClock_Config();
 
   /* USER CODE BEGIN SysInit */
+  /* the time service first: the profile change rebases its microseconds */
+  time_init();
+  /* HSE, 100 MHz and ART; stays on the HSI clocks above when HSE is missing */
+  clock_profile_apply(CLOCK_PROFILE_PERFORMANCE);
 
   /* USER CODE END SysInit */
 
@@ -91,6 +101,19 @@ int main(void)
   MX_GPIO_Init();
   MX_USART1_UART_Init();
   /* USER CODE BEGIN 2 */
+  clock_listener_register(MX_USART1_ClockChanged);
+#ifdef DSP_PIPELINE_ENABLE
+  /* ADC1 paced by TIM2 into DMA2 stream 0: clocked only for the pipeline,
+     their calls are not generated (functionlistsort of the .ioc) */
+  MX_DMA_Init();
+  MX_ADC1_Init();
+  MX_TIM2_Init();
+  clock_listener_register(MX_TIM2_ClockChanged);
+  MX_TIM2_ClockChanged(SystemCoreClock);
+#endif /* DSP_PIPELINE_ENABLE */
+  /* record of the crash before this reset, if any */
+  crash_report();
+  crash_init();
 
   /* USER CODE END 2 */
 
@@ -184,6 +207,10 @@ void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim)
     HAL_IncTick();
   }
   /* USER CODE BEGIN Callback 1 */
+  if (htim->Instance == TIM1)
+  {
+    time_tick_isr();
+  }
 
   /* USER CODE END Callback 1 */
 }
@@ -196,10 +223,8 @@ void Error_Handler(void)
 {
   /* USER CODE BEGIN Error_Handler_Debug */
   /* User can add his own implementation to report the HAL error return state */
-  __disable_irq();
-  while (1)
-  {
-  }
+  /* post-mortem record of the caller, reported after the reset */
+  crash_capture(CRASH_ERROR_HANDLER, CRASH_CALLER());
   /* USER CODE END Error_Handler_Debug */
 }
 
@@ -55,9 +55,34 @@
 /* USER CODE END 0 */
 
 /* External variables --------------------------------------------------------*/
+extern DMA_HandleTypeDef hdma_adc1;
 extern TIM_HandleTypeDef htim1;
 
 /* USER CODE BEGIN EV */
+#ifdef CRC_ENABLE
+extern DMA_HandleTypeDef core_hdma_crc;
+#endif /* CRC_ENABLE */
+#ifdef FW_UPDATE_ENABLE
+extern DMA_HandleTypeDef  core_hdma_usart1_rx;
+extern UART_HandleTypeDef huart1;
+#endif /* FW_UPDATE_ENABLE */
+#ifdef SPI_ENABLE
+extern SPI_HandleTypeDef core_hspi2;
+extern DMA_HandleTypeDef core_hdma_spi2_tx;
+extern DMA_HandleTypeDef core_hdma_spi2_rx;
+#endif /* SPI_ENABLE */
+#ifdef WS2812_ENABLE
+extern DMA_HandleTypeDef core_hdma_tim3_up;
+#endif /* WS2812_ENABLE */
+#ifdef MATRIX_ENABLE
+extern void core_matrix_tim_isr(void);
+#endif /* MATRIX_ENABLE */
+#ifdef I2C_ENABLE
+extern I2C_HandleTypeDef core_hi2c1;
+extern DMA_HandleTypeDef core_hdma_i2c1_rx;
+extern DMA_HandleTypeDef core_hdma_i2c1_tx;
+extern void core_i2c_er_isr(void);
+#endif /* I2C_ENABLE */
 
 /* USER CODE END EV */
 
@@ -80,99 +105,182 @@ void NMI_Handler(void)
 }
 
 /**
-  * @brief This function handles Hard fault interrupt.
+  * @brief This function handles Debug monitor.
   */
-void HardFault_Handler(void)
+void DebugMon_Handler(void)
 {
-  /* USER CODE BEGIN HardFault_IRQn 0 */
+  /* USER CODE BEGIN DebugMonitor_IRQn 0 */
 
-  /* USER CODE END HardFault_IRQn 0 */
-  while (1)
-  {
-    /* USER CODE BEGIN W1_HardFault_IRQn 0 */
-    /* USER CODE END W1_HardFault_IRQn 0 */
-  }
+  /* USER CODE END DebugMonitor_IRQn 0 */
+  /* USER CODE BEGIN DebugMonitor_IRQn 1 */
+
+  /* USER CODE END DebugMonitor_IRQn 1 */
 }
 
+/******************************************************************************/
+/* STM32F4xx Peripheral Interrupt Handlers                                    */
+/* Add here the Interrupt Handlers for the used peripherals.                  */
+/* For the available peripheral interrupt handler names,                      */
+/* please refer to the startup file (startup_stm32f4xx.s).                    */
+/******************************************************************************/
+
 /**
-  * @brief This function handles Memory management fault.
+  * @brief This function handles EXTI line0 interrupt.
   */
-void MemManage_Handler(void)
+void EXTI0_IRQHandler(void)
 {
-  /* USER CODE BEGIN MemoryManagement_IRQn 0 */
+  /* USER CODE BEGIN EXTI0_IRQn 0 */
 
-  /* USER CODE END MemoryManagement_IRQn 0 */
-  while (1)
-  {
-    /* USER CODE BEGIN W1_MemoryManagement_IRQn 0 */
-    /* USER CODE END W1_MemoryManagement_IRQn 0 */
-  }
+  /* USER CODE END EXTI0_IRQn 0 */
+  HAL_GPIO_EXTI_IRQHandler(KEY_Pin);
+  /* USER CODE BEGIN EXTI0_IRQn 1 */
+
+  /* USER CODE END EXTI0_IRQn 1 */
 }
 
 /**
-  * @brief This function handles Pre-fetch fault, memory access fault.
+  * @brief This function handles TIM1 update interrupt and TIM10 global interrupt.
   */
-void BusFault_Handler(void)
+void TIM1_UP_TIM10_IRQHandler(void)
 {
-  /* USER CODE BEGIN BusFault_IRQn 0 */
+  /* USER CODE BEGIN TIM1_UP_TIM10_IRQn 0 */
 
-  /* USER CODE END BusFault_IRQn 0 */
-  while (1)
-  {
-    /* USER CODE BEGIN W1_BusFault_IRQn 0 */
-    /* USER CODE END W1_BusFault_IRQn 0 */
-  }
+  /* USER CODE END TIM1_UP_TIM10_IRQn 0 */
+  HAL_TIM_IRQHandler(&htim1);
+  /* USER CODE BEGIN TIM1_UP_TIM10_IRQn 1 */
+
+  /* USER CODE END TIM1_UP_TIM10_IRQn 1 */
 }
 
 /**
-  * @brief This function handles Undefined instruction or illegal state.
+  * @brief This function handles DMA2 stream0 global interrupt.
   */
-void UsageFault_Handler(void)
+void DMA2_Stream0_IRQHandler(void)
 {
-  /* USER CODE BEGIN UsageFault_IRQn 0 */
+  /* USER CODE BEGIN DMA2_Stream0_IRQn 0 */
 
-  /* USER CODE END UsageFault_IRQn 0 */
-  while (1)
-  {
-    /* USER CODE BEGIN W1_UsageFault_IRQn 0 */
-    /* USER CODE END W1_UsageFault_IRQn 0 */
-  }
+  /* USER CODE END DMA2_Stream0_IRQn 0 */
+  HAL_DMA_IRQHandler(&hdma_adc1);
+  /* USER CODE BEGIN DMA2_Stream0_IRQn 1 */
+
+  /* USER CODE END DMA2_Stream0_IRQn 1 */
 }
 
+/* USER CODE BEGIN 1 */
+#ifdef CRC_ENABLE
 /**
-  * @brief This function handles Debug monitor.
+  * @brief This function handles DMA2 stream4 global interrupt, the CRC
+  *        service feeding the CRC unit.
   */
-void DebugMon_Handler(void)
+void DMA2_Stream4_IRQHandler(void)
 {
-  /* USER CODE BEGIN DebugMonitor_IRQn 0 */
+  HAL_DMA_IRQHandler(&core_hdma_crc);
+}
+#endif /* CRC_ENABLE */
 
-  /* USER CODE END DebugMonitor_IRQn 0 */
-  /* USER CODE BEGIN DebugMonitor_IRQn 1 */
+#ifdef FW_UPDATE_ENABLE
+/**
+  * @brief This function handles DMA2 stream2 global interrupt, USART1
+  *        reception into the ring of the firmware receiver.
+  */
+void DMA2_Stream2_IRQHandler(void)
+{
+  HAL_DMA_IRQHandler(&core_hdma_usart1_rx);
+}
 
-  /* USER CODE END DebugMonitor_IRQn 1 */
+/**
+  * @brief This function handles USART1 global interrupt, the idle line and
+  *        the line errors of the firmware link.
+  */
+void USART1_IRQHandler(void)
+{
+  HAL_UART_IRQHandler(&huart1);
 }
+#endif /* FW_UPDATE_ENABLE */
 
-/******************************************************************************/
-/* STM32F4xx Peripheral Interrupt Handlers                                    */
-/* Add here the Interrupt Handlers for the used peripherals.                  */
-/* For the available peripheral interrupt handler names,                      */
-/* please refer to the startup file (startup_stm32f4xx.s).                    */
-/******************************************************************************/
+#ifdef SPI_ENABLE
+/**
+  * @brief This function handles DMA1 stream3 global interrupt, SPI2
+  *        reception of the SPI bus manager.
+  */
+void DMA1_Stream3_IRQHandler(void)
+{
+  HAL_DMA_IRQHandler(&core_hdma_spi2_rx);
+}
 
 /**
-  * @brief This function handles TIM1 update interrupt and TIM10 global interrupt.
+  * @brief This function handles DMA1 stream4 global interrupt, SPI2
+  *        transmission of the SPI bus manager.
   */
-void TIM1_UP_TIM10_IRQHandler(void)
+void DMA1_Stream4_IRQHandler(void)
 {
-  /* USER CODE BEGIN TIM1_UP_TIM10_IRQn 0 */
+  HAL_DMA_IRQHandler(&core_hdma_spi2_tx);
+}
 
-  /* USER CODE END TIM1_UP_TIM10_IRQn 0 */
-  HAL_TIM_IRQHandler(&htim1);
-  /* USER CODE BEGIN TIM1_UP_TIM10_IRQn 1 */
+/**
+  * @brief This function handles SPI2 global interrupt, the errors during
+  *        a DMA transfer.
+  */
+void SPI2_IRQHandler(void)
+{
+  HAL_SPI_IRQHandler(&core_hspi2);
+}
+#endif /* SPI_ENABLE */
+#ifdef WS2812_ENABLE
+/**
+  * @brief This function handles DMA1 stream2 global interrupt, TIM3 update
+  *        duties of the WS2812 strip.
+  */
+void DMA1_Stream2_IRQHandler(void)
+{
+  HAL_DMA_IRQHandler(&core_hdma_tim3_up);
+}
+#endif /* WS2812_ENABLE */
+#ifdef MATRIX_ENABLE
+/**
+  * @brief This function handles TIM4 global interrupt, a slot of the LED
+  *        matrix scan.
+  */
+void TIM4_IRQHandler(void)
+{
+  core_matrix_tim_isr();
+}
+#endif /* MATRIX_ENABLE */
+#ifdef I2C_ENABLE
+/**
+  * @brief This function handles DMA1 stream0 global interrupt, I2C1
+  *        reception of the I2C bus manager.
+  */
+void DMA1_Stream0_IRQHandler(void)
+{
+  HAL_DMA_IRQHandler(&core_hdma_i2c1_rx);
+}
 
-  /* USER CODE END TIM1_UP_TIM10_IRQn 1 */
+/**
+  * @brief This function handles DMA1 stream6 global interrupt, I2C1
+  *        transmission of the I2C bus manager.
+  */
+void DMA1_Stream6_IRQHandler(void)
+{
+  HAL_DMA_IRQHandler(&core_hdma_i2c1_tx);
 }
 
-/* USER CODE BEGIN 1 */
+/**
+  * @brief This function handles I2C1 event interrupt, the address and
+  *        STOP phases around the DMA, every byte of a register transaction.
+  */
+void I2C1_EV_IRQHandler(void)
+{
+  HAL_I2C_EV_IRQHandler(&core_hi2c1);
+}
+
+/**
+  * @brief This function handles I2C1 error interrupt, NACK and bus errors.
+  */
+void I2C1_ER_IRQHandler(void)
+{
+  core_i2c_er_isr();
+}
+#endif /* I2C_ENABLE */
 
 /* USER CODE END 1 */
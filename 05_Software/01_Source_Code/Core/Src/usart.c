@@ -110,6 +110,21 @@ void HAL_UART_MspDeInit(UART_HandleTypeDef* uartHandle)
 }
 
 /* USER CODE BEGIN 1 */
+
+/**
+  * @brief  Recompute the USART1 BRR after a clock profile change
+  * @note   The handle is READY, so HAL_UART_Init does not run the MSP again
+  * @param  core_clock_hz: new SystemCoreClock, the BRR comes from PCLK2
+  * @retval None
+  */
+void MX_USART1_ClockChanged(uint32_t core_clock_hz)
+{
+  (void)core_clock_hz;
+  if (HAL_UART_Init(&huart1) != HAL_OK)
+  {
+    Error_Handler();
+  }
+}
  
  #ifdef __GNUC__
      #define PUTCHAR_PROTOTYPE int _io_putchar(int ch)
@@ -0,0 +1,268 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+###############################################################################
+# Copyright (C) 2025 Damian.
+#
+# All Rights Reserved.
+#
+# @file crash_decode.py
+#
+# @brief Decode the crash record bsp_crash.c prints on the boot after a
+#        fault and symbolize it against the image.
+#
+# The log is the serial output, every "crash,<key>,<value>" line between
+# "# crash" and "# crash end" belongs to one record, other lines are
+# skipped. Per record the tool prints the fault type and task, the fault
+# status bits of CFSR / HFSR with the fault address where it is valid, the
+# stacked registers and the stack snapshot.
+#
+# With --elf (the .axf of the same build, armlink or GNU ld) pc, lr and
+# every stack word pointing into the flash are resolved to function+offset
+# from the ELF symbol table. A stack word with the Thumb bit set is most
+# likely a return address, the caller of the frame above. When the
+# addr2line tool is found, file:line is added; return addresses are looked
+# up at address - 1, the call instruction.
+#
+# Usage:
+#   crash_decode.py [--elf homework_06/homework_06.axf] [log | -]
+#
+# @version V1.0 2026-10-18
+###############################################################################
+
+import argparse
+import bisect
+import shutil
+import struct
+import subprocess
+import sys
+
+FLASH_BASE = 0x08000000
+FLASH_SIZE = 0x00080000
+
+REGS = ('r0', 'r1', 'r2', 'r3', 'r12', 'lr', 'pc', 'xpsr')
+
+CFSR_BITS = (
+    # MemManage, CFSR[7:0]
+    (0, 'IACCVIOL', 'instruction fetch from a no-execute region'),
+    (1, 'DACCVIOL', 'data access violation, MMFAR holds the address'),
+    (3, 'MUNSTKERR', 'MPU fault unstacking on exception return'),
+    (4, 'MSTKERR', 'MPU fault stacking on exception entry'),
+    (5, 'MLSPERR', 'MPU fault on lazy FP state preservation'),
+    (7, 'MMARVALID', 'MMFAR is valid'),
+    # BusFault, CFSR[15:8]
+    (8, 'IBUSERR', 'bus error on instruction fetch'),
+    (9, 'PRECISERR', 'precise data bus error, BFAR holds the address'),
+    (10, 'IMPRECISERR', 'imprecise data bus error, pc is after the store'),
+    (11, 'UNSTKERR', 'bus error unstacking on exception return'),
+    (12, 'STKERR', 'bus error stacking on exception entry, stack overflow?'),
+    (13, 'LSPERR', 'bus error on lazy FP state preservation'),
+    (15, 'BFARVALID', 'BFAR is valid'),
+    # UsageFault, CFSR[31:16]
+    (16, 'UNDEFINSTR', 'undefined instruction'),
+    (17, 'INVSTATE', 'invalid state, a call through a pointer without the '
+                     'Thumb bit?'),
+    (18, 'INVPC', 'invalid EXC_RETURN on exception return'),
+    (19, 'NOCP', 'coprocessor access, FPU not enabled?'),
+    (24, 'UNALIGNED', 'unaligned access'),
+    (25, 'DIVBYZERO', 'division by zero'),
+)
+
+HFSR_BITS = (
+    (1, 'VECTTBL', 'bus fault on the vector table read'),
+    (30, 'FORCED', 'escalated from a configurable fault, see CFSR'),
+    (31, 'DEBUGEVT', 'debug event'),
+)
+
+
+###############################################################################
+# Log
+###############################################################################
+
+def parse_log(lines):
+    """List of records, a record is a dict of key -> value; 'stack' is a
+    list of (address, word)."""
+    records = []
+    rec = None
+    for line in lines:
+        line = line.strip()
+        if line == '# crash':
+            rec = {'stack': []}
+            continue
+        if line == '# crash end':
+            if rec is not None:
+                records.append(rec)
+            rec = None
+            continue
+        if rec is None or not line.startswith('crash,'):
+            continue
+        fields = line.split(',')
+        if fields[1] == 'stack':
+            addr = int(fields[2], 16)
+            for i, w in enumerate(fields[3:]):
+                rec['stack'].append((addr + 4 * i, int(w, 16)))
+        elif fields[1] in ('type', 'task'):
+            rec[fields[1]] = ','.join(fields[2:])
+        else:
+            rec[fields[1]] = int(fields[2], 0)
+    return records
+
+
+###############################################################################
+# ELF symbols
+###############################################################################
+
+class Symbols(object):
+    """Function symbols of an ELF32/ELF64 little endian image."""
+
+    def __init__(self, path):
+        with open(path, 'rb') as f:
+            data = f.read()
+        if data[:4] != b'\x7fELF' or data[5] != 1:
+            raise ValueError('%s: not a little endian ELF' % path)
+        elf64 = data[4] == 2
+        if elf64:
+            shoff, = struct.unpack_from('<Q', data, 0x28)
+            shentsize, shnum = struct.unpack_from('<HH', data, 0x3A)
+            sh_fmt, sym_fmt, sym_size = '<IIQQQQIIQQ', '<IBBHQQ', 24
+        else:
+            shoff, = struct.unpack_from('<I', data, 0x20)
+            shentsize, shnum = struct.unpack_from('<HH', data, 0x2E)
+            sh_fmt, sym_fmt, sym_size = '<IIIIIIIIII', '<IIIBBH', 16
+        sections = [struct.unpack_from(sh_fmt, data, shoff + i * shentsize)
+                    for i in range(shnum)]
+        funcs = []
+        for sh in sections:
+            if sh[1] != 2:                              # SHT_SYMTAB
+                continue
+            strtab = sections[sh[6]]
+            for off in range(sh[4], sh[4] + sh[5], sym_size):
+                if elf64:
+                    name, info, _, shndx, value, size = struct.unpack_from(
+                        sym_fmt, data, off)
+                else:
+                    name, value, size, info, _, shndx = struct.unpack_from(
+                        sym_fmt, data, off)
+                if info & 0xF != 2 or shndx == 0:       # STT_FUNC, defined
+                    continue
+                end = data.index(b'\0', strtab[4] + name)
+                funcs.append((value & ~1, size,
+                              data[strtab[4] + name:end].decode()))
+        funcs.sort()
+        self.addrs = [f[0] for f in funcs]
+        self.funcs = funcs
+
+    def lookup(self, addr):
+        """'name+0xoff' of the function holding addr, None outside."""
+        i = bisect.bisect_right(self.addrs, addr) - 1
+        if i < 0:
+            return None
+        start, size, name = self.funcs[i]
+        if size and addr >= start + size:
+            return None
+        return '%s+0x%x' % (name, addr - start)
+
+
+def addr2line(tool, elf, addrs):
+    """addr -> 'file:line' with the binutils addr2line, {} without it."""
+    if not tool or not addrs:
+        return {}
+    out = subprocess.run([tool, '-e', elf] + ['0x%x' % a for a in addrs],
+                         stdout=subprocess.PIPE, universal_newlines=True,
+                         check=False).stdout.split('\n')
+    return {a: line for a, line in zip(addrs, out)
+            if not line.startswith('??')}
+
+
+###############################################################################
+# Report
+###############################################################################
+
+def bits(value, table):
+    return [(name, text) for bit, name, text in table if value >> bit & 1]
+
+
+def code_addr(word):
+    return FLASH_BASE <= word < FLASH_BASE + FLASH_SIZE
+
+
+def describe(rec, syms, lines):
+    """Lines of text for one record."""
+    def where(addr, ret):
+        if syms is None or not code_addr(addr):
+            return ''
+        pc = addr & ~1
+        text = syms.lookup(pc) or '?'
+        src = lines.get(pc - 1 if ret else pc)
+        return '  ' + text + ('  ' + src if src else '')
+
+    out = ['crash %d: %s in task "%s" at tick %d ms' %
+           (rec.get('count', 0), rec.get('type', '?'), rec.get('task', ''),
+            rec.get('tick', 0))]
+    exc = rec.get('exc_return', 0)
+    if exc:
+        out.append('  from %s mode, %s, %s frame' % (
+            'thread' if exc & 8 else 'handler', 'PSP' if exc & 4 else 'MSP',
+            'basic' if exc & 0x10 else 'FP extended'))
+        ipsr = rec.get('xpsr', 0) & 0x1FF
+        if ipsr:
+            out.append('  inside exception %d (IRQ %d)' % (ipsr, ipsr - 16))
+    else:
+        out.append('  software crash, pc is the caller of the handler')
+
+    cfsr, hfsr = rec.get('cfsr', 0), rec.get('hfsr', 0)
+    out.append('  cfsr 0x%08X  hfsr 0x%08X' % (cfsr, hfsr))
+    for name, text in bits(cfsr, CFSR_BITS) + bits(hfsr, HFSR_BITS):
+        out.append('    %-11s %s' % (name, text))
+    if cfsr >> 7 & 1:
+        out.append('    mmfar 0x%08X' % rec.get('mmfar', 0))
+    if cfsr >> 15 & 1:
+        out.append('    bfar  0x%08X' % rec.get('bfar', 0))
+
+    for reg in REGS:
+        val = rec.get(reg, 0)
+        out.append('  %-4s 0x%08X%s' % (reg, val,
+                                         where(val, reg == 'lr')))
+    out.append('  sp   0x%08X' % rec.get('sp', 0))
+    if rec['stack']:
+        out.append('  stack')
+    for addr, word in rec['stack']:
+        out.append('    0x%08X: 0x%08X%s' % (addr, word,
+                                             where(word, word & 1)))
+    return out
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__)
+    ap.add_argument('log', nargs='?', default='-')
+    ap.add_argument('--elf', help='.axf of the same build')
+    ap.add_argument('--addr2line', default='arm-none-eabi-addr2line',
+                    help='addr2line tool, skipped when not found')
+    args = ap.parse_args()
+
+    if args.log == '-':
+        records = parse_log(sys.stdin)
+    else:
+        with open(args.log, errors='replace') as f:
+            records = parse_log(f)
+    if not records:
+        print('no crash record in the log')
+        return 1
+
+    syms = Symbols(args.elf) if args.elf else None
+    tool = shutil.which(args.addr2line) if args.elf else None
+    for rec in records:
+        addrs = set()
+        for reg in ('pc', 'lr'):
+            if code_addr(rec.get(reg, 0)):
+                addrs.add(rec[reg] & ~1)
+                addrs.add((rec[reg] & ~1) - 1)
+        for _, word in rec['stack']:
+            if code_addr(word) and word & 1:
+                addrs.add((word & ~1) - 1)
+        lines = addr2line(tool, args.elf, sorted(addrs))
+        print('\n'.join(describe(rec, syms, lines)))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
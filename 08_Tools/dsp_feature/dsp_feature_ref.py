@@ -0,0 +1,286 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+###############################################################################
+# Copyright (C) 2025 Damian.
+#
+# All Rights Reserved.
+#
+# @file dsp_feature_ref.py
+#
+# @brief Reference of the streaming features of bsp_dsp_feature.h in double
+#        with NumPy, written as C for the feature bench.
+#
+# The signal is 16 kHz int16: a chirp from 100 Hz to 6 kHz, two steady
+# tones and seeded noise. For every case in CASES the features of every hop
+# are computed the way the firmware streams them: the window ends at the
+# last sample of the hop, zeros before the first sample. The tool writes
+# the signal, the float column of every hop and the int8 spectrogram after
+# the last hop; the int8 scale of a case spans the range of its features.
+#
+# Usage:
+#   dsp_feature_ref.py [--seed 1] [--out-dir BSP/bench]
+#
+# @version V1.0 2026-10-18
+###############################################################################
+
+import argparse
+import os
+import sys
+
+import numpy as np
+
+SAMPLE_RATE = 16000
+SIGNAL_LEN = 2048
+LOG_FLOOR = 1e-6
+
+# mode, hop, frame, mel, mfcc, columns, f_min, f_max
+CASES = [
+    ('mfcc',   160, 512, 40, 10, 12, 20.0, 8000.0),
+    ('mfcc',   320, 512, 40, 10, 6,  20.0, 8000.0),
+    ('mfcc',   512, 512, 40, 10, 4,  20.0, 8000.0),
+    ('logmel', 64,  256, 20, 0,  32, 125.0, 7500.0),
+    ('logmel', 128, 256, 20, 0,  16, 125.0, 7500.0),
+]
+
+
+def hz_to_mel(hz):
+    return 2595.0 * np.log10(1.0 + hz / 700.0)
+
+
+def mel_to_hz(mel):
+    return 700.0 * (10.0 ** (mel / 2595.0) - 1.0)
+
+
+def mel_matrix(frame, mel_num, f_min, f_max):
+    """[mel_num, frame / 2 + 1] triangular HTK bands."""
+    edges = mel_to_hz(np.linspace(hz_to_mel(f_min), hz_to_mel(f_max),
+                                  mel_num + 2))
+    hz = np.arange(frame // 2 + 1) * SAMPLE_RATE / frame
+    w = np.zeros((mel_num, hz.size))
+    for m in range(mel_num):
+        rise = (hz - edges[m]) / (edges[m + 1] - edges[m])
+        fall = (edges[m + 2] - hz) / (edges[m + 2] - edges[m + 1])
+        w[m] = np.maximum(0.0, np.minimum(rise, fall))
+        if not w[m].any():
+            raise ValueError('mel band %d has no bin' % m)
+    return w
+
+
+def dct_matrix(mfcc_num, mel_num):
+    """Orthonormal DCT-II, [mfcc_num, mel_num]."""
+    i = np.arange(mfcc_num)[:, None]
+    m = np.arange(mel_num)[None, :]
+    d = np.cos(np.pi * i * (m + 0.5) / mel_num) * np.sqrt(2.0 / mel_num)
+    d[0] *= np.sqrt(0.5)
+    return d
+
+
+def features(x, hop, frame, mel_num, mfcc_num, f_min, f_max):
+    """[hops, coeff_num], one row per hop in streaming order."""
+    window = 0.5 - 0.5 * np.cos(2.0 * np.pi * np.arange(frame) / frame)
+    mel_w = mel_matrix(frame, mel_num, f_min, f_max)
+    padded = np.concatenate([np.zeros(frame), x])
+    rows = []
+    for j in range(1, len(x) // hop + 1):
+        seg = padded[j * hop:j * hop + frame]
+        power = np.abs(np.fft.rfft(seg * window)) ** 2
+        logmel = np.log(mel_w @ power + LOG_FLOOR)
+        rows.append(dct_matrix(mfcc_num, mel_num) @ logmel if mfcc_num
+                    else logmel)
+    return np.array(rows)
+
+
+def quantise(v, scale, zero_point):
+    q = np.where(v >= 0, np.floor(v / scale + 0.5), np.ceil(v / scale - 0.5))
+    return np.clip(q + zero_point, -128, 127).astype(int)
+
+
+def signal(seed):
+    rng = np.random.default_rng(seed)
+    t = np.arange(SIGNAL_LEN) / SAMPLE_RATE
+    f0, f1 = 100.0, 6000.0
+    dur = SIGNAL_LEN / SAMPLE_RATE
+    x = 0.4 * np.sin(2.0 * np.pi * (f0 * t + (f1 - f0) * t * t / (2 * dur)))
+    x += 0.2 * np.sin(2.0 * np.pi * 440.0 * t)
+    x += 0.1 * np.sin(2.0 * np.pi * 2500.0 * t)
+    x += 0.05 * rng.standard_normal(SIGNAL_LEN)
+    return np.clip(np.round(x * 32767.0), -32768, 32767).astype(int)
+
+
+###############################################################################
+# C output
+###############################################################################
+
+BANNER = """/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file {file}
+ *
+ * @par dependencies
+ * - bsp_dsp_feature.h
+ *
+ * @author Damian
+ *
+ * @brief Reference of the feature bench: the test signal, the float column
+ *        of every hop and the int8 spectrogram after the last hop.
+ *
+ * Processing flow:
+ *
+ * {flow}
+ *
+ * Generated by 08_Tools/dsp_feature/dsp_feature_ref.py --seed {seed},
+ * do not edit.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+"""
+
+
+def c_array(ctype, name, values, per_line, fmt):
+    lines = []
+    for i in range(0, len(values), per_line):
+        lines.append('    ' + ', '.join(fmt(v) for v in values[i:i + per_line])
+                     + ',')
+    return 'static const %s %s[%d] =\n{\n%s\n};\n' % (
+        ctype, name, len(values), '\n'.join(lines))
+
+
+def c_float(v):
+    return '%.9gf' % v if '.' in '%.9g' % v or 'e' in '%.9g' % v \
+        else '%.9g.0f' % v
+
+
+def emit(seed, x, cases, out_dir):
+    base = 'bsp_bench_dsp_feature_ref'
+    guard = '__BSP_BENCH_DSP_FEATURE_REF_H__'
+
+    h = [BANNER.format(file=base + '.h', seed=seed,
+                       flow='bench_dsp_feature_ref_case[i] -> '
+                            'dsp_feature_inst( &feat, &case->cfg )')]
+    h.append('#ifndef %s\n#define %s\n' % (guard, guard))
+    h.append('//******************************** Includes '
+             '*********************************//\n')
+    h.append('#include "bsp_dsp_feature.h"\n')
+    h.append('//******************************** Includes '
+             '*********************************//\n')
+    h.append('//******************************** Defines '
+             '**********************************//\n')
+    h.append('#define BENCH_DSP_FEATURE_REF_LEN     %-6s/* samples of the signal  */'
+             % ('%dU' % len(x)))
+    h.append('#define BENCH_DSP_FEATURE_REF_CASES   %-6s/* cases                  */'
+             % ('%dU' % len(cases)))
+    h.append('''
+typedef struct
+{
+    const char            * mode;                     /* "mfcc" / "logmel"   */
+    const char            * case_name;                /* "hop_N"             */
+    dsp_feature_cfg_t     cfg;                        /* feature config      */
+    uint32_t              hops;                       /* hops of the signal  */
+    const float32_t       * columns;                  /* [hops, coeff_num]   */
+    const int8_t          * tensor;                   /* [columns, coeff]    */
+} bench_dsp_feature_ref_t;
+''')
+    h.append('//******************************** Defines '
+             '**********************************//\n')
+    h.append('//******************************* Declaring '
+             '*********************************//\n')
+    h.append('extern const int16_t bench_dsp_feature_ref_signal'
+             '[BENCH_DSP_FEATURE_REF_LEN];')
+    h.append('extern const bench_dsp_feature_ref_t\n'
+             '                bench_dsp_feature_ref_case'
+             '[BENCH_DSP_FEATURE_REF_CASES];')
+    h.append('\n//******************************* Declaring '
+             '*********************************//')
+    h.append('#endif // %s\n' % guard)
+
+    c = [BANNER.format(file=base + '.c', seed=seed, flow='Call directly.')]
+    c.append('//******************************** Includes '
+             '*********************************//\n')
+    c.append('#include "%s.h"\n' % base)
+    c.append('//******************************** Includes '
+             '*********************************//\n')
+    c.append('//******************************** Defines '
+             '**********************************//\n')
+    for k, cs in enumerate(cases):
+        c.append(c_array('float32_t', 's_case%d_columns' % k,
+                         cs['columns'].ravel().tolist(), 4, c_float))
+        c.append(c_array('int8_t   ', 's_case%d_tensor' % k,
+                         cs['tensor'].ravel().tolist(), 12, str))
+    c.append(c_array('int16_t', 'bench_dsp_feature_ref_signal', x.tolist(),
+                     9, str)
+             .replace('static const', 'const')
+             .replace('[%d]' % len(x), '[BENCH_DSP_FEATURE_REF_LEN]'))
+    c.append('const bench_dsp_feature_ref_t\n'
+             '                bench_dsp_feature_ref_case'
+             '[BENCH_DSP_FEATURE_REF_CASES] =\n{')
+    for k, cs in enumerate(cases):
+        c.append('    {')
+        c.append('        .mode      = "%s",' % cs['mode'])
+        c.append('        .case_name = "hop_%d",' % cs['hop'])
+        c.append('        .cfg       =')
+        c.append('        {')
+        c.append('            .sample_rate = %dU,' % SAMPLE_RATE)
+        c.append('            .frame_len   = %dU,' % cs['frame'])
+        c.append('            .hop_len     = %dU,' % cs['hop'])
+        c.append('            .mel_num     = %dU,' % cs['mel'])
+        c.append('            .mfcc_num    = %dU,' % cs['mfcc'])
+        c.append('            .column_num  = %dU,' % cs['column_num'])
+        c.append('            .f_min       = %s,' % c_float(cs['f_min']))
+        c.append('            .f_max       = %s,' % c_float(cs['f_max']))
+        c.append('            .scale       = %s,' % c_float(cs['scale']))
+        c.append('            .zero_point  = %d,' % cs['zero_point'])
+        c.append('        },')
+        c.append('        .hops      = %dU,' % len(cs['columns']))
+        c.append('        .columns   = s_case%d_columns,' % k)
+        c.append('        .tensor    = s_case%d_tensor,' % k)
+        c.append('    },')
+    c.append('};\n')
+    c.append('//******************************** Defines '
+             '**********************************//')
+
+    for sub, name, body in (('include', base + '.h', h),
+                            ('src', base + '.c', c)):
+        os.makedirs(os.path.join(out_dir, sub), exist_ok=True)
+        with open(os.path.join(out_dir, sub, name), 'w') as f:
+            f.write('\n'.join(body) + '\n')
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__)
+    ap.add_argument('--seed', type=int, default=1)
+    ap.add_argument('--out-dir', default=os.path.join(
+        os.path.dirname(os.path.abspath(__file__)), '..', '..',
+        '05_Software', '01_Source_Code', 'BSP', 'bench'))
+    args = ap.parse_args()
+
+    x = signal(args.seed)
+    cases = []
+    for mode, hop, frame, mel, mfcc, column_num, f_min, f_max in CASES:
+        cols = features(x / 32768.0, hop, frame, mel, mfcc, f_min, f_max)
+        lo, hi = float(cols.min()), float(cols.max())
+        scale = float(np.float32((hi - lo) / 255.0))
+        zero_point = int(np.clip(np.round(-128.0 - lo / scale), -128, 127))
+        # the spectrogram after the last hop, zero columns before the first
+        last = np.zeros((column_num, cols.shape[1]))
+        take = min(column_num, len(cols))
+        last[column_num - take:] = cols[len(cols) - take:]
+        tensor = quantise(last, scale, zero_point)
+        cases.append(dict(mode=mode, hop=hop, frame=frame, mel=mel,
+                          mfcc=mfcc, column_num=column_num, f_min=f_min,
+                          f_max=f_max, scale=scale, zero_point=zero_point,
+                          columns=cols.astype(np.float32), tensor=tensor))
+        print('%-6s hop %3d frame %3d: %2d hops x %2d, range %.3f .. %.3f, '
+              'scale %.6f zero point %d' %
+              (mode, hop, frame, len(cols), cols.shape[1], lo, hi, scale,
+               zero_point))
+    emit(args.seed, x, cases, os.path.normpath(args.out_dir))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,125 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+###############################################################################
+# Copyright (C) 2025 Damian.
+#
+# All Rights Reserved.
+#
+# @file evlog_decode.py
+#
+# @brief Decode the event journal evlog_dump (bsp_evlog.c) prints: one line
+#        per record with its time, the event name and the decoded payload.
+#
+# The log is the serial output, every "evlog,<seq>,<time ms>,<id>,<hex>"
+# line between "# evlog" and "# evlog end,..." belongs to one dump, other
+# lines are skipped. The last dump of the log is decoded unless --all.
+#
+# Per record: sequence number, time since its boot (the time restarts at
+# every boot, a BOOT record starts a new one), event name and payload. A
+# hole in the sequence numbers is reported: records lost in RAM by a reset,
+# or dropped by the writer (the end line counts the drops since the boot).
+#
+# EVENTS maps an id to (name, payload decoder); keep it in step with the
+# CORE_EVLOG_* ids of freertos.c. Unknown ids print the payload as hex.
+#
+# Usage:
+#   evlog_decode.py [--all] [log | -]
+#
+# @version V1.0 2026-10-18
+###############################################################################
+
+import argparse
+import struct
+import sys
+
+RESET_FLAGS = (
+    (25, 'BORRST'),
+    (26, 'PINRST'),
+    (27, 'PORRST'),
+    (28, 'SFTRST'),
+    (29, 'IWDGRST'),
+    (30, 'WWDGRST'),
+    (31, 'LPWRRST'),
+)
+
+
+def reset_cause(payload):
+    """RCC->CSR of the boot record."""
+    csr = struct.unpack('<I', payload[:4])[0]
+    names = [name for bit, name in RESET_FLAGS if csr & (1 << bit)]
+    return 'csr 0x%08X %s' % (csr, '|'.join(names) or '-')
+
+
+EVENTS = {
+    1: ('BOOT', reset_cause),
+}
+
+
+def parse_log(lines):
+    """List of dumps, a dump is a dict: 'records' a list of
+    (seq, time_ms, id, payload) and 'end' the fields of the end line."""
+    dumps = []
+    dump = None
+    for line in lines:
+        line = line.strip()
+        if line == '# evlog':
+            dump = {'records': [], 'end': None}
+            continue
+        if line.startswith('# evlog end'):
+            if dump is not None:
+                dump['end'] = [int(v) for v in line.split(',')[1:]]
+                dumps.append(dump)
+            dump = None
+            continue
+        if dump is None or not line.startswith('evlog,'):
+            continue
+        fields = line.split(',')
+        dump['records'].append((int(fields[1]), int(fields[2]),
+                                int(fields[3]), bytes.fromhex(fields[4])))
+    return dumps
+
+
+def describe(dump):
+    """Lines of text of one dump."""
+    lines = []
+    prev = None
+    for seq, time_ms, ev, payload in dump['records']:
+        if prev is not None and seq != (prev + 1) & 0xFFFFFFFF:
+            lines.append('         -- %d records missing' %
+                         ((seq - prev - 1) & 0xFFFFFFFF))
+        prev = seq
+        name, decode = EVENTS.get(ev, ('id %d' % ev, None))
+        text = decode(payload) if decode and payload else payload.hex()
+        lines.append('%8d %10.3f s  %-8s %s' %
+                     (seq, time_ms / 1000.0, name, text))
+    if dump['end']:
+        printed, dropped, erases = dump['end']
+        lines.append('%d records, %d dropped since the boot, %d erases' %
+                     (printed, dropped, erases))
+    return lines
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__)
+    ap.add_argument('log', nargs='?', default='-',
+                    help='serial log, - for stdin')
+    ap.add_argument('--all', action='store_true',
+                    help='every dump of the log, not only the last one')
+    args = ap.parse_args()
+
+    if args.log == '-':
+        dumps = parse_log(sys.stdin)
+    else:
+        with open(args.log, errors='replace') as f:
+            dumps = parse_log(f)
+    if not dumps:
+        print('no event log dump in the log')
+        return 1
+
+    for dump in (dumps if args.all else dumps[-1:]):
+        print('\n'.join(describe(dump)))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
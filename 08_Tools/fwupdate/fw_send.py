@@ -0,0 +1,311 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+###############################################################################
+# Copyright (C) 2025 Damian.
+#
+# All Rights Reserved.
+#
+# @file fw_send.py
+#
+# @brief Send a firmware image over USART1 to the receiver of
+#        bsp_fw_update.c, or pack it with its slot header for the probe.
+#
+# The image is the hex of target homework_06_slot_a or homework_06_slot_b,
+# linked at slot + 0x200 (bsp_fw_image.h). The receiver writes into the
+# slot not running, so the image has to be linked for that one: QUERY
+# tells which, a mismatch stops here.
+#
+# Send: QUERY, BEGIN (the receiver erases, or resumes a session of the same
+# version, size and CRC and tells the offset), DATA with WINDOW blocks ahead
+# of the last acknowledge, back to it when a reply is missing, END (the CRC
+# of the whole image in the flash), then REBOOT with --reboot. Run it again
+# after a broken link or a reset: it resumes after the last block written.
+# Bytes between the frames are the console of the board, printed with -v.
+#
+# Pack: --pack out.hex writes the header and the image as one hex for the
+# first download with the probe, after the boot loader (boot.uvprojx):
+# progress complete, confirmed, so the boot loader starts it as it is.
+#
+# Frames, little endian, CRC-32/MPEG-2 of type..payload:
+#   0xA5 0x5A type len(2) payload crc(4)
+# Keep CMD_*, RSP_* and the header layout in step with bsp_fw_update.h and
+# bsp_fw_image.h.
+#
+# Usage:
+#   fw_send.py --port COM5 --version 7 image.hex [--reboot] [-v]
+#   fw_send.py --version 1 --pack out.hex image.hex
+#
+# @version V1.0 2026-10-18
+###############################################################################
+
+import argparse
+import struct
+import sys
+import time
+
+SOF = b'\xA5\x5A'
+CMD_QUERY, CMD_BEGIN, CMD_DATA, CMD_END, CMD_REBOOT = 1, 2, 3, 4, 5
+RSP_FLAG = 0x80
+RSP_NAMES = ('OK', 'OFFSET', 'SIZE', 'STATE', 'FLASH', 'CRC')
+STATE_NAMES = ('IDLE', 'BEGIN', 'DATA', 'END', 'DONE')
+
+SLOT_ADDR = (0x08020000, 0x08040000)
+SLOT_BYTES = 0x20000
+HEADER_BYTES = 0x200
+BLOCK_BYTES = 1024
+MAGIC = 0x46574131
+MARK = 0x00000000
+ERASED = 0xFFFFFFFF
+
+WINDOW = 2          # DATA frames ahead, the receiver has two block buffers
+TIMEOUT_S = 1.0     # a reply missing: send again
+ERASE_S = 4.0       # BEGIN: erase of a 128 KiB sector
+CRC_S = 3.0         # END: CRC of the whole image
+RETRIES = 5
+
+
+def crc32_mpeg2(data, crc=0xFFFFFFFF):
+    """CRC-32/MPEG-2: poly 0x04C11DB7, not reflected, no final xor."""
+    for byte in data:
+        crc ^= byte << 24
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x04C11DB7) if crc & 0x80000000 else crc << 1
+            crc &= 0xFFFFFFFF
+    return crc
+
+
+def crc32_image(image):
+    """CRC of the image words, most significant byte first: the CRC unit."""
+    swapped = bytearray()
+    for i in range(0, len(image), 4):
+        swapped += image[i:i + 4][::-1]
+    return crc32_mpeg2(swapped)
+
+
+def read_hex(path):
+    """(start address, bytes) of an Intel hex, gaps filled with 0xFF."""
+    chunks = {}
+    upper = 0
+    with open(path) as f:
+        for line in f:
+            line = line.strip()
+            if not line.startswith(':'):
+                continue
+            rec = bytes.fromhex(line[1:])
+            count, addr, kind = rec[0], (rec[1] << 8) | rec[2], rec[3]
+            data = rec[4:4 + count]
+            if kind == 0:
+                chunks[upper + addr] = data
+            elif kind == 4:
+                upper = ((data[0] << 8) | data[1]) << 16
+            elif kind == 2:
+                upper = ((data[0] << 8) | data[1]) << 4
+            elif kind == 1:
+                break
+    if not chunks:
+        raise SystemExit('%s: no data' % path)
+    start = min(chunks)
+    end = max(a + len(d) for a, d in chunks.items())
+    image = bytearray(b'\xFF' * (end - start))
+    for addr, data in chunks.items():
+        image[addr - start:addr - start + len(data)] = data
+    image += b'\xFF' * (-len(image) % 4)
+    return start, bytes(image)
+
+
+def write_hex(path, start, data):
+    """Intel hex of data at start."""
+    lines = []
+    upper = None
+    for off in range(0, len(data), 16):
+        addr = start + off
+        if addr >> 16 != upper:
+            upper = addr >> 16
+            rec = struct.pack('>BHBH', 2, 0, 4, upper)
+            lines.append(rec)
+        chunk = data[off:off + 16]
+        lines.append(struct.pack('>BHB', len(chunk), addr & 0xFFFF, 0) + chunk)
+    lines.append(struct.pack('>BHB', 0, 0, 1))
+    with open(path, 'w') as f:
+        for rec in lines:
+            f.write(':%s%02X\n' % (rec.hex().upper(), -sum(rec) & 0xFF))
+
+
+def slot_of(start):
+    """Slot an image linked at start belongs to."""
+    for slot, addr in enumerate(SLOT_ADDR):
+        if start == addr + HEADER_BYTES:
+            return slot
+    raise SystemExit('image at 0x%08X: not linked for a slot, build target '
+                     'homework_06_slot_a or homework_06_slot_b' % start)
+
+
+def pack(args, start, image):
+    """Header and image for the probe."""
+    header = struct.pack('<8I', MAGIC, args.version, len(image),
+                         crc32_image(image), 0, 0, 0, 0)
+    header += struct.pack('<3I', ERASED, MARK, ERASED)
+    header += b'\xFF' * (HEADER_BYTES - len(header))
+    write_hex(args.pack, start - HEADER_BYTES, header + image)
+    print('%s: slot %s, version %u, %u bytes, crc 0x%08X' %
+          (args.pack, 'AB'[slot_of(start)], args.version, len(image),
+           crc32_image(image)))
+
+
+class Link:
+    """Frames over the serial port, the console bytes in between kept."""
+
+    def __init__(self, port, baud, verbose):
+        import serial
+        self.ser = serial.Serial(port, baud, timeout=0.05)
+        self.buf = bytearray()
+        self.verbose = verbose
+
+    def send(self, kind, payload=b''):
+        body = struct.pack('<BH', kind, len(payload)) + payload
+        self.ser.write(SOF + body + struct.pack('<I', crc32_mpeg2(body)))
+
+    def replies(self, timeout, want=1):
+        """Replies (type, status, state, running, target, words), until
+        want of them came or the timeout."""
+        out = []
+        end = time.time() + timeout
+        while time.time() < end and len(out) < want:
+            self.buf += self.ser.read(4096)
+            while True:
+                i = self.buf.find(SOF)
+                if i < 0:
+                    self._console(self.buf[:-1])
+                    del self.buf[:-1]
+                    break
+                self._console(self.buf[:i])
+                del self.buf[:i]
+                if len(self.buf) < 5:
+                    break
+                plen = self.buf[3] | (self.buf[4] << 8)
+                if plen > 64:
+                    del self.buf[:1]
+                    continue
+                if len(self.buf) < 9 + plen:
+                    break
+                frame = bytes(self.buf[:9 + plen])
+                if (struct.unpack('<I', frame[-4:])[0] !=
+                        crc32_mpeg2(frame[2:-4]) or plen < 4 or
+                        not frame[2] & RSP_FLAG):
+                    del self.buf[:1]
+                    continue
+                del self.buf[:9 + plen]
+                num = (plen - 4) // 4
+                words = struct.unpack('<%dI' % num, frame[9:9 + 4 * num])
+                out.append((frame[2] & ~RSP_FLAG, frame[5], frame[6],
+                            frame[7], frame[8], words))
+        return out
+
+    def command(self, kind, payload=b'', timeout=TIMEOUT_S):
+        """Reply of a command, sent again while none comes."""
+        for _ in range(RETRIES):
+            self.send(kind, payload)
+            for reply in self.replies(timeout):
+                if reply[0] == kind:
+                    return reply
+        raise SystemExit('no reply to command %u' % kind)
+
+    def _console(self, data):
+        if self.verbose and data:
+            sys.stdout.write(data.decode('ascii', 'replace'))
+
+
+def status(reply):
+    return RSP_NAMES[reply[1]] if reply[1] < len(RSP_NAMES) else str(reply[1])
+
+
+def update(args, start, image):
+    """QUERY, BEGIN, DATA, END, REBOOT."""
+    link = Link(args.port, args.baud, args.verbose)
+    size = len(image)
+    crc = crc32_image(image)
+
+    reply = link.command(CMD_QUERY)
+    running, target = reply[3], reply[4]
+    print('running slot %s, receiving into slot %s, %s' %
+          ('AB'[running] if running < 2 else '-', 'AB'[target],
+           STATE_NAMES[reply[2]] if reply[2] < 5 else reply[2]))
+    if slot_of(start) != target:
+        raise SystemExit('image linked for slot %s, build target '
+                         'homework_06_slot_%s' %
+                         ('AB'[slot_of(start)], 'ab'[target]))
+
+    reply = link.command(CMD_BEGIN, struct.pack('<3I', args.version, size,
+                                                crc), ERASE_S)
+    if reply[1] != 0:
+        raise SystemExit('BEGIN refused: %s' % status(reply))
+    acked = first = reply[5][0]
+    if acked:
+        print('resuming at %u of %u bytes' % (acked, size))
+
+    t0 = time.time()
+    sent = 0
+    while acked < size:
+        frames = 0
+        for w in range(WINDOW):
+            off = acked + w * BLOCK_BYTES
+            if off >= size:
+                break
+            link.send(CMD_DATA, struct.pack('<I', off) +
+                      image[off:off + BLOCK_BYTES])
+            sent += min(BLOCK_BYTES, size - off)
+            frames += 1
+        for reply in link.replies(TIMEOUT_S, frames):
+            if reply[0] != CMD_DATA:
+                continue
+            if reply[1] in (3, 4):
+                raise SystemExit('DATA at %u: %s, run again to resume' %
+                                 (acked, status(reply)))
+            if reply[1] == 0 and reply[5][0] > acked:
+                acked = reply[5][0]
+        sys.stdout.write('\r%u / %u bytes' % (acked, size))
+        sys.stdout.flush()
+    dt = time.time() - t0
+    print('\n%u bytes sent, %u again, %.1f s, %.0f B/s' %
+          (sent, sent - (size - first), dt,
+           (size - first) / dt if dt else 0.0))
+
+    reply = link.command(CMD_END, timeout=CRC_S)
+    if reply[1] != 0:
+        raise SystemExit('END: %s' % status(reply))
+    print('slot %s: version %u, %u bytes, crc 0x%08X, complete' %
+          ('AB'[target], args.version, size, crc))
+    if args.reboot:
+        link.command(CMD_REBOOT)
+        print('rebooting, the boot loader starts it on a trial')
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__)
+    ap.add_argument('image', help='hex of homework_06_slot_a/b')
+    ap.add_argument('--version', type=int, required=True,
+                    help='the highest valid version boots')
+    ap.add_argument('--port', help='serial port of USART1')
+    ap.add_argument('--baud', type=int, default=115200)
+    ap.add_argument('--reboot', action='store_true')
+    ap.add_argument('--pack', metavar='OUT',
+                    help='write header and image as one hex, no sending')
+    ap.add_argument('-v', '--verbose', action='store_true',
+                    help='print the console bytes between the frames')
+    args = ap.parse_args()
+
+    start, image = read_hex(args.image)
+    slot_of(start)
+    if len(image) > SLOT_BYTES - HEADER_BYTES:
+        raise SystemExit('image of %u bytes, the slot holds %u' %
+                         (len(image), SLOT_BYTES - HEADER_BYTES))
+    if args.pack:
+        pack(args, start, image)
+    elif args.port:
+        update(args, start, image)
+    else:
+        ap.error('--port or --pack')
+
+
+if __name__ == '__main__':
+    main()
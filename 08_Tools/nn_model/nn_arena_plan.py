@@ -0,0 +1,312 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+###############################################################################
+# Copyright (C) 2025 Damian.
+#
+# All Rights Reserved.
+#
+# @file nn_arena_plan.py
+#
+# @brief Plan the activation arena of an int8 graph: one offset per tensor,
+#        two tensors share bytes only when their lives do not overlap.
+#
+# A tensor lives from the op that writes it to the last op that reads it,
+# the graph inputs from the start and the graph outputs to the end. The ops
+# run in list order, as in the nn runtime (bsp_nn_runtime.h).
+#
+# Strategies, every offset aligned to ARENA_ALIGN:
+#   naive       one buffer per tensor, nothing shared (per layer allocation)
+#   first_fit   in order of first use, lowest offset clear of the live
+#               tensors already placed; the runtime does the same on target
+#   greedy_size largest tensor first, lowest gap between the live tensors
+#               already placed (the TFLite micro greedy planner)
+#   bound       most bytes live at one op, no plan can go below it
+#
+# nn_model_gen.py takes the best plan and writes its offsets into the model,
+# nn_runtime_inst checks them and uses them instead of its own first fit.
+#
+# Run alone, the tool compares the strategies on a few standard small models
+# (the demo model and the shapes of the MLPerf Tiny reference models), only
+# the tensor shapes matter here.
+#
+# Usage:
+#   nn_arena_plan.py [--model NAME] [--offsets]
+#
+# @version V1.0 2026-10-18
+###############################################################################
+
+import argparse
+import sys
+
+ARENA_ALIGN = 4
+
+
+def align_up(x):
+    return (x + ARENA_ALIGN - 1) & ~(ARENA_ALIGN - 1)
+
+
+###############################################################################
+# Graph
+###############################################################################
+
+class Graph(object):
+    """Tensor shapes (h, w, c) and ops (inputs, output) in execution order."""
+
+    def __init__(self, name, shape):
+        self.name = name
+        self.shapes = [shape]
+        self.ops = []
+        self.inputs = [0]
+        self.outputs = []
+
+    def op(self, inputs, shape):
+        self.shapes.append(shape)
+        self.ops.append((list(inputs), len(self.shapes) - 1))
+        return len(self.shapes) - 1
+
+    def conv(self, x, out_c, kernel=3, stride=1):
+        h, w, _ = self.shapes[x]
+        # 'same' padding, the output only depends on the stride
+        return self.op([x], (-(-h // stride), -(-w // stride), out_c))
+
+    def dwconv(self, x, stride=1):
+        return self.conv(x, self.shapes[x][2], stride=stride)
+
+    def pool(self, x, kernel, stride):
+        h, w, c = self.shapes[x]
+        return self.op([x], ((h - kernel[0]) // stride[0] + 1,
+                             (w - kernel[1]) // stride[1] + 1, c))
+
+    def global_pool(self, x):
+        return self.op([x], (1, 1, self.shapes[x][2]))
+
+    def fc(self, x, out_c):
+        return self.op([x], (1, 1, out_c))
+
+    def add(self, a, b):
+        return self.op([a, b], self.shapes[a])
+
+    def softmax(self, x):
+        return self.op([x], self.shapes[x])
+
+    def size(self, t):
+        h, w, c = self.shapes[t]
+        return h * w * c
+
+
+def from_model(name, tensors, layers):
+    """Graph of a model of nn_model_gen.py, input 0 and output last."""
+    g = Graph(name, tensors[0])
+    g.shapes = list(tensors)
+    g.ops = [([l['input']], l['output']) for l in layers]
+    g.outputs = [len(tensors) - 1]
+    return g
+
+
+def lifetimes(g):
+    num = len(g.shapes)
+    first = [0] * num
+    last = [0] * num
+    for i, (inputs, output) in enumerate(g.ops):
+        first[output] = i
+        for t in inputs:
+            last[t] = max(last[t], i)
+    for t in g.inputs:
+        first[t] = 0
+    for t in g.outputs or [num - 1]:
+        last[t] = len(g.ops)
+    return first, last
+
+
+###############################################################################
+# Strategies
+###############################################################################
+
+def _place(g, order):
+    """Lowest aligned offset clear of the live tensors placed before."""
+    first, last = lifetimes(g)
+    offset = [0] * len(g.shapes)
+    placed = []
+    for t in order:
+        live = sorted((offset[p], offset[p] + g.size(p)) for p in placed
+                      if first[p] <= last[t] and first[t] <= last[p])
+        off = 0
+        for start, end in live:
+            if off + g.size(t) <= start:
+                break
+            off = max(off, align_up(end))
+        offset[t] = off
+        placed.append(t)
+    return offset
+
+
+def plan_naive(g):
+    offset = []
+    off = 0
+    for t in range(len(g.shapes)):
+        offset.append(off)
+        off = align_up(off + g.size(t))
+    return offset
+
+
+def plan_first_fit(g):
+    first, _ = lifetimes(g)
+    return _place(g, sorted(range(len(g.shapes)), key=lambda t: (first[t], t)))
+
+
+def plan_greedy_size(g):
+    first, _ = lifetimes(g)
+    return _place(g, sorted(range(len(g.shapes)),
+                            key=lambda t: (-g.size(t), first[t], t)))
+
+
+STRATEGIES = [
+    ('naive', plan_naive),
+    ('first_fit', plan_first_fit),
+    ('greedy_size', plan_greedy_size),
+]
+
+
+def arena_size(g, offset):
+    return max(offset[t] + g.size(t) for t in range(len(g.shapes)))
+
+
+def lower_bound(g):
+    first, last = lifetimes(g)
+    return max(sum(g.size(t) for t in range(len(g.shapes))
+                   if first[t] <= i <= last[t])
+               for i in range(len(g.ops) + 1))
+
+
+def check(g, offset):
+    """True when no two tensors with overlapping lives share a byte."""
+    first, last = lifetimes(g)
+    num = len(g.shapes)
+    for t in range(num):
+        if offset[t] % ARENA_ALIGN:
+            return False
+        for o in range(t + 1, num):
+            if first[o] <= last[t] and first[t] <= last[o] and \
+                    offset[t] < offset[o] + g.size(o) and \
+                    offset[o] < offset[t] + g.size(t):
+                return False
+    return True
+
+
+def plan_best(g):
+    """(strategy, offsets, bytes) of the smallest sharing plan, first fit
+    wins a tie so the offline plan equals the runtime one when it can."""
+    best = None
+    for name, fn in STRATEGIES[1:]:
+        offset = fn(g)
+        size = arena_size(g, offset)
+        if best is None or size < best[2]:
+            best = (name, offset, size)
+    return best
+
+
+###############################################################################
+# Standard small models
+###############################################################################
+
+def model_demo():
+    import nn_model_gen
+    g = Graph('demo', nn_model_gen.INPUT_SHAPE)
+    x = 0
+    for kind, p in nn_model_gen.GRAPH:
+        x = g.op([x], nn_model_gen.out_shape(kind, g.shapes[x], p))
+    return g
+
+
+def model_ds_cnn():
+    """Keyword spotting DS-CNN (small), 49 x 10 MFCC in, 12 classes."""
+    g = Graph('ds_cnn', (49, 10, 1))
+    x = g.conv(0, 64, stride=2)
+    for _ in range(4):
+        x = g.dwconv(x)
+        x = g.conv(x, 64, kernel=1)
+    x = g.global_pool(x)
+    g.softmax(g.fc(x, 12))
+    return g
+
+
+def model_mobilenet():
+    """Visual wake words MobileNet v1 0.25, 96 x 96 x 3 in, 2 classes."""
+    g = Graph('mobilenet', (96, 96, 3))
+    x = g.conv(0, 8, stride=2)
+    for out_c, stride in ((16, 1), (32, 2), (32, 1), (64, 2), (64, 1),
+                          (128, 2), (128, 1), (128, 1), (128, 1), (128, 1),
+                          (128, 1), (256, 2), (256, 1)):
+        x = g.dwconv(x, stride)
+        x = g.conv(x, out_c, kernel=1)
+    x = g.global_pool(x)
+    g.softmax(g.fc(x, 2))
+    return g
+
+
+def model_resnet8():
+    """Image classification ResNet-8, 32 x 32 x 3 in, 10 classes."""
+    g = Graph('resnet8', (32, 32, 3))
+    x = g.conv(0, 16)
+    for out_c, stride in ((16, 1), (32, 2), (64, 2)):
+        y = g.conv(x, out_c, stride=stride)
+        y = g.conv(y, out_c)
+        if stride != 1:
+            x = g.conv(x, out_c, kernel=1, stride=stride)
+        x = g.add(x, y)
+    x = g.global_pool(x)
+    g.softmax(g.fc(x, 10))
+    return g
+
+
+def model_autoencoder():
+    """Anomaly detection FC autoencoder, 640 in, 640 out."""
+    g = Graph('autoencoder', (1, 1, 640))
+    x = 0
+    for out_c in (128, 128, 128, 128, 8, 128, 128, 128, 128, 640):
+        x = g.fc(x, out_c)
+    return g
+
+
+MODELS = [model_demo, model_ds_cnn, model_mobilenet, model_resnet8,
+          model_autoencoder]
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__)
+    ap.add_argument('--model', help='only this model')
+    ap.add_argument('--offsets', action='store_true',
+                    help='print the offsets of the best plan')
+    args = ap.parse_args()
+
+    print('%-12s %3s %8s %8s %8s %8s %8s %7s' %
+          ('model', 'ops', 'naive', 'first', 'greedy', 'bound', 'best',
+           'saved'))
+    ret = 0
+    for build in MODELS:
+        g = build()
+        if args.model and g.name != args.model:
+            continue
+        sizes = {}
+        for name, fn in STRATEGIES:
+            offset = fn(g)
+            if not check(g, offset):
+                print('%s: %s plan overlaps' % (g.name, name))
+                ret = 1
+            sizes[name] = arena_size(g, offset)
+        best, offset, size = plan_best(g)
+        print('%-12s %3d %8d %8d %8d %8d %8s %6.1f%%' %
+              (g.name, len(g.ops), sizes['naive'], sizes['first_fit'],
+               sizes['greedy_size'], lower_bound(g), best,
+               100.0 * (sizes['naive'] - size) / sizes['naive']))
+        if args.offsets:
+            first, last = lifetimes(g)
+            for t, shape in enumerate(g.shapes):
+                print('    tensor %2d %-12s %6d bytes at %6d, ops %d..%d' %
+                      (t, 'x'.join(str(d) for d in shape), g.size(t),
+                       offset[t], first[t], last[t]))
+    return ret
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,584 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+###############################################################################
+# Copyright (C) 2025 Damian.
+#
+# All Rights Reserved.
+#
+# @file nn_model_gen.py
+#
+# @brief Generate an int8 model for the nn runtime (bsp_nn_runtime.h) as a C
+#        source, plus a test input and the expected output.
+#
+# The graph is a straight list of layers in GRAPH below, every layer takes
+# the output of the previous one. Weights come from a seeded generator,
+# the scales are calibrated on the test input so every layer spans the int8
+# range. The expected output is computed here with the integer arithmetic of
+# CMSIS-NN (TFLite micro rounding), independent of the C kernels, so a run of
+# the firmware or of the host build is bit exact or wrong.
+#
+# The activation arena is planned by nn_arena_plan.py (the best of its
+# strategies), the offsets and the size go into the model and the runtime
+# uses them instead of its own first fit.
+#
+# Usage:
+#   nn_model_gen.py [--name demo] [--seed 1] [--out-dir BSP/nn/model]
+#
+# @version V1.0 2026-10-18
+###############################################################################
+
+import argparse
+import math
+import os
+import random
+import sys
+
+import nn_arena_plan
+
+# Input window: 32 samples of 3 channels, NHWC with N = H = 1
+INPUT_SHAPE = (1, 32, 3)
+INPUT_SCALE = 1.0 / 64.0
+INPUT_ZERO_POINT = -3
+
+GRAPH = [
+    ('conv',    dict(out_c=8,  kernel=(1, 5), stride=(1, 1), pad=(0, 2),
+                     relu=True)),
+    ('maxpool', dict(kernel=(1, 2), stride=(1, 2), pad=(0, 0))),
+    ('dwconv',  dict(kernel=(1, 3), stride=(1, 1), pad=(0, 1), relu=True)),
+    ('conv',    dict(out_c=16, kernel=(1, 1), stride=(1, 1), pad=(0, 0),
+                     relu=True)),
+    ('avgpool', dict(kernel=(1, 16), stride=(1, 16), pad=(0, 0))),
+    ('fc',      dict(out_c=4)),
+    ('softmax', dict()),
+]
+
+LAYER_ENUM = {
+    'conv':    'NN_LAYER_CONV',
+    'dwconv':  'NN_LAYER_DWCONV',
+    'fc':      'NN_LAYER_FC',
+    'maxpool': 'NN_LAYER_MAXPOOL',
+    'avgpool': 'NN_LAYER_AVGPOOL',
+    'softmax': 'NN_LAYER_SOFTMAX',
+}
+
+Q31_MIN = -(1 << 31)
+Q31_MAX = (1 << 31) - 1
+
+
+###############################################################################
+# CMSIS-NN integer arithmetic
+###############################################################################
+
+def i32(x):
+    x &= 0xFFFFFFFF
+    return x - (1 << 32) if x & 0x80000000 else x
+
+
+def trunc_div(a, b):
+    q = abs(a) // abs(b)
+    return q if (a >= 0) == (b >= 0) else -q
+
+
+def clamp(x, lo, hi):
+    return max(lo, min(hi, x))
+
+
+def doubling_high_mult(a, b):
+    if a == b == Q31_MIN:
+        return Q31_MAX
+    mult = (1 << 30) if (a < 0) == (b < 0) else 1 - (1 << 30)
+    return i32(trunc_div(mult + a * b, 1 << 31))
+
+
+def doubling_high_mult_no_sat(a, b):
+    return i32(((1 << 30) + a * b) >> 31)
+
+
+def divide_by_power_of_two(dividend, exponent):
+    mask = (1 << exponent) - 1
+    remainder = mask & dividend
+    result = dividend >> exponent
+    threshold = mask >> 1
+    if result < 0:
+        threshold += 1
+    if remainder > threshold:
+        result += 1
+    return result
+
+
+def requantize(val, multiplier, shift):
+    left = shift if shift > 0 else 0
+    right = -shift if shift < 0 else 0
+    return divide_by_power_of_two(
+        doubling_high_mult_no_sat(i32(val * (1 << left)), multiplier), right)
+
+
+def mult_by_power_of_two(val, exp):
+    thresh = (1 << (31 - exp)) - 1
+    if val > thresh:
+        return Q31_MAX
+    if val < -thresh:
+        return Q31_MIN
+    return i32(val << exp)
+
+
+def exp_on_negative_values(val):
+    shift = 24
+    val_mod_minus_quarter = (val & ((1 << shift) - 1)) - (1 << shift)
+    remainder = val_mod_minus_quarter - val
+    x = i32((val_mod_minus_quarter << 5) + (1 << 28))
+    x2 = doubling_high_mult(x, x)
+    inner = divide_by_power_of_two(doubling_high_mult(x2, x2), 2)
+    inner = doubling_high_mult(i32(inner + doubling_high_mult(x2, x)),
+                               715827883)
+    inner = divide_by_power_of_two(i32(inner + x2), 1)
+    result = i32(1895147668 + doubling_high_mult(1895147668, i32(x + inner)))
+    for k in (1672461947, 1302514674, 790015084, 290630308, 39332535,
+              720401, 242):
+        if remainder & (1 << shift):
+            result = doubling_high_mult(result, k)
+        shift += 1
+    return Q31_MAX if val == 0 else result
+
+
+def one_over_one_plus_x_for_x_in_0_1(val):
+    total = val + Q31_MAX
+    half_denominator = i32(trunc_div(total + (1 if total >= 0 else -1), 2))
+    x = i32(1515870810 + doubling_high_mult(half_denominator, -1010580540))
+    shift = 1 << 29
+    for _ in range(3):
+        x = i32(x + mult_by_power_of_two(
+            doubling_high_mult(x, i32(shift - doubling_high_mult(
+                half_denominator, x))), 2))
+    return mult_by_power_of_two(x, 1)
+
+
+def clz32(x):
+    return 32 - (x & 0xFFFFFFFF).bit_length()
+
+
+###############################################################################
+# TFLite micro quantisation helpers
+###############################################################################
+
+def tfl_round(x):
+    return int(math.floor(x + 0.5)) if x >= 0 else -int(math.floor(-x + 0.5))
+
+
+def quantize_multiplier(real):
+    if real == 0.0:
+        return 0, 0
+    q, shift = math.frexp(real)
+    q_fixed = tfl_round(q * (1 << 31))
+    if q_fixed == (1 << 31):
+        q_fixed //= 2
+        shift += 1
+    if shift < -31:
+        return 0, 0
+    return q_fixed, shift
+
+
+def softmax_params(input_scale, beta=1.0, scaled_diff_integer_bits=5):
+    real = min(beta * input_scale * (1 << (31 - scaled_diff_integer_bits)),
+               float((1 << 31) - 1))
+    mult, shift = quantize_multiplier(real)
+    radius = ((1 << scaled_diff_integer_bits) - 1) * \
+        (1 << (31 - scaled_diff_integer_bits)) / (1 << shift)
+    return mult, shift, -int(math.floor(radius))
+
+
+###############################################################################
+# Reference kernels, NHWC with N = 1, tensors are flat lists
+###############################################################################
+
+def conv_acc(inp, shape, layer, depthwise):
+    h, w, c = shape
+    kh, kw = layer['kernel']
+    sh, sw = layer['stride']
+    ph, pw = layer['pad']
+    oh, ow, oc = layer['out_shape']
+    wt = layer['weights']
+    acc = []
+    for oy in range(oh):
+        for ox in range(ow):
+            for o in range(oc):
+                s = layer['bias'][o]
+                for ky in range(kh):
+                    iy = oy * sh - ph + ky
+                    if iy < 0 or iy >= h:
+                        continue
+                    for kx in range(kw):
+                        ix = ox * sw - pw + kx
+                        if ix < 0 or ix >= w:
+                            continue
+                        base = (iy * w + ix) * c
+                        if depthwise:
+                            s += (inp[base + o] + layer['input_offset']) * \
+                                wt[(ky * kw + kx) * oc + o]
+                        else:
+                            for i in range(c):
+                                s += (inp[base + i] + layer['input_offset']) * \
+                                    wt[((o * kh + ky) * kw + kx) * c + i]
+                acc.append(s)
+    return acc
+
+
+def fc_acc(inp, layer):
+    n = len(inp)
+    return [layer['bias'][o] +
+            sum((inp[i] + layer['input_offset']) * layer['weights'][o * n + i]
+                for i in range(n))
+            for o in range(layer['out_shape'][2])]
+
+
+def requant_out(acc, layer):
+    oc = layer['out_shape'][2]
+    out = []
+    for idx, a in enumerate(acc):
+        o = idx % oc
+        v = requantize(a, layer['multiplier'][o], layer['shift'][o])
+        out.append(clamp(v + layer['output_offset'], layer['act_min'],
+                         layer['act_max']))
+    return out
+
+
+def pool(inp, shape, layer, average):
+    h, w, c = shape
+    kh, kw = layer['kernel']
+    sh, sw = layer['stride']
+    ph, pw = layer['pad']
+    oh, ow, _ = layer['out_shape']
+    out = []
+    for oy in range(oh):
+        for ox in range(ow):
+            for ch in range(c):
+                vals = []
+                for ky in range(kh):
+                    iy = oy * sh - ph + ky
+                    for kx in range(kw):
+                        ix = ox * sw - pw + kx
+                        if 0 <= iy < h and 0 <= ix < w:
+                            vals.append(inp[(iy * w + ix) * c + ch])
+                if average:
+                    s, n = sum(vals), len(vals)
+                    v = trunc_div(s + n // 2, n) if s > 0 else \
+                        trunc_div(s - n // 2, n)
+                else:
+                    v = max(vals)
+                out.append(clamp(v, layer['act_min'], layer['act_max']))
+    return out
+
+
+def softmax(inp, layer):
+    row = layer['out_shape'][2]
+    mult, shift, diff_min = layer['multiplier'][0], layer['shift'][0], \
+        layer['diff_min']
+    mask = 1 << shift
+    out = []
+    for r in range(0, len(inp), row):
+        x = inp[r:r + row]
+        mx = max(x)
+        total = 0
+        for v in x:
+            diff = v - mx
+            if diff >= diff_min:
+                total += divide_by_power_of_two(exp_on_negative_values(
+                    doubling_high_mult(diff * mask, mult)), 12)
+        headroom = clz32(total)
+        shifted_scale = one_over_one_plus_x_for_x_in_0_1(
+            i32(i32(total << headroom) - Q31_MIN))
+        bits_over_unit = 12 - headroom + 23
+        for v in x:
+            diff = v - mx
+            if diff >= diff_min:
+                res = divide_by_power_of_two(doubling_high_mult(
+                    shifted_scale, exp_on_negative_values(
+                        doubling_high_mult(diff * mask, mult))),
+                    bits_over_unit) - 128
+                out.append(clamp(res, -128, 127))
+            else:
+                out.append(-128)
+    return out
+
+
+###############################################################################
+# Model building
+###############################################################################
+
+def out_shape(kind, shape, p):
+    h, w, c = shape
+    if kind in ('conv', 'dwconv', 'maxpool', 'avgpool'):
+        kh, kw = p['kernel']
+        sh, sw = p['stride']
+        ph, pw = p['pad']
+        oc = p['out_c'] if kind == 'conv' else c
+        return ((h + 2 * ph - kh) // sh + 1, (w + 2 * pw - kw) // sw + 1, oc)
+    if kind == 'fc':
+        return (1, 1, p['out_c'])
+    return shape
+
+
+def calibrate(acc, layer, in_scale, w_scale, relu):
+    """Pick the output scale so the accumulators span the int8 range."""
+    real = [a * in_scale * w_scale for a in acc]
+    if relu:
+        out_scale = max(max(real), 1e-6) / 255.0
+        zero_point = -128
+    else:
+        out_scale = max(max(abs(r) for r in real), 1e-6) / 127.0
+        zero_point = 0
+    mults = [quantize_multiplier(in_scale * w_scale / out_scale)
+             for _ in range(layer['out_shape'][2])]
+    layer['multiplier'] = [m for m, _ in mults]
+    layer['shift'] = [s for _, s in mults]
+    layer['output_offset'] = zero_point
+    layer['act_min'] = zero_point if relu else -128
+    layer['act_max'] = 127
+    return out_scale, zero_point
+
+
+def build(seed):
+    rng = random.Random(seed)
+    h, w, c = INPUT_SHAPE
+    x = []
+    for t in range(w):
+        for ch in range(c):
+            v = math.sin(0.35 * t * (ch + 1)) + 0.2 * rng.uniform(-1.0, 1.0)
+            x.append(clamp(tfl_round(v / INPUT_SCALE) + INPUT_ZERO_POINT,
+                           -128, 127))
+    tensors = [INPUT_SHAPE]
+    layers = []
+    data, shape = x, INPUT_SHAPE
+    scale, zero_point = INPUT_SCALE, INPUT_ZERO_POINT
+    w_scale = 1.0 / 127.0
+    for kind, p in GRAPH:
+        layer = dict(kind=kind, input=len(tensors) - 1, output=len(tensors),
+                     kernel=p.get('kernel', (0, 0)),
+                     stride=p.get('stride', (0, 0)),
+                     pad=p.get('pad', (0, 0)),
+                     input_offset=-zero_point, output_offset=0,
+                     act_min=-128, act_max=127, weights=None, bias=None,
+                     multiplier=None, shift=None, diff_min=0)
+        layer['out_shape'] = out_shape(kind, shape, p)
+        oh, ow, oc = layer['out_shape']
+        if kind in ('conv', 'dwconv', 'fc'):
+            kh, kw = layer['kernel']
+            fan_in = {'conv': kh * kw * shape[2], 'dwconv': kh * kw,
+                      'fc': shape[0] * shape[1] * shape[2]}[kind]
+            count = {'conv': oc * fan_in, 'dwconv': kh * kw * oc,
+                     'fc': oc * fan_in}[kind]
+            layer['weights'] = [rng.randint(-127, 127) for _ in range(count)]
+            layer['bias'] = [tfl_round(rng.uniform(-0.1, 0.1) /
+                                       (scale * w_scale)) for _ in range(oc)]
+            if kind == 'fc':
+                acc = fc_acc(data, layer)
+            else:
+                acc = conv_acc(data, shape, layer, kind == 'dwconv')
+            scale, zero_point = calibrate(acc, layer, scale, w_scale,
+                                          p.get('relu', False))
+            data = requant_out(acc, layer)
+        elif kind in ('maxpool', 'avgpool'):
+            data = pool(data, shape, layer, kind == 'avgpool')
+        elif kind == 'softmax':
+            m, s, d = softmax_params(scale)
+            layer['multiplier'], layer['shift'], layer['diff_min'] = [m], [s], d
+            data = softmax(data, layer)
+            scale, zero_point = 1.0 / 256.0, -128
+        layers.append(layer)
+        tensors.append(layer['out_shape'])
+        shape = layer['out_shape']
+    return tensors, layers, x, data
+
+
+def plan_arena(name, tensors, layers):
+    """Best plan of nn_arena_plan.py, (strategy, offsets, bytes)."""
+    return nn_arena_plan.plan_best(
+        nn_arena_plan.from_model(name, tensors, layers))
+
+
+###############################################################################
+# C output
+###############################################################################
+
+BANNER = """/******************************************************************************
+ * Copyright (C) 2025 Damian.
+ *
+ * All Rights Reserved.
+ *
+ * @file {file}
+ *
+ * @par dependencies
+ * - bsp_nn_runtime.h
+ *
+ * @author Damian
+ *
+ * @brief {brief}
+ *
+ * Processing flow:
+ *
+ * {flow}
+ *
+ * Generated by 08_Tools/nn_model/nn_model_gen.py --name {name} --seed {seed},
+ * do not edit.
+ *
+ * @version V1.0 2026-10-18
+ *
+ * @note 1 tab == 4 spaces!
+ *
+ *****************************************************************************/
+"""
+
+
+def c_array(ctype, name, values, per_line=12):
+    lines = []
+    for i in range(0, len(values), per_line):
+        lines.append('    ' + ', '.join(str(v) for v in values[i:i + per_line])
+                     + ',')
+    return 'static const %s %s[%d] =\n{\n%s\n};\n' % (
+        ctype, name, len(values), '\n'.join(lines))
+
+
+def emit(name, seed, tensors, layers, x, y, offsets, arena, out_dir):
+    up = name.upper()
+    base = 'bsp_nn_model_%s' % name
+    guard = '__BSP_NN_MODEL_%s_H__' % up
+    brief = 'Model "%s" for the nn runtime, its test input and output.' % name
+
+    h = [BANNER.format(file=base + '.h', brief=brief, name=name, seed=seed,
+                       flow='nn_runtime_inst( &rt, &nn_model_%s, ... )' % name)]
+    h.append('#ifndef %s\n#define %s\n' % (guard, guard))
+    h.append('//******************************** Includes '
+             '*********************************//\n')
+    h.append('#include "bsp_nn_runtime.h"\n')
+    h.append('//******************************** Includes '
+             '*********************************//\n')
+    h.append('//******************************** Defines '
+             '**********************************//\n')
+    in_len = len(x)
+    out_len = len(y)
+    h.append('#define NN_MODEL_%s_INPUT_LEN     %-6s/* bytes of the input      */'
+             % (up, '%dU' % in_len))
+    h.append('#define NN_MODEL_%s_OUTPUT_LEN    %-6s/* bytes of the output     */'
+             % (up, '%dU' % out_len))
+    h.append('#define NN_MODEL_%s_ARENA_SIZE    %-6s/* planned activations     */'
+             % (up, '%dU' % arena))
+    h.append('\n//******************************** Defines '
+             '**********************************//\n')
+    h.append('//******************************* Declaring '
+             '*********************************//\n')
+    h.append('extern const nn_model_t nn_model_%s;' % name)
+    h.append('extern const int8_t     nn_model_%s_input[NN_MODEL_%s_INPUT_LEN];'
+             % (name, up))
+    h.append('extern const int8_t     nn_model_%s_expected[NN_MODEL_%s_OUTPUT_LEN];'
+             % (name, up))
+    h.append('\n//******************************* Declaring '
+             '*********************************//')
+    h.append('#endif // %s\n' % guard)
+
+    c = [BANNER.format(file=base + '.c', brief=brief, name=name, seed=seed,
+                       flow='Call directly.')]
+    c.append('//******************************** Includes '
+             '*********************************//\n')
+    c.append('#include "%s.h"\n' % base)
+    c.append('//******************************** Includes '
+             '*********************************//\n')
+    c.append('//******************************** Defines '
+             '**********************************//\n')
+    for i, l in enumerate(layers):
+        if l['weights'] is not None:
+            c.append(c_array('int8_t ', 's_l%d_weights' % i, l['weights']))
+            c.append(c_array('int32_t', 's_l%d_bias' % i, l['bias'], 6))
+        if l['multiplier'] is not None:
+            c.append(c_array('int32_t', 's_l%d_multiplier' % i,
+                             l['multiplier'], 6))
+            c.append(c_array('int32_t', 's_l%d_shift' % i, l['shift'], 12))
+    c.append('static const nn_tensor_t s_tensors[%d] =\n{' % len(tensors))
+    for t in tensors:
+        c.append('    { %3dU, %3dU, %3dU },' % t)
+    c.append('};\n')
+    c.append(c_array('uint32_t', 's_offsets',
+                     ['%dU' % o for o in offsets], 8))
+    c.append('static const nn_layer_t s_layers[%d] =\n{' % len(layers))
+    for i, l in enumerate(layers):
+        w = l['weights'] is not None
+        q = l['multiplier'] is not None
+        c.append('    {')
+        c.append('        .type          = %s,' % LAYER_ENUM[l['kind']])
+        c.append('        .input         = %dU,' % l['input'])
+        c.append('        .output        = %dU,' % l['output'])
+        if l['kind'] not in ('fc', 'softmax'):
+            c.append('        .kernel_h      = %dU,' % l['kernel'][0])
+            c.append('        .kernel_w      = %dU,' % l['kernel'][1])
+            c.append('        .stride_h      = %dU,' % l['stride'][0])
+            c.append('        .stride_w      = %dU,' % l['stride'][1])
+            c.append('        .pad_h         = %dU,' % l['pad'][0])
+            c.append('        .pad_w         = %dU,' % l['pad'][1])
+        if w:
+            c.append('        .input_offset  = %d,' % l['input_offset'])
+            c.append('        .output_offset = %d,' % l['output_offset'])
+        c.append('        .act_min       = %d,' % l['act_min'])
+        c.append('        .act_max       = %d,' % l['act_max'])
+        if w:
+            c.append('        .weights       = s_l%d_weights,' % i)
+            c.append('        .bias          = s_l%d_bias,' % i)
+        if q:
+            c.append('        .multiplier    = s_l%d_multiplier,' % i)
+            c.append('        .shift         = s_l%d_shift,' % i)
+        if l['kind'] == 'softmax':
+            c.append('        .diff_min      = %d,' % l['diff_min'])
+        c.append('    },')
+    c.append('};\n')
+    c.append('const nn_model_t nn_model_%s =\n{' % name)
+    c.append('    .magic      = NN_MODEL_MAGIC,')
+    c.append('    .name       = "%s",' % name)
+    c.append('    .tensor_num = %dU,' % len(tensors))
+    c.append('    .layer_num  = %dU,' % len(layers))
+    c.append('    .input      = 0U,')
+    c.append('    .output     = %dU,' % (len(tensors) - 1))
+    c.append('    .tensors    = s_tensors,')
+    c.append('    .layers     = s_layers,')
+    c.append('    .offsets    = s_offsets,')
+    c.append('    .arena_size = NN_MODEL_%s_ARENA_SIZE,' % up)
+    c.append('};\n')
+    c.append(c_array('int8_t', 'nn_model_%s_input' % name, x, 16)
+             .replace('static const', 'const')
+             .replace('[%d]' % in_len, '[NN_MODEL_%s_INPUT_LEN]' % up))
+    c.append(c_array('int8_t', 'nn_model_%s_expected' % name, y, 16)
+             .replace('static const', 'const')
+             .replace('[%d]' % out_len, '[NN_MODEL_%s_OUTPUT_LEN]' % up))
+    c.append('//******************************** Defines '
+             '**********************************//')
+
+    inc = os.path.join(out_dir, 'include')
+    src = os.path.join(out_dir, 'src')
+    os.makedirs(inc, exist_ok=True)
+    os.makedirs(src, exist_ok=True)
+    with open(os.path.join(inc, base + '.h'), 'w') as f:
+        f.write('\n'.join(h) + '\n')
+    with open(os.path.join(src, base + '.c'), 'w') as f:
+        f.write('\n'.join(c) + '\n')
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__)
+    ap.add_argument('--name', default='demo')
+    ap.add_argument('--seed', type=int, default=1)
+    ap.add_argument('--out-dir', default=os.path.join(
+        os.path.dirname(os.path.abspath(__file__)), '..', '..',
+        '05_Software', '01_Source_Code', 'BSP', 'nn', 'model'))
+    args = ap.parse_args()
+
+    tensors, layers, x, y = build(args.seed)
+    strategy, offsets, arena = plan_arena(args.name, tensors, layers)
+    emit(args.name, args.seed, tensors, layers, x, y, offsets, arena,
+         os.path.normpath(args.out_dir))
+    for t, shape in enumerate(tensors):
+        print('tensor %d %-14s %5d bytes at %5d' %
+              (t, 'x'.join(str(d) for d in shape),
+               shape[0] * shape[1] * shape[2], offsets[t]))
+    print('arena %d bytes (%s), output %s' % (arena, strategy, y))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
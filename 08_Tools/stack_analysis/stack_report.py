@@ -0,0 +1,163 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+###############################################################################
+# Copyright (C) 2025 Damian.
+#
+# All Rights Reserved.
+#
+# @file stack_report.py
+#
+# @brief Static worst-case stack bound of every task.
+#
+# Inputs, one of:
+#   --callgraph  armlink callgraph (--callgraph, text or htm output), the
+#                linker already folds the call tree into "Max Depth"
+#   --ci         GCC -fcallgraph-info=su files (*.ci), the call tree is
+#                folded here with a DFS
+#
+# The task list (tasks.txt) gives each task entry function and the stack
+# size it is created with. The report adds the FreeRTOS context frame the
+# port pushes on the task stack and flags every chain that goes through an
+# indirect call or recursion, the bound is then only a lower bound.
+#
+# Exit code is 1 when a task's bound exceeds its configured stack.
+#
+# @version V1.0 2026-10-18
+###############################################################################
+
+import argparse
+import glob
+import html
+import re
+import sys
+
+# Context pushed on a task stack by port.c (ARM_CM4F): 8 hardware words,
+# r4-r11 and EXC_RETURN. With an active FPU context, 18 more hardware words
+# and s16-s31.
+FRAME_BASIC = (8 + 9) * 4
+FRAME_FPU = FRAME_BASIC + (18 + 16) * 4
+
+
+def load_tasks(path):
+    """Return [(entry, configured_bytes)] from tasks.txt."""
+    tasks = []
+    with open(path, encoding="utf-8") as f:
+        for line in f:
+            line = line.split("#", 1)[0].strip()
+            if not line:
+                continue
+            entry, size = line.split()[:2]
+            tasks.append((entry, int(size, 0)))
+    return tasks
+
+
+def parse_armlink(path):
+    """Return {function: (max_depth, unknown)} from an armlink callgraph."""
+    with open(path, encoding="utf-8", errors="replace") as f:
+        text = f.read()
+    if path.lower().endswith((".htm", ".html")):
+        text = re.sub(r"<(BR|LI|P|UL)[^>]*>", "\n", text, flags=re.I)
+        text = html.unescape(re.sub(r"<[^>]+>", "", text))
+
+    head = re.compile(r"^\s*(\S+) \((?:Thumb|ARM), \d+ bytes, Stack size (\d+) bytes")
+    depth = re.compile(r"Max Depth = (\d+)(.*)")
+    result = {}
+    current = None
+    for line in text.splitlines():
+        m = head.match(line)
+        if m:
+            current = m.group(1)
+            # leaf functions have no [Stack] block, their own frame is all
+            result[current] = (int(m.group(2)), False)
+            continue
+        m = depth.search(line)
+        if m and current is not None:
+            result[current] = (int(m.group(1)), "Unknown" in m.group(2))
+            current = None
+    return result
+
+
+def parse_ci(patterns):
+    """Return {function: (max_depth, unknown)} from GCC .ci files."""
+    frame = {}
+    calls = {}
+    node = re.compile(r'node:\s*\{\s*title:\s*"([^"]+)"\s*label:\s*"([^"]*)"')
+    edge = re.compile(r'edge:\s*\{\s*sourcename:\s*"([^"]+)"\s*targetname:\s*"([^"]+)"')
+    for pattern in patterns:
+        for path in glob.glob(pattern, recursive=True):
+            with open(path, encoding="utf-8", errors="replace") as f:
+                text = f.read()
+            for title, label in node.findall(text):
+                m = re.search(r"(\d+) bytes", label)
+                # external functions have no stack info in this unit
+                if m or title not in frame:
+                    frame[title] = int(m.group(1)) if m else None
+            for src, dst in edge.findall(text):
+                calls.setdefault(src, set()).add(dst)
+
+    result = {}
+
+    def walk(fn, stack):
+        if fn in result:
+            return result[fn]
+        if fn in stack:
+            return (0, True)                        # recursion
+        own = frame.get(fn)
+        unknown = own is None or fn == "__indirect_call"
+        best = 0
+        stack.add(fn)
+        for callee in calls.get(fn, ()):
+            d, u = walk(callee, stack)
+            best = max(best, d)
+            unknown = unknown or u
+        stack.discard(fn)
+        result[fn] = ((own or 0) + best, unknown)
+        return result[fn]
+
+    for fn in list(frame):
+        walk(fn, set())
+    return result
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__)
+    src = ap.add_mutually_exclusive_group(required=True)
+    src.add_argument("--callgraph", help="armlink callgraph .txt/.htm")
+    src.add_argument("--ci", nargs="+", help="GCC .ci files or globs")
+    ap.add_argument("--tasks", required=True, help="task list, see tasks.txt")
+    ap.add_argument("--fpu", action="store_true",
+                    help="tasks may hold an FPU context")
+    ap.add_argument("--csv", action="store_true", help="CSV output")
+    args = ap.parse_args()
+
+    depths = parse_armlink(args.callgraph) if args.callgraph else parse_ci(args.ci)
+    frame = FRAME_FPU if args.fpu else FRAME_BASIC
+    over = False
+
+    if args.csv:
+        print("task,static_bytes,frame_bytes,bound_bytes,configured_bytes,"
+              "margin_bytes,exact")
+    else:
+        print("%-24s %8s %8s %10s %8s  %s" % ("task", "static", "bound",
+                                              "configured", "margin", "note"))
+    for entry, configured in load_tasks(args.tasks):
+        if entry not in depths:
+            note = "not found in call graph"
+            static, unknown = 0, True
+        else:
+            static, unknown = depths[entry]
+            note = "lower bound: indirect call or recursion" if unknown else ""
+        bound = static + frame
+        margin = configured - bound
+        over = over or margin < 0
+        if args.csv:
+            print("%s,%d,%d,%d,%d,%d,%d" % (entry, static, frame, bound,
+                                            configured, margin, not unknown))
+        else:
+            print("%-24s %8d %8d %10d %8d  %s" % (entry, static, bound,
+                                                  configured, margin, note))
+    return 1 if over else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())